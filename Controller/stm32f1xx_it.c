@@ -17,75 +17,103 @@
  *
  * @date  21.08.2023
  * @date  22.09.2023  Added HardFault debugger breakpoint
+ * @date  19.10.2026  Added DMA memory-to-memory engine handler
+ * @date  19.10.2026  Added ADC telemetry DMA handler
+ * @date  19.10.2026  Replaced HAL_IncTick() with system time/timer service
+ * @date  19.10.2026  Fault handlers record snapshot and reset
+ * @date  19.10.2026  SVC/PendSV/SysTick drive the kernel
+ * @date  19.10.2026  Handlers record timeline trace
+ * @date  19.10.2026  Added SPI NOR transmit DMA handler
+ * @date  19.10.2026  Added USB device handler
+ * @date  19.10.2026  Added sensor I2C event, error and DMA handlers
+ * @date  19.10.2026  Added capture timer and DMA handlers
+ * @date  19.10.2026  Shared DMA channel dispatches to capture or sequencer
  ******************************************************************************/
 
 /*- Header files -------------------------------------------------------------*/
 #include "stm32f1xx_hal.h"
+#include "hw_iodef.h"
+#include "hw_adc.h"
+#include "hw_capture.h"
+#include "hw_clk.h"
+#include "hw_dma.h"
+#include "hw_flight.h"
+#include "hw_i2c.h"
+#include "hw_os.h"
+#include "hw_seq.h"
+#include "hw_spi.h"
+#include "hw_trace.h"
+#include "hw_usb.h"
 
 
 /*!*****************************************************************************
  * @brief
  * Non-Maskable Interrupt (NMI) handler
  *
+ * Branches to flight recorder (snapshot and reset, see hw_flight.c).
+ *
  * @date  21.08.2023
+ * @date  19.10.2026
  ******************************************************************************/
-void NMI_Handler(void)
+__attribute__((naked)) void NMI_Handler(void)
 {
-  while (1)
-  {
-  }
+  __asm volatile("b vHW_FLIGHT_FaultHandler");
 }
 
 /*!*****************************************************************************
  * @brief
  * Hard Fault handler
  *
+ * Branches to flight recorder (snapshot and reset, see hw_flight.c).
+ *
  * @date  21.08.2023
+ * @date  19.10.2026
  ******************************************************************************/
-void HardFault_Handler(void)
+__attribute__((naked)) void HardFault_Handler(void)
 {
-  while (1)
-  {
-  }
+  __asm volatile("b vHW_FLIGHT_FaultHandler");
 }
 
 /*!*****************************************************************************
  * @brief
  * MPU / Memory map fault handler
  *
+ * Branches to flight recorder (snapshot and reset, see hw_flight.c).
+ *
  * @date  21.08.2023
+ * @date  19.10.2026
  ******************************************************************************/
-void MemManage_Handler(void)
+__attribute__((naked)) void MemManage_Handler(void)
 {
-  while (1)
-  {
-  }
+  __asm volatile("b vHW_FLIGHT_FaultHandler");
 }
 
 /*!*****************************************************************************
  * @brief
  * Bus access error handler
  *
+ * Branches to flight recorder (snapshot and reset, see hw_flight.c).
+ *
  * @date  21.08.2023
+ * @date  19.10.2026
  ******************************************************************************/
-void BusFault_Handler(void)
+__attribute__((naked)) void BusFault_Handler(void)
 {
-  while (1)
-  {
-  }
+  __asm volatile("b vHW_FLIGHT_FaultHandler");
 }
 
 /*!*****************************************************************************
  * @brief
  * Usage Fault Exception handler
  *
+ * Branches to flight recorder (snapshot and reset, see hw_flight.c).
+ *
  * @date  21.08.2023
+ * @date  19.10.2026
  ******************************************************************************/
-void UsageFault_Handler(void)
+__attribute__((naked)) void UsageFault_Handler(void)
 {
-  while (1)
-  {
-  }
+  __asm volatile("b vHW_FLIGHT_FaultHandler");
 }
 
 /*!*****************************************************************************
@@ -93,9 +121,11 @@ void UsageFault_Handler(void)
  * Supervisor Call Exception handler
  *
  * @date  21.08.2023
+ * @date  19.10.2026
  ******************************************************************************/
-void SVC_Handler(void)
+__attribute__((naked)) void SVC_Handler(void)
 {
+  __asm volatile("b vHW_OS_SvcHandler");
 }
 
 /*!*****************************************************************************
@@ -113,9 +143,11 @@ void DebugMon_Handler(void)
  * PendSV / Pending Supervisor Call Exception handler
  *
  * @date  21.08.2023
+ * @date  19.10.2026
  ******************************************************************************/
-void PendSV_Handler(void)
+__attribute__((naked)) void PendSV_Handler(void)
 {
+  __asm volatile("b vHW_OS_PendSvHandler");
 }
 
 /*!*****************************************************************************
@@ -123,8 +155,144 @@ void PendSV_Handler(void)
  * SysTick Interrupt Handler
  *
  * @date  21.08.2023
+ * @date  19.10.2026
  ******************************************************************************/
 void SysTick_Handler(void)
 {
-  HAL_IncTick();
+  HW_TRACE_ISR_ENTER();
+  vHW_CLK_TickHandler();
+  vHW_OS_TickHandler();
+  HW_TRACE_ISR_EXIT();
+}
+
+/*!*****************************************************************************
+ * @brief
+ * DMA memory-to-memory engine channel interrupt handler
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void DMA_M2M_IRQHandler(void)
+{
+  HW_TRACE_ISR_ENTER();
+  vHW_DMA_IRQHandler();
+  HW_TRACE_ISR_EXIT();
+}
+
+/*!*****************************************************************************
+ * @brief
+ * ADC telemetry DMA channel interrupt handler
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void DMA_ADC_IRQHandler(void)
+{
+  HW_TRACE_ISR_ENTER();
+  vHW_ADC_IRQHandler();
+  HW_TRACE_ISR_EXIT();
+}
+
+/*!*****************************************************************************
+ * @brief
+ * SPI NOR transmit DMA channel interrupt handler
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void DMA_SPI_TX_IRQHandler(void)
+{
+  HW_TRACE_ISR_ENTER();
+  vHW_SPI_IRQHandler();
+  HW_TRACE_ISR_EXIT();
+}
+
+/*!*****************************************************************************
+ * @brief
+ * USB low-priority interrupt handler (all USB device events)
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void USB_DEV_IRQHandler(void)
+{
+  HW_TRACE_ISR_ENTER();
+  vHW_USB_IRQHandler();
+  HW_TRACE_ISR_EXIT();
+}
+
+/*!*****************************************************************************
+ * @brief
+ * Sensor I2C event interrupt handler
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void I2C_SENS_EV_IRQHandler(void)
+{
+  HW_TRACE_ISR_ENTER();
+  vHW_I2C_EvIRQHandler();
+  HW_TRACE_ISR_EXIT();
+}
+
+/*!*****************************************************************************
+ * @brief
+ * Sensor I2C error interrupt handler
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void I2C_SENS_ER_IRQHandler(void)
+{
+  HW_TRACE_ISR_ENTER();
+  vHW_I2C_ErIRQHandler();
+  HW_TRACE_ISR_EXIT();
+}
+
+/*!*****************************************************************************
+ * @brief
+ * Sensor I2C receive DMA channel interrupt handler
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void DMA_I2C_RX_IRQHandler(void)
+{
+  HW_TRACE_ISR_ENTER();
+  vHW_I2C_DmaIRQHandler();
+  HW_TRACE_ISR_EXIT();
+}
+
+/*!*****************************************************************************
+ * @brief
+ * Capture timer interrupt handler (half period count)
+ *
+ * CRITICAL level: not traced, the timeline trace takes the hw_irq lock.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void CAPT_IRQHandler(void)
+{
+  vHW_CAPTURE_IRQHandler();
+}
+
+/*!*****************************************************************************
+ * @brief
+ * Shared DMA channel interrupt handler (capture or sequencer)
+ *
+ * Flags left over from a released channel are cleared.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void DMA_SHARED_IRQHandler(void)
+{
+  HW_TRACE_ISR_ENTER();
+  switch (eHW_DMA_GetShared())
+  {
+    case HW_DMA_SHARED_CAPTURE:
+      vHW_CAPTURE_DmaIRQHandler();
+      break;
+
+    case HW_DMA_SHARED_SEQ:
+      vHW_SEQ_DmaIRQHandler();
+      break;
+
+    default:
+      DMA1->IFCR = DMA_SHARED_IFCR_CGIF;
+      break;
+  }
+  HW_TRACE_ISR_EXIT();
 }
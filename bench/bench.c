@@ -0,0 +1,258 @@
+/*!****************************************************************************
+ * @file
+ * bench.c
+ *
+ * @brief
+ * Microbenchmark harness
+ *
+ * Results are written to the platform's result sink (vBENCH_Write()), a
+ * separate output channel so they do not interleave with console output
+ * produced by the benchmarks themselves.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdio.h>
+#include "bench.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/*! @brief Output formats
+ *  @{                                                                        */
+#define BENCH_FORMAT_CSV              0
+#define BENCH_FORMAT_JSON             1
+/*! @}                                                                        */
+
+/// Selected output format
+#ifndef BENCH_FORMAT
+#define BENCH_FORMAT                  BENCH_FORMAT_CSV
+#endif
+
+/// Output line buffer size
+#define BENCH_LINE_SIZE               160u
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Measurement overhead in cycles (empty body)
+static uint32_t ulOverhead;
+
+/// Output line buffer
+static char acLine[BENCH_LINE_SIZE];
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vBENCH_Empty(uint32_t ulArg);
+static uint32_t ulBENCH_Measure(BENCH_FuncTypeDef pfnRun, uint32_t ulArg,
+                                uint32_t ulFlags);
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise harness and emit result header
+ *
+ * Calibrates the measurement overhead (cycle counter reads and indirect call)
+ * using an empty benchmark body.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vBENCH_Init(void)
+{
+  ulOverhead = 0uL;
+
+  uint32_t ulMin = UINT32_MAX;
+  for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + BENCH_DEFAULT_RUNS; ++i)
+  {
+    uint32_t ulCycles = ulBENCH_Measure(vBENCH_Empty, 0uL, 0uL);
+    if (i >= BENCH_DEFAULT_WARMUP && ulCycles < ulMin) ulMin = ulCycles;
+  }
+  ulOverhead = ulMin;
+
+#if BENCH_FORMAT == BENCH_FORMAT_JSON
+  (void)snprintf(acLine, sizeof(acLine),
+    "{\"meta\":{\"f_hclk\":%lu,\"overhead\":%lu}}\r\n",
+    (unsigned long)ulBENCH_GetCoreClock(), (unsigned long)ulOverhead
+  );
+  vBENCH_Write(acLine);
+#else
+  (void)snprintf(acLine, sizeof(acLine),
+    "# f_hclk=%lu overhead=%lu\r\n",
+    (unsigned long)ulBENCH_GetCoreClock(), (unsigned long)ulOverhead
+  );
+  vBENCH_Write(acLine);
+  vBENCH_Write("suite,case,arg,units,runs,min,max,mean\r\n");
+#endif
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run all cases of a benchmark suite and report results
+ *
+ * @param[in] *psSuite  Suite descriptor
+ * @date  19.10.2026
+ ******************************************************************************/
+void vBENCH_RunSuite(const BENCH_SuiteTypeDef* psSuite)
+{
+  if (psSuite->pfnSetup != NULL) psSuite->pfnSetup();
+
+  for (uint32_t c = 0uL; c < psSuite->ulNumCases; ++c)
+  {
+    const BENCH_CaseTypeDef* psCase = &psSuite->psCases[c];
+    uint32_t ulWarmup = (psCase->ulWarmup != 0uL) ? psCase->ulWarmup : BENCH_DEFAULT_WARMUP;
+    uint32_t ulRuns = (psCase->ulRuns != 0uL) ? psCase->ulRuns : BENCH_DEFAULT_RUNS;
+
+    for (uint32_t i = 0uL; i < ulWarmup; ++i)
+    {
+      (void)ulBENCH_Measure(psCase->pfnRun, psCase->ulArg, psCase->ulFlags);
+    }
+
+    BENCH_ResultTypeDef sResult;
+    vBENCH_ResetResult(&sResult);
+    for (uint32_t i = 0uL; i < ulRuns; ++i)
+    {
+      vBENCH_AddSample(&sResult, ulBENCH_Measure(psCase->pfnRun, psCase->ulArg, psCase->ulFlags));
+    }
+    vBENCH_Report(psSuite->pcName, psCase->pcName, psCase->ulArg, psCase->ulUnits, &sResult);
+  }
+
+  if (psSuite->pfnCustom != NULL) psSuite->pfnCustom(psSuite->pcName);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Emit end-of-results marker
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vBENCH_Finish(void)
+{
+#if BENCH_FORMAT == BENCH_FORMAT_JSON
+  vBENCH_Write("{\"done\":true}\r\n");
+#else
+  vBENCH_Write("# done\r\n");
+#endif
+}
+
+/*!****************************************************************************
+ * @brief
+ * Reset result accumulator
+ *
+ * @param[out] *psResult  Result accumulator
+ * @date  19.10.2026
+ ******************************************************************************/
+void vBENCH_ResetResult(BENCH_ResultTypeDef* psResult)
+{
+  psResult->ulRuns = 0uL;
+  psResult->ulMin = UINT32_MAX;
+  psResult->ulMax = 0uL;
+  psResult->ullSum = 0uLL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Add a cycle count sample to a result accumulator
+ *
+ * @param[in,out] *psResult Result accumulator
+ * @param[in] ulCycles      Measured cycles
+ * @date  19.10.2026
+ ******************************************************************************/
+void vBENCH_AddSample(BENCH_ResultTypeDef* psResult, uint32_t ulCycles)
+{
+  psResult->ulRuns++;
+  psResult->ullSum += ulCycles;
+  if (ulCycles < psResult->ulMin) psResult->ulMin = ulCycles;
+  if (ulCycles > psResult->ulMax) psResult->ulMax = ulCycles;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get calibrated measurement overhead
+ *
+ * Self-timed cases that read the cycle counter directly should subtract this
+ * value from their samples.
+ *
+ * @return  (uint32_t)  Overhead in cycles
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulBENCH_GetOverhead(void)
+{
+  return ulOverhead;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Emit a result record
+ *
+ * @param[in] *pcSuite  Suite name
+ * @param[in] *pcCase   Case name
+ * @param[in] ulArg     Case argument
+ * @param[in] ulUnits   Work units per run, or 0
+ * @param[in] *psResult Result accumulator
+ * @date  19.10.2026
+ ******************************************************************************/
+void vBENCH_Report(const char* pcSuite, const char* pcCase, uint32_t ulArg,
+                   uint32_t ulUnits, const BENCH_ResultTypeDef* psResult)
+{
+  uint32_t ulMin = (psResult->ulRuns != 0uL) ? psResult->ulMin : 0uL;
+  uint32_t ulMean = (psResult->ulRuns != 0uL) ? (uint32_t)(psResult->ullSum / psResult->ulRuns) : 0uL;
+
+#if BENCH_FORMAT == BENCH_FORMAT_JSON
+  (void)snprintf(acLine, sizeof(acLine),
+    "{\"suite\":\"%s\",\"case\":\"%s\",\"arg\":%lu,\"units\":%lu,"
+    "\"runs\":%lu,\"min\":%lu,\"max\":%lu,\"mean\":%lu}\r\n",
+    pcSuite, pcCase, (unsigned long)ulArg, (unsigned long)ulUnits,
+    (unsigned long)psResult->ulRuns, (unsigned long)ulMin,
+    (unsigned long)psResult->ulMax, (unsigned long)ulMean
+  );
+#else
+  (void)snprintf(acLine, sizeof(acLine),
+    "%s,%s,%lu,%lu,%lu,%lu,%lu,%lu\r\n",
+    pcSuite, pcCase, (unsigned long)ulArg, (unsigned long)ulUnits,
+    (unsigned long)psResult->ulRuns, (unsigned long)ulMin,
+    (unsigned long)psResult->ulMax, (unsigned long)ulMean
+  );
+#endif
+  vBENCH_Write(acLine);
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Empty benchmark body for overhead calibration
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static __attribute__((noinline)) void vBENCH_Empty(uint32_t ulArg)
+{
+  (void)ulArg;
+  __asm__ volatile ("" ::: "memory");
+}
+
+/*!****************************************************************************
+ * @brief
+ * Measure a single run of a benchmark body
+ *
+ * Interrupts are masked during the measurement unless BENCH_FLAG_IRQ is set.
+ *
+ * @param[in] pfnRun    Benchmark body
+ * @param[in] ulArg     Argument passed to body
+ * @param[in] ulFlags   Case flags
+ * @return  (uint32_t)  Cycles spent, measurement overhead removed
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulBENCH_Measure(BENCH_FuncTypeDef pfnRun, uint32_t ulArg,
+                                uint32_t ulFlags)
+{
+  bool bMask = (ulFlags & BENCH_FLAG_IRQ) == 0uL;
+  uint32_t ulMask = bMask ? ulBENCH_MaskIrq() : 0uL;
+
+  uint32_t ulStart = ulBENCH_GetCycles();
+  pfnRun(ulArg);
+  uint32_t ulCycles = ulBENCH_GetCycles() - ulStart;
+
+  if (bMask) vBENCH_RestoreIrq(ulMask);
+  return (ulCycles > ulOverhead) ? (ulCycles - ulOverhead) : 0uL;
+}
@@ -0,0 +1,98 @@
+/*!****************************************************************************
+ * @file
+ * bench.h
+ *
+ * @brief
+ * Microbenchmark harness
+ *
+ * Each case is run a number of times for warm-up (caches, prefetch buffer,
+ * lazy initialisation in newlib), then measured repeatedly using the DWT
+ * cycle counter. Min/max/mean cycle counts are reported as one record per
+ * case, either as CSV or as JSON lines.
+ *
+ * The harness reaches the hardware only through the platform functions:
+ * cycle counter, interrupt masking and result sink. bench_hw.c implements
+ * them on the target; a POSIX stand-in lets the harness run on the host
+ * (tools/bench_check).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Default number of warm-up runs per case (results discarded)
+#define BENCH_DEFAULT_WARMUP          4uL
+
+/// Default number of measured runs per case
+#define BENCH_DEFAULT_RUNS            32uL
+
+/*! @brief Case flags
+ *  @{                                                                        */
+/// Keep interrupts enabled during measurement
+#define BENCH_FLAG_IRQ                (1uL << 0)
+/*! @}                                                                        */
+
+/// Number of elements in a case table
+#define BENCH_COUNT(arr)              (sizeof(arr) / sizeof((arr)[0]))
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Benchmark body, called once per run with the case argument
+typedef void (*BENCH_FuncTypeDef)(uint32_t ulArg);
+
+/// Benchmark case descriptor
+typedef struct {
+  const char* pcName;             ///< Case name
+  BENCH_FuncTypeDef pfnRun;       ///< Body to be measured
+  uint32_t ulArg;                 ///< Argument passed to body (e.g. size)
+  uint32_t ulUnits;               ///< Work units per run (e.g. bytes), or 0
+  uint32_t ulWarmup;              ///< Warm-up runs, 0 for default
+  uint32_t ulRuns;                ///< Measured runs, 0 for default
+  uint32_t ulFlags;               ///< Case flags BENCH_FLAG_x
+} BENCH_CaseTypeDef;
+
+/// Benchmark result (cycle counts, measurement overhead removed)
+typedef struct {
+  uint32_t ulRuns;                ///< Number of measured runs
+  uint32_t ulMin;                 ///< Minimum cycles
+  uint32_t ulMax;                 ///< Maximum cycles
+  uint64_t ullSum;                ///< Sum of cycles over all runs
+} BENCH_ResultTypeDef;
+
+/// Benchmark suite
+typedef struct {
+  const char* pcName;                 ///< Suite name
+  void (*pfnSetup)(void);             ///< Optional setup, called once
+  const BENCH_CaseTypeDef* psCases;   ///< Case table
+  uint32_t ulNumCases;                ///< Number of entries in case table
+  void (*pfnCustom)(const char* pcSuite); ///< Optional self-timed cases
+} BENCH_SuiteTypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vBENCH_Init(void);
+void vBENCH_RunSuite(const BENCH_SuiteTypeDef* psSuite);
+void vBENCH_Finish(void);
+
+// Helpers for self-timed cases
+void vBENCH_ResetResult(BENCH_ResultTypeDef* psResult);
+void vBENCH_AddSample(BENCH_ResultTypeDef* psResult, uint32_t ulCycles);
+uint32_t ulBENCH_GetOverhead(void);
+void vBENCH_Report(const char* pcSuite, const char* pcCase, uint32_t ulArg,
+                   uint32_t ulUnits, const BENCH_ResultTypeDef* psResult);
+
+// Platform (bench_hw.c)
+uint32_t ulBENCH_GetCycles(void);
+uint32_t ulBENCH_GetCoreClock(void);
+uint32_t ulBENCH_MaskIrq(void);
+void vBENCH_RestoreIrq(uint32_t ulMask);
+void vBENCH_Write(const char* pcStr);
+
+#endif // BENCH_H_
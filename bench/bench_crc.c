@@ -0,0 +1,124 @@
+/*!****************************************************************************
+ * @file
+ * bench_crc.c
+ *
+ * @brief
+ * Microbenchmarks - CRC-32
+ *
+ * Data is read from the start of flash, as for the image self-check. For
+ * each size, the following are reported:
+ *  - "sw":         ulCRC32_Update() (table-driven, zlib result)
+ *  - "zlib_cpu":   CRC unit fed by the CPU with bit reversal (zlib result)
+ *  - "native_cpu": CRC unit fed by the CPU (native result)
+ *  - "native_dma": CRC unit fed by DMA until completion (native result)
+ *  - "dma_submit": bHW_CRC_UpdateDma() until return (CPU time consumed)
+ * Units are bytes. Additionally, "image" reports vHW_CRC_CheckImage(),
+ * arg = image length.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include "stm32f1xx_hal.h"
+#include "hw_layer.h"
+#include "hw_crc.h"
+#include "crc32.h"
+#include "bench.h"
+#include "bench_suites.h"
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Data sizes
+static const uint32_t aulSizes[] = { 16uL, 64uL, 256uL, 1024uL, 4096uL };
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Self-timed cases
+ *
+ * @param[in] *pcSuite  Suite name
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vRun(const char* pcSuite)
+{
+  uint32_t ulOverhead = ulBENCH_GetOverhead();
+  const uint32_t* pulData = (const uint32_t*)FLASH_BASE;
+  volatile uint32_t ulSink;
+
+  for (uint32_t s = 0uL; s < BENCH_COUNT(aulSizes); ++s)
+  {
+    uint32_t ulSize = aulSizes[s];
+    BENCH_ResultTypeDef sSw, sZlib, sNative, sDma, sSubmit;
+    vBENCH_ResetResult(&sSw);
+    vBENCH_ResetResult(&sZlib);
+    vBENCH_ResetResult(&sNative);
+    vBENCH_ResetResult(&sDma);
+    vBENCH_ResetResult(&sSubmit);
+
+    for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + BENCH_DEFAULT_RUNS; ++i)
+    {
+      HW_CRC_ContextTypeDef sCtx;
+
+      __disable_irq();
+      uint32_t ulT0 = ulHW_GetCycleCount();
+      ulSink = ulCRC32_Update(CRC32_INIT, pulData, ulSize);
+      uint32_t ulT1 = ulHW_GetCycleCount();
+
+      vHW_CRC_Start(&sCtx, HW_CRC_MODE_ZLIB);
+      uint32_t ulT2 = ulHW_GetCycleCount();
+      vHW_CRC_Update(&sCtx, pulData, ulSize);
+      uint32_t ulT3 = ulHW_GetCycleCount();
+      ulSink = ulHW_CRC_Final(&sCtx);
+
+      vHW_CRC_Start(&sCtx, HW_CRC_MODE_NATIVE);
+      uint32_t ulT4 = ulHW_GetCycleCount();
+      vHW_CRC_Update(&sCtx, pulData, ulSize);
+      uint32_t ulT5 = ulHW_GetCycleCount();
+      ulSink = ulHW_CRC_Final(&sCtx);
+      __enable_irq();
+
+      // DMA completion needs interrupts
+      vHW_CRC_Start(&sCtx, HW_CRC_MODE_NATIVE);
+      uint32_t ulT6 = ulHW_GetCycleCount();
+      (void)bHW_CRC_UpdateDma(&sCtx, pulData, ulSize / sizeof(uint32_t));
+      uint32_t ulT7 = ulHW_GetCycleCount();
+      ulSink = ulHW_CRC_Final(&sCtx);
+      uint32_t ulT8 = ulHW_GetCycleCount();
+
+      if (i < BENCH_DEFAULT_WARMUP) continue;
+      vBENCH_AddSample(&sSw, ulT1 - ulT0 - ulOverhead);
+      vBENCH_AddSample(&sZlib, ulT3 - ulT2 - ulOverhead);
+      vBENCH_AddSample(&sNative, ulT5 - ulT4 - ulOverhead);
+      vBENCH_AddSample(&sSubmit, ulT7 - ulT6 - ulOverhead);
+      vBENCH_AddSample(&sDma, ulT8 - ulT6 - ulOverhead);
+    }
+
+    vBENCH_Report(pcSuite, "sw", ulSize, ulSize, &sSw);
+    vBENCH_Report(pcSuite, "zlib_cpu", ulSize, ulSize, &sZlib);
+    vBENCH_Report(pcSuite, "native_cpu", ulSize, ulSize, &sNative);
+    vBENCH_Report(pcSuite, "native_dma", ulSize, ulSize, &sDma);
+    vBENCH_Report(pcSuite, "dma_submit", ulSize, ulSize, &sSubmit);
+  }
+  (void)ulSink;
+
+  // Boot-time image self-check (fewer runs, takes milliseconds)
+  BENCH_ResultTypeDef sImage;
+  vBENCH_ResetResult(&sImage);
+  for (uint32_t i = 0uL; i < BENCH_DEFAULT_RUNS / 4uL; ++i)
+  {
+    vHW_CRC_CheckImage();
+    const HW_CRC_ImageCheckTypeDef* psCheck = psHW_CRC_GetImageCheck();
+    if (psCheck->eStatus == HW_CRC_IMAGE_MISSING) break;
+    vBENCH_AddSample(&sImage, psCheck->ulCycles);
+  }
+  vBENCH_Report(pcSuite, "image", psHW_CRC_GetImageCheck()->ulLength, 1uL, &sImage);
+}
+
+
+/*- Global data --------------------------------------------------------------*/
+/// CRC benchmark suite
+const BENCH_SuiteTypeDef sBENCH_SuiteCrc = {
+  .pcName = "crc",
+  .pfnCustom = vRun
+};
@@ -0,0 +1,99 @@
+/*!****************************************************************************
+ * @file
+ * bench_dma.c
+ *
+ * @brief
+ * Microbenchmarks - DMA memory-to-memory engine
+ *
+ * For each size, the following are reported:
+ *  - "cpu":        newlib memcpy()
+ *  - "dma_total":  bHW_DMA_Memcpy() until completion (latency)
+ *  - "dma_submit": bHW_DMA_Memcpy() until return (CPU time consumed)
+ * The crossover point for HW_DMA_CPU_THRESHOLD is the smallest size where
+ * "dma_total" drops below "cpu". Above "dma_submit", all CPU time is free for
+ * other work while the transfer runs.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <string.h>
+#include "hw_layer.h"
+#include "hw_dma.h"
+#include "bench.h"
+#include "bench_suites.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Largest transfer size
+#define DMA_MAX_SIZE                  2048u
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Transfer sizes
+static const uint32_t aulSizes[] = { 16uL, 32uL, 64uL, 128uL, 256uL, 512uL, 1024uL, 2048uL };
+
+/// Buffers
+static uint32_t aulSrc[DMA_MAX_SIZE / sizeof(uint32_t)];
+static uint32_t aulDst[DMA_MAX_SIZE / sizeof(uint32_t)];
+
+/// Request storage
+static DMAQ_RequestTypeDef sReq;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Self-timed crossover cases
+ *
+ * @param[in] *pcSuite  Suite name
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vRun(const char* pcSuite)
+{
+  uint32_t ulOverhead = ulBENCH_GetOverhead();
+
+  // Force all transfers onto DMA
+  vHW_DMA_SetThreshold(0uL);
+
+  for (uint32_t s = 0uL; s < BENCH_COUNT(aulSizes); ++s)
+  {
+    uint32_t ulSize = aulSizes[s];
+    BENCH_ResultTypeDef sCpu, sTotal, sSubmit;
+    vBENCH_ResetResult(&sCpu);
+    vBENCH_ResetResult(&sTotal);
+    vBENCH_ResetResult(&sSubmit);
+
+    for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + BENCH_DEFAULT_RUNS; ++i)
+    {
+      uint32_t ulT0 = ulHW_GetCycleCount();
+      (void)memcpy(aulDst, aulSrc, ulSize);
+      uint32_t ulT1 = ulHW_GetCycleCount();
+
+      uint32_t ulT2 = ulHW_GetCycleCount();
+      (void)bHW_DMA_Memcpy(&sReq, aulDst, aulSrc, ulSize, NULL);
+      uint32_t ulT3 = ulHW_GetCycleCount();
+      (void)eHW_DMA_Wait(&sReq);
+      uint32_t ulT4 = ulHW_GetCycleCount();
+
+      if (i < BENCH_DEFAULT_WARMUP) continue;
+      vBENCH_AddSample(&sCpu, ulT1 - ulT0 - ulOverhead);
+      vBENCH_AddSample(&sSubmit, ulT3 - ulT2 - ulOverhead);
+      vBENCH_AddSample(&sTotal, ulT4 - ulT2 - ulOverhead);
+    }
+
+    vBENCH_Report(pcSuite, "cpu", ulSize, ulSize, &sCpu);
+    vBENCH_Report(pcSuite, "dma_total", ulSize, ulSize, &sTotal);
+    vBENCH_Report(pcSuite, "dma_submit", ulSize, ulSize, &sSubmit);
+  }
+
+  vHW_DMA_SetThreshold(HW_DMA_CPU_THRESHOLD);
+}
+
+
+/*- Global data --------------------------------------------------------------*/
+/// DMA engine benchmark suite
+const BENCH_SuiteTypeDef sBENCH_SuiteDma = {
+  .pcName = "dma",
+  .pfnCustom = vRun
+};
@@ -0,0 +1,197 @@
+/*!****************************************************************************
+ * @file
+ * bench_exec.c
+ *
+ * @brief
+ * Microbenchmarks - code placement (FLASH vs. SRAM execution)
+ *
+ * The same kernel is compiled twice, once into FLASH and once into the
+ * ".RamFunc" section which the startup code copies to SRAM along with .data.
+ * At 72 MHz, FLASH runs with 2 wait states behind the prefetch buffer, so
+ * taken branches cost more than in SRAM.
+ *
+ * The self-timed cases run shorter variants of both kernels under the DWT
+ * event counters, sampled after every call so that no 8-bit counter wraps,
+ * and report per call: instructions, CPICNT (fetch stalls and multi-cycle
+ * instructions), LSUCNT and FOLDCNT. The "empty" case is the sampling
+ * overhead included in the other cases.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdio.h>
+#include "hw_layer.h"
+#include "bench.h"
+#include "bench_suites.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Kernel iterations per run
+#define EXEC_ITERATIONS               256uL
+
+/// Kernel iterations per event counter sample (sample stays below 256 cycles)
+#define EXEC_PERF_ITERATIONS          8uL
+
+/// Kernel: branchy integer loop (CRC-32 style bit shuffling)
+#define EXEC_KERNEL(ulArg, ulIterations)                                      \
+  uint32_t ulAcc = (ulArg);                                                   \
+  for (uint32_t i = 0uL; i < (ulIterations); ++i)                             \
+  {                                                                           \
+    ulAcc = (ulAcc & 1uL) ? ((ulAcc >> 1) ^ 0xEDB88320uL) : (ulAcc >> 1);     \
+  }                                                                           \
+  ulSink = ulAcc;
+
+/// Place function in SRAM (the host build overrides it, see tools/bench_check)
+#ifndef RAMFUNC
+#define RAMFUNC                       __attribute__((section(".RamFunc"), long_call, noinline))
+#endif
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Event counter case
+typedef struct {
+  const char* pcName;             ///< Case name prefix
+  BENCH_FuncTypeDef pfnRun;       ///< Kernel
+} ExecPerfCaseTypeDef;
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Result sink, keeps kernels from being optimised away
+static volatile uint32_t ulSink;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Kernel executed from FLASH
+ *
+ * @param[in] ulArg   Kernel seed
+ * @date  19.10.2026
+ ******************************************************************************/
+static __attribute__((noinline)) void vKernelFlash(uint32_t ulArg)
+{
+  EXEC_KERNEL(ulArg, EXEC_ITERATIONS)
+}
+
+/*!****************************************************************************
+ * @brief
+ * Kernel executed from SRAM
+ *
+ * @param[in] ulArg   Kernel seed
+ * @date  19.10.2026
+ ******************************************************************************/
+static RAMFUNC void vKernelRam(uint32_t ulArg)
+{
+  EXEC_KERNEL(ulArg, EXEC_ITERATIONS)
+}
+
+/*!****************************************************************************
+ * @brief
+ * Short kernel executed from FLASH
+ *
+ * @param[in] ulArg   Kernel seed
+ * @date  19.10.2026
+ ******************************************************************************/
+static __attribute__((noinline)) void vKernelFlashShort(uint32_t ulArg)
+{
+  EXEC_KERNEL(ulArg, EXEC_PERF_ITERATIONS)
+}
+
+/*!****************************************************************************
+ * @brief
+ * Short kernel executed from SRAM
+ *
+ * @param[in] ulArg   Kernel seed
+ * @date  19.10.2026
+ ******************************************************************************/
+static RAMFUNC void vKernelRamShort(uint32_t ulArg)
+{
+  EXEC_KERNEL(ulArg, EXEC_PERF_ITERATIONS)
+}
+
+/*!****************************************************************************
+ * @brief
+ * Empty body, sampling overhead
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static __attribute__((noinline)) void vKernelEmpty(uint32_t ulArg)
+{
+  (void)ulArg;
+  __asm__ volatile ("" ::: "memory");
+}
+
+/*!****************************************************************************
+ * @brief
+ * Self-timed cases: DWT event counts per call
+ *
+ * @param[in] *pcSuite  Suite name
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vRunPerf(const char* pcSuite)
+{
+  static const ExecPerfCaseTypeDef asPerfCases[] = {
+    { .pcName = "empty", .pfnRun = vKernelEmpty },
+    { .pcName = "flash", .pfnRun = vKernelFlashShort },
+    { .pcName = "sram",  .pfnRun = vKernelRamShort }
+  };
+  static const char* const apcCounters[] = { "instr", "cpicnt", "lsucnt", "foldcnt" };
+
+  vHW_PerfEnable(true);
+  for (uint32_t c = 0uL; c < BENCH_COUNT(asPerfCases); ++c)
+  {
+    BENCH_ResultTypeDef asResults[BENCH_COUNT(apcCounters)];
+    for (uint32_t k = 0uL; k < BENCH_COUNT(apcCounters); ++k)
+    {
+      vBENCH_ResetResult(&asResults[k]);
+    }
+
+    HW_PerfTypeDef sPerf;
+    bool bExact = true;
+    uint32_t ulMask = ulBENCH_MaskIrq();
+    for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + BENCH_DEFAULT_RUNS; ++i)
+    {
+      vHW_PerfStart(&sPerf);
+      asPerfCases[c].pfnRun(0x12345678uL);
+      vHW_PerfSample(&sPerf);
+      if (i < BENCH_DEFAULT_WARMUP) continue;
+
+      HW_PerfMetricsTypeDef sMetrics;
+      vHW_PerfGetMetrics(&sPerf, &sMetrics);
+      bExact = bExact && sMetrics.bExact;
+      vBENCH_AddSample(&asResults[0], sMetrics.ulInstructions);
+      vBENCH_AddSample(&asResults[1], sPerf.ulCpi);
+      vBENCH_AddSample(&asResults[2], sPerf.ulLsu);
+      vBENCH_AddSample(&asResults[3], sPerf.ulFold);
+    }
+    vBENCH_RestoreIrq(ulMask);
+
+    // Counts that may have wrapped are not reported
+    if (!bExact) continue;
+    for (uint32_t k = 0uL; k < BENCH_COUNT(apcCounters); ++k)
+    {
+      char acCase[24];
+      (void)snprintf(acCase, sizeof(acCase), "%s_%s", asPerfCases[c].pcName, apcCounters[k]);
+      vBENCH_Report(pcSuite, acCase, 0x12345678uL, EXEC_PERF_ITERATIONS, &asResults[k]);
+    }
+  }
+  vHW_PerfEnable(false);
+}
+
+/// Benchmark cases
+static const BENCH_CaseTypeDef asCases[] = {
+  { .pcName = "flash",  .pfnRun = vKernelFlash, .ulArg = 0x12345678uL, .ulUnits = EXEC_ITERATIONS },
+  { .pcName = "sram",   .pfnRun = vKernelRam,   .ulArg = 0x12345678uL, .ulUnits = EXEC_ITERATIONS }
+};
+
+
+/*- Global data --------------------------------------------------------------*/
+/// Code placement benchmark suite
+const BENCH_SuiteTypeDef sBENCH_SuiteExec = {
+  .pcName = "exec",
+  .psCases = asCases,
+  .ulNumCases = BENCH_COUNT(asCases),
+  .pfnCustom = vRunPerf
+};
@@ -0,0 +1,335 @@
+/*!****************************************************************************
+ * @file
+ * bench_fix.c
+ *
+ * @brief
+ * Microbenchmarks - fixed-point vs. soft-float arithmetic
+ *
+ * Each case applies one operation to a block of inputs; units are
+ * operations. Cases come in pairs, the lib/fixmath function and its float
+ * equivalent from libgcc/libm (software emulation, the M3 has no FPU):
+ *  - "mul_q31"   / "mul_f32":   multiplication
+ *  - "mac_q31"   / "mac_f32":   dot product (multiply-accumulate)
+ *  - "div_q31"   / "div_f32":   division
+ *  - "sqrt_q31"  / "sqrt_f32":  square root (sqrtf)
+ *  - "sin_q31"   / "sin_f32":   sine (sinf), plus "sin_q15"
+ *  - "log2_q16"  / "log2_f32":  binary logarithm (log2f)
+ *  - "fmt_q15":                 decimal formatting, 5 digits
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <math.h>
+#include "fixmath.h"
+#include "bench.h"
+#include "bench_suites.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Operations per run
+#define FIX_BENCH_BLOCK               16uL
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vSetup(void);
+static void vMulQ31(uint32_t ulArg);
+static void vMulF32(uint32_t ulArg);
+static void vMacQ31(uint32_t ulArg);
+static void vMacF32(uint32_t ulArg);
+static void vDivQ31(uint32_t ulArg);
+static void vDivF32(uint32_t ulArg);
+static void vSqrtQ31(uint32_t ulArg);
+static void vSqrtF32(uint32_t ulArg);
+static void vSinQ31(uint32_t ulArg);
+static void vSinQ15(uint32_t ulArg);
+static void vSinF32(uint32_t ulArg);
+static void vLog2Q16(uint32_t ulArg);
+static void vLog2F32(uint32_t ulArg);
+static void vFmtQ15(uint32_t ulArg);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Inputs in (0, 1), the same values as Q31 and float
+static int32_t alIn[FIX_BENCH_BLOCK + 1u];
+static float afIn[FIX_BENCH_BLOCK + 1u];
+
+/// Result sinks, keep kernels from being optimised away
+static volatile int32_t lSink;
+static volatile float fSink;
+
+/// Benchmark cases
+static const BENCH_CaseTypeDef asCases[] = {
+  { .pcName = "mul_q31",  .pfnRun = vMulQ31,  .ulUnits = FIX_BENCH_BLOCK },
+  { .pcName = "mul_f32",  .pfnRun = vMulF32,  .ulUnits = FIX_BENCH_BLOCK },
+  { .pcName = "mac_q31",  .pfnRun = vMacQ31,  .ulUnits = FIX_BENCH_BLOCK },
+  { .pcName = "mac_f32",  .pfnRun = vMacF32,  .ulUnits = FIX_BENCH_BLOCK },
+  { .pcName = "div_q31",  .pfnRun = vDivQ31,  .ulUnits = FIX_BENCH_BLOCK },
+  { .pcName = "div_f32",  .pfnRun = vDivF32,  .ulUnits = FIX_BENCH_BLOCK },
+  { .pcName = "sqrt_q31", .pfnRun = vSqrtQ31, .ulUnits = FIX_BENCH_BLOCK },
+  { .pcName = "sqrt_f32", .pfnRun = vSqrtF32, .ulUnits = FIX_BENCH_BLOCK },
+  { .pcName = "sin_q31",  .pfnRun = vSinQ31,  .ulUnits = FIX_BENCH_BLOCK },
+  { .pcName = "sin_q15",  .pfnRun = vSinQ15,  .ulUnits = FIX_BENCH_BLOCK },
+  { .pcName = "sin_f32",  .pfnRun = vSinF32,  .ulUnits = FIX_BENCH_BLOCK },
+  { .pcName = "log2_q16", .pfnRun = vLog2Q16, .ulUnits = FIX_BENCH_BLOCK },
+  { .pcName = "log2_f32", .pfnRun = vLog2F32, .ulUnits = FIX_BENCH_BLOCK },
+  { .pcName = "fmt_q15",  .pfnRun = vFmtQ15,  .ulUnits = FIX_BENCH_BLOCK }
+};
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Generate inputs (not timed)
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSetup(void)
+{
+  uint32_t ulX = 0x12345678uL;
+  for (uint32_t i = 0uL; i <= FIX_BENCH_BLOCK; ++i)
+  {
+    ulX = ulX * 1664525uL + 1013904223uL;
+    alIn[i] = (int32_t)((ulX >> 1) | 1uL);
+    afIn[i] = (float)alIn[i] * (1.0f / 2147483648.0f);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Q31 multiplication
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vMulQ31(uint32_t ulArg)
+{
+  (void)ulArg;
+  for (uint32_t i = 0uL; i < FIX_BENCH_BLOCK; ++i)
+  {
+    lSink = lFIX_MulQ31(alIn[i], alIn[i + 1u]);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Float multiplication
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vMulF32(uint32_t ulArg)
+{
+  (void)ulArg;
+  for (uint32_t i = 0uL; i < FIX_BENCH_BLOCK; ++i)
+  {
+    fSink = afIn[i] * afIn[i + 1u];
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Q31 dot product
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vMacQ31(uint32_t ulArg)
+{
+  (void)ulArg;
+  FIX_AccTypeDef llAcc = 0;
+  for (uint32_t i = 0uL; i < FIX_BENCH_BLOCK; ++i)
+  {
+    llAcc = llFIX_MacQ31(llAcc, alIn[i], alIn[i + 1u]);
+  }
+  lSink = lFIX_AccToQ31(llAcc >> 4);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Float dot product
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vMacF32(uint32_t ulArg)
+{
+  (void)ulArg;
+  float fAcc = 0.0f;
+  for (uint32_t i = 0uL; i < FIX_BENCH_BLOCK; ++i)
+  {
+    fAcc += afIn[i] * afIn[i + 1u];
+  }
+  fSink = fAcc;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Q31 division
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vDivQ31(uint32_t ulArg)
+{
+  (void)ulArg;
+  for (uint32_t i = 0uL; i < FIX_BENCH_BLOCK; ++i)
+  {
+    lSink = lFIX_DivQ31(alIn[i] >> 1, alIn[i + 1u]);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Float division
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vDivF32(uint32_t ulArg)
+{
+  (void)ulArg;
+  for (uint32_t i = 0uL; i < FIX_BENCH_BLOCK; ++i)
+  {
+    fSink = (afIn[i] * 0.5f) / afIn[i + 1u];
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Q31 square root
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSqrtQ31(uint32_t ulArg)
+{
+  (void)ulArg;
+  for (uint32_t i = 0uL; i < FIX_BENCH_BLOCK; ++i)
+  {
+    lSink = lFIX_SqrtQ31(alIn[i]);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Float square root
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSqrtF32(uint32_t ulArg)
+{
+  (void)ulArg;
+  for (uint32_t i = 0uL; i < FIX_BENCH_BLOCK; ++i)
+  {
+    fSink = sqrtf(afIn[i]);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Q31 sine (input as angle, i.e. [0, pi))
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSinQ31(uint32_t ulArg)
+{
+  (void)ulArg;
+  for (uint32_t i = 0uL; i < FIX_BENCH_BLOCK; ++i)
+  {
+    lSink = lFIX_SinQ31((uint32_t)alIn[i]);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Q15 sine
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSinQ15(uint32_t ulArg)
+{
+  (void)ulArg;
+  for (uint32_t i = 0uL; i < FIX_BENCH_BLOCK; ++i)
+  {
+    lSink = iFIX_SinQ15((uint16_t)((uint32_t)alIn[i] >> 16));
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Float sine (same angles as the Q31 case)
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSinF32(uint32_t ulArg)
+{
+  (void)ulArg;
+  for (uint32_t i = 0uL; i < FIX_BENCH_BLOCK; ++i)
+  {
+    fSink = sinf(afIn[i] * 3.14159265f);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Binary logarithm to Q16
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vLog2Q16(uint32_t ulArg)
+{
+  (void)ulArg;
+  for (uint32_t i = 0uL; i < FIX_BENCH_BLOCK; ++i)
+  {
+    lSink = lFIX_Log2((uint32_t)alIn[i], 31uL);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Float binary logarithm
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vLog2F32(uint32_t ulArg)
+{
+  (void)ulArg;
+  for (uint32_t i = 0uL; i < FIX_BENCH_BLOCK; ++i)
+  {
+    fSink = log2f(afIn[i]);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Q15 decimal formatting
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vFmtQ15(uint32_t ulArg)
+{
+  (void)ulArg;
+  char acBuf[FIX_FORMAT_MAX];
+  for (uint32_t i = 0uL; i < FIX_BENCH_BLOCK; ++i)
+  {
+    lSink = (int32_t)ulFIX_Format(acBuf, alIn[i] >> 16, 15uL, 5uL);
+  }
+}
+
+
+/*- Global data --------------------------------------------------------------*/
+/// Fixed-point arithmetic benchmark suite
+const BENCH_SuiteTypeDef sBENCH_SuiteFix = {
+  .pcName = "fix",
+  .pfnSetup = vSetup,
+  .psCases = asCases,
+  .ulNumCases = BENCH_COUNT(asCases)
+};
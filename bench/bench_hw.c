@@ -0,0 +1,192 @@
+/*!****************************************************************************
+ * @file
+ * bench_hw.c
+ *
+ * @brief
+ * Microbenchmarks - hardware layer
+ *
+ * Also the platform of the harness on the target: DWT cycle counter, PRIMASK
+ * and the result sink. Results are written to a separate output channel so
+ * they do not interleave with console output of the benchmarks themselves:
+ *  - BENCH_SINK_ITM:         ITM stimulus port BENCH_ITM_PORT (default)
+ *  - BENCH_SINK_SEMIHOSTING: SYS_WRITE0 semihosting call. Note: requires a
+ *                            debugger with semihosting enabled, otherwise the
+ *                            BKPT instruction escalates to a HardFault.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include "stm32f1xx_hal.h"
+#include "hw_layer.h"
+#include "bench.h"
+#include "bench_suites.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/*! @brief Output sinks
+ *  @{                                                                        */
+#define BENCH_SINK_ITM                0
+#define BENCH_SINK_SEMIHOSTING        1
+/*! @}                                                                        */
+
+/// Selected output sink
+#ifndef BENCH_SINK
+#define BENCH_SINK                    BENCH_SINK_ITM
+#endif
+
+/// ITM stimulus port for results (BENCH_SINK_ITM only)
+#ifndef BENCH_ITM_PORT
+#define BENCH_ITM_PORT                1u
+#endif
+
+/// Semihosting operation: write zero-terminated string
+#define SEMIHOSTING_SYS_WRITE0        0x04uL
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Toggle LED output through the hardware layer
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vGpioToggle(uint32_t ulArg)
+{
+  (void)ulArg;
+  vHW_ToggleLed();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Read system time through the hardware layer
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vGetTime(uint32_t ulArg)
+{
+  (void)ulArg;
+  (void)ulHW_GetTime();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Pend SysTick exception and return once it has been serviced
+ *
+ * Measures the tick ISR including exception entry and return.
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vTickIsr(uint32_t ulArg)
+{
+  (void)ulArg;
+  SCB->ICSR = SCB_ICSR_PENDSTSET_Msk;
+  __DSB();
+  __ISB();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Record flight recorder event through the hardware layer
+ *
+ * @param[in] ulArg   Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vFlightRecord(uint32_t ulArg)
+{
+  (void)ulArg;
+  vHW_Record(0xBE00u, 0x1234u);
+}
+
+/// Benchmark cases
+static const BENCH_CaseTypeDef asCases[] = {
+  { .pcName = "gpio_toggle",  .pfnRun = vGpioToggle },
+  { .pcName = "get_time",     .pfnRun = vGetTime },
+  { .pcName = "flight_record", .pfnRun = vFlightRecord },
+  { .pcName = "tick_isr",     .pfnRun = vTickIsr, .ulFlags = BENCH_FLAG_IRQ }
+};
+
+
+/*- Global data --------------------------------------------------------------*/
+/// Hardware layer benchmark suite
+const BENCH_SuiteTypeDef sBENCH_SuiteHw = {
+  .pcName = "hw",
+  .psCases = asCases,
+  .ulNumCases = BENCH_COUNT(asCases)
+};
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Read cycle counter
+ *
+ * @return  (uint32_t)  DWT cycle count
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulBENCH_GetCycles(void)
+{
+  return ulHW_GetCycleCount();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get cycle counter frequency
+ *
+ * @return  (uint32_t)  Core clock in Hz
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulBENCH_GetCoreClock(void)
+{
+  return ulHW_GetCoreClkFreq();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Mask all interrupts
+ *
+ * @return  (uint32_t)  Previous PRIMASK, for vBENCH_RestoreIrq()
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulBENCH_MaskIrq(void)
+{
+  uint32_t ulPrimask = __get_PRIMASK();
+  __disable_irq();
+  return ulPrimask;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Restore interrupt mask
+ *
+ * @param[in] ulMask  PRIMASK returned by ulBENCH_MaskIrq()
+ * @date  19.10.2026
+ ******************************************************************************/
+void vBENCH_RestoreIrq(uint32_t ulMask)
+{
+  __set_PRIMASK(ulMask);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write string to result sink
+ *
+ * @param[in] *pcStr  Zero-terminated string
+ * @date  19.10.2026
+ ******************************************************************************/
+void vBENCH_Write(const char* pcStr)
+{
+#if BENCH_SINK == BENCH_SINK_SEMIHOSTING
+  register uint32_t ulOp __asm__("r0") = SEMIHOSTING_SYS_WRITE0;
+  register const char* pcArg __asm__("r1") = pcStr;
+  __asm__ volatile ("bkpt 0xAB" : "+r"(ulOp) : "r"(pcArg) : "memory");
+#else
+  while (*pcStr != '\0')
+  {
+    vHW_WriteSwoPort(BENCH_ITM_PORT, *pcStr++);
+  }
+#endif
+}
@@ -0,0 +1,233 @@
+/*!****************************************************************************
+ * @file
+ * bench_irq.c
+ *
+ * @brief
+ * Microbenchmarks - Interrupt latency per priority level
+ *
+ * A software-triggered interrupt (NVIC->STIR) at CRITICAL or DRIVER level of
+ * the priority plan stamps the cycle counter on entry. Reported cases
+ * (cycles from trigger to handler; jitter is max - min):
+ *  - "critical":         CRITICAL level, triggered from thread mode
+ *  - "driver":           DRIVER level, triggered from thread mode
+ *  - "critical_locked":  CRITICAL level, triggered inside ulHW_IRQ_Lock()
+ *  - "critical_nested":  CRITICAL level, triggered from a running DRIVER
+ *                        level handler
+ *  - "critical_load":    CRITICAL level under load: back-to-back DMA
+ *                        transfers with completion interrupts, trigger
+ *                        inside a critical section of arg cycles at most
+ *  - "driver_load":      DRIVER level under the same load; the handler only
+ *                        runs when the critical section ends
+ *
+ * The interrupts are SWI_LAT_CRITICAL and SWI_LAT_DRIVER in hw_iodef.h.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include "stm32f1xx_hal.h"
+#include "hw_dma.h"
+#include "hw_iodef.h"
+#include "hw_irq.h"
+#include "hw_layer.h"
+#include "bench.h"
+#include "bench_suites.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Measured runs of the load cases
+#define IRQ_LOAD_RUNS                 256uL
+
+/// Maximum critical section length in the load cases (cycles)
+#define IRQ_LOAD_HOLD_MAX             256uL
+
+/// Background DMA transfer size in bytes
+#define IRQ_LOAD_DMA_SIZE             1024u
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Cycle counter at handler entry
+static volatile uint32_t ulStamp;
+
+/// DRIVER level handler triggers CRITICAL level, and its trigger time
+static volatile bool bNest;
+static volatile uint32_t ulNestT0;
+
+/// Background DMA load
+static volatile bool bLoad;
+static DMAQ_RequestTypeDef sLoadReq;
+static uint32_t aulLoadSrc[IRQ_LOAD_DMA_SIZE / sizeof(uint32_t)];
+static uint32_t aulLoadDst[IRQ_LOAD_DMA_SIZE / sizeof(uint32_t)];
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Background DMA completion: resubmit while load is requested
+ *
+ * @param[in,out] *psReq  Completed request
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vLoadDone(DMAQ_RequestTypeDef* psReq)
+{
+  if (bLoad)
+  {
+    (void)bHW_DMA_Memcpy(psReq, aulLoadDst, aulLoadSrc, IRQ_LOAD_DMA_SIZE, vLoadDone);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Trigger interrupt and get its entry latency
+ *
+ * @param[in] eIrq      Software-triggered interrupt
+ * @param[in] ulHold    Cycles to stay in a critical section after the
+ *                      trigger, 0 for none
+ * @return  (uint32_t)  Cycles from trigger to handler entry
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulTrigger(IRQn_Type eIrq, uint32_t ulHold)
+{
+  uint32_t ulLock = (ulHold != 0uL) ? ulHW_IRQ_Lock() : 0uL;
+
+  uint32_t ulT0 = ulHW_GetCycleCount();
+  NVIC->STIR = (uint32_t)eIrq;
+  __DSB();
+  __ISB();
+
+  if (ulHold != 0uL)
+  {
+    while (ulHW_GetCycleCount() - ulT0 < ulHold)
+    {
+    }
+    vHW_IRQ_Unlock(ulLock);
+    __ISB();
+  }
+  return ulStamp - ulT0;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Self-timed cases
+ *
+ * @param[in] *pcSuite  Suite name
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vRun(const char* pcSuite)
+{
+  uint32_t ulOverhead = ulBENCH_GetOverhead();
+  uint32_t ulSeed = 0x9E3779B9uL;
+  BENCH_ResultTypeDef sCritical, sDriver;
+
+  NVIC_ClearPendingIRQ(SWI_LAT_CRITICAL_IRQn);
+  NVIC_ClearPendingIRQ(SWI_LAT_DRIVER_IRQn);
+  NVIC_EnableIRQ(SWI_LAT_CRITICAL_IRQn);
+  NVIC_EnableIRQ(SWI_LAT_DRIVER_IRQn);
+
+  // Idle system
+  vBENCH_ResetResult(&sCritical);
+  vBENCH_ResetResult(&sDriver);
+  for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + BENCH_DEFAULT_RUNS; ++i)
+  {
+    uint32_t ulCritical = ulTrigger(SWI_LAT_CRITICAL_IRQn, 0uL);
+    uint32_t ulDriver = ulTrigger(SWI_LAT_DRIVER_IRQn, 0uL);
+    if (i < BENCH_DEFAULT_WARMUP) continue;
+    vBENCH_AddSample(&sCritical, ulCritical - ulOverhead);
+    vBENCH_AddSample(&sDriver, ulDriver - ulOverhead);
+  }
+  vBENCH_Report(pcSuite, "critical", 0uL, 0uL, &sCritical);
+  vBENCH_Report(pcSuite, "driver", 0uL, 0uL, &sDriver);
+
+  // Critical section held: CRITICAL level must not be delayed
+  vBENCH_ResetResult(&sCritical);
+  for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + BENCH_DEFAULT_RUNS; ++i)
+  {
+    uint32_t ulCritical = ulTrigger(SWI_LAT_CRITICAL_IRQn, IRQ_LOAD_HOLD_MAX);
+    if (i >= BENCH_DEFAULT_WARMUP) vBENCH_AddSample(&sCritical, ulCritical - ulOverhead);
+  }
+  vBENCH_Report(pcSuite, "critical_locked", IRQ_LOAD_HOLD_MAX, 0uL, &sCritical);
+
+  // Preemption of a running handler
+  vBENCH_ResetResult(&sCritical);
+  bNest = true;
+  for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + BENCH_DEFAULT_RUNS; ++i)
+  {
+    NVIC->STIR = (uint32_t)SWI_LAT_DRIVER_IRQn;
+    __DSB();
+    __ISB();
+    if (i >= BENCH_DEFAULT_WARMUP) vBENCH_AddSample(&sCritical, ulStamp - ulNestT0 - ulOverhead);
+  }
+  bNest = false;
+  vBENCH_Report(pcSuite, "critical_nested", 0uL, 0uL, &sCritical);
+
+  // Under load: DMA streaming, critical sections of random length
+  vHW_DMA_SetThreshold(0uL);
+  bLoad = true;
+  (void)bHW_DMA_Memcpy(&sLoadReq, aulLoadDst, aulLoadSrc, IRQ_LOAD_DMA_SIZE, vLoadDone);
+
+  vBENCH_ResetResult(&sCritical);
+  vBENCH_ResetResult(&sDriver);
+  for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + IRQ_LOAD_RUNS; ++i)
+  {
+    ulSeed = ulSeed * 1664525uL + 1013904223uL;
+    uint32_t ulHold = 1uL + (ulSeed >> 24) % IRQ_LOAD_HOLD_MAX;
+    uint32_t ulCritical = ulTrigger(SWI_LAT_CRITICAL_IRQn, ulHold);
+    uint32_t ulDriver = ulTrigger(SWI_LAT_DRIVER_IRQn, ulHold);
+    if (i < BENCH_DEFAULT_WARMUP) continue;
+    vBENCH_AddSample(&sCritical, ulCritical - ulOverhead);
+    vBENCH_AddSample(&sDriver, ulDriver - ulOverhead);
+  }
+
+  bLoad = false;
+  (void)eHW_DMA_Wait(&sLoadReq);
+  vHW_DMA_SetThreshold(HW_DMA_CPU_THRESHOLD);
+
+  vBENCH_Report(pcSuite, "critical_load", IRQ_LOAD_HOLD_MAX, 0uL, &sCritical);
+  vBENCH_Report(pcSuite, "driver_load", IRQ_LOAD_HOLD_MAX, 0uL, &sDriver);
+
+  NVIC_DisableIRQ(SWI_LAT_CRITICAL_IRQn);
+  NVIC_DisableIRQ(SWI_LAT_DRIVER_IRQn);
+}
+
+
+/*- Global data --------------------------------------------------------------*/
+/// Interrupt latency benchmark suite
+const BENCH_SuiteTypeDef sBENCH_SuiteIrq = {
+  .pcName = "irq",
+  .pfnCustom = vRun
+};
+
+
+/*- Interrupt handlers -------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * CRITICAL level benchmark interrupt handler
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void SWI_LAT_CRITICAL_IRQHandler(void)
+{
+  ulStamp = ulHW_GetCycleCount();
+}
+
+/*!****************************************************************************
+ * @brief
+ * DRIVER level benchmark interrupt handler
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void SWI_LAT_DRIVER_IRQHandler(void)
+{
+  uint32_t ulNow = ulHW_GetCycleCount();
+  if (bNest)
+  {
+    ulNestT0 = ulNow;
+    NVIC->STIR = (uint32_t)SWI_LAT_CRITICAL_IRQn;
+    __DSB();
+    __ISB();
+  }
+  else
+  {
+    ulStamp = ulNow;
+  }
+}
@@ -0,0 +1,131 @@
+/*!****************************************************************************
+ * @file
+ * bench_log.c
+ *
+ * @brief
+ * Microbenchmarks - SPI NOR log
+ *
+ * Measures the SPI driver and the log sink on the attached flash:
+ *  - "xfer_poll":  polled read below the DMA threshold, incl. command
+ *  - "xfer_dma":   DMA read of one page, incl. command
+ *  - "write":      vHW_LogWrite() of one page payload, incl. stalls
+ *  - "sustained":  LOG_SUSTAINED_PAGES payloads back to back (single run)
+ * Units are bytes. The write cases append test data to the log; the suite is
+ * skipped if no flash was detected.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <string.h>
+#include "stm32f1xx_hal.h"
+#include "hw_layer.h"
+#include "hw_spi.h"
+#include "norlog.h"
+#include "spinor.h"
+#include "bench.h"
+#include "bench_suites.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Pages written for the "sustained" case (spans several sector erases)
+#define LOG_SUSTAINED_PAGES           128uL
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Transfer buffer (command header followed by data)
+static uint8_t aucBuf[4u + SPINOR_PAGE_SIZE];
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Measure read of ulLen bytes from address 0
+ *
+ * @param[out] *psResult  Result
+ * @param[in] ulLen       Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vMeasureRead(BENCH_ResultTypeDef* psResult, uint32_t ulLen)
+{
+  uint32_t ulOverhead = ulBENCH_GetOverhead();
+  vBENCH_ResetResult(psResult);
+
+  for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + BENCH_DEFAULT_RUNS; ++i)
+  {
+    (void)memset(aucBuf, 0, 4u);
+    aucBuf[0] = SPINOR_CMD_READ;
+
+    // Log is idle after a flush, the poll timer cannot interfere
+    __disable_irq();
+    uint32_t ulT0 = ulHW_GetCycleCount();
+    vHW_SPI_Select(true);
+    vHW_SPI_Transfer(aucBuf, NULL, 4uL);
+    vHW_SPI_Transfer(NULL, &aucBuf[4], ulLen);
+    vHW_SPI_Select(false);
+    uint32_t ulT1 = ulHW_GetCycleCount();
+    __enable_irq();
+
+    if (i < BENCH_DEFAULT_WARMUP) continue;
+    vBENCH_AddSample(psResult, ulT1 - ulT0 - ulOverhead);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Self-timed cases
+ *
+ * @param[in] *pcSuite  Suite name
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vRun(const char* pcSuite)
+{
+  if (!bHW_LogIsReady()) return;
+  uint32_t ulOverhead = ulBENCH_GetOverhead();
+  BENCH_ResultTypeDef sResult;
+
+  vHW_LogFlush();
+  vMeasureRead(&sResult, HW_SPI_DMA_THRESHOLD - 1uL);
+  vBENCH_Report(pcSuite, "xfer_poll", HW_SPI_DMA_THRESHOLD - 1uL, HW_SPI_DMA_THRESHOLD - 1uL,
+                &sResult);
+  vMeasureRead(&sResult, SPINOR_PAGE_SIZE);
+  vBENCH_Report(pcSuite, "xfer_dma", SPINOR_PAGE_SIZE, SPINOR_PAGE_SIZE, &sResult);
+
+  // Page payloads, interrupts enabled (programming completes in the background)
+  for (uint32_t i = 0uL; i < sizeof(aucBuf); ++i)
+  {
+    aucBuf[i] = (uint8_t)('!' + i % 94u);
+  }
+  vBENCH_ResetResult(&sResult);
+  for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + BENCH_DEFAULT_RUNS; ++i)
+  {
+    uint32_t ulT0 = ulHW_GetCycleCount();
+    vHW_LogWrite(aucBuf, NORLOG_PAYLOAD);
+    uint32_t ulT1 = ulHW_GetCycleCount();
+
+    if (i < BENCH_DEFAULT_WARMUP) continue;
+    vBENCH_AddSample(&sResult, ulT1 - ulT0 - ulOverhead);
+  }
+  vBENCH_Report(pcSuite, "write", NORLOG_PAYLOAD, NORLOG_PAYLOAD, &sResult);
+
+  // Sustained rate including sector erases
+  vBENCH_ResetResult(&sResult);
+  uint32_t ulT0 = ulHW_GetCycleCount();
+  for (uint32_t i = 0uL; i < LOG_SUSTAINED_PAGES; ++i)
+  {
+    vHW_LogWrite(aucBuf, NORLOG_PAYLOAD);
+  }
+  uint32_t ulT1 = ulHW_GetCycleCount();
+  vBENCH_AddSample(&sResult, ulT1 - ulT0 - ulOverhead);
+  uint32_t ulBytes = LOG_SUSTAINED_PAGES * NORLOG_PAYLOAD;
+  vBENCH_Report(pcSuite, "sustained", ulBytes, ulBytes, &sResult);
+  vHW_LogFlush();
+}
+
+
+/*- Global data --------------------------------------------------------------*/
+/// SPI NOR log benchmark suite
+const BENCH_SuiteTypeDef sBENCH_SuiteLog = {
+  .pcName = "log",
+  .pfnCustom = vRun
+};
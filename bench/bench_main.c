@@ -0,0 +1,79 @@
+/*!****************************************************************************
+ * @file
+ * bench_main.c
+ *
+ * @brief
+ * Microbenchmark firmware entrypoint
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdio.h>
+#include "vt100.h"
+#include "hw_layer.h"
+#include "bench.h"
+#include "bench_suites.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// LED toggle interval after completion in milliseconds
+#define LED_TOGGLE_INTERVAL           100uL
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Benchmark suites, run in order
+static const BENCH_SuiteTypeDef* const apsSuites[] = {
+  &sBENCH_SuiteExec,
+  &sBENCH_SuiteMem,
+  &sBENCH_SuiteDma,
+  &sBENCH_SuiteHw,
+  &sBENCH_SuiteTimer,
+  &sBENCH_SuiteTrace,
+  &sBENCH_SuiteNvm,
+  &sBENCH_SuiteCrc,
+  &sBENCH_SuiteOs,
+  &sBENCH_SuiteSpsc,
+  &sBENCH_SuiteIrq,
+  &sBENCH_SuiteLog,
+  &sBENCH_SuiteStdio,
+  &sBENCH_SuiteFix
+};
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Benchmark firmware entrypoint
+ *
+ * Runs all suites once, then signals completion by fast LED blinking.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(void)
+{
+  vHW_Init();
+
+  printf(VT100_ERASE_DISPLAY "hello-stm32f103 microbenchmarks\r\n");
+
+  vBENCH_Init();
+  for (uint32_t i = 0uL; i < BENCH_COUNT(apsSuites); ++i)
+  {
+    printf("running suite \"%s\"\r\n", apsSuites[i]->pcName);
+    vBENCH_RunSuite(apsSuites[i]);
+  }
+  vBENCH_Finish();
+
+  printf("done\r\n");
+
+  uint32_t ulLastToggle = ulHW_GetTime();
+  while (1)
+  {
+    uint32_t ulNow = ulHW_GetTime();
+    if (ulNow - ulLastToggle > LED_TOGGLE_INTERVAL)
+    {
+      vHW_ToggleLed();
+      ulLastToggle = ulNow;
+    }
+  }
+}
@@ -0,0 +1,99 @@
+/*!****************************************************************************
+ * @file
+ * bench_mem.c
+ *
+ * @brief
+ * Microbenchmarks - newlib memcpy/memset
+ *
+ * Case argument encodes the transfer size in bytes (bits 0..15) and the
+ * destination misalignment in bytes (bits 16..17). The source buffer is always
+ * word-aligned, so a non-zero offset yields a relatively misaligned copy.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <string.h>
+#include "bench.h"
+#include "bench_suites.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Largest transfer size
+#define MEM_MAX_SIZE                  1024u
+
+/// Encode case argument
+#define MEM_ARG(size, ofs)            ((uint32_t)(size) | ((uint32_t)(ofs) << 16))
+
+/// Decode transfer size
+#define MEM_SIZE(arg)                 ((arg) & 0xFFFFuL)
+
+/// Decode destination offset
+#define MEM_OFS(arg)                  (((arg) >> 16) & 0x3uL)
+
+/// Cases for one function, all sizes at one offset
+#define MEM_CASES(name, fn, ofs)                                              \
+  { .pcName = name, .pfnRun = fn, .ulArg = MEM_ARG(4, ofs), .ulUnits = 4 },   \
+  { .pcName = name, .pfnRun = fn, .ulArg = MEM_ARG(16, ofs), .ulUnits = 16 }, \
+  { .pcName = name, .pfnRun = fn, .ulArg = MEM_ARG(64, ofs), .ulUnits = 64 }, \
+  { .pcName = name, .pfnRun = fn, .ulArg = MEM_ARG(256, ofs), .ulUnits = 256 }, \
+  { .pcName = name, .pfnRun = fn, .ulArg = MEM_ARG(1024, ofs), .ulUnits = 1024 }
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Source buffer
+static uint32_t aulSrc[MEM_MAX_SIZE / sizeof(uint32_t)];
+
+/// Destination buffer (with room for misalignment)
+static uint32_t aulDst[MEM_MAX_SIZE / sizeof(uint32_t) + 1u];
+
+/// Buffer pointers, volatile to keep the compiler from specialising calls
+static uint8_t* volatile pucSrc = (uint8_t*)aulSrc;
+static uint8_t* volatile pucDst = (uint8_t*)aulDst;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * memcpy() case
+ *
+ * @param[in] ulArg   Encoded size and offset
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vMemcpy(uint32_t ulArg)
+{
+  (void)memcpy(pucDst + MEM_OFS(ulArg), pucSrc, MEM_SIZE(ulArg));
+}
+
+/*!****************************************************************************
+ * @brief
+ * memset() case
+ *
+ * @param[in] ulArg   Encoded size and offset
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vMemset(uint32_t ulArg)
+{
+  (void)memset(pucDst + MEM_OFS(ulArg), 0x5A, MEM_SIZE(ulArg));
+}
+
+/// Benchmark cases
+static const BENCH_CaseTypeDef asCases[] = {
+  MEM_CASES("memcpy", vMemcpy, 0),
+  MEM_CASES("memcpy", vMemcpy, 1),
+  MEM_CASES("memcpy", vMemcpy, 2),
+  MEM_CASES("memcpy", vMemcpy, 3),
+  MEM_CASES("memset", vMemset, 0),
+  MEM_CASES("memset", vMemset, 1),
+  MEM_CASES("memset", vMemset, 2),
+  MEM_CASES("memset", vMemset, 3)
+};
+
+
+/*- Global data --------------------------------------------------------------*/
+/// Memory function benchmark suite
+const BENCH_SuiteTypeDef sBENCH_SuiteMem = {
+  .pcName = "mem",
+  .psCases = asCases,
+  .ulNumCases = BENCH_COUNT(asCases)
+};
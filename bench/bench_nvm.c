@@ -0,0 +1,193 @@
+/*!****************************************************************************
+ * @file
+ * bench_nvm.c
+ *
+ * @brief
+ * Microbenchmarks - non-volatile key-value store
+ *
+ * The store logic is measured against flash simulated in RAM, so that the
+ * numbers are not dominated by flash programming time and the benchmark does
+ * not wear the flash. For each value size, the following are reported:
+ *  - "get":        lKVS_Get() of an existing key
+ *  - "put_ram":    bKVS_Put() with a changed value, incl. occasional reclaim
+ *  - "put_flash":  bHW_NVM_Put() on the real storage region (fewer runs)
+ * Units are bytes. Additionally, "mount" reports bKVS_Mount() of the filled
+ * simulated store, arg = number of keys.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <string.h>
+#include "stm32f1xx_hal.h"
+#include "hw_layer.h"
+#include "hw_nvm.h"
+#include "kvstore.h"
+#include "bench.h"
+#include "bench_suites.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Simulated flash pages
+#define NVM_SIM_PAGES                 4u
+
+/// Keys filled into simulated store before measuring
+#define NVM_FILL_KEYS                 16u
+
+/// Key used for measurements
+#define NVM_BENCH_KEY                 0xBE00u
+
+/// Runs of "put_flash" (limits flash wear)
+#define NVM_FLASH_RUNS                8uL
+
+
+/*- Private functions --------------------------------------------------------*/
+static bool bSimErase(uintptr_t ulAddr);
+static bool bSimProgram(uintptr_t ulAddr, const uint16_t* puiData, uint32_t ulCount);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Value sizes
+static const uint32_t aulSizes[] = { 4uL, 16uL, 64uL, 256uL };
+
+/// Simulated flash
+static uint16_t auiSimFlash[NVM_SIM_PAGES * HW_NVM_PAGE_SIZE / 2u];
+
+/// Simulated flash driver
+static const KVS_FlashTypeDef sSimFlash = {
+  .ulBase = (uintptr_t)auiSimFlash,
+  .ulPageSize = HW_NVM_PAGE_SIZE,
+  .ulNumPages = NVM_SIM_PAGES,
+  .pfnErase = bSimErase,
+  .pfnProgram = bSimProgram
+};
+
+/// Store on simulated flash
+static KVS_TypeDef sKvs;
+
+/// Value buffers
+static uint8_t aucValue[KVS_MAX_VALUE];
+static uint8_t aucRead[KVS_MAX_VALUE];
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Erase simulated flash page
+ *
+ * @param[in] ulAddr  Page address
+ * @return  (bool)  Success
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimErase(uintptr_t ulAddr)
+{
+  (void)memset((void*)ulAddr, 0xFF, HW_NVM_PAGE_SIZE);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Program simulated flash
+ *
+ * @param[in] ulAddr      Destination address
+ * @param[in] *puiData    Data
+ * @param[in] ulCount     Number of half-words
+ * @return  (bool)  Success
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimProgram(uintptr_t ulAddr, const uint16_t* puiData, uint32_t ulCount)
+{
+  uint16_t* puiDst = (uint16_t*)ulAddr;
+  for (uint32_t i = 0uL; i < ulCount; ++i)
+  {
+    puiDst[i] &= puiData[i];
+  }
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Self-timed cases
+ *
+ * @param[in] *pcSuite  Suite name
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vRun(const char* pcSuite)
+{
+  uint32_t ulOverhead = ulBENCH_GetOverhead();
+
+  // Empty simulated store with some background keys
+  (void)memset(auiSimFlash, 0xFF, sizeof(auiSimFlash));
+  (void)bKVS_Mount(&sKvs, &sSimFlash);
+  for (uint16_t k = 1u; k <= NVM_FILL_KEYS; ++k)
+  {
+    (void)bKVS_Put(&sKvs, k, &k, sizeof(k));
+  }
+
+  for (uint32_t s = 0uL; s < BENCH_COUNT(aulSizes); ++s)
+  {
+    uint32_t ulSize = aulSizes[s];
+    BENCH_ResultTypeDef sGet, sPut, sFlash;
+    vBENCH_ResetResult(&sGet);
+    vBENCH_ResetResult(&sPut);
+    vBENCH_ResetResult(&sFlash);
+
+    for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + BENCH_DEFAULT_RUNS; ++i)
+    {
+      aucValue[0] = (uint8_t)i;
+
+      __disable_irq();
+      uint32_t ulT0 = ulHW_GetCycleCount();
+      (void)bKVS_Put(&sKvs, NVM_BENCH_KEY, aucValue, ulSize);
+      uint32_t ulT1 = ulHW_GetCycleCount();
+      (void)lKVS_Get(&sKvs, NVM_BENCH_KEY, aucRead, sizeof(aucRead));
+      uint32_t ulT2 = ulHW_GetCycleCount();
+      __enable_irq();
+
+      if (i < BENCH_DEFAULT_WARMUP) continue;
+      vBENCH_AddSample(&sPut, ulT1 - ulT0 - ulOverhead);
+      vBENCH_AddSample(&sGet, ulT2 - ulT1 - ulOverhead);
+    }
+
+    // Real flash, interrupts stay enabled (programming stalls the bus anyway)
+    for (uint32_t i = 0uL; bHW_NVM_IsReady() && (i < NVM_FLASH_RUNS); ++i)
+    {
+      aucValue[0] = (uint8_t)i;
+
+      uint32_t ulT0 = ulHW_GetCycleCount();
+      (void)bHW_NVM_Put(NVM_BENCH_KEY, aucValue, ulSize);
+      uint32_t ulT1 = ulHW_GetCycleCount();
+
+      vBENCH_AddSample(&sFlash, ulT1 - ulT0 - ulOverhead);
+    }
+
+    vBENCH_Report(pcSuite, "get", ulSize, ulSize, &sGet);
+    vBENCH_Report(pcSuite, "put_ram", ulSize, ulSize, &sPut);
+    vBENCH_Report(pcSuite, "put_flash", ulSize, ulSize, &sFlash);
+  }
+  (void)bHW_NVM_Delete(NVM_BENCH_KEY);
+
+  // Mount (index rebuild) of filled simulated store
+  BENCH_ResultTypeDef sMount;
+  vBENCH_ResetResult(&sMount);
+  for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + BENCH_DEFAULT_RUNS; ++i)
+  {
+    __disable_irq();
+    uint32_t ulT0 = ulHW_GetCycleCount();
+    (void)bKVS_Mount(&sKvs, &sSimFlash);
+    uint32_t ulT1 = ulHW_GetCycleCount();
+    __enable_irq();
+
+    if (i < BENCH_DEFAULT_WARMUP) continue;
+    vBENCH_AddSample(&sMount, ulT1 - ulT0 - ulOverhead);
+  }
+  vBENCH_Report(pcSuite, "mount", sKvs.ulKeys, 1uL, &sMount);
+}
+
+
+/*- Global data --------------------------------------------------------------*/
+/// Non-volatile store benchmark suite
+const BENCH_SuiteTypeDef sBENCH_SuiteNvm = {
+  .pcName = "nvm",
+  .pfnCustom = vRun
+};
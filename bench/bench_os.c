@@ -0,0 +1,258 @@
+/*!****************************************************************************
+ * @file
+ * bench_os.c
+ *
+ * @brief
+ * Microbenchmarks - Kernel
+ *
+ * The cases run in kernel threads; the kernel is started and stopped by the
+ * suite. Reported cases:
+ *  - "yield":      round trip between two threads of equal priority
+ *                  (units = 2 switches)
+ *  - "sem_wake":   bHW_OS_SemGive() until a higher-priority waiter runs
+ *  - "irq_entry":  software-triggered interrupt until its handler runs
+ *  - "irq_wake":   software-triggered interrupt giving a semaphore until a
+ *                  waiting thread runs
+ *  - "mutex":      uncontended lock and unlock
+ *  - "queue":      send and receive of a 4-byte item without waiters
+ *
+ * The interrupt cases use the otherwise unused CAN1 SCE interrupt, triggered
+ * through NVIC->STIR (SWI_OS in hw_iodef.h, priority from the hw_irq plan).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include "stm32f1xx_hal.h"
+#include "hw_iodef.h"
+#include "hw_layer.h"
+#include "hw_os.h"
+#include "bench.h"
+#include "bench_suites.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Thread stack size in words
+#define OS_STACK_WORDS                128u
+
+/*! @brief Thread priorities
+ *  @{                                                                        */
+#define OS_PRIO_CTRL                  1u
+#define OS_PRIO_WAITER                3u
+/*! @}                                                                        */
+
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Measured cases
+typedef enum {
+  OS_CASE_YIELD = 0,
+  OS_CASE_SEM_WAKE,
+  OS_CASE_IRQ_ENTRY,
+  OS_CASE_IRQ_WAKE,
+  OS_CASE_MUTEX,
+  OS_CASE_QUEUE,
+  OS_NUM_CASES
+} OS_CaseTypeDef;
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Threads
+static HW_OS_ThreadTypeDef sCtrl;
+static HW_OS_ThreadTypeDef sPeer;
+static HW_OS_ThreadTypeDef sWaiter;
+static uint32_t aulCtrlStack[OS_STACK_WORDS];
+static uint32_t aulPeerStack[OS_STACK_WORDS];
+static uint32_t aulWaiterStack[OS_STACK_WORDS];
+
+/// Kernel objects
+static HW_OS_SemTypeDef sSem;
+static HW_OS_MutexTypeDef sMutex;
+static HW_OS_QueueTypeDef sQueue;
+static uint32_t aulQueueBuf[4];
+
+/// Peer thread keeps yielding
+static volatile bool bPeerRun;
+
+/// Interrupt gives semaphore instead of recording entry time
+static volatile bool bIrqGive;
+
+/// Timestamp taken by interrupt or waiter
+static volatile uint32_t ulStamp;
+
+/// Results
+static BENCH_ResultTypeDef asResults[OS_NUM_CASES];
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Peer thread: yield back to the control thread
+ *
+ * @param[in] *pvArg  Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vPeerThread(void* pvArg)
+{
+  (void)pvArg;
+  while (bPeerRun)
+  {
+    vHW_OS_Yield();
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Waiter thread: take timestamp when woken
+ *
+ * @param[in] *pvArg  Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vWaiterThread(void* pvArg)
+{
+  (void)pvArg;
+  while (1)
+  {
+    (void)bHW_OS_SemTake(&sSem, HW_OS_WAIT_FOREVER);
+    ulStamp = ulHW_GetCycleCount();
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Control thread: run all cases, then stop the kernel
+ *
+ * @param[in] *pvArg  Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vCtrlThread(void* pvArg)
+{
+  (void)pvArg;
+  uint32_t ulOverhead = ulBENCH_GetOverhead();
+
+  for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + BENCH_DEFAULT_RUNS; ++i)
+  {
+    uint32_t aulCycles[OS_NUM_CASES];
+
+    // Round trip through the peer thread
+    uint32_t ulT0 = ulHW_GetCycleCount();
+    vHW_OS_Yield();
+    aulCycles[OS_CASE_YIELD] = ulHW_GetCycleCount() - ulT0;
+
+    // Waiter preempts on give
+    ulT0 = ulHW_GetCycleCount();
+    (void)bHW_OS_SemGive(&sSem);
+    aulCycles[OS_CASE_SEM_WAKE] = ulStamp - ulT0;
+
+    // Handler records its entry
+    bIrqGive = false;
+    ulT0 = ulHW_GetCycleCount();
+    NVIC->STIR = (uint32_t)SWI_OS_IRQn;
+    __DSB();
+    __ISB();
+    aulCycles[OS_CASE_IRQ_ENTRY] = ulStamp - ulT0;
+
+    // Handler wakes waiter
+    bIrqGive = true;
+    ulT0 = ulHW_GetCycleCount();
+    NVIC->STIR = (uint32_t)SWI_OS_IRQn;
+    __DSB();
+    __ISB();
+    aulCycles[OS_CASE_IRQ_WAKE] = ulStamp - ulT0;
+
+    ulT0 = ulHW_GetCycleCount();
+    (void)bHW_OS_MutexLock(&sMutex, HW_OS_WAIT_FOREVER);
+    (void)bHW_OS_MutexUnlock(&sMutex);
+    aulCycles[OS_CASE_MUTEX] = ulHW_GetCycleCount() - ulT0;
+
+    uint32_t ulItem = i;
+    ulT0 = ulHW_GetCycleCount();
+    (void)bHW_OS_QueueSend(&sQueue, &ulItem, HW_OS_NO_WAIT);
+    (void)bHW_OS_QueueReceive(&sQueue, &ulItem, HW_OS_NO_WAIT);
+    aulCycles[OS_CASE_QUEUE] = ulHW_GetCycleCount() - ulT0;
+
+    if (i < BENCH_DEFAULT_WARMUP) continue;
+    for (uint32_t c = 0uL; c < OS_NUM_CASES; ++c)
+    {
+      vBENCH_AddSample(&asResults[c], aulCycles[c] - ulOverhead);
+    }
+  }
+
+  // Let the peer thread terminate
+  bPeerRun = false;
+  vHW_OS_Yield();
+
+  vHW_OS_Stop();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run kernel benchmarks
+ *
+ * @param[in] *pcSuite  Suite name
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vRun(const char* pcSuite)
+{
+  static const char* const apcCases[OS_NUM_CASES] = {
+    "yield", "sem_wake", "irq_entry", "irq_wake", "mutex", "queue"
+  };
+  static const uint32_t aulUnits[OS_NUM_CASES] = { 2uL, 1uL, 1uL, 1uL, 1uL, 1uL };
+
+  for (uint32_t c = 0uL; c < OS_NUM_CASES; ++c)
+  {
+    vBENCH_ResetResult(&asResults[c]);
+  }
+
+  vHW_OS_Init();
+  vHW_OS_SemInit(&sSem, 0uL, 1uL);
+  vHW_OS_MutexInit(&sMutex);
+  vHW_OS_QueueInit(&sQueue, aulQueueBuf, sizeof(uint32_t), BENCH_COUNT(aulQueueBuf));
+  bPeerRun = true;
+  (void)bHW_OS_ThreadCreate(&sCtrl, "ctrl", vCtrlThread, NULL,
+                            aulCtrlStack, sizeof(aulCtrlStack), OS_PRIO_CTRL);
+  (void)bHW_OS_ThreadCreate(&sPeer, "peer", vPeerThread, NULL,
+                            aulPeerStack, sizeof(aulPeerStack), OS_PRIO_CTRL);
+  (void)bHW_OS_ThreadCreate(&sWaiter, "waiter", vWaiterThread, NULL,
+                            aulWaiterStack, sizeof(aulWaiterStack), OS_PRIO_WAITER);
+
+  NVIC_ClearPendingIRQ(SWI_OS_IRQn);
+  NVIC_EnableIRQ(SWI_OS_IRQn);
+
+  vHW_OS_Start();
+
+  NVIC_DisableIRQ(SWI_OS_IRQn);
+
+  for (uint32_t c = 0uL; c < OS_NUM_CASES; ++c)
+  {
+    vBENCH_Report(pcSuite, apcCases[c], 0uL, aulUnits[c], &asResults[c]);
+  }
+}
+
+
+/*- Global data --------------------------------------------------------------*/
+/// Kernel benchmark suite
+const BENCH_SuiteTypeDef sBENCH_SuiteOs = {
+  .pcName = "os",
+  .pfnCustom = vRun
+};
+
+
+/*- Interrupt handlers -------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Benchmark interrupt handler
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void SWI_OS_IRQHandler(void)
+{
+  if (bIrqGive)
+  {
+    (void)bHW_OS_SemGive(&sSem);
+  }
+  else
+  {
+    ulStamp = ulHW_GetCycleCount();
+  }
+}
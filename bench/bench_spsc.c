@@ -0,0 +1,232 @@
+/*!****************************************************************************
+ * @file
+ * bench_spsc.c
+ *
+ * @brief
+ * Microbenchmarks - Lock-free SPSC queue
+ *
+ * On a queue of 32-bit items, the following are reported:
+ *  - "push_pop":   single push followed by single pop
+ *  - "bulk":       ulPushBulk() + ulPopBulk() of arg items (units = items)
+ *  - "span":       write span filled and committed, read span consumed and
+ *                  committed, arg items (units = items)
+ *  - "locked":     push + pop of a ring guarded by PRIMASK, for comparison
+ *  - "irq_push":   software-triggered interrupt pushing one item, until the
+ *                  consumer has popped it
+ *
+ * The interrupt case uses the otherwise unused CAN1 RX1 interrupt, triggered
+ * through NVIC->STIR (SWI_SPSC in hw_iodef.h, priority from the hw_irq plan).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include "stm32f1xx_hal.h"
+#include "hw_iodef.h"
+#include "hw_layer.h"
+#include "spsc.h"
+#include "bench.h"
+#include "bench_suites.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Queue capacity in items
+#define SPSC_BENCH_SIZE               64u
+
+
+
+/*- Type definitions ---------------------------------------------------------*/
+SPSC_DEFINE(Bench, uint32_t, SPSC_BENCH_SIZE)
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Bulk sizes
+static const uint32_t aulSizes[] = { 1uL, 8uL, 32uL };
+
+/// Queue under test
+static SPSC_Bench_TypeDef sQueue;
+
+/// Item buffers for bulk cases
+static uint32_t aulIn[SPSC_BENCH_SIZE];
+static uint32_t aulOut[SPSC_BENCH_SIZE];
+
+/// PRIMASK-guarded reference ring
+static uint32_t aulLocked[SPSC_BENCH_SIZE];
+static uint32_t ulLockedHead;
+static uint32_t ulLockedTail;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Push to reference ring
+ *
+ * @param[in] ulItem  Item
+ * @return  (bool)  false if full
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bLockedPush(uint32_t ulItem)
+{
+  uint32_t ulPrimask = __get_PRIMASK();
+  __disable_irq();
+  bool bOk = (ulLockedHead - ulLockedTail) < SPSC_BENCH_SIZE;
+  if (bOk) aulLocked[ulLockedHead++ & (SPSC_BENCH_SIZE - 1u)] = ulItem;
+  __set_PRIMASK(ulPrimask);
+  return bOk;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Pop from reference ring
+ *
+ * @param[out] *pulItem   Item
+ * @return  (bool)      false if empty
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bLockedPop(uint32_t* pulItem)
+{
+  uint32_t ulPrimask = __get_PRIMASK();
+  __disable_irq();
+  bool bOk = ulLockedHead != ulLockedTail;
+  if (bOk) *pulItem = aulLocked[ulLockedTail++ & (SPSC_BENCH_SIZE - 1u)];
+  __set_PRIMASK(ulPrimask);
+  return bOk;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Self-timed cases
+ *
+ * @param[in] *pcSuite  Suite name
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vRun(const char* pcSuite)
+{
+  uint32_t ulOverhead = ulBENCH_GetOverhead();
+  uint32_t ulItem = 0uL;
+  BENCH_ResultTypeDef sResult;
+
+  vSPSC_Bench_Init(&sQueue);
+  for (uint32_t i = 0uL; i < SPSC_BENCH_SIZE; ++i)
+  {
+    aulIn[i] = i;
+  }
+
+  // Single item
+  vBENCH_ResetResult(&sResult);
+  for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + BENCH_DEFAULT_RUNS; ++i)
+  {
+    __disable_irq();
+    uint32_t ulT0 = ulHW_GetCycleCount();
+    (void)bSPSC_Bench_Push(&sQueue, &i);
+    (void)bSPSC_Bench_Pop(&sQueue, &ulItem);
+    uint32_t ulT1 = ulHW_GetCycleCount();
+    __enable_irq();
+    if (i >= BENCH_DEFAULT_WARMUP) vBENCH_AddSample(&sResult, ulT1 - ulT0 - ulOverhead);
+  }
+  vBENCH_Report(pcSuite, "push_pop", 1uL, 1uL, &sResult);
+
+  // Bulk copy and zero-copy spans
+  for (uint32_t s = 0uL; s < BENCH_COUNT(aulSizes); ++s)
+  {
+    uint32_t ulNum = aulSizes[s];
+    BENCH_ResultTypeDef sSpan;
+    vBENCH_ResetResult(&sResult);
+    vBENCH_ResetResult(&sSpan);
+
+    for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + BENCH_DEFAULT_RUNS; ++i)
+    {
+      __disable_irq();
+      uint32_t ulT0 = ulHW_GetCycleCount();
+      (void)ulSPSC_Bench_PushBulk(&sQueue, aulIn, ulNum);
+      (void)ulSPSC_Bench_PopBulk(&sQueue, aulOut, ulNum);
+      uint32_t ulT1 = ulHW_GetCycleCount();
+
+      // Spans may be split at the ring end
+      uint32_t ulT2 = ulHW_GetCycleCount();
+      for (uint32_t ulDone = 0uL; ulDone < ulNum; )
+      {
+        uint32_t* pulSpan;
+        uint32_t ulLen = ulSPSC_Bench_GetWriteSpan(&sQueue, &pulSpan);
+        if (ulLen > ulNum - ulDone) ulLen = ulNum - ulDone;
+        for (uint32_t j = 0uL; j < ulLen; ++j)
+        {
+          pulSpan[j] = j;
+        }
+        vSPSC_Bench_CommitWrite(&sQueue, ulLen);
+        ulDone += ulLen;
+      }
+      for (uint32_t ulDone = 0uL; ulDone < ulNum; )
+      {
+        const uint32_t* pulSpan;
+        uint32_t ulLen = ulSPSC_Bench_GetReadSpan(&sQueue, &pulSpan);
+        for (uint32_t j = 0uL; j < ulLen; ++j)
+        {
+          ulItem += pulSpan[j];
+        }
+        vSPSC_Bench_CommitRead(&sQueue, ulLen);
+        ulDone += ulLen;
+      }
+      uint32_t ulT3 = ulHW_GetCycleCount();
+      __enable_irq();
+
+      if (i < BENCH_DEFAULT_WARMUP) continue;
+      vBENCH_AddSample(&sResult, ulT1 - ulT0 - ulOverhead);
+      vBENCH_AddSample(&sSpan, ulT3 - ulT2 - ulOverhead);
+    }
+    vBENCH_Report(pcSuite, "bulk", ulNum, ulNum, &sResult);
+    vBENCH_Report(pcSuite, "span", ulNum, ulNum, &sSpan);
+  }
+
+  // Reference: interrupt lock instead of ordering
+  vBENCH_ResetResult(&sResult);
+  for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + BENCH_DEFAULT_RUNS; ++i)
+  {
+    uint32_t ulT0 = ulHW_GetCycleCount();
+    (void)bLockedPush(i);
+    (void)bLockedPop(&ulItem);
+    uint32_t ulT1 = ulHW_GetCycleCount();
+    if (i >= BENCH_DEFAULT_WARMUP) vBENCH_AddSample(&sResult, ulT1 - ulT0 - ulOverhead);
+  }
+  vBENCH_Report(pcSuite, "locked", 1uL, 1uL, &sResult);
+
+  // Interrupt to consumer handoff
+  NVIC_ClearPendingIRQ(SWI_SPSC_IRQn);
+  NVIC_EnableIRQ(SWI_SPSC_IRQn);
+  vBENCH_ResetResult(&sResult);
+  for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + BENCH_DEFAULT_RUNS; ++i)
+  {
+    uint32_t ulT0 = ulHW_GetCycleCount();
+    NVIC->STIR = (uint32_t)SWI_SPSC_IRQn;
+    while (!bSPSC_Bench_Pop(&sQueue, &ulItem))
+    {
+    }
+    uint32_t ulT1 = ulHW_GetCycleCount();
+    if (i >= BENCH_DEFAULT_WARMUP) vBENCH_AddSample(&sResult, ulT1 - ulT0 - ulOverhead);
+  }
+  NVIC_DisableIRQ(SWI_SPSC_IRQn);
+  vBENCH_Report(pcSuite, "irq_push", 1uL, 1uL, &sResult);
+  (void)ulItem;
+}
+
+
+/*- Global data --------------------------------------------------------------*/
+/// SPSC queue benchmark suite
+const BENCH_SuiteTypeDef sBENCH_SuiteSpsc = {
+  .pcName = "spsc",
+  .pfnCustom = vRun
+};
+
+
+/*- Interrupt handlers -------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Benchmark interrupt handler: producer
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void SWI_SPSC_IRQHandler(void)
+{
+  uint32_t ulItem = ulHW_GetCycleCount();
+  (void)bSPSC_Bench_Push(&sQueue, &ulItem);
+}
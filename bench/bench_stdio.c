@@ -0,0 +1,79 @@
+/*!****************************************************************************
+ * @file
+ * bench_stdio.c
+ *
+ * @brief
+ * Microbenchmarks - stdio retargeting
+ *
+ * Output of these cases goes to the console (ITM port 0), results are kept
+ * apart on the result sink.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdio.h>
+#include <unistd.h>
+#include "bench.h"
+#include "bench_suites.h"
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Payload for raw write cases
+static const char acPayload[64] =
+  "................................"
+  "..............................\r\n";
+
+
+/*- Private functions --------------------------------------------------------*/
+extern int _write(int fd, const char* buffer, unsigned count);
+
+/*!****************************************************************************
+ * @brief
+ * Raw _write() of ulArg bytes
+ *
+ * @param[in] ulArg   Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vWrite(uint32_t ulArg)
+{
+  (void)_write(STDOUT_FILENO, acPayload + sizeof(acPayload) - ulArg, (unsigned)ulArg);
+}
+
+/*!****************************************************************************
+ * @brief
+ * printf() formatting cases
+ *
+ * @param[in] ulArg   Value to be formatted
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vPrintfLiteral(uint32_t ulArg) { (void)ulArg; printf("literal\r\n"); }
+static void vPrintfChar(uint32_t ulArg) { printf("%c\r\n", (char)ulArg); }
+static void vPrintfStr(uint32_t ulArg) { (void)ulArg; printf("%s\r\n", "string"); }
+static void vPrintfInt(uint32_t ulArg) { printf("%d\r\n", (int)ulArg); }
+static void vPrintfULong(uint32_t ulArg) { printf("%lu\r\n", ulArg); }
+static void vPrintfHex(uint32_t ulArg) { printf("0x%08lX\r\n", ulArg); }
+static void vPrintfMulti(uint32_t ulArg) { printf("%d.%03d MHz\r\n", (int)(ulArg / 1000uL), (int)(ulArg % 1000uL)); }
+
+/// Benchmark cases
+static const BENCH_CaseTypeDef asCases[] = {
+  { .pcName = "_write",         .pfnRun = vWrite,         .ulArg = 2uL,         .ulUnits = 2uL },
+  { .pcName = "_write",         .pfnRun = vWrite,         .ulArg = 16uL,        .ulUnits = 16uL },
+  { .pcName = "_write",         .pfnRun = vWrite,         .ulArg = 64uL,        .ulUnits = 64uL },
+  { .pcName = "printf_literal", .pfnRun = vPrintfLiteral, .ulArg = 0uL },
+  { .pcName = "printf_c",       .pfnRun = vPrintfChar,    .ulArg = 'x' },
+  { .pcName = "printf_s",       .pfnRun = vPrintfStr,     .ulArg = 0uL },
+  { .pcName = "printf_d",       .pfnRun = vPrintfInt,     .ulArg = 12345uL },
+  { .pcName = "printf_lu",      .pfnRun = vPrintfULong,   .ulArg = 4000000000uL },
+  { .pcName = "printf_08lX",    .pfnRun = vPrintfHex,     .ulArg = 0x412FC231uL },
+  { .pcName = "printf_d.03d",   .pfnRun = vPrintfMulti,   .ulArg = 72000uL }
+};
+
+
+/*- Global data --------------------------------------------------------------*/
+/// stdio benchmark suite
+const BENCH_SuiteTypeDef sBENCH_SuiteStdio = {
+  .pcName = "stdio",
+  .psCases = asCases,
+  .ulNumCases = BENCH_COUNT(asCases)
+};
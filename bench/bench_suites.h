@@ -0,0 +1,34 @@
+/*!****************************************************************************
+ * @file
+ * bench_suites.h
+ *
+ * @brief
+ * Microbenchmark suites
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef BENCH_SUITES_H_
+#define BENCH_SUITES_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include "bench.h"
+
+
+/*- Global data --------------------------------------------------------------*/
+extern const BENCH_SuiteTypeDef sBENCH_SuiteStdio;
+extern const BENCH_SuiteTypeDef sBENCH_SuiteHw;
+extern const BENCH_SuiteTypeDef sBENCH_SuiteMem;
+extern const BENCH_SuiteTypeDef sBENCH_SuiteExec;
+extern const BENCH_SuiteTypeDef sBENCH_SuiteDma;
+extern const BENCH_SuiteTypeDef sBENCH_SuiteTimer;
+extern const BENCH_SuiteTypeDef sBENCH_SuiteTrace;
+extern const BENCH_SuiteTypeDef sBENCH_SuiteNvm;
+extern const BENCH_SuiteTypeDef sBENCH_SuiteCrc;
+extern const BENCH_SuiteTypeDef sBENCH_SuiteOs;
+extern const BENCH_SuiteTypeDef sBENCH_SuiteSpsc;
+extern const BENCH_SuiteTypeDef sBENCH_SuiteIrq;
+extern const BENCH_SuiteTypeDef sBENCH_SuiteLog;
+extern const BENCH_SuiteTypeDef sBENCH_SuiteFix;
+
+#endif // BENCH_SUITES_H_
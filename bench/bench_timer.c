@@ -0,0 +1,125 @@
+/*!****************************************************************************
+ * @file
+ * bench_timer.c
+ *
+ * @brief
+ * Microbenchmarks - software timer service
+ *
+ * With 1, 16 and 256 periodic timers active (pseudo-random periods), the
+ * following are reported:
+ *  - "tick_isr":   SysTick exception incl. wheel advance, expiries, cascades
+ *  - "start_stop": vHW_CLK_TimerStart() + vHW_CLK_TimerStop() pair
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include "stm32f1xx_hal.h"
+#include "hw_layer.h"
+#include "hw_clk.h"
+#include "bench.h"
+#include "bench_suites.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Maximum number of background timers
+#define TIMER_MAX_ACTIVE              256u
+
+/// Measured ticks per load level (covers level 1 cascades)
+#define TIMER_RUNS                    256uL
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Load levels
+static const uint32_t aulLoads[] = { 1uL, 16uL, TIMER_MAX_ACTIVE };
+
+/// Background timers
+static HW_CLK_TimerTypeDef asTimers[TIMER_MAX_ACTIVE];
+
+/// Probe timer for start/stop measurement
+static HW_CLK_TimerTypeDef sProbe;
+
+/// Expiry counter
+static volatile uint32_t ulExpired;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Background timer callback
+ *
+ * @param[in] *psTimer  Expired timer
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vExpire(HW_CLK_TimerTypeDef* psTimer)
+{
+  (void)psTimer;
+  ulExpired++;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Self-timed cases
+ *
+ * @param[in] *pcSuite  Suite name
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vRun(const char* pcSuite)
+{
+  uint32_t ulOverhead = ulBENCH_GetOverhead();
+  uint32_t ulSeed = 0x2545F491uL;
+
+  vHW_CLK_TimerInit(&sProbe, vExpire, NULL);
+
+  for (uint32_t l = 0uL; l < BENCH_COUNT(aulLoads); ++l)
+  {
+    // Start background load, periods 2..4097 ms
+    for (uint32_t i = 0uL; i < aulLoads[l]; ++i)
+    {
+      ulSeed = ulSeed * 1664525uL + 1013904223uL;
+      uint32_t ulPeriod = 2uL + (ulSeed >> 20);
+      vHW_CLK_TimerInit(&asTimers[i], vExpire, NULL);
+      vHW_CLK_TimerStart(&asTimers[i], ulPeriod, ulPeriod);
+    }
+
+    BENCH_ResultTypeDef sTick, sStartStop;
+    vBENCH_ResetResult(&sTick);
+    vBENCH_ResetResult(&sStartStop);
+
+    for (uint32_t i = 0uL; i < BENCH_DEFAULT_WARMUP + TIMER_RUNS; ++i)
+    {
+      uint32_t ulT0 = ulHW_GetCycleCount();
+      SCB->ICSR = SCB_ICSR_PENDSTSET_Msk;
+      __DSB();
+      __ISB();
+      uint32_t ulT1 = ulHW_GetCycleCount();
+
+      __disable_irq();
+      uint32_t ulT2 = ulHW_GetCycleCount();
+      vHW_CLK_TimerStart(&sProbe, 1000uL + i, 0uL);
+      vHW_CLK_TimerStop(&sProbe);
+      uint32_t ulT3 = ulHW_GetCycleCount();
+      __enable_irq();
+
+      if (i < BENCH_DEFAULT_WARMUP) continue;
+      vBENCH_AddSample(&sTick, ulT1 - ulT0 - ulOverhead);
+      vBENCH_AddSample(&sStartStop, ulT3 - ulT2 - ulOverhead);
+    }
+
+    vBENCH_Report(pcSuite, "tick_isr", aulLoads[l], 0uL, &sTick);
+    vBENCH_Report(pcSuite, "start_stop", aulLoads[l], 0uL, &sStartStop);
+
+    for (uint32_t i = 0uL; i < aulLoads[l]; ++i)
+    {
+      vHW_CLK_TimerStop(&asTimers[i]);
+    }
+  }
+}
+
+
+/*- Global data --------------------------------------------------------------*/
+/// Software timer benchmark suite
+const BENCH_SuiteTypeDef sBENCH_SuiteTimer = {
+  .pcName = "timer",
+  .pfnCustom = vRun
+};
@@ -0,0 +1,291 @@
+/*!****************************************************************************
+ * @file
+ * bench_trace.c
+ *
+ * @brief
+ * Microbenchmarks - compact binary trace encoding
+ *
+ * Synthetic recordings of typical trace content are encoded as a whole, each
+ * run starting with a fresh encoder (incl. initial resync marker). For each
+ * profile, the following are reported:
+ *  - "enc_<profile>":  ulTRACE_Encode(), arg = encoded bytes
+ *  - "raw_<profile>":  packing raw fixed-width records, arg = raw bytes
+ * Units are records, so mean / units is the cost per record. The compression
+ * ratio is the "raw" arg divided by the "enc" arg.
+ *
+ * Profiles:
+ *  - "tick":     1 ms periodic event with a few cycles of jitter
+ *  - "isr":      interrupt enter/exit pairs of three IRQs, IRQ number as arg
+ *  - "counters": periodic sample of three slowly changing counters
+ *  - "mixed":    interleaving of the above
+ *  - "random":   random IDs and arguments (worst case)
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <string.h>
+#include "stm32f1xx_hal.h"
+#include "hw_layer.h"
+#include "trace.h"
+#include "bench.h"
+#include "bench_suites.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Records per recording
+#define TRACE_RECORDS                 128u
+
+/// Cycles per millisecond at 72 MHz
+#define TRACE_MS                      72000uL
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Recorded event
+typedef struct {
+  uint32_t ulTime;
+  uint16_t uiId;
+  uint8_t ucNumArgs;
+  uint32_t aulArgs[TRACE_MAX_ARGS];
+} TraceRecordTypeDef;
+
+/// Profile generator
+typedef void (*TraceProfileTypeDef)(TraceRecordTypeDef* psRec, uint32_t ulIdx);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Recording
+static TraceRecordTypeDef asRecords[TRACE_RECORDS];
+
+/// Output scratch buffers
+static uint8_t aucOut[TRACE_ENCODE_MAX];
+static uint8_t aucRaw[TRACE_RAW_SIZE(TRACE_MAX_ARGS)];
+
+/// Encoder
+static TRACE_EncoderTypeDef sEncoder;
+
+/// Generator state
+static uint32_t ulSeed;
+static uint32_t ulClock;
+static uint32_t aulCounters[3];
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Pseudo-random number
+ *
+ * @param[in] ulMask    Result mask
+ * @return  (uint32_t)  Random bits
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulRand(uint32_t ulMask)
+{
+  ulSeed = ulSeed * 1664525uL + 1013904223uL;
+  return (ulSeed >> 8) & ulMask;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Generate periodic tick event
+ *
+ * @param[out] *psRec   Record
+ * @param[in] ulIdx     Record index
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vGenTick(TraceRecordTypeDef* psRec, uint32_t ulIdx)
+{
+  (void)ulIdx;
+  ulClock += TRACE_MS;
+  psRec->ulTime = ulClock + ulRand(0x7uL);
+  psRec->uiId = 1u;
+  psRec->ucNumArgs = 0u;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Generate interrupt enter/exit events
+ *
+ * @param[out] *psRec   Record
+ * @param[in] ulIdx     Record index
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vGenIsr(TraceRecordTypeDef* psRec, uint32_t ulIdx)
+{
+  static uint32_t ulIrq;
+  if ((ulIdx & 1uL) == 0uL)
+  {
+    ulIrq = 11uL + ulRand(0x3uL) % 3uL;
+    ulClock += 500uL + ulRand(0xFFFuL);
+    psRec->uiId = 2u;
+  }
+  else
+  {
+    ulClock += 40uL + ulRand(0x3FuL);
+    psRec->uiId = 3u;
+  }
+  psRec->ulTime = ulClock;
+  psRec->ucNumArgs = 1u;
+  psRec->aulArgs[0] = ulIrq;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Generate counter sample event
+ *
+ * @param[out] *psRec   Record
+ * @param[in] ulIdx     Record index
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vGenCounters(TraceRecordTypeDef* psRec, uint32_t ulIdx)
+{
+  (void)ulIdx;
+  ulClock += TRACE_MS;
+  aulCounters[0] += 100000uL + ulRand(0xFFuL);
+  aulCounters[1] = 2500uL + ulRand(0x7uL);
+  aulCounters[2] += 60uL + ulRand(0x3uL);
+  psRec->ulTime = ulClock + ulRand(0x7uL);
+  psRec->uiId = 4u;
+  psRec->ucNumArgs = 3u;
+  (void)memcpy(psRec->aulArgs, aulCounters, sizeof(aulCounters));
+}
+
+/*!****************************************************************************
+ * @brief
+ * Generate interleaved events
+ *
+ * @param[out] *psRec   Record
+ * @param[in] ulIdx     Record index
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vGenMixed(TraceRecordTypeDef* psRec, uint32_t ulIdx)
+{
+  static uint32_t ulTick;
+  switch (ulIdx & 3uL)
+  {
+    case 0uL:
+      ulClock = ulTick;
+      vGenTick(psRec, ulIdx);
+      ulTick = ulClock;
+      break;
+    case 1uL:
+    case 2uL:
+      ulClock = asRecords[ulIdx - 1uL].ulTime;
+      vGenIsr(psRec, ulIdx - 1uL);
+      break;
+    default:
+      ulClock = asRecords[ulIdx - 1uL].ulTime - TRACE_MS + 8uL;
+      vGenCounters(psRec, ulIdx);
+      break;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Generate random events
+ *
+ * @param[out] *psRec   Record
+ * @param[in] ulIdx     Record index
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vGenRandom(TraceRecordTypeDef* psRec, uint32_t ulIdx)
+{
+  (void)ulIdx;
+  ulClock += ulRand(0xFFFFuL);
+  psRec->ulTime = ulClock;
+  psRec->uiId = (uint16_t)ulRand(0x3FuL);
+  psRec->ucNumArgs = (uint8_t)(ulRand(0x3uL));
+  for (uint32_t i = 0uL; i < TRACE_MAX_ARGS; ++i)
+  {
+    psRec->aulArgs[i] = ulRand(0xFFFFFFuL) ^ (ulSeed << 24);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Self-timed cases
+ *
+ * @param[in] *pcSuite  Suite name
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vRun(const char* pcSuite)
+{
+  static const struct {
+    const char* pcEnc;
+    const char* pcRaw;
+    TraceProfileTypeDef pfnGen;
+  } asProfiles[] = {
+    { "enc_tick",     "raw_tick",     vGenTick },
+    { "enc_isr",      "raw_isr",      vGenIsr },
+    { "enc_counters", "raw_counters", vGenCounters },
+    { "enc_mixed",    "raw_mixed",    vGenMixed },
+    { "enc_random",   "raw_random",   vGenRandom }
+  };
+
+  uint32_t ulOverhead = ulBENCH_GetOverhead();
+
+  for (uint32_t p = 0uL; p < BENCH_COUNT(asProfiles); ++p)
+  {
+    ulSeed = 0x2545F491uL;
+    ulClock = 0uL;
+    (void)memset(aulCounters, 0, sizeof(aulCounters));
+    for (uint32_t i = 0uL; i < TRACE_RECORDS; ++i)
+    {
+      asProfiles[p].pfnGen(&asRecords[i], i);
+    }
+
+    BENCH_ResultTypeDef sEncode, sRaw;
+    vBENCH_ResetResult(&sEncode);
+    vBENCH_ResetResult(&sRaw);
+    uint32_t ulEncBytes = 0uL;
+    uint32_t ulRawBytes = 0uL;
+
+    for (uint32_t r = 0uL; r < BENCH_DEFAULT_WARMUP + BENCH_DEFAULT_RUNS; ++r)
+    {
+      __disable_irq();
+
+      // Compact encoding
+      uint32_t ulT0 = ulHW_GetCycleCount();
+      vTRACE_EncoderInit(&sEncoder);
+      ulEncBytes = 0uL;
+      for (uint32_t i = 0uL; i < TRACE_RECORDS; ++i)
+      {
+        const TraceRecordTypeDef* psRec = &asRecords[i];
+        ulEncBytes += ulTRACE_Encode(&sEncoder, aucOut, psRec->ulTime, psRec->uiId,
+                                     psRec->ucNumArgs, psRec->aulArgs);
+      }
+      uint32_t ulT1 = ulHW_GetCycleCount();
+
+      // Raw fixed-width records
+      ulRawBytes = 0uL;
+      for (uint32_t i = 0uL; i < TRACE_RECORDS; ++i)
+      {
+        const TraceRecordTypeDef* psRec = &asRecords[i];
+        uint32_t ulHdr = (uint32_t)psRec->uiId | ((uint32_t)psRec->ucNumArgs << 16);
+        (void)memcpy(&aucRaw[0], &psRec->ulTime, 4u);
+        (void)memcpy(&aucRaw[4], &ulHdr, 4u);
+        (void)memcpy(&aucRaw[8], psRec->aulArgs, 4u * psRec->ucNumArgs);
+        ulRawBytes += TRACE_RAW_SIZE(psRec->ucNumArgs);
+        __DMB();
+      }
+      uint32_t ulT2 = ulHW_GetCycleCount();
+
+      __enable_irq();
+
+      if (r < BENCH_DEFAULT_WARMUP) continue;
+      vBENCH_AddSample(&sEncode, ulT1 - ulT0 - ulOverhead);
+      vBENCH_AddSample(&sRaw, ulT2 - ulT1 - ulOverhead);
+    }
+
+    vBENCH_Report(pcSuite, asProfiles[p].pcEnc, ulEncBytes, TRACE_RECORDS, &sEncode);
+    vBENCH_Report(pcSuite, asProfiles[p].pcRaw, ulRawBytes, TRACE_RECORDS, &sRaw);
+  }
+}
+
+
+/*- Global data --------------------------------------------------------------*/
+/// Trace encoding benchmark suite
+const BENCH_SuiteTypeDef sBENCH_SuiteTrace = {
+  .pcName = "trace",
+  .pfnCustom = vRun
+};
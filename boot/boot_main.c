@@ -0,0 +1,498 @@
+/*!****************************************************************************
+ * @file
+ * boot_main.c
+ *
+ * @brief
+ * Serial bootloader
+ *
+ * Occupies the first flash pages; the application is linked behind it (see
+ * BOOTLOADER in CMakeLists.txt) and its region ends before the non-volatile
+ * storage, which is never touched. Runs without HAL, interrupts or kernel.
+ *
+ * After reset, the bootloader starts the application right away unless
+ * - the application requested an update (BOOT_REQUEST_MAGIC in BKP->DR1),
+ * - the application region holds no valid vector table, or
+ * - the uploader (tools/boot_upload) sends a probe byte within BOOT_WAIT_MS.
+ *
+ * Images are received on USART1 (PA9 TX, PA10 RX) at BOOT_BAUD. DMA1
+ * channel 5 writes incoming bytes into a circular buffer of BOOT_WINDOW
+ * frames, and the CPU programs the page of one half while the other half is
+ * being received, so the line stays busy as long as flash can keep up.
+ * Protocol and image handling are in lib/bootproto.c.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "stm32f1xx.h"
+#include "bootproto.h"
+#include "hw_nvm.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Application start address (vector table)
+#ifndef BOOT_APP_BASE
+#define BOOT_APP_BASE                 0x08002000uL
+#endif
+
+/// Application region end, the storage pages are kept
+#define BOOT_APP_END                  HW_NVM_BASE
+
+/// RAM size (STM32F103x8)
+#define BOOT_RAM_SIZE                 (20u * 1024u)
+
+/// Line rate, PCLK2 / BOOT_BAUD must be an integer of at least 16
+#ifndef BOOT_BAUD
+#define BOOT_BAUD                     1000000uL
+#endif
+
+/// Time to wait for a probe byte before starting the application
+#ifndef BOOT_WAIT_MS
+#define BOOT_WAIT_MS                  20uL
+#endif
+
+/// Silence on the line that ends discarding input
+#define BOOT_IDLE_MS                  2uL
+
+/// A started frame must complete within this time
+#define BOOT_FRAME_TIMEOUT_MS         20uL
+
+/// Core clock: HSI / 2 * 16
+#define BOOT_CLK_FREQ                 64000000uL
+
+/// Cycles per millisecond
+#define BOOT_CYCLES_PER_MS            (BOOT_CLK_FREQ / 1000uL)
+
+/*! @brief Flash unlock sequence
+ *  @{                                                                        */
+#define BOOT_FLASH_KEY1               0x45670123uL
+#define BOOT_FLASH_KEY2               0xCDEF89ABuL
+/*! @}                                                                        */
+
+/// Flash error flags
+#define BOOT_FLASH_ERRORS             (FLASH_SR_PGERR | FLASH_SR_WRPRTERR)
+
+/// Receive buffer size, one half per frame
+#define BOOT_RX_SIZE                  (BOOT_WINDOW * BOOT_FRAME_SIZE)
+
+_Static_assert(BOOT_WINDOW == 2u, "Receive buffer halves must match the window");
+_Static_assert((BOOT_APP_BASE % BOOT_PAGE_SIZE) == 0uL, "Application must start on a page");
+_Static_assert((BOOT_CLK_FREQ % BOOT_BAUD == 0uL) && (BOOT_CLK_FREQ / BOOT_BAUD >= 16uL),
+               "Baud rate not exactly reachable");
+
+
+/*- Private functions --------------------------------------------------------*/
+void Reset_Handler(void);
+static void vBootFault(void);
+static void vBootClockInit(void);
+static void vBootUartInit(void);
+static void vBootDeinit(void);
+static uint32_t ulBootElapsedMs(uint32_t ulStart);
+static bool bBootWaitProbe(uint32_t ulTimeoutMs);
+static void vBootWaitIdle(void);
+static void vBootRxStart(void);
+static void vBootSend(const uint8_t* pucData, uint32_t ulLen);
+static void vBootRun(void);
+static void vBootStartApp(void);
+static bool bBootErase(uint32_t ulOffset);
+static bool bBootProgram(uint32_t ulOffset, const uint8_t* pucData);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Linker symbols: initialisation data in flash, data and bss sections in RAM, initial stack
+extern uint32_t _sidata;
+extern uint32_t _sdata;
+extern uint32_t _edata;
+extern uint32_t _sbss;
+extern uint32_t _ebss;
+extern uint32_t _estack;
+
+/// Vector table: no interrupts are used, faults reset
+__attribute__((section(".isr_vector"), used))
+static void (* const apfnVectors[])(void) = {
+  (void (*)(void))&_estack,
+  Reset_Handler,
+  vBootFault,                     // NMI
+  vBootFault,                     // HardFault
+  vBootFault,                     // MemManage
+  vBootFault,                     // BusFault
+  vBootFault                      // UsageFault
+};
+
+/// Application region
+static const BOOT_FlashTypeDef sFlash = {
+  .pucBase = (const uint8_t*)BOOT_APP_BASE,
+  .ulAddr = BOOT_APP_BASE,
+  .ulSize = BOOT_APP_END - BOOT_APP_BASE,
+  .pfnErase = bBootErase,
+  .pfnProgram = bBootProgram
+};
+
+/// Receiver state
+static BOOT_TargetTypeDef sTarget;
+
+/// Receive buffer, written by DMA
+static uint8_t aucRx[BOOT_RX_SIZE];
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Reset entrypoint: initialise RAM and run bootloader
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void Reset_Handler(void)
+{
+  const uint32_t* pulSrc = &_sidata;
+  for (uint32_t* pulDst = &_sdata; pulDst < &_edata; )
+  {
+    *pulDst++ = *pulSrc++;
+  }
+  for (uint32_t* pulDst = &_sbss; pulDst < &_ebss; )
+  {
+    *pulDst++ = 0uL;
+  }
+
+  vBootClockInit();
+
+  // Update request from application, cleared so that the next reset starts it again
+  RCC->APB1ENR |= RCC_APB1ENR_PWREN | RCC_APB1ENR_BKPEN;
+  (void)RCC->APB1ENR;
+  PWR->CR |= PWR_CR_DBP;
+  bool bRequest = (BKP->DR1 == BOOT_REQUEST_MAGIC);
+  BKP->DR1 = 0u;
+  PWR->CR &= ~PWR_CR_DBP;
+
+  vBootUartInit();
+  if (bRequest || !bBOOT_IsAppValid(&sFlash, SRAM_BASE, BOOT_RAM_SIZE) || bBootWaitProbe(BOOT_WAIT_MS))
+  {
+    vBootRun();
+  }
+  vBootStartApp();
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Fault handler: reset
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vBootFault(void)
+{
+  NVIC_SystemReset();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Switch to 64 MHz from HSI, start cycle counter
+ *
+ * Two flash wait states above 48 MHz. APB1 is limited to 36 MHz, USART1 on
+ * APB2 runs at 64 MHz.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vBootClockInit(void)
+{
+  FLASH->ACR = FLASH_ACR_PRFTBE | (2uL << FLASH_ACR_LATENCY_Pos);
+  RCC->CFGR = RCC_CFGR_PLLMULL16 | RCC_CFGR_PPRE1_DIV2;
+  RCC->CR |= RCC_CR_PLLON;
+  while ((RCC->CR & RCC_CR_PLLRDY) == 0uL) {}
+  RCC->CFGR |= RCC_CFGR_SW_PLL;
+  while ((RCC->CFGR & RCC_CFGR_SWS) != RCC_CFGR_SWS_PLL) {}
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0uL;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Initialise USART1 (8N1, no flow control) and its receive DMA channel
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vBootUartInit(void)
+{
+  RCC->AHBENR |= RCC_AHBENR_DMA1EN;
+  RCC->APB2ENR |= RCC_APB2ENR_IOPAEN | RCC_APB2ENR_USART1EN;
+  (void)RCC->APB2ENR;
+
+  // PA9: alternate function push-pull 50 MHz, PA10: input with pull-up
+  GPIOA->CRH = (GPIOA->CRH & ~(GPIO_CRH_CNF9 | GPIO_CRH_MODE9 | GPIO_CRH_CNF10 | GPIO_CRH_MODE10)) |
+               GPIO_CRH_CNF9_1 | GPIO_CRH_MODE9 | GPIO_CRH_CNF10_1;
+  GPIOA->BSRR = GPIO_BSRR_BS10;
+
+  USART1->BRR = BOOT_CLK_FREQ / BOOT_BAUD;
+  USART1->CR3 = USART_CR3_DMAR;
+  USART1->CR1 = USART_CR1_UE | USART_CR1_TE | USART_CR1_RE;
+
+  DMA1_Channel5->CPAR = (uint32_t)&USART1->DR;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Return clocks and peripherals to their reset state for the application
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vBootDeinit(void)
+{
+  while ((USART1->SR & USART_SR_TC) == 0uL) {}
+  DMA1_Channel5->CCR = 0uL;
+  DMA1->IFCR = DMA_IFCR_CGIF5;
+  RCC->APB2RSTR = RCC_APB2RSTR_USART1RST | RCC_APB2RSTR_IOPARST;
+  RCC->APB2RSTR = 0uL;
+  RCC->AHBENR &= ~RCC_AHBENR_DMA1EN;
+  RCC->APB2ENR &= ~(RCC_APB2ENR_IOPAEN | RCC_APB2ENR_USART1EN);
+  RCC->APB1ENR &= ~(RCC_APB1ENR_PWREN | RCC_APB1ENR_BKPEN);
+
+  RCC->CFGR &= ~RCC_CFGR_SW;
+  while ((RCC->CFGR & RCC_CFGR_SWS) != RCC_CFGR_SWS_HSI) {}
+  RCC->CR &= ~RCC_CR_PLLON;
+  RCC->CFGR = 0uL;
+  FLASH->ACR = FLASH_ACR_PRFTBE;
+
+  DWT->CTRL &= ~DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Milliseconds since a cycle counter value
+ *
+ * @param[in] ulStart   Cycle counter value
+ * @return  (uint32_t)  Elapsed time in ms
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulBootElapsedMs(uint32_t ulStart)
+{
+  return (DWT->CYCCNT - ulStart) / BOOT_CYCLES_PER_MS;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Wait for a probe byte, other bytes are ignored
+ *
+ * @param[in] ulTimeoutMs   Timeout in ms, 0 to wait forever
+ * @return  (bool)  Probe received
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bBootWaitProbe(uint32_t ulTimeoutMs)
+{
+  uint32_t ulStart = DWT->CYCCNT;
+  while ((ulTimeoutMs == 0uL) || (ulBootElapsedMs(ulStart) < ulTimeoutMs))
+  {
+    if (((USART1->SR & USART_SR_RXNE) != 0uL) && ((uint8_t)USART1->DR == BOOT_PROBE))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stop reception and discard input until the line is idle for BOOT_IDLE_MS
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vBootWaitIdle(void)
+{
+  DMA1_Channel5->CCR = 0uL;
+  uint32_t ulStart = DWT->CYCCNT;
+  while (ulBootElapsedMs(ulStart) < BOOT_IDLE_MS)
+  {
+    // Reading DR after SR also clears an overrun
+    if ((USART1->SR & (USART_SR_RXNE | USART_SR_ORE)) != 0uL)
+    {
+      (void)USART1->DR;
+      ulStart = DWT->CYCCNT;
+    }
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start circular reception at the first buffer half
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vBootRxStart(void)
+{
+  DMA1_Channel5->CCR = 0uL;
+  DMA1->IFCR = DMA_IFCR_CGIF5;
+  DMA1_Channel5->CMAR = (uint32_t)aucRx;
+  DMA1_Channel5->CNDTR = BOOT_RX_SIZE;
+  DMA1_Channel5->CCR = DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_EN;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Send bytes (polled)
+ *
+ * @param[in] *pucData  Data
+ * @param[in] ulLen     Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vBootSend(const uint8_t* pucData, uint32_t ulLen)
+{
+  for (uint32_t i = 0uL; i < ulLen; ++i)
+  {
+    while ((USART1->SR & USART_SR_TXE) == 0uL) {}
+    USART1->DR = pucData[i];
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Receive and program images until one is committed
+ *
+ * Frame n is complete when DMA signals half transfer (even n) or transfer
+ * complete (odd n). The uploader sends at most BOOT_WINDOW frames ahead, so
+ * a half is only overwritten after its frame has been answered. A frame that
+ * starts but does not complete in time is treated as damaged; if it starts
+ * with a probe byte, the uploader was restarted and is answered with READY.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vBootRun(void)
+{
+  uint8_t aucResp[BOOT_RESP_SIZE];
+
+  // The uploader repeats its probe until answered
+  vBOOT_TargetInit(&sTarget, &sFlash);
+  (void)bBootWaitProbe(0uL);
+  vBOOT_PutResponse(aucResp, BOOT_STATUS_READY, 0uL);
+  vBootWaitIdle();
+  vBootRxStart();
+  vBootSend(aucResp, BOOT_RESP_SIZE);
+
+  uint32_t ulHalf = 0uL;
+  for (;;)
+  {
+    const uint32_t ulDoneFlag = (ulHalf == 0uL) ? DMA_ISR_HTIF5 : DMA_ISR_TCIF5;
+    const uint32_t ulEmpty = BOOT_RX_SIZE - ulHalf * BOOT_FRAME_SIZE;
+    const uint8_t* pucFrame = &aucRx[ulHalf * BOOT_FRAME_SIZE];
+    BOOT_StatusTypeDef eStatus;
+    uint32_t ulStart = 0uL;
+    bool bStarted = false;
+
+    // Wait for frame, time out once its first byte is in
+    while ((DMA1->ISR & ulDoneFlag) == 0uL)
+    {
+      if (!bStarted && (DMA1_Channel5->CNDTR != ulEmpty))
+      {
+        bStarted = true;
+        ulStart = DWT->CYCCNT;
+      }
+      if (bStarted && (ulBootElapsedMs(ulStart) >= BOOT_FRAME_TIMEOUT_MS)) break;
+    }
+
+    if ((DMA1->ISR & ulDoneFlag) != 0uL)
+    {
+      DMA1->IFCR = (ulHalf == 0uL) ? DMA_IFCR_CHTIF5 : DMA_IFCR_CTCIF5;
+      eStatus = eBOOT_TargetFrame(&sTarget, pucFrame, aucResp);
+    }
+    else if (pucFrame[BOOT_FRAME_SYNC] == BOOT_PROBE)
+    {
+      eStatus = BOOT_STATUS_READY;
+      vBOOT_PutResponse(aucResp, eStatus, 0uL);
+    }
+    else
+    {
+      eStatus = BOOT_STATUS_RESEND;
+      vBOOT_PutResponse(aucResp, eStatus, sTarget.ulNextSeq);
+    }
+
+    if (eStatus == BOOT_STATUS_ACK)
+    {
+      ulHalf ^= 1uL;
+    }
+    else if (eStatus != BOOT_STATUS_DONE)
+    {
+      // Resynchronise on the frame the uploader sends next
+      vBootWaitIdle();
+      vBootRxStart();
+      ulHalf = 0uL;
+    }
+    vBootSend(aucResp, BOOT_RESP_SIZE);
+    if (eStatus == BOOT_STATUS_DONE) return;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start application: vector table, stack pointer and reset handler
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vBootStartApp(void)
+{
+  const uint32_t* pulVectors = (const uint32_t*)BOOT_APP_BASE;
+
+  vBootDeinit();
+  SCB->VTOR = BOOT_APP_BASE;
+  __DSB();
+  __set_MSP(pulVectors[0]);
+  ((void (*)(void))pulVectors[1])();
+  for (;;) {}
+}
+
+/*!****************************************************************************
+ * @brief
+ * Flash driver: erase page
+ *
+ * @param[in] ulOffset  Page offset in application region
+ * @return  (bool)  Success
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bBootErase(uint32_t ulOffset)
+{
+  FLASH->KEYR = BOOT_FLASH_KEY1;
+  FLASH->KEYR = BOOT_FLASH_KEY2;
+  FLASH->SR = FLASH_SR_EOP | BOOT_FLASH_ERRORS;
+  FLASH->CR = FLASH_CR_PER;
+  FLASH->AR = BOOT_APP_BASE + ulOffset;
+  FLASH->CR = FLASH_CR_PER | FLASH_CR_STRT;
+  while ((FLASH->SR & FLASH_SR_BSY) != 0uL) {}
+  FLASH->CR = FLASH_CR_LOCK;
+
+  return (FLASH->SR & BOOT_FLASH_ERRORS) == 0uL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Flash driver: program erased page
+ *
+ * Erased half-words are skipped. The caller compares the page afterwards.
+ *
+ * @param[in] ulOffset  Page offset in application region
+ * @param[in] *pucData  Page data
+ * @return  (bool)  Success
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bBootProgram(uint32_t ulOffset, const uint8_t* pucData)
+{
+  volatile uint16_t* puiDst = (volatile uint16_t*)(BOOT_APP_BASE + ulOffset);
+  bool bOk = true;
+
+  FLASH->KEYR = BOOT_FLASH_KEY1;
+  FLASH->KEYR = BOOT_FLASH_KEY2;
+  FLASH->SR = FLASH_SR_EOP | BOOT_FLASH_ERRORS;
+  FLASH->CR = FLASH_CR_PG;
+  for (uint32_t i = 0uL; bOk && (i < BOOT_PAGE_SIZE / 2u); ++i)
+  {
+    uint16_t uiValue = (uint16_t)(pucData[2u * i] | ((uint16_t)pucData[2u * i + 1u] << 8));
+    if (uiValue == 0xFFFFu) continue;
+    puiDst[i] = uiValue;
+    while ((FLASH->SR & FLASH_SR_BSY) != 0uL) {}
+    bOk = (FLASH->SR & BOOT_FLASH_ERRORS) == 0uL;
+  }
+  FLASH->CR = FLASH_CR_LOCK;
+
+  return bOk;
+}
@@ -0,0 +1,283 @@
+/*!****************************************************************************
+ * @file
+ * hw_adc.c
+ *
+ * @brief
+ * Hardware Layer - ADC telemetry
+ *
+ * ADC1 continuously scans the internal temperature sensor, Vrefint and the
+ * analog input pins. DMA1 moves each result into a circular buffer split into
+ * two halves. On half/full transfer, the completed half is decimated into one
+ * sum per channel and passed through a moving average, while DMA keeps
+ * filling the other half.
+ *
+ *   ADCCLK = HW_CLK_ADCCLK = PCLK2 / 4 = 9 MHz (default)
+ *   t_conv = (239.5 + 12.5) / 9 MHz = 28 us per channel
+ *   half buffer = HW_ADC_FRAMES scan sequences = 1.8 ms (4 channels)
+ *
+ * Filtered values are kept as 12.4 fixed-point (sum of 16 samples). Voltages
+ * are ratiometric against Vrefint, so they do not depend on VDDA.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stddef.h>
+#include "stm32f1xx_hal.h"
+#include "filter.h"
+#include "hw_adc.h"
+#include "hw_clkcfg.h"
+#include "hw_init.h"
+#include "hw_iodef.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Scan sequences per half buffer, as power of two
+#define HW_ADC_FRAMES_SHIFT           4u
+
+/// Scan sequences per half buffer
+#define HW_ADC_FRAMES                 (1u << HW_ADC_FRAMES_SHIFT)
+
+/// Internal channels
+#define HW_ADC_CH_TEMP                16u
+#define HW_ADC_CH_VREFINT             17u
+
+/// Sample time selection for all channels (239.5 cycles, >= 17.1 us for TS)
+#define HW_ADC_SMP                    7uL
+
+/// Vrefint typical voltage in mV
+#define HW_ADC_VREFINT_MV             1200uL
+
+/// Temperature sensor voltage at 25 degC in 0.1 mV
+#define HW_ADC_TS_V25                 14300L
+
+/// Temperature sensor slope in 0.1 mV/degC
+#define HW_ADC_TS_SLOPE               43L
+
+_Static_assert(HW_ADC_FRAMES_SHIFT >= 4u, "decimation must yield at least 12.4 fixed-point");
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Scan sequence (internal channels first)
+static const uint8_t aucSequence[] = { HW_ADC_CH_TEMP, HW_ADC_CH_VREFINT, AIN_CHANNELS };
+
+/// Number of channels in scan sequence
+#define HW_ADC_NUM_CH                 (sizeof(aucSequence) / sizeof(aucSequence[0]))
+
+/// Number of analog input pins
+#define HW_ADC_NUM_INPUTS             (HW_ADC_NUM_CH - 2u)
+
+/// DMA double buffer
+static uint16_t auiBuffer[2u * HW_ADC_FRAMES * HW_ADC_NUM_CH];
+
+/// Moving average state per channel
+static FILT_MovAvgTypeDef asFilt[HW_ADC_NUM_CH];
+
+/// Filters have been seeded with first block
+static bool bPrimed;
+
+/// Published values
+static volatile int32_t lDieTemp;
+static volatile uint16_t uiVdda;
+static volatile uint16_t auiInputs[HW_ADC_NUM_INPUTS];
+
+/// Block completion callback
+static HW_ADC_CallbackTypeDef pfnBlockCallback;
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vHW_ADC_Process(const uint16_t* puiBlock);
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise ADC1 scan with DMA double buffering and start conversions
+ *
+ * - Internal temperature sensor (channel 16)
+ * - Internal reference voltage (channel 17)
+ * - AIN_PINS: Analog inputs
+ *
+ * With HW_INIT_DIRECT, clocks, prescaler and pins are set up by the bring-up
+ * table. The interrupt priority is taken from the priority plan (hw_irq).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_ADC_Init(void)
+{
+#if !HW_INIT_DIRECT
+  __HAL_RCC_GPIOB_CLK_ENABLE();
+  __HAL_RCC_ADC1_CLK_ENABLE();
+  __HAL_RCC_DMA1_CLK_ENABLE();
+  __HAL_RCC_ADC_CONFIG(HW_CLK_CFGR_ADCPRE);
+
+  GPIO_InitTypeDef sAin = {
+    .Pin = AIN_PINS,
+    .Mode = GPIO_MODE_ANALOG,
+    .Pull = GPIO_NOPULL
+  };
+  HAL_GPIO_Init(AIN_PORT, &sAin);
+#endif
+
+  // Scan sequence and sample times
+  uint32_t aulSqr[3] = { 0uL, 0uL, 0uL };
+  uint32_t ulSmpr1 = 0uL;
+  uint32_t ulSmpr2 = 0uL;
+  for (uint32_t i = 0uL; i < HW_ADC_NUM_CH; ++i)
+  {
+    uint32_t ulCh = aucSequence[i];
+    aulSqr[2u - i / 6u] |= ulCh << (5u * (i % 6u));
+    if (ulCh < 10u)
+    {
+      ulSmpr2 |= HW_ADC_SMP << (3u * ulCh);
+    }
+    else
+    {
+      ulSmpr1 |= HW_ADC_SMP << (3u * (ulCh - 10u));
+    }
+  }
+  ADC1->SMPR1 = ulSmpr1;
+  ADC1->SMPR2 = ulSmpr2;
+  ADC1->SQR1 = aulSqr[0] | ((HW_ADC_NUM_CH - 1uL) << ADC_SQR1_L_Pos);
+  ADC1->SQR2 = aulSqr[1];
+  ADC1->SQR3 = aulSqr[2];
+
+  // Continuous scan, DMA requests, software trigger
+  ADC1->CR1 = ADC_CR1_SCAN;
+  ADC1->CR2 = ADC_CR2_CONT | ADC_CR2_DMA | ADC_CR2_TSVREFE | ADC_CR2_EXTSEL | ADC_CR2_EXTTRIG;
+
+  // Power up and calibrate
+  ADC1->CR2 |= ADC_CR2_ADON;
+  HAL_Delay(1u);
+  ADC1->CR2 |= ADC_CR2_RSTCAL;
+  while ((ADC1->CR2 & ADC_CR2_RSTCAL) != 0uL) {}
+  ADC1->CR2 |= ADC_CR2_CAL;
+  while ((ADC1->CR2 & ADC_CR2_CAL) != 0uL) {}
+
+  // Circular DMA with half/full transfer interrupts
+  DMA_ADC_CHANNEL->CCR = 0uL;
+  DMA1->IFCR = DMA_ADC_IFCR_CGIF;
+  DMA_ADC_CHANNEL->CPAR = (uint32_t)&ADC1->DR;
+  DMA_ADC_CHANNEL->CMAR = (uint32_t)auiBuffer;
+  DMA_ADC_CHANNEL->CNDTR = sizeof(auiBuffer) / sizeof(auiBuffer[0]);
+  DMA_ADC_CHANNEL->CCR = DMA_CCR_PL_0 | DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_0 |
+                         DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_HTIE |
+                         DMA_CCR_TCIE | DMA_CCR_EN;
+
+  HAL_NVIC_EnableIRQ(DMA_ADC_IRQn);
+
+  bPrimed = false;
+  ADC1->CR2 |= ADC_CR2_SWSTART;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Set block completion callback
+ *
+ * The callback is invoked after new filtered values have been published.
+ *
+ * @param[in] pfnCallback   Callback, or NULL
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_ADC_SetCallback(HW_ADC_CallbackTypeDef pfnCallback)
+{
+  pfnBlockCallback = pfnCallback;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get filtered die temperature
+ *
+ * @return  (int32_t)   Temperature in 0.01 degC
+ * @date  19.10.2026
+ ******************************************************************************/
+int32_t lHW_ADC_GetDieTemp(void)
+{
+  return lDieTemp;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get filtered analog supply voltage (derived from Vrefint)
+ *
+ * @return  (uint16_t)  VDDA in mV
+ * @date  19.10.2026
+ ******************************************************************************/
+uint16_t uiHW_ADC_GetVdda(void)
+{
+  return uiVdda;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get filtered analog input voltage
+ *
+ * @param[in] ucIdx     Input index, in order of AIN_CHANNELS
+ * @return  (uint16_t)  Voltage in mV, 0 for invalid index
+ * @date  19.10.2026
+ ******************************************************************************/
+uint16_t uiHW_ADC_GetInput(uint8_t ucIdx)
+{
+  return (ucIdx < HW_ADC_NUM_INPUTS) ? auiInputs[ucIdx] : 0u;
+}
+
+/*!****************************************************************************
+ * @brief
+ * ADC DMA channel interrupt handler
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_ADC_IRQHandler(void)
+{
+  uint32_t ulIsr = DMA1->ISR;
+  DMA1->IFCR = DMA_ADC_IFCR_CGIF;
+
+  if ((ulIsr & DMA_ADC_ISR_HTIF) != 0uL)
+  {
+    vHW_ADC_Process(&auiBuffer[0]);
+  }
+  if ((ulIsr & DMA_ADC_ISR_TCIF) != 0uL)
+  {
+    vHW_ADC_Process(&auiBuffer[HW_ADC_FRAMES * HW_ADC_NUM_CH]);
+  }
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Filter a completed half buffer and publish results
+ *
+ * @param[in] *puiBlock   First sample of completed half buffer
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_ADC_Process(const uint16_t* puiBlock)
+{
+  uint32_t aulSums[HW_ADC_NUM_CH];
+  uint16_t auiFilt[HW_ADC_NUM_CH];
+  vFILT_Decimate(puiBlock, HW_ADC_FRAMES, HW_ADC_NUM_CH, aulSums);
+
+  for (uint32_t c = 0uL; c < HW_ADC_NUM_CH; ++c)
+  {
+    uint16_t uiSample = (uint16_t)(aulSums[c] >> (HW_ADC_FRAMES_SHIFT - 4u));
+    if (!bPrimed) vFILT_MovAvgInit(&asFilt[c], uiSample);
+    auiFilt[c] = uiFILT_MovAvgPush(&asFilt[c], uiSample);
+  }
+  bPrimed = true;
+
+  // Ratiometric conversion against Vrefint
+  uint32_t ulVref = auiFilt[1];
+  if (ulVref == 0uL) return;
+
+  uiVdda = (uint16_t)((HW_ADC_VREFINT_MV * (4095uL << 4)) / ulVref);
+  for (uint32_t i = 0uL; i < HW_ADC_NUM_INPUTS; ++i)
+  {
+    auiInputs[i] = (uint16_t)((auiFilt[2u + i] * HW_ADC_VREFINT_MV) / ulVref);
+  }
+
+  int32_t lVsense = (int32_t)((auiFilt[0] * (HW_ADC_VREFINT_MV * 10uL)) / ulVref);
+  lDieTemp = 2500L + ((HW_ADC_TS_V25 - lVsense) * 100L) / HW_ADC_TS_SLOPE;
+
+  if (pfnBlockCallback != NULL) pfnBlockCallback();
+}
@@ -0,0 +1,33 @@
+/*!****************************************************************************
+ * @file
+ * hw_adc.h
+ *
+ * @brief
+ * Hardware Layer - ADC telemetry
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef HW_ADC_H_
+#define HW_ADC_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Block completion callback, called from DMA interrupt context
+typedef void (*HW_ADC_CallbackTypeDef)(void);
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vHW_ADC_Init(void);
+void vHW_ADC_SetCallback(HW_ADC_CallbackTypeDef pfnCallback);
+
+int32_t lHW_ADC_GetDieTemp(void);
+uint16_t uiHW_ADC_GetVdda(void);
+uint16_t uiHW_ADC_GetInput(uint8_t ucIdx);
+
+void vHW_ADC_IRQHandler(void);
+
+#endif // HW_ADC_H_
@@ -0,0 +1,415 @@
+/*!****************************************************************************
+ * @file
+ * hw_capture.c
+ *
+ * @brief
+ * Hardware Layer - Input capture timestamping
+ *
+ * TIM2 counts free-running at the full timer clock (72 MHz: PCLK1 doubled
+ * for the divided APB1) and captures every rising edge of the input on CC1
+ * and every falling edge on CC2. Each rising edge requests one DMA burst
+ * through the DMA address register, which stores CCR1, CCR2 and CCR3 as one
+ * record in a circular buffer; no interrupt is taken per edge.
+ *
+ *   CCR1   rising edge
+ *   CCR2   last falling edge (low time before the rising edge)
+ *   CCR3   stamp: half counter periods counted (frozen output, no preload)
+ *
+ * Overflows are counted in half counter periods by the update and CC4
+ * (compare at 0x8000) interrupts, which also write the count into CCR3. The
+ * records are extended to 64-bit timestamps by lib/capture, exactly as long
+ * as the interrupt runs within a quarter counter period (227 us at 72 MHz);
+ * it therefore sits at the CRITICAL level, which no critical section masks.
+ *
+ * Timestamps are in counter ticks of system time: the counter start is
+ * placed at the system time in ticks, including the SysTick phase, and both
+ * run from the same clock. ullHW_CAPTURE_GetTime() / (clock / 1000) equals
+ * the system time in ms. Periods are exact at any length; the duty cycle
+ * needs high and low times below one counter period (910 us at 72 MHz, or
+ * longer with HW_CAPTURE_PRESCALER).
+ *
+ * The consumer collects all new records as one batch, at least every 30 s
+ * and before the buffer is full; the DMA half and full transfer interrupts
+ * count completed halves to detect overruns and may notify the consumer.
+ * The DMA channel is shared with the waveform sequencer and is taken from
+ * hw_dma for as long as capturing runs; the bootloader's USART1 receive
+ * uses it too, but never runs alongside the application.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stddef.h>
+#include "stm32f1xx_hal.h"
+#include "hw_capture.h"
+#include "hw_clk.h"
+#include "hw_dma.h"
+#include "hw_init.h"
+#include "hw_iodef.h"
+#include "hw_irq.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Halfword transfers per record (CCR1, CCR2, CCR3)
+#define HW_CAPTURE_BURST              (sizeof(CAPT_RawTypeDef) / sizeof(uint16_t))
+
+/// Halfword transfers per buffer
+#define HW_CAPTURE_TRANSFERS          (HW_CAPTURE_EDGES * HW_CAPTURE_BURST)
+
+/// DMA burst: HW_CAPTURE_BURST registers from CCR1
+#define HW_CAPTURE_DCR                                                         \
+  (((HW_CAPTURE_BURST - 1u) << TIM_DCR_DBL_Pos) |                              \
+   ((offsetof(TIM_TypeDef, CCR1) / sizeof(uint32_t)) << TIM_DCR_DBA_Pos))
+
+/// Interrupt flags marking a half period boundary
+#define HW_CAPTURE_SR_HALVES          (TIM_SR_UIF | TIM_SR_CC4IF)
+
+_Static_assert((HW_CAPTURE_EDGES >= 2u) && ((HW_CAPTURE_EDGES % 2u) == 0u),
+               "capture buffer must split into two halves");
+_Static_assert(HW_CAPTURE_TRANSFERS <= 0xFFFFu, "capture buffer exceeds DMA transfer count");
+_Static_assert((HW_CAPTURE_PRESCALER >= 1u) && (HW_CAPTURE_PRESCALER <= 0x10000u),
+               "capture prescaler out of range");
+_Static_assert(HW_CAPTURE_FILTER <= 15u, "capture filter out of range");
+
+
+/*- Private functions --------------------------------------------------------*/
+static uint64_t ullHW_CAPTURE_Halves(void);
+static uint32_t ulHW_CAPTURE_Written(void);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// DMA buffer
+static CAPT_RawTypeDef asRaw[HW_CAPTURE_EDGES];
+
+/// Half counter periods since start
+static volatile uint64_t ullHalves;
+
+/// Records written up to the last completed buffer half, or in total once stopped
+static volatile uint32_t ulFilled;
+
+/// DMA channel owned and writing records
+static volatile bool bRunning;
+
+/// Records consumed
+static uint32_t ulRead;
+
+/// Edge chain
+static CAPT_TypeDef sChain;
+
+/// Counter clock in Hz
+static uint32_t ulClock;
+
+/// Batches lost to buffer overruns
+static volatile uint32_t ulOverruns;
+
+/// Half buffer callback
+static HW_CAPTURE_CallbackTypeDef pfnHalfCallback;
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise capture timer, without starting
+ *
+ * - CAPT_PIN: Floating input
+ *
+ * With HW_INIT_DIRECT, clocks and pins are set up by the bring-up table. The
+ * interrupt priorities are taken from the priority plan (hw_irq).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_CAPTURE_Init(void)
+{
+#if !HW_INIT_DIRECT
+  __HAL_RCC_GPIOA_CLK_ENABLE();
+  __HAL_RCC_TIM2_CLK_ENABLE();
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  GPIO_InitTypeDef sPin = {
+    .Pin = CAPT_PIN,
+    .Mode = GPIO_MODE_INPUT,
+    .Pull = GPIO_NOPULL
+  };
+  HAL_GPIO_Init(CAPT_PORT, &sPin);
+#endif
+
+  // Timer clock is PCLK1 doubled when APB1 is divided
+  ulClock = HAL_RCC_GetPCLK1Freq();
+  if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1) ulClock *= 2uL;
+  ulClock /= HW_CAPTURE_PRESCALER;
+
+  // IC1 and IC2 both from TI1; CC3 and CC4 frozen outputs without preload
+  CAPT_TIM->CR1 = 0uL;
+  CAPT_TIM->DIER = 0uL;
+  CAPT_TIM->CCER = 0uL;
+  CAPT_TIM->PSC = HW_CAPTURE_PRESCALER - 1u;
+  CAPT_TIM->ARR = 0xFFFFuL;
+  CAPT_TIM->CCMR1 = (1uL << TIM_CCMR1_CC1S_Pos) | ((uint32_t)HW_CAPTURE_FILTER << TIM_CCMR1_IC1F_Pos) |
+                    (2uL << TIM_CCMR1_CC2S_Pos) | ((uint32_t)HW_CAPTURE_FILTER << TIM_CCMR1_IC2F_Pos);
+  CAPT_TIM->CCMR2 = 0uL;
+  CAPT_TIM->CCR4 = CAPT_HALF;
+  CAPT_TIM->DCR = HW_CAPTURE_DCR;
+
+  HAL_NVIC_EnableIRQ(CAPT_IRQn);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start capturing, discarding earlier records
+ *
+ * The half period interrupt then runs at about 2.2 kHz (at 72 MHz), which
+ * keeps tickless idle from sleeping longer; stop capturing when not needed.
+ *
+ * @return  (bool)  false if the sequencer holds the DMA channel
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_CAPTURE_Start(void)
+{
+  vHW_CAPTURE_Stop();
+  if (!bHW_DMA_AcquireShared(HW_DMA_SHARED_CAPTURE)) return false;
+
+  uint32_t ulLock = ulHW_IRQ_Lock();
+
+  // Load prescaler and clear counter, flags and stamp
+  CAPT_TIM->EGR = TIM_EGR_UG;
+  CAPT_TIM->SR = 0uL;
+  CAPT_TIM->CCR3 = 0uL;
+  ullHalves = 0uLL;
+  ulFilled = 0uL;
+  ulRead = 0uL;
+  bRunning = true;
+
+  DMA_SHARED_CHANNEL->CPAR = (uint32_t)&CAPT_TIM->DMAR;
+  DMA_SHARED_CHANNEL->CMAR = (uint32_t)asRaw;
+  DMA_SHARED_CHANNEL->CNDTR = HW_CAPTURE_TRANSFERS;
+  DMA_SHARED_CHANNEL->CCR = DMA_CCR_PL_1 | DMA_CCR_PL_0 | DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_0 |
+                            DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_EN;
+  CAPT_TIM->CCER = TIM_CCER_CC1E | TIM_CCER_CC2E | TIM_CCER_CC2P;
+  CAPT_TIM->DIER = TIM_DIER_UIE | TIM_DIER_CC4IE | TIM_DIER_CC1DE;
+
+  // System time at counter start; a tick pending in the lock is not counted yet
+  uint32_t ulLoad = SysTick->LOAD + 1uL;
+  uint32_t ulVal = SysTick->VAL;
+  uint32_t ulMs = ulHW_CLK_GetTime();
+  if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0uL)
+  {
+    ulVal = SysTick->VAL;
+    ulMs++;
+  }
+  CAPT_TIM->CR1 = TIM_CR1_CEN;
+
+  uint32_t ulPerMs = ulClock / 1000uL;
+  vCAPT_Init(&sChain, (uint64_t)ulMs * ulPerMs + (uint64_t)(ulLoad - 1uL - ulVal) * ulPerMs / ulLoad);
+  vHW_IRQ_Unlock(ulLock);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stop capturing and release the DMA channel
+ *
+ * Records captured before remain available to bHW_CAPTURE_GetBatch().
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_CAPTURE_Stop(void)
+{
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  CAPT_TIM->CR1 = 0uL;
+  CAPT_TIM->DIER = 0uL;
+  CAPT_TIM->CCER = 0uL;
+
+  // Keep the written count; the transfer counter then belongs to the next user
+  if (bRunning)
+  {
+    ulFilled = ulHW_CAPTURE_Written();
+    bRunning = false;
+  }
+  vHW_DMA_ReleaseShared(HW_DMA_SHARED_CAPTURE);
+  vHW_IRQ_Unlock(ulLock);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Set half buffer callback
+ *
+ * @param[in] pfnCallback   Called after each completed buffer half, or NULL
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_CAPTURE_SetCallback(HW_CAPTURE_CallbackTypeDef pfnCallback)
+{
+  pfnHalfCallback = pfnCallback;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Collect the records captured since the last call
+ *
+ * Single consumer only, from thread or half buffer callback. After an
+ * overrun, all pending records are dropped and the next period starts at
+ * the following edge.
+ *
+ * @param[out] *psBatch     Statistics of the new records
+ * @param[out] *pullEdges   Rising edge timestamps (HW_CAPTURE_EDGES entries),
+ *                          or NULL
+ * @return  (bool)  New rising edges collected
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_CAPTURE_GetBatch(CAPT_BatchTypeDef* psBatch, uint64_t* pullEdges)
+{
+  vCAPT_ClearBatch(psBatch);
+
+  // Stamps of the written records are not ahead of the half period count
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  uint32_t ulWritten = ulHW_CAPTURE_Written();
+  uint64_t ullNow = ullHW_CAPTURE_Halves();
+  vHW_IRQ_Unlock(ulLock);
+
+  // The record being written is in the slot after the written ones
+  uint32_t ulNew = ulWritten - ulRead;
+  if (ulNew < HW_CAPTURE_EDGES)
+  {
+    uint32_t ulIdx = ulRead % HW_CAPTURE_EDGES;
+    uint32_t ulFirst = HW_CAPTURE_EDGES - ulIdx;
+    if (ulFirst > ulNew) ulFirst = ulNew;
+
+    vCAPT_Process(&sChain, &asRaw[ulIdx], ulFirst, ullNow, psBatch, pullEdges);
+    vCAPT_Process(&sChain, &asRaw[0], ulNew - ulFirst, ullNow, psBatch,
+                  (pullEdges != NULL) ? &pullEdges[ulFirst] : NULL);
+
+    // Valid unless the DMA reached the first record meanwhile
+    ulLock = ulHW_IRQ_Lock();
+    ulWritten = ulHW_CAPTURE_Written();
+    vHW_IRQ_Unlock(ulLock);
+  }
+
+  if (ulWritten - ulRead >= HW_CAPTURE_EDGES)
+  {
+    ulOverruns++;
+    vCAPT_Init(&sChain, sChain.ullOrigin);
+    vCAPT_ClearBatch(psBatch);
+    ulRead = ulWritten;
+    return false;
+  }
+  ulRead += ulNew;
+  return psBatch->ulEdges != 0uL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get current time on the capture timebase
+ *
+ * @return  (uint64_t)  Counter ticks of system time
+ * @date  19.10.2026
+ ******************************************************************************/
+uint64_t ullHW_CAPTURE_GetTime(void)
+{
+  uint64_t ullNow;
+  uint16_t uiCount;
+  do
+  {
+    ullNow = ullHalves;
+    uiCount = (uint16_t)CAPT_TIM->CNT;
+  } while (ullNow != ullHalves);
+
+  return sChain.ullOrigin + ullCAPT_Extend(uiCount, (uint16_t)ullNow, ullNow);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get counter clock
+ *
+ * @return  (uint32_t)  Timestamp ticks per second
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulHW_CAPTURE_GetClock(void)
+{
+  return ulClock;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get number of buffer overruns
+ *
+ * @return  (uint32_t)  Batches dropped since reset
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulHW_CAPTURE_GetOverruns(void)
+{
+  return ulOverruns;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Capture timer interrupt handler: count half periods, update stamp
+ *
+ * Runs at the CRITICAL level and must not take the hw_irq lock.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_CAPTURE_IRQHandler(void)
+{
+  uint32_t ulSr = CAPT_TIM->SR & HW_CAPTURE_SR_HALVES;
+  CAPT_TIM->SR = ~ulSr;
+
+  uint64_t ullNow = ullHalves;
+  if ((ulSr & TIM_SR_UIF) != 0uL) ullNow++;
+  if ((ulSr & TIM_SR_CC4IF) != 0uL) ullNow++;
+  ullHalves = ullNow;
+  CAPT_TIM->CCR3 = (uint16_t)ullNow;
+}
+
+/*!****************************************************************************
+ * @brief
+ * DMA capture channel interrupt handler: count completed buffer halves
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_CAPTURE_DmaIRQHandler(void)
+{
+  uint32_t ulIsr = DMA1->ISR;
+  DMA1->IFCR = DMA_SHARED_IFCR_CGIF;
+
+  if ((ulIsr & DMA_SHARED_ISR_HTIF) != 0uL) ulFilled += HW_CAPTURE_EDGES / 2u;
+  if ((ulIsr & DMA_SHARED_ISR_TCIF) != 0uL) ulFilled += HW_CAPTURE_EDGES / 2u;
+
+  if (pfnHalfCallback != NULL) pfnHalfCallback();
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Read half period count consistently against the CRITICAL interrupt
+ *
+ * @return  (uint64_t)  Half counter periods since start
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint64_t ullHW_CAPTURE_Halves(void)
+{
+  uint64_t ullNow;
+  do
+  {
+    ullNow = ullHalves;
+  } while (ullNow != ullHalves);
+  return ullNow;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Count records written since start
+ *
+ * Called with the DMA interrupt masked; a buffer half completed since its
+ * last run is taken from the transfer counter while capturing.
+ *
+ * @return  (uint32_t)  Complete records written
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulHW_CAPTURE_Written(void)
+{
+  if (!bRunning) return ulFilled;
+
+  uint32_t ulPos = (HW_CAPTURE_TRANSFERS - DMA_SHARED_CHANNEL->CNDTR) / HW_CAPTURE_BURST;
+  uint32_t ulFill = ulFilled;
+  return ulFill + (ulPos + HW_CAPTURE_EDGES - ulFill % HW_CAPTURE_EDGES) % HW_CAPTURE_EDGES;
+}
@@ -0,0 +1,55 @@
+/*!****************************************************************************
+ * @file
+ * hw_capture.h
+ *
+ * @brief
+ * Hardware Layer - Input capture timestamping
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef HW_CAPTURE_H_
+#define HW_CAPTURE_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "capture.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Rising edges buffered between two batches (even)
+#ifndef HW_CAPTURE_EDGES
+#define HW_CAPTURE_EDGES              128u
+#endif
+
+/// Counter clock divider (1: full timer clock)
+#ifndef HW_CAPTURE_PRESCALER
+#define HW_CAPTURE_PRESCALER          1u
+#endif
+
+/// Input filter setting ICxF (0: none, 1..15: see reference manual)
+#ifndef HW_CAPTURE_FILTER
+#define HW_CAPTURE_FILTER             0u
+#endif
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Half buffer callback, called from DMA interrupt context
+typedef void (*HW_CAPTURE_CallbackTypeDef)(void);
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vHW_CAPTURE_Init(void);
+bool bHW_CAPTURE_Start(void);
+void vHW_CAPTURE_Stop(void);
+void vHW_CAPTURE_SetCallback(HW_CAPTURE_CallbackTypeDef pfnCallback);
+bool bHW_CAPTURE_GetBatch(CAPT_BatchTypeDef* psBatch, uint64_t* pullEdges);
+uint64_t ullHW_CAPTURE_GetTime(void);
+uint32_t ulHW_CAPTURE_GetClock(void);
+uint32_t ulHW_CAPTURE_GetOverruns(void);
+
+void vHW_CAPTURE_IRQHandler(void);
+void vHW_CAPTURE_DmaIRQHandler(void);
+
+#endif // HW_CAPTURE_H_
@@ -5,12 +5,68 @@
  * @brief
  * Hardware Layer - System Clock
  *
+ * SysTick increments the system time every millisecond and, while software
+ * timers are active, advances the timer wheel by one tick. The HAL tick
+ * counter is replaced by overriding HAL_GetTick(), so HAL timeouts and
+ * HAL_Delay() keep working without HAL_IncTick().
+ *
+ * For tickless idle, vHW_CLK_Sleep() stretches the SysTick period over ticks
+ * in which neither a software timer nor the caller has anything to do, and
+ * accounts for the skipped ticks after wake-up.
+ *
  * @date  13.10.2025
+ * @date  19.10.2026  Added software timer service
+ * @date  19.10.2026  Added tickless sleep
+ * @date  19.10.2026  Clock tree set up by bring-up table with HW_INIT_DIRECT
+ * @date  19.10.2026  Timer critical sections use hw_irq lock
+ * @date  19.10.2026  USB clock from PLL
+ * @date  19.10.2026  Clock tree solved at compile time from target frequencies
  ******************************************************************************/
 
 /*- Header files -------------------------------------------------------------*/
 #include "stm32f1xx_hal.h"
 #include "hw_clk.h"
+#include "hw_clkcfg.h"
+#include "hw_init.h"
+#include "hw_irq.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+_Static_assert((HSE_VALUE >= CLKTREE_HSE_MIN) && (HSE_VALUE <= CLKTREE_HSE_MAX),
+               "HSE_VALUE outside 4..16 MHz");
+_Static_assert((HW_CLK_SYSCLK >= CLKTREE_PLL_MIN) && (HW_CLK_SYSCLK <= CLKTREE_SYSCLK_MAX),
+               "HW_CLK_SYSCLK outside 16..72 MHz");
+_Static_assert(CLKTREE_PLLMUL(HSE_VALUE, HW_CLK_SYSCLK) != 0u,
+               "HW_CLK_SYSCLK is not HSE_VALUE or HSE_VALUE / 2 times 2..16");
+_Static_assert(CLKTREE_HPRE_DIV(HW_CLK_SYSCLK, HW_CLK_HCLK) != 0u,
+               "HW_CLK_HCLK is not HW_CLK_SYSCLK / 1, 2, 4, 8, 16, 64, 128, 256 or 512");
+_Static_assert((CLKTREE_PPRE_DIV(HW_CLK_HCLK, HW_CLK_PCLK1) != 0u) && (HW_CLK_PCLK1 <= CLKTREE_PCLK1_MAX),
+               "HW_CLK_PCLK1 is not HW_CLK_HCLK / 1, 2, 4, 8 or 16, up to 36 MHz");
+_Static_assert((CLKTREE_PPRE_DIV(HW_CLK_HCLK, HW_CLK_PCLK2) != 0u) && (HW_CLK_PCLK2 <= CLKTREE_PCLK2_MAX),
+               "HW_CLK_PCLK2 is not HW_CLK_HCLK / 1, 2, 4, 8 or 16");
+_Static_assert(CLKTREE_USB_OK(HW_CLK_SYSCLK, HW_CLK_USBCLK),
+               "HW_CLK_USBCLK needs 48 MHz from HW_CLK_SYSCLK / 1 or / 1.5");
+_Static_assert((CLKTREE_ADCPRE_DIV(HW_CLK_PCLK2, HW_CLK_ADCCLK) != 0u) &&
+               ((HW_CLK_ADCCLK == 0u) || ((HW_CLK_ADCCLK >= CLKTREE_ADCCLK_MIN) &&
+                                          (HW_CLK_ADCCLK <= CLKTREE_ADCCLK_MAX))),
+               "HW_CLK_ADCCLK is not HW_CLK_PCLK2 / 2, 4, 6 or 8, within 0.6..14 MHz");
+_Static_assert(HW_CLK_FEASIBLE, "clock tree infeasible");
+_Static_assert((CLKTREE_CFGR_HPRE_Pos == RCC_CFGR_HPRE_Pos) && (CLKTREE_CFGR_PPRE1_Pos == RCC_CFGR_PPRE1_Pos) &&
+               (CLKTREE_CFGR_PPRE2_Pos == RCC_CFGR_PPRE2_Pos) && (CLKTREE_CFGR_ADCPRE_Pos == RCC_CFGR_ADCPRE_Pos) &&
+               (CLKTREE_CFGR_PLLSRC_Pos == RCC_CFGR_PLLSRC_Pos) &&
+               (CLKTREE_CFGR_PLLXTPRE_Pos == RCC_CFGR_PLLXTPRE_Pos) &&
+               (CLKTREE_CFGR_PLLMULL_Pos == RCC_CFGR_PLLMULL_Pos) &&
+               (CLKTREE_CFGR_USBPRE_Pos == RCC_CFGR_USBPRE_Pos) &&
+               (CLKTREE_FLASH_ACR_PRFTBE_Pos == FLASH_ACR_PRFTBE_Pos),
+               "clock tree register layout differs from CMSIS");
+
+
+/*- Private data -------------------------------------------------------------*/
+/// System time in milliseconds
+static volatile uint32_t ulTicks;
+
+/// Software timer wheel, advanced from SysTick
+static TWHEEL_TypeDef sWheel;
 
 
 /*- Public interface ---------------------------------------------------------*/
@@ -18,32 +74,45 @@
  * @brief
  * Configure system clock tree
  *
- *       8 MHz    /1    72 MHz            72 MHz
- *       HSECLK   *9    SYSCLK     /1     HCLK
- *   HSE------->[ PLL ]------->[ AHBPRE ]----+-------------------------> CPU
- *                                           |               9 MHz
- *                                           |        /8     STKCLK
- *                                           +----[ STKPRE ]-------> SysTick
- *                                           |                36 MHz
- *                                           |        /2      PCLK1
- *                                           +----[ APB1PRE ]---------> APB1
- *                                           |                36 MHz
- *                                           |        /2      PCLK2
- *                                           '----[ APB2PRE ]---------> APB2
+ *       HSE_VALUE  /PREDIV  SYSCLK             HCLK
+ *       HSECLK     *PLLMUL                                      SysTick
+ *   HSE------->[ PLL ]--+---->[ AHBPRE ]----+-------------------------> CPU
+ *                       |                   |                PCLK1
+ *                       |                   +----[ APB1PRE ]---------> APB1
+ *                       |                   |                PCLK2
+ *                       |                   '----[ APB2PRE ]---+-----> APB2
+ *                       |                                      |  ADCCLK
+ *                       |                                      '-[ ADCPRE ]-> ADC
+ *                       |                  USBCLK
+ *                       |      /1, /1.5
+ *                       '----[ USBPRE ]-------------------------------> USB
+ *
+ * The settings are solved from the HW_CLK_* targets (hw_clkcfg.h); by
+ * default 72 MHz SYSCLK and HCLK from an 8 MHz HSE (*9), 36 MHz PCLK1 and
+ * PCLK2, 9 MHz ADCCLK and 48 MHz USBCLK (/1.5). SysTick runs from HCLK.
+ *
+ * With HW_INIT_DIRECT, the clock tree has been set up by the bring-up table
+ * already and only the timer service is initialised.
  *
  * @date  13.10.2025
+ * @date  19.10.2026
+ * @date  19.10.2026  USB clock from PLL
+ * @date  19.10.2026  Settings from compile-time solver
  ******************************************************************************/
 void vHW_CLK_Init(void)
 {
+  vTWHEEL_Init(&sWheel, ulTicks);
+
+#if !HW_INIT_DIRECT
   // Set up PLL and SYSCLK
   RCC_OscInitTypeDef sOsc = {
     .OscillatorType = RCC_OSCILLATORTYPE_HSE,
-    .HSEPredivValue = RCC_HSE_PREDIV_DIV1,
+    .HSEPredivValue = HW_CLK_CFGR_PLLXTPRE,
     .HSEState = RCC_HSE_ON,
     .PLL = {
       .PLLSource = RCC_PLLSOURCE_HSE,
       .PLLState = RCC_PLL_ON,
-      .PLLMUL = RCC_PLL_MUL9
+      .PLLMUL = HW_CLK_CFGR_PLLMULL
     }
   };
   if (HAL_RCC_OscConfig(&sOsc) != HAL_OK) __BKPT();
@@ -52,15 +121,25 @@ void vHW_CLK_Init(void)
   RCC_ClkInitTypeDef sClk = {
     .ClockType = RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2,
     .SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK,
-    .AHBCLKDivider = RCC_SYSCLK_DIV1,
-    .APB1CLKDivider = RCC_HCLK_DIV2,
-    .APB2CLKDivider = RCC_HCLK_DIV2
+    .AHBCLKDivider = HW_CLK_CFGR_HPRE,
+    .APB1CLKDivider = HW_CLK_CFGR_PPRE1,
+    .APB2CLKDivider = HW_CLK_CFGR_PPRE2 >> (RCC_CFGR_PPRE2_Pos - RCC_CFGR_PPRE1_Pos)
   };
-  if (HAL_RCC_ClockConfig(&sClk, FLASH_LATENCY_2) != HAL_OK) __BKPT();
+  if (HAL_RCC_ClockConfig(&sClk, HW_CLK_FLASH_LATENCY) != HAL_OK) __BKPT();
+
+#if HW_CLK_USBCLK != 0
+  // USB at 48 MHz
+  RCC_PeriphCLKInitTypeDef sPeriph = {
+    .PeriphClockSelection = RCC_PERIPHCLK_USB,
+    .UsbClockSelection = HW_CLK_CFGR_USBPRE
+  };
+  if (HAL_RCCEx_PeriphCLKConfig(&sPeriph) != HAL_OK) __BKPT();
+#endif
 
   // Disable unused LSI and HSI
   __HAL_RCC_LSI_DISABLE();
   __HAL_RCC_HSI_DISABLE();
+#endif
 }
 
 /*!****************************************************************************
@@ -74,7 +153,7 @@ void vHW_CLK_Init(void)
  ******************************************************************************/
 uint32_t ulHW_CLK_GetTime(void)
 {
-  return HAL_GetTick();
+  return ulTicks;
 }
 
 /*!****************************************************************************
@@ -88,3 +167,174 @@ uint32_t ulHW_CLK_GetCoreClkFreq(void)
 {
   return SystemCoreClock;
 }
+
+/*!****************************************************************************
+ * @brief
+ * Initialise software timer
+ *
+ * @param[out] *psTimer     Timer
+ * @param[in] pfnCallback   Expiry callback, called from SysTick interrupt
+ * @param[in] *pvContext    User context, stored in timer
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_CLK_TimerInit(HW_CLK_TimerTypeDef* psTimer,
+                       HW_CLK_TimerCallbackTypeDef pfnCallback, void* pvContext)
+{
+  psTimer->psNext = NULL;
+  psTimer->ppsPrev = NULL;
+  psTimer->ulExpiry = 0uL;
+  psTimer->ulPeriod = 0uL;
+  psTimer->pfnCallback = pfnCallback;
+  psTimer->pvContext = pvContext;
+}
+
+/*!****************************************************************************
+ * @brief
+ * (Re-)start software timer
+ *
+ * An active timer is restarted with the new settings.
+ *
+ * @param[in,out] *psTimer  Timer
+ * @param[in] ulDelay       Delay until first expiry in ms (min. 1)
+ * @param[in] ulPeriod      Reload period in ms, 0 for one-shot
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_CLK_TimerStart(HW_CLK_TimerTypeDef* psTimer, uint32_t ulDelay,
+                        uint32_t ulPeriod)
+{
+  uint32_t ulLock = ulHW_IRQ_Lock();
+
+  vTWHEEL_Remove(&sWheel, psTimer);
+
+  // Wheel is not advanced while empty, catch up with system time
+  if (sWheel.ulActive == 0uL) sWheel.ulNow = ulTicks;
+
+  psTimer->ulExpiry = sWheel.ulNow + ((ulDelay != 0uL) ? ulDelay : 1uL);
+  psTimer->ulPeriod = ulPeriod;
+  vTWHEEL_Insert(&sWheel, psTimer);
+
+  vHW_IRQ_Unlock(ulLock);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stop software timer
+ *
+ * @param[in,out] *psTimer  Timer
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_CLK_TimerStop(HW_CLK_TimerTypeDef* psTimer)
+{
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  vTWHEEL_Remove(&sWheel, psTimer);
+  vHW_IRQ_Unlock(ulLock);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if software timer is running
+ *
+ * @param[in] *psTimer  Timer
+ * @return  (bool)    Timer active
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_CLK_TimerIsActive(const HW_CLK_TimerTypeDef* psTimer)
+{
+  return bTWHEEL_IsActive(psTimer);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Sleep until next interrupt, suppressing idle ticks
+ *
+ * Must be called with interrupts disabled (PRIMASK). Returns with interrupts
+ * still disabled after any interrupt became pending; it is taken once the
+ * caller enables interrupts. If software timers and caller allow it, SysTick
+ * only fires at the end of the idle period. Ticks passed until wake-up are
+ * added to system time and timer wheel on return.
+ *
+ * @param[in] ulIdleTicks   Ticks after the current one the caller does not
+ *                          need (UINT32_MAX: no limit)
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_CLK_Sleep(uint32_t ulIdleTicks)
+{
+  uint32_t ulReload = SysTick->LOAD + 1uL;
+  uint32_t ulLimit = SysTick_LOAD_RELOAD_Msk / ulReload - 1uL;
+  uint32_t ulSkip = ulTWHEEL_GetIdleTicks(&sWheel, (ulIdleTicks < ulLimit) ? ulIdleTicks : ulLimit);
+
+  // Stop counter to reprogram it
+  uint32_t ulCtrl = SysTick->CTRL;
+  SysTick->CTRL = ulCtrl & ~SysTick_CTRL_ENABLE_Msk;
+  uint32_t ulVal = SysTick->VAL;
+  bool bTickPending = ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0uL) || (ulVal == 0uL);
+
+  if ((ulSkip == 0uL) || bTickPending)
+  {
+    SysTick->CTRL = ulCtrl;
+    __DSB();
+    __WFI();
+    return;
+  }
+
+  // Fire at the end of the idle period, then continue with regular period
+  uint32_t ulTotal = ulVal + ulSkip * ulReload;
+  SysTick->LOAD = ulTotal - 1uL;
+  SysTick->VAL = 0uL;
+  SysTick->CTRL = ulCtrl;
+  SysTick->LOAD = ulReload - 1uL;
+
+  __DSB();
+  __WFI();
+
+  SysTick->CTRL = ulCtrl & ~SysTick_CTRL_ENABLE_Msk;
+  uint32_t ulPassed;
+  if (((SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) != 0uL) ||
+      ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0uL))
+  {
+    // Idle period elapsed, its last tick is processed by the pending interrupt
+    ulPassed = ulSkip;
+  }
+  else
+  {
+    // Woken early, resume within the current tick
+    uint32_t ulRemaining = SysTick->VAL;
+    uint32_t ulElapsed = ulTotal - ulRemaining;
+    ulPassed = (ulElapsed >= ulVal) ? (1uL + (ulElapsed - ulVal) / ulReload) : 0uL;
+    uint32_t ulPartial = ulRemaining % ulReload;
+    SysTick->LOAD = ((ulPartial != 0uL) ? ulPartial : ulReload) - 1uL;
+    SysTick->VAL = 0uL;
+  }
+  SysTick->CTRL = ulCtrl;
+  SysTick->LOAD = ulReload - 1uL;
+
+  // Skipped ticks have no timers due
+  for (uint32_t i = 0uL; i < ulPassed; ++i)
+  {
+    vHW_CLK_TickHandler();
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * SysTick handler: advance system time and timer wheel
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_CLK_TickHandler(void)
+{
+  ulTicks++;
+  if (sWheel.ulActive != 0uL) vTWHEEL_Advance(&sWheel);
+}
+
+/*!****************************************************************************
+ * @brief
+ * HAL tick source override
+ *
+ * @return  (uint32_t)  System time in milliseconds
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t HAL_GetTick(void)
+{
+  return ulTicks;
+}
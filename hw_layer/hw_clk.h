@@ -12,7 +12,17 @@
 #define HW_CLK_H_
 
 /*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
 #include <stdint.h>
+#include "timer_wheel.h"
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Software timer
+typedef TWHEEL_TimerTypeDef HW_CLK_TimerTypeDef;
+
+/// Software timer expiry callback, called from SysTick interrupt context
+typedef TWHEEL_CallbackTypeDef HW_CLK_TimerCallbackTypeDef;
 
 
 /*- Public interface ---------------------------------------------------------*/
@@ -20,4 +30,15 @@ void vHW_CLK_Init(void);
 uint32_t ulHW_CLK_GetTime(void);
 uint32_t ulHW_CLK_GetCoreClkFreq(void);
 
+// Software timers
+void vHW_CLK_TimerInit(HW_CLK_TimerTypeDef* psTimer,
+                       HW_CLK_TimerCallbackTypeDef pfnCallback, void* pvContext);
+void vHW_CLK_TimerStart(HW_CLK_TimerTypeDef* psTimer, uint32_t ulDelay,
+                        uint32_t ulPeriod);
+void vHW_CLK_TimerStop(HW_CLK_TimerTypeDef* psTimer);
+bool bHW_CLK_TimerIsActive(const HW_CLK_TimerTypeDef* psTimer);
+
+void vHW_CLK_Sleep(uint32_t ulIdleTicks);
+void vHW_CLK_TickHandler(void);
+
 #endif // HW_CLK_H_
@@ -0,0 +1,86 @@
+/*!****************************************************************************
+ * @file
+ * hw_clkcfg.h
+ *
+ * @brief
+ * Hardware Layer - Clock tree configuration
+ *
+ * Target frequencies of the clock tree; the register values are solved from
+ * them and HSE_VALUE at compile time (lib/clktree). hw_clk fails the build if
+ * a target cannot be reached exactly.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef HW_CLKCFG_H_
+#define HW_CLKCFG_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include "stm32f1xx_hal.h"
+#include "clktree.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Core clock (PLL output) in Hz
+#ifndef HW_CLK_SYSCLK
+#define HW_CLK_SYSCLK                 72000000uL
+#endif
+
+/// AHB clock in Hz (CPU, SysTick, DMA)
+#ifndef HW_CLK_HCLK
+#define HW_CLK_HCLK                   HW_CLK_SYSCLK
+#endif
+
+/// APB1 clock in Hz (up to 36 MHz)
+#ifndef HW_CLK_PCLK1
+#define HW_CLK_PCLK1                  36000000uL
+#endif
+
+/// APB2 clock in Hz
+#ifndef HW_CLK_PCLK2
+#define HW_CLK_PCLK2                  36000000uL
+#endif
+
+/// USB clock in Hz (48 MHz, 0: unused)
+#ifndef HW_CLK_USBCLK
+#define HW_CLK_USBCLK                 48000000uL
+#endif
+
+/// ADC clock in Hz (up to 14 MHz, 0: unused)
+#ifndef HW_CLK_ADCCLK
+#define HW_CLK_ADCCLK                 9000000uL
+#endif
+
+/// All targets reachable from HSE_VALUE
+#define HW_CLK_FEASIBLE                                                        \
+  CLKTREE_FEASIBLE(HSE_VALUE, HW_CLK_SYSCLK, HW_CLK_HCLK, HW_CLK_PCLK1, HW_CLK_PCLK2, \
+                   HW_CLK_USBCLK, HW_CLK_ADCCLK)
+
+/*! @brief Register values of the direct bring-up
+ *  @{                                                                        */
+#define HW_CLK_CFGR                                                            \
+  CLKTREE_CFGR(HSE_VALUE, HW_CLK_SYSCLK, HW_CLK_HCLK, HW_CLK_PCLK1, HW_CLK_PCLK2, \
+               HW_CLK_USBCLK, HW_CLK_ADCCLK)
+#define HW_CLK_FLASH_ACR              CLKTREE_FLASH_ACR(HW_CLK_SYSCLK)
+/*! @}                                                                        */
+
+/*! @brief Register fields, for the HAL path (HAL constants such as RCC_PLL_MUL9
+ *         or RCC_HCLK_DIV2 are the field values)
+ *  @{                                                                        */
+#define HW_CLK_CFGR_PLLXTPRE          (HW_CLK_CFGR & RCC_CFGR_PLLXTPRE)
+#define HW_CLK_CFGR_PLLMULL           (HW_CLK_CFGR & RCC_CFGR_PLLMULL)
+#define HW_CLK_CFGR_USBPRE            (HW_CLK_CFGR & RCC_CFGR_USBPRE)
+#define HW_CLK_CFGR_HPRE              (HW_CLK_CFGR & RCC_CFGR_HPRE)
+#define HW_CLK_CFGR_PPRE1             (HW_CLK_CFGR & RCC_CFGR_PPRE1)
+#define HW_CLK_CFGR_PPRE2             (HW_CLK_CFGR & RCC_CFGR_PPRE2)
+#define HW_CLK_CFGR_ADCPRE            (HW_CLK_CFGR & RCC_CFGR_ADCPRE)
+#define HW_CLK_FLASH_LATENCY          (HW_CLK_FLASH_ACR & FLASH_ACR_LATENCY)
+/*! @}                                                                        */
+
+/*! @brief Timer clocks in Hz (TIM2..4 on APB1, TIM1 on APB2)
+ *  @{                                                                        */
+#define HW_CLK_TIMCLK1                CLKTREE_TIMCLK(HW_CLK_HCLK, HW_CLK_PCLK1)
+#define HW_CLK_TIMCLK2                CLKTREE_TIMCLK(HW_CLK_HCLK, HW_CLK_PCLK2)
+/*! @}                                                                        */
+
+#endif // HW_CLKCFG_H_
@@ -0,0 +1,322 @@
+/*!****************************************************************************
+ * @file
+ * hw_crc.c
+ *
+ * @brief
+ * Hardware Layer - CRC-32 unit and image self-check
+ *
+ * The STM32F1 CRC unit computes the CRC-32 polynomial MSB first over 32-bit
+ * words, starting from 0xFFFFFFFF, without reflection or final XOR. Its
+ * result register can only be reset, not loaded. To match zlib's crc32(),
+ * each input word and the result are bit-reversed (RBIT) and the result is
+ * inverted; unaligned head and tail bytes are processed in software. Since
+ * the DMA cannot reverse bits, DMA feeding is limited to the native variant.
+ *
+ * Every context keeps its CRC in RAM, so that several streams can be
+ * interleaved. Before feeding, the unit is brought to the context's state
+ * unless it already holds it: after a reset, one word chosen by running the
+ * CRC shift register backwards yields any desired state.
+ *
+ * At boot, the flash image is checked against the CRC embedded by the
+ * post-build step (tools/image_crc). The descriptor in section ".image_crc"
+ * tells where the image starts relative to itself and how long it is.
+ *
+ * The unit is shared; contexts must not be updated from interrupts.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "stm32f1xx_hal.h"
+#include "crc32.h"
+#include "hw_crc.h"
+#include "hw_dma.h"
+#include "hw_init.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Reset value of CRC unit
+#define HW_CRC_RESET_VALUE            0xFFFFFFFFuL
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vHW_CRC_Load(uint32_t ulState);
+static void vHW_CRC_DmaDone(DMAQ_RequestTypeDef* psReq);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Image descriptor, completed by the post-build step
+__attribute__((section(HW_CRC_IMAGE_SECTION), used))
+static const HW_CRC_ImageTypeDef sImage = {
+  .aulMagic = { HW_CRC_IMAGE_MAGIC0, HW_CRC_IMAGE_MAGIC1 }
+};
+
+/// Image self-check result
+static HW_CRC_ImageCheckTypeDef sImageCheck;
+
+/// DMA feed request
+static DMAQ_RequestTypeDef sDmaReq;
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise CRC unit
+ *
+ * With HW_INIT_DIRECT, the clock is enabled by the bring-up table.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_CRC_Init(void)
+{
+#if !HW_INIT_DIRECT
+  __HAL_RCC_CRC_CLK_ENABLE();
+#endif
+  CRC->CR = CRC_CR_RESET;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start CRC calculation
+ *
+ * @param[out] *psCtx   Context
+ * @param[in] eMode     CRC variant
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_CRC_Start(HW_CRC_ContextTypeDef* psCtx, HW_CRC_ModeTypeDef eMode)
+{
+  psCtx->eMode = eMode;
+  psCtx->ulCrc = (eMode == HW_CRC_MODE_ZLIB) ? CRC32_INIT : HW_CRC_RESET_VALUE;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Feed data by CPU
+ *
+ * Waits for a pending DMA feed first. In native mode, the unit only processes
+ * whole words, so the length is rounded down to a multiple of 4.
+ *
+ * @param[in,out] *psCtx  Context
+ * @param[in] *pvData     Data, any alignment
+ * @param[in] ulLen       Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_CRC_Update(HW_CRC_ContextTypeDef* psCtx, const void* pvData, uint32_t ulLen)
+{
+  (void)eHW_DMA_Wait(&sDmaReq);
+
+  const uint8_t* pucData = (const uint8_t*)pvData;
+  uint32_t ulCrc = psCtx->ulCrc;
+
+  if (psCtx->eMode == HW_CRC_MODE_NATIVE)
+  {
+    uint32_t ulWords = ulLen >> 2;
+    vHW_CRC_Load(ulCrc);
+    for (uint32_t i = 0uL; i < ulWords; ++i)
+    {
+      uint32_t ulWord;
+      (void)memcpy(&ulWord, &pucData[i * 4uL], sizeof(ulWord));
+      CRC->DR = ulWord;
+    }
+    psCtx->ulCrc = CRC->DR;
+    return;
+  }
+
+  // Unaligned head in software
+  uint32_t ulHead = (uint32_t)(-(uintptr_t)pucData) & 0x3uL;
+  if (ulHead > ulLen) ulHead = ulLen;
+  ulCrc = ulCRC32_Update(ulCrc, pucData, ulHead);
+  pucData += ulHead;
+  ulLen -= ulHead;
+
+  // Whole words on CRC unit, bit order reversed
+  uint32_t ulWords = ulLen >> 2;
+  if (ulWords != 0uL)
+  {
+    const uint32_t* pulData = (const uint32_t*)pucData;
+    vHW_CRC_Load(__RBIT(~ulCrc));
+    for (uint32_t i = 0uL; i < ulWords; ++i)
+    {
+      CRC->DR = __RBIT(pulData[i]);
+    }
+    ulCrc = ~__RBIT(CRC->DR);
+    pucData += ulWords * 4uL;
+  }
+
+  // Tail in software
+  psCtx->ulCrc = ulCRC32_Update(ulCrc, pucData, ulLen & 0x3uL);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Feed data by DMA
+ *
+ * Returns immediately; the CPU is free until ulHW_CRC_Final() or the next
+ * update. Only available in native mode, see file description. Worth it
+ * for large regions (see "crc" benchmark suite).
+ *
+ * @param[in,out] *psCtx  Context, must stay valid until the feed is done
+ * @param[in] *pulData    Data, word aligned, in flash or SRAM
+ * @param[in] ulCount     Number of words
+ * @return  (bool)      false if a feed is still in progress, wrong mode or
+ *                      unaligned data
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_CRC_UpdateDma(HW_CRC_ContextTypeDef* psCtx, const uint32_t* pulData, uint32_t ulCount)
+{
+  if ((psCtx->eMode != HW_CRC_MODE_NATIVE) || (((uintptr_t)pulData & 0x3uL) != 0uL) ||
+      bHW_DMA_IsPending(&sDmaReq))
+  {
+    return false;
+  }
+
+  vHW_CRC_Load(psCtx->ulCrc);
+  sDmaReq.pvContext = psCtx;
+  return bHW_DMA_Feed(&sDmaReq, &CRC->DR, pulData, ulCount, vHW_CRC_DmaDone);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if a DMA feed is in progress
+ *
+ * @return  (bool)  DMA feed in progress
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_CRC_IsBusy(void)
+{
+  return bHW_DMA_IsPending(&sDmaReq);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get CRC of all data fed so far
+ *
+ * Waits for a pending DMA feed. The context may be updated further.
+ *
+ * @param[in] *psCtx    Context
+ * @return  (uint32_t)  CRC
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulHW_CRC_Final(HW_CRC_ContextTypeDef* psCtx)
+{
+  (void)eHW_DMA_Wait(&sDmaReq);
+  return psCtx->ulCrc;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Calculate zlib compatible CRC-32 of a block
+ *
+ * @param[in] *pvData   Data, any alignment
+ * @param[in] ulLen     Number of bytes
+ * @return  (uint32_t)  CRC, same as crc32(0, pvData, ulLen)
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulHW_CRC_Calc(const void* pvData, uint32_t ulLen)
+{
+  HW_CRC_ContextTypeDef sCtx;
+  vHW_CRC_Start(&sCtx, HW_CRC_MODE_ZLIB);
+  vHW_CRC_Update(&sCtx, pvData, ulLen);
+  return ulHW_CRC_Final(&sCtx);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check flash image against embedded CRC
+ *
+ * Requires the DWT cycle counter to be running for the duration.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_CRC_CheckImage(void)
+{
+  uint32_t ulStart = DWT->CYCCNT;
+
+  // Hide descriptor contents from the optimiser, they change after linking
+  const HW_CRC_ImageTypeDef* psImage = &sImage;
+  __asm volatile("" : "+r" (psImage));
+
+  uint32_t ulOffset = psImage->ulOffset;
+  uint32_t ulLength = psImage->ulLength;
+  uint32_t ulFlashSize = (uint32_t)*(const uint16_t*)FLASHSIZE_BASE * 1024uL;
+  sImageCheck.ulLength = ulLength;
+  sImageCheck.ulExpected = psImage->ulCrc;
+
+  if ((ulLength < sizeof(HW_CRC_ImageTypeDef)) || (ulLength > ulFlashSize) ||
+      (ulOffset > ulLength - sizeof(HW_CRC_ImageTypeDef)))
+  {
+    sImageCheck.eStatus = HW_CRC_IMAGE_MISSING;
+    return;
+  }
+
+  // CRC field itself counts as zero
+  const uint8_t* pucBase = (const uint8_t*)psImage - ulOffset;
+  uint32_t ulField = ulOffset + offsetof(HW_CRC_ImageTypeDef, ulCrc);
+  uint32_t ulRest = ulField + sizeof(uint32_t);
+  static const uint32_t ulZero = 0uL;
+
+  HW_CRC_ContextTypeDef sCtx;
+  vHW_CRC_Start(&sCtx, HW_CRC_MODE_ZLIB);
+  vHW_CRC_Update(&sCtx, pucBase, ulField);
+  vHW_CRC_Update(&sCtx, &ulZero, sizeof(ulZero));
+  vHW_CRC_Update(&sCtx, pucBase + ulRest, ulLength - ulRest);
+  sImageCheck.ulActual = ulHW_CRC_Final(&sCtx);
+
+  sImageCheck.eStatus = (sImageCheck.ulActual == sImageCheck.ulExpected) ?
+                        HW_CRC_IMAGE_OK : HW_CRC_IMAGE_CORRUPT;
+  sImageCheck.ulCycles = DWT->CYCCNT - ulStart;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get image self-check result
+ *
+ * @return  (const HW_CRC_ImageCheckTypeDef*)   Result
+ * @date  19.10.2026
+ ******************************************************************************/
+const HW_CRC_ImageCheckTypeDef* psHW_CRC_GetImageCheck(void)
+{
+  return &sImageCheck;
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Bring CRC unit to a given state
+ *
+ * Each word written updates the unit as DR = F(DR ^ word), where F is 32
+ * steps of the CRC shift register. F is invertible, so after a reset the
+ * word F^-1(state) ^ 0xFFFFFFFF produces the state.
+ *
+ * @param[in] ulState   Unit state (native, not reflected)
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_CRC_Load(uint32_t ulState)
+{
+  if (CRC->DR == ulState) return;
+
+  CRC->CR = CRC_CR_RESET;
+  if (ulState == HW_CRC_RESET_VALUE) return;
+
+  for (uint32_t i = 0uL; i < 32uL; ++i)
+  {
+    ulState = ((ulState & 1uL) != 0uL) ? (((ulState ^ CRC32_POLY) >> 1) | 0x80000000uL) : (ulState >> 1);
+  }
+  CRC->DR = ulState ^ HW_CRC_RESET_VALUE;
+}
+
+/*!****************************************************************************
+ * @brief
+ * DMA feed completion callback
+ *
+ * @param[in] *psReq  Completed request
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_CRC_DmaDone(DMAQ_RequestTypeDef* psReq)
+{
+  HW_CRC_ContextTypeDef* psCtx = (HW_CRC_ContextTypeDef*)psReq->pvContext;
+  psCtx->ulCrc = CRC->DR;
+}
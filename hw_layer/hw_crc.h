@@ -0,0 +1,84 @@
+/*!****************************************************************************
+ * @file
+ * hw_crc.h
+ *
+ * @brief
+ * Hardware Layer - CRC-32 unit and image self-check
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef HW_CRC_H_
+#define HW_CRC_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/*! @brief Image descriptor magic, searched for by the post-build step
+ *  @{                                                                        */
+#define HW_CRC_IMAGE_MAGIC0           0x43474D49uL    ///< "IMGC"
+#define HW_CRC_IMAGE_MAGIC1           0x32335243uL    ///< "RC32"
+/*! @}                                                                        */
+
+/// Linker section of image descriptor, replaced by the post-build step
+#define HW_CRC_IMAGE_SECTION          ".image_crc"
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// CRC variant
+typedef enum {
+  HW_CRC_MODE_ZLIB = 0,           ///< Reflected, final XOR (zlib crc32()), CPU fed
+  HW_CRC_MODE_NATIVE              ///< Native unit result (CRC-32/MPEG-2 over
+                                  ///< little-endian words), CPU or DMA fed
+} HW_CRC_ModeTypeDef;
+
+/// Streaming CRC context
+typedef struct {
+  volatile uint32_t ulCrc;        ///< CRC of data so far
+  HW_CRC_ModeTypeDef eMode;       ///< CRC variant
+} HW_CRC_ContextTypeDef;
+
+/*! @brief Image descriptor
+ *
+ * Placed in flash by the firmware with magic only. The post-build step fills
+ * in offset, length and CRC of the linked image.                           */
+typedef struct {
+  uint32_t aulMagic[2];           ///< HW_CRC_IMAGE_MAGICx
+  uint32_t ulOffset;              ///< Offset of descriptor from image start
+  uint32_t ulLength;              ///< Image length in bytes, 0 if not embedded
+  uint32_t ulCrc;                 ///< zlib CRC-32 of image, with this field as 0
+} HW_CRC_ImageTypeDef;
+
+/// Image self-check status
+typedef enum {
+  HW_CRC_IMAGE_MISSING = 0,       ///< No CRC embedded by post-build step
+  HW_CRC_IMAGE_OK,                ///< CRC matches
+  HW_CRC_IMAGE_CORRUPT            ///< CRC mismatch
+} HW_CRC_ImageStatusTypeDef;
+
+/// Image self-check result
+typedef struct {
+  HW_CRC_ImageStatusTypeDef eStatus; ///< Check status
+  uint32_t ulLength;              ///< Image length in bytes
+  uint32_t ulExpected;            ///< Embedded CRC
+  uint32_t ulActual;              ///< Computed CRC
+  uint32_t ulCycles;              ///< Check duration in core clock cycles
+} HW_CRC_ImageCheckTypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vHW_CRC_Init(void);
+void vHW_CRC_Start(HW_CRC_ContextTypeDef* psCtx, HW_CRC_ModeTypeDef eMode);
+void vHW_CRC_Update(HW_CRC_ContextTypeDef* psCtx, const void* pvData, uint32_t ulLen);
+bool bHW_CRC_UpdateDma(HW_CRC_ContextTypeDef* psCtx, const uint32_t* pulData, uint32_t ulCount);
+bool bHW_CRC_IsBusy(void);
+uint32_t ulHW_CRC_Final(HW_CRC_ContextTypeDef* psCtx);
+uint32_t ulHW_CRC_Calc(const void* pvData, uint32_t ulLen);
+
+void vHW_CRC_CheckImage(void);
+const HW_CRC_ImageCheckTypeDef* psHW_CRC_GetImageCheck(void);
+
+#endif // HW_CRC_H_
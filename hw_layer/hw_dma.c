@@ -0,0 +1,385 @@
+/*!****************************************************************************
+ * @file
+ * hw_dma.c
+ *
+ * @brief
+ * Hardware Layer - DMA memory-to-memory engine
+ *
+ * Requests are queued in submission order and processed one after another on
+ * a single DMA1 channel in memory-to-memory mode (lib/dmaq). Unaligned head
+ * and tail bytes are handled by the CPU during submission, so that the DMA
+ * can use the widest data size permitted by the relative alignment of source
+ * and destination. Transfers larger than the 16-bit channel counter are split
+ * into chunks in the interrupt handler.
+ *
+ * Besides copies and fills, the engine can feed a memory block into a fixed
+ * peripheral data register word by word (e.g. the CRC unit).
+ *
+ * Transfers below a configurable size threshold are not worth the setup cost
+ * and are done by the CPU immediately instead (see "dma" benchmark suite for
+ * the crossover point).
+ *
+ * DMA1 has no free channel left for every peripheral request; the channel
+ * serving both TIM2 CC1 and TIM1 UP is handed to one driver at a time
+ * (capture or sequencer), which owns it until it releases it.
+ *
+ * The queue and the owner are kept by lib/dmaq; this driver adds the channel
+ * registers, the CPU path and the interrupt lock.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <string.h>
+#include "stm32f1xx_hal.h"
+#include "hw_dma.h"
+#include "hw_init.h"
+#include "hw_iodef.h"
+#include "hw_irq.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Smallest transfer handled by DMA (head and tail peeling needs >= 8 bytes)
+#define HW_DMA_MIN_SIZE               8uL
+
+/// Maximum transfer units per channel activation
+#define HW_DMA_MAX_CHUNK              0xFFFFuL
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vHW_DMA_Enqueue(DMAQ_RequestTypeDef* psReq);
+static void vHW_DMA_Start(const DMAQ_RequestTypeDef* psReq, uint32_t ulCount);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Channel driver of the queue
+static const DMAQ_DriverTypeDef sDrv = {
+  .pfnStart = vHW_DMA_Start
+};
+
+/// Request queue, head is active
+static DMAQ_TypeDef sQueue;
+
+/// Active CPU/DMA size threshold
+static uint32_t ulThreshold = HW_DMA_CPU_THRESHOLD;
+
+/// Owner of the shared channel (HW_DMA_SharedTypeDef)
+static volatile uint32_t ulShared;
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise DMA engine
+ *
+ * With HW_INIT_DIRECT, the clock is enabled by the bring-up table. The
+ * interrupt priority is taken from the priority plan (hw_irq).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_DMA_Init(void)
+{
+#if !HW_INIT_DIRECT
+  __HAL_RCC_DMA1_CLK_ENABLE();
+#endif
+
+  DMA_M2M_CHANNEL->CCR = 0uL;
+  DMA1->IFCR = DMA_M2M_IFCR_CGIF;
+  vDMAQ_Init(&sQueue, &sDrv, HW_DMA_MAX_CHUNK);
+
+  DMA_SHARED_CHANNEL->CCR = 0uL;
+  DMA1->IFCR = DMA_SHARED_IFCR_CGIF;
+  ulShared = HW_DMA_SHARED_FREE;
+
+  HAL_NVIC_EnableIRQ(DMA_M2M_IRQn);
+  HAL_NVIC_EnableIRQ(DMA_SHARED_IRQn);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Set CPU/DMA size threshold
+ *
+ * @param[in] ulSize  Transfers below this size in bytes are done by the CPU
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_DMA_SetThreshold(uint32_t ulSize)
+{
+  ulThreshold = ulSize;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Submit memory copy
+ *
+ * Source and destination must not overlap. Small copies are completed by the
+ * CPU before returning; the callback is then invoked from the caller's
+ * context.
+ *
+ * @param[out] *psReq       Request storage
+ * @param[out] *pvDst       Destination
+ * @param[in] *pvSrc        Source
+ * @param[in] ulSize        Size in bytes
+ * @param[in] pfnCallback   Completion callback, or NULL
+ * @return  (bool)        false if request storage is still in use
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_DMA_Memcpy(DMAQ_RequestTypeDef* psReq, void* pvDst, const void* pvSrc,
+                    uint32_t ulSize, DMAQ_CallbackTypeDef pfnCallback)
+{
+  if (bDMAQ_IsPending(psReq)) return false;
+  psReq->pfnCallback = pfnCallback;
+
+  uint8_t* pucDst = (uint8_t*)pvDst;
+  const uint8_t* pucSrc = (const uint8_t*)pvSrc;
+
+  if (ulSize < ulThreshold || ulSize < HW_DMA_MIN_SIZE)
+  {
+    (void)memcpy(pucDst, pucSrc, ulSize);
+    vDMAQ_Finish(psReq, DMAQ_STATE_DONE);
+    return true;
+  }
+
+  // Widest data size for relative alignment, unaligned head and tail on CPU
+  DMAQ_PlanTypeDef sPlan;
+  vDMAQ_Plan((uintptr_t)pucDst, (uintptr_t)pucSrc, ulSize, &sPlan);
+  (void)memcpy(pucDst, pucSrc, sPlan.ulHead);
+  pucDst += sPlan.ulHead;
+  pucSrc += sPlan.ulHead;
+  (void)memcpy(pucDst + sPlan.ulBody, pucSrc + sPlan.ulBody, sPlan.ulTail);
+
+  psReq->ulDst = (uintptr_t)pucDst;
+  psReq->ulSrc = (uintptr_t)pucSrc;
+  psReq->ulCount = sPlan.ulBody >> sPlan.ucShift;
+  psReq->ucShift = sPlan.ucShift;
+  psReq->ucFlags = DMAQ_FLAG_DST_INC | DMAQ_FLAG_SRC_INC;
+  vHW_DMA_Enqueue(psReq);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Submit memory fill
+ *
+ * Small fills are completed by the CPU before returning; the callback is then
+ * invoked from the caller's context.
+ *
+ * @param[out] *psReq       Request storage
+ * @param[out] *pvDst       Destination
+ * @param[in] ucValue       Fill value
+ * @param[in] ulSize        Size in bytes
+ * @param[in] pfnCallback   Completion callback, or NULL
+ * @return  (bool)        false if request storage is still in use
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_DMA_Memset(DMAQ_RequestTypeDef* psReq, void* pvDst, uint8_t ucValue,
+                    uint32_t ulSize, DMAQ_CallbackTypeDef pfnCallback)
+{
+  if (bDMAQ_IsPending(psReq)) return false;
+  psReq->pfnCallback = pfnCallback;
+
+  uint8_t* pucDst = (uint8_t*)pvDst;
+
+  if (ulSize < ulThreshold || ulSize < HW_DMA_MIN_SIZE)
+  {
+    (void)memset(pucDst, ucValue, ulSize);
+    vDMAQ_Finish(psReq, DMAQ_STATE_DONE);
+    return true;
+  }
+
+  // Fill unaligned head and tail on CPU, DMA always uses word size
+  DMAQ_PlanTypeDef sPlan;
+  vDMAQ_Plan((uintptr_t)pucDst, (uintptr_t)pucDst, ulSize, &sPlan);
+  (void)memset(pucDst, ucValue, sPlan.ulHead);
+  pucDst += sPlan.ulHead;
+  (void)memset(pucDst + sPlan.ulBody, ucValue, sPlan.ulTail);
+
+  psReq->ulFill = 0x01010101uL * ucValue;
+  psReq->ulDst = (uintptr_t)pucDst;
+  psReq->ulSrc = (uintptr_t)&psReq->ulFill;
+  psReq->ulCount = sPlan.ulBody >> 2;
+  psReq->ucShift = 2u;
+  psReq->ucFlags = DMAQ_FLAG_DST_INC;
+  vHW_DMA_Enqueue(psReq);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Submit memory-to-register feed
+ *
+ * Writes a block of words to a fixed register address, e.g. a peripheral
+ * data register. Always uses the DMA, regardless of the size threshold.
+ *
+ * @param[out] *psReq       Request storage
+ * @param[out] *pulReg      Destination register
+ * @param[in] *pulSrc       Source (word aligned)
+ * @param[in] ulCount       Number of words
+ * @param[in] pfnCallback   Completion callback, or NULL
+ * @return  (bool)        false if request storage is still in use
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_DMA_Feed(DMAQ_RequestTypeDef* psReq, volatile uint32_t* pulReg, const uint32_t* pulSrc,
+                  uint32_t ulCount, DMAQ_CallbackTypeDef pfnCallback)
+{
+  if (bDMAQ_IsPending(psReq)) return false;
+  psReq->pfnCallback = pfnCallback;
+
+  if (ulCount == 0uL)
+  {
+    vDMAQ_Finish(psReq, DMAQ_STATE_DONE);
+    return true;
+  }
+
+  psReq->ulDst = (uintptr_t)pulReg;
+  psReq->ulSrc = (uintptr_t)pulSrc;
+  psReq->ulCount = ulCount;
+  psReq->ucShift = 2u;
+  psReq->ucFlags = DMAQ_FLAG_SRC_INC;
+  vHW_DMA_Enqueue(psReq);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if a request is queued or in progress
+ *
+ * @param[in] *psReq    Request
+ * @return  (bool)    Request pending
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_DMA_IsPending(const DMAQ_RequestTypeDef* psReq)
+{
+  return bDMAQ_IsPending(psReq);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Wait for request completion
+ *
+ * @param[in] *psReq                Request
+ * @return  (DMAQ_StateTypeDef)   Final request state
+ * @date  19.10.2026
+ ******************************************************************************/
+DMAQ_StateTypeDef eHW_DMA_Wait(const DMAQ_RequestTypeDef* psReq)
+{
+  while (bDMAQ_IsPending(psReq))
+  {
+    __NOP();
+  }
+  return psReq->eState;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Take ownership of the shared channel
+ *
+ * @param[in] eUser   Driver
+ * @return  (bool)  Channel free or already owned by eUser
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_DMA_AcquireShared(HW_DMA_SharedTypeDef eUser)
+{
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  bool bOwned = bDMAQ_Acquire(&ulShared, eUser);
+  vHW_IRQ_Unlock(ulLock);
+  return bOwned;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stop the shared channel and give up ownership
+ *
+ * Does nothing unless eUser owns the channel.
+ *
+ * @param[in] eUser   Driver
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_DMA_ReleaseShared(HW_DMA_SharedTypeDef eUser)
+{
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  if (bDMAQ_Release(&ulShared, eUser))
+  {
+    DMA_SHARED_CHANNEL->CCR = 0uL;
+    DMA1->IFCR = DMA_SHARED_IFCR_CGIF;
+  }
+  vHW_IRQ_Unlock(ulLock);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get owner of the shared channel
+ *
+ * @return  (HW_DMA_SharedTypeDef)  Owner, HW_DMA_SHARED_FREE if unused
+ * @date  19.10.2026
+ ******************************************************************************/
+HW_DMA_SharedTypeDef eHW_DMA_GetShared(void)
+{
+  return (HW_DMA_SharedTypeDef)ulShared;
+}
+
+/*!****************************************************************************
+ * @brief
+ * DMA channel interrupt handler
+ *
+ * Reports the end of a chunk or a bus error to the queue, which starts the
+ * next chunk or request.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_DMA_IRQHandler(void)
+{
+  uint32_t ulIsr = DMA1->ISR;
+  DMA1->IFCR = DMA_M2M_IFCR_CGIF;
+
+  if ((ulIsr & DMA_M2M_ISR_TEIF) != 0uL)
+  {
+    DMA_M2M_CHANNEL->CCR = 0uL;
+    vDMAQ_Event(&sQueue, DMAQ_EVENT_ERROR);
+  }
+  else if ((ulIsr & DMA_M2M_ISR_TCIF) != 0uL)
+  {
+    vDMAQ_Event(&sQueue, DMAQ_EVENT_DONE);
+  }
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Append request to queue, start channel if idle
+ *
+ * @param[in,out] *psReq  Prepared request
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_DMA_Enqueue(DMAQ_RequestTypeDef* psReq)
+{
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  vDMAQ_Submit(&sQueue, psReq);
+  vHW_IRQ_Unlock(ulLock);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Program channel with next chunk of a request
+ *
+ * Source and destination are the peripheral and memory side of the
+ * memory-to-memory transfer.
+ *
+ * @param[in] *psReq    Request
+ * @param[in] ulCount   Transfer units
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_DMA_Start(const DMAQ_RequestTypeDef* psReq, uint32_t ulCount)
+{
+  uint32_t ulShift = psReq->ucShift;
+  uint32_t ulCcr = DMA_CCR_MEM2MEM | (ulShift << DMA_CCR_MSIZE_Pos) | (ulShift << DMA_CCR_PSIZE_Pos) |
+                   DMA_CCR_TCIE | DMA_CCR_TEIE;
+  if ((psReq->ucFlags & DMAQ_FLAG_DST_INC) != 0u) ulCcr |= DMA_CCR_MINC;
+  if ((psReq->ucFlags & DMAQ_FLAG_SRC_INC) != 0u) ulCcr |= DMA_CCR_PINC;
+
+  DMA_M2M_CHANNEL->CCR = 0uL;
+  DMA_M2M_CHANNEL->CPAR = psReq->ulSrc;
+  DMA_M2M_CHANNEL->CMAR = psReq->ulDst;
+  DMA_M2M_CHANNEL->CNDTR = ulCount;
+  DMA_M2M_CHANNEL->CCR = ulCcr | DMA_CCR_EN;
+}
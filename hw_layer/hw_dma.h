@@ -0,0 +1,55 @@
+/*!****************************************************************************
+ * @file
+ * hw_dma.h
+ *
+ * @brief
+ * Hardware Layer - DMA memory-to-memory engine
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef HW_DMA_H_
+#define HW_DMA_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "dmaq.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Default size threshold in bytes below which transfers are done by the CPU
+#ifndef HW_DMA_CPU_THRESHOLD
+#define HW_DMA_CPU_THRESHOLD          256uL
+#endif
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Users of the channel shared between drivers (DMA_SHARED_CHANNEL)
+typedef enum {
+  HW_DMA_SHARED_FREE = 0,         ///< Not in use
+  HW_DMA_SHARED_CAPTURE,          ///< Input capture (hw_capture)
+  HW_DMA_SHARED_SEQ               ///< Waveform sequencer (hw_seq)
+} HW_DMA_SharedTypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vHW_DMA_Init(void);
+void vHW_DMA_SetThreshold(uint32_t ulSize);
+
+bool bHW_DMA_Memcpy(DMAQ_RequestTypeDef* psReq, void* pvDst, const void* pvSrc,
+                    uint32_t ulSize, DMAQ_CallbackTypeDef pfnCallback);
+bool bHW_DMA_Memset(DMAQ_RequestTypeDef* psReq, void* pvDst, uint8_t ucValue,
+                    uint32_t ulSize, DMAQ_CallbackTypeDef pfnCallback);
+bool bHW_DMA_Feed(DMAQ_RequestTypeDef* psReq, volatile uint32_t* pulReg, const uint32_t* pulSrc,
+                  uint32_t ulCount, DMAQ_CallbackTypeDef pfnCallback);
+bool bHW_DMA_IsPending(const DMAQ_RequestTypeDef* psReq);
+DMAQ_StateTypeDef eHW_DMA_Wait(const DMAQ_RequestTypeDef* psReq);
+
+bool bHW_DMA_AcquireShared(HW_DMA_SharedTypeDef eUser);
+void vHW_DMA_ReleaseShared(HW_DMA_SharedTypeDef eUser);
+HW_DMA_SharedTypeDef eHW_DMA_GetShared(void);
+
+void vHW_DMA_IRQHandler(void);
+
+#endif // HW_DMA_H_
@@ -0,0 +1,226 @@
+/*!****************************************************************************
+ * @file
+ * hw_flight.c
+ *
+ * @brief
+ * Hardware Layer - Reset-surviving flight recorder
+ *
+ * Events are written to a ring in uninitialised RAM (section ".noinit",
+ * placed by the linker right after .bss), which is not cleared by the
+ * startup code and therefore survives a system reset. Recording an event
+ * takes an atomic slot reservation (LDREX/STREX), a cycle counter read and
+ * two stores, so it can be called from any context and stay enabled in
+ * production builds.
+ *
+ * The fault handlers branch to vHW_FLIGHT_FaultHandler(), which snapshots the
+ * stacked registers and fault status registers next to the ring, then resets
+ * the MCU. If a debugger is attached, it halts on a breakpoint first. On the
+ * next boot, the snapshot and the ring are copied out for printing before
+ * recording restarts. After power-on reset, the RAM content is discarded.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include "stm32f1xx_hal.h"
+#include "hw_flight.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Ring contents are valid
+#define HW_FLIGHT_MAGIC               0x464C5452uL
+
+/// Fault snapshot is valid
+#define HW_FLIGHT_FAULT_MAGIC         0x46415554uL
+
+/// Ring index mask
+#define HW_FLIGHT_MASK                (HW_FLIGHT_EVENTS - 1u)
+
+/// Size of basic exception stack frame in bytes
+#define HW_FLIGHT_FRAME_SIZE          (HW_FLIGHT_NUM_REGS * 4u)
+
+/// xPSR bit indicating stack realignment on exception entry
+#define HW_FLIGHT_XPSR_ALIGN          (1uL << 9)
+
+_Static_assert((HW_FLIGHT_EVENTS & HW_FLIGHT_MASK) == 0u, "HW_FLIGHT_EVENTS must be a power of two");
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Recorder state in uninitialised RAM
+typedef struct {
+  uint32_t ulMagic;                                 ///< HW_FLIGHT_MAGIC if valid
+  uint32_t ulHead;                                  ///< Events recorded
+  HW_FLIGHT_EventTypeDef asEvents[HW_FLIGHT_EVENTS];  ///< Event ring
+  HW_FLIGHT_FaultTypeDef sFault;                    ///< Fault snapshot
+  uint32_t ulFaultMagic;                            ///< HW_FLIGHT_FAULT_MAGIC if valid
+} HW_FLIGHT_RecorderTypeDef;
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Linker symbol: initial stack pointer
+extern uint32_t _estack;
+
+/// Recorder, preserved across resets
+__attribute__((section(".noinit")))
+static HW_FLIGHT_RecorderTypeDef sRecorder;
+
+/// Dump of previous run
+static HW_FLIGHT_DumpTypeDef sDump;
+
+/// Dump is valid
+static bool bDumpValid;
+
+
+/*- Private functions --------------------------------------------------------*/
+// Referenced from assembly only, must keep its name with LTO
+__attribute__((used, externally_visible, noreturn))
+void vHW_FLIGHT_Fault(const uint32_t* pulFrame, uint32_t ulExcReturn);
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise flight recorder
+ *
+ * Takes over a fault snapshot of the previous run, then restarts recording.
+ * Must be called before the first event is recorded.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_FLIGHT_Init(void)
+{
+  bool bPowerOn = (RCC->CSR & RCC_CSR_PORRSTF) != 0uL;
+  RCC->CSR |= RCC_CSR_RMVF;
+
+  bDumpValid = !bPowerOn && (sRecorder.ulMagic == HW_FLIGHT_MAGIC) &&
+               (sRecorder.ulFaultMagic == HW_FLIGHT_FAULT_MAGIC);
+  if (bDumpValid)
+  {
+    uint32_t ulHead = sRecorder.ulHead;
+    uint32_t ulNum = (ulHead < HW_FLIGHT_EVENTS) ? ulHead : HW_FLIGHT_EVENTS;
+    sDump.sFault = sRecorder.sFault;
+    sDump.ulNumEvents = ulNum;
+    for (uint32_t i = 0uL; i < ulNum; ++i)
+    {
+      sDump.asEvents[i] = sRecorder.asEvents[(ulHead - ulNum + i) & HW_FLIGHT_MASK];
+    }
+  }
+
+  sRecorder.ulFaultMagic = 0uL;
+  sRecorder.ulHead = 0uL;
+  sRecorder.ulMagic = HW_FLIGHT_MAGIC;
+
+  // Report configurable faults separately instead of escalating to HardFault
+  SCB->SHCSR |= SCB_SHCSR_MEMFAULTENA_Msk | SCB_SHCSR_BUSFAULTENA_Msk | SCB_SHCSR_USGFAULTENA_Msk;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Record event
+ *
+ * May be called from any context.
+ *
+ * @param[in] uiId    Event ID
+ * @param[in] uiArg   Event argument
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_FLIGHT_Record(uint16_t uiId, uint16_t uiArg)
+{
+  uint32_t ulIdx;
+  do
+  {
+    ulIdx = __LDREXW(&sRecorder.ulHead);
+  } while (__STREXW(ulIdx + 1uL, &sRecorder.ulHead) != 0uL);
+
+  HW_FLIGHT_EventTypeDef* psEvent = &sRecorder.asEvents[ulIdx & HW_FLIGHT_MASK];
+  psEvent->ulTime = DWT->CYCCNT;
+  psEvent->uiId = uiId;
+  psEvent->uiArg = uiArg;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get fault dump of previous run
+ *
+ * @return  (const HW_FLIGHT_DumpTypeDef*)  Dump, NULL if the previous run
+ *                                          did not end with a fault
+ * @date  19.10.2026
+ ******************************************************************************/
+const HW_FLIGHT_DumpTypeDef* psHW_FLIGHT_GetDump(void)
+{
+  return bDumpValid ? &sDump : NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Common fault handler entry
+ *
+ * Must be branched to (not called) from the fault handlers, so that LR still
+ * holds EXC_RETURN. Determines the stack frame, switches to the top of the
+ * main stack if the stack pointer has left RAM (stack overflow), and
+ * continues in vHW_FLIGHT_Fault().
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+__attribute__((naked, used, externally_visible))
+void vHW_FLIGHT_FaultHandler(void)
+{
+  __asm volatile(
+    "  tst   lr, #4                   \n"   // Frame on MSP or PSP?
+    "  ite   eq                       \n"
+    "  mrseq r0, msp                  \n"
+    "  mrsne r0, psp                  \n"
+    "  mov   r1, lr                   \n"
+    "  ldr   r2, =0x20000000          \n"   // SRAM_BASE
+    "  cmp   sp, r2                   \n"
+    "  itt   lo                       \n"
+    "  ldrlo r2, =_estack             \n"
+    "  movlo sp, r2                   \n"
+    "  b     vHW_FLIGHT_Fault         \n"
+  );
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Take fault snapshot and reset
+ *
+ * Called from vHW_FLIGHT_FaultHandler() only.
+ *
+ * @param[in] *pulFrame     Exception stack frame
+ * @param[in] ulExcReturn   EXC_RETURN value
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_FLIGHT_Fault(const uint32_t* pulFrame, uint32_t ulExcReturn)
+{
+  HW_FLIGHT_FaultTypeDef* psFault = &sRecorder.sFault;
+
+  // Frame may be unreadable if the fault occurred during stacking
+  uintptr_t ulFrame = (uintptr_t)pulFrame;
+  bool bFrameValid = (ulFrame >= SRAM_BASE) && (ulFrame + HW_FLIGHT_FRAME_SIZE <= (uintptr_t)&_estack);
+  for (uint32_t i = 0uL; i < HW_FLIGHT_NUM_REGS; ++i)
+  {
+    psFault->aulRegs[i] = bFrameValid ? pulFrame[i] : 0uL;
+  }
+  psFault->ulSp = ulFrame + HW_FLIGHT_FRAME_SIZE +
+                  (((psFault->aulRegs[HW_FLIGHT_REG_XPSR] & HW_FLIGHT_XPSR_ALIGN) != 0uL) ? 4uL : 0uL);
+  psFault->ulExcReturn = ulExcReturn;
+  psFault->ulIpsr = __get_IPSR();
+  psFault->ulCfsr = SCB->CFSR;
+  psFault->ulHfsr = SCB->HFSR;
+  psFault->ulBfar = SCB->BFAR;
+  psFault->ulMmfar = SCB->MMFAR;
+  psFault->ulTime = DWT->CYCCNT;
+  sRecorder.ulFaultMagic = HW_FLIGHT_FAULT_MAGIC;
+  __DSB();
+
+  // Give an attached debugger the chance to inspect the fault
+  if ((CoreDebug->DHCSR & CoreDebug_DHCSR_C_DEBUGEN_Msk) != 0uL)
+  {
+    __BKPT(0);
+  }
+
+  NVIC_SystemReset();
+}
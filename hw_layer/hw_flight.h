@@ -0,0 +1,74 @@
+/*!****************************************************************************
+ * @file
+ * hw_flight.h
+ *
+ * @brief
+ * Hardware Layer - Reset-surviving flight recorder
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef HW_FLIGHT_H_
+#define HW_FLIGHT_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Number of events kept in ring (power of two)
+#ifndef HW_FLIGHT_EVENTS
+#define HW_FLIGHT_EVENTS              32u
+#endif
+
+/*! @brief Stacked register indices in fault snapshot
+ *  @{                                                                        */
+#define HW_FLIGHT_REG_R0              0u
+#define HW_FLIGHT_REG_R1              1u
+#define HW_FLIGHT_REG_R2              2u
+#define HW_FLIGHT_REG_R3              3u
+#define HW_FLIGHT_REG_R12             4u
+#define HW_FLIGHT_REG_LR              5u
+#define HW_FLIGHT_REG_PC              6u
+#define HW_FLIGHT_REG_XPSR            7u
+#define HW_FLIGHT_NUM_REGS            8u
+/*! @}                                                                        */
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Recorded event
+typedef struct {
+  uint32_t ulTime;                ///< DWT cycle count
+  uint16_t uiId;                  ///< Event ID
+  uint16_t uiArg;                 ///< Event argument
+} HW_FLIGHT_EventTypeDef;
+
+/// Fault snapshot
+typedef struct {
+  uint32_t aulRegs[HW_FLIGHT_NUM_REGS]; ///< Stacked registers HW_FLIGHT_REG_x
+  uint32_t ulSp;                  ///< Stack pointer before exception entry
+  uint32_t ulExcReturn;           ///< EXC_RETURN value
+  uint32_t ulIpsr;                ///< Exception number
+  uint32_t ulCfsr;                ///< Configurable Fault Status Register
+  uint32_t ulHfsr;                ///< HardFault Status Register
+  uint32_t ulBfar;                ///< BusFault Address Register
+  uint32_t ulMmfar;               ///< MemManage Fault Address Register
+  uint32_t ulTime;                ///< DWT cycle count at fault
+} HW_FLIGHT_FaultTypeDef;
+
+/// Dump of previous run
+typedef struct {
+  HW_FLIGHT_FaultTypeDef sFault;  ///< Fault snapshot
+  uint32_t ulNumEvents;           ///< Number of valid events
+  HW_FLIGHT_EventTypeDef asEvents[HW_FLIGHT_EVENTS]; ///< Last events, oldest first
+} HW_FLIGHT_DumpTypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vHW_FLIGHT_Init(void);
+void vHW_FLIGHT_Record(uint16_t uiId, uint16_t uiArg);
+const HW_FLIGHT_DumpTypeDef* psHW_FLIGHT_GetDump(void);
+
+void vHW_FLIGHT_FaultHandler(void);
+
+#endif // HW_FLIGHT_H_
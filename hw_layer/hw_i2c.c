@@ -0,0 +1,542 @@
+/*!****************************************************************************
+ * @file
+ * hw_i2c.c
+ *
+ * @brief
+ * Hardware Layer - I2C master transaction engine for sensors
+ *
+ * I2C1 master driving the transaction queue (lib/i2cq). The queue runs in
+ * the I2C event, I2C error and DMA receive interrupts; the CPU only steps in
+ * at phase boundaries:
+ *
+ *   SB      start sent        -> address byte
+ *   ADDR    address acked     -> arm DMA (write, or read with LAST), clear ADDR
+ *   BTF     last byte written -> repeated start or stop
+ *   DMA TC  last byte read    -> stop
+ *   AF      not acknowledged  -> stop, retry
+ *   BERR / ARLO / OVR         -> bus recovery, retry
+ *
+ * Single-byte reads cannot use DMA (the acknowledge must be disabled before
+ * ADDR is cleared and the stop requested right after), so they take one
+ * RXNE interrupt instead.
+ *
+ * Bus recovery drives the pins as open-drain outputs, clocks up to nine SCL
+ * pulses until a slave stuck in a read releases SDA, sends a stop condition
+ * and resets the peripheral (SWRST). This also clears a BUSY flag stuck by
+ * glitches (see errata sheet ES096).
+ *
+ * Phase timeouts are counted by a 1 ms software timer that only runs while
+ * the queue is busy. Transaction and batch callbacks are called from
+ * interrupt context at the driver level and may submit new transactions.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include "stm32f1xx_hal.h"
+#include "hw_clk.h"
+#include "hw_init.h"
+#include "hw_iodef.h"
+#include "hw_irq.h"
+#include "hw_i2c.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Timeout tick in ms
+#define HW_I2C_TICK_MS                1uL
+
+/// Phase timeout in ticks, without data
+#define HW_I2C_TIMEOUT_BASE           2u
+
+/// Bytes per tick at bus speed (9 clocks per byte)
+#define HW_I2C_BYTES_PER_TICK         (HW_I2C_SPEED * HW_I2C_TICK_MS / 9000uL)
+
+/// Bus pins
+#define HW_I2C_PINS                   (I2C_SENS_SCL_PIN | I2C_SENS_SDA_PIN)
+
+/// Clock pulses to free a slave holding SDA low
+#define HW_I2C_RECOVERY_CLOCKS        9u
+
+/// Bit rate of the recovery clock in Hz
+#define HW_I2C_RECOVERY_SPEED         100000uL
+
+/// Longest wait for a requested stop condition in us
+#define HW_I2C_STOP_WAIT_US           100uL
+
+/// Error flags in SR1
+#define HW_I2C_SR1_ERRORS             (I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_AF | I2C_SR1_OVR | \
+                                       I2C_SR1_TIMEOUT)
+
+_Static_assert((HW_I2C_SPEED >= 10000uL) && (HW_I2C_SPEED <= 400000uL), "I2C speed out of range");
+_Static_assert(HW_I2C_BYTES_PER_TICK >= 1uL, "I2C tick too short");
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vHW_I2C_Config(void);
+static void vHW_I2C_Delay(uint32_t ulCycles);
+static void vHW_I2C_DmaStop(void);
+static void vHW_I2C_Tick(HW_CLK_TimerTypeDef* psTimer);
+static void vHW_I2C_Start(void);
+static void vHW_I2C_Address(uint8_t ucAddrRw);
+static void vHW_I2C_Write(const uint8_t* pucData, uint16_t uiLen);
+static void vHW_I2C_Read(uint8_t* pucData, uint16_t uiLen);
+static void vHW_I2C_Stop(void);
+static void vHW_I2C_Recover(void);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Queue driver
+static const I2CQ_DriverTypeDef sDrv = {
+  .pfnStart = vHW_I2C_Start,
+  .pfnAddress = vHW_I2C_Address,
+  .pfnWrite = vHW_I2C_Write,
+  .pfnRead = vHW_I2C_Read,
+  .pfnStop = vHW_I2C_Stop,
+  .pfnRecover = vHW_I2C_Recover
+};
+
+/// Transaction queue
+static I2CQ_TypeDef sQueue;
+
+/// Timeout tick, active while the queue is busy
+static HW_CLK_TimerTypeDef sTick;
+
+/// Write phase on DMA, ends with BTF
+static bool bWriting;
+
+/// Destination of a single-byte read, ends with RXNE
+static uint8_t* pucReadByte;
+
+/// Stop condition already requested (single-byte read)
+static bool bStopRequested;
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise I2C1 master, DMA channels and transaction queue
+ *
+ * - I2C_SENS_SCL_PIN, I2C_SENS_SDA_PIN: Alternate function open-drain
+ *
+ * With HW_INIT_DIRECT, clocks and pins are set up by the bring-up table. The
+ * interrupt priorities are taken from the priority plan (hw_irq).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_I2C_Init(void)
+{
+#if !HW_INIT_DIRECT
+  __HAL_RCC_GPIOB_CLK_ENABLE();
+  __HAL_RCC_I2C1_CLK_ENABLE();
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  GPIO_InitTypeDef sPins = {
+    .Pin = HW_I2C_PINS,
+    .Mode = GPIO_MODE_AF_OD,
+    .Pull = GPIO_NOPULL,
+    .Speed = GPIO_SPEED_FREQ_HIGH
+  };
+  HAL_GPIO_Init(I2C_SENS_PORT, &sPins);
+#endif
+
+  // Both channels address the data register
+  DMA_I2C_TX_CHANNEL->CCR = 0uL;
+  DMA_I2C_RX_CHANNEL->CCR = 0uL;
+  DMA1->IFCR = DMA_I2C_TX_IFCR_CGIF | DMA_I2C_RX_IFCR_CGIF;
+  DMA_I2C_TX_CHANNEL->CPAR = (uint32_t)&I2C_SENS->DR;
+  DMA_I2C_RX_CHANNEL->CPAR = (uint32_t)&I2C_SENS->DR;
+
+  // Clear a BUSY flag left from a reset during a transfer
+  I2C_SENS->CR1 = I2C_CR1_SWRST;
+  I2C_SENS->CR1 = 0uL;
+  vHW_I2C_Config();
+
+  vHW_CLK_TimerInit(&sTick, vHW_I2C_Tick, NULL);
+  vI2CQ_Init(&sQueue, &sDrv, HW_I2C_RETRIES, HW_I2C_TIMEOUT_BASE, HW_I2C_BYTES_PER_TICK);
+
+  HAL_NVIC_EnableIRQ(I2C_SENS_EV_IRQn);
+  HAL_NVIC_EnableIRQ(I2C_SENS_ER_IRQn);
+  HAL_NVIC_EnableIRQ(DMA_I2C_RX_IRQn);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Submit transaction
+ *
+ * @param[in,out] *psXfer Transaction, see bI2CQ_Submit()
+ * @return  (bool)  Transaction queued
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_I2C_Submit(I2CQ_XferTypeDef* psXfer)
+{
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  bool bQueued = bI2CQ_Submit(&sQueue, psXfer);
+  if (bQueued && !bHW_CLK_TimerIsActive(&sTick))
+  {
+    vHW_CLK_TimerStart(&sTick, HW_I2C_TICK_MS, HW_I2C_TICK_MS);
+  }
+  vHW_IRQ_Unlock(ulLock);
+  return bQueued;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Submit batch of transactions
+ *
+ * @param[in,out] *psBatch  Batch, see bI2CQ_SubmitBatch()
+ * @return  (bool)  Batch queued
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_I2C_SubmitBatch(I2CQ_BatchTypeDef* psBatch)
+{
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  bool bQueued = bI2CQ_SubmitBatch(&sQueue, psBatch);
+  if (bQueued && !bHW_CLK_TimerIsActive(&sTick))
+  {
+    vHW_CLK_TimerStart(&sTick, HW_I2C_TICK_MS, HW_I2C_TICK_MS);
+  }
+  vHW_IRQ_Unlock(ulLock);
+  return bQueued;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get queue statistics
+ *
+ * @param[out] *psStats   Statistics
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_I2C_GetStats(I2CQ_StatsTypeDef* psStats)
+{
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  *psStats = sQueue.sStats;
+  vHW_IRQ_Unlock(ulLock);
+}
+
+/*!****************************************************************************
+ * @brief
+ * I2C event interrupt handler
+ *
+ * BTF stays set after the write phase until the repeated start or stop is
+ * generated, so the handler may run again for about one bit time without
+ * reporting an event.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_I2C_EvIRQHandler(void)
+{
+  uint32_t ulSr1 = I2C_SENS->SR1;
+
+  if ((ulSr1 & I2C_SR1_SB) != 0uL)
+  {
+    vI2CQ_Event(&sQueue, I2CQ_EVENT_START);
+  }
+  else if ((ulSr1 & I2C_SR1_ADDR) != 0uL)
+  {
+    vI2CQ_Event(&sQueue, I2CQ_EVENT_ADDR);
+
+    // Completes the clear sequence if the queue did not continue
+    (void)I2C_SENS->SR2;
+  }
+  else if (((ulSr1 & I2C_SR1_RXNE) != 0uL) && (pucReadByte != NULL))
+  {
+    *pucReadByte = (uint8_t)I2C_SENS->DR;
+    pucReadByte = NULL;
+    I2C_SENS->CR2 &= ~I2C_CR2_ITBUFEN;
+    vI2CQ_Event(&sQueue, I2CQ_EVENT_DONE);
+  }
+  else if (((ulSr1 & I2C_SR1_BTF) != 0uL) && bWriting)
+  {
+    bWriting = false;
+    vHW_I2C_DmaStop();
+    vI2CQ_Event(&sQueue, I2CQ_EVENT_DONE);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * I2C error interrupt handler
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_I2C_ErIRQHandler(void)
+{
+  uint32_t ulErrors = I2C_SENS->SR1 & HW_I2C_SR1_ERRORS;
+
+  // Flags are cleared by writing zero
+  I2C_SENS->SR1 = ~ulErrors;
+  if (ulErrors == 0uL) return;
+
+  vI2CQ_Event(&sQueue, (ulErrors == I2C_SR1_AF) ? I2CQ_EVENT_NACK : I2CQ_EVENT_BUS);
+}
+
+/*!****************************************************************************
+ * @brief
+ * DMA receive channel interrupt handler
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_I2C_DmaIRQHandler(void)
+{
+  uint32_t ulIsr = DMA1->ISR;
+  DMA1->IFCR = DMA_I2C_RX_IFCR_CGIF;
+
+  if ((ulIsr & DMA_I2C_RX_ISR_TEIF) != 0uL)
+  {
+    vI2CQ_Event(&sQueue, I2CQ_EVENT_BUS);
+  }
+  else if ((ulIsr & DMA_I2C_RX_ISR_TCIF) != 0uL)
+  {
+    vHW_I2C_DmaStop();
+    vI2CQ_Event(&sQueue, I2CQ_EVENT_DONE);
+  }
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Configure bus timing and interrupts, enable peripheral
+ *
+ * Fast mode uses a 1:2 high/low ratio. Rise times are the limits of the
+ * I2C specification (1000 ns standard, 300 ns fast mode).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_I2C_Config(void)
+{
+  uint32_t ulPclk = HAL_RCC_GetPCLK1Freq();
+  uint32_t ulMhz = ulPclk / 1000000uL;
+  uint32_t ulCcr;
+  uint32_t ulTrise;
+
+  if (HW_I2C_SPEED <= 100000uL)
+  {
+    ulCcr = (ulPclk + 2uL * HW_I2C_SPEED - 1uL) / (2uL * HW_I2C_SPEED);
+    if (ulCcr < 4uL) ulCcr = 4uL;
+    ulTrise = ulMhz + 1uL;
+  }
+  else
+  {
+    ulCcr = (ulPclk + 3uL * HW_I2C_SPEED - 1uL) / (3uL * HW_I2C_SPEED);
+    if (ulCcr < 1uL) ulCcr = 1uL;
+    ulCcr |= I2C_CCR_FS;
+    ulTrise = ulMhz * 300uL / 1000uL + 1uL;
+  }
+
+  I2C_SENS->CR1 = 0uL;
+  I2C_SENS->CR2 = ulMhz | I2C_CR2_ITEVTEN | I2C_CR2_ITERREN;
+  I2C_SENS->CCR = ulCcr;
+  I2C_SENS->TRISE = ulTrise;
+  I2C_SENS->CR1 = I2C_CR1_PE;
+
+  bWriting = false;
+  pucReadByte = NULL;
+  bStopRequested = false;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Busy-wait on the DWT cycle counter
+ *
+ * @param[in] ulCycles  Core clock cycles
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_I2C_Delay(uint32_t ulCycles)
+{
+  uint32_t ulStart = DWT->CYCCNT;
+  while ((DWT->CYCCNT - ulStart) < ulCycles) {}
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stop both DMA channels and DMA requests
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_I2C_DmaStop(void)
+{
+  I2C_SENS->CR2 &= ~(I2C_CR2_DMAEN | I2C_CR2_LAST);
+  DMA_I2C_TX_CHANNEL->CCR = 0uL;
+  DMA_I2C_RX_CHANNEL->CCR = 0uL;
+  DMA1->IFCR = DMA_I2C_TX_IFCR_CGIF | DMA_I2C_RX_IFCR_CGIF;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Timeout tick, called from SysTick interrupt context
+ *
+ * Stops itself once the queue is idle.
+ *
+ * @param[in,out] *psTimer  Tick timer
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_I2C_Tick(HW_CLK_TimerTypeDef* psTimer)
+{
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  vI2CQ_Tick(&sQueue);
+  if (!bI2CQ_IsBusy(&sQueue)) vHW_CLK_TimerStop(psTimer);
+  vHW_IRQ_Unlock(ulLock);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: generate (repeated) start condition
+ *
+ * CR1 must not be written while a stop request is pending; the wait is
+ * bounded, a bus that does not complete the stop times out in the queue.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_I2C_Start(void)
+{
+  uint32_t ulStart = DWT->CYCCNT;
+  uint32_t ulLimit = SystemCoreClock / 1000000uL * HW_I2C_STOP_WAIT_US;
+  while (((I2C_SENS->CR1 & I2C_CR1_STOP) != 0uL) && ((DWT->CYCCNT - ulStart) < ulLimit)) {}
+
+  bStopRequested = false;
+  I2C_SENS->CR1 |= I2C_CR1_ACK | I2C_CR1_START;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: send address byte (clears SB)
+ *
+ * @param[in] ucAddrRw  Address and direction bit
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_I2C_Address(uint8_t ucAddrRw)
+{
+  I2C_SENS->DR = ucAddrRw;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: transmit data on the DMA channel
+ *
+ * Clearing ADDR releases the clock stretch and starts the transfer.
+ *
+ * @param[in] *pucData  Data
+ * @param[in] uiLen     Number of bytes (min. 1)
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_I2C_Write(const uint8_t* pucData, uint16_t uiLen)
+{
+  DMA_I2C_TX_CHANNEL->CMAR = (uint32_t)pucData;
+  DMA_I2C_TX_CHANNEL->CNDTR = uiLen;
+  DMA_I2C_TX_CHANNEL->CCR = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_EN;
+  I2C_SENS->CR2 |= I2C_CR2_DMAEN;
+  bWriting = true;
+
+  (void)I2C_SENS->SR1;
+  (void)I2C_SENS->SR2;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: receive data on the DMA channel
+ *
+ * With LAST set, the peripheral does not acknowledge the byte of the final
+ * DMA request.
+ *
+ * @param[out] *pucData Buffer
+ * @param[in] uiLen     Number of bytes (min. 1)
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_I2C_Read(uint8_t* pucData, uint16_t uiLen)
+{
+  if (uiLen == 1u)
+  {
+    I2C_SENS->CR1 &= ~I2C_CR1_ACK;
+    (void)I2C_SENS->SR1;
+    (void)I2C_SENS->SR2;
+    I2C_SENS->CR1 |= I2C_CR1_STOP;
+    bStopRequested = true;
+    pucReadByte = pucData;
+    I2C_SENS->CR2 |= I2C_CR2_ITBUFEN;
+    return;
+  }
+
+  DMA_I2C_RX_CHANNEL->CMAR = (uint32_t)pucData;
+  DMA_I2C_RX_CHANNEL->CNDTR = uiLen;
+  DMA_I2C_RX_CHANNEL->CCR = DMA_CCR_MINC | DMA_CCR_TCIE | DMA_CCR_TEIE | DMA_CCR_EN;
+  I2C_SENS->CR2 |= I2C_CR2_DMAEN | I2C_CR2_LAST;
+
+  (void)I2C_SENS->SR1;
+  (void)I2C_SENS->SR2;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: abort data transfer and generate stop condition
+ *
+ * Also clears a pending ADDR (address-only probe).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_I2C_Stop(void)
+{
+  vHW_I2C_DmaStop();
+  I2C_SENS->CR2 &= ~I2C_CR2_ITBUFEN;
+  bWriting = false;
+  pucReadByte = NULL;
+
+  (void)I2C_SENS->SR1;
+  (void)I2C_SENS->SR2;
+  if (!bStopRequested) I2C_SENS->CR1 |= I2C_CR1_STOP;
+  bStopRequested = true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: free the bus and reset the peripheral
+ *
+ * Takes up to about 100 us at the recovery clock.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_I2C_Recover(void)
+{
+  uint32_t ulHalfBit = SystemCoreClock / (2uL * HW_I2C_RECOVERY_SPEED);
+
+  vHW_I2C_DmaStop();
+  I2C_SENS->CR1 = 0uL;
+
+  // Pins as open-drain outputs, released
+  I2C_SENS_PORT->BSRR = HW_I2C_PINS;
+  GPIO_InitTypeDef sPins = {
+    .Pin = HW_I2C_PINS,
+    .Mode = GPIO_MODE_OUTPUT_OD,
+    .Pull = GPIO_NOPULL,
+    .Speed = GPIO_SPEED_FREQ_HIGH
+  };
+  HAL_GPIO_Init(I2C_SENS_PORT, &sPins);
+  vHW_I2C_Delay(ulHalfBit);
+
+  // Clock out the rest of a byte a slave is sending
+  for (uint32_t i = 0uL; (i < HW_I2C_RECOVERY_CLOCKS) &&
+       ((I2C_SENS_PORT->IDR & I2C_SENS_SDA_PIN) == 0uL); ++i)
+  {
+    I2C_SENS_PORT->BSRR = (uint32_t)I2C_SENS_SCL_PIN << 16;
+    vHW_I2C_Delay(ulHalfBit);
+    I2C_SENS_PORT->BSRR = I2C_SENS_SCL_PIN;
+    vHW_I2C_Delay(ulHalfBit);
+  }
+
+  // Stop condition: SDA rises while SCL is high
+  I2C_SENS_PORT->BSRR = (uint32_t)I2C_SENS_SCL_PIN << 16;
+  vHW_I2C_Delay(ulHalfBit);
+  I2C_SENS_PORT->BSRR = (uint32_t)I2C_SENS_SDA_PIN << 16;
+  vHW_I2C_Delay(ulHalfBit);
+  I2C_SENS_PORT->BSRR = I2C_SENS_SCL_PIN;
+  vHW_I2C_Delay(ulHalfBit);
+  I2C_SENS_PORT->BSRR = I2C_SENS_SDA_PIN;
+  vHW_I2C_Delay(ulHalfBit);
+
+  sPins.Mode = GPIO_MODE_AF_OD;
+  HAL_GPIO_Init(I2C_SENS_PORT, &sPins);
+
+  I2C_SENS->CR1 = I2C_CR1_SWRST;
+  I2C_SENS->CR1 = 0uL;
+  vHW_I2C_Config();
+}
@@ -0,0 +1,42 @@
+/*!****************************************************************************
+ * @file
+ * hw_i2c.h
+ *
+ * @brief
+ * Hardware Layer - I2C master transaction engine for sensors
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef HW_I2C_H_
+#define HW_I2C_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "i2cq.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Bus clock in Hz (up to 100 kHz standard mode, above fast mode)
+#ifndef HW_I2C_SPEED
+#define HW_I2C_SPEED                  400000uL
+#endif
+
+/// Repeated attempts after an error
+#ifndef HW_I2C_RETRIES
+#define HW_I2C_RETRIES                2u
+#endif
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vHW_I2C_Init(void);
+bool bHW_I2C_Submit(I2CQ_XferTypeDef* psXfer);
+bool bHW_I2C_SubmitBatch(I2CQ_BatchTypeDef* psBatch);
+void vHW_I2C_GetStats(I2CQ_StatsTypeDef* psStats);
+
+void vHW_I2C_EvIRQHandler(void);
+void vHW_I2C_ErIRQHandler(void);
+void vHW_I2C_DmaIRQHandler(void);
+
+#endif // HW_I2C_H_
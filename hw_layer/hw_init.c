@@ -0,0 +1,186 @@
+/*!****************************************************************************
+ * @file
+ * hw_init.c
+ *
+ * @brief
+ * Hardware Layer - Register-level bring-up
+ *
+ * Replaces HAL_Init(), HAL_RCC_OscConfig()/HAL_RCC_ClockConfig() and
+ * HAL_GPIO_Init() by writing pre-computed register values from constant
+ * tables: flash wait states, clock tree, peripheral clock enables (one write
+ * per bus), port configuration and SysTick. The values produce the same
+ * configuration as the HAL path; drivers skip the parts covered here when
+ * HW_INIT_DIRECT is set. Interrupt priorities are applied from the priority
+ * plan (hw_irq) in both paths.
+ *
+ * Ready flags are polled without timeout. A missing HSE hangs in
+ * vHW_INIT_Apply() (the HAL path stops at a breakpoint instead).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include "stm32f1xx_hal.h"
+#include "hw_clkcfg.h"
+#include "hw_init.h"
+#include "hw_iodef.h"
+
+#if HW_INIT_DIRECT
+
+/*- Macros -------------------------------------------------------------------*/
+/// SysTick rate
+#define HW_INIT_TICK_RATE             1000u
+
+/// Port configuration register value after reset (all floating inputs)
+#define HW_INIT_CR_RESET              0x44444444uL
+
+/*! @brief Pin configuration (CNFy[1:0] and MODEy[1:0])
+ *  @{                                                                        */
+#define HW_INIT_PIN_ANALOG            0x0uL   ///< Analog input
+#define HW_INIT_PIN_FLOATING          0x4uL   ///< Floating input
+#define HW_INIT_PIN_OUT_OD_2MHZ       0x6uL   ///< Open-drain output, 2 MHz
+#define HW_INIT_PIN_OUT_PP_50MHZ      0x3uL   ///< Push-pull output, 50 MHz
+#define HW_INIT_PIN_AF_PP_50MHZ       0xBuL   ///< Alternate function push-pull, 50 MHz
+#define HW_INIT_PIN_AF_OD_50MHZ       0xFuL   ///< Alternate function open-drain, 50 MHz
+/*! @}                                                                        */
+
+/// Nibble mask of the pins set in an 8-bit pin mask
+#define HW_INIT_NIBBLES(ulPins8)                                               \
+  (((((ulPins8) >> 0) & 1uL) * 0x0000000FuL) | ((((ulPins8) >> 1) & 1uL) * 0x000000F0uL) | \
+   ((((ulPins8) >> 2) & 1uL) * 0x00000F00uL) | ((((ulPins8) >> 3) & 1uL) * 0x0000F000uL) | \
+   ((((ulPins8) >> 4) & 1uL) * 0x000F0000uL) | ((((ulPins8) >> 5) & 1uL) * 0x00F00000uL) | \
+   ((((ulPins8) >> 6) & 1uL) * 0x0F000000uL) | ((((ulPins8) >> 7) & 1uL) * 0xF0000000uL))
+
+/// Configuration register value ulCr with pins of an 8-bit pin mask set to ulCfg
+#define HW_INIT_CR(ulCr, ulPins8, ulCfg)                                       \
+  (((ulCr) & ~HW_INIT_NIBBLES(ulPins8)) |                                      \
+   (HW_INIT_NIBBLES(ulPins8) & ((ulCfg) * 0x11111111uL)))
+
+/*! @brief CRL / CRH value with pins of a 16-bit pin mask set to ulCfg
+ *  @{                                                                        */
+#define HW_INIT_CRL(ulPins, ulCfg)    HW_INIT_CRL_SET(HW_INIT_CR_RESET, ulPins, ulCfg)
+#define HW_INIT_CRH(ulPins, ulCfg)    HW_INIT_CRH_SET(HW_INIT_CR_RESET, ulPins, ulCfg)
+/*! @}                                                                        */
+
+/*! @brief CRL / CRH value ulCr with pins of a 16-bit pin mask changed to ulCfg
+ *  @{                                                                        */
+#define HW_INIT_CRL_SET(ulCr, ulPins, ulCfg)                                   \
+  HW_INIT_CR(ulCr, (uint32_t)(ulPins) & 0xFFuL, ulCfg)
+#define HW_INIT_CRH_SET(ulCr, ulPins, ulCfg)                                   \
+  HW_INIT_CR(ulCr, ((uint32_t)(ulPins) >> 8) & 0xFFuL, ulCfg)
+/*! @}                                                                        */
+
+_Static_assert((HW_CLK_HCLK / HW_INIT_TICK_RATE - 1u) <= SysTick_LOAD_RELOAD_Msk,
+               "SysTick reload out of range");
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Clock tree and flash configuration
+typedef struct {
+  uint32_t ulFlashAcr;            ///< FLASH_ACR
+  uint32_t ulCfgr;                ///< RCC_CFGR without SYSCLK switch
+  uint32_t ulAhbEnr;              ///< RCC_AHBENR
+  uint32_t ulApb2Enr;             ///< RCC_APB2ENR
+  uint32_t ulApb1Enr;             ///< RCC_APB1ENR
+} HW_INIT_ClockTypeDef;
+
+/// Port configuration
+typedef struct {
+  GPIO_TypeDef* psPort;           ///< Port
+  uint32_t ulCrl;                 ///< GPIOx_CRL
+  uint32_t ulCrh;                 ///< GPIOx_CRH
+  uint32_t ulOdr;                 ///< GPIOx_ODR, written before the mode
+} HW_INIT_PortTypeDef;
+
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Clock tree as solved from the HW_CLK_* targets (hw_clkcfg.h, checked in hw_clk)
+static const HW_INIT_ClockTypeDef sClock = {
+  .ulFlashAcr = HW_CLK_FLASH_ACR,
+  .ulCfgr = HW_CLK_CFGR,
+  .ulAhbEnr = RCC_AHBENR_SRAMEN | RCC_AHBENR_FLITFEN | RCC_AHBENR_DMA1EN |
+              RCC_AHBENR_CRCEN,
+  .ulApb2Enr = RCC_APB2ENR_IOPAEN | RCC_APB2ENR_IOPBEN | RCC_APB2ENR_IOPCEN |
+               RCC_APB2ENR_ADC1EN | RCC_APB2ENR_SPI1EN | RCC_APB2ENR_TIM1EN,
+  .ulApb1Enr = RCC_APB1ENR_USBEN | RCC_APB1ENR_I2C1EN | RCC_APB1ENR_TIM2EN
+};
+
+/// Ports: SPI NOR (deselected), USB D+ (low, detached) and sequencer PWM on
+/// port A, analog inputs, sensor I2C bus (released) and sequencer outputs
+/// (low) on port B, LED (off)
+static const HW_INIT_PortTypeDef asPorts[] = {
+  {
+    .psPort = SPI_NOR_PORT,
+    .ulCrl = HW_INIT_CRL_SET(HW_INIT_CRL(SPI_NOR_CS_PIN, HW_INIT_PIN_OUT_PP_50MHZ),
+                             SPI_NOR_AF_PINS, HW_INIT_PIN_AF_PP_50MHZ),
+    .ulCrh = HW_INIT_CRH_SET(HW_INIT_CRH(USB_DEV_DP_PIN, HW_INIT_PIN_OUT_OD_2MHZ),
+                             SEQ_PWM_PINS, HW_INIT_PIN_AF_PP_50MHZ),
+    .ulOdr = SPI_NOR_CS_PIN
+  },
+  {
+    .psPort = AIN_PORT,
+    .ulCrl = HW_INIT_CRL_SET(HW_INIT_CRL(AIN_PINS, HW_INIT_PIN_ANALOG),
+                             I2C_SENS_SCL_PIN | I2C_SENS_SDA_PIN, HW_INIT_PIN_AF_OD_50MHZ),
+    .ulCrh = HW_INIT_CRH_SET(HW_INIT_CRH(AIN_PINS, HW_INIT_PIN_ANALOG),
+                             SEQ_GPIO_PINS, HW_INIT_PIN_OUT_PP_50MHZ),
+    .ulOdr = I2C_SENS_SCL_PIN | I2C_SENS_SDA_PIN
+  },
+  {
+    .psPort = LED_PORT,
+    .ulCrl = HW_INIT_CRL(LED_PIN, HW_INIT_PIN_OUT_OD_2MHZ),
+    .ulCrh = HW_INIT_CRH(LED_PIN, HW_INIT_PIN_OUT_OD_2MHZ),
+    .ulOdr = LED_PIN
+  }
+};
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Apply bring-up tables
+ *
+ * Must be called once after reset, instead of HAL_Init(). Leaves SysTick
+ * running at 1 ms.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_INIT_Apply(void)
+{
+  // Wait states before raising SYSCLK
+  FLASH->ACR = sClock.ulFlashAcr;
+
+  // HSE and PLL, then switch SYSCLK
+  RCC->CR |= RCC_CR_HSEON;
+  while ((RCC->CR & RCC_CR_HSERDY) == 0uL) {}
+  RCC->CFGR = sClock.ulCfgr;
+  RCC->CR |= RCC_CR_PLLON;
+  while ((RCC->CR & RCC_CR_PLLRDY) == 0uL) {}
+  RCC->CFGR = sClock.ulCfgr | RCC_CFGR_SW_PLL;
+  while ((RCC->CFGR & RCC_CFGR_SWS) != RCC_CFGR_SWS_PLL) {}
+  SystemCoreClock = HW_CLK_HCLK;
+
+  // Disable unused LSI and HSI
+  RCC->CSR &= ~RCC_CSR_LSION;
+  RCC->CR &= ~RCC_CR_HSION;
+
+  // Peripheral clocks, one write per bus; read back before first access
+  RCC->AHBENR = sClock.ulAhbEnr;
+  RCC->APB2ENR = sClock.ulApb2Enr;
+  RCC->APB1ENR = sClock.ulApb1Enr;
+  (void)RCC->APB1ENR;
+
+  for (uint32_t i = 0uL; i < sizeof(asPorts) / sizeof(asPorts[0]); ++i)
+  {
+    const HW_INIT_PortTypeDef* psCfg = &asPorts[i];
+    psCfg->psPort->ODR = psCfg->ulOdr;
+    psCfg->psPort->CRL = psCfg->ulCrl;
+    psCfg->psPort->CRH = psCfg->ulCrh;
+  }
+
+  SysTick->LOAD = HW_CLK_HCLK / HW_INIT_TICK_RATE - 1uL;
+  SysTick->VAL = 0uL;
+  SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+}
+
+#endif
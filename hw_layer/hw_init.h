@@ -0,0 +1,31 @@
+/*!****************************************************************************
+ * @file
+ * hw_init.h
+ *
+ * @brief
+ * Hardware Layer - Register-level bring-up
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef HW_INIT_H_
+#define HW_INIT_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Bring up clocks and pins from a constant register table instead of
+/// HAL_Init(), HAL RCC and HAL GPIO configuration
+#ifndef HW_INIT_DIRECT
+#define HW_INIT_DIRECT                1
+#endif
+
+
+/*- Public interface ---------------------------------------------------------*/
+#if HW_INIT_DIRECT
+void vHW_INIT_Apply(void);
+#endif
+
+#endif // HW_INIT_H_
@@ -18,4 +18,130 @@
 #define LED_PORT                      GPIOC
 /*! @}                                                                        */
 
+/*! @brief Analog inputs (ADC1 channels 8, 9)
+ *  @{                                                                        */
+#define AIN_PINS                      (GPIO_PIN_0 | GPIO_PIN_1)
+#define AIN_PORT                      GPIOB
+#define AIN_CHANNELS                  8u, 9u
+/*! @}                                                                        */
+
+/*! @brief SPI NOR flash on SPI1
+ *  @{                                                                        */
+#define SPI_NOR                       SPI1
+#define SPI_NOR_PORT                  GPIOA
+#define SPI_NOR_CS_PIN                GPIO_PIN_4
+#define SPI_NOR_AF_PINS               (GPIO_PIN_5 | GPIO_PIN_7)
+#define SPI_NOR_MISO_PIN              GPIO_PIN_6
+/*! @}                                                                        */
+
+/*! @brief Sensor bus on I2C1 (SCL PB6, SDA PB7, external pull-ups)
+ *  @{                                                                        */
+#define I2C_SENS                      I2C1
+#define I2C_SENS_PORT                 GPIOB
+#define I2C_SENS_SCL_PIN              GPIO_PIN_6
+#define I2C_SENS_SDA_PIN              GPIO_PIN_7
+#define I2C_SENS_EV_IRQn              I2C1_EV_IRQn
+#define I2C_SENS_EV_IRQHandler        I2C1_EV_IRQHandler
+#define I2C_SENS_ER_IRQn              I2C1_ER_IRQn
+#define I2C_SENS_ER_IRQHandler        I2C1_ER_IRQHandler
+/*! @}                                                                        */
+
+/*! @brief Pulse capture input on TIM2 (PA0: TI1, rising edges on CC1,
+ *  falling edges on CC2)
+ *  @{                                                                        */
+#define CAPT_TIM                      TIM2
+#define CAPT_PORT                     GPIOA
+#define CAPT_PIN                      GPIO_PIN_0
+#define CAPT_IRQn                     TIM2_IRQn
+#define CAPT_IRQHandler               TIM2_IRQHandler
+/*! @}                                                                        */
+
+/*! @brief Waveform sequencer on TIM1 (PWM on PA8..PA10: CH1..CH3, set/reset
+ *  patterns on PB12..PB15)
+ *  @{                                                                        */
+#define SEQ_TIM                       TIM1
+#define SEQ_PWM_PORT                  GPIOA
+#define SEQ_PWM_PINS                  (GPIO_PIN_8 | GPIO_PIN_9 | GPIO_PIN_10)
+#define SEQ_GPIO_PORT                 GPIOB
+#define SEQ_GPIO_PINS                 (GPIO_PIN_12 | GPIO_PIN_13 | GPIO_PIN_14 | GPIO_PIN_15)
+/*! @}                                                                        */
+
+/*! @brief USB full-speed device (D- PA11, D+ PA12 with external pull-up)
+ *  @{                                                                        */
+#define USB_DEV_PORT                  GPIOA
+#define USB_DEV_DP_PIN                GPIO_PIN_12
+#define USB_DEV_IRQn                  USB_LP_CAN1_RX0_IRQn
+#define USB_DEV_IRQHandler            USB_LP_CAN1_RX0_IRQHandler
+/*! @}                                                                        */
+
+/*! @brief DMA1 ADC1 channel
+ *  @{                                                                        */
+#define DMA_ADC_CHANNEL               DMA1_Channel1
+#define DMA_ADC_IRQn                  DMA1_Channel1_IRQn
+#define DMA_ADC_IRQHandler            DMA1_Channel1_IRQHandler
+#define DMA_ADC_ISR_HTIF              DMA_ISR_HTIF1
+#define DMA_ADC_ISR_TCIF              DMA_ISR_TCIF1
+#define DMA_ADC_IFCR_CGIF             DMA_IFCR_CGIF1
+/*! @}                                                                        */
+
+/*! @brief DMA1 SPI1 channels (receive polled, transmit interrupt)
+ *  @{                                                                        */
+#define DMA_SPI_RX_CHANNEL            DMA1_Channel2
+#define DMA_SPI_RX_ISR_TCIF           DMA_ISR_TCIF2
+#define DMA_SPI_RX_IFCR_CGIF          DMA_IFCR_CGIF2
+#define DMA_SPI_TX_CHANNEL            DMA1_Channel3
+#define DMA_SPI_TX_IRQn               DMA1_Channel3_IRQn
+#define DMA_SPI_TX_IRQHandler         DMA1_Channel3_IRQHandler
+#define DMA_SPI_TX_ISR_TCIF           DMA_ISR_TCIF3
+#define DMA_SPI_TX_ISR_TEIF           DMA_ISR_TEIF3
+#define DMA_SPI_TX_IFCR_CGIF          DMA_IFCR_CGIF3
+/*! @}                                                                        */
+
+/*! @brief DMA1 I2C1 channels (transmit completion from I2C BTF, receive
+ *  interrupt)
+ *  @{                                                                        */
+#define DMA_I2C_TX_CHANNEL            DMA1_Channel6
+#define DMA_I2C_TX_IFCR_CGIF          DMA_IFCR_CGIF6
+#define DMA_I2C_RX_CHANNEL            DMA1_Channel7
+#define DMA_I2C_RX_IRQn               DMA1_Channel7_IRQn
+#define DMA_I2C_RX_IRQHandler         DMA1_Channel7_IRQHandler
+#define DMA_I2C_RX_ISR_TCIF           DMA_ISR_TCIF7
+#define DMA_I2C_RX_ISR_TEIF           DMA_ISR_TEIF7
+#define DMA_I2C_RX_IFCR_CGIF          DMA_IFCR_CGIF7
+/*! @}                                                                        */
+
+/*! @brief DMA1 channel shared by TIM2 CC1 (capture) and TIM1 UP
+ *  (sequencer), one user at a time (hw_dma); also the bootloader's USART1
+ *  receive
+ *  @{                                                                        */
+#define DMA_SHARED_CHANNEL            DMA1_Channel5
+#define DMA_SHARED_IRQn               DMA1_Channel5_IRQn
+#define DMA_SHARED_IRQHandler         DMA1_Channel5_IRQHandler
+#define DMA_SHARED_ISR_HTIF           DMA_ISR_HTIF5
+#define DMA_SHARED_ISR_TCIF           DMA_ISR_TCIF5
+#define DMA_SHARED_IFCR_CGIF          DMA_IFCR_CGIF5
+/*! @}                                                                        */
+
+/*! @brief DMA1 memory-to-memory engine
+ *  @{                                                                        */
+#define DMA_M2M_CHANNEL               DMA1_Channel4
+#define DMA_M2M_IRQn                  DMA1_Channel4_IRQn
+#define DMA_M2M_IRQHandler            DMA1_Channel4_IRQHandler
+#define DMA_M2M_ISR_TCIF              DMA_ISR_TCIF4
+#define DMA_M2M_ISR_TEIF              DMA_ISR_TEIF4
+#define DMA_M2M_IFCR_CGIF             DMA_IFCR_CGIF4
+/*! @}                                                                        */
+
+/*! @brief Software-triggered interrupts on unused vectors (benchmarks)
+ *  @{                                                                        */
+#define SWI_LAT_CRITICAL_IRQn         PVD_IRQn
+#define SWI_LAT_CRITICAL_IRQHandler   PVD_IRQHandler
+#define SWI_LAT_DRIVER_IRQn           TAMPER_IRQn
+#define SWI_LAT_DRIVER_IRQHandler     TAMPER_IRQHandler
+#define SWI_OS_IRQn                   CAN1_SCE_IRQn
+#define SWI_OS_IRQHandler             CAN1_SCE_IRQHandler
+#define SWI_SPSC_IRQn                 CAN1_RX1_IRQn
+#define SWI_SPSC_IRQHandler           CAN1_RX1_IRQHandler
+/*! @}                                                                        */
+
 #endif // HW_IODEF_H_
@@ -0,0 +1,132 @@
+/*!****************************************************************************
+ * @file
+ * hw_irq.c
+ *
+ * @brief
+ * Hardware Layer - Interrupt priority plan and critical sections
+ *
+ * All interrupt and system exception priorities are assigned from one plan
+ * table. The 4 implemented priority bits are split into 4 preemption levels
+ * and 4 sub-priorities; sub-priorities only order pending interrupts of the
+ * same level.
+ *
+ *   0  CRITICAL   time-critical inputs
+ *   1  DRIVER     peripheral drivers (may use kernel and hw_layer services)
+ *   2  SOFT       software-triggered work
+ *   3  KERNEL     SysTick, SVCall, PendSV
+ *
+ * Critical sections raise BASEPRI to mask levels HW_IRQ_PREEMPT_LOCK and
+ * below, instead of setting PRIMASK. CRITICAL handlers are therefore never
+ * delayed by hw_layer or kernel critical sections; in exchange they must not
+ * call any function taking ulHW_IRQ_Lock() (kernel, timers, DMA queue, SWO,
+ * trace), but may e.g. push to an SPSC queue. Their worst-case entry latency
+ * is bounded by exception entry (12 cycles plus flash wait states), a higher
+ * or equal CRITICAL handler, and the only remaining PRIMASK section: the idle
+ * thread entering sleep (vHW_CLK_Sleep()).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include "stm32f1xx_hal.h"
+#include "hw_iodef.h"
+#include "hw_irq.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// BASEPRI value masking HW_IRQ_PREEMPT_LOCK and lower levels
+#define HW_IRQ_LOCK_BASEPRI                                                    \
+  (NVIC_EncodePriority(HW_IRQ_PRIGROUP, HW_IRQ_PREEMPT_LOCK, 0u) << (8u - __NVIC_PRIO_BITS))
+
+_Static_assert(__NVIC_PRIO_BITS == 4u, "plan assumes 4 priority bits");
+_Static_assert(HW_IRQ_PREEMPT_LOCK > HW_IRQ_PREEMPT_CRITICAL, "CRITICAL level must stay unmasked");
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Plan entry
+typedef struct {
+  IRQn_Type eIrq;                 ///< Interrupt or system exception
+  uint8_t ucPreempt;              ///< Preemption level HW_IRQ_PREEMPT_x
+  uint8_t ucSub;                  ///< Sub-priority, 0 is highest
+} HW_IRQ_PlanTypeDef;
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Priority plan
+static const HW_IRQ_PlanTypeDef asPlan[] = {
+  // Kernel: tick before switch
+  { SysTick_IRQn,           HW_IRQ_PREEMPT_KERNEL,    0u },
+  { SVCall_IRQn,            HW_IRQ_PREEMPT_KERNEL,    1u },
+  { PendSV_IRQn,            HW_IRQ_PREEMPT_KERNEL,    3u },
+
+  // Drivers
+  { DMA_SPI_TX_IRQn,        HW_IRQ_PREEMPT_DRIVER,    0u },
+  { DMA_ADC_IRQn,           HW_IRQ_PREEMPT_DRIVER,    1u },
+  { DMA_M2M_IRQn,           HW_IRQ_PREEMPT_DRIVER,    2u },
+  { USB_DEV_IRQn,           HW_IRQ_PREEMPT_DRIVER,    2u },
+  { I2C_SENS_EV_IRQn,       HW_IRQ_PREEMPT_DRIVER,    1u },
+  { I2C_SENS_ER_IRQn,       HW_IRQ_PREEMPT_DRIVER,    1u },
+  { DMA_I2C_RX_IRQn,        HW_IRQ_PREEMPT_DRIVER,    1u },
+
+  // Capture or sequencer DMA: sequencer re-arms within one sample period
+  { DMA_SHARED_IRQn,        HW_IRQ_PREEMPT_DRIVER,    0u },
+
+  // Time-critical inputs: capture half period count (latency < 227 us)
+  { CAPT_IRQn,              HW_IRQ_PREEMPT_CRITICAL,  1u },
+
+  // Software-triggered interrupts (benchmarks)
+  { SWI_LAT_CRITICAL_IRQn,  HW_IRQ_PREEMPT_CRITICAL,  0u },
+  { SWI_LAT_DRIVER_IRQn,    HW_IRQ_PREEMPT_DRIVER,    3u },
+  { SWI_OS_IRQn,            HW_IRQ_PREEMPT_DRIVER,    3u },
+  { SWI_SPSC_IRQn,          HW_IRQ_PREEMPT_DRIVER,    3u }
+};
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Set priority grouping and apply priority plan
+ *
+ * Interrupts are enabled by their drivers. Must be called after the clock
+ * tree is set up (HAL clock configuration resets the SysTick priority).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_IRQ_Init(void)
+{
+  NVIC_SetPriorityGrouping(HW_IRQ_PRIGROUP);
+  for (uint32_t i = 0uL; i < sizeof(asPlan) / sizeof(asPlan[0]); ++i)
+  {
+    NVIC_SetPriority(asPlan[i].eIrq,
+                     NVIC_EncodePriority(HW_IRQ_PRIGROUP, asPlan[i].ucPreempt, asPlan[i].ucSub));
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Enter critical section
+ *
+ * Masks all interrupts except HW_IRQ_PREEMPT_CRITICAL. May be nested and
+ * called from any handler below CRITICAL level.
+ *
+ * @return  (uint32_t)  Previous state, to be passed to vHW_IRQ_Unlock()
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulHW_IRQ_Lock(void)
+{
+  uint32_t ulState = __get_BASEPRI();
+  __set_BASEPRI_MAX(HW_IRQ_LOCK_BASEPRI);
+  return ulState;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Leave critical section
+ *
+ * @param[in] ulState   State returned by ulHW_IRQ_Lock()
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_IRQ_Unlock(uint32_t ulState)
+{
+  __set_BASEPRI(ulState);
+}
@@ -0,0 +1,39 @@
+/*!****************************************************************************
+ * @file
+ * hw_irq.h
+ *
+ * @brief
+ * Hardware Layer - Interrupt priority plan and critical sections
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef HW_IRQ_H_
+#define HW_IRQ_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Priority grouping (AIRCR.PRIGROUP): 2 bits preemption, 2 bits sub-priority
+#define HW_IRQ_PRIGROUP               5u
+
+/*! @brief Preemption levels, 0 is highest
+ *  @{                                                                        */
+#define HW_IRQ_PREEMPT_CRITICAL       0u  ///< Time-critical inputs, never masked
+#define HW_IRQ_PREEMPT_DRIVER         1u  ///< Peripheral drivers
+#define HW_IRQ_PREEMPT_SOFT           2u  ///< Software-triggered work
+#define HW_IRQ_PREEMPT_KERNEL         3u  ///< SysTick, SVCall, PendSV
+/*! @}                                                                        */
+
+/// Highest preemption level masked by ulHW_IRQ_Lock()
+#define HW_IRQ_PREEMPT_LOCK           HW_IRQ_PREEMPT_DRIVER
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vHW_IRQ_Init(void);
+uint32_t ulHW_IRQ_Lock(void);
+void vHW_IRQ_Unlock(uint32_t ulState);
+
+#endif // HW_IRQ_H_
@@ -10,25 +10,117 @@
 
 /*- Header files -------------------------------------------------------------*/
 #include "stm32f1xx_hal.h"
+#include "bootproto.h"
+#include "hw_adc.h"
+#include "hw_capture.h"
 #include "hw_clk.h"
+#include "hw_crc.h"
+#include "hw_dma.h"
+#include "hw_flight.h"
 #include "hw_gpio.h"
+#include "hw_i2c.h"
+#include "hw_init.h"
+#include "hw_irq.h"
+#include "hw_log.h"
+#include "hw_nvm.h"
+#include "hw_os.h"
+#include "hw_seq.h"
+#include "hw_spi.h"
 #include "hw_swo.h"
+#include "hw_trace.h"
+#include "hw_usb.h"
 #include "hw_layer.h"
 
 
+/*- Macros -------------------------------------------------------------------*/
+/// Vector table address (image start, behind the bootloader if built with it)
+#ifndef HW_APP_BASE
+#define HW_APP_BASE                   FLASH_BASE
+#endif
+
+/// DWT event counter enables
+#define HW_PERF_CTRL_EVENTS           (DWT_CTRL_CPIEVTENA_Msk | DWT_CTRL_EXCEVTENA_Msk | \
+                                       DWT_CTRL_SLEEPEVTENA_Msk | DWT_CTRL_LSUEVTENA_Msk | \
+                                       DWT_CTRL_FOLDEVTENA_Msk)
+
+/// Longest sample in cycles in which no 8-bit event counter can wrap
+#define HW_PERF_EXACT_CYCLES          255uL
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vHW_PerfRead(uint32_t aulRaw[HW_PERF_RAW_COUNTERS]);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Cycles spent in hardware bring-up
+static uint32_t ulBootCycles;
+
+
 /*- Public interface ---------------------------------------------------------*/
 /*!****************************************************************************
  * @brief
  * Initialise hardware layer
  *
  * @date  13.10.2025
+ * @date  19.10.2026  Bring-up by register table with HW_INIT_DIRECT
  ******************************************************************************/
 void vHW_Init(void)
 {
-  HAL_Init();
+  // Enable DWT cycle counter, also measures bring-up
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0uL;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 
+  SCB->VTOR = HW_APP_BASE;
+  vHW_FLIGHT_Init();
+#if HW_INIT_DIRECT
+  vHW_INIT_Apply();
+  vHW_CLK_Init();
+#else
+  HAL_Init();
   vHW_CLK_Init();
   vHW_GPIO_Init();
+#endif
+  vHW_IRQ_Init();
+  vHW_DMA_Init();
+  vHW_CRC_Init();
+  vHW_ADC_Init();
+  vHW_NVM_Init();
+  vHW_SPI_Init();
+  vHW_I2C_Init();
+  vHW_CAPTURE_Init();
+  vHW_SEQ_Init();
+  ulBootCycles = DWT->CYCCNT;
+
+  vHW_CRC_CheckImage();
+
+  vHW_TRACE_Init();
+  vHW_LOG_Init();
+  vHW_USB_Init();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Reset into the serial bootloader
+ *
+ * The request is left in backup register DR1, which survives the reset and
+ * is cleared by the bootloader. Returns only if the image is not linked
+ * behind a bootloader.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_EnterBootloader(void)
+{
+  if (HW_APP_BASE == FLASH_BASE) return;
+
+  vHW_LOG_Flush();
+  vHW_SWO_Flush();
+
+  RCC->APB1ENR |= RCC_APB1ENR_PWREN | RCC_APB1ENR_BKPEN;
+  (void)RCC->APB1ENR;
+  PWR->CR |= PWR_CR_DBP;
+  BKP->DR1 = BOOT_REQUEST_MAGIC;
+  NVIC_SystemReset();
 }
 
 /*!****************************************************************************
@@ -43,6 +135,156 @@ uint32_t ulHW_GetCpuid(void)
   return SCB->CPUID;
 }
 
+/*!****************************************************************************
+ * @brief
+ * Enable or disable DWT event counters
+ *
+ * Enabling clears CPICNT, EXCCNT, SLEEPCNT, LSUCNT and FOLDCNT. Counting
+ * does not slow down the core.
+ *
+ * @param[in] bEnable   Enable counters
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_PerfEnable(bool bEnable)
+{
+  if (bEnable)
+  {
+    DWT->CPICNT = 0uL;
+    DWT->EXCCNT = 0uL;
+    DWT->SLEEPCNT = 0uL;
+    DWT->LSUCNT = 0uL;
+    DWT->FOLDCNT = 0uL;
+    DWT->CTRL |= HW_PERF_CTRL_EVENTS;
+  }
+  else
+  {
+    DWT->CTRL &= ~HW_PERF_CTRL_EVENTS;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start accumulating DWT event counters
+ *
+ * @param[out] *psPerf  Accumulator
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_PerfStart(HW_PerfTypeDef* psPerf)
+{
+  psPerf->ulCycles = 0uL;
+  psPerf->ulCpi = 0uL;
+  psPerf->ulExc = 0uL;
+  psPerf->ulSleep = 0uL;
+  psPerf->ulLsu = 0uL;
+  psPerf->ulFold = 0uL;
+  psPerf->ulInexact = 0uL;
+  vHW_PerfRead(psPerf->aulLast);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Add DWT event counts since the last sample
+ *
+ * The event counters are only 8 bits wide. Each one advances by at most one
+ * per cycle, so the accumulated counts are exact as long as samples are at
+ * most 255 cycles apart, e.g. when sampling once per iteration of a short
+ * loop. Longer samples are counted in ulInexact; the counts are then lower
+ * bounds. The sample itself adds a few cycles and loads to the counts.
+ *
+ * @param[in,out] *psPerf   Accumulator
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_PerfSample(HW_PerfTypeDef* psPerf)
+{
+  uint32_t aulRaw[HW_PERF_RAW_COUNTERS];
+  vHW_PerfRead(aulRaw);
+
+  uint32_t ulCycles = aulRaw[0] - psPerf->aulLast[0];
+  psPerf->ulCycles += ulCycles;
+  psPerf->ulCpi += (aulRaw[1] - psPerf->aulLast[1]) & 0xFFuL;
+  psPerf->ulExc += (aulRaw[2] - psPerf->aulLast[2]) & 0xFFuL;
+  psPerf->ulSleep += (aulRaw[3] - psPerf->aulLast[3]) & 0xFFuL;
+  psPerf->ulLsu += (aulRaw[4] - psPerf->aulLast[4]) & 0xFFuL;
+  psPerf->ulFold += (aulRaw[5] - psPerf->aulLast[5]) & 0xFFuL;
+  if (ulCycles > HW_PERF_EXACT_CYCLES) psPerf->ulInexact++;
+
+  for (uint32_t i = 0uL; i < HW_PERF_RAW_COUNTERS; ++i)
+  {
+    psPerf->aulLast[i] = aulRaw[i];
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Derive metrics from accumulated event counts
+ *
+ * Instructions = cycles - CPI - exception - sleep - LSU cycles + folded
+ * instructions. Stall shares tell where cycles beyond one per instruction
+ * went, e.g. CPICNT rises with flash wait states on taken branches.
+ *
+ * @param[in] *psPerf       Accumulator
+ * @param[out] *psMetrics   Metrics
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_PerfGetMetrics(const HW_PerfTypeDef* psPerf, HW_PerfMetricsTypeDef* psMetrics)
+{
+  uint64_t ullCycles = psPerf->ulCycles;
+  uint32_t ulInstr = psPerf->ulCycles - psPerf->ulCpi - psPerf->ulExc - psPerf->ulSleep -
+                     psPerf->ulLsu + psPerf->ulFold;
+  psMetrics->ulInstructions = ulInstr;
+  psMetrics->ulCpiMilli = (ulInstr != 0uL) ? (uint32_t)(ullCycles * 1000uLL / ulInstr) : 0uL;
+  if (ullCycles == 0uLL) ullCycles = 1uLL;
+  psMetrics->ulCpiStallPermille = (uint32_t)(psPerf->ulCpi * 1000uLL / ullCycles);
+  psMetrics->ulLsuStallPermille = (uint32_t)(psPerf->ulLsu * 1000uLL / ullCycles);
+  psMetrics->ulExcPermille = (uint32_t)(psPerf->ulExc * 1000uLL / ullCycles);
+  psMetrics->ulSleepPermille = (uint32_t)(psPerf->ulSleep * 1000uLL / ullCycles);
+  psMetrics->ulFoldPermille = (ulInstr != 0uL) ? (uint32_t)(psPerf->ulFold * 1000uLL / ulInstr) : 0uL;
+  psMetrics->bExact = psPerf->ulInexact == 0uL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get DWT cycle counter value
+ *
+ * The counter runs at HCLK and wraps around after 2^32 cycles. Use unsigned
+ * subtraction to compute intervals.
+ *
+ * @return  (uint32_t)  Current cycle count
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulHW_GetCycleCount(void)
+{
+  return DWT->CYCCNT;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get duration of hardware bring-up
+ *
+ * Counts core cycles in vHW_Init() from entry until all peripherals are
+ * initialised (excluding the image self-check). Cycles before the switch to
+ * PLL run at HSI (8 MHz).
+ *
+ * @return  (uint32_t)  Bring-up duration in core cycles
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulHW_GetBootCycles(void)
+{
+  return ulBootCycles;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get name of hardware bring-up path
+ *
+ * @return  (const char*)   "register" or "HAL"
+ * @date  19.10.2026
+ ******************************************************************************/
+const char* pcHW_GetInitPath(void)
+{
+  return HW_INIT_DIRECT ? "register" : "HAL";
+}
+
 /*!****************************************************************************
  * @brief
  * Get FLASH memory size in kB
@@ -70,10 +312,91 @@ const uint32_t* pulHW_GetUID(void)
 }
 
 
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Read cycle and event counters
+ *
+ * @param[out] aulRaw   CYCCNT, CPICNT, EXCCNT, SLEEPCNT, LSUCNT, FOLDCNT
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_PerfRead(uint32_t aulRaw[HW_PERF_RAW_COUNTERS])
+{
+  aulRaw[0] = DWT->CYCCNT;
+  aulRaw[1] = DWT->CPICNT;
+  aulRaw[2] = DWT->EXCCNT;
+  aulRaw[3] = DWT->SLEEPCNT;
+  aulRaw[4] = DWT->LSUCNT;
+  aulRaw[5] = DWT->FOLDCNT;
+}
+
+
 /*- Delegated to submodules --------------------------------------------------*/
 void vHW_ToggleLed(void) { vHW_GPIO_ToggleLed(); }
 uint32_t ulHW_GetTime(void) { return ulHW_CLK_GetTime(); }
 uint32_t ulHW_GetCoreClkFreq(void) { return ulHW_CLK_GetCoreClkFreq(); }
+void vHW_TimerInit(HW_CLK_TimerTypeDef* psTimer, HW_CLK_TimerCallbackTypeDef pfnCallback, void* pvContext) { vHW_CLK_TimerInit(psTimer, pfnCallback, pvContext); }
+void vHW_TimerStart(HW_CLK_TimerTypeDef* psTimer, uint32_t ulDelay, uint32_t ulPeriod) { vHW_CLK_TimerStart(psTimer, ulDelay, ulPeriod); }
+void vHW_TimerStop(HW_CLK_TimerTypeDef* psTimer) { vHW_CLK_TimerStop(psTimer); }
 bool bHW_IsSwoDataAvailable(void) { return bHW_SWO_IsDataAvailable(); }
 char cHW_ReadSwo(void) { return cHW_SWO_Read(); }
 void vHW_WriteSwo(char cCh) { vHW_SWO_Write(cCh); }
+void vHW_WriteSwoPort(uint8_t ucPort, char cCh) { vHW_SWO_WritePort(ucPort, cCh); }
+void vHW_SetSwoBuffered(bool bEnable) { vHW_SWO_SetBuffered(bEnable); }
+uint32_t ulHW_GetSwoTxFree(void) { return ulHW_SWO_GetTxFree(); }
+void vHW_PollSwo(void) { vHW_SWO_Poll(); }
+void vHW_FlushSwo(void) { vHW_SWO_Flush(); }
+int32_t lHW_GetDieTemp(void) { return lHW_ADC_GetDieTemp(); }
+uint16_t uiHW_GetVdda(void) { return uiHW_ADC_GetVdda(); }
+uint16_t uiHW_GetAnalogIn(uint8_t ucIdx) { return uiHW_ADC_GetInput(ucIdx); }
+int32_t lHW_NvmGet(uint16_t uiKey, void* pvBuf, uint32_t ulSize) { return lHW_NVM_Get(uiKey, pvBuf, ulSize); }
+bool bHW_NvmPut(uint16_t uiKey, const void* pvData, uint32_t ulLen) { return bHW_NVM_Put(uiKey, pvData, ulLen); }
+bool bHW_NvmDelete(uint16_t uiKey) { return bHW_NVM_Delete(uiKey); }
+uint32_t ulHW_Crc32(const void* pvData, uint32_t ulLen) { return ulHW_CRC_Calc(pvData, ulLen); }
+const HW_CRC_ImageCheckTypeDef* psHW_GetImageCheck(void) { return psHW_CRC_GetImageCheck(); }
+void vHW_Record(uint16_t uiId, uint16_t uiArg) { vHW_FLIGHT_Record(uiId, uiArg); }
+const HW_FLIGHT_DumpTypeDef* psHW_GetFaultDump(void) { return psHW_FLIGHT_GetDump(); }
+bool bHW_LogIsReady(void) { return bHW_LOG_IsReady(); }
+void vHW_LogWrite(const void* pvData, uint32_t ulLen) { vHW_LOG_Write(pvData, ulLen); }
+void vHW_LogFlush(void) { vHW_LOG_Flush(); }
+uint32_t ulHW_LogDump(void) { return ulHW_LOG_Dump(); }
+void vHW_LogGetStats(HW_LOG_StatsTypeDef* psStats) { vHW_LOG_GetStats(psStats); }
+bool bHW_UsbIsConnected(void) { return bHW_USB_IsConnected(); }
+uint32_t ulHW_UsbWrite(const void* pvData, uint32_t ulLen) { return ulHW_USB_Write(pvData, ulLen); }
+uint32_t ulHW_UsbRead(void* pvData, uint32_t ulLen) { return ulHW_USB_Read(pvData, ulLen); }
+bool bHW_UsbIsDataAvailable(void) { return bHW_USB_IsDataAvailable(); }
+bool bHW_I2cSubmit(I2CQ_XferTypeDef* psXfer) { return bHW_I2C_Submit(psXfer); }
+bool bHW_I2cSubmitBatch(I2CQ_BatchTypeDef* psBatch) { return bHW_I2C_SubmitBatch(psBatch); }
+void vHW_I2cGetStats(I2CQ_StatsTypeDef* psStats) { vHW_I2C_GetStats(psStats); }
+bool bHW_CaptureStart(void) { return bHW_CAPTURE_Start(); }
+void vHW_CaptureStop(void) { vHW_CAPTURE_Stop(); }
+bool bHW_CaptureGetBatch(CAPT_BatchTypeDef* psBatch, uint64_t* pullEdges) { return bHW_CAPTURE_GetBatch(psBatch, pullEdges); }
+uint64_t ullHW_CaptureGetTime(void) { return ullHW_CAPTURE_GetTime(); }
+uint32_t ulHW_CaptureGetClock(void) { return ulHW_CAPTURE_GetClock(); }
+uint32_t ulHW_CaptureGetOverruns(void) { return ulHW_CAPTURE_GetOverruns(); }
+bool bHW_SeqStart(const HW_SEQ_ConfigTypeDef* psConfig, const SEQ_TableTypeDef* psTable) { return bHW_SEQ_Start(psConfig, psTable); }
+bool bHW_SeqStartStream(const HW_SEQ_ConfigTypeDef* psConfig, SEQ_RefillTypeDef pfnRefill, void* pvContext) { return bHW_SEQ_StartStream(psConfig, pfnRefill, pvContext); }
+bool bHW_SeqQueue(const SEQ_TableTypeDef* psTable) { return bHW_SEQ_Queue(psTable); }
+void vHW_SeqStop(void) { vHW_SEQ_Stop(); }
+bool bHW_SeqIsPlaying(void) { return bHW_SEQ_IsPlaying(); }
+uint32_t ulHW_SeqGetTop(uint32_t ulRate) { return ulHW_SEQ_GetTop(ulRate); }
+void vHW_SeqGetStats(SEQ_StatsTypeDef* psStats) { vHW_SEQ_GetStats(psStats); }
+void vHW_OsInit(void) { vHW_OS_Init(); }
+bool bHW_ThreadCreate(HW_OS_ThreadTypeDef* psThread, const char* pcName, HW_OS_EntryTypeDef pfnEntry, void* pvArg, uint32_t* pulStack, uint32_t ulStackSize, uint8_t ucPriority) { return bHW_OS_ThreadCreate(psThread, pcName, pfnEntry, pvArg, pulStack, ulStackSize, ucPriority); }
+void vHW_OsStart(void) { vHW_OS_Start(); }
+void vHW_Sleep(uint32_t ulMs) { vHW_OS_Delay(ulMs); }
+void vHW_SleepUntil(uint32_t* pulWakeTime, uint32_t ulPeriod) { vHW_OS_DelayUntil(pulWakeTime, ulPeriod); }
+void vHW_SemInit(HW_OS_SemTypeDef* psSem, uint32_t ulCount, uint32_t ulMax) { vHW_OS_SemInit(psSem, ulCount, ulMax); }
+bool bHW_SemTake(HW_OS_SemTypeDef* psSem, uint32_t ulTimeout) { return bHW_OS_SemTake(psSem, ulTimeout); }
+bool bHW_SemGive(HW_OS_SemTypeDef* psSem) { return bHW_OS_SemGive(psSem); }
+void vHW_MutexInit(HW_OS_MutexTypeDef* psMutex) { vHW_OS_MutexInit(psMutex); }
+bool bHW_MutexLock(HW_OS_MutexTypeDef* psMutex, uint32_t ulTimeout) { return bHW_OS_MutexLock(psMutex, ulTimeout); }
+bool bHW_MutexUnlock(HW_OS_MutexTypeDef* psMutex) { return bHW_OS_MutexUnlock(psMutex); }
+void vHW_Trace(uint8_t ucStream, uint16_t uiId, uint32_t ulNumArgs, const uint32_t* pulArgs) { vHW_TRACE_Event(ucStream, uiId, ulNumArgs, pulArgs); }
+#if HW_TRACE_TIMELINE
+void vHW_TraceBegin(uint16_t uiRegion) { vHW_TRACE_RegionBegin(uiRegion); }
+void vHW_TraceEnd(uint16_t uiRegion) { vHW_TRACE_RegionEnd(uiRegion); }
+#else
+void vHW_TraceBegin(uint16_t uiRegion) { (void)uiRegion; }
+void vHW_TraceEnd(uint16_t uiRegion) { (void)uiRegion; }
+#endif
@@ -14,10 +14,50 @@
 /*- Header files -------------------------------------------------------------*/
 #include <stdbool.h>
 #include <stdint.h>
+#include "hw_capture.h"
+#include "hw_clk.h"
+#include "hw_crc.h"
+#include "hw_flight.h"
+#include "hw_i2c.h"
+#include "hw_log.h"
+#include "hw_os.h"
+#include "hw_seq.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Counters read per sample: CYCCNT and the five DWT event counters
+#define HW_PERF_RAW_COUNTERS          6u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// DWT event counters, accumulated over samples (see vHW_PerfSample())
+typedef struct {
+  uint32_t ulCycles;              ///< Core cycles (CYCCNT)
+  uint32_t ulCpi;                 ///< Extra cycles of multi-cycle instructions and fetch stalls (CPICNT)
+  uint32_t ulExc;                 ///< Cycles of exception entry and return (EXCCNT)
+  uint32_t ulSleep;               ///< Cycles in sleep (SLEEPCNT)
+  uint32_t ulLsu;                 ///< Extra cycles of loads and stores (LSUCNT)
+  uint32_t ulFold;                ///< Folded instructions, executed in zero cycles (FOLDCNT)
+  uint32_t ulInexact;             ///< Samples over 255 cycles, counts are lower bounds
+  uint32_t aulLast[HW_PERF_RAW_COUNTERS]; ///< Raw counter values at last sample
+} HW_PerfTypeDef;
+
+/// Metrics derived from event counters
+typedef struct {
+  uint32_t ulInstructions;        ///< Instructions executed
+  uint32_t ulCpiMilli;            ///< Cycles per instruction x 1000
+  uint32_t ulCpiStallPermille;    ///< CPICNT share of cycles in 0.1 %
+  uint32_t ulLsuStallPermille;    ///< LSUCNT share of cycles in 0.1 %
+  uint32_t ulExcPermille;         ///< EXCCNT share of cycles in 0.1 %
+  uint32_t ulSleepPermille;       ///< SLEEPCNT share of cycles in 0.1 %
+  uint32_t ulFoldPermille;        ///< Folded share of instructions in 0.1 %
+  bool bExact;                    ///< No counter can have wrapped between samples
+} HW_PerfMetricsTypeDef;
 
 
 /*- Public interface ---------------------------------------------------------*/
 void vHW_Init(void);
+void vHW_EnterBootloader(void);
 
 // GPIOs
 void vHW_ToggleLed(void);
@@ -26,13 +66,104 @@ void vHW_ToggleLed(void);
 uint32_t ulHW_GetTime(void);
 uint32_t ulHW_GetCoreClkFreq(void);
 
+// Software timers
+void vHW_TimerInit(HW_CLK_TimerTypeDef* psTimer,
+                   HW_CLK_TimerCallbackTypeDef pfnCallback, void* pvContext);
+void vHW_TimerStart(HW_CLK_TimerTypeDef* psTimer, uint32_t ulDelay, uint32_t ulPeriod);
+void vHW_TimerStop(HW_CLK_TimerTypeDef* psTimer);
+
 // SWO
 bool bHW_IsSwoDataAvailable(void);
 char cHW_ReadSwo(void);
 void vHW_WriteSwo(char cCh);
+void vHW_WriteSwoPort(uint8_t ucPort, char cCh);
+void vHW_SetSwoBuffered(bool bEnable);
+uint32_t ulHW_GetSwoTxFree(void);
+void vHW_PollSwo(void);
+void vHW_FlushSwo(void);
+
+// Telemetry
+int32_t lHW_GetDieTemp(void);
+uint16_t uiHW_GetVdda(void);
+uint16_t uiHW_GetAnalogIn(uint8_t ucIdx);
+
+// Non-volatile storage
+int32_t lHW_NvmGet(uint16_t uiKey, void* pvBuf, uint32_t ulSize);
+bool bHW_NvmPut(uint16_t uiKey, const void* pvData, uint32_t ulLen);
+bool bHW_NvmDelete(uint16_t uiKey);
+
+// Integrity
+uint32_t ulHW_Crc32(const void* pvData, uint32_t ulLen);
+const HW_CRC_ImageCheckTypeDef* psHW_GetImageCheck(void);
+
+// Flight recorder
+void vHW_Record(uint16_t uiId, uint16_t uiArg);
+const HW_FLIGHT_DumpTypeDef* psHW_GetFaultDump(void);
+
+// Log
+bool bHW_LogIsReady(void);
+void vHW_LogWrite(const void* pvData, uint32_t ulLen);
+void vHW_LogFlush(void);
+uint32_t ulHW_LogDump(void);
+void vHW_LogGetStats(HW_LOG_StatsTypeDef* psStats);
+
+// USB serial port
+bool bHW_UsbIsConnected(void);
+uint32_t ulHW_UsbWrite(const void* pvData, uint32_t ulLen);
+uint32_t ulHW_UsbRead(void* pvData, uint32_t ulLen);
+bool bHW_UsbIsDataAvailable(void);
+
+// Sensor bus
+bool bHW_I2cSubmit(I2CQ_XferTypeDef* psXfer);
+bool bHW_I2cSubmitBatch(I2CQ_BatchTypeDef* psBatch);
+void vHW_I2cGetStats(I2CQ_StatsTypeDef* psStats);
+
+// Pulse capture
+bool bHW_CaptureStart(void);
+void vHW_CaptureStop(void);
+bool bHW_CaptureGetBatch(CAPT_BatchTypeDef* psBatch, uint64_t* pullEdges);
+uint64_t ullHW_CaptureGetTime(void);
+uint32_t ulHW_CaptureGetClock(void);
+uint32_t ulHW_CaptureGetOverruns(void);
+
+// Waveform sequencer
+bool bHW_SeqStart(const HW_SEQ_ConfigTypeDef* psConfig, const SEQ_TableTypeDef* psTable);
+bool bHW_SeqStartStream(const HW_SEQ_ConfigTypeDef* psConfig, SEQ_RefillTypeDef pfnRefill, void* pvContext);
+bool bHW_SeqQueue(const SEQ_TableTypeDef* psTable);
+void vHW_SeqStop(void);
+bool bHW_SeqIsPlaying(void);
+uint32_t ulHW_SeqGetTop(uint32_t ulRate);
+void vHW_SeqGetStats(SEQ_StatsTypeDef* psStats);
+
+// Kernel
+void vHW_OsInit(void);
+bool bHW_ThreadCreate(HW_OS_ThreadTypeDef* psThread, const char* pcName,
+                      HW_OS_EntryTypeDef pfnEntry, void* pvArg,
+                      uint32_t* pulStack, uint32_t ulStackSize, uint8_t ucPriority);
+void vHW_OsStart(void);
+void vHW_Sleep(uint32_t ulMs);
+void vHW_SleepUntil(uint32_t* pulWakeTime, uint32_t ulPeriod);
+void vHW_SemInit(HW_OS_SemTypeDef* psSem, uint32_t ulCount, uint32_t ulMax);
+bool bHW_SemTake(HW_OS_SemTypeDef* psSem, uint32_t ulTimeout);
+bool bHW_SemGive(HW_OS_SemTypeDef* psSem);
+void vHW_MutexInit(HW_OS_MutexTypeDef* psMutex);
+bool bHW_MutexLock(HW_OS_MutexTypeDef* psMutex, uint32_t ulTimeout);
+bool bHW_MutexUnlock(HW_OS_MutexTypeDef* psMutex);
+
+// Trace
+void vHW_Trace(uint8_t ucStream, uint16_t uiId, uint32_t ulNumArgs, const uint32_t* pulArgs);
+void vHW_TraceBegin(uint16_t uiRegion);
+void vHW_TraceEnd(uint16_t uiRegion);
 
 // Core info
 uint32_t ulHW_GetCpuid(void);
+void vHW_PerfEnable(bool bEnable);
+void vHW_PerfStart(HW_PerfTypeDef* psPerf);
+void vHW_PerfSample(HW_PerfTypeDef* psPerf);
+void vHW_PerfGetMetrics(const HW_PerfTypeDef* psPerf, HW_PerfMetricsTypeDef* psMetrics);
+uint32_t ulHW_GetCycleCount(void);
+uint32_t ulHW_GetBootCycles(void);
+const char* pcHW_GetInitPath(void);
 uint16_t uiHW_GetFlashSize(void);
 const uint32_t* pulHW_GetUID();
 
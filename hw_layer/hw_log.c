@@ -0,0 +1,264 @@
+/*!****************************************************************************
+ * @file
+ * hw_log.c
+ *
+ * @brief
+ * Hardware Layer - Console log to external SPI NOR flash
+ *
+ * Keeps a copy of console output on an external 25-series SPI NOR flash, so
+ * that it survives without an attached probe. Output is collected in 256-byte
+ * pages (see norlog.c); while the CPU fills one page buffer, the other one is
+ * programmed by DMA (hw_spi). Sectors are erased ahead of the write position
+ * and the oldest data is overwritten when the device is full.
+ *
+ * The log is advanced by writers and by a 1 ms software timer, both inside a
+ * critical section. A writer that finds both page buffers in use waits for
+ * the flash (HW_LOG_BLOCKING) or drops the rest of its output.
+ *
+ * The dump sends the log, oldest page first, as raw bytes to ITM stimulus
+ * port HW_LOG_DUMP_PORT using 32-bit writes. Logging is suspended meanwhile.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <string.h>
+#include "stm32f1xx_hal.h"
+#include "hw_clk.h"
+#include "hw_irq.h"
+#include "hw_log.h"
+#include "hw_spi.h"
+#include "spinor.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Poll period in ms (page program takes ~0.7 ms)
+#define HW_LOG_POLL_PERIOD            1uL
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vHW_LOG_PollTimer(HW_CLK_TimerTypeDef* psTimer);
+static void vHW_LOG_DumpSink(const uint8_t* pucData, uint32_t ulLen, void* pvContext);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Bus driver
+static const SPINOR_BusTypeDef sBus = {
+  .pfnSelect = vHW_SPI_Select,
+  .pfnTransfer = vHW_SPI_Transfer,
+  .pfnWriteAsync = vHW_SPI_WriteAsync,
+  .pfnIsBusy = bHW_SPI_IsBusy
+};
+
+/// Device
+static SPINOR_TypeDef sNor;
+
+/// Log instance
+static NORLOG_TypeDef sLog;
+
+/// Poll timer
+static HW_CLK_TimerTypeDef sPollTimer;
+
+/// Log mounted
+static bool bReady;
+
+/// Logging suspended for flush or dump
+static volatile bool bSuspended;
+
+/// Bytes not logged
+static uint32_t ulDropped;
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Detect flash, mount log and start poll timer
+ *
+ * Requires the SPI driver and the system clock. Without a device, the log
+ * stays disabled and writes are ignored.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_LOG_Init(void)
+{
+  bReady = false;
+  if (!HW_LOG) return;
+
+  if (!bSPINOR_Init(&sNor, &sBus) || (sNor.ulSize <= HW_LOG_BASE)) return;
+  if (!bNORLOG_Mount(&sLog, &sNor, HW_LOG_BASE, sNor.ulSize - HW_LOG_BASE)) return;
+
+  bReady = true;
+  vHW_CLK_TimerInit(&sPollTimer, vHW_LOG_PollTimer, NULL);
+  vHW_CLK_TimerStart(&sPollTimer, HW_LOG_POLL_PERIOD, HW_LOG_POLL_PERIOD);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if the log is mounted
+ *
+ * @return  (bool)  Log available
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_LOG_IsReady(void)
+{
+  return bReady;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Append data to the log
+ *
+ * May be called from threads and interrupt handlers below CRITICAL level.
+ *
+ * @param[in] *pvData   Data
+ * @param[in] ulLen     Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_LOG_Write(const void* pvData, uint32_t ulLen)
+{
+  if (!bReady) return;
+
+  const uint8_t* pucData = (const uint8_t*)pvData;
+  while (ulLen != 0uL)
+  {
+    uint32_t ulLock = ulHW_IRQ_Lock();
+    uint32_t ulDone = 0uL;
+    bool bDrop = bSuspended;
+    if (!bDrop)
+    {
+      ulDone = ulNORLOG_Write(&sLog, pucData, ulLen);
+      if (ulDone < ulLen) vNORLOG_Poll(&sLog);
+      bDrop = (ulDone == 0uL) && !HW_LOG_BLOCKING;
+    }
+    if (bDrop) ulDropped += ulLen;
+    vHW_IRQ_Unlock(ulLock);
+
+    if (bDrop) return;
+    pucData += ulDone;
+    ulLen -= ulDone;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Program buffered data, including a partially filled page
+ *
+ * Each flush uses a page; flush before a reset, not after each line. Waits
+ * for the flash without holding the lock; output written meanwhile is
+ * dropped.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_LOG_Flush(void)
+{
+  if (!bReady) return;
+
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  bSuspended = true;
+  vHW_IRQ_Unlock(ulLock);
+
+  vNORLOG_Flush(&sLog);
+
+  bSuspended = false;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Send log contents to the debug probe
+ *
+ * Returns immediately if ITM or the dump port are disabled.
+ *
+ * @return  (uint32_t)  Number of bytes sent
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulHW_LOG_Dump(void)
+{
+  if (!bReady || ((ITM->TCR & ITM_TCR_ITMENA_Msk) == 0uL) ||
+      ((ITM->TER & (1uL << HW_LOG_DUMP_PORT)) == 0uL))
+  {
+    return 0uL;
+  }
+
+  // Stop writers and poll timer, then flush and read without holding the lock
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  bSuspended = true;
+  vHW_IRQ_Unlock(ulLock);
+
+  uint32_t ulBytes = ulNORLOG_Dump(&sLog, vHW_LOG_DumpSink, NULL);
+
+  bSuspended = false;
+  return ulBytes;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get log statistics
+ *
+ * @param[out] *psStats   Statistics
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_LOG_GetStats(HW_LOG_StatsTypeDef* psStats)
+{
+  (void)memset(psStats, 0, sizeof(*psStats));
+  psStats->ulDropped = ulDropped;
+  if (!bReady) return;
+
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  vNORLOG_GetStats(&sLog, &psStats->sFlash);
+  vHW_IRQ_Unlock(ulLock);
+  psStats->ulJedecId = sNor.ulJedecId;
+  psStats->ulSize = sLog.ulSize;
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Poll timer callback, advances programming and erasing
+ *
+ * @param[in] *psTimer  Timer
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_LOG_PollTimer(HW_CLK_TimerTypeDef* psTimer)
+{
+  (void)psTimer;
+
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  if (!bSuspended) vNORLOG_Poll(&sLog);
+  vHW_IRQ_Unlock(ulLock);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Dump output, writes page payload to the ITM dump port
+ *
+ * @param[in] *pucData    Payload
+ * @param[in] ulLen       Number of bytes
+ * @param[in] *pvContext  Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_LOG_DumpSink(const uint8_t* pucData, uint32_t ulLen, void* pvContext)
+{
+  (void)pvContext;
+
+  for (uint32_t i = 0uL; i < ulLen; )
+  {
+    while (ITM->PORT[HW_LOG_DUMP_PORT].u32 == 0uL)
+    {
+      __NOP();
+    }
+
+    if (ulLen - i >= 4uL)
+    {
+      uint32_t ulWord;
+      (void)memcpy(&ulWord, &pucData[i], sizeof(ulWord));
+      ITM->PORT[HW_LOG_DUMP_PORT].u32 = ulWord;
+      i += 4uL;
+    }
+    else
+    {
+      ITM->PORT[HW_LOG_DUMP_PORT].u8 = pucData[i];
+      i += 1uL;
+    }
+  }
+}
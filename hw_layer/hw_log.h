@@ -0,0 +1,60 @@
+/*!****************************************************************************
+ * @file
+ * hw_log.h
+ *
+ * @brief
+ * Hardware Layer - Console log to external SPI NOR flash
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef HW_LOG_H_
+#define HW_LOG_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "norlog.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Copy console output to the SPI NOR flash
+#ifndef HW_LOG
+#define HW_LOG                        1
+#endif
+
+/// Wait for a free page buffer instead of dropping output (up to one erase)
+#ifndef HW_LOG_BLOCKING
+#define HW_LOG_BLOCKING               1
+#endif
+
+/// Log region start address (the region extends to the end of the device)
+#ifndef HW_LOG_BASE
+#define HW_LOG_BASE                   0uL
+#endif
+
+/// ITM stimulus port of log dump
+#ifndef HW_LOG_DUMP_PORT
+#define HW_LOG_DUMP_PORT              5u
+#endif
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Log statistics
+typedef struct {
+  NORLOG_StatsTypeDef sFlash;     ///< Flash statistics since mount
+  uint32_t ulDropped;             ///< Bytes not logged (buffers full or dump running)
+  uint32_t ulJedecId;             ///< Manufacturer, memory type, capacity code
+  uint32_t ulSize;                ///< Region size in bytes, 0 if no device
+} HW_LOG_StatsTypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vHW_LOG_Init(void);
+bool bHW_LOG_IsReady(void);
+void vHW_LOG_Write(const void* pvData, uint32_t ulLen);
+void vHW_LOG_Flush(void);
+uint32_t ulHW_LOG_Dump(void);
+void vHW_LOG_GetStats(HW_LOG_StatsTypeDef* psStats);
+
+#endif // HW_LOG_H_
@@ -0,0 +1,214 @@
+/*!****************************************************************************
+ * @file
+ * hw_nvm.c
+ *
+ * @brief
+ * Hardware Layer - Non-volatile key-value storage in on-chip flash
+ *
+ * Flash driver for the log-structured key-value store (see kvstore.c) on the
+ * last HW_NVM_PAGES pages of flash. Each record is programmed in a single
+ * burst: the flash is unlocked and the PG bit set once, then half-words are
+ * written back to back, each one checked for programming errors and read
+ * back. Instruction fetches from flash stall while the flash is busy, so
+ * interrupts are delayed by up to one half-word program (~60 us) or page
+ * erase (~40 ms).
+ *
+ * The storage region must not overlap the firmware image; this is checked
+ * at runtime against the linker symbols, and storage stays disabled if it
+ * does.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include "stm32f1xx_hal.h"
+#include "hw_nvm.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Flash error flags
+#define HW_NVM_SR_ERRORS              (FLASH_SR_PGERR | FLASH_SR_WRPRTERR)
+
+_Static_assert((HW_NVM_BASE % HW_NVM_PAGE_SIZE) == 0uL, "NVM region must be page aligned");
+_Static_assert(HW_NVM_PAGES <= KVS_MAX_PAGES, "Too many NVM pages");
+
+
+/*- Private functions --------------------------------------------------------*/
+static bool bHW_NVM_Erase(uintptr_t ulAddr);
+static bool bHW_NVM_Program(uintptr_t ulAddr, const uint16_t* puiData, uint32_t ulCount);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Linker symbols: initialisation data in flash, data section in RAM
+extern uint32_t _sidata;
+extern uint32_t _sdata;
+extern uint32_t _edata;
+
+/// Store instance
+static KVS_TypeDef sKvs;
+
+/// Flash driver
+static const KVS_FlashTypeDef sFlash = {
+  .ulBase = HW_NVM_BASE,
+  .ulPageSize = HW_NVM_PAGE_SIZE,
+  .ulNumPages = HW_NVM_PAGES,
+  .pfnErase = bHW_NVM_Erase,
+  .pfnProgram = bHW_NVM_Program
+};
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise storage
+ *
+ * Mounts the store, repairing operations interrupted by power loss. An
+ * unusable region is formatted.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_NVM_Init(void)
+{
+  uintptr_t ulImageEnd = (uintptr_t)&_sidata + ((uintptr_t)&_edata - (uintptr_t)&_sdata);
+  uintptr_t ulFlashEnd = FLASH_BASE + ((uintptr_t)*(const uint16_t*)FLASHSIZE_BASE << 10);
+  if ((ulImageEnd > HW_NVM_BASE) || (HW_NVM_BASE + HW_NVM_PAGES * HW_NVM_PAGE_SIZE > ulFlashEnd))
+  {
+    return;
+  }
+
+  if (!bKVS_Mount(&sKvs, &sFlash))
+  {
+    (void)bKVS_Format(&sKvs, &sFlash);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if storage is usable
+ *
+ * @return  (bool)  Store is mounted
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_NVM_IsReady(void)
+{
+  return sKvs.bMounted;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Read value
+ *
+ * @param[in] uiKey     Key
+ * @param[out] *pvBuf   Buffer, receives up to ulSize bytes
+ * @param[in] ulSize    Buffer size
+ * @return  (int32_t)   Value length in bytes, -1 if not found
+ * @date  19.10.2026
+ ******************************************************************************/
+int32_t lHW_NVM_Get(uint16_t uiKey, void* pvBuf, uint32_t ulSize)
+{
+  return lKVS_Get(&sKvs, uiKey, pvBuf, ulSize);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Store value
+ *
+ * @param[in] uiKey     Key
+ * @param[in] *pvData   Value
+ * @param[in] ulLen     Value length (0..KVS_MAX_VALUE)
+ * @return  (bool)  Success
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_NVM_Put(uint16_t uiKey, const void* pvData, uint32_t ulLen)
+{
+  return bKVS_Put(&sKvs, uiKey, pvData, ulLen);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Delete key
+ *
+ * @param[in] uiKey     Key
+ * @return  (bool)  Success
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_NVM_Delete(uint16_t uiKey)
+{
+  return bKVS_Delete(&sKvs, uiKey);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get store statistics
+ *
+ * @param[out] *psStats   Statistics
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_NVM_GetStats(KVS_StatsTypeDef* psStats)
+{
+  vKVS_GetStats(&sKvs, psStats);
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Erase flash page
+ *
+ * @param[in] ulAddr  Page address
+ * @return  (bool)  Success, page reads back erased
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bHW_NVM_Erase(uintptr_t ulAddr)
+{
+  (void)HAL_FLASH_Unlock();
+  FLASH->SR = FLASH_SR_EOP | HW_NVM_SR_ERRORS;
+  FLASH->CR |= FLASH_CR_PER;
+  FLASH->AR = ulAddr;
+  FLASH->CR |= FLASH_CR_STRT;
+  while ((FLASH->SR & FLASH_SR_BSY) != 0uL) {}
+  FLASH->CR &= ~FLASH_CR_PER;
+  (void)HAL_FLASH_Lock();
+
+  bool bOk = (FLASH->SR & HW_NVM_SR_ERRORS) == 0uL;
+  const uint32_t* pulPage = (const uint32_t*)ulAddr;
+  for (uint32_t i = 0uL; bOk && (i < HW_NVM_PAGE_SIZE / 4u); ++i)
+  {
+    bOk = pulPage[i] == 0xFFFFFFFFuL;
+  }
+  return bOk;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Program half-words in one burst
+ *
+ * @param[in] ulAddr      Destination address (half-word aligned)
+ * @param[in] *puiData    Data, may be in flash
+ * @param[in] ulCount     Number of half-words
+ * @return  (bool)  Success, data reads back correctly
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bHW_NVM_Program(uintptr_t ulAddr, const uint16_t* puiData, uint32_t ulCount)
+{
+  volatile uint16_t* puiDst = (volatile uint16_t*)ulAddr;
+  bool bOk = true;
+
+  (void)HAL_FLASH_Unlock();
+  FLASH->SR = FLASH_SR_EOP | HW_NVM_SR_ERRORS;
+  FLASH->CR |= FLASH_CR_PG;
+  for (uint32_t i = 0uL; i < ulCount; ++i)
+  {
+    uint16_t uiData = puiData[i];
+    puiDst[i] = uiData;
+    while ((FLASH->SR & FLASH_SR_BSY) != 0uL) {}
+    if (((FLASH->SR & HW_NVM_SR_ERRORS) != 0uL) || (puiDst[i] != uiData))
+    {
+      bOk = false;
+      break;
+    }
+  }
+  FLASH->CR &= ~FLASH_CR_PG;
+  (void)HAL_FLASH_Lock();
+  return bOk;
+}
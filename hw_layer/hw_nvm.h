@@ -0,0 +1,43 @@
+/*!****************************************************************************
+ * @file
+ * hw_nvm.h
+ *
+ * @brief
+ * Hardware Layer - Non-volatile key-value storage in on-chip flash
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef HW_NVM_H_
+#define HW_NVM_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "kvstore.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Number of flash pages reserved for storage (at the end of flash)
+#ifndef HW_NVM_PAGES
+#define HW_NVM_PAGES                  4u
+#endif
+
+/// Flash page size in bytes
+#define HW_NVM_PAGE_SIZE              0x400uL
+
+/// Start address of storage region (64 KB device)
+#ifndef HW_NVM_BASE
+#define HW_NVM_BASE                   (0x08010000uL - HW_NVM_PAGES * HW_NVM_PAGE_SIZE)
+#endif
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vHW_NVM_Init(void);
+bool bHW_NVM_IsReady(void);
+int32_t lHW_NVM_Get(uint16_t uiKey, void* pvBuf, uint32_t ulSize);
+bool bHW_NVM_Put(uint16_t uiKey, const void* pvData, uint32_t ulLen);
+bool bHW_NVM_Delete(uint16_t uiKey);
+void vHW_NVM_GetStats(KVS_StatsTypeDef* psStats);
+
+#endif // HW_NVM_H_
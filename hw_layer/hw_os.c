@@ -0,0 +1,1302 @@
+/*!****************************************************************************
+ * @file
+ * hw_os.c
+ *
+ * @brief
+ * Hardware Layer - Preemptive priority-based kernel
+ *
+ * The highest-priority ready thread runs; threads of equal priority take
+ * turns when the running one yields or blocks. Each priority has a FIFO
+ * ready list, a bitmap of non-empty lists gives the next thread with a
+ * single CLZ. The running thread stays at the head of its ready list.
+ *
+ * vHW_OS_Start() enters the kernel through SVC, which saves the caller's
+ * context on the main stack and switches to the first thread on the process
+ * stack. Kernel objects request a context switch by pending PendSV, which
+ * runs at lowest priority after all other interrupts and swaps the callee-
+ * saved registers. vHW_OS_Stop() returns from vHW_OS_Start() the same way.
+ * Interrupts keep using the main stack.
+ *
+ * Stacks are filled with a pattern for usage measurement and end in guard
+ * words. On every switch, the outgoing thread's stack pointer and guard are
+ * checked (the STM32F103 has no MPU); an overflow is recorded in the flight
+ * recorder and trapped, so that the fault dump shows it after the reset.
+ *
+ * Mutexes use priority inheritance: the owner runs at the priority of its
+ * highest waiter, transitively along chains of owners waiting for other
+ * mutexes. Semaphores and queues hand over directly to the highest-priority
+ * waiter, so a woken thread never finds the object taken again.
+ *
+ * Timeouts and delays use system time (ulHW_GetTime(), milliseconds) and are
+ * kept in a list sorted by expiry, which is checked from SysTick. The idle
+ * thread runs when no thread is ready and sleeps with SysTick suppressed up
+ * to the next expiry (HW_OS_TICKLESS).
+ *
+ * Kernel state is protected by short, bounded hw_irq critical sections
+ * (BASEPRI), so interrupts at CRITICAL level are never delayed by the kernel
+ * and must not call it. Blocking calls must be made from threads outside
+ * critical sections.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "stm32f1xx_hal.h"
+#include "hw_clk.h"
+#include "hw_flight.h"
+#include "hw_irq.h"
+#include "hw_os.h"
+#include "hw_trace.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Stack guard pattern
+#define HW_OS_GUARD_PATTERN           0xDEADBEEFuL
+
+/// Fill pattern of unused stack
+#define HW_OS_FILL_PATTERN            0xA5A5A5A5uL
+
+/// Initial xPSR (Thumb state)
+#define HW_OS_INITIAL_XPSR            0x01000000uL
+
+/// Initial frame size in words (saved context, exception frame)
+#define HW_OS_FRAME_WORDS             16u
+
+/*! @brief Initial frame word indices
+ *  @{                                                                        */
+#define HW_OS_FRAME_R0                8u
+#define HW_OS_FRAME_LR                13u
+#define HW_OS_FRAME_PC                14u
+#define HW_OS_FRAME_XPSR              15u
+/*! @}                                                                        */
+
+/// Idle thread stack in words
+#define HW_OS_IDLE_STACK_WORDS        (HW_OS_MIN_STACK_WORDS + 48u)
+
+_Static_assert((HW_OS_PRIORITIES >= 1u) && (HW_OS_PRIORITIES <= 32u), "HW_OS_PRIORITIES must be 1..32");
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Ready lists per priority
+static HW_OS_ListTypeDef asReady[HW_OS_PRIORITIES];
+
+/// Bitmap of non-empty ready lists
+static volatile uint32_t ulReadyMask;
+
+/// Running thread
+static HW_OS_ThreadTypeDef* volatile psCurrent;
+
+/// Threads with timeout, sorted by expiry
+static HW_OS_ThreadTypeDef* psSleepHead;
+
+/// Idle thread
+static HW_OS_ThreadTypeDef sIdle;
+static uint32_t aulIdleStack[HW_OS_IDLE_STACK_WORDS];
+
+/// Kernel state
+static volatile bool bRunning;
+static volatile bool bStopRequest;
+
+/// Saved context of vHW_OS_Start() caller
+static uint32_t* pulMainSp;
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vHW_OS_Prepare(HW_OS_ThreadTypeDef* psThread, const char* pcName,
+                           HW_OS_EntryTypeDef pfnEntry, void* pvArg,
+                           uint32_t* pulStack, uint32_t ulWords, uint8_t ucPriority);
+static void vHW_OS_Exit(void);
+static void vHW_OS_IdleThread(void* pvArg);
+static void vHW_OS_ListAppend(HW_OS_ListTypeDef* psList, HW_OS_ThreadTypeDef* psThread);
+static void vHW_OS_ListPrepend(HW_OS_ListTypeDef* psList, HW_OS_ThreadTypeDef* psThread);
+static void vHW_OS_ListInsert(HW_OS_ListTypeDef* psList, HW_OS_ThreadTypeDef* psThread);
+static void vHW_OS_ListRemove(HW_OS_ThreadTypeDef* psThread);
+static void vHW_OS_Ready(HW_OS_ThreadTypeDef* psThread, bool bFront);
+static void vHW_OS_Unready(HW_OS_ThreadTypeDef* psThread);
+static void vHW_OS_SleepInsert(HW_OS_ThreadTypeDef* psThread, uint32_t ulTimeout);
+static void vHW_OS_SleepRemove(HW_OS_ThreadTypeDef* psThread);
+static void vHW_OS_Block(HW_OS_ListTypeDef* psWaitList, uint32_t ulTimeout);
+static void vHW_OS_Wake(HW_OS_ThreadTypeDef* psThread, bool bTimedOut);
+static void vHW_OS_SetPrio(HW_OS_ThreadTypeDef* psThread, uint8_t ucPrio);
+static void vHW_OS_UpdatePrio(HW_OS_ThreadTypeDef* psThread);
+static void vHW_OS_Preempt(void);
+static void vHW_OS_CheckStack(const HW_OS_ThreadTypeDef* psThread);
+static uint32_t ulHW_OS_GetIdleTicks(void);
+
+// Referenced from assembly only, must keep their names with LTO
+__attribute__((used, externally_visible))
+uint32_t* pulHW_OS_Launch(uint32_t* pulSp);
+__attribute__((used, externally_visible))
+uint32_t* pulHW_OS_Switch(uint32_t* pulSp);
+__attribute__((used, externally_visible))
+uint32_t* pulHW_OS_GetMainSp(void);
+
+/*!****************************************************************************
+ * @brief
+ * Enter kernel critical section
+ *
+ * @return  (uint32_t)  Previous lock state
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline uint32_t ulHW_OS_Lock(void)
+{
+  return ulHW_IRQ_Lock();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Leave kernel critical section
+ *
+ * A context switch requested inside the section is taken here.
+ *
+ * @param[in] ulLock    Lock state returned by ulHW_OS_Lock()
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline void vHW_OS_Unlock(uint32_t ulLock)
+{
+  vHW_IRQ_Unlock(ulLock);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Request context switch
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline void vHW_OS_RequestSwitch(void)
+{
+  SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check for interrupt context
+ *
+ * @return  (bool)  Called from an exception handler
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline bool bHW_OS_InIsr(void)
+{
+  return __get_IPSR() != 0uL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get highest-priority ready thread
+ *
+ * @return  (HW_OS_ThreadTypeDef*)  Thread, idle thread if none is ready
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline HW_OS_ThreadTypeDef* psHW_OS_GetNext(void)
+{
+  uint32_t ulMask = ulReadyMask;
+  return (ulMask != 0uL) ? asReady[31uL - __CLZ(ulMask)].psHead : &sIdle;
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise kernel
+ *
+ * Forgets all threads. Must not be called while the kernel runs.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_OS_Init(void)
+{
+  for (uint32_t i = 0uL; i < HW_OS_PRIORITIES; ++i)
+  {
+    asReady[i].psHead = NULL;
+    asReady[i].psTail = NULL;
+  }
+  ulReadyMask = 0uL;
+  psCurrent = NULL;
+  psSleepHead = NULL;
+  bRunning = false;
+  bStopRequest = false;
+
+  vHW_OS_Prepare(&sIdle, "idle", vHW_OS_IdleThread, NULL,
+                 aulIdleStack, HW_OS_IDLE_STACK_WORDS, 0u);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Create thread
+ *
+ * The thread is ready immediately; if the kernel runs and the new thread has
+ * a higher priority, it preempts the caller. A thread that returns from its
+ * entry function is terminated.
+ *
+ * @param[out] *psThread    Thread control block
+ * @param[in] *pcName       Name
+ * @param[in] pfnEntry      Entry function
+ * @param[in] *pvArg        Entry function argument
+ * @param[out] *pulStack    Stack memory
+ * @param[in] ulStackSize   Stack size in bytes
+ * @param[in] ucPriority    Priority, 0 is lowest
+ * @return  (bool)        false if priority or stack size are invalid
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_OS_ThreadCreate(HW_OS_ThreadTypeDef* psThread, const char* pcName,
+                         HW_OS_EntryTypeDef pfnEntry, void* pvArg,
+                         uint32_t* pulStack, uint32_t ulStackSize, uint8_t ucPriority)
+{
+  uint32_t ulWords = ulStackSize / sizeof(uint32_t);
+  if ((ucPriority >= HW_OS_PRIORITIES) || (ulWords < HW_OS_MIN_STACK_WORDS)) return false;
+
+  vHW_OS_Prepare(psThread, pcName, pfnEntry, pvArg, pulStack, ulWords, ucPriority);
+#if HW_TRACE_TIMELINE
+  vHW_TRACE_ThreadName(psThread, pcName);
+#endif
+
+  uint32_t ulLock = ulHW_OS_Lock();
+  vHW_OS_Ready(psThread, false);
+  vHW_OS_Preempt();
+  vHW_OS_Unlock(ulLock);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start kernel
+ *
+ * Switches to the highest-priority thread. Must be called from thread mode
+ * with interrupts enabled. Returns after vHW_OS_Stop().
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_OS_Start(void)
+{
+  if (bRunning) return;
+  __asm volatile("svc 0" ::: "memory");
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stop kernel
+ *
+ * Returns to the caller of vHW_OS_Start(). Threads keep their state, but the
+ * kernel must be initialised again before the next start. Threads only.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_OS_Stop(void)
+{
+  uint32_t ulLock = ulHW_OS_Lock();
+  bStopRequest = true;
+  vHW_OS_RequestSwitch();
+  vHW_OS_Unlock(ulLock);
+
+  while (1)
+  {
+    __NOP();
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if kernel is running
+ *
+ * @return  (bool)  Kernel running
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_OS_IsRunning(void)
+{
+  return bRunning;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get running thread
+ *
+ * @return  (HW_OS_ThreadTypeDef*)  Running thread, NULL if kernel is stopped
+ * @date  19.10.2026
+ ******************************************************************************/
+HW_OS_ThreadTypeDef* psHW_OS_GetCurrent(void)
+{
+  return psCurrent;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get unused stack of a thread
+ *
+ * Counts words above the guard that still hold the fill pattern.
+ *
+ * @param[in] *psThread   Thread
+ * @return  (uint32_t)  Stack never used so far in bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulHW_OS_GetStackFree(const HW_OS_ThreadTypeDef* psThread)
+{
+  uint32_t ulFree = 0uL;
+  for (uint32_t i = HW_OS_GUARD_WORDS; i < psThread->ulStackWords; ++i)
+  {
+    if (psThread->pulStack[i] != HW_OS_FILL_PATTERN) break;
+    ulFree++;
+  }
+  return ulFree * sizeof(uint32_t);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Let other ready threads of the same priority run
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_OS_Yield(void)
+{
+  uint32_t ulLock = ulHW_OS_Lock();
+  HW_OS_ThreadTypeDef* psThread = psCurrent;
+  if (bRunning && (psThread != &sIdle))
+  {
+    vHW_OS_ListRemove(psThread);
+    vHW_OS_ListAppend(&asReady[psThread->ucPrio], psThread);
+    vHW_OS_RequestSwitch();
+  }
+  vHW_OS_Unlock(ulLock);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Suspend running thread for a time
+ *
+ * The delay ends on the ulMs-th system time tick, i.e. after ulMs - 1 to
+ * ulMs milliseconds.
+ *
+ * @param[in] ulMs  Delay in milliseconds, 0 yields
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_OS_Delay(uint32_t ulMs)
+{
+  if (ulMs == 0uL)
+  {
+    vHW_OS_Yield();
+    return;
+  }
+
+  uint32_t ulLock = ulHW_OS_Lock();
+  if (bRunning) vHW_OS_Block(NULL, ulMs);
+  vHW_OS_Unlock(ulLock);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Suspend running thread until the next period
+ *
+ * For periodic threads without drift. If the next period has already begun,
+ * returns after yielding.
+ *
+ * @param[in,out] *pulWakeTime  Previous wake time, advanced by one period
+ * @param[in] ulPeriod          Period in milliseconds
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_OS_DelayUntil(uint32_t* pulWakeTime, uint32_t ulPeriod)
+{
+  *pulWakeTime += ulPeriod;
+  int32_t lDelay = (int32_t)(*pulWakeTime - ulHW_CLK_GetTime());
+  vHW_OS_Delay((lDelay > 0L) ? (uint32_t)lDelay : 0uL);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Initialise mutex
+ *
+ * @param[out] *psMutex   Mutex
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_OS_MutexInit(HW_OS_MutexTypeDef* psMutex)
+{
+  psMutex->psOwner = NULL;
+  psMutex->ulCount = 0uL;
+  psMutex->sWaiters.psHead = NULL;
+  psMutex->sWaiters.psTail = NULL;
+  psMutex->psNextHeld = NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Lock mutex
+ *
+ * May be locked recursively by its owner. While waiting, the owner inherits
+ * the caller's priority.
+ *
+ * @param[in,out] *psMutex  Mutex
+ * @param[in] ulTimeout     Timeout in milliseconds, or HW_OS_NO_WAIT /
+ *                          HW_OS_WAIT_FOREVER
+ * @return  (bool)        Mutex locked, false on timeout
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_OS_MutexLock(HW_OS_MutexTypeDef* psMutex, uint32_t ulTimeout)
+{
+  uint32_t ulLock = ulHW_OS_Lock();
+  HW_OS_ThreadTypeDef* psThread = psCurrent;
+
+  if (!bRunning || bHW_OS_InIsr())
+  {
+    vHW_OS_Unlock(ulLock);
+    return false;
+  }
+  if (psMutex->psOwner == NULL)
+  {
+    psMutex->psOwner = psThread;
+    psMutex->ulCount = 1uL;
+    psMutex->psNextHeld = psThread->psMutexes;
+    psThread->psMutexes = psMutex;
+    vHW_OS_Unlock(ulLock);
+    return true;
+  }
+  if (psMutex->psOwner == psThread)
+  {
+    psMutex->ulCount++;
+    vHW_OS_Unlock(ulLock);
+    return true;
+  }
+  if (ulTimeout == HW_OS_NO_WAIT)
+  {
+    vHW_OS_Unlock(ulLock);
+    return false;
+  }
+
+  psThread->psWaitMutex = psMutex;
+  vHW_OS_Block(&psMutex->sWaiters, ulTimeout);
+  vHW_OS_UpdatePrio(psMutex->psOwner);
+  vHW_OS_Unlock(ulLock);
+
+  // Ownership was handed over on wake-up
+  return !psThread->bTimedOut;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Unlock mutex
+ *
+ * On the last unlock, ownership passes to the highest-priority waiter and
+ * inherited priority is dropped.
+ *
+ * @param[in,out] *psMutex  Mutex
+ * @return  (bool)        false if caller is not the owner
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_OS_MutexUnlock(HW_OS_MutexTypeDef* psMutex)
+{
+  uint32_t ulLock = ulHW_OS_Lock();
+  HW_OS_ThreadTypeDef* psThread = psCurrent;
+
+  if (!bRunning || (psMutex->psOwner != psThread))
+  {
+    vHW_OS_Unlock(ulLock);
+    return false;
+  }
+  if (--psMutex->ulCount != 0uL)
+  {
+    vHW_OS_Unlock(ulLock);
+    return true;
+  }
+
+  // Remove from held mutexes
+  HW_OS_MutexTypeDef** ppsLink = &psThread->psMutexes;
+  while (*ppsLink != psMutex)
+  {
+    ppsLink = &(*ppsLink)->psNextHeld;
+  }
+  *ppsLink = psMutex->psNextHeld;
+  psMutex->psOwner = NULL;
+
+  // Hand over to highest-priority waiter
+  HW_OS_ThreadTypeDef* psWaiter = psMutex->sWaiters.psHead;
+  if (psWaiter != NULL)
+  {
+    psWaiter->psWaitMutex = NULL;
+    vHW_OS_Wake(psWaiter, false);
+    psMutex->psOwner = psWaiter;
+    psMutex->ulCount = 1uL;
+    psMutex->psNextHeld = psWaiter->psMutexes;
+    psWaiter->psMutexes = psMutex;
+    vHW_OS_UpdatePrio(psWaiter);
+  }
+
+  vHW_OS_UpdatePrio(psThread);
+  vHW_OS_Preempt();
+  vHW_OS_Unlock(ulLock);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Initialise semaphore
+ *
+ * @param[out] *psSem   Semaphore
+ * @param[in] ulCount   Initial count
+ * @param[in] ulMax     Maximum count
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_OS_SemInit(HW_OS_SemTypeDef* psSem, uint32_t ulCount, uint32_t ulMax)
+{
+  psSem->ulCount = ulCount;
+  psSem->ulMax = ulMax;
+  psSem->sWaiters.psHead = NULL;
+  psSem->sWaiters.psTail = NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Take semaphore
+ *
+ * From interrupts and before the kernel is started, never waits.
+ *
+ * @param[in,out] *psSem  Semaphore
+ * @param[in] ulTimeout   Timeout in milliseconds, or HW_OS_NO_WAIT /
+ *                        HW_OS_WAIT_FOREVER
+ * @return  (bool)      Semaphore taken, false on timeout
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_OS_SemTake(HW_OS_SemTypeDef* psSem, uint32_t ulTimeout)
+{
+  uint32_t ulLock = ulHW_OS_Lock();
+  if (psSem->ulCount != 0uL)
+  {
+    psSem->ulCount--;
+    vHW_OS_Unlock(ulLock);
+    return true;
+  }
+  if ((ulTimeout == HW_OS_NO_WAIT) || !bRunning || bHW_OS_InIsr())
+  {
+    vHW_OS_Unlock(ulLock);
+    return false;
+  }
+
+  HW_OS_ThreadTypeDef* psThread = psCurrent;
+  vHW_OS_Block(&psSem->sWaiters, ulTimeout);
+  vHW_OS_Unlock(ulLock);
+  return !psThread->bTimedOut;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Give semaphore
+ *
+ * May be called from interrupts.
+ *
+ * @param[in,out] *psSem  Semaphore
+ * @return  (bool)      false if maximum count is reached
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_OS_SemGive(HW_OS_SemTypeDef* psSem)
+{
+  bool bGiven = true;
+  uint32_t ulLock = ulHW_OS_Lock();
+  if (psSem->sWaiters.psHead != NULL)
+  {
+    vHW_OS_Wake(psSem->sWaiters.psHead, false);
+  }
+  else if (psSem->ulCount < psSem->ulMax)
+  {
+    psSem->ulCount++;
+  }
+  else
+  {
+    bGiven = false;
+  }
+  vHW_OS_Unlock(ulLock);
+  return bGiven;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Initialise message queue
+ *
+ * @param[out] *psQueue   Queue
+ * @param[out] *pvBuf     Item storage of ulItemSize * ulLength bytes
+ * @param[in] ulItemSize  Item size in bytes
+ * @param[in] ulLength    Capacity in items (min. 1)
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_OS_QueueInit(HW_OS_QueueTypeDef* psQueue, void* pvBuf,
+                      uint32_t ulItemSize, uint32_t ulLength)
+{
+  psQueue->pucBuf = (uint8_t*)pvBuf;
+  psQueue->ulItemSize = ulItemSize;
+  psQueue->ulLength = ulLength;
+  psQueue->ulHead = 0uL;
+  psQueue->ulCount = 0uL;
+  psQueue->sSenders.psHead = NULL;
+  psQueue->sSenders.psTail = NULL;
+  psQueue->sReceivers.psHead = NULL;
+  psQueue->sReceivers.psTail = NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Send item to queue
+ *
+ * The item is copied. From interrupts and before the kernel is started,
+ * never waits.
+ *
+ * @param[in,out] *psQueue  Queue
+ * @param[in] *pvItem       Item
+ * @param[in] ulTimeout     Timeout in milliseconds, or HW_OS_NO_WAIT /
+ *                          HW_OS_WAIT_FOREVER
+ * @return  (bool)        Item sent, false if queue stayed full
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_OS_QueueSend(HW_OS_QueueTypeDef* psQueue, const void* pvItem, uint32_t ulTimeout)
+{
+  uint32_t ulLock = ulHW_OS_Lock();
+
+  // Hand over to waiting receiver
+  HW_OS_ThreadTypeDef* psReceiver = psQueue->sReceivers.psHead;
+  if (psReceiver != NULL)
+  {
+    (void)memcpy(psReceiver->pvMsg, pvItem, psQueue->ulItemSize);
+    vHW_OS_Wake(psReceiver, false);
+    vHW_OS_Unlock(ulLock);
+    return true;
+  }
+
+  if (psQueue->ulCount < psQueue->ulLength)
+  {
+    uint32_t ulIdx = (psQueue->ulHead + psQueue->ulCount) % psQueue->ulLength;
+    (void)memcpy(&psQueue->pucBuf[ulIdx * psQueue->ulItemSize], pvItem, psQueue->ulItemSize);
+    psQueue->ulCount++;
+    vHW_OS_Unlock(ulLock);
+    return true;
+  }
+
+  if ((ulTimeout == HW_OS_NO_WAIT) || !bRunning || bHW_OS_InIsr())
+  {
+    vHW_OS_Unlock(ulLock);
+    return false;
+  }
+
+  // Receiver copies the item when it makes space
+  HW_OS_ThreadTypeDef* psThread = psCurrent;
+  psThread->pvMsg = (void*)pvItem;
+  vHW_OS_Block(&psQueue->sSenders, ulTimeout);
+  vHW_OS_Unlock(ulLock);
+  return !psThread->bTimedOut;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Receive item from queue
+ *
+ * From interrupts and before the kernel is started, never waits.
+ *
+ * @param[in,out] *psQueue  Queue
+ * @param[out] *pvItem      Item buffer
+ * @param[in] ulTimeout     Timeout in milliseconds, or HW_OS_NO_WAIT /
+ *                          HW_OS_WAIT_FOREVER
+ * @return  (bool)        Item received, false if queue stayed empty
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_OS_QueueReceive(HW_OS_QueueTypeDef* psQueue, void* pvItem, uint32_t ulTimeout)
+{
+  uint32_t ulLock = ulHW_OS_Lock();
+
+  if (psQueue->ulCount != 0uL)
+  {
+    uint32_t ulSize = psQueue->ulItemSize;
+    (void)memcpy(pvItem, &psQueue->pucBuf[psQueue->ulHead * ulSize], ulSize);
+    psQueue->ulHead = (psQueue->ulHead + 1uL) % psQueue->ulLength;
+    psQueue->ulCount--;
+
+    // Take over item of waiting sender
+    HW_OS_ThreadTypeDef* psSender = psQueue->sSenders.psHead;
+    if (psSender != NULL)
+    {
+      uint32_t ulIdx = (psQueue->ulHead + psQueue->ulCount) % psQueue->ulLength;
+      (void)memcpy(&psQueue->pucBuf[ulIdx * ulSize], psSender->pvMsg, ulSize);
+      psQueue->ulCount++;
+      vHW_OS_Wake(psSender, false);
+    }
+    vHW_OS_Unlock(ulLock);
+    return true;
+  }
+
+  if ((ulTimeout == HW_OS_NO_WAIT) || !bRunning || bHW_OS_InIsr())
+  {
+    vHW_OS_Unlock(ulLock);
+    return false;
+  }
+
+  // Sender copies the item directly
+  HW_OS_ThreadTypeDef* psThread = psCurrent;
+  psThread->pvMsg = pvItem;
+  vHW_OS_Block(&psQueue->sReceivers, ulTimeout);
+  vHW_OS_Unlock(ulLock);
+  return !psThread->bTimedOut;
+}
+
+/*!****************************************************************************
+ * @brief
+ * System time tick: wake threads whose timeout expired
+ *
+ * Must be called from SysTick after the system time has been advanced.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_OS_TickHandler(void)
+{
+  if (!bRunning) return;
+
+  uint32_t ulLock = ulHW_OS_Lock();
+  uint32_t ulNow = ulHW_CLK_GetTime();
+  while ((psSleepHead != NULL) && ((int32_t)(ulNow - psSleepHead->ulWakeTime) >= 0L))
+  {
+    vHW_OS_Wake(psSleepHead, true);
+  }
+  vHW_OS_Unlock(ulLock);
+}
+
+/*!****************************************************************************
+ * @brief
+ * SVC handler: start first thread
+ *
+ * Must be branched to from SVC_Handler. Saves the callee-saved registers of
+ * the vHW_OS_Start() caller on the main stack.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+__attribute__((naked, used, externally_visible))
+void vHW_OS_SvcHandler(void)
+{
+  __asm volatile(
+    "  stmdb sp!, {r4-r11}            \n"   // Save context of caller
+    "  mov   r0, sp                   \n"
+    "  bl    pulHW_OS_Launch          \n"
+    "  ldmia r0!, {r4-r11}            \n"   // Restore context of first thread
+    "  msr   psp, r0                  \n"
+    "  isb                            \n"
+    "  mvn   lr, #2                   \n"   // EXC_RETURN: thread mode, PSP
+    "  bx    lr                       \n"
+  );
+}
+
+/*!****************************************************************************
+ * @brief
+ * PendSV handler: switch context
+ *
+ * Must be branched to from PendSV_Handler.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+__attribute__((naked, used, externally_visible))
+void vHW_OS_PendSvHandler(void)
+{
+  __asm volatile(
+    "  mrs   r0, psp                  \n"
+    "  isb                            \n"
+    "  stmdb r0!, {r4-r11}            \n"   // Save context of current thread
+    "  push  {r3, lr}                 \n"
+    "  bl    pulHW_OS_Switch          \n"
+    "  pop   {r3, lr}                 \n"
+    "  cbz   r0, 1f                   \n"
+    "  ldmia r0!, {r4-r11}            \n"   // Restore context of next thread
+    "  msr   psp, r0                  \n"
+    "  isb                            \n"
+    "  bx    lr                       \n"
+    "1:                               \n"   // Stopped: return to vHW_OS_Start()
+    "  bl    pulHW_OS_GetMainSp       \n"
+    "  ldmia r0!, {r4-r11}            \n"
+    "  msr   msp, r0                  \n"
+    "  isb                            \n"
+    "  mvn   lr, #6                   \n"   // EXC_RETURN: thread mode, MSP
+    "  bx    lr                       \n"
+  );
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise thread control block and stack
+ *
+ * @param[out] *psThread    Thread control block
+ * @param[in] *pcName       Name
+ * @param[in] pfnEntry      Entry function
+ * @param[in] *pvArg        Entry function argument
+ * @param[out] *pulStack    Stack memory
+ * @param[in] ulWords       Stack size in words
+ * @param[in] ucPriority    Priority
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_OS_Prepare(HW_OS_ThreadTypeDef* psThread, const char* pcName,
+                           HW_OS_EntryTypeDef pfnEntry, void* pvArg,
+                           uint32_t* pulStack, uint32_t ulWords, uint8_t ucPriority)
+{
+  for (uint32_t i = 0uL; i < ulWords; ++i)
+  {
+    pulStack[i] = (i < HW_OS_GUARD_WORDS) ? HW_OS_GUARD_PATTERN : HW_OS_FILL_PATTERN;
+  }
+
+  // Initial frame as if the thread had been switched out before its entry
+  uint32_t* pulTop = (uint32_t*)((uintptr_t)&pulStack[ulWords] & ~(uintptr_t)0x7u);
+  uint32_t* pulSp = pulTop - HW_OS_FRAME_WORDS;
+  for (uint32_t i = 0uL; i < HW_OS_FRAME_WORDS; ++i)
+  {
+    pulSp[i] = 0uL;
+  }
+  pulSp[HW_OS_FRAME_R0] = (uint32_t)(uintptr_t)pvArg;
+  pulSp[HW_OS_FRAME_LR] = (uint32_t)(uintptr_t)vHW_OS_Exit;
+  pulSp[HW_OS_FRAME_PC] = (uint32_t)(uintptr_t)pfnEntry & ~1uL;
+  pulSp[HW_OS_FRAME_XPSR] = HW_OS_INITIAL_XPSR;
+
+  psThread->pulSp = pulSp;
+  psThread->pulStack = pulStack;
+  psThread->ulStackWords = ulWords;
+  psThread->pcName = pcName;
+  psThread->psNext = NULL;
+  psThread->psPrev = NULL;
+  psThread->psList = NULL;
+  psThread->psSleepNext = NULL;
+  psThread->ulWakeTime = 0uL;
+  psThread->bSleeping = false;
+  psThread->bTimedOut = false;
+  psThread->ucBasePrio = ucPriority;
+  psThread->ucPrio = ucPriority;
+  psThread->eState = HW_OS_STATE_BLOCKED;
+  psThread->psWaitMutex = NULL;
+  psThread->psMutexes = NULL;
+  psThread->pvMsg = NULL;
+  psThread->ulSwitches = 0uL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Terminate running thread (return address of entry functions)
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_OS_Exit(void)
+{
+  uint32_t ulLock = ulHW_OS_Lock();
+  HW_OS_ThreadTypeDef* psThread = psCurrent;
+  vHW_OS_Unready(psThread);
+  psThread->eState = HW_OS_STATE_DEAD;
+  vHW_OS_RequestSwitch();
+  vHW_OS_Unlock(ulLock);
+
+  while (1)
+  {
+    __NOP();
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Idle thread: sleep until the next interrupt
+ *
+ * @param[in] *pvArg  Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_OS_IdleThread(void* pvArg)
+{
+  (void)pvArg;
+  while (1)
+  {
+    // Interrupts making a thread ready must wake us up before sleeping; WFI
+    // wakes on interrupts masked by PRIMASK but not on those masked by BASEPRI
+    __disable_irq();
+    if (ulReadyMask == 0uL)
+    {
+#if HW_OS_TICKLESS
+      vHW_CLK_Sleep(ulHW_OS_GetIdleTicks());
+#else
+      vHW_CLK_Sleep(0uL);
+#endif
+    }
+    __enable_irq();
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Append thread to list
+ *
+ * @param[in,out] *psList     List
+ * @param[in,out] *psThread   Unlinked thread
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_OS_ListAppend(HW_OS_ListTypeDef* psList, HW_OS_ThreadTypeDef* psThread)
+{
+  psThread->psNext = NULL;
+  psThread->psPrev = psList->psTail;
+  if (psList->psTail != NULL) psList->psTail->psNext = psThread;
+  else psList->psHead = psThread;
+  psList->psTail = psThread;
+  psThread->psList = psList;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Prepend thread to list
+ *
+ * @param[in,out] *psList     List
+ * @param[in,out] *psThread   Unlinked thread
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_OS_ListPrepend(HW_OS_ListTypeDef* psList, HW_OS_ThreadTypeDef* psThread)
+{
+  psThread->psPrev = NULL;
+  psThread->psNext = psList->psHead;
+  if (psList->psHead != NULL) psList->psHead->psPrev = psThread;
+  else psList->psTail = psThread;
+  psList->psHead = psThread;
+  psThread->psList = psList;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Insert thread into wait list, behind threads of higher or equal priority
+ *
+ * @param[in,out] *psList     List
+ * @param[in,out] *psThread   Unlinked thread
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_OS_ListInsert(HW_OS_ListTypeDef* psList, HW_OS_ThreadTypeDef* psThread)
+{
+  HW_OS_ThreadTypeDef* psPos = psList->psHead;
+  while ((psPos != NULL) && (psPos->ucPrio >= psThread->ucPrio))
+  {
+    psPos = psPos->psNext;
+  }
+  if (psPos == NULL)
+  {
+    vHW_OS_ListAppend(psList, psThread);
+    return;
+  }
+
+  psThread->psNext = psPos;
+  psThread->psPrev = psPos->psPrev;
+  if (psPos->psPrev != NULL) psPos->psPrev->psNext = psThread;
+  else psList->psHead = psThread;
+  psPos->psPrev = psThread;
+  psThread->psList = psList;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Remove thread from its list
+ *
+ * @param[in,out] *psThread   Linked thread
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_OS_ListRemove(HW_OS_ThreadTypeDef* psThread)
+{
+  HW_OS_ListTypeDef* psList = psThread->psList;
+  if (psThread->psPrev != NULL) psThread->psPrev->psNext = psThread->psNext;
+  else psList->psHead = psThread->psNext;
+  if (psThread->psNext != NULL) psThread->psNext->psPrev = psThread->psPrev;
+  else psList->psTail = psThread->psPrev;
+  psThread->psNext = NULL;
+  psThread->psPrev = NULL;
+  psThread->psList = NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Make thread ready
+ *
+ * @param[in,out] *psThread   Thread not in any list
+ * @param[in] bFront          Run before other threads of its priority
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_OS_Ready(HW_OS_ThreadTypeDef* psThread, bool bFront)
+{
+  HW_OS_ListTypeDef* psList = &asReady[psThread->ucPrio];
+  if (bFront) vHW_OS_ListPrepend(psList, psThread);
+  else vHW_OS_ListAppend(psList, psThread);
+  psThread->eState = HW_OS_STATE_READY;
+  ulReadyMask |= 1uL << psThread->ucPrio;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Remove thread from ready list
+ *
+ * @param[in,out] *psThread   Ready thread
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_OS_Unready(HW_OS_ThreadTypeDef* psThread)
+{
+  vHW_OS_ListRemove(psThread);
+  if (asReady[psThread->ucPrio].psHead == NULL) ulReadyMask &= ~(1uL << psThread->ucPrio);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Insert thread into timeout list
+ *
+ * @param[in,out] *psThread   Thread
+ * @param[in] ulTimeout       Timeout in milliseconds
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_OS_SleepInsert(HW_OS_ThreadTypeDef* psThread, uint32_t ulTimeout)
+{
+  uint32_t ulNow = ulHW_CLK_GetTime();
+  psThread->ulWakeTime = ulNow + ulTimeout;
+
+  HW_OS_ThreadTypeDef** ppsLink = &psSleepHead;
+  while ((*ppsLink != NULL) && ((*ppsLink)->ulWakeTime - ulNow <= ulTimeout))
+  {
+    ppsLink = &(*ppsLink)->psSleepNext;
+  }
+  psThread->psSleepNext = *ppsLink;
+  *ppsLink = psThread;
+  psThread->bSleeping = true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Remove thread from timeout list
+ *
+ * @param[in,out] *psThread   Thread in timeout list
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_OS_SleepRemove(HW_OS_ThreadTypeDef* psThread)
+{
+  HW_OS_ThreadTypeDef** ppsLink = &psSleepHead;
+  while (*ppsLink != psThread)
+  {
+    ppsLink = &(*ppsLink)->psSleepNext;
+  }
+  *ppsLink = psThread->psSleepNext;
+  psThread->psSleepNext = NULL;
+  psThread->bSleeping = false;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Block running thread
+ *
+ * The switch is taken when the caller leaves the critical section.
+ *
+ * @param[in,out] *psWaitList   Wait list, NULL for delay
+ * @param[in] ulTimeout         Timeout in milliseconds, or HW_OS_WAIT_FOREVER
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_OS_Block(HW_OS_ListTypeDef* psWaitList, uint32_t ulTimeout)
+{
+  HW_OS_ThreadTypeDef* psThread = psCurrent;
+  vHW_OS_Unready(psThread);
+  psThread->eState = HW_OS_STATE_BLOCKED;
+  psThread->bTimedOut = false;
+
+  if (psWaitList != NULL) vHW_OS_ListInsert(psWaitList, psThread);
+  if (ulTimeout != HW_OS_WAIT_FOREVER) vHW_OS_SleepInsert(psThread, ulTimeout);
+  vHW_OS_RequestSwitch();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Make blocked thread ready
+ *
+ * @param[in,out] *psThread   Blocked thread
+ * @param[in] bTimedOut       Wait ended by timeout
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_OS_Wake(HW_OS_ThreadTypeDef* psThread, bool bTimedOut)
+{
+  HW_OS_MutexTypeDef* psMutex = psThread->psWaitMutex;
+  psThread->psWaitMutex = NULL;
+
+  if (psThread->psList != NULL) vHW_OS_ListRemove(psThread);
+  if (psThread->bSleeping) vHW_OS_SleepRemove(psThread);
+  psThread->bTimedOut = bTimedOut;
+  vHW_OS_Ready(psThread, false);
+
+  // Owner may lose priority inherited from a timed-out waiter
+  if (psMutex != NULL) vHW_OS_UpdatePrio(psMutex->psOwner);
+  vHW_OS_Preempt();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Change effective priority and reposition thread in its list
+ *
+ * @param[in,out] *psThread   Thread
+ * @param[in] ucPrio          New effective priority
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_OS_SetPrio(HW_OS_ThreadTypeDef* psThread, uint8_t ucPrio)
+{
+  if (psThread->eState == HW_OS_STATE_READY)
+  {
+    // Boosted owner runs before its new peers to release the mutex soon
+    vHW_OS_Unready(psThread);
+    psThread->ucPrio = ucPrio;
+    vHW_OS_Ready(psThread, true);
+  }
+  else if (psThread->psList != NULL)
+  {
+    HW_OS_ListTypeDef* psList = psThread->psList;
+    vHW_OS_ListRemove(psThread);
+    psThread->ucPrio = ucPrio;
+    vHW_OS_ListInsert(psList, psThread);
+  }
+  else
+  {
+    psThread->ucPrio = ucPrio;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Recompute effective priority from held mutexes
+ *
+ * Propagates along the chain of owners the thread is waiting for.
+ *
+ * @param[in,out] *psThread   Thread, or NULL
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_OS_UpdatePrio(HW_OS_ThreadTypeDef* psThread)
+{
+  while (psThread != NULL)
+  {
+    uint8_t ucPrio = psThread->ucBasePrio;
+    for (HW_OS_MutexTypeDef* psMutex = psThread->psMutexes; psMutex != NULL; psMutex = psMutex->psNextHeld)
+    {
+      HW_OS_ThreadTypeDef* psWaiter = psMutex->sWaiters.psHead;
+      if ((psWaiter != NULL) && (psWaiter->ucPrio > ucPrio)) ucPrio = psWaiter->ucPrio;
+    }
+    if (ucPrio == psThread->ucPrio) break;
+
+    vHW_OS_SetPrio(psThread, ucPrio);
+    psThread = (psThread->psWaitMutex != NULL) ? psThread->psWaitMutex->psOwner : NULL;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Request context switch if a thread of higher priority became ready
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_OS_Preempt(void)
+{
+  if (!bRunning) return;
+
+  HW_OS_ThreadTypeDef* psThread = psCurrent;
+  if ((psThread == &sIdle) || (psThread->eState != HW_OS_STATE_READY) ||
+      (psHW_OS_GetNext()->ucPrio > psThread->ucPrio))
+  {
+    vHW_OS_RequestSwitch();
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check stack pointer and guard of a switched-out thread
+ *
+ * On overflow, records a flight recorder event and traps into the fault
+ * handler.
+ *
+ * @param[in] *psThread   Thread
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_OS_CheckStack(const HW_OS_ThreadTypeDef* psThread)
+{
+  bool bIntact = (psThread->pulSp >= &psThread->pulStack[HW_OS_GUARD_WORDS]);
+  for (uint32_t i = 0uL; i < HW_OS_GUARD_WORDS; ++i)
+  {
+    if (psThread->pulStack[i] != HW_OS_GUARD_PATTERN) bIntact = false;
+  }
+
+  if (!bIntact)
+  {
+    vHW_FLIGHT_Record(HW_OS_FLIGHT_EVT_OVERFLOW, (uint16_t)(uintptr_t)psThread);
+    __builtin_trap();
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get number of ticks without timeout expiry
+ *
+ * @return  (uint32_t)  Ticks after the current one that need no processing
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulHW_OS_GetIdleTicks(void)
+{
+  if (psSleepHead == NULL) return UINT32_MAX;
+
+  int32_t lDelta = (int32_t)(psSleepHead->ulWakeTime - ulHW_CLK_GetTime());
+  return (lDelta > 1L) ? (uint32_t)(lDelta - 1L) : 0uL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Enter first thread (called from SVC handler)
+ *
+ * @param[in] *pulSp    Saved context of vHW_OS_Start() caller
+ * @return  (uint32_t*)   Saved context of first thread
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t* pulHW_OS_Launch(uint32_t* pulSp)
+{
+  pulMainSp = pulSp;
+  HW_OS_ThreadTypeDef* psThread = psHW_OS_GetNext();
+  psThread->ulSwitches++;
+  psCurrent = psThread;
+  bRunning = true;
+#if HW_TRACE_TIMELINE
+  vHW_TRACE_ThreadSwitch(psThread);
+#endif
+  return psThread->pulSp;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Select next thread (called from PendSV handler)
+ *
+ * @param[in] *pulSp    Saved context of current thread
+ * @return  (uint32_t*)   Saved context of next thread, NULL to stop
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t* pulHW_OS_Switch(uint32_t* pulSp)
+{
+  uint32_t ulLock = ulHW_OS_Lock();
+  HW_OS_ThreadTypeDef* psThread = psCurrent;
+  psThread->pulSp = pulSp;
+  vHW_OS_CheckStack(psThread);
+
+  if (bStopRequest)
+  {
+    bStopRequest = false;
+    bRunning = false;
+    psCurrent = NULL;
+#if HW_TRACE_TIMELINE
+    vHW_TRACE_ThreadSwitch(NULL);
+#endif
+    vHW_OS_Unlock(ulLock);
+    return NULL;
+  }
+
+  HW_OS_ThreadTypeDef* psNext = psHW_OS_GetNext();
+  if (psNext != psThread)
+  {
+    psNext->ulSwitches++;
+#if HW_TRACE_TIMELINE
+    vHW_TRACE_ThreadSwitch(psNext);
+#endif
+  }
+  psCurrent = psNext;
+  vHW_OS_Unlock(ulLock);
+  return psNext->pulSp;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get saved context of vHW_OS_Start() caller (called from PendSV handler)
+ *
+ * @return  (uint32_t*)   Saved context
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t* pulHW_OS_GetMainSp(void)
+{
+  return pulMainSp;
+}
@@ -0,0 +1,156 @@
+/*!****************************************************************************
+ * @file
+ * hw_os.h
+ *
+ * @brief
+ * Hardware Layer - Preemptive priority-based kernel
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef HW_OS_H_
+#define HW_OS_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Number of thread priorities, 0 is lowest (max. 32)
+#ifndef HW_OS_PRIORITIES
+#define HW_OS_PRIORITIES              8u
+#endif
+
+/// Stack guard size in words at the bottom of each stack
+#ifndef HW_OS_GUARD_WORDS
+#define HW_OS_GUARD_WORDS             4u
+#endif
+
+/// Suppress SysTick while idle (0: sleep until next tick)
+#ifndef HW_OS_TICKLESS
+#define HW_OS_TICKLESS                1
+#endif
+
+/// Smallest thread stack in words (exception frame, saved context, guard)
+#define HW_OS_MIN_STACK_WORDS         (16u + HW_OS_GUARD_WORDS + 16u)
+
+/*! @brief Timeout values in milliseconds
+ *  @{                                                                        */
+#define HW_OS_NO_WAIT                 0uL
+#define HW_OS_WAIT_FOREVER            0xFFFFFFFFuL
+/*! @}                                                                        */
+
+/// Flight recorder event ID for stack overflow, arg: low half of thread address
+#define HW_OS_FLIGHT_EVT_OVERFLOW     0xF001u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Thread entry function
+typedef void (*HW_OS_EntryTypeDef)(void* pvArg);
+
+/// Thread state
+typedef enum {
+  HW_OS_STATE_READY = 0,          ///< Ready or running
+  HW_OS_STATE_BLOCKED,            ///< Waiting for object or delay
+  HW_OS_STATE_DEAD                ///< Returned from entry function
+} HW_OS_StateTypeDef;
+
+struct HW_OS_Thread;
+struct HW_OS_Mutex;
+
+/// Thread list, sorted by priority where used as wait list
+typedef struct {
+  struct HW_OS_Thread* psHead;    ///< First thread
+  struct HW_OS_Thread* psTail;    ///< Last thread
+} HW_OS_ListTypeDef;
+
+/*! @brief Thread control block
+ *
+ * Storage is provided by the caller and must stay valid while the kernel
+ * runs. All fields are managed by the kernel.                             */
+typedef struct HW_OS_Thread {
+  uint32_t* pulSp;                ///< Saved stack pointer (must be first)
+  uint32_t* pulStack;             ///< Stack bottom (guard)
+  uint32_t ulStackWords;          ///< Stack size in words
+  const char* pcName;             ///< Name
+  struct HW_OS_Thread* psNext;    ///< Ready/wait list link
+  struct HW_OS_Thread* psPrev;    ///< Ready/wait list link
+  HW_OS_ListTypeDef* psList;      ///< List the thread is in, or NULL
+  struct HW_OS_Thread* psSleepNext; ///< Timeout list link
+  uint32_t ulWakeTime;            ///< Timeout expiry in system time
+  bool bSleeping;                 ///< In timeout list
+  bool bTimedOut;                 ///< Last wait ended by timeout
+  uint8_t ucBasePrio;             ///< Assigned priority
+  uint8_t ucPrio;                 ///< Effective priority (inheritance)
+  volatile HW_OS_StateTypeDef eState; ///< State
+  struct HW_OS_Mutex* psWaitMutex; ///< Mutex waited for, or NULL
+  struct HW_OS_Mutex* psMutexes;  ///< Held mutexes
+  void* pvMsg;                    ///< Queue item buffer while waiting
+  uint32_t ulSwitches;            ///< Number of times switched in
+} HW_OS_ThreadTypeDef;
+
+/// Mutex with priority inheritance, recursive
+typedef struct HW_OS_Mutex {
+  HW_OS_ThreadTypeDef* psOwner;   ///< Owner, or NULL
+  uint32_t ulCount;               ///< Recursion depth
+  HW_OS_ListTypeDef sWaiters;     ///< Waiting threads
+  struct HW_OS_Mutex* psNextHeld; ///< Owner's held mutex list link
+} HW_OS_MutexTypeDef;
+
+/// Counting semaphore
+typedef struct {
+  uint32_t ulCount;               ///< Available count
+  uint32_t ulMax;                 ///< Maximum count
+  HW_OS_ListTypeDef sWaiters;     ///< Waiting threads
+} HW_OS_SemTypeDef;
+
+/// Message queue of fixed-size items
+typedef struct {
+  uint8_t* pucBuf;                ///< Item storage
+  uint32_t ulItemSize;            ///< Item size in bytes
+  uint32_t ulLength;              ///< Capacity in items
+  uint32_t ulHead;                ///< Index of oldest item
+  uint32_t ulCount;               ///< Number of items
+  HW_OS_ListTypeDef sSenders;     ///< Threads waiting for space
+  HW_OS_ListTypeDef sReceivers;   ///< Threads waiting for items
+} HW_OS_QueueTypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vHW_OS_Init(void);
+bool bHW_OS_ThreadCreate(HW_OS_ThreadTypeDef* psThread, const char* pcName,
+                         HW_OS_EntryTypeDef pfnEntry, void* pvArg,
+                         uint32_t* pulStack, uint32_t ulStackSize, uint8_t ucPriority);
+void vHW_OS_Start(void);
+void vHW_OS_Stop(void);
+bool bHW_OS_IsRunning(void);
+HW_OS_ThreadTypeDef* psHW_OS_GetCurrent(void);
+uint32_t ulHW_OS_GetStackFree(const HW_OS_ThreadTypeDef* psThread);
+
+// Thread control
+void vHW_OS_Yield(void);
+void vHW_OS_Delay(uint32_t ulMs);
+void vHW_OS_DelayUntil(uint32_t* pulWakeTime, uint32_t ulPeriod);
+
+// Mutexes (threads only)
+void vHW_OS_MutexInit(HW_OS_MutexTypeDef* psMutex);
+bool bHW_OS_MutexLock(HW_OS_MutexTypeDef* psMutex, uint32_t ulTimeout);
+bool bHW_OS_MutexUnlock(HW_OS_MutexTypeDef* psMutex);
+
+// Semaphores (give and polling take from interrupts)
+void vHW_OS_SemInit(HW_OS_SemTypeDef* psSem, uint32_t ulCount, uint32_t ulMax);
+bool bHW_OS_SemTake(HW_OS_SemTypeDef* psSem, uint32_t ulTimeout);
+bool bHW_OS_SemGive(HW_OS_SemTypeDef* psSem);
+
+// Message queues (polling from interrupts)
+void vHW_OS_QueueInit(HW_OS_QueueTypeDef* psQueue, void* pvBuf,
+                      uint32_t ulItemSize, uint32_t ulLength);
+bool bHW_OS_QueueSend(HW_OS_QueueTypeDef* psQueue, const void* pvItem, uint32_t ulTimeout);
+bool bHW_OS_QueueReceive(HW_OS_QueueTypeDef* psQueue, void* pvItem, uint32_t ulTimeout);
+
+void vHW_OS_TickHandler(void);
+void vHW_OS_SvcHandler(void);
+void vHW_OS_PendSvHandler(void);
+
+#endif // HW_OS_H_
@@ -0,0 +1,484 @@
+/*!****************************************************************************
+ * @file
+ * hw_seq.c
+ *
+ * @brief
+ * Hardware Layer - DMA waveform sequencer
+ *
+ * TIM1 runs at the sample rate; each update event requests one DMA burst
+ * that moves the next sample from memory to the outputs, so no interrupt is
+ * taken per sample:
+ *  - PWM: the compare values of CH1..CHn, written through the DMA address
+ *    register into the preloaded CCR1..CCRn. They take effect together at
+ *    the following update, so the PWM period is the sample period and all
+ *    channels change on the same edge. The first period after start is idle.
+ *  - GPIO: one set/reset word written to SEQ_GPIO_PORT->BSRR, which changes
+ *    all pins of the port at once. The first sample is output at start.
+ *
+ * Tables are played as one DMA block per pass (lib/seq). The transfer
+ * complete interrupt selects the next pass and re-arms the channel before
+ * the next update, i.e. within one sample period, which is why it sits at
+ * sub-priority 0 of the DRIVER level. Re-arming later holds the last sample
+ * for a period, but never mixes samples. A queued table takes over at the
+ * next pass boundary; at the end of the sequence, the last sample is held.
+ *
+ * Streams play a ring of two halves in circular mode; the half and full
+ * transfer interrupts refill the half just played from a callback. A half
+ * refilled after playback reached it is counted as underrun.
+ *
+ * The DMA channel is shared with input capture and is taken from hw_dma for
+ * as long as the sequencer runs, i.e. until vHW_SEQ_Stop().
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stddef.h>
+#include "stm32f1xx_hal.h"
+#include "hw_seq.h"
+#include "hw_dma.h"
+#include "hw_init.h"
+#include "hw_iodef.h"
+#include "hw_irq.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Largest sample in bytes (PWM, HW_SEQ_CHANNELS_MAX compare values)
+#define HW_SEQ_SAMPLE_MAX             (HW_SEQ_CHANNELS_MAX * sizeof(uint16_t))
+
+/// Stream ring in words
+#define HW_SEQ_RING_WORDS             ((2u * HW_SEQ_STREAM_HALF * HW_SEQ_SAMPLE_MAX + 3u) / 4u)
+
+/// Maximum transfers per channel activation
+#define HW_SEQ_MAX_TRANSFERS          0xFFFFuL
+
+/// Counter periods (PSC) and ticks per period (ARR) are 16 bits wide
+#define HW_SEQ_MAX_TICKS              0x10000uL
+
+/// PWM mode 1 with compare preload, for the OCxM/OCxPE fields of CCMR1 and CCMR2
+#define HW_SEQ_CCMR_PWM1              (TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1PE)
+
+_Static_assert(HW_SEQ_STREAM_HALF >= 1u, "stream ring needs at least one sample per half");
+_Static_assert(2u * HW_SEQ_STREAM_HALF * HW_SEQ_CHANNELS_MAX <= HW_SEQ_MAX_TRANSFERS,
+               "stream ring exceeds DMA transfer count");
+_Static_assert((HW_SEQ_RATE_MAX >= 1u) && (HW_SEQ_RATE_MAX <= 1000000uL), "sequencer rate out of range");
+
+
+/*- Private functions --------------------------------------------------------*/
+static uint32_t ulHW_SEQ_Transfers(const HW_SEQ_ConfigTypeDef* psConfig);
+static bool bHW_SEQ_Fits(const SEQ_TableTypeDef* psTable, uint32_t ulPerSample);
+static uint32_t ulHW_SEQ_Prescaler(uint32_t ulTicks);
+static bool bHW_SEQ_Setup(const HW_SEQ_ConfigTypeDef* psConfig, uint32_t ulPerSample);
+static void vHW_SEQ_Arm(const void* pvData, uint32_t ulCount, uint32_t ulFlags);
+static void vHW_SEQ_Run(void);
+static void vHW_SEQ_End(void);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Stream ring (both halves)
+static uint32_t aulRing[HW_SEQ_RING_WORDS];
+
+/// Table player
+static SEQ_PlayerTypeDef sPlayer;
+
+/// Stream
+static SEQ_StreamTypeDef sStream;
+
+/// Counters since start
+static SEQ_StatsTypeDef sStats;
+
+/// Playing a stream instead of tables
+static bool bStream;
+
+/// Samples are moved to the outputs
+static volatile bool bPlaying;
+
+/// DMA transfers per sample
+static uint32_t ulTransfers;
+
+/// DMA data size bits of the output mode
+static uint32_t ulDataSize;
+
+/// Timer clock in Hz
+static uint32_t ulClock;
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise sequencer timer and outputs, without starting
+ *
+ * - SEQ_PWM_PINS: Alternate function push-pull (TIM1 CH1..CH3)
+ * - SEQ_GPIO_PINS: Output push-pull, low
+ *
+ * With HW_INIT_DIRECT, clocks and pins are set up by the bring-up table.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_SEQ_Init(void)
+{
+#if !HW_INIT_DIRECT
+  __HAL_RCC_GPIOA_CLK_ENABLE();
+  __HAL_RCC_GPIOB_CLK_ENABLE();
+  __HAL_RCC_TIM1_CLK_ENABLE();
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  GPIO_InitTypeDef sPins = {
+    .Pin = SEQ_PWM_PINS,
+    .Mode = GPIO_MODE_AF_PP,
+    .Pull = GPIO_NOPULL,
+    .Speed = GPIO_SPEED_FREQ_HIGH
+  };
+  HAL_GPIO_Init(SEQ_PWM_PORT, &sPins);
+
+  sPins.Pin = SEQ_GPIO_PINS;
+  sPins.Mode = GPIO_MODE_OUTPUT_PP;
+  HAL_GPIO_WritePin(SEQ_GPIO_PORT, SEQ_GPIO_PINS, GPIO_PIN_RESET);
+  HAL_GPIO_Init(SEQ_GPIO_PORT, &sPins);
+#endif
+
+  // Timer clock is PCLK2 doubled when APB2 is divided
+  ulClock = HAL_RCC_GetPCLK2Freq();
+  if ((RCC->CFGR & RCC_CFGR_PPRE2) != RCC_CFGR_PPRE2_DIV1) ulClock *= 2uL;
+
+  SEQ_TIM->CR1 = 0uL;
+  SEQ_TIM->DIER = 0uL;
+  bPlaying = false;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start playing a table sequence
+ *
+ * Stops a running sequence first. Linked and queued tables must fit the DMA
+ * transfer count as well; one that does not ends the sequence.
+ *
+ * @param[in] *psConfig   Output mode and rate
+ * @param[in] *psTable    First table, kept in memory while playing
+ * @return  (bool)  false if the configuration or table is invalid, or
+ *                  capture holds the DMA channel
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_SEQ_Start(const HW_SEQ_ConfigTypeDef* psConfig, const SEQ_TableTypeDef* psTable)
+{
+  uint32_t ulPerSample = ulHW_SEQ_Transfers(psConfig);
+  if ((ulPerSample == 0uL) || !bHW_SEQ_Fits(psTable, ulPerSample)) return false;
+  if (!bHW_SEQ_Setup(psConfig, ulPerSample)) return false;
+
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  bStream = false;
+  vSEQ_Init(&sPlayer, psTable, &sStats);
+  vHW_SEQ_Arm(psTable->pvData, psTable->ulSamples * ulTransfers, DMA_CCR_TCIE);
+  vHW_SEQ_Run();
+  vHW_IRQ_Unlock(ulLock);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start playing a stream
+ *
+ * Stops a running sequence first. The refill is called from the caller's
+ * context for both halves of the ring, then from the DMA interrupt.
+ *
+ * @param[in] *psConfig   Output mode and rate
+ * @param[in] pfnRefill   Refill, writes HW_SEQ_STREAM_HALF samples at most
+ * @param[in] *pvContext  Refill context
+ * @return  (bool)  false if the configuration is invalid, the stream has no
+ *                  samples, or capture holds the DMA channel
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_SEQ_StartStream(const HW_SEQ_ConfigTypeDef* psConfig, SEQ_RefillTypeDef pfnRefill,
+                         void* pvContext)
+{
+  uint32_t ulPerSample = ulHW_SEQ_Transfers(psConfig);
+  if ((ulPerSample == 0uL) || (pfnRefill == NULL)) return false;
+  if (!bHW_SEQ_Setup(psConfig, ulPerSample)) return false;
+
+  bStream = true;
+  uint32_t ulSampleSize = (psConfig->eMode == HW_SEQ_MODE_GPIO) ? sizeof(uint32_t) : ulPerSample * sizeof(uint16_t);
+  if (!bSEQ_StreamInit(&sStream, aulRing, HW_SEQ_STREAM_HALF, ulSampleSize, pfnRefill, pvContext))
+  {
+    vHW_SEQ_Stop();
+    return false;
+  }
+
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  vHW_SEQ_Arm(aulRing, 2uL * HW_SEQ_STREAM_HALF * ulTransfers, DMA_CCR_CIRC | DMA_CCR_HTIE | DMA_CCR_TCIE);
+  vHW_SEQ_Run();
+  vHW_IRQ_Unlock(ulLock);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Queue table to take over at the next pass boundary
+ *
+ * Replaces a table queued before that has not taken over yet.
+ *
+ * @param[in] *psTable    Table, kept in memory while playing
+ * @return  (bool)  false if no table sequence is playing, or the table is
+ *                  invalid
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_SEQ_Queue(const SEQ_TableTypeDef* psTable)
+{
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  bool bQueued = bPlaying && !bStream && bHW_SEQ_Fits(psTable, ulTransfers);
+  if (bQueued) vSEQ_Queue(&sPlayer, psTable);
+  vHW_IRQ_Unlock(ulLock);
+  return bQueued;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stop the timer, disable the PWM outputs and release the DMA channel
+ *
+ * GPIO outputs keep their levels.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_SEQ_Stop(void)
+{
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  SEQ_TIM->CR1 = 0uL;
+  SEQ_TIM->DIER = 0uL;
+  SEQ_TIM->BDTR = 0uL;
+  SEQ_TIM->CCER = 0uL;
+  bPlaying = false;
+  vHW_DMA_ReleaseShared(HW_DMA_SHARED_SEQ);
+  vHW_IRQ_Unlock(ulLock);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if samples are still moved to the outputs
+ *
+ * @return  (bool)  false once stopped, or the sequence or stream has ended
+ *                  and the last sample is held
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_SEQ_IsPlaying(void)
+{
+  return bPlaying;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get timer ticks per sample period at a rate
+ *
+ * Lets tables of compare values be scaled before starting.
+ *
+ * @param[in] ulRate    Samples per second
+ * @return  (uint32_t)  PWM compare value for 100 % duty cycle, 0 if the rate
+ *                      is out of range
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulHW_SEQ_GetTop(uint32_t ulRate)
+{
+  if ((ulRate == 0uL) || (ulRate > HW_SEQ_RATE_MAX)) return 0uL;
+
+  uint32_t ulTicks = ulClock / ulRate;
+  return ulTicks / ulHW_SEQ_Prescaler(ulTicks);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get counters since start
+ *
+ * @param[out] *psStats   Counters
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_SEQ_GetStats(SEQ_StatsTypeDef* psStats)
+{
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  *psStats = sStats;
+  vHW_IRQ_Unlock(ulLock);
+}
+
+/*!****************************************************************************
+ * @brief
+ * DMA channel interrupt handler: re-arm the next pass or refill the stream
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_SEQ_DmaIRQHandler(void)
+{
+  uint32_t ulIsr = DMA1->ISR;
+  DMA1->IFCR = DMA_SHARED_IFCR_CGIF;
+  if (!bPlaying) return;
+
+  if (bStream)
+  {
+    // Refill the half not playing; both flags set: playback reached it already
+    uint32_t ulLen = 2uL * HW_SEQ_STREAM_HALF * ulTransfers;
+    uint32_t ulHalf = ((ulLen - DMA_SHARED_CHANNEL->CNDTR) >= ulLen / 2uL) ? 0uL : 1uL;
+    if (((ulIsr & DMA_SHARED_ISR_HTIF) != 0uL) && ((ulIsr & DMA_SHARED_ISR_TCIF) != 0uL))
+    {
+      sStats.ulUnderruns++;
+    }
+    if (!bSEQ_StreamRefill(&sStream, ulHalf, &sStats)) vHW_SEQ_End();
+    return;
+  }
+
+  if ((ulIsr & DMA_SHARED_ISR_TCIF) == 0uL) return;
+
+  const SEQ_TableTypeDef* psTable = psSEQ_NextPass(&sPlayer, &sStats);
+  if (!bHW_SEQ_Fits(psTable, ulTransfers))
+  {
+    vHW_SEQ_End();
+    return;
+  }
+  vHW_SEQ_Arm(psTable->pvData, psTable->ulSamples * ulTransfers, DMA_CCR_TCIE);
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Validate configuration
+ *
+ * @param[in] *psConfig   Output mode and rate
+ * @return  (uint32_t)  DMA transfers per sample, 0 if invalid
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulHW_SEQ_Transfers(const HW_SEQ_ConfigTypeDef* psConfig)
+{
+  if ((psConfig->ulRate == 0uL) || (psConfig->ulRate > HW_SEQ_RATE_MAX)) return 0uL;
+  if (psConfig->eMode == HW_SEQ_MODE_GPIO) return 1uL;
+  if (psConfig->eMode != HW_SEQ_MODE_PWM) return 0uL;
+  if ((psConfig->ulChannels == 0uL) || (psConfig->ulChannels > HW_SEQ_CHANNELS_MAX)) return 0uL;
+  return psConfig->ulChannels;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check that a table plays as one DMA block
+ *
+ * @param[in] *psTable      Table, or NULL
+ * @param[in] ulPerSample   DMA transfers per sample
+ * @return  (bool)  Table valid
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bHW_SEQ_Fits(const SEQ_TableTypeDef* psTable, uint32_t ulPerSample)
+{
+  return (psTable != NULL) && (psTable->pvData != NULL) && (psTable->ulSamples != 0uL) &&
+         (psTable->ulSamples <= HW_SEQ_MAX_TRANSFERS / ulPerSample);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Prescaler bringing a sample period into the 16-bit auto-reload range
+ *
+ * @param[in] ulTicks   Timer ticks per sample period (at least 1)
+ * @return  (uint32_t)  Prescaler (PSC + 1)
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulHW_SEQ_Prescaler(uint32_t ulTicks)
+{
+  return (ulTicks - 1uL) / HW_SEQ_MAX_TICKS + 1uL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Take the DMA channel and set up the timer for a configuration
+ *
+ * The timer is reset, so that no compare value or DMA burst state of an
+ * earlier sequence remains.
+ *
+ * @param[in] *psConfig     Output mode and rate (validated)
+ * @param[in] ulPerSample   DMA transfers per sample
+ * @return  (bool)  false if capture holds the DMA channel
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bHW_SEQ_Setup(const HW_SEQ_ConfigTypeDef* psConfig, uint32_t ulPerSample)
+{
+  vHW_SEQ_Stop();
+  if (!bHW_DMA_AcquireShared(HW_DMA_SHARED_SEQ)) return false;
+
+  RCC->APB2RSTR |= RCC_APB2RSTR_TIM1RST;
+  RCC->APB2RSTR &= ~RCC_APB2RSTR_TIM1RST;
+
+  uint32_t ulTicks = ulClock / psConfig->ulRate;
+  uint32_t ulPrescaler = ulHW_SEQ_Prescaler(ulTicks);
+  SEQ_TIM->PSC = ulPrescaler - 1uL;
+  SEQ_TIM->ARR = ulTicks / ulPrescaler - 1uL;
+  SEQ_TIM->CR1 = TIM_CR1_ARPE;
+
+  ulTransfers = ulPerSample;
+  sStats = (SEQ_StatsTypeDef){ 0 };
+
+  if (psConfig->eMode == HW_SEQ_MODE_PWM)
+  {
+    // Burst of ulPerSample compare values from CCR1
+    SEQ_TIM->CCMR1 = HW_SEQ_CCMR_PWM1 | (HW_SEQ_CCMR_PWM1 << 8);
+    SEQ_TIM->CCMR2 = HW_SEQ_CCMR_PWM1;
+    uint32_t ulCcer = 0uL;
+    for (uint32_t c = 0uL; c < ulPerSample; ++c)
+    {
+      ulCcer |= TIM_CCER_CC1E << (4u * c);
+    }
+    SEQ_TIM->CCER = ulCcer;
+    SEQ_TIM->BDTR = TIM_BDTR_MOE;
+    SEQ_TIM->DCR = ((ulPerSample - 1uL) << TIM_DCR_DBL_Pos) |
+                   ((offsetof(TIM_TypeDef, CCR1) / sizeof(uint32_t)) << TIM_DCR_DBA_Pos);
+    DMA_SHARED_CHANNEL->CPAR = (uint32_t)&SEQ_TIM->DMAR;
+    ulDataSize = DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_0;
+  }
+  else
+  {
+    DMA_SHARED_CHANNEL->CPAR = (uint32_t)&SEQ_GPIO_PORT->BSRR;
+    ulDataSize = DMA_CCR_MSIZE_1 | DMA_CCR_PSIZE_1;
+  }
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Program the DMA channel with a block of samples
+ *
+ * @param[in] *pvData   First sample
+ * @param[in] ulCount   Transfers
+ * @param[in] ulFlags   Circular mode and interrupt enables
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_SEQ_Arm(const void* pvData, uint32_t ulCount, uint32_t ulFlags)
+{
+  DMA_SHARED_CHANNEL->CCR = 0uL;
+  DMA_SHARED_CHANNEL->CMAR = (uint32_t)pvData;
+  DMA_SHARED_CHANNEL->CNDTR = ulCount;
+  DMA_SHARED_CHANNEL->CCR = DMA_CCR_PL_1 | DMA_CCR_PL_0 | ulDataSize | DMA_CCR_MINC | DMA_CCR_DIR |
+                            ulFlags | DMA_CCR_EN;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start the timer with the first sample
+ *
+ * The update generated here loads the prescaler and idle compare values and
+ * requests the first sample, which the first counter overflow then outputs.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_SEQ_Run(void)
+{
+  bPlaying = true;
+  SEQ_TIM->DIER = TIM_DIER_UDE;
+  SEQ_TIM->EGR = TIM_EGR_UG;
+  SEQ_TIM->CR1 |= TIM_CR1_CEN;
+}
+
+/*!****************************************************************************
+ * @brief
+ * End of sequence or stream: hold the last sample
+ *
+ * The timer keeps running with the compare values last written.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_SEQ_End(void)
+{
+  SEQ_TIM->DIER = 0uL;
+  DMA_SHARED_CHANNEL->CCR = 0uL;
+  bPlaying = false;
+}
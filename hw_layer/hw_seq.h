@@ -0,0 +1,63 @@
+/*!****************************************************************************
+ * @file
+ * hw_seq.h
+ *
+ * @brief
+ * Hardware Layer - DMA waveform sequencer
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef HW_SEQ_H_
+#define HW_SEQ_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "seq.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Samples per half of the stream ring
+#ifndef HW_SEQ_STREAM_HALF
+#define HW_SEQ_STREAM_HALF            64u
+#endif
+
+/// Highest sample rate in Hz (the DMA burst of one sample must fit a period)
+#ifndef HW_SEQ_RATE_MAX
+#define HW_SEQ_RATE_MAX               500000uL
+#endif
+
+/// Most PWM channels per sample (CH1..CH3)
+#define HW_SEQ_CHANNELS_MAX           3u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Output mode
+typedef enum {
+  HW_SEQ_MODE_PWM = 0,            ///< Sample: uint16_t compare value per channel
+  HW_SEQ_MODE_GPIO                ///< Sample: uint32_t SEQ_GPIO_PORT BSRR word (ulSEQ_Bsrr())
+} HW_SEQ_ModeTypeDef;
+
+/// Configuration
+typedef struct {
+  HW_SEQ_ModeTypeDef eMode;       ///< Output mode
+  uint32_t ulRate;                ///< Samples per second (1..HW_SEQ_RATE_MAX)
+  uint32_t ulChannels;            ///< PWM: channels from CH1 (1..HW_SEQ_CHANNELS_MAX)
+} HW_SEQ_ConfigTypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vHW_SEQ_Init(void);
+bool bHW_SEQ_Start(const HW_SEQ_ConfigTypeDef* psConfig, const SEQ_TableTypeDef* psTable);
+bool bHW_SEQ_StartStream(const HW_SEQ_ConfigTypeDef* psConfig, SEQ_RefillTypeDef pfnRefill,
+                         void* pvContext);
+bool bHW_SEQ_Queue(const SEQ_TableTypeDef* psTable);
+void vHW_SEQ_Stop(void);
+bool bHW_SEQ_IsPlaying(void);
+uint32_t ulHW_SEQ_GetTop(uint32_t ulRate);
+void vHW_SEQ_GetStats(SEQ_StatsTypeDef* psStats);
+
+void vHW_SEQ_DmaIRQHandler(void);
+
+#endif // HW_SEQ_H_
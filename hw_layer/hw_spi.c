@@ -0,0 +1,247 @@
+/*!****************************************************************************
+ * @file
+ * hw_spi.c
+ *
+ * @brief
+ * Hardware Layer - SPI master for serial NOR flash
+ *
+ * SPI1 in master mode 0 at PCLK2 / 2 (18 MHz) with a software chip select.
+ * Short blocking transfers (commands, status) are polled; longer ones run on
+ * the two DMA channels of SPI1, so that the bus is kept busy without gaps
+ * between bytes. Receive data is discarded into a dummy byte and transmit
+ * data replaced by 0xFF where the caller passes NULL.
+ *
+ * vHW_SPI_WriteAsync() streams transmit-only data (page program) in the
+ * background. The DMA transfer complete interrupt waits for the last byte to
+ * leave the shift register, clears the receive overrun caused by the ignored
+ * receive data and releases the chip select.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include "stm32f1xx_hal.h"
+#include "hw_init.h"
+#include "hw_iodef.h"
+#include "hw_spi.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Maximum transfer units per channel activation
+#define HW_SPI_MAX_CHUNK              0xFFFFuL
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Transmit data for receive-only transfers
+static const uint8_t ucFill = 0xFFu;
+
+/// Receive data sink for transmit-only transfers
+static uint8_t ucDiscard;
+
+/// Asynchronous write in progress
+static volatile bool bBusy;
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vHW_SPI_TransferDma(const uint8_t* pucTx, uint8_t* pucRx, uint32_t ulLen);
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise SPI1 master and DMA channels
+ *
+ * - SPI_NOR_CS_PIN: Push-pull output, high (deselected)
+ * - SPI_NOR_AF_PINS: SCK, MOSI
+ * - SPI_NOR_MISO_PIN: Floating input
+ *
+ * With HW_INIT_DIRECT, clocks and pins are set up by the bring-up table. The
+ * interrupt priority is taken from the priority plan (hw_irq).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_SPI_Init(void)
+{
+#if !HW_INIT_DIRECT
+  __HAL_RCC_GPIOA_CLK_ENABLE();
+  __HAL_RCC_SPI1_CLK_ENABLE();
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  GPIO_InitTypeDef sPins = {
+    .Pin = SPI_NOR_CS_PIN,
+    .Mode = GPIO_MODE_OUTPUT_PP,
+    .Pull = GPIO_NOPULL,
+    .Speed = GPIO_SPEED_FREQ_HIGH
+  };
+  HAL_GPIO_WritePin(SPI_NOR_PORT, SPI_NOR_CS_PIN, GPIO_PIN_SET);
+  HAL_GPIO_Init(SPI_NOR_PORT, &sPins);
+
+  sPins.Pin = SPI_NOR_AF_PINS;
+  sPins.Mode = GPIO_MODE_AF_PP;
+  HAL_GPIO_Init(SPI_NOR_PORT, &sPins);
+
+  sPins.Pin = SPI_NOR_MISO_PIN;
+  sPins.Mode = GPIO_MODE_INPUT;
+  HAL_GPIO_Init(SPI_NOR_PORT, &sPins);
+#endif
+
+  // Master, mode 0, MSB first, 8 bit, software NSS, PCLK2 / 2
+  SPI_NOR->CR1 = 0uL;
+  SPI_NOR->CR2 = 0uL;
+  SPI_NOR->CR1 = SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI | SPI_CR1_SPE;
+
+  // Both channels address the data register; receive before transmit
+  DMA_SPI_RX_CHANNEL->CCR = 0uL;
+  DMA_SPI_TX_CHANNEL->CCR = 0uL;
+  DMA1->IFCR = DMA_SPI_RX_IFCR_CGIF | DMA_SPI_TX_IFCR_CGIF;
+  DMA_SPI_RX_CHANNEL->CPAR = (uint32_t)&SPI_NOR->DR;
+  DMA_SPI_TX_CHANNEL->CPAR = (uint32_t)&SPI_NOR->DR;
+  bBusy = false;
+
+  HAL_NVIC_EnableIRQ(DMA_SPI_TX_IRQn);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Assert or release chip select
+ *
+ * @param[in] bSelect   true to assert (low)
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_SPI_Select(bool bSelect)
+{
+  SPI_NOR_PORT->BSRR = bSelect ? ((uint32_t)SPI_NOR_CS_PIN << 16) : (uint32_t)SPI_NOR_CS_PIN;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Blocking full-duplex transfer
+ *
+ * Must not be called while an asynchronous write is in progress.
+ *
+ * @param[in] *pucTx    Transmit data, or NULL to send 0xFF
+ * @param[out] *pucRx   Receive buffer, or NULL to discard
+ * @param[in] ulLen     Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_SPI_Transfer(const uint8_t* pucTx, uint8_t* pucRx, uint32_t ulLen)
+{
+  if (ulLen >= HW_SPI_DMA_THRESHOLD)
+  {
+    vHW_SPI_TransferDma(pucTx, pucRx, ulLen);
+    return;
+  }
+
+  for (uint32_t i = 0uL; i < ulLen; ++i)
+  {
+    while ((SPI_NOR->SR & SPI_SR_TXE) == 0uL) {}
+    SPI_NOR->DR = (pucTx != NULL) ? pucTx[i] : ucFill;
+    while ((SPI_NOR->SR & SPI_SR_RXNE) == 0uL) {}
+    uint8_t ucRx = (uint8_t)SPI_NOR->DR;
+    if (pucRx != NULL) pucRx[i] = ucRx;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start transmit-only transfer in the background
+ *
+ * Chip select must be asserted; it is released when the transfer is done.
+ * The data must stay valid until bHW_SPI_IsBusy() returns false.
+ *
+ * @param[in] *pucTx    Transmit data
+ * @param[in] ulLen     Number of bytes (1..65535)
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_SPI_WriteAsync(const uint8_t* pucTx, uint32_t ulLen)
+{
+  bBusy = true;
+  DMA_SPI_TX_CHANNEL->CCR = 0uL;
+  DMA1->IFCR = DMA_SPI_TX_IFCR_CGIF;
+  DMA_SPI_TX_CHANNEL->CMAR = (uint32_t)pucTx;
+  DMA_SPI_TX_CHANNEL->CNDTR = ulLen;
+  DMA_SPI_TX_CHANNEL->CCR = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_TCIE | DMA_CCR_TEIE |
+                            DMA_CCR_EN;
+  SPI_NOR->CR2 = SPI_CR2_TXDMAEN;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if an asynchronous write is in progress
+ *
+ * @return  (bool)  Write in progress
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_SPI_IsBusy(void)
+{
+  return bBusy;
+}
+
+/*!****************************************************************************
+ * @brief
+ * DMA transmit channel interrupt handler
+ *
+ * Completes an asynchronous write. The wait for the shift register is at
+ * most two byte times (< 1 us).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_SPI_IRQHandler(void)
+{
+  DMA1->IFCR = DMA_SPI_TX_IFCR_CGIF;
+  DMA_SPI_TX_CHANNEL->CCR = 0uL;
+  SPI_NOR->CR2 = 0uL;
+
+  while ((SPI_NOR->SR & SPI_SR_TXE) == 0uL) {}
+  while ((SPI_NOR->SR & SPI_SR_BSY) != 0uL) {}
+
+  // Clear overrun from ignored receive data (read DR, then SR)
+  (void)SPI_NOR->DR;
+  (void)SPI_NOR->SR;
+
+  vHW_SPI_Select(false);
+  bBusy = false;
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Blocking full-duplex transfer on both DMA channels
+ *
+ * Completion is polled on the receive channel, which finishes last.
+ *
+ * @param[in] *pucTx    Transmit data, or NULL to send 0xFF
+ * @param[out] *pucRx   Receive buffer, or NULL to discard
+ * @param[in] ulLen     Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_SPI_TransferDma(const uint8_t* pucTx, uint8_t* pucRx, uint32_t ulLen)
+{
+  uint32_t ulTxCcr = DMA_CCR_DIR | DMA_CCR_PL_0 | ((pucTx != NULL) ? DMA_CCR_MINC : 0uL);
+  uint32_t ulRxCcr = DMA_CCR_PL_1 | ((pucRx != NULL) ? DMA_CCR_MINC : 0uL);
+
+  while (ulLen != 0uL)
+  {
+    uint32_t ulChunk = (ulLen > HW_SPI_MAX_CHUNK) ? HW_SPI_MAX_CHUNK : ulLen;
+
+    DMA_SPI_RX_CHANNEL->CMAR = (pucRx != NULL) ? (uint32_t)pucRx : (uint32_t)&ucDiscard;
+    DMA_SPI_RX_CHANNEL->CNDTR = ulChunk;
+    DMA_SPI_TX_CHANNEL->CMAR = (pucTx != NULL) ? (uint32_t)pucTx : (uint32_t)&ucFill;
+    DMA_SPI_TX_CHANNEL->CNDTR = ulChunk;
+    DMA_SPI_RX_CHANNEL->CCR = ulRxCcr | DMA_CCR_EN;
+    DMA_SPI_TX_CHANNEL->CCR = ulTxCcr | DMA_CCR_EN;
+    SPI_NOR->CR2 = SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN;
+
+    while ((DMA1->ISR & DMA_SPI_RX_ISR_TCIF) == 0uL) {}
+
+    SPI_NOR->CR2 = 0uL;
+    DMA_SPI_RX_CHANNEL->CCR = 0uL;
+    DMA_SPI_TX_CHANNEL->CCR = 0uL;
+    DMA1->IFCR = DMA_SPI_RX_IFCR_CGIF | DMA_SPI_TX_IFCR_CGIF;
+
+    if (pucTx != NULL) pucTx += ulChunk;
+    if (pucRx != NULL) pucRx += ulChunk;
+    ulLen -= ulChunk;
+  }
+}
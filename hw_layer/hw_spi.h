@@ -0,0 +1,35 @@
+/*!****************************************************************************
+ * @file
+ * hw_spi.h
+ *
+ * @brief
+ * Hardware Layer - SPI master for serial NOR flash
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef HW_SPI_H_
+#define HW_SPI_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Blocking transfers from this size on use DMA instead of polling
+#ifndef HW_SPI_DMA_THRESHOLD
+#define HW_SPI_DMA_THRESHOLD          16uL
+#endif
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vHW_SPI_Init(void);
+void vHW_SPI_Select(bool bSelect);
+void vHW_SPI_Transfer(const uint8_t* pucTx, uint8_t* pucRx, uint32_t ulLen);
+void vHW_SPI_WriteAsync(const uint8_t* pucTx, uint32_t ulLen);
+bool bHW_SPI_IsBusy(void);
+
+void vHW_SPI_IRQHandler(void);
+
+#endif // HW_SPI_H_
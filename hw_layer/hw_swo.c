@@ -5,14 +5,43 @@
  * @brief
  * Hardware Layer - SWO-based I/O
  *
+ * Console output (stimulus port 0) can optionally be buffered in a transmit
+ * ring that is drained by vHW_SWO_Poll() whenever the ITM FIFO is ready, so
+ * that writers only block when the ring is full. Cooperative code can check
+ * ulHW_SWO_GetTxFree() and wait for space instead of blocking.
+ *
  * @date  13.08.2025
+ * @date  19.10.2026  Added buffered transmit
+ * @date  19.10.2026  Transmit ring guarded by hw_irq lock
  ******************************************************************************/
 
 /*- Header files -------------------------------------------------------------*/
 #include "stm32f1xx_hal.h"
+#include "hw_irq.h"
 #include "hw_swo.h"
 
 
+/*- Macros -------------------------------------------------------------------*/
+/// Transmit ring index mask
+#define HW_SWO_TX_MASK                (HW_SWO_TX_SIZE - 1u)
+
+_Static_assert((HW_SWO_TX_SIZE & HW_SWO_TX_MASK) == 0u, "HW_SWO_TX_SIZE must be a power of two");
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Transmit ring
+static char acTxBuf[HW_SWO_TX_SIZE];
+static uint32_t ulTxHead;
+static uint32_t ulTxTail;
+
+/// Buffered transmit enabled
+static bool bTxBuffered;
+
+
+/*- Private functions --------------------------------------------------------*/
+static bool bHW_SWO_SendNext(bool bWait);
+
+
 /*- Global data --------------------------------------------------------------*/
 /// Data receive buffer
 volatile int32_t ITM_RxBuffer = ITM_RXBUFFER_EMPTY;
@@ -48,12 +77,152 @@ char cHW_SWO_Read(void)
  * Write character to debugger output
  *
  * When a debugger is connected, this call blocks until the previous character
- * has been transmitted.
+ * has been transmitted. With buffered transmit, it only blocks while the
+ * transmit ring is full.
  *
  * @param[in] cCh   Character to send
  * @date  13.08.2025
+ * @date  19.10.2026
  ******************************************************************************/
 void vHW_SWO_Write(char cCh)
 {
-  (void)ITM_SendChar(cCh);
+  if (!bTxBuffered)
+  {
+    (void)ITM_SendChar(cCh);
+    return;
+  }
+
+  while (1)
+  {
+    uint32_t ulLock = ulHW_IRQ_Lock();
+    if (ulTxHead - ulTxTail < HW_SWO_TX_SIZE)
+    {
+      acTxBuf[ulTxHead & HW_SWO_TX_MASK] = cCh;
+      ulTxHead++;
+      vHW_IRQ_Unlock(ulLock);
+      return;
+    }
+    vHW_IRQ_Unlock(ulLock);
+
+    // Ring full: make space
+    (void)bHW_SWO_SendNext(true);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Enable or disable buffered transmit
+ *
+ * When enabled, vHW_SWO_Poll() must be called regularly. Disabling flushes
+ * the transmit ring.
+ *
+ * @param[in] bEnable   Buffer console output
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_SWO_SetBuffered(bool bEnable)
+{
+  if (!bEnable) vHW_SWO_Flush();
+  bTxBuffered = bEnable;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get free space in transmit ring
+ *
+ * @return  (uint32_t)  Number of characters that can be written without
+ *                      blocking
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulHW_SWO_GetTxFree(void)
+{
+  return HW_SWO_TX_SIZE - (ulTxHead - ulTxTail);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Move buffered characters to the ITM while it accepts them
+ *
+ * Never blocks.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_SWO_Poll(void)
+{
+  while (bHW_SWO_SendNext(false))
+  {
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Transmit all buffered characters
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_SWO_Flush(void)
+{
+  while (bHW_SWO_SendNext(true))
+  {
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write character to a specific ITM stimulus port
+ *
+ * Same as vHW_SWO_Write(), but allows selecting one of the 32 stimulus ports
+ * so that machine-readable data can be kept apart from console output. The
+ * character is dropped if ITM or the selected port is disabled.
+ *
+ * @param[in] ucPort  ITM stimulus port (0..31)
+ * @param[in] cCh     Character to send
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_SWO_WritePort(uint8_t ucPort, char cCh)
+{
+  if (((ITM->TCR & ITM_TCR_ITMENA_Msk) != 0uL) &&
+      ((ITM->TER & (1uL << (ucPort & 0x1Fu))) != 0uL))
+  {
+    while (ITM->PORT[ucPort & 0x1Fu].u32 == 0uL)
+    {
+      __NOP();
+    }
+    ITM->PORT[ucPort & 0x1Fu].u8 = (uint8_t)cCh;
+  }
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Send oldest buffered character
+ *
+ * Characters are discarded if ITM or stimulus port 0 is disabled (no
+ * debugger), like ITM_SendChar() does.
+ *
+ * @param[in] bWait   Wait for the ITM FIFO to become ready
+ * @return  (bool)  A character was removed from the ring
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bHW_SWO_SendNext(bool bWait)
+{
+  bool bEnabled = ((ITM->TCR & ITM_TCR_ITMENA_Msk) != 0uL) && ((ITM->TER & 1uL) != 0uL);
+  if (bEnabled && bWait)
+  {
+    while (ITM->PORT[0].u32 == 0uL)
+    {
+      __NOP();
+    }
+  }
+
+  // Several contexts may drain, so take and send under lock
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  bool bSent = (ulTxHead != ulTxTail) && (!bEnabled || (ITM->PORT[0].u32 != 0uL));
+  if (bSent)
+  {
+    if (bEnabled) ITM->PORT[0].u8 = (uint8_t)acTxBuf[ulTxTail & HW_SWO_TX_MASK];
+    ulTxTail++;
+  }
+  vHW_IRQ_Unlock(ulLock);
+  return bSent;
 }
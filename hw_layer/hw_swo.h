@@ -13,6 +13,14 @@
 
 /*- Header files -------------------------------------------------------------*/
 #include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Transmit ring size in characters (power of two)
+#ifndef HW_SWO_TX_SIZE
+#define HW_SWO_TX_SIZE                256u
+#endif
 
 
 /*- Public interface ---------------------------------------------------------*/
@@ -20,5 +28,12 @@ bool bHW_SWO_IsDataAvailable(void);
 
 char cHW_SWO_Read(void);
 void vHW_SWO_Write(char cCh);
+void vHW_SWO_WritePort(uint8_t ucPort, char cCh);
+
+// Buffered transmit
+void vHW_SWO_SetBuffered(bool bEnable);
+uint32_t ulHW_SWO_GetTxFree(void);
+void vHW_SWO_Poll(void);
+void vHW_SWO_Flush(void);
 
 #endif // SWO_H_
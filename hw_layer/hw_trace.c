@@ -0,0 +1,306 @@
+/*!****************************************************************************
+ * @file
+ * hw_trace.c
+ *
+ * @brief
+ * Hardware Layer - Compact binary event trace via ITM
+ *
+ * Events are timestamped with the DWT cycle counter, encoded by the trace
+ * library (delta timestamps, zig-zag varint arguments, per-stream event ID
+ * dictionary) and written to one ITM stimulus port per stream, using 32-bit
+ * stimulus writes where possible to minimise SWO packet overhead.
+ *
+ * Unless HW_TRACE_BLOCKING is set, records that do not fit into the ITM FIFO
+ * are dropped and the next record is preceded by a resync marker, so the
+ * host decoder recovers without stalling the firmware.
+ *
+ * With HW_TRACE_TIMELINE, a separate timeline stream records enter/exit of
+ * exception handlers, kernel thread switches and user-marked regions on its
+ * own stimulus port. The core clock frequency is recorded after every resync
+ * marker, so the host converter (tools/trace_timeline) can scale timestamps
+ * of captures started at any time.
+ *
+ * Records are written under the hw_irq lock, so handlers at CRITICAL level
+ * must not trace.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <string.h>
+#include "stm32f1xx_hal.h"
+#include "trace.h"
+#include "hw_clk.h"
+#include "hw_irq.h"
+#include "hw_trace.h"
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Stream encoders
+static TRACE_EncoderTypeDef asEncoders[HW_TRACE_STREAMS];
+
+#if HW_TRACE_TIMELINE
+/// Timeline encoder
+static TRACE_EncoderTypeDef sTimeline;
+#endif
+
+/// Number of dropped records
+static volatile uint32_t ulDropped;
+
+
+/*- Private functions --------------------------------------------------------*/
+static bool bHW_TRACE_Emit(TRACE_EncoderTypeDef* psEnc, uint32_t ulPort, uint16_t uiId,
+                           uint32_t ulNumArgs, const uint32_t* pulArgs);
+static bool bHW_TRACE_PortReady(uint32_t ulPort);
+#if HW_TRACE_TIMELINE
+static void vHW_TRACE_Timeline(uint16_t uiId, uint32_t ulNumArgs, const uint32_t* pulArgs);
+#endif
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise trace streams
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_TRACE_Init(void)
+{
+  for (uint32_t i = 0uL; i < HW_TRACE_STREAMS; ++i)
+  {
+    vTRACE_EncoderInit(&asEncoders[i]);
+  }
+  ulDropped = 0uL;
+
+#if HW_TRACE_TIMELINE
+  vTRACE_EncoderInit(&sTimeline);
+#endif
+}
+
+/*!****************************************************************************
+ * @brief
+ * Record trace event
+ *
+ * May be called from any context. Records are discarded if ITM or the
+ * stream's stimulus port is disabled.
+ *
+ * @param[in] ucStream    Stream index (0..HW_TRACE_STREAMS-1)
+ * @param[in] uiId        Event ID
+ * @param[in] ulNumArgs   Number of arguments (0..3)
+ * @param[in] *pulArgs    Arguments
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_TRACE_Event(uint8_t ucStream, uint16_t uiId, uint32_t ulNumArgs,
+                     const uint32_t* pulArgs)
+{
+  if (ucStream >= HW_TRACE_STREAMS) return;
+  (void)bHW_TRACE_Emit(&asEncoders[ucStream], HW_TRACE_PORT_BASE + ucStream,
+                       uiId, ulNumArgs, pulArgs);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get number of records dropped due to full ITM FIFO
+ *
+ * @return  (uint32_t)  Dropped records
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulHW_TRACE_GetDropped(void)
+{
+  return ulDropped;
+}
+
+#if HW_TRACE_TIMELINE
+/*!****************************************************************************
+ * @brief
+ * Timeline: exception handler entered
+ *
+ * Must be called at the start of the handler; the exception number is taken
+ * from IPSR.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_TRACE_ExcEnter(void)
+{
+  uint32_t ulExc = __get_IPSR();
+  vHW_TRACE_Timeline(HW_TRACE_TL_EXC_ENTER, 1uL, &ulExc);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Timeline: exception handler left
+ *
+ * Must be called at the end of the handler.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_TRACE_ExcExit(void)
+{
+  uint32_t ulExc = __get_IPSR();
+  vHW_TRACE_Timeline(HW_TRACE_TL_EXC_EXIT, 1uL, &ulExc);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Timeline: thread switched in
+ *
+ * @param[in] *pvThread   Thread identity (e.g. control block address)
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_TRACE_ThreadSwitch(const void* pvThread)
+{
+  uint32_t ulThread = (uint32_t)(uintptr_t)pvThread;
+  vHW_TRACE_Timeline(HW_TRACE_TL_THREAD, 1uL, &ulThread);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Timeline: name a thread
+ *
+ * @param[in] *pvThread   Thread identity
+ * @param[in] *pcName     Name, first 8 characters are recorded
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_TRACE_ThreadName(const void* pvThread, const char* pcName)
+{
+  uint32_t aulArgs[3] = { (uint32_t)(uintptr_t)pvThread, 0uL, 0uL };
+  for (uint32_t i = 0uL; (i < 8u) && (pcName[i] != '\0'); ++i)
+  {
+    aulArgs[1u + i / 4u] |= (uint32_t)(uint8_t)pcName[i] << (8u * (i % 4u));
+  }
+  vHW_TRACE_Timeline(HW_TRACE_TL_THREAD_NAME, 3uL, aulArgs);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Timeline: user region begins
+ *
+ * Regions must nest within the calling context.
+ *
+ * @param[in] uiRegion  Region ID
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_TRACE_RegionBegin(uint16_t uiRegion)
+{
+  uint32_t ulRegion = uiRegion;
+  vHW_TRACE_Timeline(HW_TRACE_TL_REGION_BEGIN, 1uL, &ulRegion);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Timeline: user region ends
+ *
+ * @param[in] uiRegion  Region ID
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_TRACE_RegionEnd(uint16_t uiRegion)
+{
+  uint32_t ulRegion = uiRegion;
+  vHW_TRACE_Timeline(HW_TRACE_TL_REGION_END, 1uL, &ulRegion);
+}
+#endif
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Encode record and write it to a stimulus port
+ *
+ * @param[in,out] *psEnc  Stream encoder
+ * @param[in] ulPort      ITM stimulus port
+ * @param[in] uiId        Event ID
+ * @param[in] ulNumArgs   Number of arguments (0..3)
+ * @param[in] *pulArgs    Arguments
+ * @return  (bool)      Record was preceded by a resync marker
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bHW_TRACE_Emit(TRACE_EncoderTypeDef* psEnc, uint32_t ulPort, uint16_t uiId,
+                           uint32_t ulNumArgs, const uint32_t* pulArgs)
+{
+  if (((ITM->TCR & ITM_TCR_ITMENA_Msk) == 0uL) || ((ITM->TER & (1uL << ulPort)) == 0uL))
+  {
+    vTRACE_RequestSync(psEnc);
+    return false;
+  }
+
+  uint32_t ulLock = ulHW_IRQ_Lock();
+
+  uint8_t aucRecord[(TRACE_ENCODE_MAX + 3u) & ~3u];
+  uint32_t ulLen = ulTRACE_Encode(psEnc, aucRecord, DWT->CYCCNT, uiId, ulNumArgs, pulArgs);
+  bool bSynced = (psEnc->ulSinceSync == 1uL);
+
+  for (uint32_t i = 0uL; i < ulLen; )
+  {
+    if (!bHW_TRACE_PortReady(ulPort))
+    {
+      vTRACE_RequestSync(psEnc);
+      ulDropped++;
+      bSynced = false;
+      break;
+    }
+
+    uint32_t ulRem = ulLen - i;
+    if (ulRem >= 4u)
+    {
+      uint32_t ulWord;
+      (void)memcpy(&ulWord, &aucRecord[i], sizeof(ulWord));
+      ITM->PORT[ulPort].u32 = ulWord;
+      i += 4u;
+    }
+    else if (ulRem >= 2u)
+    {
+      ITM->PORT[ulPort].u16 = (uint16_t)(aucRecord[i] | ((uint16_t)aucRecord[i + 1u] << 8));
+      i += 2u;
+    }
+    else
+    {
+      ITM->PORT[ulPort].u8 = aucRecord[i];
+      i += 1u;
+    }
+  }
+
+  vHW_IRQ_Unlock(ulLock);
+  return bSynced;
+}
+
+#if HW_TRACE_TIMELINE
+/*!****************************************************************************
+ * @brief
+ * Write timeline record, followed by the core clock after a resync marker
+ *
+ * @param[in] uiId        Event ID
+ * @param[in] ulNumArgs   Number of arguments (0..3)
+ * @param[in] *pulArgs    Arguments
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_TRACE_Timeline(uint16_t uiId, uint32_t ulNumArgs, const uint32_t* pulArgs)
+{
+  if (bHW_TRACE_Emit(&sTimeline, HW_TRACE_TL_PORT, uiId, ulNumArgs, pulArgs))
+  {
+    uint32_t ulFreq = ulHW_CLK_GetCoreClkFreq();
+    (void)bHW_TRACE_Emit(&sTimeline, HW_TRACE_TL_PORT, HW_TRACE_TL_CLOCK, 1uL, &ulFreq);
+  }
+}
+#endif
+
+/*!****************************************************************************
+ * @brief
+ * Check or wait for ITM stimulus port FIFO space
+ *
+ * @param[in] ulPort    ITM stimulus port
+ * @return  (bool)  Port can accept a write
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bHW_TRACE_PortReady(uint32_t ulPort)
+{
+#if HW_TRACE_BLOCKING
+  while (ITM->PORT[ulPort].u32 == 0uL)
+  {
+    __NOP();
+  }
+  return true;
+#else
+  return ITM->PORT[ulPort].u32 != 0uL;
+#endif
+}
@@ -0,0 +1,83 @@
+/*!****************************************************************************
+ * @file
+ * hw_trace.h
+ *
+ * @brief
+ * Hardware Layer - Compact binary event trace via ITM
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef HW_TRACE_H_
+#define HW_TRACE_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Number of trace streams
+#ifndef HW_TRACE_STREAMS
+#define HW_TRACE_STREAMS              2u
+#endif
+
+/// ITM stimulus port of first stream (one port per stream)
+#ifndef HW_TRACE_PORT_BASE
+#define HW_TRACE_PORT_BASE            2u
+#endif
+
+/// Wait for ITM FIFO space instead of dropping records
+#ifndef HW_TRACE_BLOCKING
+#define HW_TRACE_BLOCKING             0
+#endif
+
+/// Record exception, thread and region timeline
+#ifndef HW_TRACE_TIMELINE
+#define HW_TRACE_TIMELINE             1
+#endif
+
+/// ITM stimulus port of timeline stream
+#ifndef HW_TRACE_TL_PORT
+#define HW_TRACE_TL_PORT              (HW_TRACE_PORT_BASE + HW_TRACE_STREAMS)
+#endif
+
+/*! @brief Timeline event IDs
+ *  @{                                                                        */
+#define HW_TRACE_TL_EXC_ENTER         0xFF00u   ///< Handler entered, arg: exception number
+#define HW_TRACE_TL_EXC_EXIT          0xFF01u   ///< Handler left, arg: exception number
+#define HW_TRACE_TL_THREAD            0xFF02u   ///< Thread switched in, arg: thread
+#define HW_TRACE_TL_THREAD_NAME       0xFF03u   ///< Thread name, args: thread, 8 chars
+#define HW_TRACE_TL_REGION_BEGIN      0xFF04u   ///< Region begins, arg: region ID
+#define HW_TRACE_TL_REGION_END        0xFF05u   ///< Region ends, arg: region ID
+#define HW_TRACE_TL_CLOCK             0xFF06u   ///< Core clock, arg: frequency in Hz
+/*! @}                                                                        */
+
+/*! @brief Exception handler instrumentation
+ *  @{                                                                        */
+#if HW_TRACE_TIMELINE
+#define HW_TRACE_ISR_ENTER()          vHW_TRACE_ExcEnter()
+#define HW_TRACE_ISR_EXIT()           vHW_TRACE_ExcExit()
+#else
+#define HW_TRACE_ISR_ENTER()          ((void)0)
+#define HW_TRACE_ISR_EXIT()           ((void)0)
+#endif
+/*! @}                                                                        */
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vHW_TRACE_Init(void);
+void vHW_TRACE_Event(uint8_t ucStream, uint16_t uiId, uint32_t ulNumArgs,
+                     const uint32_t* pulArgs);
+uint32_t ulHW_TRACE_GetDropped(void);
+
+#if HW_TRACE_TIMELINE
+// Timeline
+void vHW_TRACE_ExcEnter(void);
+void vHW_TRACE_ExcExit(void);
+void vHW_TRACE_ThreadSwitch(const void* pvThread);
+void vHW_TRACE_ThreadName(const void* pvThread, const char* pcName);
+void vHW_TRACE_RegionBegin(uint16_t uiRegion);
+void vHW_TRACE_RegionEnd(uint16_t uiRegion);
+#endif
+
+#endif // HW_TRACE_H_
@@ -0,0 +1,787 @@
+/*!****************************************************************************
+ * @file
+ * hw_usb.c
+ *
+ * @brief
+ * Hardware Layer - USB full-speed CDC-ACM serial port
+ *
+ * Register-level driver for the USB device peripheral, running the control
+ * pipe and CDC-ACM function of lib/usbd. Endpoint registers:
+ *
+ *   EP0R  address 0     control, 64 bytes
+ *   EP1R  address 0x01  bulk OUT, double-buffered
+ *   EP2R  address 0x81  bulk IN, double-buffered
+ *   EP3R  address 0x82  interrupt IN (serial state, never sent)
+ *
+ * Bulk data is copied between the packet memory (PMA) and the caller's
+ * buffer directly, without an intermediate FIFO. While the application
+ * drains one OUT buffer, the host fills the other; the endpoint NAKs when
+ * both are full, which throttles the host. On the IN side, writers fill one
+ * buffer while the other one is transmitted. A full packet is submitted
+ * immediately, a partial one at the next start of frame (1 ms), so short
+ * writes are collected into one packet. A transfer ending on a full packet
+ * is terminated by a zero-length packet, which makes the host return it.
+ *
+ * Output is dropped while the port is not open (DTR clear) and when the
+ * host has not read for HW_USB_TX_TIMEOUT; the latter persists until the
+ * host reads again, so that printf() does not stall at each call.
+ *
+ * All events are served by the low-priority interrupt; the high-priority
+ * interrupt (double-buffered bulk only) is not used. The USB clock is
+ * 48 MHz, PLLCLK / 1.5 (see vHW_CLK_Init()). D+ is held low for
+ * HW_USB_DISCONNECT_TIME at start-up, so that the host enumerates the
+ * device again after a reset.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stddef.h>
+#include "stm32f1xx_hal.h"
+#include "hw_init.h"
+#include "hw_iodef.h"
+#include "hw_irq.h"
+#include "hw_layer.h"
+#include "hw_usb.h"
+#include "usbd.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Endpoint register n
+#define HW_USB_EPR(ulEpr)             (*(&USB->EP0R + 2u * (ulEpr)))
+
+/// Packet memory half-word at byte offset (16-bit words on a 32-bit stride)
+#define HW_USB_PMA(ulOff)             (((volatile uint32_t*)USB_PMAADDR)[(ulOff) / 2u])
+
+/// Buffer descriptor table entry field of endpoint register n (table at 0)
+#define HW_USB_BD(ulEpr, ulField)     HW_USB_PMA(8u * (ulEpr) + (ulField))
+
+/*! @brief Buffer descriptor fields; double-buffered endpoints use the TX
+ *  fields for buffer 0 and the RX fields for buffer 1
+ *  @{                                                                        */
+#define HW_USB_BD_ADDR_TX             0u
+#define HW_USB_BD_COUNT_TX            2u
+#define HW_USB_BD_ADDR_RX             4u
+#define HW_USB_BD_COUNT_RX            6u
+/*! @}                                                                        */
+
+/*! @brief Endpoint registers
+ *  @{                                                                        */
+#define HW_USB_EPR_CTRL               0u
+#define HW_USB_EPR_OUT                1u
+#define HW_USB_EPR_IN                 2u
+#define HW_USB_EPR_NOTIFY             3u
+/*! @}                                                                        */
+
+/*! @brief Packet memory layout (byte offsets)
+ *  @{                                                                        */
+#define HW_USB_PMA_EP0_TX             0x040u
+#define HW_USB_PMA_EP0_RX             0x080u
+#define HW_USB_PMA_OUT_0              0x0C0u
+#define HW_USB_PMA_OUT_1              0x100u
+#define HW_USB_PMA_IN_0               0x140u
+#define HW_USB_PMA_IN_1               0x180u
+#define HW_USB_PMA_NOTIFY             0x1C0u
+#define HW_USB_PMA_SIZE               512u
+/*! @}                                                                        */
+
+_Static_assert(HW_USB_PMA_NOTIFY + USBD_NOTIFY_SIZE <= HW_USB_PMA_SIZE, "packet memory exceeded");
+_Static_assert(USBD_EP0_SIZE == 64u && USBD_DATA_SIZE == 64u, "PMA layout assumes 64-byte packets");
+
+/// COUNT_RX for 64-byte buffers: BL_SIZE = 1 (32-byte blocks), NUM_BLOCK = 1
+#define HW_USB_COUNT_RX_64            0x8400u
+
+/// Byte count field of COUNT_x
+#define HW_USB_COUNT_MASK             0x03FFu
+
+/*! @brief SW_BUF bit of double-buffered endpoints (the unused direction's
+ *  DTOG bit)
+ *  @{                                                                        */
+#define HW_USB_EP_SWBUF_OUT           USB_EP_DTOG_TX
+#define HW_USB_EP_SWBUF_IN            USB_EP_DTOG_RX
+/*! @}                                                                        */
+
+/// Toggle-on-write bits of an endpoint register
+#define HW_USB_EP_TOGGLES             (USB_EP_DTOG_RX | USB_EPRX_STAT | USB_EP_DTOG_TX | USB_EPTX_STAT)
+
+/// Time in ms D+ is held low at start-up
+#define HW_USB_DISCONNECT_TIME        10uL
+
+/// Serial number length (96-bit unique ID in hex)
+#define HW_USB_SERIAL_LEN             24u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Bulk OUT state
+typedef struct {
+  uint8_t ucFull;                 ///< Buffers holding data (0..2)
+  uint8_t ucRead;                 ///< Buffer read by the application
+  uint32_t ulPos;                 ///< Read position in buffer ucRead
+} HW_USB_RxTypeDef;
+
+/// Bulk IN state
+typedef struct {
+  uint8_t ucFill;                 ///< Buffer filled by writers (= SW_BUF)
+  uint32_t ulLen;                 ///< Bytes in buffer ucFill
+  bool bBusy;                     ///< Other buffer being transmitted
+  bool bZlp;                      ///< Last packet was full, terminate transfer
+  bool bStalled;                  ///< Host did not read, drop output
+} HW_USB_TxTypeDef;
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vHW_USB_Ep0Send(const uint8_t* pucData, uint32_t ulLen);
+static void vHW_USB_Ep0Receive(void);
+static void vHW_USB_Ep0Stall(void);
+static void vHW_USB_SetAddress(uint8_t ucAddr);
+static void vHW_USB_Configure(bool bEnable);
+static void vHW_USB_SetHalt(uint8_t ucEp, bool bHalt);
+static bool bHW_USB_IsHalted(uint8_t ucEp);
+static void vHW_USB_BusReset(void);
+static void vHW_USB_Ep0Event(uint16_t uiEpr);
+static void vHW_USB_OpenEndpoint(uint32_t ulEpr);
+static void vHW_USB_TxSubmit(void);
+static void vHW_USB_SetStat(uint32_t ulEpr, uint16_t uiMask, uint16_t uiStat);
+static void vHW_USB_Toggle(uint32_t ulEpr, uint16_t uiBits);
+static void vHW_USB_ClearCtr(uint32_t ulEpr, uint16_t uiCtr);
+static void vHW_USB_WritePma(uint32_t ulAddr, const uint8_t* pucData, uint32_t ulLen);
+static void vHW_USB_ReadPma(uint32_t ulAddr, uint8_t* pucData, uint32_t ulLen);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Driver for the control pipe
+static const USBD_DriverTypeDef sDrv = {
+  .pfnEp0Send = vHW_USB_Ep0Send,
+  .pfnEp0Receive = vHW_USB_Ep0Receive,
+  .pfnEp0Stall = vHW_USB_Ep0Stall,
+  .pfnSetAddress = vHW_USB_SetAddress,
+  .pfnConfigure = vHW_USB_Configure,
+  .pfnSetHalt = vHW_USB_SetHalt,
+  .pfnIsHalted = bHW_USB_IsHalted
+};
+
+/// Serial number, filled in from the unique ID
+static char acSerial[HW_USB_SERIAL_LEN + 1u];
+
+/// Identification
+static const USBD_IdentTypeDef sIdent = {
+  .uiVendorId = HW_USB_VID,
+  .uiProductId = HW_USB_PID,
+  .pcManufacturer = "STMicroelectronics",
+  .pcProduct = "STM32F103 Virtual COM Port",
+  .pcSerial = acSerial
+};
+
+/// Device
+static USBD_TypeDef sDev;
+
+/// Bulk endpoint state
+static HW_USB_RxTypeDef sRx;
+static HW_USB_TxTypeDef sTx;
+
+/// Bus suspended
+static volatile bool bSuspended;
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise USB device and signal attach to the host
+ *
+ * - USB_DEV_DP_PIN: Open-drain output, low for HW_USB_DISCONNECT_TIME, then
+ *   released to the peripheral
+ *
+ * With HW_INIT_DIRECT, clocks and D+ are set up by the bring-up table. The
+ * interrupt priority is taken from the priority plan (hw_irq). Requires the
+ * system time.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_USB_Init(void)
+{
+  if (!HW_USB) return;
+
+#if !HW_INIT_DIRECT
+  __HAL_RCC_GPIOA_CLK_ENABLE();
+  __HAL_RCC_USB_CLK_ENABLE();
+
+  GPIO_InitTypeDef sPin = {
+    .Pin = USB_DEV_DP_PIN,
+    .Mode = GPIO_MODE_OUTPUT_OD,
+    .Pull = GPIO_NOPULL,
+    .Speed = GPIO_SPEED_FREQ_LOW
+  };
+  HAL_GPIO_WritePin(USB_DEV_PORT, USB_DEV_DP_PIN, GPIO_PIN_RESET);
+  HAL_GPIO_Init(USB_DEV_PORT, &sPin);
+#endif
+
+  // Serial number: unique ID in hex, most significant word first
+  static const char acHex[] = "0123456789ABCDEF";
+  const uint32_t* pulUid = pulHW_GetUID();
+  for (uint32_t i = 0uL; i < HW_USB_SERIAL_LEN; ++i)
+  {
+    uint32_t ulWord = pulUid[2u - i / 8u];
+    acSerial[i] = acHex[(ulWord >> (28u - 4u * (i % 8u))) & 0xFu];
+  }
+  vUSBD_Init(&sDev, &sDrv, &sIdent);
+
+  // Release D+, the pull-up signals attach
+  HAL_Delay(HW_USB_DISCONNECT_TIME);
+  HAL_GPIO_DeInit(USB_DEV_PORT, USB_DEV_DP_PIN);
+
+  // Power up transceiver (t_STARTUP 1 us), then release reset
+  USB->CNTR = USB_CNTR_FRES;
+  HAL_Delay(1uL);
+  USB->CNTR = 0u;
+  USB->ISTR = 0u;
+  USB->CNTR = USB_CNTR_CTRM | USB_CNTR_RESETM | USB_CNTR_SUSPM | USB_CNTR_WKUPM;
+
+  HAL_NVIC_EnableIRQ(USB_DEV_IRQn);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if a terminal has the port open
+ *
+ * @return  (bool)  Configured, not suspended and DTR set
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_USB_IsConnected(void)
+{
+  return bUSBD_IsConfigured(&sDev) && !bSuspended &&
+         ((uiUSBD_GetLines(&sDev) & USBD_LINE_DTR) != 0u);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Send data to the host
+ *
+ * Waits while both IN buffers are in use, at most HW_USB_TX_TIMEOUT without
+ * progress. Never waits in interrupt handlers.
+ *
+ * @param[in] *pvData   Data
+ * @param[in] ulLen     Number of bytes
+ * @return  (uint32_t)  Number of bytes accepted, the rest was dropped
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulHW_USB_Write(const void* pvData, uint32_t ulLen)
+{
+  const uint8_t* pucData = (const uint8_t*)pvData;
+  bool bWait = (__get_IPSR() == 0uL);
+  uint32_t ulStart = HAL_GetTick();
+  uint32_t ulDone = 0uL;
+
+  while ((ulDone < ulLen) && bHW_USB_IsConnected())
+  {
+    uint32_t ulLock = ulHW_IRQ_Lock();
+    bool bDrop = sTx.bStalled;
+    uint32_t ulFree = USBD_DATA_SIZE - sTx.ulLen;
+    if (!bDrop && (ulFree != 0uL))
+    {
+      uint32_t ulChunk = (ulLen - ulDone < ulFree) ? ulLen - ulDone : ulFree;
+      uint32_t ulBuf = (sTx.ucFill == 0u) ? HW_USB_PMA_IN_0 : HW_USB_PMA_IN_1;
+      vHW_USB_WritePma(ulBuf + sTx.ulLen, &pucData[ulDone], ulChunk);
+      sTx.ulLen += ulChunk;
+      ulDone += ulChunk;
+      if ((sTx.ulLen == USBD_DATA_SIZE) && !sTx.bBusy) vHW_USB_TxSubmit();
+
+      // Partial packet or zero-length packet sent at start of frame
+      USB->CNTR |= USB_CNTR_SOFM;
+      ulStart = HAL_GetTick();
+    }
+    else if (!bDrop && (!bWait || (HAL_GetTick() - ulStart >= HW_USB_TX_TIMEOUT)))
+    {
+      sTx.bStalled = bWait;
+      bDrop = true;
+    }
+    vHW_IRQ_Unlock(ulLock);
+
+    if (bDrop) break;
+  }
+  return ulDone;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Receive data from the host without waiting
+ *
+ * @param[out] *pvData  Buffer
+ * @param[in] ulLen     Buffer size
+ * @return  (uint32_t)  Number of bytes received
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulHW_USB_Read(void* pvData, uint32_t ulLen)
+{
+  uint8_t* pucData = (uint8_t*)pvData;
+  uint32_t ulDone = 0uL;
+
+  uint32_t ulLock = ulHW_IRQ_Lock();
+  while ((ulDone < ulLen) && (sRx.ucFull != 0u))
+  {
+    uint32_t ulBuf = (sRx.ucRead == 0u) ? HW_USB_PMA_OUT_0 : HW_USB_PMA_OUT_1;
+    uint32_t ulField = (sRx.ucRead == 0u) ? HW_USB_BD_COUNT_TX : HW_USB_BD_COUNT_RX;
+    uint32_t ulCount = HW_USB_BD(HW_USB_EPR_OUT, ulField) & HW_USB_COUNT_MASK;
+    uint32_t ulChunk = ulCount - sRx.ulPos;
+    if (ulChunk > ulLen - ulDone) ulChunk = ulLen - ulDone;
+
+    vHW_USB_ReadPma(ulBuf + sRx.ulPos, &pucData[ulDone], ulChunk);
+    sRx.ulPos += ulChunk;
+    ulDone += ulChunk;
+
+    // Buffer drained: hand it back, take over the other one if filled
+    if (sRx.ulPos >= ulCount)
+    {
+      sRx.ulPos = 0uL;
+      sRx.ucRead ^= 1u;
+      sRx.ucFull--;
+      if (sRx.ucFull != 0u) vHW_USB_Toggle(HW_USB_EPR_OUT, HW_USB_EP_SWBUF_OUT);
+    }
+  }
+  vHW_IRQ_Unlock(ulLock);
+  return ulDone;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if received data is available
+ *
+ * @return  (bool)  Data available
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_USB_IsDataAvailable(void)
+{
+  return sRx.ucFull != 0u;
+}
+
+/*!****************************************************************************
+ * @brief
+ * USB low-priority interrupt handler
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_USB_IRQHandler(void)
+{
+  uint16_t uiIstr = USB->ISTR;
+
+  if ((uiIstr & USB_ISTR_RESET) != 0u)
+  {
+    USB->ISTR = (uint16_t)~USB_ISTR_RESET;
+    vHW_USB_BusReset();
+  }
+
+  // Correct transfers, highest priority endpoint first
+  while (((uiIstr = USB->ISTR) & USB_ISTR_CTR) != 0u)
+  {
+    uint32_t ulEpr = uiIstr & USB_ISTR_EP_ID;
+    uint16_t uiEpr = HW_USB_EPR(ulEpr);
+
+    switch (ulEpr)
+    {
+      case HW_USB_EPR_CTRL:
+        vHW_USB_Ep0Event(uiEpr);
+        break;
+
+      case HW_USB_EPR_OUT:
+        // Take over the filled buffer unless the application still reads one
+        vHW_USB_ClearCtr(ulEpr, USB_EP_CTR_RX);
+        sRx.ucFull++;
+        if (sRx.ucFull == 1u) vHW_USB_Toggle(ulEpr, HW_USB_EP_SWBUF_OUT);
+        break;
+
+      case HW_USB_EPR_IN:
+        vHW_USB_ClearCtr(ulEpr, USB_EP_CTR_TX);
+        sTx.bBusy = false;
+        sTx.bStalled = false;
+        if (sTx.ulLen == USBD_DATA_SIZE) vHW_USB_TxSubmit();
+        break;
+
+      default:
+        vHW_USB_ClearCtr(ulEpr, USB_EP_CTR_RX | USB_EP_CTR_TX);
+        break;
+    }
+  }
+
+  if ((uiIstr & USB_ISTR_SOF) != 0u)
+  {
+    USB->ISTR = (uint16_t)~USB_ISTR_SOF;
+    if (!sTx.bBusy && ((sTx.ulLen != 0uL) || sTx.bZlp))
+    {
+      vHW_USB_TxSubmit();
+    }
+    else if (!sTx.bBusy)
+    {
+      USB->CNTR &= (uint16_t)~USB_CNTR_SOFM;
+    }
+  }
+
+  if ((uiIstr & USB_ISTR_SUSP) != 0u)
+  {
+    USB->CNTR |= USB_CNTR_FSUSP;
+    USB->ISTR = (uint16_t)~USB_ISTR_SUSP;
+    bSuspended = true;
+  }
+
+  if ((uiIstr & USB_ISTR_WKUP) != 0u)
+  {
+    USB->CNTR &= (uint16_t)~USB_CNTR_FSUSP;
+    USB->ISTR = (uint16_t)~USB_ISTR_WKUP;
+    bSuspended = false;
+  }
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Driver: send one packet on EP0
+ *
+ * @param[in] *pucData  Packet data
+ * @param[in] ulLen     Packet length
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_USB_Ep0Send(const uint8_t* pucData, uint32_t ulLen)
+{
+  vHW_USB_WritePma(HW_USB_PMA_EP0_TX, pucData, ulLen);
+  HW_USB_BD(HW_USB_EPR_CTRL, HW_USB_BD_COUNT_TX) = ulLen;
+  vHW_USB_SetStat(HW_USB_EPR_CTRL, USB_EPTX_STAT, USB_EP_TX_VALID);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: accept one packet on EP0
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_USB_Ep0Receive(void)
+{
+  vHW_USB_SetStat(HW_USB_EPR_CTRL, USB_EPRX_STAT, USB_EP_RX_VALID);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: stall EP0 until the next setup packet
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_USB_Ep0Stall(void)
+{
+  vHW_USB_SetStat(HW_USB_EPR_CTRL, USB_EPTX_STAT | USB_EPRX_STAT,
+                  USB_EP_TX_STALL | USB_EP_RX_STALL);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: apply device address
+ *
+ * @param[in] ucAddr  Address
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_USB_SetAddress(uint8_t ucAddr)
+{
+  USB->DADDR = USB_DADDR_EF | ucAddr;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: enable or disable CDC endpoints
+ *
+ * Buffered data is discarded in both cases.
+ *
+ * @param[in] bEnable   Enable
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_USB_Configure(bool bEnable)
+{
+  for (uint32_t ulEpr = HW_USB_EPR_OUT; ulEpr <= HW_USB_EPR_NOTIFY; ++ulEpr)
+  {
+    if (bEnable)
+    {
+      vHW_USB_OpenEndpoint(ulEpr);
+    }
+    else
+    {
+      // Disabled: all toggle bits 0
+      HW_USB_EPR(ulEpr) = HW_USB_EPR(ulEpr) & HW_USB_EP_TOGGLES;
+    }
+  }
+  if (!bEnable) USB->CNTR &= (uint16_t)~USB_CNTR_SOFM;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: set or clear halt of a CDC endpoint
+ *
+ * Clearing the halt resets the data toggle and discards buffered data.
+ *
+ * @param[in] ucEp    Endpoint address
+ * @param[in] bHalt   Halt
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_USB_SetHalt(uint8_t ucEp, bool bHalt)
+{
+  uint32_t ulEpr = (ucEp == USBD_EP_DATA_OUT) ? HW_USB_EPR_OUT :
+                   (ucEp == USBD_EP_DATA_IN) ? HW_USB_EPR_IN : HW_USB_EPR_NOTIFY;
+
+  if (!bHalt)
+  {
+    vHW_USB_OpenEndpoint(ulEpr);
+  }
+  else if (ulEpr == HW_USB_EPR_OUT)
+  {
+    vHW_USB_SetStat(ulEpr, USB_EPRX_STAT, USB_EP_RX_STALL);
+  }
+  else
+  {
+    vHW_USB_SetStat(ulEpr, USB_EPTX_STAT, USB_EP_TX_STALL);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: get halt state of a CDC endpoint
+ *
+ * @param[in] ucEp    Endpoint address
+ * @return  (bool)  Halted
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bHW_USB_IsHalted(uint8_t ucEp)
+{
+  if (ucEp == USBD_EP_DATA_OUT)
+  {
+    return (HW_USB_EPR(HW_USB_EPR_OUT) & USB_EPRX_STAT) == USB_EP_RX_STALL;
+  }
+  uint32_t ulEpr = (ucEp == USBD_EP_DATA_IN) ? HW_USB_EPR_IN : HW_USB_EPR_NOTIFY;
+  return (HW_USB_EPR(ulEpr) & USB_EPTX_STAT) == USB_EP_TX_STALL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Bus reset: set up EP0, enable address 0
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_USB_BusReset(void)
+{
+  USB->BTABLE = 0u;
+  HW_USB_BD(HW_USB_EPR_CTRL, HW_USB_BD_ADDR_TX) = HW_USB_PMA_EP0_TX;
+  HW_USB_BD(HW_USB_EPR_CTRL, HW_USB_BD_COUNT_TX) = 0u;
+  HW_USB_BD(HW_USB_EPR_CTRL, HW_USB_BD_ADDR_RX) = HW_USB_PMA_EP0_RX;
+  HW_USB_BD(HW_USB_EPR_CTRL, HW_USB_BD_COUNT_RX) = HW_USB_COUNT_RX_64;
+  HW_USB_EPR(HW_USB_EPR_CTRL) = USB_EP_CONTROL |
+    ((HW_USB_EPR(HW_USB_EPR_CTRL) & HW_USB_EP_TOGGLES) ^ (USB_EP_RX_VALID | USB_EP_TX_NAK));
+
+  USB->DADDR = USB_DADDR_EF;
+  bSuspended = false;
+  vUSBD_Reset(&sDev);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Handle correct transfer on EP0
+ *
+ * A completed IN packet is handled before a received packet, so that a
+ * status or setup packet following the last IN data is seen in order.
+ *
+ * @param[in] uiEpr   EP0R value
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_USB_Ep0Event(uint16_t uiEpr)
+{
+  if ((uiEpr & USB_EP_CTR_TX) != 0u)
+  {
+    vHW_USB_ClearCtr(HW_USB_EPR_CTRL, USB_EP_CTR_TX);
+    vUSBD_Ep0InDone(&sDev);
+  }
+
+  if ((uiEpr & USB_EP_CTR_RX) != 0u)
+  {
+    uint8_t aucPacket[USBD_EP0_SIZE];
+    uint32_t ulLen = HW_USB_BD(HW_USB_EPR_CTRL, HW_USB_BD_COUNT_RX) & HW_USB_COUNT_MASK;
+    if (ulLen > USBD_EP0_SIZE) ulLen = USBD_EP0_SIZE;
+    vHW_USB_ReadPma(HW_USB_PMA_EP0_RX, aucPacket, ulLen);
+    vHW_USB_ClearCtr(HW_USB_EPR_CTRL, USB_EP_CTR_RX);
+
+    if ((uiEpr & USB_EP_SETUP) == 0u)
+    {
+      vUSBD_Ep0Out(&sDev, aucPacket, ulLen);
+    }
+    else if (ulLen == USBD_SETUP_SIZE)
+    {
+      vUSBD_Setup(&sDev, aucPacket);
+    }
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Set up CDC endpoint with data toggle 0 and empty buffers
+ *
+ * - OUT: DTOG_RX 0 (host fills buffer 0), SW_BUF 1, valid
+ * - IN: DTOG_TX 0, SW_BUF 0 (writers fill buffer 0, NAK until submitted), valid
+ * - Notification: NAK
+ *
+ * @param[in] ulEpr   Endpoint register
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_USB_OpenEndpoint(uint32_t ulEpr)
+{
+  uint16_t uiConf;
+  uint16_t uiToggles;
+
+  switch (ulEpr)
+  {
+    case HW_USB_EPR_OUT:
+      HW_USB_BD(ulEpr, HW_USB_BD_ADDR_TX) = HW_USB_PMA_OUT_0;
+      HW_USB_BD(ulEpr, HW_USB_BD_COUNT_TX) = HW_USB_COUNT_RX_64;
+      HW_USB_BD(ulEpr, HW_USB_BD_ADDR_RX) = HW_USB_PMA_OUT_1;
+      HW_USB_BD(ulEpr, HW_USB_BD_COUNT_RX) = HW_USB_COUNT_RX_64;
+      uiConf = USB_EP_BULK | USB_EP_KIND | (USBD_EP_DATA_OUT & 0x0Fu);
+      uiToggles = USB_EP_RX_VALID | HW_USB_EP_SWBUF_OUT;
+      sRx.ucFull = 0u;
+      sRx.ucRead = 0u;
+      sRx.ulPos = 0uL;
+      break;
+
+    case HW_USB_EPR_IN:
+      HW_USB_BD(ulEpr, HW_USB_BD_ADDR_TX) = HW_USB_PMA_IN_0;
+      HW_USB_BD(ulEpr, HW_USB_BD_COUNT_TX) = 0u;
+      HW_USB_BD(ulEpr, HW_USB_BD_ADDR_RX) = HW_USB_PMA_IN_1;
+      HW_USB_BD(ulEpr, HW_USB_BD_COUNT_RX) = 0u;
+      uiConf = USB_EP_BULK | USB_EP_KIND | (USBD_EP_DATA_IN & 0x0Fu);
+      uiToggles = USB_EP_TX_VALID;
+      sTx.ucFill = 0u;
+      sTx.ulLen = 0uL;
+      sTx.bBusy = false;
+      sTx.bZlp = false;
+      sTx.bStalled = false;
+      break;
+
+    default:
+      HW_USB_BD(ulEpr, HW_USB_BD_ADDR_TX) = HW_USB_PMA_NOTIFY;
+      HW_USB_BD(ulEpr, HW_USB_BD_COUNT_TX) = 0u;
+      uiConf = USB_EP_INTERRUPT | (USBD_EP_NOTIFY & 0x0Fu);
+      uiToggles = USB_EP_TX_NAK;
+      break;
+  }
+
+  // CTR bits written as 0 are cleared, toggle bits flip where written as 1
+  HW_USB_EPR(ulEpr) = uiConf | ((HW_USB_EPR(ulEpr) & HW_USB_EP_TOGGLES) ^ uiToggles);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Submit fill buffer for transmission and switch writers to the other one
+ *
+ * Only called while no packet is in flight.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_USB_TxSubmit(void)
+{
+  uint32_t ulField = (sTx.ucFill == 0u) ? HW_USB_BD_COUNT_TX : HW_USB_BD_COUNT_RX;
+  HW_USB_BD(HW_USB_EPR_IN, ulField) = sTx.ulLen;
+  vHW_USB_Toggle(HW_USB_EPR_IN, HW_USB_EP_SWBUF_IN);
+
+  sTx.bZlp = (sTx.ulLen == USBD_DATA_SIZE);
+  sTx.ucFill ^= 1u;
+  sTx.ulLen = 0uL;
+  sTx.bBusy = true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Set STAT_RX and/or STAT_TX of an endpoint register
+ *
+ * @param[in] ulEpr   Endpoint register
+ * @param[in] uiMask  USB_EPRX_STAT and/or USB_EPTX_STAT
+ * @param[in] uiStat  New status bits
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_USB_SetStat(uint32_t ulEpr, uint16_t uiMask, uint16_t uiStat)
+{
+  uint16_t uiEpr = HW_USB_EPR(ulEpr) & (USB_EPREG_MASK | uiMask);
+  HW_USB_EPR(ulEpr) = (uiEpr ^ uiStat) | USB_EP_CTR_RX | USB_EP_CTR_TX;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Flip toggle bits of an endpoint register
+ *
+ * @param[in] ulEpr   Endpoint register
+ * @param[in] uiBits  DTOG_x bits to flip
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_USB_Toggle(uint32_t ulEpr, uint16_t uiBits)
+{
+  HW_USB_EPR(ulEpr) = (HW_USB_EPR(ulEpr) & USB_EPREG_MASK) | USB_EP_CTR_RX | USB_EP_CTR_TX | uiBits;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Clear correct transfer flags of an endpoint register
+ *
+ * @param[in] ulEpr   Endpoint register
+ * @param[in] uiCtr   USB_EP_CTR_RX and/or USB_EP_CTR_TX
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_USB_ClearCtr(uint32_t ulEpr, uint16_t uiCtr)
+{
+  HW_USB_EPR(ulEpr) = ((HW_USB_EPR(ulEpr) & USB_EPREG_MASK) | USB_EP_CTR_RX | USB_EP_CTR_TX) &
+                      (uint16_t)~uiCtr;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Copy data to packet memory
+ *
+ * An odd start address merges into the high byte of the half-word.
+ *
+ * @param[in] ulAddr    Packet memory byte address
+ * @param[in] *pucData  Data
+ * @param[in] ulLen     Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_USB_WritePma(uint32_t ulAddr, const uint8_t* pucData, uint32_t ulLen)
+{
+  volatile uint32_t* pulPma = &HW_USB_PMA(ulAddr);
+  uint32_t i = 0uL;
+
+  if (((ulAddr & 1uL) != 0uL) && (ulLen != 0uL))
+  {
+    *pulPma = (*pulPma & 0x00FFuL) | ((uint32_t)pucData[0] << 8);
+    pulPma++;
+    i = 1uL;
+  }
+  for (; i + 1uL < ulLen; i += 2uL)
+  {
+    *pulPma++ = (uint32_t)pucData[i] | ((uint32_t)pucData[i + 1u] << 8);
+  }
+  if (i < ulLen) *pulPma = pucData[i];
+}
+
+/*!****************************************************************************
+ * @brief
+ * Copy data from packet memory
+ *
+ * @param[in] ulAddr    Packet memory byte address
+ * @param[out] *pucData Buffer
+ * @param[in] ulLen     Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vHW_USB_ReadPma(uint32_t ulAddr, uint8_t* pucData, uint32_t ulLen)
+{
+  const volatile uint32_t* pulPma = &HW_USB_PMA(ulAddr);
+  uint32_t i = 0uL;
+
+  if (((ulAddr & 1uL) != 0uL) && (ulLen != 0uL))
+  {
+    pucData[i++] = (uint8_t)(*pulPma++ >> 8);
+  }
+  for (; i + 1uL < ulLen; i += 2uL)
+  {
+    uint32_t ulWord = *pulPma++;
+    pucData[i] = (uint8_t)ulWord;
+    pucData[i + 1u] = (uint8_t)(ulWord >> 8);
+  }
+  if (i < ulLen) pucData[i] = (uint8_t)*pulPma;
+}
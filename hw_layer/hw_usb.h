@@ -0,0 +1,48 @@
+/*!****************************************************************************
+ * @file
+ * hw_usb.h
+ *
+ * @brief
+ * Hardware Layer - USB full-speed CDC-ACM serial port
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef HW_USB_H_
+#define HW_USB_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Enable USB device
+#ifndef HW_USB
+#define HW_USB                        1
+#endif
+
+/// Vendor and product ID (ST virtual COM port)
+#ifndef HW_USB_VID
+#define HW_USB_VID                    0x0483u
+#endif
+#ifndef HW_USB_PID
+#define HW_USB_PID                    0x5740u
+#endif
+
+/// Time in ms a writer waits for the host before output is dropped
+#ifndef HW_USB_TX_TIMEOUT
+#define HW_USB_TX_TIMEOUT             20uL
+#endif
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vHW_USB_Init(void);
+bool bHW_USB_IsConnected(void);
+uint32_t ulHW_USB_Write(const void* pvData, uint32_t ulLen);
+uint32_t ulHW_USB_Read(void* pvData, uint32_t ulLen);
+bool bHW_USB_IsDataAvailable(void);
+
+void vHW_USB_IRQHandler(void);
+
+#endif // HW_USB_H_
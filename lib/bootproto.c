@@ -0,0 +1,459 @@
+/*!****************************************************************************
+ * @file
+ * bootproto.c
+ *
+ * @brief
+ * Serial bootloader protocol and image handling
+ *
+ * The uploader sends fixed-size frames: START (image length and CRC-32),
+ * one DATA frame per flash page, and END. Each frame carries a sequence
+ * number (START is 0, END follows the last page) and a CRC-32, and is
+ * answered with a 4-byte response. Up to BOOT_WINDOW frames are sent ahead,
+ * so the bootloader programs one page while the next one arrives. A damaged
+ * or unexpected frame is answered with RESEND and the next expected sequence
+ * number, from where the uploader goes back; duplicates are acknowledged
+ * again without being processed.
+ *
+ * The first page (vector table) is held in RAM and programmed only after the
+ * CRC of the whole image has been verified, so an interrupted update leaves
+ * an erased first page and the bootloader does not start the application.
+ * START erases the first page for the same reason.
+ *
+ * The module only depends on a flash driver and is used unchanged by the
+ * bootloader, the host uploader and the loopback simulator (tools/).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <string.h>
+#include "bootproto.h"
+#include "crc32.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Largest sequence number (16-bit field)
+#define BOOT_SEQ_MAX                  0xFFFFu
+
+
+/*- Private functions --------------------------------------------------------*/
+static uint32_t ulBOOT_Get16(const uint8_t* pucData);
+static uint32_t ulBOOT_Get32(const uint8_t* pucData);
+static void vBOOT_Put16(uint8_t* pucData, uint32_t ulValue);
+static void vBOOT_Put32(uint8_t* pucData, uint32_t ulValue);
+static BOOT_StatusTypeDef eBOOT_Start(BOOT_TargetTypeDef* psTarget, const uint8_t* pucFrame);
+static BOOT_StatusTypeDef eBOOT_Data(BOOT_TargetTypeDef* psTarget, uint32_t ulSeq,
+                                     const uint8_t* pucData);
+static BOOT_StatusTypeDef eBOOT_End(BOOT_TargetTypeDef* psTarget);
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Check if the application region holds a startable image
+ *
+ * Only the vector table is checked (initial stack pointer in RAM, reset
+ * handler in Thumb state inside the region), so this takes microseconds.
+ * The image CRC was verified before the vector table was programmed.
+ *
+ * @param[in] *psFlash    Application region
+ * @param[in] ulRamBase   RAM start address
+ * @param[in] ulRamSize   RAM size in bytes
+ * @return  (bool)  Application can be started
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bBOOT_IsAppValid(const BOOT_FlashTypeDef* psFlash, uint32_t ulRamBase, uint32_t ulRamSize)
+{
+  uint32_t ulSp = ulBOOT_Get32(&psFlash->pucBase[0]);
+  uint32_t ulReset = ulBOOT_Get32(&psFlash->pucBase[4]);
+
+  return (ulSp > ulRamBase) && (ulSp <= ulRamBase + ulRamSize) && ((ulSp & 3uL) == 0uL) &&
+         ((ulReset & 1uL) != 0uL) && (ulReset - psFlash->ulAddr < psFlash->ulSize);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Encode response
+ *
+ * @param[out] *pucResp   Response, BOOT_RESP_SIZE bytes
+ * @param[in] eStatus     Status
+ * @param[in] ulSeq       Sequence number
+ * @date  19.10.2026
+ ******************************************************************************/
+void vBOOT_PutResponse(uint8_t* pucResp, BOOT_StatusTypeDef eStatus, uint32_t ulSeq)
+{
+  pucResp[BOOT_RESP_SYNC] = BOOT_SYNC_RESP;
+  pucResp[BOOT_RESP_STATUS] = (uint8_t)eStatus;
+  vBOOT_Put16(&pucResp[BOOT_RESP_SEQ], ulSeq);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Initialise receiving side
+ *
+ * @param[out] *psTarget  Receiver
+ * @param[in] *psFlash    Application region
+ * @date  19.10.2026
+ ******************************************************************************/
+void vBOOT_TargetInit(BOOT_TargetTypeDef* psTarget, const BOOT_FlashTypeDef* psFlash)
+{
+  psTarget->psFlash = psFlash;
+  psTarget->bActive = false;
+  psTarget->ulNextSeq = 0uL;
+  psTarget->ulEndSeq = 0uL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Process received frame
+ *
+ * Blocks for the duration of a page erase and program. On RESEND, the
+ * caller discards input until the line is idle before sending the response,
+ * so that the next frame is received from its start.
+ *
+ * @param[in,out] *psTarget   Receiver
+ * @param[in] *pucFrame       Frame, BOOT_FRAME_SIZE bytes
+ * @param[out] *pucResp       Response, BOOT_RESP_SIZE bytes
+ * @return  (BOOT_StatusTypeDef)  Response status
+ * @date  19.10.2026
+ ******************************************************************************/
+BOOT_StatusTypeDef eBOOT_TargetFrame(BOOT_TargetTypeDef* psTarget, const uint8_t* pucFrame,
+                                     uint8_t* pucResp)
+{
+  uint32_t ulSeq = ulBOOT_Get16(&pucFrame[BOOT_FRAME_SEQ]);
+  uint32_t ulCmd = pucFrame[BOOT_FRAME_CMD];
+  BOOT_StatusTypeDef eStatus;
+
+  if ((pucFrame[BOOT_FRAME_SYNC] != BOOT_SYNC) ||
+      (ulBOOT_Get32(&pucFrame[BOOT_FRAME_CRC]) != ulCRC32_Update(CRC32_INIT, pucFrame, BOOT_FRAME_CRC)))
+  {
+    eStatus = BOOT_STATUS_RESEND;
+    ulSeq = psTarget->ulNextSeq;
+  }
+  else if ((ulCmd == BOOT_CMD_START) && (ulSeq == 0uL))
+  {
+    // Always (re)starts, a duplicate only costs a go-back
+    eStatus = eBOOT_Start(psTarget, pucFrame);
+  }
+  else if (!psTarget->bActive)
+  {
+    eStatus = BOOT_STATUS_ORDER;
+  }
+  else if (ulSeq < psTarget->ulNextSeq)
+  {
+    // Response was lost
+    eStatus = (ulSeq == psTarget->ulEndSeq) ? BOOT_STATUS_DONE : BOOT_STATUS_ACK;
+  }
+  else if (ulSeq > psTarget->ulNextSeq)
+  {
+    eStatus = BOOT_STATUS_RESEND;
+    ulSeq = psTarget->ulNextSeq;
+  }
+  else if ((ulCmd == BOOT_CMD_DATA) && (ulSeq < psTarget->ulEndSeq))
+  {
+    eStatus = eBOOT_Data(psTarget, ulSeq, &pucFrame[BOOT_FRAME_DATA]);
+  }
+  else if ((ulCmd == BOOT_CMD_END) && (ulSeq == psTarget->ulEndSeq))
+  {
+    eStatus = eBOOT_End(psTarget);
+  }
+  else
+  {
+    eStatus = BOOT_STATUS_ORDER;
+  }
+
+  if ((eStatus == BOOT_STATUS_ACK) || (eStatus == BOOT_STATUS_DONE))
+  {
+    if (ulSeq == psTarget->ulNextSeq) psTarget->ulNextSeq++;
+  }
+  else if (eStatus != BOOT_STATUS_RESEND)
+  {
+    psTarget->bActive = false;
+  }
+
+  vBOOT_PutResponse(pucResp, eStatus, ulSeq);
+  return eStatus;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Initialise sending side
+ *
+ * @param[out] *psHost    Sender
+ * @param[in] *pucImage   Image, must stay valid until done
+ * @param[in] ulLength    Image length in bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+void vBOOT_HostInit(BOOT_HostTypeDef* psHost, const uint8_t* pucImage, uint32_t ulLength)
+{
+  psHost->pucImage = pucImage;
+  psHost->ulLength = ulLength;
+  psHost->ulCrc = ulCRC32_Update(CRC32_INIT, pucImage, ulLength);
+  psHost->ulEndSeq = (ulLength + BOOT_PAGE_SIZE - 1u) / BOOT_PAGE_SIZE + 1u;
+  psHost->ulNext = 0uL;
+  psHost->ulAcked = 0uL;
+  psHost->ulResends = 0uL;
+  psHost->bDone = false;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get next frame to send, if the window allows
+ *
+ * @param[in,out] *psHost   Sender
+ * @param[out] *pucFrame    Frame, BOOT_FRAME_SIZE bytes
+ * @return  (bool)  Frame to send
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bBOOT_HostNextFrame(BOOT_HostTypeDef* psHost, uint8_t* pucFrame)
+{
+  if (psHost->bDone || (psHost->ulNext > psHost->ulEndSeq) ||
+      (psHost->ulNext >= psHost->ulAcked + BOOT_WINDOW))
+  {
+    return false;
+  }
+
+  uint32_t ulSeq = psHost->ulNext++;
+  (void)memset(pucFrame, 0xFF, BOOT_FRAME_SIZE);
+  pucFrame[BOOT_FRAME_SYNC] = BOOT_SYNC;
+  vBOOT_Put16(&pucFrame[BOOT_FRAME_SEQ], ulSeq);
+  vBOOT_Put32(&pucFrame[BOOT_FRAME_ARG], 0uL);
+  if (ulSeq == 0uL)
+  {
+    pucFrame[BOOT_FRAME_CMD] = BOOT_CMD_START;
+    vBOOT_Put32(&pucFrame[BOOT_FRAME_ARG], psHost->ulLength);
+    vBOOT_Put32(&pucFrame[BOOT_FRAME_DATA], psHost->ulCrc);
+  }
+  else if (ulSeq < psHost->ulEndSeq)
+  {
+    uint32_t ulOffset = (ulSeq - 1u) * BOOT_PAGE_SIZE;
+    uint32_t ulLen = psHost->ulLength - ulOffset;
+    pucFrame[BOOT_FRAME_CMD] = BOOT_CMD_DATA;
+    (void)memcpy(&pucFrame[BOOT_FRAME_DATA], &psHost->pucImage[ulOffset],
+                 (ulLen < BOOT_PAGE_SIZE) ? ulLen : BOOT_PAGE_SIZE);
+  }
+  else
+  {
+    pucFrame[BOOT_FRAME_CMD] = BOOT_CMD_END;
+  }
+  vBOOT_Put32(&pucFrame[BOOT_FRAME_CRC], ulCRC32_Update(CRC32_INIT, pucFrame, BOOT_FRAME_CRC));
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Process response
+ *
+ * A response without sync byte is treated like a timeout.
+ *
+ * @param[in,out] *psHost   Sender
+ * @param[in] *pucResp      Response, BOOT_RESP_SIZE bytes
+ * @return  (BOOT_StatusTypeDef)  Response status, SIZE and above end the upload
+ * @date  19.10.2026
+ ******************************************************************************/
+BOOT_StatusTypeDef eBOOT_HostResponse(BOOT_HostTypeDef* psHost, const uint8_t* pucResp)
+{
+  if (pucResp[BOOT_RESP_SYNC] != BOOT_SYNC_RESP)
+  {
+    vBOOT_HostTimeout(psHost);
+    return BOOT_STATUS_RESEND;
+  }
+
+  BOOT_StatusTypeDef eStatus = (BOOT_StatusTypeDef)pucResp[BOOT_RESP_STATUS];
+  uint32_t ulSeq = ulBOOT_Get16(&pucResp[BOOT_RESP_SEQ]);
+  switch (eStatus)
+  {
+    case BOOT_STATUS_ACK:
+      if (ulSeq == psHost->ulAcked) psHost->ulAcked++;
+      break;
+
+    case BOOT_STATUS_RESEND:
+      if (ulSeq <= psHost->ulEndSeq)
+      {
+        psHost->ulAcked = ulSeq;
+        psHost->ulNext = ulSeq;
+        psHost->ulResends++;
+      }
+      break;
+
+    case BOOT_STATUS_DONE:
+      if (ulSeq == psHost->ulEndSeq)
+      {
+        psHost->ulAcked = ulSeq + 1u;
+        psHost->bDone = true;
+      }
+      break;
+
+    default:
+      break;
+  }
+  return eStatus;
+}
+
+/*!****************************************************************************
+ * @brief
+ * No response in time: go back to first unacknowledged frame
+ *
+ * @param[in,out] *psHost   Sender
+ * @date  19.10.2026
+ ******************************************************************************/
+void vBOOT_HostTimeout(BOOT_HostTypeDef* psHost)
+{
+  psHost->ulNext = psHost->ulAcked;
+  psHost->ulResends++;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if the image was committed
+ *
+ * @param[in] *psHost   Sender
+ * @return  (bool)  Upload complete
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bBOOT_HostIsDone(const BOOT_HostTypeDef* psHost)
+{
+  return psHost->bDone;
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Read little-endian half-word
+ *
+ * @param[in] *pucData  Data
+ * @return  (uint32_t)  Value
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulBOOT_Get16(const uint8_t* pucData)
+{
+  return (uint32_t)pucData[0] | ((uint32_t)pucData[1] << 8);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Read little-endian word
+ *
+ * @param[in] *pucData  Data
+ * @return  (uint32_t)  Value
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulBOOT_Get32(const uint8_t* pucData)
+{
+  return ulBOOT_Get16(pucData) | (ulBOOT_Get16(&pucData[2]) << 16);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write little-endian half-word
+ *
+ * @param[out] *pucData   Destination
+ * @param[in] ulValue     Value (lower 16 bits)
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vBOOT_Put16(uint8_t* pucData, uint32_t ulValue)
+{
+  pucData[0] = (uint8_t)ulValue;
+  pucData[1] = (uint8_t)(ulValue >> 8);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write little-endian word
+ *
+ * @param[out] *pucData   Destination
+ * @param[in] ulValue     Value
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vBOOT_Put32(uint8_t* pucData, uint32_t ulValue)
+{
+  vBOOT_Put16(pucData, ulValue);
+  vBOOT_Put16(&pucData[2], ulValue >> 16);
+}
+
+/*!****************************************************************************
+ * @brief
+ * START: check length, invalidate application
+ *
+ * @param[in,out] *psTarget   Receiver
+ * @param[in] *pucFrame       Frame
+ * @return  (BOOT_StatusTypeDef)  Response status
+ * @date  19.10.2026
+ ******************************************************************************/
+static BOOT_StatusTypeDef eBOOT_Start(BOOT_TargetTypeDef* psTarget, const uint8_t* pucFrame)
+{
+  uint32_t ulLength = ulBOOT_Get32(&pucFrame[BOOT_FRAME_ARG]);
+  uint32_t ulPages = (ulLength + BOOT_PAGE_SIZE - 1u) / BOOT_PAGE_SIZE;
+  if ((ulLength == 0uL) || (ulLength > psTarget->psFlash->ulSize) || (ulPages >= BOOT_SEQ_MAX))
+  {
+    return BOOT_STATUS_SIZE;
+  }
+  if (!psTarget->psFlash->pfnErase(0uL))
+  {
+    return BOOT_STATUS_FLASH;
+  }
+
+  psTarget->ulLength = ulLength;
+  psTarget->ulCrc = ulBOOT_Get32(&pucFrame[BOOT_FRAME_DATA]);
+  psTarget->ulNextSeq = 0uL;
+  psTarget->ulEndSeq = ulPages + 1u;
+  psTarget->bActive = true;
+  return BOOT_STATUS_ACK;
+}
+
+/*!****************************************************************************
+ * @brief
+ * DATA: program page, keep first page in RAM
+ *
+ * @param[in,out] *psTarget   Receiver
+ * @param[in] ulSeq           Sequence number (page + 1)
+ * @param[in] *pucData        Page data
+ * @return  (BOOT_StatusTypeDef)  Response status
+ * @date  19.10.2026
+ ******************************************************************************/
+static BOOT_StatusTypeDef eBOOT_Data(BOOT_TargetTypeDef* psTarget, uint32_t ulSeq,
+                                     const uint8_t* pucData)
+{
+  const BOOT_FlashTypeDef* psFlash = psTarget->psFlash;
+  uint32_t ulOffset = (ulSeq - 1u) * BOOT_PAGE_SIZE;
+  if (ulOffset == 0uL)
+  {
+    (void)memcpy(psTarget->aucFirst, pucData, BOOT_PAGE_SIZE);
+    return BOOT_STATUS_ACK;
+  }
+
+  if (!psFlash->pfnErase(ulOffset) || !psFlash->pfnProgram(ulOffset, pucData) ||
+      (memcmp(&psFlash->pucBase[ulOffset], pucData, BOOT_PAGE_SIZE) != 0))
+  {
+    return BOOT_STATUS_FLASH;
+  }
+  return BOOT_STATUS_ACK;
+}
+
+/*!****************************************************************************
+ * @brief
+ * END: verify image CRC, then program first page
+ *
+ * @param[in,out] *psTarget   Receiver
+ * @return  (BOOT_StatusTypeDef)  Response status
+ * @date  19.10.2026
+ ******************************************************************************/
+static BOOT_StatusTypeDef eBOOT_End(BOOT_TargetTypeDef* psTarget)
+{
+  const BOOT_FlashTypeDef* psFlash = psTarget->psFlash;
+  uint32_t ulFirst = (psTarget->ulLength < BOOT_PAGE_SIZE) ? psTarget->ulLength : BOOT_PAGE_SIZE;
+  uint32_t ulCrc = ulCRC32_Update(CRC32_INIT, psTarget->aucFirst, ulFirst);
+  ulCrc = ulCRC32_Update(ulCrc, &psFlash->pucBase[ulFirst], psTarget->ulLength - ulFirst);
+  if (ulCrc != psTarget->ulCrc)
+  {
+    return BOOT_STATUS_CRC;
+  }
+
+  if (!psFlash->pfnProgram(0uL, psTarget->aucFirst) ||
+      (memcmp(psFlash->pucBase, psTarget->aucFirst, BOOT_PAGE_SIZE) != 0))
+  {
+    return BOOT_STATUS_FLASH;
+  }
+  return BOOT_STATUS_DONE;
+}
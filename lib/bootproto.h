@@ -0,0 +1,126 @@
+/*!****************************************************************************
+ * @file
+ * bootproto.h
+ *
+ * @brief
+ * Serial bootloader protocol and image handling
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef BOOTPROTO_H_
+#define BOOTPROTO_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Flash page size in bytes, payload of each frame
+#define BOOT_PAGE_SIZE                1024u
+
+/*! @brief Frame layout (little-endian fields)
+ *  @{                                                                        */
+#define BOOT_FRAME_SYNC               0u      ///< BOOT_SYNC
+#define BOOT_FRAME_CMD                1u      ///< BOOT_CmdTypeDef
+#define BOOT_FRAME_SEQ                2u      ///< Sequence number, 16 bits
+#define BOOT_FRAME_ARG                4u      ///< Command argument, 32 bits
+#define BOOT_FRAME_DATA               8u      ///< Payload, BOOT_PAGE_SIZE bytes
+#define BOOT_FRAME_CRC                (BOOT_FRAME_DATA + BOOT_PAGE_SIZE) ///< CRC-32 of the above
+#define BOOT_FRAME_SIZE               (BOOT_FRAME_CRC + 4u)
+/*! @}                                                                        */
+
+/*! @brief Response layout
+ *  @{                                                                        */
+#define BOOT_RESP_SYNC                0u      ///< BOOT_SYNC_RESP
+#define BOOT_RESP_STATUS              1u      ///< BOOT_StatusTypeDef
+#define BOOT_RESP_SEQ                 2u      ///< Sequence number, 16 bits
+#define BOOT_RESP_SIZE                4u
+/*! @}                                                                        */
+
+/*! @brief Sync bytes
+ *  @{                                                                        */
+#define BOOT_SYNC                     0x5Au   ///< Frame start
+#define BOOT_SYNC_RESP                0xA5u   ///< Response start
+#define BOOT_PROBE                    0x7Fu   ///< Sent by host until the bootloader answers
+/*! @}                                                                        */
+
+/// Frames sent ahead of their response, one per receive buffer
+#define BOOT_WINDOW                   2u
+
+/// Bootloader request magic (16 bits, e.g. in a backup register)
+#define BOOT_REQUEST_MAGIC            0xB007u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Frame commands
+typedef enum {
+  BOOT_CMD_START = 1,             ///< Begin image, arg: length, data: CRC-32 of image
+  BOOT_CMD_DATA,                  ///< Image page (seq - 1), padded with 0xFF
+  BOOT_CMD_END                    ///< Verify and commit image
+} BOOT_CmdTypeDef;
+
+/// Response status
+typedef enum {
+  BOOT_STATUS_ACK = 0,            ///< Frame done, seq: frame
+  BOOT_STATUS_READY,              ///< Answer to probe, frames are received now
+  BOOT_STATUS_RESEND,             ///< Frame damaged or out of order, seq: next expected
+  BOOT_STATUS_DONE,               ///< Image verified and committed, seq: frame
+  BOOT_STATUS_SIZE,               ///< Image length invalid or too large
+  BOOT_STATUS_ORDER,              ///< DATA or END without START, or END too early
+  BOOT_STATUS_FLASH,              ///< Erase, program or read-back failed
+  BOOT_STATUS_CRC                 ///< Image CRC mismatch
+} BOOT_StatusTypeDef;
+
+/// Application flash region
+typedef struct {
+  const uint8_t* pucBase;         ///< First page, memory-mapped for reads
+  uint32_t ulAddr;                ///< Target address of first page
+  uint32_t ulSize;                ///< Region size in bytes, multiple of BOOT_PAGE_SIZE
+  bool (*pfnErase)(uint32_t ulOffset);  ///< Erase page at offset
+  bool (*pfnProgram)(uint32_t ulOffset, const uint8_t* pucData); ///< Program erased page at offset
+} BOOT_FlashTypeDef;
+
+/// Receiving side (bootloader)
+typedef struct {
+  const BOOT_FlashTypeDef* psFlash;           ///< Application region
+  uint32_t ulLength;                          ///< Image length in bytes
+  uint32_t ulCrc;                             ///< Expected image CRC-32
+  uint32_t ulNextSeq;                         ///< Next expected frame
+  uint32_t ulEndSeq;                          ///< Sequence number of END frame
+  bool bActive;                               ///< START accepted
+  uint8_t aucFirst[BOOT_PAGE_SIZE];           ///< First page, programmed last
+} BOOT_TargetTypeDef;
+
+/// Sending side (uploader)
+typedef struct {
+  const uint8_t* pucImage;        ///< Image
+  uint32_t ulLength;              ///< Image length in bytes
+  uint32_t ulCrc;                 ///< Image CRC-32
+  uint32_t ulEndSeq;              ///< Sequence number of END frame
+  uint32_t ulNext;                ///< Next frame to send
+  uint32_t ulAcked;               ///< Frames before this one are acknowledged
+  uint32_t ulResends;             ///< Go-back events
+  bool bDone;                     ///< Image committed
+} BOOT_HostTypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+// Common
+bool bBOOT_IsAppValid(const BOOT_FlashTypeDef* psFlash, uint32_t ulRamBase, uint32_t ulRamSize);
+void vBOOT_PutResponse(uint8_t* pucResp, BOOT_StatusTypeDef eStatus, uint32_t ulSeq);
+
+// Receiving side
+void vBOOT_TargetInit(BOOT_TargetTypeDef* psTarget, const BOOT_FlashTypeDef* psFlash);
+BOOT_StatusTypeDef eBOOT_TargetFrame(BOOT_TargetTypeDef* psTarget, const uint8_t* pucFrame,
+                                     uint8_t* pucResp);
+
+// Sending side
+void vBOOT_HostInit(BOOT_HostTypeDef* psHost, const uint8_t* pucImage, uint32_t ulLength);
+bool bBOOT_HostNextFrame(BOOT_HostTypeDef* psHost, uint8_t* pucFrame);
+BOOT_StatusTypeDef eBOOT_HostResponse(BOOT_HostTypeDef* psHost, const uint8_t* pucResp);
+void vBOOT_HostTimeout(BOOT_HostTypeDef* psHost);
+bool bBOOT_HostIsDone(const BOOT_HostTypeDef* psHost);
+
+#endif // BOOTPROTO_H_
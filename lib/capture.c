@@ -0,0 +1,209 @@
+/*!****************************************************************************
+ * @file
+ * capture.c
+ *
+ * @brief
+ * Input capture timestamp extension and batch statistics
+ *
+ * A free-running 16-bit counter captures rising and falling edges; per
+ * rising edge, one DMA burst stores both capture values together with a
+ * stamp, the number of half counter periods (CAPT_HALF ticks) counted by
+ * software when the burst ran. The stamp is advanced by an interrupt at
+ * every half period boundary, so it may lag the counter by the interrupt
+ * latency, and a delayed burst may see it one ahead of the capture. Since
+ * the parity of the true half period equals the top bit of the count, a
+ * mismatch tells that the stamp is off by one, and the position within the
+ * half period tells in which direction:
+ *
+ *   count  0x0000 .. 0x3FFF  boundary not yet counted  -> stamp + 1
+ *   count  0x4000 .. 0x7FFF  burst after next boundary -> stamp - 1
+ *
+ * This is exact as long as interrupt and DMA latency stay below a quarter
+ * counter period. The 16-bit stamp itself is extended against the current
+ * 64-bit half period count, so records must be processed within 2^16 half
+ * periods.
+ *
+ * Falling edges are only known modulo the counter period (as low time before
+ * the next rising edge). The high time is taken from it when it is unique,
+ * which holds if both high and low time are shorter than one counter period;
+ * for slower signals, the counter clock must be divided.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stddef.h>
+#include "capture.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Counter period in ticks
+#define CAPT_PERIOD                   (2uL * CAPT_HALF)
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Extend captured count to 64-bit ticks since counter start
+ *
+ * @param[in] uiCount       Captured counter value
+ * @param[in] uiHalves      Stamp transferred with the count
+ * @param[in] ullHalvesNow  Half periods counted now (not before the stamp)
+ * @return  (uint64_t)  Ticks since counter start
+ * @date  19.10.2026
+ ******************************************************************************/
+uint64_t ullCAPT_Extend(uint16_t uiCount, uint16_t uiHalves, uint64_t ullHalvesNow)
+{
+  uint64_t ullHalves = ullHalvesNow - (uint16_t)((uint16_t)ullHalvesNow - uiHalves);
+  uint32_t ulOffset = uiCount & (CAPT_HALF - 1uL);
+
+  if ((ullHalves & 1uLL) != (uint64_t)(uiCount / CAPT_HALF))
+  {
+    if (ulOffset < CAPT_HALF / 2uL)
+    {
+      ullHalves++;
+    }
+    else
+    {
+      ullHalves--;
+    }
+  }
+  return ullHalves * CAPT_HALF + ulOffset;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Initialise edge chain
+ *
+ * @param[out] *psCapt    Chain state
+ * @param[in] ullOrigin   Timestamp of counter start, added to all timestamps
+ * @date  19.10.2026
+ ******************************************************************************/
+void vCAPT_Init(CAPT_TypeDef* psCapt, uint64_t ullOrigin)
+{
+  psCapt->ullOrigin = ullOrigin;
+  psCapt->ullLastRise = 0uLL;
+  psCapt->bHaveRise = false;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Clear batch statistics
+ *
+ * @param[out] *psBatch   Statistics
+ * @date  19.10.2026
+ ******************************************************************************/
+void vCAPT_ClearBatch(CAPT_BatchTypeDef* psBatch)
+{
+  *psBatch = (CAPT_BatchTypeDef){ .ulPeriodMin = UINT32_MAX };
+}
+
+/*!****************************************************************************
+ * @brief
+ * Add batch statistics to a total over consecutive batches
+ *
+ * @param[in,out] *psTotal  Total, cleared by vCAPT_ClearBatch()
+ * @param[in] *psBatch      Statistics of the next batch
+ * @date  19.10.2026
+ ******************************************************************************/
+void vCAPT_AddBatch(CAPT_BatchTypeDef* psTotal, const CAPT_BatchTypeDef* psBatch)
+{
+  if (psBatch->ulEdges == 0uL) return;
+
+  if (psTotal->ulEdges == 0uL) psTotal->ullFirst = psBatch->ullFirst;
+  psTotal->ullLast = psBatch->ullLast;
+  psTotal->ulEdges += psBatch->ulEdges;
+  psTotal->ulPeriods += psBatch->ulPeriods;
+  if (psBatch->ulPeriodMin < psTotal->ulPeriodMin) psTotal->ulPeriodMin = psBatch->ulPeriodMin;
+  if (psBatch->ulPeriodMax > psTotal->ulPeriodMax) psTotal->ulPeriodMax = psBatch->ulPeriodMax;
+  psTotal->ullSpan += psBatch->ullSpan;
+  psTotal->ullHigh += psBatch->ullHigh;
+  psTotal->ullHighSpan += psBatch->ullHighSpan;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Add capture records to batch statistics
+ *
+ * A period is counted for every rising edge after the first one of the
+ * chain. Records must be passed in order; the chain continues across calls.
+ *
+ * @param[in,out] *psCapt   Chain state
+ * @param[in] *psRaw        Records
+ * @param[in] ulCount       Number of records
+ * @param[in] ullHalvesNow  Half periods counted after the last record
+ * @param[in,out] *psBatch  Statistics, cleared by vCAPT_ClearBatch()
+ * @param[out] *pullEdges   Rising edge timestamps (ulCount entries), or NULL
+ * @date  19.10.2026
+ ******************************************************************************/
+void vCAPT_Process(CAPT_TypeDef* psCapt, const CAPT_RawTypeDef* psRaw, uint32_t ulCount,
+                   uint64_t ullHalvesNow, CAPT_BatchTypeDef* psBatch, uint64_t* pullEdges)
+{
+  for (uint32_t i = 0uL; i < ulCount; ++i)
+  {
+    uint64_t ullRise = psCapt->ullOrigin +
+                       ullCAPT_Extend(psRaw[i].uiRise, psRaw[i].uiHalves, ullHalvesNow);
+    if (pullEdges != NULL) pullEdges[i] = ullRise;
+
+    if (psBatch->ulEdges == 0uL) psBatch->ullFirst = ullRise;
+    psBatch->ullLast = ullRise;
+    psBatch->ulEdges++;
+
+    if (psCapt->bHaveRise)
+    {
+      uint64_t ullPeriod = ullRise - psCapt->ullLastRise;
+      uint32_t ulPeriod = (ullPeriod > UINT32_MAX) ? UINT32_MAX : (uint32_t)ullPeriod;
+      if (ulPeriod < psBatch->ulPeriodMin) psBatch->ulPeriodMin = ulPeriod;
+      if (ulPeriod > psBatch->ulPeriodMax) psBatch->ulPeriodMax = ulPeriod;
+      psBatch->ullSpan += ullPeriod;
+      psBatch->ulPeriods++;
+
+      // Low time modulo the counter period; unique if the high time with
+      // the shortest candidate fits into one counter period
+      uint64_t ullLow = (uint16_t)(psRaw[i].uiRise - psRaw[i].uiFall);
+      if ((ullLow != 0uLL) && (ullLow < ullPeriod) && (ullPeriod - ullLow <= CAPT_PERIOD))
+      {
+        psBatch->ullHigh += ullPeriod - ullLow;
+        psBatch->ullHighSpan += ullPeriod;
+      }
+    }
+    psCapt->ullLastRise = ullRise;
+    psCapt->bHaveRise = true;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Mean frequency of a batch
+ *
+ * Exact (rounded) for batches of up to 2^24 periods at a 72 MHz clock.
+ *
+ * @param[in] *psBatch  Statistics
+ * @param[in] ulClock   Counter clock in Hz
+ * @return  (uint32_t)  Frequency in mHz, 0 without complete period
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulCAPT_GetFreq(const CAPT_BatchTypeDef* psBatch, uint32_t ulClock)
+{
+  if (psBatch->ullSpan == 0uLL) return 0uL;
+
+  uint64_t ullFreq = ((uint64_t)ulClock * 1000uLL * psBatch->ulPeriods + psBatch->ullSpan / 2uLL) /
+                     psBatch->ullSpan;
+  return (ullFreq > UINT32_MAX) ? UINT32_MAX : (uint32_t)ullFreq;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Mean duty cycle of a batch
+ *
+ * @param[in] *psBatch  Statistics
+ * @return  (uint16_t)  High time in 0.01 % of the period, UINT16_MAX if unknown
+ * @date  19.10.2026
+ ******************************************************************************/
+uint16_t uiCAPT_GetDuty(const CAPT_BatchTypeDef* psBatch)
+{
+  if (psBatch->ullHighSpan == 0uLL) return UINT16_MAX;
+
+  return (uint16_t)((psBatch->ullHigh * CAPT_DUTY_FULL + psBatch->ullHighSpan / 2uLL) /
+                    psBatch->ullHighSpan);
+}
@@ -0,0 +1,68 @@
+/*!****************************************************************************
+ * @file
+ * capture.h
+ *
+ * @brief
+ * Input capture timestamp extension and batch statistics
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef CAPTURE_H_
+#define CAPTURE_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Counter ticks per half counter period
+#define CAPT_HALF                     0x8000uL
+
+/// Duty cycle of a full period, in 0.01 %
+#define CAPT_DUTY_FULL                10000u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Capture record, as transferred by one DMA burst per rising edge
+typedef struct {
+  uint16_t uiRise;                ///< Counter at the rising edge
+  uint16_t uiFall;                ///< Counter at the last falling edge before it
+  uint16_t uiHalves;              ///< Half counter periods counted at transfer time
+} CAPT_RawTypeDef;
+
+/// Edge chain state
+typedef struct {
+  uint64_t ullOrigin;             ///< Timestamp of counter start
+  uint64_t ullLastRise;           ///< Timestamp of the last rising edge
+  bool bHaveRise;                 ///< Last rising edge known
+} CAPT_TypeDef;
+
+/// Batch statistics
+typedef struct {
+  uint32_t ulEdges;               ///< Rising edges
+  uint32_t ulPeriods;             ///< Periods ending in this batch
+  uint64_t ullFirst;              ///< Timestamp of the first rising edge
+  uint64_t ullLast;               ///< Timestamp of the last rising edge
+  uint32_t ulPeriodMin;           ///< Shortest period in ticks (saturated)
+  uint32_t ulPeriodMax;           ///< Longest period in ticks (saturated)
+  uint64_t ullSpan;               ///< Sum of periods in ticks
+  uint64_t ullHigh;               ///< Sum of high times of periods with known falling edge
+  uint64_t ullHighSpan;           ///< Sum of those periods
+} CAPT_BatchTypeDef;
+
+_Static_assert(sizeof(CAPT_RawTypeDef) == 6u, "capture record must match the DMA burst");
+
+
+/*- Public interface ---------------------------------------------------------*/
+uint64_t ullCAPT_Extend(uint16_t uiCount, uint16_t uiHalves, uint64_t ullHalvesNow);
+void vCAPT_Init(CAPT_TypeDef* psCapt, uint64_t ullOrigin);
+void vCAPT_ClearBatch(CAPT_BatchTypeDef* psBatch);
+void vCAPT_AddBatch(CAPT_BatchTypeDef* psTotal, const CAPT_BatchTypeDef* psBatch);
+void vCAPT_Process(CAPT_TypeDef* psCapt, const CAPT_RawTypeDef* psRaw, uint32_t ulCount,
+                   uint64_t ullHalvesNow, CAPT_BatchTypeDef* psBatch, uint64_t* pullEdges);
+uint32_t ulCAPT_GetFreq(const CAPT_BatchTypeDef* psBatch, uint32_t ulClock);
+uint16_t uiCAPT_GetDuty(const CAPT_BatchTypeDef* psBatch);
+
+#endif // CAPTURE_H_
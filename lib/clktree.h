@@ -0,0 +1,155 @@
+/*!****************************************************************************
+ * @file
+ * clktree.h
+ *
+ * @brief
+ * Clock tree solver for the STM32F10x performance line
+ *
+ * Finds the PLL and prescaler settings that produce the target frequencies
+ * exactly from a crystal, and encodes them as RCC_CFGR and FLASH_ACR values:
+ *
+ *   HSE --[ /PREDIV ]--[ *PLLMUL ]-- PLLCLK = SYSCLK --[ AHB ]-- HCLK
+ *   HCLK --[ APB1 ]-- PCLK1, HCLK --[ APB2 ]-- PCLK2 --[ ADC ]-- ADCCLK
+ *   PLLCLK --[ /1, /1.5 ]-- USBCLK
+ *
+ * All macros are constant expressions without casts, so they fold at
+ * compile time, work in static assertions, and can equally be evaluated
+ * with variables (host check). A setting that cannot be reached exactly, or
+ * exceeds a limit of the device, yields divider 0 and CLKTREE_FEASIBLE()
+ * false. Frequencies are in Hz; USB and ADC targets of 0 mean unused.
+ *
+ * The PLL always runs from HSE and drives SYSCLK. HSE / 1 is preferred to
+ * HSE / 2 into the PLL. The flash wait states follow SYSCLK (RM0008 3.3.3);
+ * the prefetch buffer is always enabled, as required for AHB prescalers
+ * other than 1.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef CLKTREE_H_
+#define CLKTREE_H_
+
+/*- Macros -------------------------------------------------------------------*/
+/*! @brief Device limits in Hz (DS5319)
+ *  @{                                                                        */
+#define CLKTREE_HSE_MIN               4000000uL
+#define CLKTREE_HSE_MAX               16000000uL
+#define CLKTREE_PLL_MIN               16000000uL
+#define CLKTREE_SYSCLK_MAX            72000000uL
+#define CLKTREE_PCLK1_MAX             36000000uL
+#define CLKTREE_PCLK2_MAX             72000000uL
+#define CLKTREE_ADCCLK_MIN            600000uL
+#define CLKTREE_ADCCLK_MAX            14000000uL
+#define CLKTREE_USBCLK                48000000uL
+/*! @}                                                                        */
+
+/*! @brief Highest SYSCLK for 0 and 1 flash wait states in Hz
+ *  @{                                                                        */
+#define CLKTREE_LATENCY0_MAX          24000000uL
+#define CLKTREE_LATENCY1_MAX          48000000uL
+/*! @}                                                                        */
+
+/*! @brief Register bit positions (RM0008 RCC_CFGR, FLASH_ACR)
+ *  @{                                                                        */
+#define CLKTREE_CFGR_HPRE_Pos         4u
+#define CLKTREE_CFGR_PPRE1_Pos        8u
+#define CLKTREE_CFGR_PPRE2_Pos        11u
+#define CLKTREE_CFGR_ADCPRE_Pos       14u
+#define CLKTREE_CFGR_PLLSRC_Pos       16u
+#define CLKTREE_CFGR_PLLXTPRE_Pos     17u
+#define CLKTREE_CFGR_PLLMULL_Pos      18u
+#define CLKTREE_CFGR_USBPRE_Pos       22u
+#define CLKTREE_FLASH_ACR_PRFTBE_Pos  4u
+/*! @}                                                                        */
+
+/// Exact divider from a clock to a target, 0 if not an integer
+#define CLKTREE_DIV_(clk, target)                                              \
+  ((((target) != 0u) && (((clk) % (target)) == 0u)) ? ((clk) / (target)) : 0u)
+
+/// PLL multiplier (2..16) for a PLL input of hse / div, 0 if none reaches sys
+#define CLKTREE_PLLMUL_AT_(hse, div, sys)                                      \
+  (((CLKTREE_DIV_((sys) * (div), hse) >= 2u) && (CLKTREE_DIV_((sys) * (div), hse) <= 16u)) ? \
+   CLKTREE_DIV_((sys) * (div), hse) : 0u)
+
+/*! @brief Dividers available
+ *  @{                                                                        */
+#define CLKTREE_IS_HPRE_(d)                                                    \
+  (((d) == 1u) || ((d) == 2u) || ((d) == 4u) || ((d) == 8u) || ((d) == 16u) || \
+   ((d) == 64u) || ((d) == 128u) || ((d) == 256u) || ((d) == 512u))
+#define CLKTREE_IS_PPRE_(d)                                                    \
+  (((d) == 1u) || ((d) == 2u) || ((d) == 4u) || ((d) == 8u) || ((d) == 16u))
+#define CLKTREE_IS_ADCPRE_(d)                                                  \
+  (((d) == 2u) || ((d) == 4u) || ((d) == 6u) || ((d) == 8u))
+/*! @}                                                                        */
+
+/*! @brief PLL input divider (1, 2) and multiplier (2..16), 0 if SYSCLK cannot
+ *         be reached
+ *  @{                                                                        */
+#define CLKTREE_PREDIV(hse, sys)                                               \
+  ((CLKTREE_PLLMUL_AT_(hse, 1u, sys) != 0u) ? 1u : (CLKTREE_PLLMUL_AT_(hse, 2u, sys) != 0u) ? 2u : 0u)
+#define CLKTREE_PLLMUL(hse, sys)                                               \
+  ((CLKTREE_PLLMUL_AT_(hse, 1u, sys) != 0u) ? CLKTREE_PLLMUL_AT_(hse, 1u, sys) :  \
+                                              CLKTREE_PLLMUL_AT_(hse, 2u, sys))
+/*! @}                                                                        */
+
+/*! @brief Bus and ADC prescalers, 0 if the target cannot be reached
+ *  @{                                                                        */
+#define CLKTREE_HPRE_DIV(sys, hclk)                                            \
+  (CLKTREE_IS_HPRE_(CLKTREE_DIV_(sys, hclk)) ? CLKTREE_DIV_(sys, hclk) : 0u)
+#define CLKTREE_PPRE_DIV(hclk, pclk)                                           \
+  (CLKTREE_IS_PPRE_(CLKTREE_DIV_(hclk, pclk)) ? CLKTREE_DIV_(hclk, pclk) : 0u)
+#define CLKTREE_ADCPRE_DIV(pclk2, adc)                                         \
+  (((adc) == 0u) ? 8u : CLKTREE_IS_ADCPRE_(CLKTREE_DIV_(pclk2, adc)) ? CLKTREE_DIV_(pclk2, adc) : 0u)
+/*! @}                                                                        */
+
+/// USB clock reachable: 48 MHz from PLLCLK / 1 or / 1.5, or unused
+#define CLKTREE_USB_OK(sys, usb)                                               \
+  (((usb) == 0u) || (((usb) == CLKTREE_USBCLK) && (((sys) == (usb)) || ((sys) * 2u == (usb) * 3u))))
+
+/// USBPRE bit: 1 for PLLCLK / 1, 0 for PLLCLK / 1.5
+#define CLKTREE_USBPRE(sys, usb)      ((((usb) != 0u) && ((sys) == (usb))) ? 1u : 0u)
+
+/// Flash wait states
+#define CLKTREE_LATENCY(sys)                                                   \
+  (((sys) <= CLKTREE_LATENCY0_MAX) ? 0u : ((sys) <= CLKTREE_LATENCY1_MAX) ? 1u : 2u)
+
+/// Timer clock on an APB bus: PCLK doubled when the bus is divided
+#define CLKTREE_TIMCLK(hclk, pclk)    (((pclk) == (hclk)) ? (pclk) : 2u * (pclk))
+
+/*! @brief Register field codes of the dividers
+ *  @{                                                                        */
+#define CLKTREE_PLLMUL_CODE(m)        ((m) - 2u)
+#define CLKTREE_HPRE_CODE(d)                                                   \
+  (((d) <= 1u) ? 0u : ((d) == 2u) ? 8u : ((d) == 4u) ? 9u : ((d) == 8u) ? 10u : ((d) == 16u) ? 11u : \
+   ((d) == 64u) ? 12u : ((d) == 128u) ? 13u : ((d) == 256u) ? 14u : 15u)
+#define CLKTREE_PPRE_CODE(d)                                                   \
+  (((d) <= 1u) ? 0u : ((d) == 2u) ? 4u : ((d) == 4u) ? 5u : ((d) == 8u) ? 6u : 7u)
+#define CLKTREE_ADCPRE_CODE(d)        ((d) / 2u - 1u)
+/*! @}                                                                        */
+
+/// All targets reachable within the device limits
+#define CLKTREE_FEASIBLE(hse, sys, hclk, pclk1, pclk2, usb, adc)               \
+  (((hse) >= CLKTREE_HSE_MIN) && ((hse) <= CLKTREE_HSE_MAX) &&                 \
+   ((sys) >= CLKTREE_PLL_MIN) && ((sys) <= CLKTREE_SYSCLK_MAX) &&              \
+   (CLKTREE_PLLMUL(hse, sys) != 0u) && (CLKTREE_HPRE_DIV(sys, hclk) != 0u) &&  \
+   (CLKTREE_PPRE_DIV(hclk, pclk1) != 0u) && ((pclk1) <= CLKTREE_PCLK1_MAX) &&  \
+   (CLKTREE_PPRE_DIV(hclk, pclk2) != 0u) && ((pclk2) <= CLKTREE_PCLK2_MAX) &&  \
+   (CLKTREE_ADCPRE_DIV(pclk2, adc) != 0u) &&                                   \
+   (((adc) == 0u) || (((adc) >= CLKTREE_ADCCLK_MIN) && ((adc) <= CLKTREE_ADCCLK_MAX))) && \
+   CLKTREE_USB_OK(sys, usb))
+
+/// RCC_CFGR value, PLL from HSE, SYSCLK switch left at HSI
+#define CLKTREE_CFGR(hse, sys, hclk, pclk1, pclk2, usb, adc)                   \
+  ((1u << CLKTREE_CFGR_PLLSRC_Pos) |                                           \
+   (((CLKTREE_PREDIV(hse, sys) == 2u) ? 1u : 0u) << CLKTREE_CFGR_PLLXTPRE_Pos) | \
+   (CLKTREE_PLLMUL_CODE(CLKTREE_PLLMUL(hse, sys)) << CLKTREE_CFGR_PLLMULL_Pos) | \
+   (CLKTREE_USBPRE(sys, usb) << CLKTREE_CFGR_USBPRE_Pos) |                     \
+   (CLKTREE_HPRE_CODE(CLKTREE_HPRE_DIV(sys, hclk)) << CLKTREE_CFGR_HPRE_Pos) | \
+   (CLKTREE_PPRE_CODE(CLKTREE_PPRE_DIV(hclk, pclk1)) << CLKTREE_CFGR_PPRE1_Pos) | \
+   (CLKTREE_PPRE_CODE(CLKTREE_PPRE_DIV(hclk, pclk2)) << CLKTREE_CFGR_PPRE2_Pos) | \
+   (CLKTREE_ADCPRE_CODE(CLKTREE_ADCPRE_DIV(pclk2, adc)) << CLKTREE_CFGR_ADCPRE_Pos))
+
+/// FLASH_ACR value: wait states and prefetch buffer
+#define CLKTREE_FLASH_ACR(sys)        (CLKTREE_LATENCY(sys) | (1u << CLKTREE_FLASH_ACR_PRFTBE_Pos))
+
+#endif // CLKTREE_H_
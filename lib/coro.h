@@ -0,0 +1,228 @@
+/*!****************************************************************************
+ * @file
+ * coro.h
+ *
+ * @brief
+ * Stackless coroutines
+ *
+ * A coroutine is an ordinary function returning CORO_StatusTypeDef, whose
+ * body is enclosed in CORO_BEGIN()/CORO_END(). It runs until it awaits a
+ * condition that is not met yet, then returns; the next call resumes at the
+ * await. The resume point is kept in the coroutine state (CORO_TypeDef,
+ * 8 bytes) instead of a stack, so any number of coroutines can be driven
+ * from a single loop or thread:
+ *
+ *   static CORO_StatusTypeDef eBlink(CORO_TypeDef* psCo)
+ *   {
+ *     CORO_BEGIN(psCo);
+ *     while (1)
+ *     {
+ *       vHW_ToggleLed();
+ *       CORO_AWAIT_TIME(psCo, ulHW_GetTime(), 500uL);
+ *     }
+ *     CORO_END(psCo);
+ *   }
+ *
+ * The resume point is a case label (switch-based). Local variables do not
+ * survive an await and must be static or part of a caller-provided context.
+ * The body must not contain switch statements spanning an await, and at most
+ * one await per source line may be used.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef CORO_H_
+#define CORO_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Resume point of a coroutine that has not started
+#define CORO_LINE_START               0u
+
+/// Resume point of a terminated coroutine
+#define CORO_LINE_EXITED              0xFFFFu
+
+/*!****************************************************************************
+ * @brief
+ * Initialise (or restart) coroutine state
+ *
+ * @param[out] psCo   Coroutine state
+ ******************************************************************************/
+#define CORO_INIT(psCo)                                                        \
+  do { (psCo)->uiLine = CORO_LINE_START; (psCo)->ulTime = 0uL; } while (0)
+
+/*!****************************************************************************
+ * @brief
+ * Begin coroutine body
+ *
+ * @param[in,out] psCo  Coroutine state
+ ******************************************************************************/
+#define CORO_BEGIN(psCo)                                                       \
+  switch ((psCo)->uiLine)                                                      \
+  {                                                                            \
+    case CORO_LINE_EXITED:                                                     \
+      return CORO_EXITED;                                                      \
+    case CORO_LINE_START:
+
+/*!****************************************************************************
+ * @brief
+ * End coroutine body, terminating the coroutine
+ *
+ * @param[in,out] psCo  Coroutine state
+ ******************************************************************************/
+#define CORO_END(psCo)                                                         \
+    default:                                                                   \
+      break;                                                                   \
+  }                                                                            \
+  (psCo)->uiLine = CORO_LINE_EXITED;                                           \
+  return CORO_EXITED
+
+/*!****************************************************************************
+ * @brief
+ * Terminate coroutine from within its body
+ *
+ * @param[in,out] psCo  Coroutine state
+ ******************************************************************************/
+#define CORO_EXIT(psCo)                                                        \
+  do { (psCo)->uiLine = CORO_LINE_EXITED; return CORO_EXITED; } while (0)
+
+/*!****************************************************************************
+ * @brief
+ * Return to the caller once, resume after this point on the next call
+ *
+ * @param[in,out] psCo  Coroutine state
+ ******************************************************************************/
+#define CORO_YIELD(psCo)                                                       \
+  do                                                                           \
+  {                                                                            \
+    (psCo)->uiLine = (uint16_t)__LINE__;                                       \
+    return CORO_YIELDED;                                                       \
+    case __LINE__:;                                                            \
+  } while (0)
+
+/*!****************************************************************************
+ * @brief
+ * Wait until a condition is true
+ *
+ * The condition is evaluated on every call of the coroutine; if it is true
+ * already, execution continues without returning.
+ *
+ * @param[in,out] psCo  Coroutine state
+ * @param[in] bCond     Condition expression
+ ******************************************************************************/
+#define CORO_AWAIT(psCo, bCond)                                                \
+  do                                                                           \
+  {                                                                            \
+    (psCo)->uiLine = (uint16_t)__LINE__;                                       \
+    __attribute__((fallthrough));                                              \
+    case __LINE__:                                                             \
+    if (!(bCond)) return CORO_WAITING;                                         \
+  } while (0)
+
+/*!****************************************************************************
+ * @brief
+ * Wait for a time
+ *
+ * Time is given by the caller in any unit (e.g. ulHW_GetTime() for ms) and
+ * may wrap around.
+ *
+ * @param[in,out] psCo  Coroutine state
+ * @param[in] ulNow     Expression returning the current time
+ * @param[in] ulDelay   Delay in units of ulNow
+ ******************************************************************************/
+#define CORO_AWAIT_TIME(psCo, ulNow, ulDelay)                                  \
+  do                                                                           \
+  {                                                                            \
+    (psCo)->ulTime = (ulNow);                                                  \
+    CORO_AWAIT(psCo, ((uint32_t)(ulNow) - (psCo)->ulTime) >= (uint32_t)(ulDelay)); \
+  } while (0)
+
+/*!****************************************************************************
+ * @brief
+ * Wait for an event and consume it
+ *
+ * @param[in,out] psCo  Coroutine state
+ * @param[in,out] psEvt Event (CORO_EventTypeDef*)
+ ******************************************************************************/
+#define CORO_AWAIT_EVENT(psCo, psEvt)                                          \
+  CORO_AWAIT(psCo, bCORO_TakeEvent(psEvt))
+
+/*!****************************************************************************
+ * @brief
+ * Wait for buffer space
+ *
+ * @param[in,out] psCo  Coroutine state
+ * @param[in] ulFree    Expression returning the free space
+ * @param[in] ulNeeded  Space required
+ ******************************************************************************/
+#define CORO_AWAIT_SPACE(psCo, ulFree, ulNeeded)                               \
+  CORO_AWAIT(psCo, (uint32_t)(ulFree) >= (uint32_t)(ulNeeded))
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Coroutine return value
+typedef enum {
+  CORO_WAITING = 0,               ///< Suspended in an await
+  CORO_YIELDED,                   ///< Suspended in a yield
+  CORO_EXITED                     ///< Terminated
+} CORO_StatusTypeDef;
+
+/// Coroutine state
+typedef struct {
+  uint16_t uiLine;                ///< Resume point (source line)
+  uint32_t ulTime;                ///< Start of current time await
+} CORO_TypeDef;
+
+/// Event, set from any context (including interrupts) and consumed by await
+typedef volatile uint8_t CORO_EventTypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Signal event
+ *
+ * Signals are not counted: several signals before the next await wake the
+ * coroutine once.
+ *
+ * @param[out] *psEvt   Event
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline void vCORO_Signal(CORO_EventTypeDef* psEvt)
+{
+  *psEvt = 1u;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Consume event if signalled
+ *
+ * @param[in,out] *psEvt  Event
+ * @return  (bool)      Event was signalled
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline bool bCORO_TakeEvent(CORO_EventTypeDef* psEvt)
+{
+  if (*psEvt == 0u) return false;
+  *psEvt = 0u;
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if coroutine has terminated
+ *
+ * @param[in] *psCo   Coroutine state
+ * @return  (bool)  Coroutine terminated
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline bool bCORO_IsExited(const CORO_TypeDef* psCo)
+{
+  return psCo->uiLine == CORO_LINE_EXITED;
+}
+
+#endif // CORO_H_
@@ -0,0 +1,88 @@
+/*!****************************************************************************
+ * @file
+ * crc32.c
+ *
+ * @brief
+ * Table-driven CRC-32 (zlib/IEEE 802.3)
+ *
+ * Bit-reflected CRC with polynomial 0x04C11DB7, initial value and final XOR
+ * 0xFFFFFFFF, i.e. the same result as zlib's crc32(). The running value
+ * passed between calls is the final (inverted) CRC, so that the function can
+ * be chained exactly like crc32(crc, buf, len).
+ *
+ * Serves as reference and fallback where the CRC unit is not available
+ * (host tools, unaligned bytes).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include "crc32.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Table entries
+#define CRC32_TABLE_SIZE              (1u << CRC32_TABLE_BITS)
+
+_Static_assert((CRC32_TABLE_BITS == 4u) || (CRC32_TABLE_BITS == 8u), "CRC32_TABLE_BITS must be 4 or 8");
+
+/// Table entry for index i, one reflected division step per bit
+#define CRC32_STEP(c)                 (((c) >> 1) ^ (((c) & 1uL) ? CRC32_POLY_REFLECTED : 0uL))
+#define CRC32_STEP4(c)                CRC32_STEP(CRC32_STEP(CRC32_STEP(CRC32_STEP(c))))
+#define CRC32_ENTRY4(i)               CRC32_STEP4((uint32_t)(i))
+#define CRC32_ENTRY8(i)               CRC32_STEP4(CRC32_STEP4((uint32_t)(i)))
+
+/*! @brief Table initialisers in groups of 4 and 16
+ *  @{                                                                        */
+#define CRC32_ROW4(e, i)              e(i), e((i) + 1u), e((i) + 2u), e((i) + 3u)
+#define CRC32_ROW16(e, i)             CRC32_ROW4(e, i), CRC32_ROW4(e, (i) + 4u), \
+                                      CRC32_ROW4(e, (i) + 8u), CRC32_ROW4(e, (i) + 12u)
+/*! @}                                                                        */
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Lookup table, computed at compile time
+static const uint32_t aulTable[CRC32_TABLE_SIZE] = {
+#if CRC32_TABLE_BITS == 8u
+  CRC32_ROW16(CRC32_ENTRY8, 0x00u), CRC32_ROW16(CRC32_ENTRY8, 0x10u),
+  CRC32_ROW16(CRC32_ENTRY8, 0x20u), CRC32_ROW16(CRC32_ENTRY8, 0x30u),
+  CRC32_ROW16(CRC32_ENTRY8, 0x40u), CRC32_ROW16(CRC32_ENTRY8, 0x50u),
+  CRC32_ROW16(CRC32_ENTRY8, 0x60u), CRC32_ROW16(CRC32_ENTRY8, 0x70u),
+  CRC32_ROW16(CRC32_ENTRY8, 0x80u), CRC32_ROW16(CRC32_ENTRY8, 0x90u),
+  CRC32_ROW16(CRC32_ENTRY8, 0xA0u), CRC32_ROW16(CRC32_ENTRY8, 0xB0u),
+  CRC32_ROW16(CRC32_ENTRY8, 0xC0u), CRC32_ROW16(CRC32_ENTRY8, 0xD0u),
+  CRC32_ROW16(CRC32_ENTRY8, 0xE0u), CRC32_ROW16(CRC32_ENTRY8, 0xF0u)
+#else
+  CRC32_ROW16(CRC32_ENTRY4, 0x00u)
+#endif
+};
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Update CRC with data
+ *
+ * @param[in] ulCrc     CRC of preceding data, CRC32_INIT to start
+ * @param[in] *pvData   Data
+ * @param[in] ulLen     Number of bytes
+ * @return  (uint32_t)  CRC of preceding data and pvData
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulCRC32_Update(uint32_t ulCrc, const void* pvData, uint32_t ulLen)
+{
+  const uint8_t* pucData = (const uint8_t*)pvData;
+  uint32_t ulReg = ~ulCrc;
+
+  for (uint32_t i = 0uL; i < ulLen; ++i)
+  {
+    ulReg ^= pucData[i];
+#if CRC32_TABLE_BITS == 8u
+    ulReg = aulTable[ulReg & 0xFFuL] ^ (ulReg >> 8);
+#else
+    ulReg = aulTable[ulReg & 0x0FuL] ^ (ulReg >> 4);
+    ulReg = aulTable[ulReg & 0x0FuL] ^ (ulReg >> 4);
+#endif
+  }
+  return ~ulReg;
+}
@@ -0,0 +1,37 @@
+/*!****************************************************************************
+ * @file
+ * crc32.h
+ *
+ * @brief
+ * Table-driven CRC-32 (zlib/IEEE 802.3)
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef CRC32_H_
+#define CRC32_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Bits processed per table lookup (4: 64 byte table, 8: 1 KB table)
+#ifndef CRC32_TABLE_BITS
+#define CRC32_TABLE_BITS              8u
+#endif
+
+/// Reflected generator polynomial
+#define CRC32_POLY_REFLECTED          0xEDB88320uL
+
+/// Generator polynomial, as used by the STM32 CRC unit
+#define CRC32_POLY                    0x04C11DB7uL
+
+/// CRC of empty data, start value for ulCRC32_Update()
+#define CRC32_INIT                    0uL
+
+
+/*- Public interface ---------------------------------------------------------*/
+uint32_t ulCRC32_Update(uint32_t ulCrc, const void* pvData, uint32_t ulLen);
+
+#endif // CRC32_H_
@@ -0,0 +1,222 @@
+/*!****************************************************************************
+ * @file
+ * dmaq.c
+ *
+ * @brief
+ * DMA request queue
+ *
+ * Requests are linked into a FIFO queue owned by the caller's storage (no
+ * allocation) and run one after the other on a single channel. A request
+ * larger than the channel counter is split into chunks of at most
+ * ulMaxChunk units; after each chunk, the addresses flagged for increment
+ * are advanced and the next chunk is started from the event handler.
+ *
+ * A request moves from DMAQ_STATE_QUEUED to DMAQ_STATE_BUSY when its first
+ * chunk starts, and to DMAQ_STATE_DONE or DMAQ_STATE_ERROR when it ends. The
+ * next request is started before the completion callback runs, so the
+ * channel does not wait for the callback.
+ *
+ * A channel shared between drivers has one owner at a time; the owner word
+ * is kept by the caller.
+ *
+ * The functions are not reentrant: events and submissions must be
+ * serialised by the caller. Callbacks may submit new requests. The driver is
+ * the only hardware dependency, so the queue also runs on a host against a
+ * simulated channel (tools/dma_sim).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stddef.h>
+#include "dmaq.h"
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vDMAQ_Start(DMAQ_TypeDef* psQ);
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise queue
+ *
+ * @param[out] *psQ       Queue
+ * @param[in] *psDrv      Hardware driver
+ * @param[in] ulMaxChunk  Most transfer units per channel activation (min. 1)
+ * @date  19.10.2026
+ ******************************************************************************/
+void vDMAQ_Init(DMAQ_TypeDef* psQ, const DMAQ_DriverTypeDef* psDrv, uint32_t ulMaxChunk)
+{
+  psQ->psDrv = psDrv;
+  psQ->psHead = NULL;
+  psQ->psTail = NULL;
+  psQ->ulMaxChunk = (ulMaxChunk != 0uL) ? ulMaxChunk : 1uL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Append request, start channel if idle
+ *
+ * The request must have addresses, unit count (min. 1), unit size and flags
+ * set, and must not be pending.
+ *
+ * @param[in,out] *psQ    Queue
+ * @param[in,out] *psReq  Prepared request
+ * @date  19.10.2026
+ ******************************************************************************/
+void vDMAQ_Submit(DMAQ_TypeDef* psQ, DMAQ_RequestTypeDef* psReq)
+{
+  psReq->psNext = NULL;
+  psReq->eState = DMAQ_STATE_QUEUED;
+
+  if (psQ->psTail != NULL)
+  {
+    psQ->psTail->psNext = psReq;
+    psQ->psTail = psReq;
+  }
+  else
+  {
+    psQ->psHead = psReq;
+    psQ->psTail = psReq;
+    vDMAQ_Start(psQ);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Process channel event
+ *
+ * Advances the active request to its next chunk, or completes it and starts
+ * the next queued request. Events while idle are ignored.
+ *
+ * @param[in,out] *psQ    Queue
+ * @param[in] eEvent      Event
+ * @date  19.10.2026
+ ******************************************************************************/
+void vDMAQ_Event(DMAQ_TypeDef* psQ, DMAQ_EventTypeDef eEvent)
+{
+  DMAQ_RequestTypeDef* psReq = psQ->psHead;
+  if (psReq == NULL) return;
+
+  DMAQ_StateTypeDef eState = DMAQ_STATE_ERROR;
+  if (eEvent == DMAQ_EVENT_DONE)
+  {
+    uint32_t ulChunk = (psReq->ulCount > psQ->ulMaxChunk) ? psQ->ulMaxChunk : psReq->ulCount;
+    uint32_t ulBytes = ulChunk << psReq->ucShift;
+    psReq->ulCount -= ulChunk;
+    if ((psReq->ucFlags & DMAQ_FLAG_DST_INC) != 0u) psReq->ulDst += ulBytes;
+    if ((psReq->ucFlags & DMAQ_FLAG_SRC_INC) != 0u) psReq->ulSrc += ulBytes;
+
+    // Continue with next chunk
+    if (psReq->ulCount != 0uL)
+    {
+      vDMAQ_Start(psQ);
+      return;
+    }
+    eState = DMAQ_STATE_DONE;
+  }
+
+  // Dequeue and start next request before notifying
+  psQ->psHead = psReq->psNext;
+  if (psQ->psHead != NULL)
+  {
+    vDMAQ_Start(psQ);
+  }
+  else
+  {
+    psQ->psTail = NULL;
+  }
+  vDMAQ_Finish(psReq, eState);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Mark request as completed and notify owner
+ *
+ * Also used for requests completed by the CPU without being queued.
+ *
+ * @param[in,out] *psReq  Request
+ * @param[in] eState      Final state
+ * @date  19.10.2026
+ ******************************************************************************/
+void vDMAQ_Finish(DMAQ_RequestTypeDef* psReq, DMAQ_StateTypeDef eState)
+{
+  psReq->eState = eState;
+  if (psReq->pfnCallback != NULL) psReq->pfnCallback(psReq);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Split a copy for the widest unit size permitted by the relative alignment
+ *
+ * Head and tail are the unaligned bytes before and after the body, at most
+ * unit size - 1 each; the body starts aligned at the destination.
+ *
+ * @param[in] ulDst       Destination address
+ * @param[in] ulSrc       Source address
+ * @param[in] ulSize      Size in bytes (min. 8)
+ * @param[out] *psPlan    Split
+ * @date  19.10.2026
+ ******************************************************************************/
+void vDMAQ_Plan(uintptr_t ulDst, uintptr_t ulSrc, uint32_t ulSize, DMAQ_PlanTypeDef* psPlan)
+{
+  uint32_t ulMisalign = (uint32_t)((ulDst ^ ulSrc) & 0x3u);
+  uint32_t ulShift = (ulMisalign == 0uL) ? 2uL : ((ulMisalign & 0x1uL) == 0uL) ? 1uL : 0uL;
+  uint32_t ulMask = (1uL << ulShift) - 1uL;
+
+  psPlan->ucShift = (uint8_t)ulShift;
+  psPlan->ulHead = (uint32_t)(-ulDst) & ulMask;
+  psPlan->ulTail = (ulSize - psPlan->ulHead) & ulMask;
+  psPlan->ulBody = ulSize - psPlan->ulHead - psPlan->ulTail;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Take ownership of a shared channel
+ *
+ * @param[in,out] *pulOwner Owner word
+ * @param[in] ulUser        User (not DMAQ_OWNER_FREE)
+ * @return  (bool)  Channel free or already owned by ulUser
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bDMAQ_Acquire(volatile uint32_t* pulOwner, uint32_t ulUser)
+{
+  bool bOwned = (*pulOwner == DMAQ_OWNER_FREE) || (*pulOwner == ulUser);
+  if (bOwned) *pulOwner = ulUser;
+  return bOwned;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Give up ownership of a shared channel
+ *
+ * @param[in,out] *pulOwner Owner word
+ * @param[in] ulUser        User
+ * @return  (bool)  ulUser owned the channel, the caller stops it
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bDMAQ_Release(volatile uint32_t* pulOwner, uint32_t ulUser)
+{
+  if ((ulUser == DMAQ_OWNER_FREE) || (*pulOwner != ulUser)) return false;
+  *pulOwner = DMAQ_OWNER_FREE;
+  return true;
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Start next chunk of the active request
+ *
+ * @param[in,out] *psQ    Queue
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vDMAQ_Start(DMAQ_TypeDef* psQ)
+{
+  DMAQ_RequestTypeDef* psReq = psQ->psHead;
+  uint32_t ulChunk = (psReq->ulCount > psQ->ulMaxChunk) ? psQ->ulMaxChunk : psReq->ulCount;
+
+  psReq->eState = DMAQ_STATE_BUSY;
+  psQ->psDrv->pfnStart(psReq, ulChunk);
+}
@@ -0,0 +1,116 @@
+/*!****************************************************************************
+ * @file
+ * dmaq.h
+ *
+ * @brief
+ * DMA request queue
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef DMAQ_H_
+#define DMAQ_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/*! @brief Request flags: addresses advanced after each chunk
+ *  @{                                                                        */
+#define DMAQ_FLAG_DST_INC             (1u << 0)
+#define DMAQ_FLAG_SRC_INC             (1u << 1)
+/*! @}                                                                        */
+
+/// Shared channel owner when unused
+#define DMAQ_OWNER_FREE               0uL
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Request state
+typedef enum {
+  DMAQ_STATE_IDLE = 0,            ///< Never submitted
+  DMAQ_STATE_QUEUED,              ///< Waiting for channel
+  DMAQ_STATE_BUSY,                ///< Transfer in progress
+  DMAQ_STATE_DONE,                ///< Transfer completed
+  DMAQ_STATE_ERROR                ///< Transfer aborted by bus error
+} DMAQ_StateTypeDef;
+
+/// Channel event, reported by the driver
+typedef enum {
+  DMAQ_EVENT_DONE = 0,            ///< Chunk transferred
+  DMAQ_EVENT_ERROR                ///< Bus error, channel stopped
+} DMAQ_EventTypeDef;
+
+struct DMAQ_Request;
+
+/// Completion callback, called from the event functions' context
+typedef void (*DMAQ_CallbackTypeDef)(struct DMAQ_Request* psReq);
+
+/*! @brief Transfer request
+ *
+ * Storage is provided by the caller and must stay valid until the request has
+ * completed. Fields other than pvContext are managed by the queue and the
+ * driver submitting it.                                                      */
+typedef struct DMAQ_Request {
+  struct DMAQ_Request* psNext;    ///< Queue link
+  uintptr_t ulDst;                ///< Next destination address
+  uintptr_t ulSrc;                ///< Next source address
+  uint32_t ulCount;               ///< Remaining transfer units
+  uint32_t ulFill;                ///< Fill pattern (memset source)
+  uint8_t ucShift;                ///< Transfer unit size, log2 of bytes (0..2)
+  uint8_t ucFlags;                ///< Flags DMAQ_FLAG_x
+  DMAQ_CallbackTypeDef pfnCallback; ///< Completion callback, or NULL
+  void* pvContext;                ///< User context
+  volatile DMAQ_StateTypeDef eState; ///< Request state
+} DMAQ_RequestTypeDef;
+
+/// Hardware driver, called from the submitting or event functions' context
+typedef struct {
+  /// Program and enable the channel for ulCount units of the request
+  void (*pfnStart)(const DMAQ_RequestTypeDef* psReq, uint32_t ulCount);
+} DMAQ_DriverTypeDef;
+
+/// Queue instance
+typedef struct {
+  const DMAQ_DriverTypeDef* psDrv; ///< Hardware driver
+  DMAQ_RequestTypeDef* psHead;    ///< Active request, followed by queued ones
+  DMAQ_RequestTypeDef* psTail;    ///< Last queued request
+  uint32_t ulMaxChunk;            ///< Most transfer units per channel activation
+} DMAQ_TypeDef;
+
+/// Split of a copy into CPU head, DMA body and CPU tail
+typedef struct {
+  uint32_t ulHead;                ///< Bytes copied by the CPU before the body
+  uint32_t ulBody;                ///< Bytes transferred by DMA
+  uint32_t ulTail;                ///< Bytes copied by the CPU after the body
+  uint8_t ucShift;                ///< Transfer unit size of the body, log2 of bytes
+} DMAQ_PlanTypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vDMAQ_Init(DMAQ_TypeDef* psQ, const DMAQ_DriverTypeDef* psDrv, uint32_t ulMaxChunk);
+void vDMAQ_Submit(DMAQ_TypeDef* psQ, DMAQ_RequestTypeDef* psReq);
+void vDMAQ_Event(DMAQ_TypeDef* psQ, DMAQ_EventTypeDef eEvent);
+void vDMAQ_Finish(DMAQ_RequestTypeDef* psReq, DMAQ_StateTypeDef eState);
+void vDMAQ_Plan(uintptr_t ulDst, uintptr_t ulSrc, uint32_t ulSize, DMAQ_PlanTypeDef* psPlan);
+
+bool bDMAQ_Acquire(volatile uint32_t* pulOwner, uint32_t ulUser);
+bool bDMAQ_Release(volatile uint32_t* pulOwner, uint32_t ulUser);
+
+/*!****************************************************************************
+ * @brief
+ * Check if a request is queued or in progress
+ *
+ * @param[in] *psReq    Request
+ * @return  (bool)  Request pending
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline bool bDMAQ_IsPending(const DMAQ_RequestTypeDef* psReq)
+{
+  DMAQ_StateTypeDef eState = psReq->eState;
+  return (eState == DMAQ_STATE_QUEUED) || (eState == DMAQ_STATE_BUSY);
+}
+
+#endif // DMAQ_H_
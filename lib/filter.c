@@ -0,0 +1,82 @@
+/*!****************************************************************************
+ * @file
+ * filter.c
+ *
+ * @brief
+ * Fixed-point block filters
+ *
+ * Intended for interleaved sample blocks (e.g. ADC scan sequences via DMA):
+ * a block is first decimated to one sum per channel, then each sum is fed
+ * into a moving average. Filtering therefore costs one pass over the block
+ * plus O(1) per channel, instead of a filter update per sample.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include "filter.h"
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Decimate block of interleaved samples into per-channel sums
+ *
+ * @param[in] *puiBlock   Samples, ulFrames * ulChannels entries
+ * @param[in] ulFrames    Number of frames (one sample per channel each)
+ * @param[in] ulChannels  Number of channels per frame
+ * @param[out] *pulSums   Per-channel sums, ulChannels entries
+ * @date  19.10.2026
+ ******************************************************************************/
+void vFILT_Decimate(const uint16_t* puiBlock, uint32_t ulFrames,
+                    uint32_t ulChannels, uint32_t* pulSums)
+{
+  for (uint32_t c = 0uL; c < ulChannels; ++c)
+  {
+    pulSums[c] = 0uL;
+  }
+
+  for (uint32_t f = 0uL; f < ulFrames; ++f)
+  {
+    for (uint32_t c = 0uL; c < ulChannels; ++c)
+    {
+      pulSums[c] += *puiBlock++;
+    }
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Initialise moving average
+ *
+ * @param[out] *psFilt  Filter state
+ * @param[in] uiInit    Initial output value
+ * @date  19.10.2026
+ ******************************************************************************/
+void vFILT_MovAvgInit(FILT_MovAvgTypeDef* psFilt, uint16_t uiInit)
+{
+  for (uint32_t i = 0uL; i < FILT_MOVAVG_LEN; ++i)
+  {
+    psFilt->auiHist[i] = uiInit;
+  }
+  psFilt->ulSum = (uint32_t)uiInit << FILT_MOVAVG_SHIFT;
+  psFilt->ucIdx = 0u;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Push value into moving average
+ *
+ * @param[in,out] *psFilt Filter state
+ * @param[in] uiIn        Input value
+ * @return  (uint16_t)  Average over the last FILT_MOVAVG_LEN inputs
+ * @date  19.10.2026
+ ******************************************************************************/
+uint16_t uiFILT_MovAvgPush(FILT_MovAvgTypeDef* psFilt, uint16_t uiIn)
+{
+  psFilt->ulSum += uiIn;
+  psFilt->ulSum -= psFilt->auiHist[psFilt->ucIdx];
+  psFilt->auiHist[psFilt->ucIdx] = uiIn;
+  psFilt->ucIdx = (uint8_t)((psFilt->ucIdx + 1u) & (FILT_MOVAVG_LEN - 1u));
+  return (uint16_t)(psFilt->ulSum >> FILT_MOVAVG_SHIFT);
+}
@@ -0,0 +1,43 @@
+/*!****************************************************************************
+ * @file
+ * filter.h
+ *
+ * @brief
+ * Fixed-point block filters
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef FILTER_H_
+#define FILTER_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Moving average length as power of two
+#ifndef FILT_MOVAVG_SHIFT
+#define FILT_MOVAVG_SHIFT             3u
+#endif
+
+/// Moving average length
+#define FILT_MOVAVG_LEN               (1u << FILT_MOVAVG_SHIFT)
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Moving average state
+typedef struct {
+  uint16_t auiHist[FILT_MOVAVG_LEN];  ///< Input history
+  uint32_t ulSum;                     ///< Sum over history
+  uint8_t ucIdx;                      ///< Oldest history entry
+} FILT_MovAvgTypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vFILT_Decimate(const uint16_t* puiBlock, uint32_t ulFrames,
+                    uint32_t ulChannels, uint32_t* pulSums);
+void vFILT_MovAvgInit(FILT_MovAvgTypeDef* psFilt, uint16_t uiInit);
+uint16_t uiFILT_MovAvgPush(FILT_MovAvgTypeDef* psFilt, uint16_t uiIn);
+
+#endif // FILTER_H_
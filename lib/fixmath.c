@@ -0,0 +1,542 @@
+/*!****************************************************************************
+ * @file
+ * fixmath.c
+ *
+ * @brief
+ * Fixed-point arithmetic (Q15/Q31) - reciprocal, square root, sine/cosine,
+ * logarithm and decimal formatting
+ *
+ * Algorithms:
+ *  - Reciprocal: CLZ normalisation to [0.5, 1), linear seed and three
+ *    Newton-Raphson steps r' = r (2 - d r) on UMULL, then an exact rounding
+ *    fix-up (division uses the same fix-up on the quotient)
+ *  - Square root: normalisation by an even shift, table seed and three
+ *    Newton-Raphson steps for 1/sqrt(d), then an exact rounding fix-up
+ *  - Sine/cosine: quarter-wave table of 256 intervals; Q31 adds the
+ *    remaining angle b with sin(a + b) = sin a cos b + cos a sin b and short
+ *    series for sin b and cos b, Q15 interpolates linearly
+ *  - Logarithm: CLZ for the integer part, table of 256 intervals with linear
+ *    interpolation for the fraction
+ *
+ * Accuracy against double precision is checked on the host with
+ * tools/fix_check (limits see there).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include "fixmath.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Intervals per quarter wave / per octave
+#define FIX_TABLE_BITS                8u
+#define FIX_TABLE_SIZE                (1u << FIX_TABLE_BITS)
+
+/// pi in Q29
+#define FIX_PI_Q29                    1686629713uL
+
+/// Reciprocal seed 48/17 - 32/17 d, both constants in Q30
+#define FIX_RECIP_C0                  3031741620uL
+#define FIX_RECIP_C1                  2021161080uL
+
+/// Newton-Raphson steps
+#define FIX_NEWTON_STEPS              3u
+
+
+/*- Private functions --------------------------------------------------------*/
+static uint32_t ulClz(uint32_t ulX);
+static int32_t lSinQuarter(uint32_t ulIdx, uint32_t ulB, bool bCos);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// sin(i * pi / 512) in unsigned Q31, i = 0..256
+static const uint32_t aulSin[FIX_TABLE_SIZE + 1u] = {
+  0x00000000uL, 0x00C90F88uL, 0x01921D20uL, 0x025B26D7uL, 0x03242ABFuL, 0x03ED26E6uL,
+  0x04B6195DuL, 0x057F0035uL, 0x0647D97CuL, 0x0710A345uL, 0x07D95B9EuL, 0x08A2009AuL,
+  0x096A9049uL, 0x0A3308BDuL, 0x0AFB6805uL, 0x0BC3AC35uL, 0x0C8BD35EuL, 0x0D53DB92uL,
+  0x0E1BC2E4uL, 0x0EE38766uL, 0x0FAB272BuL, 0x1072A048uL, 0x1139F0CFuL, 0x120116D5uL,
+  0x12C8106FuL, 0x138EDBB1uL, 0x145576B1uL, 0x151BDF86uL, 0x15E21445uL, 0x16A81305uL,
+  0x176DD9DEuL, 0x183366E9uL, 0x18F8B83CuL, 0x19BDCBF3uL, 0x1A82A026uL, 0x1B4732EFuL,
+  0x1C0B826AuL, 0x1CCF8CB3uL, 0x1D934FE5uL, 0x1E56CA1EuL, 0x1F19F97BuL, 0x1FDCDC1BuL,
+  0x209F701CuL, 0x2161B3A0uL, 0x2223A4C5uL, 0x22E541AFuL, 0x23A6887FuL, 0x24677758uL,
+  0x25280C5EuL, 0x25E845B6uL, 0x26A82186uL, 0x27679DF4uL, 0x2826B928uL, 0x28E5714BuL,
+  0x29A3C485uL, 0x2A61B101uL, 0x2B1F34EBuL, 0x2BDC4E6FuL, 0x2C98FBBAuL, 0x2D553AFCuL,
+  0x2E110A62uL, 0x2ECC681EuL, 0x2F875262uL, 0x3041C761uL, 0x30FBC54DuL, 0x31B54A5EuL,
+  0x326E54C7uL, 0x3326E2C3uL, 0x33DEF287uL, 0x34968250uL, 0x354D9057uL, 0x36041AD9uL,
+  0x36BA2014uL, 0x376F9E46uL, 0x382493B0uL, 0x38D8FE93uL, 0x398CDD32uL, 0x3A402DD2uL,
+  0x3AF2EEB7uL, 0x3BA51E29uL, 0x3C56BA70uL, 0x3D07C1D6uL, 0x3DB832A6uL, 0x3E680B2CuL,
+  0x3F1749B8uL, 0x3FC5EC98uL, 0x4073F21DuL, 0x4121589BuL, 0x41CE1E65uL, 0x427A41D0uL,
+  0x4325C135uL, 0x43D09AEDuL, 0x447ACD50uL, 0x452456BDuL, 0x45CD358FuL, 0x46756828uL,
+  0x471CECE7uL, 0x47C3C22FuL, 0x4869E665uL, 0x490F57EEuL, 0x49B41533uL, 0x4A581C9EuL,
+  0x4AFB6C98uL, 0x4B9E0390uL, 0x4C3FDFF4uL, 0x4CE10034uL, 0x4D8162C4uL, 0x4E210617uL,
+  0x4EBFE8A5uL, 0x4F5E08E3uL, 0x4FFB654DuL, 0x5097FC5EuL, 0x5133CC94uL, 0x51CED46EuL,
+  0x5269126EuL, 0x53028518uL, 0x539B2AF0uL, 0x5433027DuL, 0x54CA0A4BuL, 0x556040E2uL,
+  0x55F5A4D2uL, 0x568A34A9uL, 0x571DEEFAuL, 0x57B0D256uL, 0x5842DD54uL, 0x58D40E8CuL,
+  0x59646498uL, 0x59F3DE12uL, 0x5A82799AuL, 0x5B1035CFuL, 0x5B9D1154uL, 0x5C290ACCuL,
+  0x5CB420E0uL, 0x5D3E5237uL, 0x5DC79D7CuL, 0x5E50015DuL, 0x5ED77C8AuL, 0x5F5E0DB3uL,
+  0x5FE3B38DuL, 0x60686CCFuL, 0x60EC3830uL, 0x616F146CuL, 0x61F1003FuL, 0x6271FA69uL,
+  0x62F201ACuL, 0x637114CCuL, 0x63EF3290uL, 0x646C59BFuL, 0x64E88926uL, 0x6563BF92uL,
+  0x65DDFBD3uL, 0x66573CBBuL, 0x66CF8120uL, 0x6746C7D8uL, 0x67BD0FBDuL, 0x683257ABuL,
+  0x68A69E81uL, 0x6919E320uL, 0x698C246CuL, 0x69FD614AuL, 0x6A6D98A4uL, 0x6ADCC964uL,
+  0x6B4AF279uL, 0x6BB812D1uL, 0x6C242960uL, 0x6C8F351CuL, 0x6CF934FCuL, 0x6D6227FAuL,
+  0x6DCA0D14uL, 0x6E30E34AuL, 0x6E96A99DuL, 0x6EFB5F12uL, 0x6F5F02B2uL, 0x6FC19385uL,
+  0x7023109AuL, 0x708378FFuL, 0x70E2CBC6uL, 0x71410805uL, 0x719E2CD2uL, 0x71FA3949uL,
+  0x72552C85uL, 0x72AF05A7uL, 0x7307C3D0uL, 0x735F6626uL, 0x73B5EBD1uL, 0x740B53FBuL,
+  0x745F9DD1uL, 0x74B2C884uL, 0x7504D345uL, 0x7555BD4CuL, 0x75A585CFuL, 0x75F42C0BuL,
+  0x7641AF3DuL, 0x768E0EA6uL, 0x76D94989uL, 0x77235F2DuL, 0x776C4EDBuL, 0x77B417DFuL,
+  0x77FAB989uL, 0x78403329uL, 0x78848414uL, 0x78C7ABA2uL, 0x7909A92DuL, 0x794A7C12uL,
+  0x798A23B1uL, 0x79C89F6EuL, 0x7A05EEADuL, 0x7A4210D8uL, 0x7A7D055BuL, 0x7AB6CBA4uL,
+  0x7AEF6323uL, 0x7B26CB4FuL, 0x7B5D039EuL, 0x7B920B89uL, 0x7BC5E290uL, 0x7BF88830uL,
+  0x7C29FBEEuL, 0x7C5A3D50uL, 0x7C894BDEuL, 0x7CB72724uL, 0x7CE3CEB2uL, 0x7D0F4218uL,
+  0x7D3980ECuL, 0x7D628AC6uL, 0x7D8A5F40uL, 0x7DB0FDF8uL, 0x7DD6668FuL, 0x7DFA98A8uL,
+  0x7E1D93EAuL, 0x7E3F57FFuL, 0x7E5FE493uL, 0x7E7F3957uL, 0x7E9D55FCuL, 0x7EBA3A39uL,
+  0x7ED5E5C6uL, 0x7EF05860uL, 0x7F0991C4uL, 0x7F2191B4uL, 0x7F3857F6uL, 0x7F4DE451uL,
+  0x7F62368FuL, 0x7F754E80uL, 0x7F872BF3uL, 0x7F97CEBDuL, 0x7FA736B4uL, 0x7FB563B3uL,
+  0x7FC25596uL, 0x7FCE0C3EuL, 0x7FD8878EuL, 0x7FE1C76BuL, 0x7FE9CBC0uL, 0x7FF09478uL,
+  0x7FF62182uL, 0x7FFA72D1uL, 0x7FFD885AuL, 0x7FFF6216uL, 0x80000000uL
+};
+
+/// log2(1 + i / 256) in unsigned Q31, i = 0..256
+static const uint32_t aulLog2[FIX_TABLE_SIZE + 1u] = {
+  0x00000000uL, 0x00B84E23uL, 0x016FE50BuL, 0x0226C623uL, 0x02DCF2D1uL, 0x03926C77uL,
+  0x04473475uL, 0x04FB4C25uL, 0x05AEB4DDuL, 0x06616FF1uL, 0x07137EAEuL, 0x07C4E261uL,
+  0x08759C50uL, 0x0925ADBFuL, 0x09D517EFuL, 0x0A83DC1BuL, 0x0B31FB7DuL, 0x0BDF774BuL,
+  0x0C8C50B7uL, 0x0D3888F0uL, 0x0DE42120uL, 0x0E8F1A72uL, 0x0F397609uL, 0x0FE33508uL,
+  0x108C588DuL, 0x1134E1B5uL, 0x11DCD197uL, 0x1284294BuL, 0x132AE9E2uL, 0x13D1146EuL,
+  0x1476A9FAuL, 0x151BAB90uL, 0x15C01A3AuL, 0x1663F6FBuL, 0x170742D5uL, 0x17A9FEC8uL,
+  0x184C2BD0uL, 0x18EDCAE8uL, 0x198EDD07uL, 0x1A2F6323uL, 0x1ACF5E2EuL, 0x1B6ECF17uL,
+  0x1C0DB6CEuL, 0x1CAC163CuL, 0x1D49EE4CuL, 0x1DE73FE4uL, 0x1E840BE7uL, 0x1F205339uL,
+  0x1FBC16B9uL, 0x20575745uL, 0x20F215B7uL, 0x218C52EBuL, 0x22260FB6uL, 0x22BF4CEDuL,
+  0x23580B65uL, 0x23F04BEEuL, 0x24880F56uL, 0x251F566BuL, 0x25B621F9uL, 0x264C72C7uL,
+  0x26E2499DuL, 0x2777A741uL, 0x280C8C76uL, 0x28A0F9FEuL, 0x2934F098uL, 0x29C87102uL,
+  0x2A5B7BF9uL, 0x2AEE1236uL, 0x2B803474uL, 0x2C11E368uL, 0x2CA31FC9uL, 0x2D33EA49uL,
+  0x2DC4439BuL, 0x2E542C70uL, 0x2EE3A575uL, 0x2F72AF59uL, 0x30014AC6uL, 0x308F7868uL,
+  0x311D38E6uL, 0x31AA8CE7uL, 0x32377512uL, 0x32C3F20AuL, 0x33500472uL, 0x33DBACEBuL,
+  0x3466EC15uL, 0x34F1C28EuL, 0x357C30F3uL, 0x360637E0uL, 0x368FD7EEuL, 0x371911B8uL,
+  0x37A1E5D4uL, 0x382A54D8uL, 0x38B25F5AuL, 0x393A05EEuL, 0x39C14924uL, 0x3A482990uL,
+  0x3ACEA7C0uL, 0x3B54C444uL, 0x3BDA7FA9uL, 0x3C5FDA7AuL, 0x3CE4D544uL, 0x3D697090uL,
+  0x3DEDACE6uL, 0x3E718ACFuL, 0x3EF50AD2uL, 0x3F782D72uL, 0x3FFAF335uL, 0x407D5C9EuL,
+  0x40FF6A2EuL, 0x41811C68uL, 0x420273CAuL, 0x428370D4uL, 0x43041403uL, 0x43845DD5uL,
+  0x44044EC5uL, 0x4483E74EuL, 0x450327EBuL, 0x45821112uL, 0x4600A33EuL, 0x467EDEE4uL,
+  0x46FCC47AuL, 0x477A5476uL, 0x47F78F4CuL, 0x4874756FuL, 0x48F10751uL, 0x496D4563uL,
+  0x49E93016uL, 0x4A64C7DAuL, 0x4AE00D1DuL, 0x4B5B004DuL, 0x4BD5A1D8uL, 0x4C4FF228uL,
+  0x4CC9F1ABuL, 0x4D43A0C9uL, 0x4DBCFFEEuL, 0x4E360F81uL, 0x4EAECFEBuL, 0x4F274192uL,
+  0x4F9F64DEuL, 0x50173A35uL, 0x508EC1FAuL, 0x5105FC93uL, 0x517CEA63uL, 0x51F38BCBuL,
+  0x5269E12FuL, 0x52DFEAF0uL, 0x5355A96DuL, 0x53CB1D07uL, 0x5440461CuL, 0x54B5250CuL,
+  0x5529BA33uL, 0x559E05EEuL, 0x5612089AuL, 0x5685C293uL, 0x56F93433uL, 0x576C5DD4uL,
+  0x57DF3FD0uL, 0x5851DA81uL, 0x58C42E3DuL, 0x59363B5EuL, 0x59A80239uL, 0x5A198326uL,
+  0x5A8ABE79uL, 0x5AFBB489uL, 0x5B6C65AAuL, 0x5BDCD22FuL, 0x5C4CFA6CuL, 0x5CBCDEB4uL,
+  0x5D2C7F59uL, 0x5D9BDCADuL, 0x5E0AF6FFuL, 0x5E79CEA2uL, 0x5EE863E5uL, 0x5F56B717uL,
+  0x5FC4C886uL, 0x60329882uL, 0x60A02757uL, 0x610D7553uL, 0x617A82C3uL, 0x61E74FF2uL,
+  0x6253DD2CuL, 0x62C02ABCuL, 0x632C38EDuL, 0x63980809uL, 0x64039858uL, 0x646EEA24uL,
+  0x64D9FDB7uL, 0x6544D356uL, 0x65AF6B4BuL, 0x6619C5DBuL, 0x6683E34FuL, 0x66EDC3EBuL,
+  0x675767F5uL, 0x67C0CFB3uL, 0x6829FB69uL, 0x6892EB5CuL, 0x68FB9FCEuL, 0x69641904uL,
+  0x69CC5741uL, 0x6A345AC6uL, 0x6A9C23D6uL, 0x6B03B2B2uL, 0x6B6B079CuL, 0x6BD222D4uL,
+  0x6C39049BuL, 0x6C9FAD30uL, 0x6D061CD3uL, 0x6D6C53C2uL, 0x6DD2523DuL, 0x6E381882uL,
+  0x6E9DA6CEuL, 0x6F02FD60uL, 0x6F681C73uL, 0x6FCD0445uL, 0x7031B512uL, 0x70962F16uL,
+  0x70FA728CuL, 0x715E7FAFuL, 0x71C256BAuL, 0x7225F7E8uL, 0x72896373uL, 0x72EC9993uL,
+  0x734F9A83uL, 0x73B2667BuL, 0x7414FDB5uL, 0x74776067uL, 0x74D98ECAuL, 0x753B8916uL,
+  0x759D4F81uL, 0x75FEE242uL, 0x76604191uL, 0x76C16DA3uL, 0x772266ADuL, 0x77832CE6uL,
+  0x77E3C082uL, 0x784421B7uL, 0x78A450B8uL, 0x79044DBBuL, 0x796418F2uL, 0x79C3B292uL,
+  0x7A231ACEuL, 0x7A8251D8uL, 0x7AE157E3uL, 0x7B402D22uL, 0x7B9ED1C7uL, 0x7BFD4603uL,
+  0x7C5B8A07uL, 0x7CB99E06uL, 0x7D17822FuL, 0x7D7536B4uL, 0x7DD2BBC4uL, 0x7E30118FuL,
+  0x7E8D3846uL, 0x7EEA3017uL, 0x7F46F932uL, 0x7FA393C5uL, 0x80000000uL
+};
+
+/// 1/sqrt(d) in Q30 at the centre of [i/32, (i+1)/32), i = 8..31
+static const uint32_t aulRsqrt[24] = {
+  0x7C2DA123uL, 0x7575FAA4uL, 0x6FBA415CuL, 0x6AC266BAuL, 0x66666666uL, 0x6288D173uL,
+  0x5F137599uL, 0x5BF539E5uL, 0x5920B4DFuL, 0x568B3632uL, 0x542C1AA4uL, 0x51FC5140uL,
+  0x4FF601E0uL, 0x4E144AE9uL, 0x4C530F65uL, 0x4AAED0F0uL, 0x49249249uL, 0x47B1C049uL,
+  0x46541FB4uL, 0x4509BEB0uL, 0x43D0E917uL, 0x42A81EF6uL, 0x418E0CC8uL, 0x40818512uL
+};
+
+/// Powers of ten for formatting
+static const uint32_t aulPow10[10] = {
+  1uL, 10uL, 100uL, 1000uL, 10000uL, 100000uL, 1000000uL, 10000000uL,
+  100000000uL, 1000000000uL
+};
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Reciprocal as mantissa and exponent
+ *
+ * 1/x = result * 2^exp with |result| in [0.5, 1], rounded to nearest.
+ * x = 0 returns the largest representable value.
+ *
+ * @param[in] lX        Divisor
+ * @param[out] *plExp   Binary exponent (0..32)
+ * @return  (FIX_Q31TypeDef)  Mantissa
+ * @date  19.10.2026
+ ******************************************************************************/
+FIX_Q31TypeDef lFIX_RecipQ31(FIX_Q31TypeDef lX, int32_t* plExp)
+{
+  if (lX == 0)
+  {
+    *plExp = 31;
+    return FIX_Q31_MAX;
+  }
+
+  uint32_t ulU = (lX < 0) ? (0uL - (uint32_t)lX) : (uint32_t)lX;
+  uint32_t ulN = ulClz(ulU);
+  uint32_t ulD = ulU << ulN;    // d in [0.5, 1) as unsigned Q32, x = d 2^(1-n)
+
+  // r ~ 1/d in (1, 2] as Q30
+  uint32_t ulR = FIX_RECIP_C0 - ulFIX_UmulHi(ulD, FIX_RECIP_C1);
+  for (uint32_t i = 0u; i < FIX_NEWTON_STEPS; ++i)
+  {
+    uint32_t ulE = 0x80000000uL - ulFIX_UmulHi(ulD, ulR);   // 2 - d r
+    ulR = (uint32_t)(((uint64_t)ulR * ulE) >> 30);
+  }
+
+  // Round to nearest: r = 2^62 / d within half an LSB
+  int64_t llRem = (int64_t)(1uLL << 62) - (int64_t)((uint64_t)ulD * ulR);
+  while (2 * llRem > (int64_t)ulD) { ++ulR; llRem -= ulD; }
+  while (2 * llRem < -(int64_t)ulD) { --ulR; llRem += ulD; }
+
+  // 1/x = 1/d 2^(n-1) = (1/(2d)) 2^n, and r in Q30 is 1/(2d) in Q31
+  if (ulR >= 0x80000000uL)
+  {
+    ulR = 0x40000000uL;
+    ++ulN;
+  }
+  *plExp = (int32_t)ulN;
+  return (lX < 0) ? -(int32_t)ulR : (int32_t)ulR;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Q31 division
+ *
+ * Rounded to nearest. Saturates if |num| >= |den|, including den = 0.
+ *
+ * @param[in] lNum    Dividend
+ * @param[in] lDen    Divisor
+ * @return  (FIX_Q31TypeDef)  lNum / lDen
+ * @date  19.10.2026
+ ******************************************************************************/
+FIX_Q31TypeDef lFIX_DivQ31(FIX_Q31TypeDef lNum, FIX_Q31TypeDef lDen)
+{
+  if (lDen == 0)
+  {
+    return (lNum < 0) ? FIX_Q31_MIN : FIX_Q31_MAX;
+  }
+
+  uint32_t ulNum = (lNum < 0) ? (0uL - (uint32_t)lNum) : (uint32_t)lNum;
+  uint32_t ulDen = (lDen < 0) ? (0uL - (uint32_t)lDen) : (uint32_t)lDen;
+  bool bNeg = (lNum < 0) != (lDen < 0);
+  if (ulNum == 0u)
+  {
+    return 0;
+  }
+  if (ulNum >= ulDen)
+  {
+    return bNeg ? FIX_Q31_MIN : FIX_Q31_MAX;
+  }
+
+  // num m is Q62, the quotient is that times 2^exp (den = -1: q = num)
+  uint32_t ulQ = ulNum;
+  if (ulDen != 0x80000000uL)
+  {
+    int32_t lExp;
+    uint32_t ulM = (uint32_t)lFIX_RecipQ31((int32_t)ulDen, &lExp);
+    ulQ = (uint32_t)(((uint64_t)ulNum * ulM) >> (31u - (uint32_t)lExp));
+  }
+
+  // Round to nearest: q = num 2^31 / den within half an LSB
+  int64_t llRem = (int64_t)((uint64_t)ulNum << 31) - (int64_t)((uint64_t)ulQ * ulDen);
+  while (2 * llRem >= (int64_t)ulDen) { ++ulQ; llRem -= ulDen; }
+  while (2 * llRem < -(int64_t)ulDen) { --ulQ; llRem += ulDen; }
+
+  if (bNeg) return (ulQ >= 0x80000000uL) ? FIX_Q31_MIN : -(int32_t)ulQ;
+  return (ulQ > (uint32_t)FIX_Q31_MAX) ? FIX_Q31_MAX : (int32_t)ulQ;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Q31 square root, rounded to nearest
+ *
+ * @param[in] lX      Radicand (negative: 0)
+ * @return  (FIX_Q31TypeDef)  sqrt(lX)
+ * @date  19.10.2026
+ ******************************************************************************/
+FIX_Q31TypeDef lFIX_SqrtQ31(FIX_Q31TypeDef lX)
+{
+  if (lX <= 0)
+  {
+    return 0;
+  }
+
+  // d in [0.25, 1) as unsigned Q32, x = d 2^-k with even k
+  uint32_t ulK = ulClz((uint32_t)lX << 1) & ~1uL;
+  uint32_t ulD = ((uint32_t)lX << 1) << ulK;
+
+  // y ~ 1/sqrt(d) in (1, 2] as Q30: y' = y (3 - d y^2) / 2
+  uint32_t ulY = aulRsqrt[(ulD >> 27) - 8u];
+  for (uint32_t i = 0u; i < FIX_NEWTON_STEPS; ++i)
+  {
+    uint32_t ulY2 = ulFIX_UmulHi(ulY, ulY);                   // Q28
+    uint32_t ulF = (3uL << 28) - ulFIX_UmulHi(ulD, ulY2);     // Q28
+    ulY = (uint32_t)(((uint64_t)ulY * ulF) >> 29);
+  }
+
+  // sqrt(x) = d y 2^(-k/2), Q32 * Q30 -> Q31
+  uint32_t ulS = (uint32_t)(((uint64_t)ulD * ulY) >> (31u + ulK / 2u));
+
+  // Round to nearest: s^2 - s < x 2^31 <= s^2 + s
+  uint64_t ullT = (uint64_t)(uint32_t)lX << 31;
+  while ((uint64_t)ulS * ulS + ulS < ullT) ++ulS;
+  while ((ulS > 0u) && ((uint64_t)ulS * ulS - ulS >= ullT)) --ulS;
+
+  return (ulS > (uint32_t)FIX_Q31_MAX) ? FIX_Q31_MAX : (int32_t)ulS;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Q15 square root
+ *
+ * @param[in] iX      Radicand (negative: 0)
+ * @return  (FIX_Q15TypeDef)  sqrt(iX)
+ * @date  19.10.2026
+ ******************************************************************************/
+FIX_Q15TypeDef iFIX_SqrtQ15(FIX_Q15TypeDef iX)
+{
+  uint32_t ulS = (uint32_t)lFIX_SqrtQ31((int32_t)iX * 65536);
+  return iFIX_SatQ15((int32_t)((ulS + 0x8000uL) >> 16));
+}
+
+/*!****************************************************************************
+ * @brief
+ * Q31 sine
+ *
+ * @param[in] ulAngle   Angle, full turn = 2^32
+ * @return  (FIX_Q31TypeDef)  sin(ulAngle)
+ * @date  19.10.2026
+ ******************************************************************************/
+FIX_Q31TypeDef lFIX_SinQ31(uint32_t ulAngle)
+{
+  uint32_t ulQuad = ulAngle >> 30;
+  uint32_t ulIdx = (ulAngle >> 22) & (FIX_TABLE_SIZE - 1u);
+
+  // Remainder b = frac 2 pi / 2^32, in Q34 this is frac pi 8
+  uint32_t ulB = (uint32_t)(((uint64_t)(ulAngle & 0x3FFFFFuL) * FIX_PI_Q29 + (1uLL << 25)) >> 26);
+
+  // Quadrants 1 and 3 continue with the cosine of the phase
+  int32_t lY = lSinQuarter(ulIdx, ulB, (ulQuad & 1u) != 0u);
+  return (ulQuad & 2u) ? -lY : lY;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Q31 cosine
+ *
+ * @param[in] ulAngle   Angle, full turn = 2^32
+ * @return  (FIX_Q31TypeDef)  cos(ulAngle)
+ * @date  19.10.2026
+ ******************************************************************************/
+FIX_Q31TypeDef lFIX_CosQ31(uint32_t ulAngle)
+{
+  return lFIX_SinQ31(ulAngle + 0x40000000uL);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Q15 sine
+ *
+ * @param[in] uiAngle   Angle, full turn = 2^16
+ * @return  (FIX_Q15TypeDef)  sin(uiAngle)
+ * @date  19.10.2026
+ ******************************************************************************/
+FIX_Q15TypeDef iFIX_SinQ15(uint16_t uiAngle)
+{
+  uint32_t ulQuad = (uint32_t)uiAngle >> 14;
+  uint32_t ulIdx = ((uint32_t)uiAngle >> 6) & (FIX_TABLE_SIZE - 1u);
+  int32_t lFrac = (int32_t)(uiAngle & 0x3Fu);
+
+  // Interpolate between table entries, walking backwards for the cosine
+  uint32_t ulY0, ulY1;
+  if (ulQuad & 1u)
+  {
+    ulY0 = aulSin[FIX_TABLE_SIZE - ulIdx];
+    ulY1 = aulSin[FIX_TABLE_SIZE - 1u - ulIdx];
+  }
+  else
+  {
+    ulY0 = aulSin[ulIdx];
+    ulY1 = aulSin[ulIdx + 1u];
+  }
+  uint32_t ulY = ulY0 + (uint32_t)(((int32_t)(ulY1 - ulY0) * lFrac) >> 6);
+  int32_t lR = iFIX_SatQ15((int32_t)((ulY + 0x8000uL) >> 16));
+  return (FIX_Q15TypeDef)((ulQuad & 2u) ? -lR : lR);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Q15 cosine
+ *
+ * @param[in] uiAngle   Angle, full turn = 2^16
+ * @return  (FIX_Q15TypeDef)  cos(uiAngle)
+ * @date  19.10.2026
+ ******************************************************************************/
+FIX_Q15TypeDef iFIX_CosQ15(uint16_t uiAngle)
+{
+  return iFIX_SinQ15((uint16_t)(uiAngle + 0x4000u));
+}
+
+/*!****************************************************************************
+ * @brief
+ * Binary logarithm of an unsigned fixed-point number
+ *
+ * E.g. ulFrac = 0 for integers, 31 for (positive) Q31. Error is below one
+ * LSB of the result.
+ *
+ * @param[in] ulX     Argument
+ * @param[in] ulFrac  Fractional bits of ulX (0..31)
+ * @return  (FIX_Q16TypeDef)  log2(ulX / 2^ulFrac), INT32_MIN for 0
+ * @date  19.10.2026
+ ******************************************************************************/
+FIX_Q16TypeDef lFIX_Log2(uint32_t ulX, uint32_t ulFrac)
+{
+  if (ulX == 0u)
+  {
+    return INT32_MIN;
+  }
+
+  // x = 2^n (1 + t) with t in [0, 1)
+  uint32_t ulZ = ulClz(ulX);
+  uint32_t ulM = ulX << ulZ;
+  uint32_t ulIdx = (ulM >> 23) & (FIX_TABLE_SIZE - 1u);
+  uint32_t ulFracT = (ulM & 0x7FFFFFuL) << 9;
+
+  uint32_t ulL0 = aulLog2[ulIdx];
+  uint32_t ulL = ulL0 + ulFIX_UmulHi(aulLog2[ulIdx + 1u] - ulL0, ulFracT);
+
+  int32_t lInt = 31 - (int32_t)ulZ - (int32_t)ulFrac;
+  return (int32_t)((uint32_t)lInt << 16) + (int32_t)((ulL + 0x4000uL) >> 15);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Format a signed fixed-point number as decimal string
+ *
+ * Rounds to nearest, e.g. Q15 0x4000 with 3 digits gives "0.500". Uses
+ * integer arithmetic only (no printf float support needed).
+ *
+ * @param[out] *pcBuf   Output, FIX_FORMAT_MAX bytes
+ * @param[in] lX        Value
+ * @param[in] ulFrac    Fractional bits of lX (0..31), e.g. 15 for Q15
+ * @param[in] ulDigits  Decimal places (0..9)
+ * @return  (uint32_t)  String length
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulFIX_Format(char* pcBuf, int32_t lX, uint32_t ulFrac, uint32_t ulDigits)
+{
+  if (ulFrac > 31u) ulFrac = 31u;
+  if (ulDigits > 9u) ulDigits = 9u;
+
+  uint32_t ulAbs = (lX < 0) ? (0uL - (uint32_t)lX) : (uint32_t)lX;
+  uint32_t ulInt = ulAbs >> ulFrac;
+  uint32_t ulRem = ulAbs & ((1uL << ulFrac) - 1uL);
+
+  // Scale the remainder to ulDigits decimals, rounding may carry over
+  uint32_t ulScale = aulPow10[ulDigits];
+  uint64_t ullHalf = (ulFrac > 0u) ? ((uint64_t)1 << (ulFrac - 1u)) : 0u;
+  uint32_t ulDec = (uint32_t)(((uint64_t)ulRem * ulScale + ullHalf) >> ulFrac);
+  if (ulDec >= ulScale)
+  {
+    ulDec -= ulScale;
+    ++ulInt;
+  }
+
+  bool bNeg = (lX < 0) && ((ulInt | ulDec) != 0u);
+
+  // Digits are produced backwards into a temporary buffer
+  char acTmp[FIX_FORMAT_MAX];
+  uint32_t ulPos = 0u;
+  for (uint32_t i = 0u; i < ulDigits; ++i)
+  {
+    acTmp[ulPos++] = (char)('0' + ulDec % 10u);
+    ulDec /= 10u;
+  }
+  if (ulDigits > 0u)
+  {
+    acTmp[ulPos++] = '.';
+  }
+  do
+  {
+    acTmp[ulPos++] = (char)('0' + ulInt % 10u);
+    ulInt /= 10u;
+  } while (ulInt > 0u);
+
+  // No sign if the rounded value is zero
+  uint32_t ulLen = 0u;
+  if (bNeg)
+  {
+    pcBuf[ulLen++] = '-';
+  }
+  while (ulPos > 0u)
+  {
+    pcBuf[ulLen++] = acTmp[--ulPos];
+  }
+  pcBuf[ulLen] = '\0';
+  return ulLen;
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Count leading zeros (CLZ)
+ *
+ * @param[in] ulX     Value (not 0)
+ * @return  (uint32_t)  Number of leading zero bits
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulClz(uint32_t ulX)
+{
+  return (uint32_t)__builtin_clz(ulX);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Sine or cosine of a phase within the first quadrant
+ *
+ * The phase is the table point a = idx pi / 512 plus b in [0, pi / 512).
+ *
+ * @param[in] ulIdx   Table index (0..255)
+ * @param[in] ulB     Remainder b in Q34
+ * @param[in] bCos    Cosine instead of sine
+ * @return  (int32_t)  Result in Q31
+ * @date  19.10.2026
+ ******************************************************************************/
+static int32_t lSinQuarter(uint32_t ulIdx, uint32_t ulB, bool bCos)
+{
+  uint32_t ulSa = aulSin[ulIdx];
+  uint32_t ulCa = aulSin[FIX_TABLE_SIZE - ulIdx];
+
+  // sin b = b - b^3/6, 1 - cos b = b^2/2 in Q34 (next terms below 2^-33)
+  uint64_t ullB2 = (uint64_t)ulB * ulB;
+  uint32_t ulB3 = (uint32_t)((((ullB2 >> 34) * ulB) >> 34) / 6u);
+  uint32_t ulSinB = ulB - ulB3;
+  uint32_t ulOmcB = (uint32_t)((ullB2 + (1uLL << 34)) >> 35);
+
+  // sin(a + b) = sin a - sin a (1 - cos b) + cos a sin b
+  // cos(a + b) = cos a - cos a (1 - cos b) - sin a sin b
+  // in unsigned Q62 (all terms are positive in the first quadrant), the
+  // Q31 * Q34 products are scaled down by 2^3
+  uint64_t ullAcc;
+  if (bCos)
+  {
+    ullAcc = ((uint64_t)ulCa << 31) - (((uint64_t)ulCa * ulOmcB) >> 3) - (((uint64_t)ulSa * ulSinB) >> 3);
+  }
+  else
+  {
+    ullAcc = ((uint64_t)ulSa << 31) - (((uint64_t)ulSa * ulOmcB) >> 3) + (((uint64_t)ulCa * ulSinB) >> 3);
+  }
+  uint32_t ulY = (uint32_t)((ullAcc + (1uLL << 30)) >> 31);
+  return (ulY > (uint32_t)FIX_Q31_MAX) ? FIX_Q31_MAX : (int32_t)ulY;
+}
@@ -0,0 +1,273 @@
+/*!****************************************************************************
+ * @file
+ * fixmath.h
+ *
+ * @brief
+ * Fixed-point arithmetic (Q15/Q31)
+ *
+ * The Cortex-M3 has no FPU, so float arithmetic ends up in soft-float library
+ * calls of typically 50..150 cycles (sqrtf(), sinf() many hundreds). These
+ * functions work on signed fractions instead:
+ *  - Q15: int16_t, value = x / 2^15, range [-1, 1 - 2^-15]
+ *  - Q31: int32_t, value = x / 2^31, range [-1, 1 - 2^-31]
+ *  - Q16: int32_t, value = x / 2^16 (results with integer part, e.g. log2)
+ *
+ * Multiplications round to nearest and saturate; products accumulate in
+ * 64 bits without intermediate rounding. The single-instruction primitives
+ * (SSAT, SMULL, SMLAL, UMULL) are inline and use the M3 instructions
+ * directly, with portable C for the host build that produces the same
+ * results bit for bit.
+ *
+ * Constants are converted at compile time, e.g. FIX_Q15(0.5), so that no
+ * float code is generated.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef FIXMATH_H_
+#define FIXMATH_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Use Cortex-M3 instructions (host: portable C)
+#ifndef FIX_USE_ASM
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#define FIX_USE_ASM                   1
+#else
+#define FIX_USE_ASM                   0
+#endif
+#endif
+
+/*! @brief Range limits
+ *  @{                                                                        */
+#define FIX_Q15_MAX                   ((FIX_Q15TypeDef)0x7FFF)
+#define FIX_Q15_MIN                   ((FIX_Q15TypeDef)-0x8000)
+#define FIX_Q31_MAX                   ((FIX_Q31TypeDef)0x7FFFFFFF)
+#define FIX_Q31_MIN                   ((FIX_Q31TypeDef)(-0x7FFFFFFF - 1))
+/*! @}                                                                        */
+
+/*! @brief Constant conversion from a floating-point literal, saturated and
+ *         rounded to nearest (folded by the compiler)
+ *  @{                                                                        */
+#define FIX_Q15(x)                    ((FIX_Q15TypeDef)FIX_CONST_((x), 32768.0, 32767.0, -32768.0))
+#define FIX_Q31(x)                    ((FIX_Q31TypeDef)FIX_CONST_((x), 2147483648.0, 2147483647.0, -2147483648.0))
+#define FIX_Q16(x)                    ((FIX_Q16TypeDef)FIX_CONST_((x), 65536.0, 2147483647.0, -2147483648.0))
+#define FIX_CONST_(x, s, hi, lo)      (((x) * (s) >= (hi)) ? (hi) : ((x) * (s) <= (lo)) ? (lo) : \
+                                       ((x) >= 0.0) ? (x) * (s) + 0.5 : (x) * (s) - 0.5)
+/*! @}                                                                        */
+
+/*! @brief Angles in binary units (full turn = 2^16 or 2^32)
+ *  @{                                                                        */
+#define FIX_ANGLE16_DEG(d)            ((uint16_t)(int32_t)((d) * 65536.0 / 360.0))
+#define FIX_ANGLE32_DEG(d)            ((uint32_t)(int64_t)((d) * 4294967296.0 / 360.0))
+/*! @}                                                                        */
+
+/// Longest output of ulFIX_Format() including terminator
+#define FIX_FORMAT_MAX                24u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+typedef int16_t FIX_Q15TypeDef;   ///< Q15 fraction
+typedef int32_t FIX_Q31TypeDef;   ///< Q31 fraction
+typedef int32_t FIX_Q16TypeDef;   ///< Q15.16 number
+typedef int64_t FIX_AccTypeDef;   ///< Q62 accumulator (Q31 * Q31)
+
+
+/*- Public interface ---------------------------------------------------------*/
+FIX_Q31TypeDef lFIX_RecipQ31(FIX_Q31TypeDef lX, int32_t* plExp);
+FIX_Q31TypeDef lFIX_DivQ31(FIX_Q31TypeDef lNum, FIX_Q31TypeDef lDen);
+FIX_Q31TypeDef lFIX_SqrtQ31(FIX_Q31TypeDef lX);
+FIX_Q15TypeDef iFIX_SqrtQ15(FIX_Q15TypeDef iX);
+FIX_Q31TypeDef lFIX_SinQ31(uint32_t ulAngle);
+FIX_Q31TypeDef lFIX_CosQ31(uint32_t ulAngle);
+FIX_Q15TypeDef iFIX_SinQ15(uint16_t uiAngle);
+FIX_Q15TypeDef iFIX_CosQ15(uint16_t uiAngle);
+FIX_Q16TypeDef lFIX_Log2(uint32_t ulX, uint32_t ulFrac);
+uint32_t ulFIX_Format(char* pcBuf, int32_t lX, uint32_t ulFrac, uint32_t ulDigits);
+
+
+/*- Inline functions ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Saturate to Q15 range
+ *
+ * @param[in] lX      Value
+ * @return  (FIX_Q15TypeDef)  lX limited to [-2^15, 2^15 - 1]
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline FIX_Q15TypeDef iFIX_SatQ15(int32_t lX)
+{
+#if FIX_USE_ASM
+  __asm__ ("ssat %0, #16, %1" : "=r" (lX) : "r" (lX));
+  return (FIX_Q15TypeDef)lX;
+#else
+  return (FIX_Q15TypeDef)((lX > 0x7FFF) ? 0x7FFF : (lX < -0x8000) ? -0x8000 : lX);
+#endif
+}
+
+/*!****************************************************************************
+ * @brief
+ * Saturate 64-bit value to Q31 range
+ *
+ * @param[in] llX     Value
+ * @return  (FIX_Q31TypeDef)  llX limited to [-2^31, 2^31 - 1]
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline FIX_Q31TypeDef lFIX_SatQ31(int64_t llX)
+{
+  // Compiles to a compare of the high word against the sign of the low word
+  if (llX > (int64_t)FIX_Q31_MAX) return FIX_Q31_MAX;
+  if (llX < (int64_t)FIX_Q31_MIN) return FIX_Q31_MIN;
+  return (FIX_Q31TypeDef)llX;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Saturating Q15 addition
+ *
+ * @param[in] iA      Addend
+ * @param[in] iB      Addend
+ * @return  (FIX_Q15TypeDef)  iA + iB
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline FIX_Q15TypeDef iFIX_AddQ15(FIX_Q15TypeDef iA, FIX_Q15TypeDef iB)
+{
+  return iFIX_SatQ15((int32_t)iA + iB);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Saturating Q31 addition
+ *
+ * @param[in] lA      Addend
+ * @param[in] lB      Addend
+ * @return  (FIX_Q31TypeDef)  lA + lB
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline FIX_Q31TypeDef lFIX_AddQ31(FIX_Q31TypeDef lA, FIX_Q31TypeDef lB)
+{
+  return lFIX_SatQ31((int64_t)lA + lB);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Q15 multiplication, rounded and saturated
+ *
+ * Only -1 * -1 saturates.
+ *
+ * @param[in] iA      Factor
+ * @param[in] iB      Factor
+ * @return  (FIX_Q15TypeDef)  iA * iB
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline FIX_Q15TypeDef iFIX_MulQ15(FIX_Q15TypeDef iA, FIX_Q15TypeDef iB)
+{
+  return iFIX_SatQ15(((int32_t)iA * iB + (1L << 14)) >> 15);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Full 32 x 32 -> 64 bit signed product (SMULL)
+ *
+ * @param[in] lA      Factor
+ * @param[in] lB      Factor
+ * @return  (int64_t)  lA * lB
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline int64_t llFIX_Smull(int32_t lA, int32_t lB)
+{
+#if FIX_USE_ASM
+  uint32_t ulLo;
+  int32_t lHi;
+  __asm__ ("smull %0, %1, %2, %3" : "=&r" (ulLo), "=&r" (lHi) : "r" (lA), "r" (lB));
+  return (int64_t)(((uint64_t)(uint32_t)lHi << 32) | ulLo);
+#else
+  return (int64_t)lA * lB;
+#endif
+}
+
+/*!****************************************************************************
+ * @brief
+ * High word of the unsigned 32 x 32 -> 64 bit product (UMULL)
+ *
+ * @param[in] ulA     Factor
+ * @param[in] ulB     Factor
+ * @return  (uint32_t)  (ulA * ulB) >> 32
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline uint32_t ulFIX_UmulHi(uint32_t ulA, uint32_t ulB)
+{
+#if FIX_USE_ASM
+  uint32_t ulLo, ulHi;
+  __asm__ ("umull %0, %1, %2, %3" : "=&r" (ulLo), "=&r" (ulHi) : "r" (ulA), "r" (ulB));
+  (void)ulLo;
+  return ulHi;
+#else
+  return (uint32_t)(((uint64_t)ulA * ulB) >> 32);
+#endif
+}
+
+/*!****************************************************************************
+ * @brief
+ * Q31 multiplication, rounded and saturated
+ *
+ * Only -1 * -1 saturates.
+ *
+ * @param[in] lA      Factor
+ * @param[in] lB      Factor
+ * @return  (FIX_Q31TypeDef)  lA * lB
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline FIX_Q31TypeDef lFIX_MulQ31(FIX_Q31TypeDef lA, FIX_Q31TypeDef lB)
+{
+  int64_t llP = llFIX_Smull(lA, lB) + (1LL << 30);
+  int32_t lR = (int32_t)(llP >> 31);
+  // (-1) * (-1) = +1 is the only product out of range
+  return ((lA == FIX_Q31_MIN) && (lB == FIX_Q31_MIN)) ? FIX_Q31_MAX : lR;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Multiply-accumulate into a Q62 accumulator (SMLAL)
+ *
+ * Wraps instead of saturating, so partial sums may leave the range: a dot
+ * product of any length is exact as long as the final sum is within [-2, 2).
+ *
+ * @param[in] llAcc   Accumulator
+ * @param[in] lA      Factor
+ * @param[in] lB      Factor
+ * @return  (FIX_AccTypeDef)  llAcc + lA * lB
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline FIX_AccTypeDef llFIX_MacQ31(FIX_AccTypeDef llAcc, FIX_Q31TypeDef lA,
+                                          FIX_Q31TypeDef lB)
+{
+#if FIX_USE_ASM
+  uint32_t ulLo = (uint32_t)llAcc;
+  int32_t lHi = (int32_t)(llAcc >> 32);
+  __asm__ ("smlal %0, %1, %2, %3" : "+r" (ulLo), "+r" (lHi) : "r" (lA), "r" (lB));
+  return (FIX_AccTypeDef)(((uint64_t)(uint32_t)lHi << 32) | ulLo);
+#else
+  return (FIX_AccTypeDef)((uint64_t)llAcc + (uint64_t)((int64_t)lA * lB));
+#endif
+}
+
+/*!****************************************************************************
+ * @brief
+ * Convert Q62 accumulator to Q31, rounded and saturated
+ *
+ * @param[in] llAcc   Accumulator
+ * @return  (FIX_Q31TypeDef)  Result
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline FIX_Q31TypeDef lFIX_AccToQ31(FIX_AccTypeDef llAcc)
+{
+  // Round without overflowing at the top of the range
+  int64_t llR = (llAcc >> 31) + ((llAcc >> 30) & 1);
+  return lFIX_SatQ31(llR);
+}
+
+#endif // FIXMATH_H_
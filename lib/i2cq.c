@@ -0,0 +1,376 @@
+/*!****************************************************************************
+ * @file
+ * i2cq.c
+ *
+ * @brief
+ * I2C master transaction queue
+ *
+ * Transactions are linked into a FIFO queue owned by the caller's storage
+ * (no allocation) and run one after the other. Each consists of an optional
+ * write phase and an optional read phase after a repeated start; the state
+ * machine advances on bus events reported by the driver and asks the driver
+ * for the next bus action, so that the CPU is only involved at phase
+ * boundaries while the driver moves the data (DMA).
+ *
+ * A not acknowledged address or data byte ends the attempt with a stop
+ * condition. Bus errors, lost arbitration and phase timeouts additionally
+ * let the driver recover the bus. Failed attempts are repeated up to the
+ * configured number of retries before the transaction completes with the
+ * error status.
+ *
+ * A batch submits several transactions at once, e.g. all sensor reads of a
+ * sampling period. They run back-to-back, and a batch callback follows the
+ * callback of the last one.
+ *
+ * The functions are not reentrant: events, ticks and submissions must be
+ * serialised by the caller. Callbacks may submit new transactions. The
+ * driver is the only hardware dependency, so the queue also runs on a host
+ * against a simulated bus (tools/i2c_sim).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stddef.h>
+#include "i2cq.h"
+
+
+/*- Private functions --------------------------------------------------------*/
+static bool bI2CQ_IsValid(const I2CQ_XferTypeDef* psXfer);
+static void vI2CQ_Append(I2CQ_TypeDef* psQ, I2CQ_XferTypeDef* psXfer);
+static void vI2CQ_Begin(I2CQ_TypeDef* psQ);
+static void vI2CQ_Arm(I2CQ_TypeDef* psQ, uint16_t uiLen);
+static void vI2CQ_Fail(I2CQ_TypeDef* psQ, I2CQ_StatusTypeDef eStatus);
+static void vI2CQ_Finish(I2CQ_TypeDef* psQ, I2CQ_StatusTypeDef eStatus);
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise queue
+ *
+ * A phase times out after uiTimeoutBase ticks plus the ticks needed for its
+ * data at bus speed.
+ *
+ * @param[out] *psQ           Queue
+ * @param[in] *psDrv          Hardware driver
+ * @param[in] ucRetries       Repeated attempts after an error
+ * @param[in] uiTimeoutBase   Phase timeout in ticks, without data
+ * @param[in] uiBytesPerTick  Bytes transferred per tick (min. 1)
+ * @date  19.10.2026
+ ******************************************************************************/
+void vI2CQ_Init(I2CQ_TypeDef* psQ, const I2CQ_DriverTypeDef* psDrv, uint8_t ucRetries,
+                uint16_t uiTimeoutBase, uint16_t uiBytesPerTick)
+{
+  psQ->psDrv = psDrv;
+  psQ->psHead = NULL;
+  psQ->psTail = NULL;
+  psQ->eState = I2CQ_STATE_IDLE;
+  psQ->ucRetries = ucRetries;
+  psQ->uiTimeoutBase = uiTimeoutBase;
+  psQ->uiBytesPerTick = (uiBytesPerTick != 0u) ? uiBytesPerTick : 1u;
+  psQ->ulTicksLeft = 0uL;
+  psQ->sStats = (I2CQ_StatsTypeDef){ 0 };
+}
+
+/*!****************************************************************************
+ * @brief
+ * Submit transaction
+ *
+ * The transaction and its buffers must stay valid until its status is no
+ * longer I2CQ_STATUS_PENDING.
+ *
+ * @param[in,out] *psQ    Queue
+ * @param[in,out] *psXfer Transaction
+ * @return  (bool)  Transaction queued, false if already pending or invalid
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bI2CQ_Submit(I2CQ_TypeDef* psQ, I2CQ_XferTypeDef* psXfer)
+{
+  if (!bI2CQ_IsValid(psXfer)) return false;
+
+  psXfer->psBatch = NULL;
+  vI2CQ_Append(psQ, psXfer);
+  if (psQ->eState == I2CQ_STATE_IDLE) vI2CQ_Begin(psQ);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Submit batch of transactions
+ *
+ * Either all transactions of the batch are queued or none.
+ *
+ * @param[in,out] *psQ      Queue
+ * @param[in,out] *psBatch  Batch
+ * @return  (bool)  Batch queued, false if empty, pending or invalid
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bI2CQ_SubmitBatch(I2CQ_TypeDef* psQ, I2CQ_BatchTypeDef* psBatch)
+{
+  if ((psBatch->ulCount == 0uL) || (psBatch->ulPending != 0uL)) return false;
+  for (uint32_t i = 0uL; i < psBatch->ulCount; ++i)
+  {
+    if (!bI2CQ_IsValid(&psBatch->psXfers[i])) return false;
+  }
+
+  psBatch->ulPending = psBatch->ulCount;
+  psBatch->ulFailed = 0uL;
+  for (uint32_t i = 0uL; i < psBatch->ulCount; ++i)
+  {
+    psBatch->psXfers[i].psBatch = psBatch;
+    vI2CQ_Append(psQ, &psBatch->psXfers[i]);
+  }
+  if (psQ->eState == I2CQ_STATE_IDLE) vI2CQ_Begin(psQ);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Process bus event
+ *
+ * Events while idle (e.g. a late flag after a stop) are ignored; events not
+ * expected in the current state are handled as bus error.
+ *
+ * @param[in,out] *psQ    Queue
+ * @param[in] eEvent      Event
+ * @date  19.10.2026
+ ******************************************************************************/
+void vI2CQ_Event(I2CQ_TypeDef* psQ, I2CQ_EventTypeDef eEvent)
+{
+  if (psQ->eState == I2CQ_STATE_IDLE) return;
+
+  const I2CQ_DriverTypeDef* psDrv = psQ->psDrv;
+  I2CQ_XferTypeDef* psXfer = psQ->psHead;
+
+  if (eEvent == I2CQ_EVENT_NACK)
+  {
+    vI2CQ_Fail(psQ, I2CQ_STATUS_NACK);
+    return;
+  }
+
+  switch (psQ->eState)
+  {
+    case I2CQ_STATE_START_WRITE:
+      if (eEvent != I2CQ_EVENT_START) break;
+      psQ->eState = I2CQ_STATE_ADDR_WRITE;
+      vI2CQ_Arm(psQ, 0u);
+      psDrv->pfnAddress((uint8_t)(psXfer->ucAddr << 1));
+      return;
+
+    case I2CQ_STATE_ADDR_WRITE:
+      if (eEvent != I2CQ_EVENT_ADDR) break;
+      if (psXfer->uiTxLen == 0u)
+      {
+        // Probe
+        psDrv->pfnStop();
+        vI2CQ_Finish(psQ, I2CQ_STATUS_OK);
+        return;
+      }
+      psQ->eState = I2CQ_STATE_WRITE;
+      vI2CQ_Arm(psQ, psXfer->uiTxLen);
+      psDrv->pfnWrite(psXfer->pucTx, psXfer->uiTxLen);
+      return;
+
+    case I2CQ_STATE_WRITE:
+      if (eEvent != I2CQ_EVENT_DONE) break;
+      if (psXfer->uiRxLen == 0u)
+      {
+        psDrv->pfnStop();
+        vI2CQ_Finish(psQ, I2CQ_STATUS_OK);
+        return;
+      }
+      psQ->eState = I2CQ_STATE_START_READ;
+      vI2CQ_Arm(psQ, 0u);
+      psDrv->pfnStart();
+      return;
+
+    case I2CQ_STATE_START_READ:
+      if (eEvent != I2CQ_EVENT_START) break;
+      psQ->eState = I2CQ_STATE_ADDR_READ;
+      vI2CQ_Arm(psQ, 0u);
+      psDrv->pfnAddress((uint8_t)((psXfer->ucAddr << 1) | 1u));
+      return;
+
+    case I2CQ_STATE_ADDR_READ:
+      if (eEvent != I2CQ_EVENT_ADDR) break;
+      psQ->eState = I2CQ_STATE_READ;
+      vI2CQ_Arm(psQ, psXfer->uiRxLen);
+      psDrv->pfnRead(psXfer->pucRx, psXfer->uiRxLen);
+      return;
+
+    case I2CQ_STATE_READ:
+      if (eEvent != I2CQ_EVENT_DONE) break;
+      psDrv->pfnStop();
+      vI2CQ_Finish(psQ, I2CQ_STATUS_OK);
+      return;
+
+    default:
+      break;
+  }
+
+  vI2CQ_Fail(psQ, I2CQ_STATUS_BUS);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Advance phase timeout
+ *
+ * Must be called periodically while the queue is busy.
+ *
+ * @param[in,out] *psQ    Queue
+ * @date  19.10.2026
+ ******************************************************************************/
+void vI2CQ_Tick(I2CQ_TypeDef* psQ)
+{
+  if (psQ->eState == I2CQ_STATE_IDLE) return;
+
+  if (--psQ->ulTicksLeft == 0uL) vI2CQ_Fail(psQ, I2CQ_STATUS_TIMEOUT);
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Check if transaction may be submitted
+ *
+ * @param[in] *psXfer   Transaction
+ * @return  (bool)  Not pending, valid address and buffers
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bI2CQ_IsValid(const I2CQ_XferTypeDef* psXfer)
+{
+  return (psXfer->eStatus != I2CQ_STATUS_PENDING) && (psXfer->ucAddr <= I2CQ_ADDR_MAX) &&
+         ((psXfer->uiTxLen == 0u) || (psXfer->pucTx != NULL)) &&
+         ((psXfer->uiRxLen == 0u) || (psXfer->pucRx != NULL));
+}
+
+/*!****************************************************************************
+ * @brief
+ * Append transaction to queue
+ *
+ * @param[in,out] *psQ    Queue
+ * @param[in,out] *psXfer Transaction
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vI2CQ_Append(I2CQ_TypeDef* psQ, I2CQ_XferTypeDef* psXfer)
+{
+  psXfer->psNext = NULL;
+  psXfer->ucAttempts = 0u;
+  psXfer->eStatus = I2CQ_STATUS_PENDING;
+
+  if (psQ->psTail != NULL)
+  {
+    psQ->psTail->psNext = psXfer;
+  }
+  else
+  {
+    psQ->psHead = psXfer;
+  }
+  psQ->psTail = psXfer;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start attempt of the transaction at the queue head
+ *
+ * @param[in,out] *psQ    Queue
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vI2CQ_Begin(I2CQ_TypeDef* psQ)
+{
+  I2CQ_XferTypeDef* psXfer = psQ->psHead;
+
+  psXfer->ucAttempts++;
+  psQ->eState = ((psXfer->uiTxLen != 0u) || (psXfer->uiRxLen == 0u)) ?
+                I2CQ_STATE_START_WRITE : I2CQ_STATE_START_READ;
+  vI2CQ_Arm(psQ, 0u);
+  psQ->psDrv->pfnStart();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Arm timeout of the next phase
+ *
+ * One tick is added because the first tick may follow immediately.
+ *
+ * @param[in,out] *psQ    Queue
+ * @param[in] uiLen       Data bytes of the phase
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vI2CQ_Arm(I2CQ_TypeDef* psQ, uint16_t uiLen)
+{
+  psQ->ulTicksLeft = 1uL + psQ->uiTimeoutBase + uiLen / psQ->uiBytesPerTick;
+}
+
+/*!****************************************************************************
+ * @brief
+ * End failed attempt, then retry or complete
+ *
+ * @param[in,out] *psQ    Queue
+ * @param[in] eStatus     Error status
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vI2CQ_Fail(I2CQ_TypeDef* psQ, I2CQ_StatusTypeDef eStatus)
+{
+  if (eStatus == I2CQ_STATUS_NACK)
+  {
+    psQ->psDrv->pfnStop();
+  }
+  else
+  {
+    psQ->psDrv->pfnRecover();
+    psQ->sStats.ulRecoveries++;
+  }
+
+  if (psQ->psHead->ucAttempts <= psQ->ucRetries)
+  {
+    psQ->sStats.ulRetries++;
+    vI2CQ_Begin(psQ);
+  }
+  else
+  {
+    vI2CQ_Finish(psQ, eStatus);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Complete transaction at the queue head and start the next one
+ *
+ * The transaction is unlinked before its callback, so that the callback may
+ * submit it again.
+ *
+ * @param[in,out] *psQ    Queue
+ * @param[in] eStatus     Final status
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vI2CQ_Finish(I2CQ_TypeDef* psQ, I2CQ_StatusTypeDef eStatus)
+{
+  I2CQ_XferTypeDef* psXfer = psQ->psHead;
+  I2CQ_BatchTypeDef* psBatch = psXfer->psBatch;
+
+  psQ->psHead = psXfer->psNext;
+  if (psQ->psHead == NULL) psQ->psTail = NULL;
+  psQ->eState = I2CQ_STATE_IDLE;
+
+  if (eStatus == I2CQ_STATUS_OK)
+  {
+    psQ->sStats.ulDone++;
+  }
+  else
+  {
+    psQ->sStats.ulFailed++;
+    if (psBatch != NULL) psBatch->ulFailed++;
+  }
+
+  psXfer->eStatus = eStatus;
+  if (psXfer->pfnDone != NULL) psXfer->pfnDone(psXfer);
+  if ((psBatch != NULL) && (--psBatch->ulPending == 0uL) && (psBatch->pfnDone != NULL))
+  {
+    psBatch->pfnDone(psBatch);
+  }
+
+  // A callback may have started a submitted transaction already
+  if ((psQ->eState == I2CQ_STATE_IDLE) && (psQ->psHead != NULL)) vI2CQ_Begin(psQ);
+}
@@ -0,0 +1,151 @@
+/*!****************************************************************************
+ * @file
+ * i2cq.h
+ *
+ * @brief
+ * I2C master transaction queue
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef I2CQ_H_
+#define I2CQ_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Highest 7-bit device address
+#define I2CQ_ADDR_MAX                 0x7Fu
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Transaction status
+typedef enum {
+  I2CQ_STATUS_IDLE = 0,           ///< Never submitted
+  I2CQ_STATUS_PENDING,            ///< Queued or on the bus
+  I2CQ_STATUS_OK,                 ///< Completed
+  I2CQ_STATUS_NACK,               ///< Address or data not acknowledged
+  I2CQ_STATUS_BUS,                ///< Bus error or arbitration lost
+  I2CQ_STATUS_TIMEOUT             ///< No progress within the phase timeout
+} I2CQ_StatusTypeDef;
+
+/// Bus event, reported by the driver
+typedef enum {
+  I2CQ_EVENT_START = 0,           ///< Start condition sent
+  I2CQ_EVENT_ADDR,                ///< Address acknowledged
+  I2CQ_EVENT_DONE,                ///< Data phase complete
+  I2CQ_EVENT_NACK,                ///< Acknowledge failure
+  I2CQ_EVENT_BUS                  ///< Bus error, arbitration lost or overrun
+} I2CQ_EventTypeDef;
+
+/// Queue state
+typedef enum {
+  I2CQ_STATE_IDLE = 0,            ///< No transaction active
+  I2CQ_STATE_START_WRITE,         ///< Waiting for start of the write phase
+  I2CQ_STATE_ADDR_WRITE,          ///< Waiting for write address acknowledge
+  I2CQ_STATE_WRITE,               ///< Transmitting
+  I2CQ_STATE_START_READ,          ///< Waiting for (repeated) start of the read phase
+  I2CQ_STATE_ADDR_READ,           ///< Waiting for read address acknowledge
+  I2CQ_STATE_READ                 ///< Receiving
+} I2CQ_StateTypeDef;
+
+struct I2CQ_Xfer;
+struct I2CQ_Batch;
+
+/// Transaction completion callback, called from the event functions' context
+typedef void (*I2CQ_CallbackTypeDef)(struct I2CQ_Xfer* psXfer);
+
+/// Batch completion callback, called after the callback of its last transaction
+typedef void (*I2CQ_BatchCallbackTypeDef)(struct I2CQ_Batch* psBatch);
+
+/// Transaction: write phase, then read phase after a repeated start. Without
+/// both phases, only the address is sent (probe).
+typedef struct I2CQ_Xfer {
+  struct I2CQ_Xfer* psNext;       ///< Queue link
+  struct I2CQ_Batch* psBatch;     ///< Batch, NULL if submitted alone
+  I2CQ_CallbackTypeDef pfnDone;   ///< Completion callback, or NULL
+  void* pvContext;                ///< User context
+  const uint8_t* pucTx;           ///< Write data
+  uint8_t* pucRx;                 ///< Read buffer
+  uint16_t uiTxLen;               ///< Write length, 0 for no write phase
+  uint16_t uiRxLen;               ///< Read length, 0 for no read phase
+  uint8_t ucAddr;                 ///< 7-bit device address
+  uint8_t ucAttempts;             ///< Attempts made
+  volatile I2CQ_StatusTypeDef eStatus; ///< Status
+} I2CQ_XferTypeDef;
+
+/// Batch: transactions run back-to-back in array order
+typedef struct I2CQ_Batch {
+  I2CQ_XferTypeDef* psXfers;      ///< Transactions
+  uint32_t ulCount;               ///< Number of transactions
+  I2CQ_BatchCallbackTypeDef pfnDone; ///< Completion callback, or NULL
+  void* pvContext;                ///< User context
+  volatile uint32_t ulPending;    ///< Transactions not completed
+  uint32_t ulFailed;              ///< Transactions completed with error
+} I2CQ_BatchTypeDef;
+
+/// Hardware driver, called from the event functions' context
+typedef struct {
+  /// Generate (repeated) start condition
+  void (*pfnStart)(void);
+  /// Send address byte (address << 1 | read bit)
+  void (*pfnAddress)(uint8_t ucAddrRw);
+  /// Transmit data after the write address was acknowledged
+  void (*pfnWrite)(const uint8_t* pucData, uint16_t uiLen);
+  /// Receive data after the read address was acknowledged, last byte not
+  /// acknowledged
+  void (*pfnRead)(uint8_t* pucData, uint16_t uiLen);
+  /// Abort data transfer and generate stop condition
+  void (*pfnStop)(void);
+  /// Free the bus (clock out a stuck slave, stop condition) and reset the
+  /// controller
+  void (*pfnRecover)(void);
+} I2CQ_DriverTypeDef;
+
+/// Statistics
+typedef struct {
+  uint32_t ulDone;                ///< Transactions completed OK
+  uint32_t ulFailed;              ///< Transactions completed with error
+  uint32_t ulRetries;             ///< Attempts repeated
+  uint32_t ulRecoveries;          ///< Bus recoveries
+} I2CQ_StatsTypeDef;
+
+/// Queue instance
+typedef struct {
+  const I2CQ_DriverTypeDef* psDrv; ///< Hardware driver
+  I2CQ_XferTypeDef* psHead;       ///< Active transaction, followed by pending ones
+  I2CQ_XferTypeDef* psTail;       ///< Last pending transaction
+  I2CQ_StateTypeDef eState;       ///< State
+  uint8_t ucRetries;              ///< Repeated attempts after an error
+  uint16_t uiTimeoutBase;         ///< Phase timeout in ticks, without data
+  uint16_t uiBytesPerTick;        ///< Bytes transferred per tick at bus speed
+  uint32_t ulTicksLeft;           ///< Ticks until the current phase times out
+  I2CQ_StatsTypeDef sStats;       ///< Statistics
+} I2CQ_TypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vI2CQ_Init(I2CQ_TypeDef* psQ, const I2CQ_DriverTypeDef* psDrv, uint8_t ucRetries,
+                uint16_t uiTimeoutBase, uint16_t uiBytesPerTick);
+bool bI2CQ_Submit(I2CQ_TypeDef* psQ, I2CQ_XferTypeDef* psXfer);
+bool bI2CQ_SubmitBatch(I2CQ_TypeDef* psQ, I2CQ_BatchTypeDef* psBatch);
+void vI2CQ_Event(I2CQ_TypeDef* psQ, I2CQ_EventTypeDef eEvent);
+void vI2CQ_Tick(I2CQ_TypeDef* psQ);
+
+/*!****************************************************************************
+ * @brief
+ * Check if a transaction is active or pending
+ *
+ * @param[in] *psQ      Queue
+ * @return  (bool)  Queue busy
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline bool bI2CQ_IsBusy(const I2CQ_TypeDef* psQ)
+{
+  return psQ->psHead != NULL;
+}
+
+#endif // I2CQ_H_
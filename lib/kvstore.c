@@ -0,0 +1,776 @@
+/*!****************************************************************************
+ * @file
+ * kvstore.c
+ *
+ * @brief
+ * Log-structured key-value store for NOR flash
+ *
+ * Records are appended to the head page; updating a key appends a new record
+ * and deleting it appends a tombstone. A RAM hash index (open addressing with
+ * linear probing) maps each key to its latest record, so reads are O(1) and
+ * return a pointer into memory-mapped flash.
+ *
+ *   page   := magic, erase count, seq, ~seq, record...
+ *   record := key, flags | length, data (padded to half-words), crc16
+ *
+ * Pages are opened with increasing sequence numbers. When no free page is
+ * left except for one reserve page, the oldest page is reclaimed: its live
+ * records are copied into a fresh page and it is erased. As pages are reused
+ * in this circular order and new pages are taken by lowest erase count, wear
+ * is spread evenly across the region, including pages with static data.
+ *
+ * Each record is built in RAM and programmed in a single half-word burst,
+ * with the CRC programmed last. On mount, pages are replayed in sequence
+ * order. A record with bad CRC or length marks a write interrupted by power
+ * loss; the rest of that page is ignored and it is no longer appended to.
+ * Interrupted page erases and page openings are detected from the header
+ * and repaired. A reclaim interrupted before the victim is erased leaves no
+ * free page; the partial copy is then discarded and the reclaim redone.
+ *
+ * The store is not thread-safe; callers must serialise access.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "kvstore.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Page header magic
+#define KVS_PAGE_MAGIC                0x4B56u
+
+/// Page header magic of a page about to be erased
+#define KVS_PAGE_RETIRED              0x0000u
+
+/// Page header size in bytes
+#define KVS_HDR_SIZE                  12u
+
+/*! @brief Page header half-word indices
+ *  @{                                                                        */
+#define KVS_HDR_MAGIC                 0u
+#define KVS_HDR_ERASE                 1u
+#define KVS_HDR_SEQ                   2u
+#define KVS_HDR_NSEQ                  4u
+/*! @}                                                                        */
+
+/// Sequence number of free pages
+#define KVS_SEQ_FREE                  0xFFFFFFFFuL
+
+/// No head page
+#define KVS_NO_PAGE                   0xFFFFFFFFuL
+
+/// Record flag: tombstone
+#define KVS_FLAG_DELETED              0x8000u
+
+/// Record length mask
+#define KVS_LEN_MASK                  0x0FFFu
+
+/// Record overhead in bytes (key, length, crc)
+#define KVS_REC_OVERHEAD              6u
+
+/// Record size for value length
+#define KVS_REC_SIZE(len)             (KVS_REC_OVERHEAD + (((len) + 1u) & ~1u))
+
+/// Free pages kept for reclaiming
+#define KVS_GC_RESERVE                1u
+
+
+/*- Private data -------------------------------------------------------------*/
+/// CRC-16/CCITT nibble table
+static const uint16_t auiCrcTable[16] = {
+  0x0000u, 0x1021u, 0x2042u, 0x3063u, 0x4084u, 0x50A5u, 0x60C6u, 0x70E7u,
+  0x8108u, 0x9129u, 0xA14Au, 0xB16Bu, 0xC18Cu, 0xD1ADu, 0xE1CEu, 0xF1EFu
+};
+
+
+/*- Private functions --------------------------------------------------------*/
+static const uint16_t* puiKVS_Ptr(const KVS_TypeDef* psKvs, uint32_t ulOffset);
+static uint16_t uiKVS_Crc(const uint16_t* puiRec, uint32_t ulLen);
+static bool bKVS_IsBlank(const KVS_TypeDef* psKvs, uint32_t ulOffset, uint32_t ulSize);
+static bool bKVS_ErasePage(KVS_TypeDef* psKvs, uint32_t ulPage);
+static bool bKVS_OpenPage(KVS_TypeDef* psKvs);
+static bool bKVS_Collect(KVS_TypeDef* psKvs);
+static bool bKVS_Reserve(KVS_TypeDef* psKvs, uint32_t ulSize);
+static bool bKVS_Append(KVS_TypeDef* psKvs, uint16_t uiKey, uint16_t uiFlags,
+                        const void* pvData, uint32_t ulLen);
+static uint32_t ulKVS_Replay(KVS_TypeDef* psKvs, uint32_t ulPage);
+static uint32_t ulKVS_Hash(uint16_t uiKey);
+static int32_t lKVS_Lookup(const KVS_TypeDef* psKvs, uint16_t uiKey);
+static bool bKVS_IndexSet(KVS_TypeDef* psKvs, uint16_t uiKey, uint32_t ulOffset);
+static void vKVS_IndexRemove(KVS_TypeDef* psKvs, uint16_t uiKey);
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Mount store, rebuilding the index and repairing interrupted operations
+ *
+ * Blank or unrecognised pages are formatted, so mounting an empty region
+ * yields an empty store.
+ *
+ * @param[out] *psKvs     Store
+ * @param[in] *psFlash    Flash driver
+ * @return  (bool)  Store is usable
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bKVS_Mount(KVS_TypeDef* psKvs, const KVS_FlashTypeDef* psFlash)
+{
+  psKvs->psFlash = psFlash;
+  psKvs->bMounted = false;
+  psKvs->ulHead = KVS_NO_PAGE;
+  psKvs->ulWrite = 0uL;
+  psKvs->ulNextSeq = 0uL;
+  psKvs->ulKeys = 0uL;
+  psKvs->ulGcRuns = 0uL;
+  psKvs->ulRecovered = 0uL;
+  for (uint32_t i = 0uL; i < KVS_INDEX_SIZE; ++i)
+  {
+    psKvs->auiKeys[i] = KVS_KEY_NONE;
+  }
+
+  if ((psFlash->ulNumPages < 3u) || (psFlash->ulNumPages > KVS_MAX_PAGES) ||
+      (psFlash->ulPageSize < KVS_HDR_SIZE + KVS_REC_SIZE(KVS_MAX_VALUE)))
+  {
+    return false;
+  }
+
+  // Erase counts are lost if a page erase was interrupted; assume the highest
+  uint16_t uiMaxErase = 0u;
+  for (uint32_t p = 0uL; p < psFlash->ulNumPages; ++p)
+  {
+    const uint16_t* puiHdr = puiKVS_Ptr(psKvs, p * psFlash->ulPageSize);
+    bool bValid = (puiHdr[KVS_HDR_MAGIC] == KVS_PAGE_MAGIC) || (puiHdr[KVS_HDR_MAGIC] == KVS_PAGE_RETIRED);
+    psKvs->auiErase[p] = bValid ? puiHdr[KVS_HDR_ERASE] : 0xFFFFu;
+    if (bValid && (puiHdr[KVS_HDR_ERASE] > uiMaxErase)) uiMaxErase = puiHdr[KVS_HDR_ERASE];
+  }
+
+  // Classify pages
+  uint32_t aulOrder[KVS_MAX_PAGES];
+  uint32_t ulUsed = 0uL;
+  for (uint32_t p = 0uL; p < psFlash->ulNumPages; ++p)
+  {
+    uint32_t ulOffset = p * psFlash->ulPageSize;
+    const uint16_t* puiHdr = puiKVS_Ptr(psKvs, ulOffset);
+    uint32_t ulSeq = puiHdr[KVS_HDR_SEQ] | ((uint32_t)puiHdr[KVS_HDR_SEQ + 1u] << 16);
+    uint32_t ulNSeq = puiHdr[KVS_HDR_NSEQ] | ((uint32_t)puiHdr[KVS_HDR_NSEQ + 1u] << 16);
+    if (psKvs->auiErase[p] == 0xFFFFu) psKvs->auiErase[p] = uiMaxErase;
+    psKvs->aulSeq[p] = KVS_SEQ_FREE;
+
+    bool bErase = false;
+    bool bRepair = false;
+    if (puiHdr[KVS_HDR_MAGIC] != KVS_PAGE_MAGIC)
+    {
+      // Never formatted (blank), retired or interrupted erase / format
+      bErase = true;
+      bRepair = !bKVS_IsBlank(psKvs, ulOffset, psFlash->ulPageSize);
+    }
+    else if ((ulSeq == KVS_SEQ_FREE) && (ulNSeq == KVS_SEQ_FREE))
+    {
+      bErase = !bKVS_IsBlank(psKvs, ulOffset + 2u * KVS_HDR_SEQ,
+                             psFlash->ulPageSize - 2u * KVS_HDR_SEQ);
+      bRepair = bErase;
+    }
+    else if ((ulSeq ^ ulNSeq) == 0xFFFFFFFFuL)
+    {
+      psKvs->aulSeq[p] = ulSeq;
+      aulOrder[ulUsed++] = p;
+      if (ulSeq >= psKvs->ulNextSeq) psKvs->ulNextSeq = ulSeq + 1uL;
+    }
+    else
+    {
+      // Interrupted page opening, no records written yet
+      bErase = true;
+      bRepair = true;
+    }
+
+    if (bRepair) psKvs->ulRecovered++;
+    if (bErase && !bKVS_ErasePage(psKvs, p)) return false;
+  }
+
+  // Sort used pages by sequence number
+  for (uint32_t i = 1uL; i < ulUsed; ++i)
+  {
+    uint32_t ulPage = aulOrder[i];
+    uint32_t j = i;
+    while ((j > 0uL) && (psKvs->aulSeq[aulOrder[j - 1uL]] > psKvs->aulSeq[ulPage]))
+    {
+      aulOrder[j] = aulOrder[j - 1uL];
+      j--;
+    }
+    aulOrder[j] = ulPage;
+  }
+
+  // No free page: reclaim was interrupted before the victim was erased. The
+  // newest page only holds copies of records still present in the victim.
+  if (ulUsed == psFlash->ulNumPages)
+  {
+    psKvs->ulRecovered++;
+    if (!bKVS_ErasePage(psKvs, aulOrder[--ulUsed])) return false;
+  }
+
+  // Replay used pages in sequence order
+  for (uint32_t i = 0uL; i < ulUsed; ++i)
+  {
+    psKvs->ulHead = aulOrder[i];
+    psKvs->ulWrite = ulKVS_Replay(psKvs, aulOrder[i]);
+  }
+
+  psKvs->bMounted = true;
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Erase all pages and mount empty store
+ *
+ * Page erase counts are preserved.
+ *
+ * @param[out] *psKvs     Store
+ * @param[in] *psFlash    Flash driver
+ * @return  (bool)  Success
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bKVS_Format(KVS_TypeDef* psKvs, const KVS_FlashTypeDef* psFlash)
+{
+  psKvs->psFlash = psFlash;
+  psKvs->bMounted = false;
+  if ((psFlash->ulNumPages < 3u) || (psFlash->ulNumPages > KVS_MAX_PAGES)) return false;
+
+  for (uint32_t p = 0uL; p < psFlash->ulNumPages; ++p)
+  {
+    const uint16_t* puiHdr = puiKVS_Ptr(psKvs, p * psFlash->ulPageSize);
+    bool bValid = (puiHdr[KVS_HDR_MAGIC] == KVS_PAGE_MAGIC) || (puiHdr[KVS_HDR_MAGIC] == KVS_PAGE_RETIRED);
+    psKvs->auiErase[p] = bValid ? puiHdr[KVS_HDR_ERASE] : 0u;
+    if (!bKVS_ErasePage(psKvs, p)) return false;
+  }
+  return bKVS_Mount(psKvs, psFlash);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Find value in flash
+ *
+ * The returned pointer is valid until the next modifying call.
+ *
+ * @param[in] *psKvs    Store
+ * @param[in] uiKey     Key
+ * @param[out] *pulLen  Value length in bytes, may be NULL
+ * @return  (const void*)   Value, NULL if not found
+ * @date  19.10.2026
+ ******************************************************************************/
+const void* pvKVS_Find(const KVS_TypeDef* psKvs, uint16_t uiKey, uint32_t* pulLen)
+{
+  int32_t lSlot = lKVS_Lookup(psKvs, uiKey);
+  if (!psKvs->bMounted || (lSlot < 0L)) return NULL;
+
+  const uint16_t* puiRec = puiKVS_Ptr(psKvs, psKvs->aulOffsets[lSlot]);
+  if (pulLen != NULL) *pulLen = puiRec[1] & KVS_LEN_MASK;
+  return &puiRec[2];
+}
+
+/*!****************************************************************************
+ * @brief
+ * Read value
+ *
+ * @param[in] *psKvs    Store
+ * @param[in] uiKey     Key
+ * @param[out] *pvBuf   Buffer, receives up to ulSize bytes
+ * @param[in] ulSize    Buffer size
+ * @return  (int32_t)   Value length in bytes, -1 if not found
+ * @date  19.10.2026
+ ******************************************************************************/
+int32_t lKVS_Get(const KVS_TypeDef* psKvs, uint16_t uiKey, void* pvBuf, uint32_t ulSize)
+{
+  uint32_t ulLen;
+  const void* pvValue = pvKVS_Find(psKvs, uiKey, &ulLen);
+  if (pvValue == NULL) return -1L;
+
+  (void)memcpy(pvBuf, pvValue, (ulLen < ulSize) ? ulLen : ulSize);
+  return (int32_t)ulLen;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Store value
+ *
+ * Writing a value identical to the stored one does not touch flash.
+ *
+ * @param[in,out] *psKvs  Store
+ * @param[in] uiKey       Key (not KVS_KEY_NONE)
+ * @param[in] *pvData     Value
+ * @param[in] ulLen       Value length (0..KVS_MAX_VALUE)
+ * @return  (bool)  Success, false if store is full or flash failed
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bKVS_Put(KVS_TypeDef* psKvs, uint16_t uiKey, const void* pvData, uint32_t ulLen)
+{
+  if (!psKvs->bMounted || (uiKey == KVS_KEY_NONE) || (ulLen > KVS_MAX_VALUE)) return false;
+
+  uint32_t ulOldLen;
+  const void* pvOld = pvKVS_Find(psKvs, uiKey, &ulOldLen);
+  if (pvOld == NULL)
+  {
+    if (psKvs->ulKeys >= KVS_MAX_KEYS) return false;
+  }
+  else if ((ulOldLen == ulLen) && (memcmp(pvOld, pvData, ulLen) == 0))
+  {
+    return true;
+  }
+
+  return bKVS_Append(psKvs, uiKey, 0u, pvData, ulLen);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Delete key
+ *
+ * @param[in,out] *psKvs  Store
+ * @param[in] uiKey       Key
+ * @return  (bool)  Success (also if key did not exist)
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bKVS_Delete(KVS_TypeDef* psKvs, uint16_t uiKey)
+{
+  if (!psKvs->bMounted) return false;
+  if (lKVS_Lookup(psKvs, uiKey) < 0L) return true;
+
+  return bKVS_Append(psKvs, uiKey, KVS_FLAG_DELETED, NULL, 0uL);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get store statistics
+ *
+ * @param[in] *psKvs      Store
+ * @param[out] *psStats   Statistics
+ * @date  19.10.2026
+ ******************************************************************************/
+void vKVS_GetStats(const KVS_TypeDef* psKvs, KVS_StatsTypeDef* psStats)
+{
+  const KVS_FlashTypeDef* psFlash = psKvs->psFlash;
+
+  psStats->ulKeys = psKvs->ulKeys;
+  psStats->ulFreeBytes = (psKvs->ulHead != KVS_NO_PAGE) ? (psFlash->ulPageSize - psKvs->ulWrite) : 0uL;
+  psStats->ulGcRuns = psKvs->ulGcRuns;
+  psStats->ulRecovered = psKvs->ulRecovered;
+  psStats->uiMinErase = 0xFFFFu;
+  psStats->uiMaxErase = 0u;
+  for (uint32_t p = 0uL; p < psFlash->ulNumPages; ++p)
+  {
+    if (psKvs->aulSeq[p] == KVS_SEQ_FREE) psStats->ulFreeBytes += psFlash->ulPageSize - KVS_HDR_SIZE;
+    if (psKvs->auiErase[p] < psStats->uiMinErase) psStats->uiMinErase = psKvs->auiErase[p];
+    if (psKvs->auiErase[p] > psStats->uiMaxErase) psStats->uiMaxErase = psKvs->auiErase[p];
+  }
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Get pointer into flash region
+ *
+ * @param[in] *psKvs      Store
+ * @param[in] ulOffset    Byte offset from region start
+ * @return  (const uint16_t*)   Memory-mapped flash
+ * @date  19.10.2026
+ ******************************************************************************/
+static const uint16_t* puiKVS_Ptr(const KVS_TypeDef* psKvs, uint32_t ulOffset)
+{
+  return (const uint16_t*)(psKvs->psFlash->ulBase + ulOffset);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Compute record CRC over key, length and data
+ *
+ * The result never equals erased flash (0xFFFF).
+ *
+ * @param[in] *puiRec   Record
+ * @param[in] ulLen     Value length in bytes
+ * @return  (uint16_t)  CRC
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint16_t uiKVS_Crc(const uint16_t* puiRec, uint32_t ulLen)
+{
+  const uint8_t* pucData = (const uint8_t*)puiRec;
+  uint32_t ulCrc = 0xFFFFuL;
+  for (uint32_t i = 0uL; i < 4u + ulLen; ++i)
+  {
+    ulCrc ^= (uint32_t)pucData[i] << 8;
+    ulCrc = (ulCrc << 4) ^ auiCrcTable[(ulCrc >> 12) & 0xFu];
+    ulCrc = (ulCrc << 4) ^ auiCrcTable[(ulCrc >> 12) & 0xFu];
+  }
+  ulCrc &= 0xFFFFuL;
+  return (ulCrc == 0xFFFFuL) ? 0xFFFEu : (uint16_t)ulCrc;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if flash area is erased
+ *
+ * @param[in] *psKvs      Store
+ * @param[in] ulOffset    Byte offset from region start
+ * @param[in] ulSize      Size in bytes
+ * @return  (bool)  All bytes are 0xFF
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bKVS_IsBlank(const KVS_TypeDef* psKvs, uint32_t ulOffset, uint32_t ulSize)
+{
+  const uint16_t* puiData = puiKVS_Ptr(psKvs, ulOffset);
+  for (uint32_t i = 0uL; i < ulSize / 2u; ++i)
+  {
+    if (puiData[i] != 0xFFFFu) return false;
+  }
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Erase and format page as free
+ *
+ * The erase count is programmed before the magic, so a page with valid
+ * magic always has a valid erase count. Flash must allow programming 0x0000
+ * over non-erased half-words (used to retire the page).
+ *
+ * @param[in,out] *psKvs  Store
+ * @param[in] ulPage      Page index
+ * @return  (bool)  Success
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bKVS_ErasePage(KVS_TypeDef* psKvs, uint32_t ulPage)
+{
+  const KVS_FlashTypeDef* psFlash = psKvs->psFlash;
+  uintptr_t ulAddr = psFlash->ulBase + ulPage * psFlash->ulPageSize;
+
+  psKvs->aulSeq[ulPage] = KVS_SEQ_FREE;
+  if (psKvs->auiErase[ulPage] < 0xFFFEu) psKvs->auiErase[ulPage]++;
+
+  // Retire page first, so an interrupted erase cannot leave a valid header
+  uint16_t uiMagic = KVS_PAGE_RETIRED;
+  if ((*puiKVS_Ptr(psKvs, ulPage * psFlash->ulPageSize) == KVS_PAGE_MAGIC) &&
+      !psFlash->pfnProgram(ulAddr + 2u * KVS_HDR_MAGIC, &uiMagic, 1uL))
+  {
+    return false;
+  }
+
+  uiMagic = KVS_PAGE_MAGIC;
+  return psFlash->pfnErase(ulAddr) &&
+         psFlash->pfnProgram(ulAddr + 2u * KVS_HDR_ERASE, &psKvs->auiErase[ulPage], 1uL) &&
+         psFlash->pfnProgram(ulAddr + 2u * KVS_HDR_MAGIC, &uiMagic, 1uL);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Open free page with lowest erase count as new head
+ *
+ * @param[in,out] *psKvs  Store
+ * @return  (bool)  Success, false if no free page or flash failed
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bKVS_OpenPage(KVS_TypeDef* psKvs)
+{
+  const KVS_FlashTypeDef* psFlash = psKvs->psFlash;
+
+  uint32_t ulPage = KVS_NO_PAGE;
+  for (uint32_t p = 0uL; p < psFlash->ulNumPages; ++p)
+  {
+    if ((psKvs->aulSeq[p] == KVS_SEQ_FREE) &&
+        ((ulPage == KVS_NO_PAGE) || (psKvs->auiErase[p] < psKvs->auiErase[ulPage])))
+    {
+      ulPage = p;
+    }
+  }
+  if (ulPage == KVS_NO_PAGE) return false;
+
+  uint32_t ulSeq = psKvs->ulNextSeq++;
+  uint16_t auiSeq[4] = {
+    (uint16_t)ulSeq, (uint16_t)(ulSeq >> 16),
+    (uint16_t)~ulSeq, (uint16_t)(~ulSeq >> 16)
+  };
+  uintptr_t ulAddr = psFlash->ulBase + ulPage * psFlash->ulPageSize;
+
+  psKvs->aulSeq[ulPage] = ulSeq;
+  psKvs->ulHead = ulPage;
+  psKvs->ulWrite = psFlash->ulPageSize;
+  if (!psFlash->pfnProgram(ulAddr + 2u * KVS_HDR_SEQ, auiSeq, 4uL)) return false;
+
+  psKvs->ulWrite = KVS_HDR_SIZE;
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Reclaim oldest page
+ *
+ * Live records are copied into a newly opened page, then the page is
+ * erased.
+ *
+ * @param[in,out] *psKvs  Store
+ * @return  (bool)  Success
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bKVS_Collect(KVS_TypeDef* psKvs)
+{
+  const KVS_FlashTypeDef* psFlash = psKvs->psFlash;
+
+  uint32_t ulVictim = KVS_NO_PAGE;
+  for (uint32_t p = 0uL; p < psFlash->ulNumPages; ++p)
+  {
+    if ((psKvs->aulSeq[p] != KVS_SEQ_FREE) &&
+        ((ulVictim == KVS_NO_PAGE) || (psKvs->aulSeq[p] < psKvs->aulSeq[ulVictim])))
+    {
+      ulVictim = p;
+    }
+  }
+  if ((ulVictim == KVS_NO_PAGE) || !bKVS_OpenPage(psKvs)) return false;
+
+  uint32_t ulStart = ulVictim * psFlash->ulPageSize;
+  uint32_t ulEnd = ulStart + psFlash->ulPageSize;
+  uint32_t ulHeadBase = psKvs->ulHead * psFlash->ulPageSize;
+  for (uint32_t i = 0uL; i < KVS_INDEX_SIZE; ++i)
+  {
+    uint32_t ulOffset = psKvs->aulOffsets[i];
+    if ((psKvs->auiKeys[i] == KVS_KEY_NONE) || (ulOffset < ulStart) || (ulOffset >= ulEnd)) continue;
+
+    const uint16_t* puiRec = puiKVS_Ptr(psKvs, ulOffset);
+    uint32_t ulSize = KVS_REC_SIZE(puiRec[1] & KVS_LEN_MASK);
+    uint32_t ulDst = ulHeadBase + psKvs->ulWrite;
+    psKvs->ulWrite += ulSize;
+    if (!psFlash->pfnProgram(psFlash->ulBase + ulDst, puiRec, ulSize / 2u))
+    {
+      psKvs->ulWrite = psFlash->ulPageSize;
+      return false;
+    }
+    psKvs->aulOffsets[i] = ulDst;
+  }
+
+  psKvs->ulGcRuns++;
+  return bKVS_ErasePage(psKvs, ulVictim);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Make room for a record in the head page
+ *
+ * @param[in,out] *psKvs  Store
+ * @param[in] ulSize      Record size in bytes
+ * @return  (bool)  Success, false if store is full or flash failed
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bKVS_Reserve(KVS_TypeDef* psKvs, uint32_t ulSize)
+{
+  const KVS_FlashTypeDef* psFlash = psKvs->psFlash;
+
+  // Reject early if live data could not fit even after reclaiming everything
+  uint32_t ulLive = ulSize;
+  for (uint32_t i = 0uL; i < KVS_INDEX_SIZE; ++i)
+  {
+    if (psKvs->auiKeys[i] == KVS_KEY_NONE) continue;
+    ulLive += KVS_REC_SIZE(puiKVS_Ptr(psKvs, psKvs->aulOffsets[i])[1] & KVS_LEN_MASK);
+  }
+  if (ulLive > (psFlash->ulNumPages - KVS_GC_RESERVE - 1u) * (psFlash->ulPageSize - KVS_HDR_SIZE))
+  {
+    return false;
+  }
+
+  for (uint32_t ulTries = 0uL; ulTries <= psFlash->ulNumPages; ++ulTries)
+  {
+    if ((psKvs->ulHead != KVS_NO_PAGE) && (psKvs->ulWrite + ulSize <= psFlash->ulPageSize))
+    {
+      return true;
+    }
+
+    uint32_t ulFree = 0uL;
+    for (uint32_t p = 0uL; p < psFlash->ulNumPages; ++p)
+    {
+      if (psKvs->aulSeq[p] == KVS_SEQ_FREE) ulFree++;
+    }
+
+    bool bOk = (ulFree > KVS_GC_RESERVE) ? bKVS_OpenPage(psKvs) : bKVS_Collect(psKvs);
+    if (!bOk) return false;
+  }
+  return false;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Append record and update index
+ *
+ * @param[in,out] *psKvs  Store
+ * @param[in] uiKey       Key
+ * @param[in] uiFlags     Record flags KVS_FLAG_x
+ * @param[in] *pvData     Value
+ * @param[in] ulLen       Value length in bytes
+ * @return  (bool)  Success
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bKVS_Append(KVS_TypeDef* psKvs, uint16_t uiKey, uint16_t uiFlags,
+                        const void* pvData, uint32_t ulLen)
+{
+  const KVS_FlashTypeDef* psFlash = psKvs->psFlash;
+  uint32_t ulSize = KVS_REC_SIZE(ulLen);
+  if (!bKVS_Reserve(psKvs, ulSize)) return false;
+
+  // Build record in RAM, then program it in one burst (CRC last)
+  uint16_t auiRec[KVS_REC_SIZE(KVS_MAX_VALUE) / 2u];
+  uint32_t ulWords = ulSize / 2u;
+  auiRec[0] = uiKey;
+  auiRec[1] = (uint16_t)(uiFlags | ulLen);
+  if ((ulLen & 1uL) != 0uL) auiRec[ulWords - 2u] = 0xFFFFu;
+  if (ulLen != 0uL) (void)memcpy(&auiRec[2], pvData, ulLen);
+  auiRec[ulWords - 1u] = uiKVS_Crc(auiRec, ulLen);
+
+  uint32_t ulOffset = psKvs->ulHead * psFlash->ulPageSize + psKvs->ulWrite;
+  psKvs->ulWrite += ulSize;
+  if (!psFlash->pfnProgram(psFlash->ulBase + ulOffset, auiRec, ulWords))
+  {
+    psKvs->ulWrite = psFlash->ulPageSize;
+    return false;
+  }
+
+  if ((uiFlags & KVS_FLAG_DELETED) != 0u) vKVS_IndexRemove(psKvs, uiKey);
+  else (void)bKVS_IndexSet(psKvs, uiKey, ulOffset);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Apply records of a page to the index
+ *
+ * @param[in,out] *psKvs  Store
+ * @param[in] ulPage      Page index
+ * @return  (uint32_t)  Append offset, page size if page must not be appended to
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulKVS_Replay(KVS_TypeDef* psKvs, uint32_t ulPage)
+{
+  uint32_t ulPageSize = psKvs->psFlash->ulPageSize;
+  uint32_t ulBase = ulPage * ulPageSize;
+
+  uint32_t ulPos = KVS_HDR_SIZE;
+  while (ulPos + KVS_REC_OVERHEAD <= ulPageSize)
+  {
+    const uint16_t* puiRec = puiKVS_Ptr(psKvs, ulBase + ulPos);
+    if (puiRec[0] == KVS_KEY_NONE)
+    {
+      // End of log, unless a header was torn
+      if (bKVS_IsBlank(psKvs, ulBase + ulPos, ulPageSize - ulPos)) return ulPos;
+      psKvs->ulRecovered++;
+      return ulPageSize;
+    }
+
+    uint32_t ulLen = puiRec[1] & KVS_LEN_MASK;
+    uint32_t ulSize = KVS_REC_SIZE(ulLen);
+    if ((ulLen > KVS_MAX_VALUE) || ((puiRec[1] & ~(KVS_LEN_MASK | KVS_FLAG_DELETED)) != 0u) ||
+        (ulPos + ulSize > ulPageSize) || (puiRec[ulSize / 2u - 1u] != uiKVS_Crc(puiRec, ulLen)))
+    {
+      // Interrupted write: keep valid records, close page
+      psKvs->ulRecovered++;
+      return ulPageSize;
+    }
+
+    if ((puiRec[1] & KVS_FLAG_DELETED) != 0u) vKVS_IndexRemove(psKvs, puiRec[0]);
+    else (void)bKVS_IndexSet(psKvs, puiRec[0], ulBase + ulPos);
+    ulPos += ulSize;
+  }
+
+  return ulPageSize;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get home slot of key
+ *
+ * @param[in] uiKey     Key
+ * @return  (uint32_t)  Index slot
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulKVS_Hash(uint16_t uiKey)
+{
+  return (((uint32_t)uiKey * 40503uL) & 0xFFFFuL) >> (16u - KVS_INDEX_BITS);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Look up key in index
+ *
+ * @param[in] *psKvs    Store
+ * @param[in] uiKey     Key
+ * @return  (int32_t)   Index slot, -1 if not found
+ * @date  19.10.2026
+ ******************************************************************************/
+static int32_t lKVS_Lookup(const KVS_TypeDef* psKvs, uint16_t uiKey)
+{
+  for (uint32_t i = ulKVS_Hash(uiKey); psKvs->auiKeys[i] != KVS_KEY_NONE;
+       i = (i + 1u) & (KVS_INDEX_SIZE - 1u))
+  {
+    if (psKvs->auiKeys[i] == uiKey) return (int32_t)i;
+  }
+  return -1L;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Insert or update index entry
+ *
+ * @param[in,out] *psKvs  Store
+ * @param[in] uiKey       Key
+ * @param[in] ulOffset    Record offset
+ * @return  (bool)  Success, false if index is full
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bKVS_IndexSet(KVS_TypeDef* psKvs, uint16_t uiKey, uint32_t ulOffset)
+{
+  uint32_t i = ulKVS_Hash(uiKey);
+  while ((psKvs->auiKeys[i] != KVS_KEY_NONE) && (psKvs->auiKeys[i] != uiKey))
+  {
+    i = (i + 1u) & (KVS_INDEX_SIZE - 1u);
+  }
+
+  if (psKvs->auiKeys[i] == KVS_KEY_NONE)
+  {
+    if (psKvs->ulKeys >= KVS_MAX_KEYS) return false;
+    psKvs->auiKeys[i] = uiKey;
+    psKvs->ulKeys++;
+  }
+  psKvs->aulOffsets[i] = ulOffset;
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Remove index entry
+ *
+ * Uses backward-shift deletion, so lookups never need tombstones.
+ *
+ * @param[in,out] *psKvs  Store
+ * @param[in] uiKey       Key
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vKVS_IndexRemove(KVS_TypeDef* psKvs, uint16_t uiKey)
+{
+  int32_t lSlot = lKVS_Lookup(psKvs, uiKey);
+  if (lSlot < 0L) return;
+
+  uint32_t ulHole = (uint32_t)lSlot;
+  uint32_t j = ulHole;
+  while (1)
+  {
+    j = (j + 1u) & (KVS_INDEX_SIZE - 1u);
+    if (psKvs->auiKeys[j] == KVS_KEY_NONE) break;
+
+    // Move entry into hole unless its home slot lies cyclically in (hole, j]
+    uint32_t ulHome = ulKVS_Hash(psKvs->auiKeys[j]);
+    if (((j - ulHome) & (KVS_INDEX_SIZE - 1u)) >= ((j - ulHole) & (KVS_INDEX_SIZE - 1u)))
+    {
+      psKvs->auiKeys[ulHole] = psKvs->auiKeys[j];
+      psKvs->aulOffsets[ulHole] = psKvs->aulOffsets[j];
+      ulHole = j;
+    }
+  }
+  psKvs->auiKeys[ulHole] = KVS_KEY_NONE;
+  psKvs->ulKeys--;
+}
@@ -0,0 +1,91 @@
+/*!****************************************************************************
+ * @file
+ * kvstore.h
+ *
+ * @brief
+ * Log-structured key-value store for NOR flash
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef KVSTORE_H_
+#define KVSTORE_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Maximum number of flash pages
+#ifndef KVS_MAX_PAGES
+#define KVS_MAX_PAGES                 8u
+#endif
+
+/// Index slots, as power of two (at most 3/4 are used)
+#ifndef KVS_INDEX_BITS
+#define KVS_INDEX_BITS                6u
+#endif
+
+/// Index slots
+#define KVS_INDEX_SIZE                (1u << KVS_INDEX_BITS)
+
+/// Maximum number of keys
+#define KVS_MAX_KEYS                  (KVS_INDEX_SIZE - KVS_INDEX_SIZE / 4u)
+
+/// Maximum value length in bytes
+#ifndef KVS_MAX_VALUE
+#define KVS_MAX_VALUE                 256u
+#endif
+
+/// Reserved key (erased flash)
+#define KVS_KEY_NONE                  0xFFFFu
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Flash driver
+typedef struct {
+  uintptr_t ulBase;               ///< Address of first page, memory-mapped for reads
+  uint32_t ulPageSize;            ///< Page size in bytes
+  uint32_t ulNumPages;            ///< Number of pages (3..KVS_MAX_PAGES)
+  bool (*pfnErase)(uintptr_t ulAddr);   ///< Erase page
+  bool (*pfnProgram)(uintptr_t ulAddr, const uint16_t* puiData, uint32_t ulCount); ///< Program half-words
+} KVS_FlashTypeDef;
+
+/// Store statistics
+typedef struct {
+  uint32_t ulKeys;                ///< Number of keys
+  uint32_t ulFreeBytes;           ///< Free bytes in head and free pages
+  uint32_t ulGcRuns;              ///< Pages reclaimed since mount
+  uint32_t ulRecovered;           ///< Torn records / pages repaired on mount
+  uint16_t uiMinErase;            ///< Lowest page erase count
+  uint16_t uiMaxErase;            ///< Highest page erase count
+} KVS_StatsTypeDef;
+
+/// Store instance
+typedef struct {
+  const KVS_FlashTypeDef* psFlash;            ///< Flash driver
+  uint16_t auiKeys[KVS_INDEX_SIZE];           ///< Index keys, KVS_KEY_NONE if empty
+  uint32_t aulOffsets[KVS_INDEX_SIZE];        ///< Index record offsets
+  uint32_t aulSeq[KVS_MAX_PAGES];             ///< Page sequence numbers
+  uint16_t auiErase[KVS_MAX_PAGES];           ///< Page erase counts
+  uint32_t ulHead;                            ///< Page being appended to
+  uint32_t ulWrite;                           ///< Append offset in head page
+  uint32_t ulNextSeq;                         ///< Sequence number of next page
+  uint32_t ulKeys;                            ///< Number of keys
+  uint32_t ulGcRuns;                          ///< Pages reclaimed since mount
+  uint32_t ulRecovered;                       ///< Repairs done on mount
+  bool bMounted;                              ///< Store is usable
+} KVS_TypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+bool bKVS_Mount(KVS_TypeDef* psKvs, const KVS_FlashTypeDef* psFlash);
+bool bKVS_Format(KVS_TypeDef* psKvs, const KVS_FlashTypeDef* psFlash);
+const void* pvKVS_Find(const KVS_TypeDef* psKvs, uint16_t uiKey, uint32_t* pulLen);
+int32_t lKVS_Get(const KVS_TypeDef* psKvs, uint16_t uiKey, void* pvBuf, uint32_t ulSize);
+bool bKVS_Put(KVS_TypeDef* psKvs, uint16_t uiKey, const void* pvData, uint32_t ulLen);
+bool bKVS_Delete(KVS_TypeDef* psKvs, uint16_t uiKey);
+void vKVS_GetStats(const KVS_TypeDef* psKvs, KVS_StatsTypeDef* psStats);
+
+#endif // KVSTORE_H_
@@ -0,0 +1,373 @@
+/*!****************************************************************************
+ * @file
+ * norlog.c
+ *
+ * @brief
+ * Streaming log to serial NOR flash
+ *
+ * Log data is appended to a region of whole sectors, one 256-byte program
+ * page at a time, and wraps around when the region is full; the sector about
+ * to be written is erased first, discarding the oldest data.
+ *
+ *   page := seq, len, ~len, payload (len bytes, up to NORLOG_PAYLOAD)
+ *
+ * Two page buffers alternate: the caller fills one while the other is
+ * programmed, so with an asynchronous bus driver the CPU only spends time on
+ * copying and on issuing commands. A full page is handed over on the next
+ * write or poll; vNORLOG_Poll() advances the program/erase sequence and must
+ * be called regularly (and whenever ulNORLOG_Write() did not accept all
+ * data). vNORLOG_Flush() programs a partly filled page.
+ *
+ * On mount, the first page of every sector is read to find the sector
+ * written last (highest sequence number), then the first blank page in it.
+ * Pages are dumped in write order, starting with the oldest sector. A page
+ * torn by power loss keeps its header only if the device programmed it; its
+ * payload may then be incomplete.
+ *
+ * The log is not thread-safe; callers must serialise access.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "norlog.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Sequence number of blank pages
+#define NORLOG_SEQ_BLANK              0xFFFFFFFFuL
+
+/// Pages per sector
+#define NORLOG_SECTOR_PAGES           (SPINOR_SECTOR_SIZE / SPINOR_PAGE_SIZE)
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Decoded page header
+typedef struct {
+  uint32_t ulSeq;                 ///< Sequence number
+  uint32_t ulLen;                 ///< Payload length
+  bool bValid;                    ///< Header consistent
+  bool bBlank;                    ///< Page erased
+} NORLOG_HeaderTypeDef;
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vNORLOG_ReadHeader(const NORLOG_TypeDef* psLog, uint32_t ulOffset,
+                               NORLOG_HeaderTypeDef* psHdr);
+static void vNORLOG_Submit(NORLOG_TypeDef* psLog);
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Mount log, finding the write position
+ *
+ * @param[out] *psLog   Log
+ * @param[in] *psNor    Detected device
+ * @param[in] ulBase    Region start address (sector aligned)
+ * @param[in] ulSize    Region size (multiple of sector size, at least two)
+ * @return  (bool)  Log is usable
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bNORLOG_Mount(NORLOG_TypeDef* psLog, const SPINOR_TypeDef* psNor,
+                   uint32_t ulBase, uint32_t ulSize)
+{
+  (void)memset(psLog, 0, sizeof(*psLog));
+  psLog->psNor = psNor;
+  psLog->ulBase = ulBase;
+  psLog->ulSize = ulSize;
+
+  if (((ulBase % SPINOR_SECTOR_SIZE) != 0uL) || ((ulSize % SPINOR_SECTOR_SIZE) != 0uL) ||
+      (ulSize < 2uL * SPINOR_SECTOR_SIZE) || (ulBase + ulSize > psNor->ulSize) ||
+      (ulBase + ulSize < ulBase))
+  {
+    return false;
+  }
+
+  // Sector written last
+  bool bFound = false;
+  uint32_t ulHeadSector = 0uL;
+  uint32_t ulHeadSeq = 0uL;
+  for (uint32_t ulSector = 0uL; ulSector < ulSize; ulSector += SPINOR_SECTOR_SIZE)
+  {
+    NORLOG_HeaderTypeDef sHdr;
+    vNORLOG_ReadHeader(psLog, ulSector, &sHdr);
+    if (sHdr.bValid && (!bFound || ((int32_t)(sHdr.ulSeq - ulHeadSeq) > 0L)))
+    {
+      bFound = true;
+      ulHeadSector = ulSector;
+      ulHeadSeq = sHdr.ulSeq;
+    }
+  }
+
+  if (!bFound)
+  {
+    // Empty log: erase before first page
+    psLog->ulWrite = 0uL;
+    psLog->bErased = false;
+  }
+  else
+  {
+    // First blank page of that sector
+    uint32_t ulOffset = ulHeadSector;
+    psLog->ulSeq = ulHeadSeq + 1uL;
+    for (uint32_t i = 0uL; i < NORLOG_SECTOR_PAGES; ++i)
+    {
+      NORLOG_HeaderTypeDef sHdr;
+      vNORLOG_ReadHeader(psLog, ulOffset, &sHdr);
+      if (sHdr.bBlank) break;
+      if (sHdr.bValid) psLog->ulSeq = sHdr.ulSeq + 1uL;
+      ulOffset += SPINOR_PAGE_SIZE;
+    }
+    if (ulOffset == ulSize) ulOffset = 0uL;
+    psLog->ulWrite = ulOffset;
+    psLog->bErased = (ulOffset % SPINOR_SECTOR_SIZE) != 0uL;
+  }
+
+  psLog->bMounted = true;
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Append data
+ *
+ * Accepts data until both page buffers are in use.
+ *
+ * @param[in,out] *psLog  Log
+ * @param[in] *pvData     Data
+ * @param[in] ulLen       Number of bytes
+ * @return  (uint32_t)  Number of bytes accepted
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulNORLOG_Write(NORLOG_TypeDef* psLog, const void* pvData, uint32_t ulLen)
+{
+  if (!psLog->bMounted) return 0uL;
+
+  const uint8_t* pucData = (const uint8_t*)pvData;
+  uint32_t ulDone = 0uL;
+  while (ulDone < ulLen)
+  {
+    if (psLog->ulFillLen == NORLOG_PAYLOAD)
+    {
+      if (psLog->bPending)
+      {
+        psLog->sStats.ulStalls++;
+        break;
+      }
+      vNORLOG_Submit(psLog);
+    }
+
+    uint32_t ulChunk = NORLOG_PAYLOAD - psLog->ulFillLen;
+    if (ulChunk > ulLen - ulDone) ulChunk = ulLen - ulDone;
+    (void)memcpy(&psLog->aaucBuf[psLog->ulFill][NORLOG_HDR_SIZE + psLog->ulFillLen],
+                 &pucData[ulDone], ulChunk);
+    psLog->ulFillLen += ulChunk;
+    ulDone += ulChunk;
+  }
+  return ulDone;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Advance program and erase sequence
+ *
+ * Returns immediately while the device is busy.
+ *
+ * @param[in,out] *psLog  Log
+ * @date  19.10.2026
+ ******************************************************************************/
+void vNORLOG_Poll(NORLOG_TypeDef* psLog)
+{
+  if (!psLog->bPending || bSPINOR_IsBusy(psLog->psNor)) return;
+
+  if (psLog->bProgramming)
+  {
+    // Page done: release buffer, take the next one if already full
+    psLog->bProgramming = false;
+    psLog->bPending = false;
+    psLog->ulWrite += SPINOR_PAGE_SIZE;
+    if (psLog->ulWrite == psLog->ulSize) psLog->ulWrite = 0uL;
+    if ((psLog->ulWrite % SPINOR_SECTOR_SIZE) == 0uL) psLog->bErased = false;
+
+    if (psLog->ulFillLen < NORLOG_PAYLOAD) return;
+    vNORLOG_Submit(psLog);
+    return;
+  }
+
+  const uint8_t* pucPage = psLog->aaucBuf[psLog->ulFill ^ 1u];
+  if (!psLog->bErased)
+  {
+    vSPINOR_EraseSector(psLog->psNor, psLog->ulBase + psLog->ulWrite);
+    psLog->bErased = true;
+    psLog->sStats.ulErases++;
+    return;
+  }
+
+  uint32_t ulLen = (uint32_t)pucPage[4] | ((uint32_t)pucPage[5] << 8);
+  vSPINOR_Program(psLog->psNor, psLog->ulBase + psLog->ulWrite, pucPage, NORLOG_HDR_SIZE + ulLen);
+  psLog->bProgramming = true;
+  psLog->sStats.ulPages++;
+  psLog->sStats.ulBytes += ulLen;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if no page is waiting for or being programmed
+ *
+ * @param[in] *psLog  Log
+ * @return  (bool)  Idle
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bNORLOG_IsIdle(const NORLOG_TypeDef* psLog)
+{
+  return !psLog->bPending;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Program all buffered data, including a partly filled page
+ *
+ * Blocks until the device is idle.
+ *
+ * @param[in,out] *psLog  Log
+ * @date  19.10.2026
+ ******************************************************************************/
+void vNORLOG_Flush(NORLOG_TypeDef* psLog)
+{
+  if (!psLog->bMounted) return;
+
+  while (psLog->bPending)
+  {
+    vNORLOG_Poll(psLog);
+  }
+  if (psLog->ulFillLen != 0uL)
+  {
+    vNORLOG_Submit(psLog);
+  }
+  while (psLog->bPending)
+  {
+    vNORLOG_Poll(psLog);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Read back log in write order
+ *
+ * Flushes the log first. The sink may be called with pages of any length.
+ *
+ * @param[in,out] *psLog  Log
+ * @param[in] pfnSink     Output
+ * @param[in] *pvContext  Passed to pfnSink
+ * @return  (uint32_t)  Number of payload bytes dumped
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulNORLOG_Dump(NORLOG_TypeDef* psLog, NORLOG_SinkTypeDef pfnSink, void* pvContext)
+{
+  if (!psLog->bMounted) return 0uL;
+  vNORLOG_Flush(psLog);
+
+  // Oldest data is in the sector after the one being written, or in the
+  // next sector to be written if it is not erased yet
+  uint32_t ulOffset = psLog->ulWrite;
+  if (psLog->bErased)
+  {
+    ulOffset += SPINOR_SECTOR_SIZE - (ulOffset % SPINOR_SECTOR_SIZE);
+    if (ulOffset == psLog->ulSize) ulOffset = 0uL;
+  }
+
+  // Both buffers are free after flushing
+  uint8_t* pucPage = psLog->aaucBuf[psLog->ulFill ^ 1u];
+  uint32_t ulTotal = 0uL;
+  do
+  {
+    NORLOG_HeaderTypeDef sHdr;
+    vNORLOG_ReadHeader(psLog, ulOffset, &sHdr);
+    if (sHdr.bValid && (sHdr.ulLen != 0uL))
+    {
+      vSPINOR_Read(psLog->psNor, psLog->ulBase + ulOffset + NORLOG_HDR_SIZE, pucPage, sHdr.ulLen);
+      pfnSink(pucPage, sHdr.ulLen, pvContext);
+      ulTotal += sHdr.ulLen;
+    }
+
+    ulOffset += SPINOR_PAGE_SIZE;
+    if (ulOffset == psLog->ulSize) ulOffset = 0uL;
+  } while (ulOffset != psLog->ulWrite);
+
+  return ulTotal;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get statistics
+ *
+ * @param[in] *psLog      Log
+ * @param[out] *psStats   Statistics
+ * @date  19.10.2026
+ ******************************************************************************/
+void vNORLOG_GetStats(const NORLOG_TypeDef* psLog, NORLOG_StatsTypeDef* psStats)
+{
+  *psStats = psLog->sStats;
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Read and decode page header
+ *
+ * @param[in] *psLog    Log
+ * @param[in] ulOffset  Region offset of page
+ * @param[out] *psHdr   Header
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vNORLOG_ReadHeader(const NORLOG_TypeDef* psLog, uint32_t ulOffset,
+                               NORLOG_HeaderTypeDef* psHdr)
+{
+  uint8_t aucHdr[NORLOG_HDR_SIZE];
+  vSPINOR_Read(psLog->psNor, psLog->ulBase + ulOffset, aucHdr, sizeof(aucHdr));
+
+  uint32_t ulSeq = (uint32_t)aucHdr[0] | ((uint32_t)aucHdr[1] << 8) |
+                   ((uint32_t)aucHdr[2] << 16) | ((uint32_t)aucHdr[3] << 24);
+  uint32_t ulLen = (uint32_t)aucHdr[4] | ((uint32_t)aucHdr[5] << 8);
+  uint32_t ulNLen = (uint32_t)aucHdr[6] | ((uint32_t)aucHdr[7] << 8);
+
+  psHdr->ulSeq = ulSeq;
+  psHdr->ulLen = ulLen;
+  psHdr->bBlank = (ulSeq == NORLOG_SEQ_BLANK) && (ulLen == 0xFFFFuL) && (ulNLen == 0xFFFFuL);
+  psHdr->bValid = !psHdr->bBlank && ((ulLen ^ ulNLen) == 0xFFFFuL) && (ulLen <= NORLOG_PAYLOAD);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Hand fill buffer over for programming and start filling the other one
+ *
+ * The other buffer must be free.
+ *
+ * @param[in,out] *psLog  Log
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vNORLOG_Submit(NORLOG_TypeDef* psLog)
+{
+  uint8_t* pucPage = psLog->aaucBuf[psLog->ulFill];
+  uint32_t ulSeq = psLog->ulSeq++;
+  uint32_t ulLen = psLog->ulFillLen;
+  if (ulSeq == NORLOG_SEQ_BLANK) ulSeq = psLog->ulSeq++;
+
+  pucPage[0] = (uint8_t)ulSeq;
+  pucPage[1] = (uint8_t)(ulSeq >> 8);
+  pucPage[2] = (uint8_t)(ulSeq >> 16);
+  pucPage[3] = (uint8_t)(ulSeq >> 24);
+  pucPage[4] = (uint8_t)ulLen;
+  pucPage[5] = (uint8_t)(ulLen >> 8);
+  pucPage[6] = (uint8_t)~ulLen;
+  pucPage[7] = (uint8_t)(~ulLen >> 8);
+
+  psLog->ulFill ^= 1u;
+  psLog->ulFillLen = 0uL;
+  psLog->bPending = true;
+  vNORLOG_Poll(psLog);
+}
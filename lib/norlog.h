@@ -0,0 +1,68 @@
+/*!****************************************************************************
+ * @file
+ * norlog.h
+ *
+ * @brief
+ * Streaming log to serial NOR flash
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef NORLOG_H_
+#define NORLOG_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "spinor.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Page header size in bytes
+#define NORLOG_HDR_SIZE               8u
+
+/// Payload bytes per page
+#define NORLOG_PAYLOAD                (SPINOR_PAGE_SIZE - NORLOG_HDR_SIZE)
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Dump output, called with the payload of each page in write order
+typedef void (*NORLOG_SinkTypeDef)(const uint8_t* pucData, uint32_t ulLen, void* pvContext);
+
+/// Log statistics
+typedef struct {
+  uint32_t ulPages;               ///< Pages programmed since mount
+  uint32_t ulBytes;               ///< Payload bytes programmed since mount
+  uint32_t ulErases;              ///< Sectors erased since mount
+  uint32_t ulStalls;              ///< Writes not fully accepted (both buffers in use)
+} NORLOG_StatsTypeDef;
+
+/// Log instance
+typedef struct {
+  const SPINOR_TypeDef* psNor;                  ///< Device
+  uint32_t ulBase;                              ///< Region start address
+  uint32_t ulSize;                              ///< Region size in bytes
+  uint8_t aaucBuf[2][SPINOR_PAGE_SIZE];         ///< Page buffers
+  uint32_t ulFill;                              ///< Index of buffer being filled
+  uint32_t ulFillLen;                           ///< Payload bytes in fill buffer
+  bool bPending;                                ///< Other buffer waits for / is being programmed
+  bool bProgramming;                            ///< Program of other buffer started
+  bool bErased;                                 ///< Sector of next page is erased
+  uint32_t ulWrite;                             ///< Region offset of next page
+  uint32_t ulSeq;                               ///< Sequence number of next page
+  NORLOG_StatsTypeDef sStats;                   ///< Statistics
+  bool bMounted;                                ///< Log is usable
+} NORLOG_TypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+bool bNORLOG_Mount(NORLOG_TypeDef* psLog, const SPINOR_TypeDef* psNor,
+                   uint32_t ulBase, uint32_t ulSize);
+uint32_t ulNORLOG_Write(NORLOG_TypeDef* psLog, const void* pvData, uint32_t ulLen);
+void vNORLOG_Poll(NORLOG_TypeDef* psLog);
+bool bNORLOG_IsIdle(const NORLOG_TypeDef* psLog);
+void vNORLOG_Flush(NORLOG_TypeDef* psLog);
+uint32_t ulNORLOG_Dump(NORLOG_TypeDef* psLog, NORLOG_SinkTypeDef pfnSink, void* pvContext);
+void vNORLOG_GetStats(const NORLOG_TypeDef* psLog, NORLOG_StatsTypeDef* psStats);
+
+#endif // NORLOG_H_
@@ -0,0 +1,214 @@
+/*!****************************************************************************
+ * @file
+ * seq.c
+ *
+ * @brief
+ * Waveform sequencer: table passes and double-buffered streams
+ *
+ * Decides what a DMA channel plays next; the driver moves the samples to the
+ * output registers on each timer update.
+ *
+ * Table player: a pass plays all samples of a table once, as one DMA block.
+ * At the end of a pass, the table is played again until its pass count is
+ * reached, then the table linked after it follows; a queued table replaces
+ * either at the next pass boundary, so the output never mixes two tables
+ * within a pass.
+ *
+ * Stream: the DMA plays a ring of two halves in circular mode. Whenever one
+ * half has been played, the refill function writes the next samples into it
+ * while the other half plays. When the refill returns fewer samples than
+ * requested, the rest of the ring is filled with the last sample, and the
+ * stream reports that it may stop once only those held samples play.
+ *
+ * The functions are not reentrant; the driver serialises them against its
+ * interrupt handler.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "seq.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Half buffer events from the half containing the end until only held samples play
+#define SEQ_ENDING_EVENTS             2uL
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vSEQ_Fill(SEQ_StreamTypeDef* psStream, uint32_t ulHalf);
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise table player with the table of the first pass
+ *
+ * @param[out] *psPlayer    Player
+ * @param[in] *psTable      First table
+ * @param[in,out] *psStats  Counters
+ * @date  19.10.2026
+ ******************************************************************************/
+void vSEQ_Init(SEQ_PlayerTypeDef* psPlayer, const SEQ_TableTypeDef* psTable,
+               SEQ_StatsTypeDef* psStats)
+{
+  psPlayer->psTable = psTable;
+  psPlayer->psQueued = NULL;
+  psPlayer->ulPass = 1uL;
+  psStats->ulPasses++;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Queue table to replace the playing one at the next pass boundary
+ *
+ * A table queued before the boundary was reached is replaced.
+ *
+ * @param[in,out] *psPlayer Player
+ * @param[in] *psTable      Table
+ * @date  19.10.2026
+ ******************************************************************************/
+void vSEQ_Queue(SEQ_PlayerTypeDef* psPlayer, const SEQ_TableTypeDef* psTable)
+{
+  psPlayer->psQueued = psTable;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Select table of the next pass, at the end of a pass
+ *
+ * @param[in,out] *psPlayer Player
+ * @param[in,out] *psStats  Counters
+ * @return  (const SEQ_TableTypeDef*)  Table to play, NULL at the end of the
+ *                                     sequence
+ * @date  19.10.2026
+ ******************************************************************************/
+const SEQ_TableTypeDef* psSEQ_NextPass(SEQ_PlayerTypeDef* psPlayer, SEQ_StatsTypeDef* psStats)
+{
+  const SEQ_TableTypeDef* psTable = psPlayer->psTable;
+
+  if (psPlayer->psQueued != NULL)
+  {
+    psTable = psPlayer->psQueued;
+    psPlayer->psQueued = NULL;
+    psPlayer->ulPass = 0uL;
+    psStats->ulSwaps++;
+  }
+  else if ((psTable->ulPasses != 0uL) && (psPlayer->ulPass >= psTable->ulPasses))
+  {
+    psTable = psTable->psNext;
+    psPlayer->ulPass = 0uL;
+    if (psTable == NULL) return NULL;
+  }
+
+  psPlayer->psTable = psTable;
+  psPlayer->ulPass++;
+  psStats->ulPasses++;
+  return psTable;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Initialise stream and fill both halves
+ *
+ * @param[out] *psStream    Stream
+ * @param[out] *pvRing      Ring of 2 * ulHalfSamples samples
+ * @param[in] ulHalfSamples Samples per half
+ * @param[in] ulSampleSize  Bytes per sample
+ * @param[in] pfnRefill     Refill
+ * @param[in] *pvContext    Refill context
+ * @return  (bool)  Stream has samples to play
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bSEQ_StreamInit(SEQ_StreamTypeDef* psStream, void* pvRing, uint32_t ulHalfSamples,
+                     uint32_t ulSampleSize, SEQ_RefillTypeDef pfnRefill, void* pvContext)
+{
+  psStream->pucRing = (uint8_t*)pvRing;
+  psStream->ulHalfSamples = ulHalfSamples;
+  psStream->ulSampleSize = ulSampleSize;
+  psStream->pfnRefill = pfnRefill;
+  psStream->pvContext = pvContext;
+  psStream->pucLast = NULL;
+  psStream->ulEnding = 0uL;
+
+  vSEQ_Fill(psStream, 0uL);
+  if (psStream->pucLast == NULL) return false;
+
+  // Filling the second half with held samples is the event after the end
+  if (psStream->ulEnding != 0uL) psStream->ulEnding--;
+  vSEQ_Fill(psStream, 1uL);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Refill the half just played
+ *
+ * @param[in,out] *psStream Stream
+ * @param[in] ulHalf        Half played (0, 1)
+ * @param[in,out] *psStats  Counters
+ * @return  (bool)  Keep playing; false once only held samples play
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bSEQ_StreamRefill(SEQ_StreamTypeDef* psStream, uint32_t ulHalf, SEQ_StatsTypeDef* psStats)
+{
+  if (psStream->ulEnding != 0uL)
+  {
+    psStream->ulEnding--;
+    if (psStream->ulEnding == 0uL) return false;
+  }
+  else
+  {
+    psStats->ulRefills++;
+  }
+
+  vSEQ_Fill(psStream, ulHalf);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * GPIO set/reset word driving a group of pins
+ *
+ * @param[in] uiPins    Pins driven by the word
+ * @param[in] uiLevels  Output levels (pins outside uiPins ignored)
+ * @return  (uint32_t)  GPIOx_BSRR value
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulSEQ_Bsrr(uint16_t uiPins, uint16_t uiLevels)
+{
+  return ((uint32_t)(uint16_t)(uiPins & ~uiLevels) << 16) | (uint32_t)(uiPins & uiLevels);
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Fill one half from the refill, padded with the last sample after the end
+ *
+ * @param[in,out] *psStream Stream
+ * @param[in] ulHalf        Half (0, 1)
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSEQ_Fill(SEQ_StreamTypeDef* psStream, uint32_t ulHalf)
+{
+  uint32_t ulSize = psStream->ulSampleSize;
+  uint8_t* pucHalf = psStream->pucRing + ulHalf * psStream->ulHalfSamples * ulSize;
+  uint32_t ulWritten = 0uL;
+
+  if (psStream->ulEnding == 0uL)
+  {
+    ulWritten = psStream->pfnRefill(pucHalf, psStream->ulHalfSamples, psStream->pvContext);
+    if (ulWritten > psStream->ulHalfSamples) ulWritten = psStream->ulHalfSamples;
+    if (ulWritten != 0uL) psStream->pucLast = &pucHalf[(ulWritten - 1uL) * ulSize];
+    if (ulWritten < psStream->ulHalfSamples) psStream->ulEnding = SEQ_ENDING_EVENTS;
+  }
+  if (psStream->pucLast == NULL) return;
+
+  for (uint32_t i = ulWritten; i < psStream->ulHalfSamples; ++i)
+  {
+    (void)memmove(&pucHalf[i * ulSize], psStream->pucLast, ulSize);
+  }
+}
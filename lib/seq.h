@@ -0,0 +1,74 @@
+/*!****************************************************************************
+ * @file
+ * seq.h
+ *
+ * @brief
+ * Waveform sequencer: table passes and double-buffered streams
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef SEQ_H_
+#define SEQ_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Table: samples played back to back in each pass, in RAM or flash
+typedef struct SEQ_Table {
+  const void* pvData;             ///< Samples
+  uint32_t ulSamples;             ///< Samples per pass (at least 1)
+  uint32_t ulPasses;              ///< Passes, 0: endless
+  const struct SEQ_Table* psNext; ///< Table after the last pass, or NULL to stop
+} SEQ_TableTypeDef;
+
+/// Counters
+typedef struct {
+  uint32_t ulPasses;              ///< Table passes started
+  uint32_t ulSwaps;               ///< Queued tables taken over
+  uint32_t ulRefills;             ///< Stream halves refilled
+  uint32_t ulUnderruns;           ///< Stream halves refilled after playback reached them
+} SEQ_StatsTypeDef;
+
+/// Table player
+typedef struct {
+  const SEQ_TableTypeDef* psTable;  ///< Table playing
+  const SEQ_TableTypeDef* psQueued; ///< Table replacing it after the pass, or NULL
+  uint32_t ulPass;                  ///< Passes of the table started
+} SEQ_PlayerTypeDef;
+
+/*! @brief Stream refill
+ *
+ * Writes up to ulSamples samples to pvDst and returns the number written;
+ * fewer than requested end the stream. Called from the driver's interrupt
+ * context, except for the initial fill.                                  */
+typedef uint32_t (*SEQ_RefillTypeDef)(void* pvDst, uint32_t ulSamples, void* pvContext);
+
+/// Double-buffered stream
+typedef struct {
+  uint8_t* pucRing;               ///< Two halves of ulHalfSamples samples
+  uint32_t ulHalfSamples;         ///< Samples per half
+  uint32_t ulSampleSize;          ///< Bytes per sample
+  SEQ_RefillTypeDef pfnRefill;    ///< Refill
+  void* pvContext;                ///< Refill context
+  const uint8_t* pucLast;         ///< Last sample after the end of the stream
+  uint32_t ulEnding;              ///< Half buffer events until only held samples play, 0: running
+} SEQ_StreamTypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vSEQ_Init(SEQ_PlayerTypeDef* psPlayer, const SEQ_TableTypeDef* psTable,
+               SEQ_StatsTypeDef* psStats);
+void vSEQ_Queue(SEQ_PlayerTypeDef* psPlayer, const SEQ_TableTypeDef* psTable);
+const SEQ_TableTypeDef* psSEQ_NextPass(SEQ_PlayerTypeDef* psPlayer, SEQ_StatsTypeDef* psStats);
+
+bool bSEQ_StreamInit(SEQ_StreamTypeDef* psStream, void* pvRing, uint32_t ulHalfSamples,
+                     uint32_t ulSampleSize, SEQ_RefillTypeDef pfnRefill, void* pvContext);
+bool bSEQ_StreamRefill(SEQ_StreamTypeDef* psStream, uint32_t ulHalf, SEQ_StatsTypeDef* psStats);
+
+uint32_t ulSEQ_Bsrr(uint16_t uiPins, uint16_t uiLevels);
+
+#endif // SEQ_H_
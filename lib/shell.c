@@ -0,0 +1,339 @@
+/*!****************************************************************************
+ * @file
+ * shell.c
+ *
+ * @brief
+ * Line-oriented command shell with a static command table
+ *
+ * Input is fed one character at a time by bSHELL_Input(), which only edits
+ * the line buffer and never blocks, so it can run from a background loop.
+ * Once a line is complete (CR, LF or CR LF), vSHELL_Execute() splits it into
+ * blank-separated arguments in place and runs the matching command. A
+ * command may be abbreviated to any prefix that selects a single table entry;
+ * an exact name always wins. No heap is used.
+ *
+ * Line editing: backspace/DEL removes the last character, Ctrl-C discards
+ * the line, control characters other than tab are ignored. Input is not
+ * echoed (the debug probe's console sends whole lines); the executed line is
+ * printed after the prompt instead.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "shell.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/*! @brief Control characters
+ *  @{                                                                        */
+#define SHELL_CHAR_ETX                '\x03'    ///< Ctrl-C
+#define SHELL_CHAR_BS                 '\b'      ///< Backspace
+#define SHELL_CHAR_DEL                '\x7F'    ///< Delete (backspace key)
+/*! @}                                                                        */
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vSHELL_Reset(SHELL_TypeDef* psShell);
+static uint32_t ulSHELL_Split(char* pcLine, char* apcArgv[]);
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise shell
+ *
+ * @param[out] *psShell   Shell instance
+ * @param[in] *psCmds     Command table
+ * @param[in] ulNumCmds   Number of entries in command table
+ * @param[in] pfnWrite    Output function
+ * @date  19.10.2026
+ ******************************************************************************/
+void vSHELL_Init(SHELL_TypeDef* psShell, const SHELL_CmdTypeDef* psCmds,
+                 uint32_t ulNumCmds, SHELL_WriteTypeDef pfnWrite)
+{
+  psShell->psCmds = psCmds;
+  psShell->ulNumCmds = ulNumCmds;
+  psShell->pfnWrite = pfnWrite;
+  psShell->cLast = '\0';
+  vSHELL_Reset(psShell);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Process one input character
+ *
+ * Input is dropped while a complete line waits for vSHELL_Execute().
+ *
+ * @param[in,out] *psShell  Shell instance
+ * @param[in] cCh           Received character
+ * @return  (bool)  Line complete, call vSHELL_Execute()
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bSHELL_Input(SHELL_TypeDef* psShell, char cCh)
+{
+  if (psShell->bReady) return true;
+
+  char cLast = psShell->cLast;
+  psShell->cLast = cCh;
+  switch (cCh)
+  {
+    case '\n':
+      // Second half of CR LF
+      if (cLast == '\r') return false;
+      psShell->bReady = true;
+      return true;
+
+    case '\r':
+      psShell->bReady = true;
+      return true;
+
+    case SHELL_CHAR_BS:
+    case SHELL_CHAR_DEL:
+      if ((psShell->ulLen > 0uL) && !psShell->bOverflow) psShell->ulLen--;
+      return false;
+
+    case SHELL_CHAR_ETX:
+      vSHELL_Reset(psShell);
+      return false;
+
+    default:
+      if ((((uint8_t)cCh < 0x20u) && (cCh != '\t')) || ((uint8_t)cCh > 0x7Eu)) return false;
+      if (psShell->ulLen < SHELL_LINE_MAX)
+      {
+        psShell->acLine[psShell->ulLen++] = cCh;
+      }
+      else
+      {
+        psShell->bOverflow = true;
+      }
+      return false;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Execute complete line
+ *
+ * Does nothing if no line is complete.
+ *
+ * @param[in,out] *psShell  Shell instance
+ * @date  19.10.2026
+ ******************************************************************************/
+void vSHELL_Execute(SHELL_TypeDef* psShell)
+{
+  if (!psShell->bReady) return;
+
+  psShell->acLine[psShell->ulLen] = '\0';
+  vSHELL_Puts(psShell, SHELL_PROMPT);
+  vSHELL_Puts(psShell, psShell->acLine);
+  vSHELL_Puts(psShell, "\r\n");
+
+  char* apcArgv[SHELL_ARGS_MAX + 1u];
+  uint32_t ulArgc = ulSHELL_Split(psShell->acLine, apcArgv);
+  if (psShell->bOverflow)
+  {
+    vSHELL_Printf(psShell, "line too long (max. %u characters)\r\n", (unsigned int)SHELL_LINE_MAX);
+  }
+  else if (ulArgc > SHELL_ARGS_MAX)
+  {
+    vSHELL_Printf(psShell, "too many arguments (max. %u)\r\n", (unsigned int)(SHELL_ARGS_MAX - 1u));
+  }
+  else if (ulArgc > 0uL)
+  {
+    uint32_t ulMatches;
+    const SHELL_CmdTypeDef* psCmd = psSHELL_Find(psShell, apcArgv[0], &ulMatches);
+    if (psCmd != NULL)
+    {
+      apcArgv[ulArgc] = NULL;
+      if (!psCmd->pfnRun(psShell, ulArgc, apcArgv))
+      {
+        vSHELL_Printf(psShell, "usage: %s %s\r\n", psCmd->pcName,
+                      (psCmd->pcArgs != NULL) ? psCmd->pcArgs : "");
+      }
+    }
+    else if (ulMatches == 0uL)
+    {
+      vSHELL_Printf(psShell, "unknown command '%s', try 'help'\r\n", apcArgv[0]);
+    }
+    else
+    {
+      vSHELL_Printf(psShell, "ambiguous command '%s':", apcArgv[0]);
+      size_t ulPrefix = strlen(apcArgv[0]);
+      for (uint32_t i = 0uL; i < psShell->ulNumCmds; ++i)
+      {
+        if (strncmp(psShell->psCmds[i].pcName, apcArgv[0], ulPrefix) == 0)
+        {
+          vSHELL_Printf(psShell, " %s", psShell->psCmds[i].pcName);
+        }
+      }
+      vSHELL_Puts(psShell, "\r\n");
+    }
+  }
+
+  vSHELL_Reset(psShell);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Look up command by name or unique prefix
+ *
+ * @param[in] *psShell      Shell instance
+ * @param[in] *pcName       Command name or prefix
+ * @param[out] *pulMatches  Number of matching entries (1 for an exact match)
+ * @return  (const SHELL_CmdTypeDef*)  Command, NULL if none or ambiguous
+ * @date  19.10.2026
+ ******************************************************************************/
+const SHELL_CmdTypeDef* psSHELL_Find(const SHELL_TypeDef* psShell, const char* pcName,
+                                     uint32_t* pulMatches)
+{
+  const SHELL_CmdTypeDef* psFound = NULL;
+  uint32_t ulMatches = 0uL;
+  size_t ulPrefix = strlen(pcName);
+
+  for (uint32_t i = 0uL; i < psShell->ulNumCmds; ++i)
+  {
+    const SHELL_CmdTypeDef* psCmd = &psShell->psCmds[i];
+    if (strncmp(psCmd->pcName, pcName, ulPrefix) != 0) continue;
+    if (psCmd->pcName[ulPrefix] == '\0')
+    {
+      *pulMatches = 1uL;
+      return psCmd;
+    }
+    psFound = psCmd;
+    ulMatches++;
+  }
+
+  *pulMatches = ulMatches;
+  return (ulMatches == 1uL) ? psFound : NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write string
+ *
+ * @param[in] *psShell  Shell instance
+ * @param[in] *pcStr    String
+ * @date  19.10.2026
+ ******************************************************************************/
+void vSHELL_Puts(SHELL_TypeDef* psShell, const char* pcStr)
+{
+  psShell->pfnWrite(pcStr, (uint32_t)strlen(pcStr));
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write formatted string (truncated to SHELL_OUT_MAX characters)
+ *
+ * @param[in] *psShell  Shell instance
+ * @param[in] *pcFmt    printf() format string
+ * @date  19.10.2026
+ ******************************************************************************/
+void vSHELL_Printf(SHELL_TypeDef* psShell, const char* pcFmt, ...)
+{
+  char acBuf[SHELL_OUT_MAX + 1u];
+  va_list args;
+  va_start(args, pcFmt);
+  (void)vsnprintf(acBuf, sizeof(acBuf), pcFmt, args);
+  va_end(args);
+  vSHELL_Puts(psShell, acBuf);
+}
+
+/*!****************************************************************************
+ * @brief
+ * List commands with synopsis and description
+ *
+ * @param[in] *psShell  Shell instance
+ * @date  19.10.2026
+ ******************************************************************************/
+void vSHELL_PrintHelp(SHELL_TypeDef* psShell)
+{
+  for (uint32_t i = 0uL; i < psShell->ulNumCmds; ++i)
+  {
+    const SHELL_CmdTypeDef* psCmd = &psShell->psCmds[i];
+    vSHELL_Printf(psShell, "  %-8s %-16s %s\r\n", psCmd->pcName,
+                  (psCmd->pcArgs != NULL) ? psCmd->pcArgs : "", psCmd->pcHelp);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Parse unsigned number, decimal or hexadecimal with "0x" prefix
+ *
+ * @param[in] *pcStr      Argument
+ * @param[out] *pulValue  Value (unchanged on error)
+ * @return  (bool)  Valid number within 32 bits
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bSHELL_ParseU32(const char* pcStr, uint32_t* pulValue)
+{
+  uint32_t ulBase = 10uL;
+  if ((pcStr[0] == '0') && ((pcStr[1] == 'x') || (pcStr[1] == 'X')))
+  {
+    ulBase = 16uL;
+    pcStr += 2;
+  }
+  if (*pcStr == '\0') return false;
+
+  uint32_t ulValue = 0uL;
+  for (; *pcStr != '\0'; ++pcStr)
+  {
+    char cCh = *pcStr;
+    uint32_t ulDigit;
+    if ((cCh >= '0') && (cCh <= '9')) ulDigit = (uint32_t)(cCh - '0');
+    else if ((cCh >= 'a') && (cCh <= 'f')) ulDigit = (uint32_t)(cCh - 'a') + 10uL;
+    else if ((cCh >= 'A') && (cCh <= 'F')) ulDigit = (uint32_t)(cCh - 'A') + 10uL;
+    else return false;
+    if (ulDigit >= ulBase) return false;
+    if (ulValue > (UINT32_MAX - ulDigit) / ulBase) return false;
+    ulValue = ulValue * ulBase + ulDigit;
+  }
+
+  *pulValue = ulValue;
+  return true;
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Discard line
+ *
+ * @param[in,out] *psShell  Shell instance
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSHELL_Reset(SHELL_TypeDef* psShell)
+{
+  psShell->ulLen = 0uL;
+  psShell->bOverflow = false;
+  psShell->bReady = false;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Split line into blank-separated arguments in place
+ *
+ * Counts arguments beyond SHELL_ARGS_MAX without storing them.
+ *
+ * @param[in,out] *pcLine   Line, terminated
+ * @param[out] *apcArgv[]   Arguments (SHELL_ARGS_MAX entries)
+ * @return  (uint32_t)  Number of arguments
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulSHELL_Split(char* pcLine, char* apcArgv[])
+{
+  uint32_t ulArgc = 0uL;
+  while (*pcLine != '\0')
+  {
+    while ((*pcLine == ' ') || (*pcLine == '\t')) *pcLine++ = '\0';
+    if (*pcLine == '\0') break;
+
+    if (ulArgc < SHELL_ARGS_MAX) apcArgv[ulArgc] = pcLine;
+    ulArgc++;
+    while ((*pcLine != '\0') && (*pcLine != ' ') && (*pcLine != '\t')) pcLine++;
+  }
+  return ulArgc;
+}
@@ -0,0 +1,86 @@
+/*!****************************************************************************
+ * @file
+ * shell.h
+ *
+ * @brief
+ * Line-oriented command shell with a static command table
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef SHELL_H_
+#define SHELL_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Longest command line in characters
+#ifndef SHELL_LINE_MAX
+#define SHELL_LINE_MAX                64u
+#endif
+
+/// Most arguments per command, including the command name
+#ifndef SHELL_ARGS_MAX
+#define SHELL_ARGS_MAX                6u
+#endif
+
+/// Longest output of vSHELL_Printf() in characters
+#ifndef SHELL_OUT_MAX
+#define SHELL_OUT_MAX                 80u
+#endif
+
+/// Prompt printed before the executed line
+#ifndef SHELL_PROMPT
+#define SHELL_PROMPT                  "> "
+#endif
+
+
+/*- Type definitions ---------------------------------------------------------*/
+typedef struct SHELL_TypeDef SHELL_TypeDef;
+
+/// Command handler, returns false on wrong usage (usage is printed)
+typedef bool (*SHELL_HandlerTypeDef)(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[]);
+
+/// Output function
+typedef void (*SHELL_WriteTypeDef)(const char* pcBuf, uint32_t ulLen);
+
+/// Command table entry
+typedef struct {
+  const char* pcName;             ///< Command name
+  const char* pcArgs;             ///< Argument synopsis, or NULL
+  const char* pcHelp;             ///< One-line description
+  SHELL_HandlerTypeDef pfnRun;    ///< Handler
+} SHELL_CmdTypeDef;
+
+/// Shell instance
+struct SHELL_TypeDef {
+  const SHELL_CmdTypeDef* psCmds; ///< Command table
+  uint32_t ulNumCmds;             ///< Number of entries in command table
+  SHELL_WriteTypeDef pfnWrite;    ///< Output function
+  char acLine[SHELL_LINE_MAX + 1u]; ///< Line being entered
+  uint32_t ulLen;                 ///< Characters in line
+  bool bOverflow;                 ///< Line exceeded SHELL_LINE_MAX
+  bool bReady;                    ///< Line complete, waiting for execution
+  char cLast;                     ///< Previous input character
+};
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vSHELL_Init(SHELL_TypeDef* psShell, const SHELL_CmdTypeDef* psCmds,
+                 uint32_t ulNumCmds, SHELL_WriteTypeDef pfnWrite);
+bool bSHELL_Input(SHELL_TypeDef* psShell, char cCh);
+void vSHELL_Execute(SHELL_TypeDef* psShell);
+const SHELL_CmdTypeDef* psSHELL_Find(const SHELL_TypeDef* psShell, const char* pcName,
+                                     uint32_t* pulMatches);
+
+// Helpers for handlers
+void vSHELL_Puts(SHELL_TypeDef* psShell, const char* pcStr);
+void vSHELL_Printf(SHELL_TypeDef* psShell, const char* pcFmt, ...)
+  __attribute__((format(printf, 2, 3)));
+void vSHELL_PrintHelp(SHELL_TypeDef* psShell);
+bool bSHELL_ParseU32(const char* pcStr, uint32_t* pulValue);
+
+#endif // SHELL_H_
@@ -0,0 +1,242 @@
+/*!****************************************************************************
+ * @file
+ * spinor.c
+ *
+ * @brief
+ * Serial NOR flash command layer (25-series SPI flash)
+ *
+ * Implements the command subset common to 25-series serial NOR flash with
+ * 3-byte addresses (Winbond W25Q, Macronix MX25L, GigaDevice GD25Q, ...):
+ * JEDEC ID, read, page program, 4 KB sector erase and status polling.
+ *
+ * Program and erase only start the operation; the device is busy until
+ * bSPINOR_IsBusy() returns false. With an asynchronous bus driver, page
+ * program data is sent in the background and the caller may prepare the
+ * next page meanwhile. All other commands wait for the device first.
+ *
+ * The bus driver is the only hardware dependency, so the layer also runs on
+ * a host against a simulated device (tools/nor_sim).
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stddef.h>
+#include "spinor.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Command header size (command, 3 address bytes)
+#define SPINOR_HDR_SIZE               4u
+
+/// Smallest capacity code accepted as a device (64 KB)
+#define SPINOR_MIN_CAPACITY_CODE      0x10u
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vSPINOR_Command(const SPINOR_TypeDef* psNor, uint8_t ucCmd);
+static void vSPINOR_Header(uint8_t* pucHdr, uint8_t ucCmd, uint32_t ulAddr);
+static uint8_t ucSPINOR_ReadStatus(const SPINOR_TypeDef* psNor);
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Detect device
+ *
+ * Wakes the device from power-down and reads its JEDEC ID. The capacity is
+ * taken from the capacity code (2^n bytes).
+ *
+ * @param[out] *psNor   Device
+ * @param[in] *psBus    Bus driver
+ * @return  (bool)  Device found
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bSPINOR_Init(SPINOR_TypeDef* psNor, const SPINOR_BusTypeDef* psBus)
+{
+  psNor->psBus = psBus;
+  psNor->ulJedecId = 0uL;
+  psNor->ulSize = 0uL;
+
+  vSPINOR_Command(psNor, SPINOR_CMD_RDP);
+
+  uint8_t aucId[4] = { SPINOR_CMD_RDID };
+  psBus->pfnSelect(true);
+  psBus->pfnTransfer(aucId, aucId, sizeof(aucId));
+  psBus->pfnSelect(false);
+  psNor->ulJedecId = ((uint32_t)aucId[1] << 16) | ((uint32_t)aucId[2] << 8) | aucId[3];
+
+  // Floating or shorted MISO reads all ones or zeros
+  uint8_t ucCapacity = aucId[3];
+  if ((aucId[1] == 0x00u) || (aucId[1] == 0xFFu) ||
+      (ucCapacity < SPINOR_MIN_CAPACITY_CODE) || ((1uL << (ucCapacity & 0x1Fu)) > SPINOR_MAX_SIZE))
+  {
+    return false;
+  }
+
+  psNor->ulSize = 1uL << ucCapacity;
+  vSPINOR_Wait(psNor);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if a transfer, program or erase is in progress
+ *
+ * @param[in] *psNor  Device
+ * @return  (bool)  Device busy
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bSPINOR_IsBusy(const SPINOR_TypeDef* psNor)
+{
+  const SPINOR_BusTypeDef* psBus = psNor->psBus;
+  if ((psBus->pfnIsBusy != NULL) && psBus->pfnIsBusy()) return true;
+  return (ucSPINOR_ReadStatus(psNor) & SPINOR_SR_WIP) != 0u;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Wait until device is idle
+ *
+ * @param[in] *psNor  Device
+ * @date  19.10.2026
+ ******************************************************************************/
+void vSPINOR_Wait(const SPINOR_TypeDef* psNor)
+{
+  while (bSPINOR_IsBusy(psNor))
+  {
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Read data
+ *
+ * @param[in] *psNor    Device
+ * @param[in] ulAddr    Start address
+ * @param[out] *pvBuf   Buffer
+ * @param[in] ulLen     Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+void vSPINOR_Read(const SPINOR_TypeDef* psNor, uint32_t ulAddr, void* pvBuf, uint32_t ulLen)
+{
+  const SPINOR_BusTypeDef* psBus = psNor->psBus;
+  uint8_t aucHdr[SPINOR_HDR_SIZE];
+  vSPINOR_Header(aucHdr, SPINOR_CMD_READ, ulAddr);
+
+  vSPINOR_Wait(psNor);
+  psBus->pfnSelect(true);
+  psBus->pfnTransfer(aucHdr, NULL, sizeof(aucHdr));
+  psBus->pfnTransfer(NULL, (uint8_t*)pvBuf, ulLen);
+  psBus->pfnSelect(false);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start sector erase
+ *
+ * @param[in] *psNor    Device
+ * @param[in] ulAddr    Address within the sector
+ * @date  19.10.2026
+ ******************************************************************************/
+void vSPINOR_EraseSector(const SPINOR_TypeDef* psNor, uint32_t ulAddr)
+{
+  const SPINOR_BusTypeDef* psBus = psNor->psBus;
+  uint8_t aucHdr[SPINOR_HDR_SIZE];
+  vSPINOR_Header(aucHdr, SPINOR_CMD_SE, ulAddr);
+
+  vSPINOR_Wait(psNor);
+  vSPINOR_Command(psNor, SPINOR_CMD_WREN);
+  psBus->pfnSelect(true);
+  psBus->pfnTransfer(aucHdr, NULL, sizeof(aucHdr));
+  psBus->pfnSelect(false);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start page program
+ *
+ * Data beyond the end of the page wraps to its start, as on the device. With
+ * an asynchronous bus driver, pvData must stay valid until the device is no
+ * longer busy.
+ *
+ * @param[in] *psNor    Device
+ * @param[in] ulAddr    Start address
+ * @param[in] *pvData   Data
+ * @param[in] ulLen     Number of bytes (1..SPINOR_PAGE_SIZE)
+ * @date  19.10.2026
+ ******************************************************************************/
+void vSPINOR_Program(const SPINOR_TypeDef* psNor, uint32_t ulAddr, const void* pvData,
+                     uint32_t ulLen)
+{
+  const SPINOR_BusTypeDef* psBus = psNor->psBus;
+  uint8_t aucHdr[SPINOR_HDR_SIZE];
+  vSPINOR_Header(aucHdr, SPINOR_CMD_PP, ulAddr);
+
+  vSPINOR_Wait(psNor);
+  vSPINOR_Command(psNor, SPINOR_CMD_WREN);
+  psBus->pfnSelect(true);
+  psBus->pfnTransfer(aucHdr, NULL, sizeof(aucHdr));
+  if (psBus->pfnWriteAsync != NULL)
+  {
+    psBus->pfnWriteAsync((const uint8_t*)pvData, ulLen);
+  }
+  else
+  {
+    psBus->pfnTransfer((const uint8_t*)pvData, NULL, ulLen);
+    psBus->pfnSelect(false);
+  }
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Send single-byte command
+ *
+ * @param[in] *psNor  Device
+ * @param[in] ucCmd   Command
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSPINOR_Command(const SPINOR_TypeDef* psNor, uint8_t ucCmd)
+{
+  const SPINOR_BusTypeDef* psBus = psNor->psBus;
+  psBus->pfnSelect(true);
+  psBus->pfnTransfer(&ucCmd, NULL, 1uL);
+  psBus->pfnSelect(false);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Build command header with address
+ *
+ * @param[out] *pucHdr  Header (SPINOR_HDR_SIZE bytes)
+ * @param[in] ucCmd     Command
+ * @param[in] ulAddr    Address
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSPINOR_Header(uint8_t* pucHdr, uint8_t ucCmd, uint32_t ulAddr)
+{
+  pucHdr[0] = ucCmd;
+  pucHdr[1] = (uint8_t)(ulAddr >> 16);
+  pucHdr[2] = (uint8_t)(ulAddr >> 8);
+  pucHdr[3] = (uint8_t)ulAddr;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Read status register 1
+ *
+ * @param[in] *psNor  Device
+ * @return  (uint8_t)   Status register
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint8_t ucSPINOR_ReadStatus(const SPINOR_TypeDef* psNor)
+{
+  const SPINOR_BusTypeDef* psBus = psNor->psBus;
+  uint8_t aucSr[2] = { SPINOR_CMD_RDSR };
+  psBus->pfnSelect(true);
+  psBus->pfnTransfer(aucSr, aucSr, sizeof(aucSr));
+  psBus->pfnSelect(false);
+  return aucSr[1];
+}
@@ -0,0 +1,78 @@
+/*!****************************************************************************
+ * @file
+ * spinor.h
+ *
+ * @brief
+ * Serial NOR flash command layer (25-series SPI flash)
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef SPINOR_H_
+#define SPINOR_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Program page size in bytes
+#define SPINOR_PAGE_SIZE              256u
+
+/// Smallest erase unit (sector) in bytes
+#define SPINOR_SECTOR_SIZE            4096u
+
+/*! @brief Commands
+ *  @{                                                                        */
+#define SPINOR_CMD_WREN               0x06u   ///< Write enable
+#define SPINOR_CMD_RDSR               0x05u   ///< Read status register 1
+#define SPINOR_CMD_READ               0x03u   ///< Read data
+#define SPINOR_CMD_PP                 0x02u   ///< Page program
+#define SPINOR_CMD_SE                 0x20u   ///< Sector erase (4 KB)
+#define SPINOR_CMD_RDID               0x9Fu   ///< Read JEDEC ID
+#define SPINOR_CMD_RDP                0xABu   ///< Release from power-down
+/*! @}                                                                        */
+
+/*! @brief Status register 1 bits
+ *  @{                                                                        */
+#define SPINOR_SR_WIP                 0x01u   ///< Write in progress
+#define SPINOR_SR_WEL                 0x02u   ///< Write enable latch
+/*! @}                                                                        */
+
+/// Largest supported capacity (3-byte addressing)
+#define SPINOR_MAX_SIZE               0x01000000uL
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Bus driver
+typedef struct {
+  /// Assert (true) or release chip select
+  void (*pfnSelect)(bool bSelect);
+  /// Blocking full-duplex transfer; NULL pucTx sends 0xFF, NULL pucRx discards
+  void (*pfnTransfer)(const uint8_t* pucTx, uint8_t* pucRx, uint32_t ulLen);
+  /// Start transmit-only transfer that releases chip select when done, or
+  /// NULL to transfer blocking. The data must stay valid until done.
+  void (*pfnWriteAsync)(const uint8_t* pucTx, uint32_t ulLen);
+  /// Asynchronous transfer in progress, or NULL
+  bool (*pfnIsBusy)(void);
+} SPINOR_BusTypeDef;
+
+/// Device
+typedef struct {
+  const SPINOR_BusTypeDef* psBus; ///< Bus driver
+  uint32_t ulJedecId;             ///< Manufacturer, memory type, capacity code
+  uint32_t ulSize;                ///< Capacity in bytes, 0 if not detected
+} SPINOR_TypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+bool bSPINOR_Init(SPINOR_TypeDef* psNor, const SPINOR_BusTypeDef* psBus);
+bool bSPINOR_IsBusy(const SPINOR_TypeDef* psNor);
+void vSPINOR_Wait(const SPINOR_TypeDef* psNor);
+void vSPINOR_Read(const SPINOR_TypeDef* psNor, uint32_t ulAddr, void* pvBuf, uint32_t ulLen);
+void vSPINOR_EraseSector(const SPINOR_TypeDef* psNor, uint32_t ulAddr);
+void vSPINOR_Program(const SPINOR_TypeDef* psNor, uint32_t ulAddr, const void* pvData,
+                     uint32_t ulLen);
+
+#endif // SPINOR_H_
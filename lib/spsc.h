@@ -0,0 +1,220 @@
+/*!****************************************************************************
+ * @file
+ * spsc.h
+ *
+ * @brief
+ * Lock-free single-producer/single-consumer queues
+ *
+ * SPSC_DEFINE() instantiates a ring of a given item type and power-of-two
+ * size together with its access functions. One context (e.g. an interrupt
+ * handler) may push while another one (e.g. a thread) pops, without disabling
+ * interrupts: each index is written by one side only, so loads and stores
+ * with acquire/release ordering suffice and no LDREX/STREX is needed.
+ *
+ * Indices run freely and are masked on access, so all SIZE slots are usable
+ * and the fill level is head - tail. Besides copying push/pop (single and
+ * bulk), the largest contiguous region can be accessed in place and
+ * committed afterwards (zero-copy spans), e.g. to let a driver or DMA fill
+ * or drain it directly.
+ *
+ *   SPSC_DEFINE(Rx, uint8_t, 64u)
+ *   static SPSC_Rx_TypeDef sRx;
+ *   ...
+ *   (void)bSPSC_Rx_Push(&sRx, &ucByte);          // producer
+ *   while (bSPSC_Rx_Pop(&sRx, &ucByte)) { ... }  // consumer
+ *
+ * Generated functions (prefix SPSC_<Name>_):
+ *  - vInit, ulGetCount, ulGetFree, ulGetHighWater
+ *  - producer: bPush, ulPushBulk, ulGetWriteSpan, vCommitWrite,
+ *              vResetHighWater
+ *  - consumer: bPop, ulPopBulk, ulGetReadSpan, vCommitRead
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef SPSC_H_
+#define SPSC_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Producer and consumer run on the same core (compiler ordering suffices)
+#ifndef SPSC_SINGLE_CORE
+#if defined(__arm__)
+#define SPSC_SINGLE_CORE              1
+#else
+#define SPSC_SINGLE_CORE              0
+#endif
+#endif
+
+/*! @brief Index access with ordering against item access
+ *  @{                                                                        */
+#if SPSC_SINGLE_CORE
+#define SPSC_LOAD_ACQUIRE(pulIdx)                                              \
+  __extension__ ({ uint32_t ulIdx__ = *(volatile const uint32_t*)(pulIdx);     \
+                   __atomic_signal_fence(__ATOMIC_ACQUIRE); ulIdx__; })
+#define SPSC_STORE_RELEASE(pulIdx, ulVal)                                      \
+  do { __atomic_signal_fence(__ATOMIC_RELEASE);                                \
+       *(volatile uint32_t*)(pulIdx) = (ulVal); } while (0)
+#else
+#define SPSC_LOAD_ACQUIRE(pulIdx)       __atomic_load_n((pulIdx), __ATOMIC_ACQUIRE)
+#define SPSC_STORE_RELEASE(pulIdx, ulVal) __atomic_store_n((pulIdx), (ulVal), __ATOMIC_RELEASE)
+#endif
+/*! @}                                                                        */
+
+/*!****************************************************************************
+ * @brief
+ * Define queue type SPSC_<Name>_TypeDef and its functions
+ *
+ * @param[in] Name    Instance name (identifier)
+ * @param[in] Type    Item type
+ * @param[in] Size    Capacity in items (power of two, min. 2)
+ ******************************************************************************/
+#define SPSC_DEFINE(Name, Type, Size)                                          \
+                                                                               \
+_Static_assert((((Size) & ((Size) - 1u)) == 0u) && ((Size) >= 2u),             \
+               "SPSC size must be a power of two");                            \
+                                                                               \
+typedef struct {                                                               \
+  uint32_t ulHead;                /* Items pushed (producer) */                \
+  uint32_t ulTail;                /* Items popped (consumer) */                \
+  uint32_t ulHighWater;           /* Maximum fill level (producer) */          \
+  Type axItems[Size];             /* Item storage */                           \
+} SPSC_##Name##_TypeDef;                                                       \
+                                                                               \
+/* Initialise queue (no concurrent access) */                                  \
+static inline void vSPSC_##Name##_Init(SPSC_##Name##_TypeDef* psQ)             \
+{                                                                              \
+  psQ->ulHead = 0uL;                                                           \
+  psQ->ulTail = 0uL;                                                           \
+  psQ->ulHighWater = 0uL;                                                      \
+}                                                                              \
+                                                                               \
+/* Number of queued items (exact for consumer, lower bound for producer) */    \
+static inline uint32_t ulSPSC_##Name##_GetCount(const SPSC_##Name##_TypeDef* psQ) \
+{                                                                              \
+  return SPSC_LOAD_ACQUIRE(&psQ->ulHead) - SPSC_LOAD_ACQUIRE(&psQ->ulTail);    \
+}                                                                              \
+                                                                               \
+/* Number of free slots (exact for producer, lower bound for consumer) */      \
+static inline uint32_t ulSPSC_##Name##_GetFree(const SPSC_##Name##_TypeDef* psQ) \
+{                                                                              \
+  return (Size) - ulSPSC_##Name##_GetCount(psQ);                               \
+}                                                                              \
+                                                                               \
+/* Maximum fill level seen by producer since init or reset */                  \
+static inline uint32_t ulSPSC_##Name##_GetHighWater(const SPSC_##Name##_TypeDef* psQ) \
+{                                                                              \
+  return *(volatile const uint32_t*)&psQ->ulHighWater;                         \
+}                                                                              \
+                                                                               \
+/* Producer: restart high-water statistics at current fill level */            \
+static inline void vSPSC_##Name##_ResetHighWater(SPSC_##Name##_TypeDef* psQ)   \
+{                                                                              \
+  psQ->ulHighWater = psQ->ulHead - SPSC_LOAD_ACQUIRE(&psQ->ulTail);            \
+}                                                                              \
+                                                                               \
+/* Producer: get contiguous free region, return its size in items */           \
+static inline uint32_t ulSPSC_##Name##_GetWriteSpan(SPSC_##Name##_TypeDef* psQ, \
+                                                     Type** ppxSpan)           \
+{                                                                              \
+  uint32_t ulHead = psQ->ulHead;                                               \
+  uint32_t ulFree = (Size) - (ulHead - SPSC_LOAD_ACQUIRE(&psQ->ulTail));       \
+  uint32_t ulIdx = ulHead & ((Size) - 1u);                                     \
+  uint32_t ulToEnd = (Size) - ulIdx;                                           \
+  *ppxSpan = &psQ->axItems[ulIdx];                                             \
+  return (ulFree < ulToEnd) ? ulFree : ulToEnd;                                \
+}                                                                              \
+                                                                               \
+/* Producer: publish items written to the span */                              \
+static inline void vSPSC_##Name##_CommitWrite(SPSC_##Name##_TypeDef* psQ,      \
+                                              uint32_t ulNum)                  \
+{                                                                              \
+  uint32_t ulHead = psQ->ulHead + ulNum;                                       \
+  SPSC_STORE_RELEASE(&psQ->ulHead, ulHead);                                    \
+  uint32_t ulLevel = ulHead - SPSC_LOAD_ACQUIRE(&psQ->ulTail);                 \
+  if (ulLevel > psQ->ulHighWater) psQ->ulHighWater = ulLevel;                  \
+}                                                                              \
+                                                                               \
+/* Producer: push item, false if full */                                       \
+static inline bool bSPSC_##Name##_Push(SPSC_##Name##_TypeDef* psQ,             \
+                                       const Type* pxItem)                     \
+{                                                                              \
+  Type* pxSpan;                                                                \
+  if (ulSPSC_##Name##_GetWriteSpan(psQ, &pxSpan) == 0uL) return false;         \
+  *pxSpan = *pxItem;                                                           \
+  vSPSC_##Name##_CommitWrite(psQ, 1uL);                                        \
+  return true;                                                                 \
+}                                                                              \
+                                                                               \
+/* Producer: push up to ulNum items, return number pushed */                   \
+static inline uint32_t ulSPSC_##Name##_PushBulk(SPSC_##Name##_TypeDef* psQ,    \
+                                                const Type* pxItems,           \
+                                                uint32_t ulNum)                \
+{                                                                              \
+  uint32_t ulDone = 0uL;                                                       \
+  while (ulDone < ulNum)                                                       \
+  {                                                                            \
+    Type* pxSpan;                                                              \
+    uint32_t ulLen = ulSPSC_##Name##_GetWriteSpan(psQ, &pxSpan);               \
+    if (ulLen == 0uL) break;                                                   \
+    if (ulLen > ulNum - ulDone) ulLen = ulNum - ulDone;                        \
+    (void)memcpy(pxSpan, &pxItems[ulDone], ulLen * sizeof(Type));              \
+    vSPSC_##Name##_CommitWrite(psQ, ulLen);                                    \
+    ulDone += ulLen;                                                           \
+  }                                                                            \
+  return ulDone;                                                               \
+}                                                                              \
+                                                                               \
+/* Consumer: get contiguous queued region, return its size in items */         \
+static inline uint32_t ulSPSC_##Name##_GetReadSpan(SPSC_##Name##_TypeDef* psQ, \
+                                                    const Type** ppxSpan)      \
+{                                                                              \
+  uint32_t ulTail = psQ->ulTail;                                               \
+  uint32_t ulCount = SPSC_LOAD_ACQUIRE(&psQ->ulHead) - ulTail;                 \
+  uint32_t ulIdx = ulTail & ((Size) - 1u);                                     \
+  uint32_t ulToEnd = (Size) - ulIdx;                                           \
+  *ppxSpan = &psQ->axItems[ulIdx];                                             \
+  return (ulCount < ulToEnd) ? ulCount : ulToEnd;                              \
+}                                                                              \
+                                                                               \
+/* Consumer: release items read from the span */                               \
+static inline void vSPSC_##Name##_CommitRead(SPSC_##Name##_TypeDef* psQ,       \
+                                             uint32_t ulNum)                   \
+{                                                                              \
+  SPSC_STORE_RELEASE(&psQ->ulTail, psQ->ulTail + ulNum);                       \
+}                                                                              \
+                                                                               \
+/* Consumer: pop item, false if empty */                                       \
+static inline bool bSPSC_##Name##_Pop(SPSC_##Name##_TypeDef* psQ, Type* pxItem) \
+{                                                                              \
+  const Type* pxSpan;                                                          \
+  if (ulSPSC_##Name##_GetReadSpan(psQ, &pxSpan) == 0uL) return false;          \
+  *pxItem = *pxSpan;                                                           \
+  vSPSC_##Name##_CommitRead(psQ, 1uL);                                         \
+  return true;                                                                 \
+}                                                                              \
+                                                                               \
+/* Consumer: pop up to ulNum items, return number popped */                    \
+static inline uint32_t ulSPSC_##Name##_PopBulk(SPSC_##Name##_TypeDef* psQ,     \
+                                               Type* pxItems, uint32_t ulNum)  \
+{                                                                              \
+  uint32_t ulDone = 0uL;                                                       \
+  while (ulDone < ulNum)                                                       \
+  {                                                                            \
+    const Type* pxSpan;                                                        \
+    uint32_t ulLen = ulSPSC_##Name##_GetReadSpan(psQ, &pxSpan);                \
+    if (ulLen == 0uL) break;                                                   \
+    if (ulLen > ulNum - ulDone) ulLen = ulNum - ulDone;                        \
+    (void)memcpy(&pxItems[ulDone], pxSpan, ulLen * sizeof(Type));              \
+    vSPSC_##Name##_CommitRead(psQ, ulLen);                                     \
+    ulDone += ulLen;                                                           \
+  }                                                                            \
+  return ulDone;                                                               \
+}
+
+#endif // SPSC_H_
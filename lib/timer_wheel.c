@@ -0,0 +1,258 @@
+/*!****************************************************************************
+ * @file
+ * timer_wheel.c
+ *
+ * @brief
+ * Hierarchical timer wheel
+ *
+ * Timers are kept in TWHEEL_LEVELS levels of TWHEEL_SLOTS slots each. Level n
+ * covers expiries up to 2^(5*(n+1)) ticks ahead with a resolution of
+ * 2^(5*n) ticks. Every timer in the level 0 slot for the current tick is due,
+ * so expiry processing costs O(expired). Whenever a level wraps around, the
+ * next slot of the level above is redistributed ("cascaded") into the lower
+ * levels, which amortises to O(1) per timer.
+ *
+ * Slot lists are doubly linked through a pointer to the previous link, so
+ * insertion and removal are O(1). Timers further ahead than the wheel range
+ * are parked in the farthest top-level slot and re-cascaded until they fit.
+ *
+ * The wheel itself is not thread-safe; callers must serialise access.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stddef.h>
+#include "timer_wheel.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Slot index mask
+#define TWHEEL_SLOT_MASK              (TWHEEL_SLOTS - 1u)
+
+/// Wheel range in ticks
+#define TWHEEL_RANGE                  (1uLL << (TWHEEL_SLOT_BITS * TWHEEL_LEVELS))
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vTWHEEL_Link(TWHEEL_TimerTypeDef** ppsHead, TWHEEL_TimerTypeDef* psTimer);
+static void vTWHEEL_Unlink(TWHEEL_TimerTypeDef* psTimer);
+static void vTWHEEL_Place(TWHEEL_TypeDef* psWheel, TWHEEL_TimerTypeDef* psTimer);
+static void vTWHEEL_Cascade(TWHEEL_TypeDef* psWheel, uint32_t ulLevel);
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise timer wheel
+ *
+ * @param[out] *psWheel   Timer wheel
+ * @param[in] ulNow       Current tick
+ * @date  19.10.2026
+ ******************************************************************************/
+void vTWHEEL_Init(TWHEEL_TypeDef* psWheel, uint32_t ulNow)
+{
+  for (uint32_t l = 0uL; l < TWHEEL_LEVELS; ++l)
+  {
+    for (uint32_t s = 0uL; s < TWHEEL_SLOTS; ++s)
+    {
+      psWheel->apsSlots[l][s] = NULL;
+    }
+  }
+  psWheel->ulNow = ulNow;
+  psWheel->ulActive = 0uL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Insert timer
+ *
+ * The timer's ulExpiry must lie after the wheel's current tick.
+ *
+ * @param[in,out] *psWheel  Timer wheel
+ * @param[in,out] *psTimer  Idle timer with expiry set
+ * @date  19.10.2026
+ ******************************************************************************/
+void vTWHEEL_Insert(TWHEEL_TypeDef* psWheel, TWHEEL_TimerTypeDef* psTimer)
+{
+  vTWHEEL_Place(psWheel, psTimer);
+  psWheel->ulActive++;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Remove timer
+ *
+ * Has no effect on idle timers.
+ *
+ * @param[in,out] *psWheel  Timer wheel
+ * @param[in,out] *psTimer  Timer
+ * @date  19.10.2026
+ ******************************************************************************/
+void vTWHEEL_Remove(TWHEEL_TypeDef* psWheel, TWHEEL_TimerTypeDef* psTimer)
+{
+  if (bTWHEEL_IsActive(psTimer))
+  {
+    vTWHEEL_Unlink(psTimer);
+    psWheel->ulActive--;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Advance wheel by one tick and fire expired timers
+ *
+ * Periodic timers are re-inserted before their callback is invoked, so the
+ * callback may stop or restart them.
+ *
+ * @param[in,out] *psWheel  Timer wheel
+ * @date  19.10.2026
+ ******************************************************************************/
+void vTWHEEL_Advance(TWHEEL_TypeDef* psWheel)
+{
+  uint32_t ulNow = ++psWheel->ulNow;
+
+  // Cascade upper levels on wrap-around of the level below
+  for (uint32_t l = 1uL; l < TWHEEL_LEVELS; ++l)
+  {
+    if ((ulNow & ((1uL << (TWHEEL_SLOT_BITS * l)) - 1uL)) != 0uL) break;
+    vTWHEEL_Cascade(psWheel, l);
+  }
+
+  // Detach current slot so that callbacks can safely modify the wheel
+  TWHEEL_TimerTypeDef** ppsSlot = &psWheel->apsSlots[0][ulNow & TWHEEL_SLOT_MASK];
+  if (*ppsSlot == NULL) return;
+  TWHEEL_TimerTypeDef* psExpired = *ppsSlot;
+  psExpired->ppsPrev = &psExpired;
+  *ppsSlot = NULL;
+
+  TWHEEL_TimerTypeDef* psTimer;
+  while ((psTimer = psExpired) != NULL)
+  {
+    vTWHEEL_Unlink(psTimer);
+    if (psTimer->ulPeriod != 0uL)
+    {
+      psTimer->ulExpiry += psTimer->ulPeriod;
+      vTWHEEL_Place(psWheel, psTimer);
+    }
+    else
+    {
+      psWheel->ulActive--;
+    }
+    psTimer->pfnCallback(psTimer);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get number of ticks that need no processing
+ *
+ * Counts the ticks after the current one for which vTWHEEL_Advance() would
+ * neither fire a timer nor cascade, so that a tickless caller may skip them
+ * and advance the wheel afterwards. Only the level 0 window is scanned, so
+ * the result is at most TWHEEL_SLOTS - 1 while timers are active.
+ *
+ * @param[in] *psWheel  Timer wheel
+ * @param[in] ulMax     Upper limit of result
+ * @return  (uint32_t)  Number of idle ticks
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulTWHEEL_GetIdleTicks(const TWHEEL_TypeDef* psWheel, uint32_t ulMax)
+{
+  if (psWheel->ulActive == 0uL) return ulMax;
+
+  uint32_t ulIdle = 0uL;
+  uint32_t ulTick = psWheel->ulNow + 1uL;
+  while ((ulIdle < ulMax) && ((ulTick & TWHEEL_SLOT_MASK) != 0uL) &&
+         (psWheel->apsSlots[0][ulTick & TWHEEL_SLOT_MASK] == NULL))
+  {
+    ulIdle++;
+    ulTick++;
+  }
+  return ulIdle;
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Push timer to front of list
+ *
+ * @param[in,out] **ppsHead List head
+ * @param[in,out] *psTimer  Timer
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vTWHEEL_Link(TWHEEL_TimerTypeDef** ppsHead, TWHEEL_TimerTypeDef* psTimer)
+{
+  psTimer->psNext = *ppsHead;
+  if (psTimer->psNext != NULL) psTimer->psNext->ppsPrev = &psTimer->psNext;
+  psTimer->ppsPrev = ppsHead;
+  *ppsHead = psTimer;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Remove timer from its list
+ *
+ * @param[in,out] *psTimer  Linked timer
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vTWHEEL_Unlink(TWHEEL_TimerTypeDef* psTimer)
+{
+  *psTimer->ppsPrev = psTimer->psNext;
+  if (psTimer->psNext != NULL) psTimer->psNext->ppsPrev = psTimer->ppsPrev;
+  psTimer->psNext = NULL;
+  psTimer->ppsPrev = NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Link timer into the slot matching its expiry
+ *
+ * @param[in,out] *psWheel  Timer wheel
+ * @param[in,out] *psTimer  Unlinked timer
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vTWHEEL_Place(TWHEEL_TypeDef* psWheel, TWHEEL_TimerTypeDef* psTimer)
+{
+  uint32_t ulExpiry = psTimer->ulExpiry;
+  uint32_t ulDelta = ulExpiry - psWheel->ulNow;
+
+  // Park out-of-range timers in the farthest top-level slot
+  if ((uint64_t)ulDelta >= TWHEEL_RANGE)
+  {
+    ulExpiry = psWheel->ulNow + (uint32_t)(TWHEEL_RANGE - 1uLL);
+    ulDelta = (uint32_t)(TWHEEL_RANGE - 1uLL);
+  }
+
+  uint32_t ulLevel = 0uL;
+  while (ulDelta >= (1uL << (TWHEEL_SLOT_BITS * (ulLevel + 1uL))))
+  {
+    ulLevel++;
+  }
+
+  uint32_t ulSlot = (ulExpiry >> (TWHEEL_SLOT_BITS * ulLevel)) & TWHEEL_SLOT_MASK;
+  vTWHEEL_Link(&psWheel->apsSlots[ulLevel][ulSlot], psTimer);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Redistribute the current slot of a level into the levels below
+ *
+ * @param[in,out] *psWheel  Timer wheel
+ * @param[in] ulLevel       Level to be cascaded (>= 1)
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vTWHEEL_Cascade(TWHEEL_TypeDef* psWheel, uint32_t ulLevel)
+{
+  uint32_t ulSlot = (psWheel->ulNow >> (TWHEEL_SLOT_BITS * ulLevel)) & TWHEEL_SLOT_MASK;
+  TWHEEL_TimerTypeDef* psTimer = psWheel->apsSlots[ulLevel][ulSlot];
+  psWheel->apsSlots[ulLevel][ulSlot] = NULL;
+
+  while (psTimer != NULL)
+  {
+    TWHEEL_TimerTypeDef* psNext = psTimer->psNext;
+    vTWHEEL_Place(psWheel, psTimer);
+    psTimer = psNext;
+  }
+}
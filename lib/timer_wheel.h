@@ -0,0 +1,74 @@
+/*!****************************************************************************
+ * @file
+ * timer_wheel.h
+ *
+ * @brief
+ * Hierarchical timer wheel
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef TIMER_WHEEL_H_
+#define TIMER_WHEEL_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Number of wheel levels
+#define TWHEEL_LEVELS                 4u
+
+/// Slots per level, as power of two
+#define TWHEEL_SLOT_BITS              5u
+
+/// Slots per level
+#define TWHEEL_SLOTS                  (1u << TWHEEL_SLOT_BITS)
+
+
+/*- Type definitions ---------------------------------------------------------*/
+struct TWHEEL_Timer;
+
+/// Expiry callback
+typedef void (*TWHEEL_CallbackTypeDef)(struct TWHEEL_Timer* psTimer);
+
+/// Timer
+typedef struct TWHEEL_Timer {
+  struct TWHEEL_Timer* psNext;    ///< Slot list link
+  struct TWHEEL_Timer** ppsPrev;  ///< Link pointing to this timer, NULL if idle
+  uint32_t ulExpiry;              ///< Absolute expiry tick
+  uint32_t ulPeriod;              ///< Reload period in ticks, 0 for one-shot
+  TWHEEL_CallbackTypeDef pfnCallback; ///< Expiry callback
+  void* pvContext;                ///< User context
+} TWHEEL_TimerTypeDef;
+
+/// Timer wheel
+typedef struct {
+  TWHEEL_TimerTypeDef* apsSlots[TWHEEL_LEVELS][TWHEEL_SLOTS]; ///< Slot lists
+  uint32_t ulNow;                 ///< Last processed tick
+  uint32_t ulActive;              ///< Number of active timers
+} TWHEEL_TypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vTWHEEL_Init(TWHEEL_TypeDef* psWheel, uint32_t ulNow);
+void vTWHEEL_Insert(TWHEEL_TypeDef* psWheel, TWHEEL_TimerTypeDef* psTimer);
+void vTWHEEL_Remove(TWHEEL_TypeDef* psWheel, TWHEEL_TimerTypeDef* psTimer);
+void vTWHEEL_Advance(TWHEEL_TypeDef* psWheel);
+uint32_t ulTWHEEL_GetIdleTicks(const TWHEEL_TypeDef* psWheel, uint32_t ulMax);
+
+/*!****************************************************************************
+ * @brief
+ * Check if timer is active
+ *
+ * @param[in] *psTimer  Timer
+ * @return  (bool)    Timer is inserted in a wheel
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline bool bTWHEEL_IsActive(const TWHEEL_TimerTypeDef* psTimer)
+{
+  return psTimer->ppsPrev != NULL;
+}
+
+#endif // TIMER_WHEEL_H_
@@ -0,0 +1,535 @@
+/*!****************************************************************************
+ * @file
+ * trace.c
+ *
+ * @brief
+ * Compact binary trace record encoding
+ *
+ * Each stream is a byte sequence of records and resync markers:
+ *
+ *   sync   := 0xFF * TRACE_SYNC_LEN, TRACE_SYNC_END, varint(time)
+ *   record := header, [varint(id)], [varint(dt)], zigzag(arg delta) * n
+ *   header := slot << 4 | n << 2 | mode
+ *
+ *   slot   0..14: event ID found in dictionary slot, 15: literal ID follows
+ *   n      number of arguments (0..3)
+ *   mode   0: same time as previous record in stream
+ *          1: previous record of slot + slot period
+ *          2: previous record of slot + slot period + zigzag(dt) follows,
+ *             for literal IDs: previous record in stream + varint(dt)
+ *          3: previous record in stream + varint(dt) (not for literal IDs)
+ *
+ * Event IDs are kept in a direct-mapped dictionary (slot = ID % 15), which
+ * is cleared by every resync marker. The slot period is the time between the
+ * two previous records of that slot, so periodic events cost a single byte
+ * and jittery ones usually two, while events that closely follow another one
+ * are coded relative to the stream. The decoder only learns slot periods
+ * modulo 2^32, so a slot whose previous record lies 2^32 or more ticks back
+ * is coded relative to the stream as well. Arguments are coded as zig-zag
+ * deltas to the slot's previous arguments, so slowly changing counter samples
+ * stay short.
+ *
+ * Since a 32-bit varint contains at most four 0xFF bytes and header byte 0xFF
+ * (literal with mode 3) is invalid, a run of TRACE_SYNC_LEN 0xFF bytes never
+ * appears within records. After an overflow, the decoder discards input until the
+ * next marker, which carries the absolute time and resets the dictionary.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stddef.h>
+#include "trace.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Header slot index for literal event IDs
+#define TRACE_SLOT_LITERAL            15u
+
+/*! @brief Timestamp modes
+ *  @{                                                                        */
+#define TRACE_MODE_SAME               0u
+#define TRACE_MODE_PERIOD             1u
+#define TRACE_MODE_JITTER             2u
+#define TRACE_MODE_STREAM             3u
+/*! @}                                                                        */
+
+/*! @brief Decoder states
+ *  @{                                                                        */
+#define TRACE_ST_UNSYNCED             0u
+#define TRACE_ST_MARKER               1u
+#define TRACE_ST_SYNC_END             2u
+#define TRACE_ST_SYNC_TIME            3u
+#define TRACE_ST_HEADER               4u
+#define TRACE_ST_ID                   5u
+#define TRACE_ST_DELTA                6u
+#define TRACE_ST_ARG                  7u
+/*! @}                                                                        */
+
+
+/*- Private functions --------------------------------------------------------*/
+static uint8_t* pucTRACE_PutVarint(uint8_t* pucOut, uint32_t ulValue);
+static uint8_t* pucTRACE_PutSync(TRACE_EncoderTypeDef* psEnc, uint8_t* pucOut, uint32_t ulTime);
+static void vTRACE_ResetSlots(TRACE_SlotTypeDef* psSlots);
+static int32_t lTRACE_GetVarint(TRACE_DecoderTypeDef* psDec, uint8_t ucByte);
+static void vTRACE_Lost(TRACE_DecoderTypeDef* psDec);
+static bool bTRACE_NextField(TRACE_DecoderTypeDef* psDec, TRACE_EventTypeDef* psEvent);
+static void vTRACE_Complete(TRACE_DecoderTypeDef* psDec, TRACE_EventTypeDef* psEvent);
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise stream encoder
+ *
+ * The first record will be preceded by a resync marker.
+ *
+ * @param[out] *psEnc   Encoder
+ * @date  19.10.2026
+ ******************************************************************************/
+void vTRACE_EncoderInit(TRACE_EncoderTypeDef* psEnc)
+{
+  vTRACE_ResetSlots(psEnc->asSlots);
+  psEnc->ullLast = 0uLL;
+  psEnc->ulSinceSync = 0uL;
+  psEnc->bSyncPending = true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Emit resync marker before next record
+ *
+ * Must be called whenever encoded output has been dropped, as the decoder's
+ * state no longer matches the encoder's.
+ *
+ * @param[in,out] *psEnc  Encoder
+ * @date  19.10.2026
+ ******************************************************************************/
+void vTRACE_RequestSync(TRACE_EncoderTypeDef* psEnc)
+{
+  psEnc->bSyncPending = true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Encode trace record
+ *
+ * @param[in,out] *psEnc  Encoder
+ * @param[out] *pucOut    Output buffer, at least TRACE_ENCODE_MAX bytes
+ * @param[in] ulTime      Timestamp
+ * @param[in] uiId        Event ID (not TRACE_ID_NONE)
+ * @param[in] ulNumArgs   Number of arguments (0..TRACE_MAX_ARGS)
+ * @param[in] *pulArgs    Arguments
+ * @return  (uint32_t)  Number of bytes written
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulTRACE_Encode(TRACE_EncoderTypeDef* psEnc, uint8_t* pucOut, uint32_t ulTime,
+                        uint16_t uiId, uint32_t ulNumArgs, const uint32_t* pulArgs)
+{
+  uint8_t* pucPos = pucOut;
+  if (psEnc->bSyncPending || (psEnc->ulSinceSync >= TRACE_SYNC_INTERVAL))
+  {
+    pucPos = pucTRACE_PutSync(psEnc, pucPos, ulTime);
+  }
+  psEnc->ulSinceSync++;
+
+  uint32_t ulSlot = uiId % TRACE_DICT_SLOTS;
+  TRACE_SlotTypeDef* psSlot = &psEnc->asSlots[ulSlot];
+  bool bHit = (psSlot->uiId == uiId);
+  uint32_t ulStream = ulTime - (uint32_t)psEnc->ullLast;
+  uint64_t ullTime = psEnc->ullLast + ulStream;
+  uint64_t ullPeriod = bHit ? (ullTime - psEnc->aullLast[ulSlot]) : 0uLL;
+  uint32_t ulPeriod = (uint32_t)ullPeriod;
+
+  // Pick shortest timestamp coding
+  uint32_t ulMode = TRACE_MODE_JITTER;
+  uint32_t ulDelta = ulStream;
+  if (ulStream == 0uL)
+  {
+    ulMode = TRACE_MODE_SAME;
+  }
+  else if (bHit)
+  {
+    uint32_t ulJitter = ulPeriod - psSlot->ulDelta;
+    ulJitter = (ulJitter << 1) ^ (uint32_t)((int32_t)ulJitter >> 31);
+    if (ullPeriod > 0xFFFFFFFFuLL) ulMode = TRACE_MODE_STREAM;
+    else if (ulJitter == 0uL) ulMode = TRACE_MODE_PERIOD;
+    else if (ulJitter <= ulStream) ulDelta = ulJitter;
+    else ulMode = TRACE_MODE_STREAM;
+  }
+
+  *pucPos++ = (uint8_t)(((bHit ? ulSlot : TRACE_SLOT_LITERAL) << 4) | (ulNumArgs << 2) | ulMode);
+  if (!bHit)
+  {
+    pucPos = pucTRACE_PutVarint(pucPos, uiId);
+    psSlot->uiId = uiId;
+    for (uint32_t i = 0uL; i < TRACE_MAX_ARGS; ++i)
+    {
+      psSlot->aulArgs[i] = 0uL;
+    }
+  }
+  if (ulMode >= TRACE_MODE_JITTER) pucPos = pucTRACE_PutVarint(pucPos, ulDelta);
+
+  for (uint32_t i = 0uL; i < ulNumArgs; ++i)
+  {
+    uint32_t ulDiff = pulArgs[i] - psSlot->aulArgs[i];
+    pucPos = pucTRACE_PutVarint(pucPos, (ulDiff << 1) ^ (uint32_t)((int32_t)ulDiff >> 31));
+    psSlot->aulArgs[i] = pulArgs[i];
+  }
+
+  psSlot->ulDelta = ulPeriod;
+  psEnc->aullLast[ulSlot] = ullTime;
+  psEnc->ullLast = ullTime;
+  return (uint32_t)(pucPos - pucOut);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Initialise stream decoder
+ *
+ * Input is discarded until the first resync marker.
+ *
+ * @param[out] *psDec   Decoder
+ * @date  19.10.2026
+ ******************************************************************************/
+void vTRACE_DecoderInit(TRACE_DecoderTypeDef* psDec)
+{
+  vTRACE_ResetSlots(psDec->asSlots);
+  psDec->ullLast = 0uLL;
+  psDec->ucState = TRACE_ST_UNSYNCED;
+  psDec->ucRun = 0u;
+  psDec->bTimeValid = false;
+  psDec->ulEvents = 0uL;
+  psDec->ulSyncs = 0uL;
+  psDec->ulErrors = 0uL;
+  psDec->ullRawBytes = 0uLL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Feed one byte of stream data into decoder
+ *
+ * @param[in,out] *psDec  Decoder
+ * @param[in] ucByte      Stream data
+ * @param[out] *psEvent   Decoded event, valid if true is returned
+ * @return  (bool)  A record has been completed
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bTRACE_DecodeByte(TRACE_DecoderTypeDef* psDec, uint8_t ucByte,
+                       TRACE_EventTypeDef* psEvent)
+{
+  // Resync marker detection, independent of parser state
+  psDec->ucRun = (ucByte == 0xFFu) ? (uint8_t)(psDec->ucRun + 1u) : 0u;
+  if (psDec->ucRun == TRACE_SYNC_LEN)
+  {
+    if ((psDec->ucState != TRACE_ST_MARKER) && (psDec->ucState != TRACE_ST_UNSYNCED))
+    {
+      psDec->ulErrors++;
+    }
+    psDec->ucState = TRACE_ST_SYNC_END;
+    return false;
+  }
+  if (psDec->ucRun > TRACE_SYNC_LEN) psDec->ucRun = TRACE_SYNC_LEN + 1u;
+
+  int32_t lRes;
+  switch (psDec->ucState)
+  {
+    case TRACE_ST_MARKER:
+      if (ucByte != 0xFFu) vTRACE_Lost(psDec);
+      return false;
+
+    case TRACE_ST_SYNC_END:
+      if (ucByte == TRACE_SYNC_END)
+      {
+        psDec->ucState = TRACE_ST_SYNC_TIME;
+        psDec->ulAcc = 0uL;
+        psDec->ucShift = 0u;
+      }
+      else if (ucByte != 0xFFu)
+      {
+        vTRACE_Lost(psDec);
+      }
+      return false;
+
+    case TRACE_ST_SYNC_TIME:
+      lRes = lTRACE_GetVarint(psDec, ucByte);
+      if (lRes > 0L)
+      {
+        uint32_t ulTime = psDec->ulAcc;
+        if (psDec->bTimeValid)
+        {
+          psDec->ullLast += (uint32_t)(ulTime - (uint32_t)psDec->ullLast);
+        }
+        else
+        {
+          psDec->ullLast = ulTime;
+          psDec->bTimeValid = true;
+        }
+        vTRACE_ResetSlots(psDec->asSlots);
+        psDec->ulSyncs++;
+        psDec->ucState = TRACE_ST_HEADER;
+      }
+      return false;
+
+    case TRACE_ST_HEADER:
+    {
+      if (ucByte == 0xFFu)
+      {
+        psDec->ucState = TRACE_ST_MARKER;
+        return false;
+      }
+
+      uint8_t ucSlot = ucByte >> 4;
+      uint8_t ucMode = ucByte & 0x03u;
+      if (((ucSlot == TRACE_SLOT_LITERAL) &&
+           ((ucMode == TRACE_MODE_PERIOD) || (ucMode == TRACE_MODE_STREAM))) ||
+          ((ucSlot != TRACE_SLOT_LITERAL) && (psDec->asSlots[ucSlot].uiId == TRACE_ID_NONE)))
+      {
+        vTRACE_Lost(psDec);
+        return false;
+      }
+
+      psDec->ucHeader = ucByte;
+      psDec->ucArg = 0u;
+      psDec->ulAcc = 0uL;
+      psDec->ucShift = 0u;
+      psDec->sEvent.ucNumArgs = (ucByte >> 2) & 0x03u;
+      if (ucSlot == TRACE_SLOT_LITERAL)
+      {
+        psDec->ucState = TRACE_ST_ID;
+        return false;
+      }
+      psDec->sEvent.uiId = psDec->asSlots[ucSlot].uiId;
+      return bTRACE_NextField(psDec, psEvent);
+    }
+
+    case TRACE_ST_ID:
+      lRes = lTRACE_GetVarint(psDec, ucByte);
+      if ((lRes > 0L) && (psDec->ulAcc >= TRACE_ID_NONE))
+      {
+        vTRACE_Lost(psDec);
+        return false;
+      }
+      if (lRes <= 0L) return false;
+
+      // Install literal ID into its dictionary slot
+      {
+        TRACE_SlotTypeDef* psSlot = &psDec->asSlots[psDec->ulAcc % TRACE_DICT_SLOTS];
+        psSlot->uiId = (uint16_t)psDec->ulAcc;
+        for (uint32_t i = 0uL; i < TRACE_MAX_ARGS; ++i)
+        {
+          psSlot->aulArgs[i] = 0uL;
+        }
+        psDec->sEvent.uiId = psSlot->uiId;
+      }
+      psDec->ulAcc = 0uL;
+      psDec->ucShift = 0u;
+      return bTRACE_NextField(psDec, psEvent);
+
+    case TRACE_ST_DELTA:
+    case TRACE_ST_ARG:
+      lRes = lTRACE_GetVarint(psDec, ucByte);
+      if (lRes <= 0L) return false;
+
+      if (psDec->ucState == TRACE_ST_DELTA)
+      {
+        psDec->sEvent.ullTime = psDec->ulAcc;
+      }
+      else
+      {
+        uint32_t ulZig = psDec->ulAcc;
+        psDec->sEvent.aulArgs[psDec->ucArg++] = (ulZig >> 1) ^ (0uL - (ulZig & 1uL));
+      }
+      psDec->ulAcc = 0uL;
+      psDec->ucShift = 0u;
+      return bTRACE_NextField(psDec, psEvent);
+
+    default:
+      return false;
+  }
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Write unsigned LEB128 varint
+ *
+ * @param[out] *pucOut  Output position
+ * @param[in] ulValue   Value
+ * @return  (uint8_t*)  Next output position
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint8_t* pucTRACE_PutVarint(uint8_t* pucOut, uint32_t ulValue)
+{
+  while (ulValue >= 0x80uL)
+  {
+    *pucOut++ = (uint8_t)(ulValue | 0x80uL);
+    ulValue >>= 7;
+  }
+  *pucOut++ = (uint8_t)ulValue;
+  return pucOut;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write resync marker and reset encoder state
+ *
+ * @param[in,out] *psEnc  Encoder
+ * @param[out] *pucOut    Output position
+ * @param[in] ulTime      Absolute timestamp
+ * @return  (uint8_t*)  Next output position
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint8_t* pucTRACE_PutSync(TRACE_EncoderTypeDef* psEnc, uint8_t* pucOut, uint32_t ulTime)
+{
+  for (uint32_t i = 0uL; i < TRACE_SYNC_LEN; ++i)
+  {
+    *pucOut++ = 0xFFu;
+  }
+  *pucOut++ = TRACE_SYNC_END;
+  pucOut = pucTRACE_PutVarint(pucOut, ulTime);
+
+  vTRACE_ResetSlots(psEnc->asSlots);
+  psEnc->ullLast += (uint32_t)(ulTime - (uint32_t)psEnc->ullLast);
+  psEnc->ulSinceSync = 0uL;
+  psEnc->bSyncPending = false;
+  return pucOut;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Clear event ID dictionary
+ *
+ * @param[out] *psSlots   Dictionary slots
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vTRACE_ResetSlots(TRACE_SlotTypeDef* psSlots)
+{
+  for (uint32_t i = 0uL; i < TRACE_DICT_SLOTS; ++i)
+  {
+    psSlots[i].uiId = TRACE_ID_NONE;
+    psSlots[i].ulDelta = 0uL;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Accumulate varint byte
+ *
+ * @param[in,out] *psDec  Decoder
+ * @param[in] ucByte      Stream data
+ * @return  (int32_t)   1: value complete, 0: more bytes follow, -1: error
+ * @date  19.10.2026
+ ******************************************************************************/
+static int32_t lTRACE_GetVarint(TRACE_DecoderTypeDef* psDec, uint8_t ucByte)
+{
+  if ((psDec->ucShift == 28u) && ((ucByte & 0xF0u) != 0u))
+  {
+    vTRACE_Lost(psDec);
+    return -1L;
+  }
+
+  psDec->ulAcc |= (uint32_t)(ucByte & 0x7Fu) << psDec->ucShift;
+  psDec->ucShift += 7u;
+  return ((ucByte & 0x80u) == 0u) ? 1L : 0L;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Drop record being decoded and wait for next resync marker
+ *
+ * @param[in,out] *psDec  Decoder
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vTRACE_Lost(TRACE_DecoderTypeDef* psDec)
+{
+  psDec->ulErrors++;
+  psDec->ucState = TRACE_ST_UNSYNCED;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Advance to next record field, or complete record
+ *
+ * @param[in,out] *psDec  Decoder
+ * @param[out] *psEvent   Decoded event
+ * @return  (bool)  Record has been completed
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bTRACE_NextField(TRACE_DecoderTypeDef* psDec, TRACE_EventTypeDef* psEvent)
+{
+  if ((psDec->ucState != TRACE_ST_DELTA) && (psDec->ucState != TRACE_ST_ARG) &&
+      ((psDec->ucHeader & 0x03u) >= TRACE_MODE_JITTER))
+  {
+    psDec->ucState = TRACE_ST_DELTA;
+    return false;
+  }
+  if (psDec->ucArg < psDec->sEvent.ucNumArgs)
+  {
+    psDec->ucState = TRACE_ST_ARG;
+    return false;
+  }
+
+  vTRACE_Complete(psDec, psEvent);
+  psDec->ucState = TRACE_ST_HEADER;
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Apply completed record to decoder state
+ *
+ * @param[in,out] *psDec  Decoder
+ * @param[out] *psEvent   Decoded event
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vTRACE_Complete(TRACE_DecoderTypeDef* psDec, TRACE_EventTypeDef* psEvent)
+{
+  TRACE_EventTypeDef* psRec = &psDec->sEvent;
+  bool bLiteral = (psDec->ucHeader >> 4) == TRACE_SLOT_LITERAL;
+  uint32_t ulSlot = psRec->uiId % TRACE_DICT_SLOTS;
+  TRACE_SlotTypeDef* psSlot = &psDec->asSlots[ulSlot];
+
+  // Timestamp (parsed delta is parked in ullTime)
+  uint32_t ulDelta = (uint32_t)psRec->ullTime;
+  uint64_t ullTime = psDec->ullLast;
+  switch (psDec->ucHeader & 0x03u)
+  {
+    case TRACE_MODE_PERIOD:
+      ullTime = psDec->aullLast[ulSlot] + psSlot->ulDelta;
+      break;
+    case TRACE_MODE_JITTER:
+      if (bLiteral)
+      {
+        ullTime += ulDelta;
+      }
+      else
+      {
+        ulDelta = (ulDelta >> 1) ^ (0uL - (ulDelta & 1uL));
+        ullTime = psDec->aullLast[ulSlot] + (uint32_t)(psSlot->ulDelta + ulDelta);
+      }
+      break;
+    case TRACE_MODE_STREAM:
+      ullTime += ulDelta;
+      break;
+    default:
+      break;
+  }
+
+  psSlot->ulDelta = bLiteral ? 0uL : (uint32_t)(ullTime - psDec->aullLast[ulSlot]);
+  psDec->aullLast[ulSlot] = ullTime;
+  psDec->ullLast = ullTime;
+
+  psEvent->ullTime = ullTime;
+  psEvent->uiId = psRec->uiId;
+  psEvent->ucNumArgs = psRec->ucNumArgs;
+  for (uint32_t i = 0uL; i < psRec->ucNumArgs; ++i)
+  {
+    psSlot->aulArgs[i] += psRec->aulArgs[i];
+    psEvent->aulArgs[i] = psSlot->aulArgs[i];
+  }
+
+  psDec->ulEvents++;
+  psDec->ullRawBytes += TRACE_RAW_SIZE(psRec->ucNumArgs);
+}
@@ -0,0 +1,108 @@
+/*!****************************************************************************
+ * @file
+ * trace.h
+ *
+ * @brief
+ * Compact binary trace record encoding
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Number of event ID dictionary slots per stream (slot index 15 is literal)
+#define TRACE_DICT_SLOTS              15u
+
+/// Maximum number of arguments per record
+#define TRACE_MAX_ARGS                3u
+
+/// Number of 0xFF bytes starting a resync marker
+#define TRACE_SYNC_LEN                6u
+
+/// Byte terminating a resync marker
+#define TRACE_SYNC_END                0xA5u
+
+/// Records between resync markers
+#ifndef TRACE_SYNC_INTERVAL
+#define TRACE_SYNC_INTERVAL           128uL
+#endif
+
+/// Reserved event ID (unused dictionary slot)
+#define TRACE_ID_NONE                 0xFFFFu
+
+/// Maximum encoded length of a 32-bit varint
+#define TRACE_VARINT_MAX              5u
+
+/// Maximum output of a single ulTRACE_Encode() call (sync + record)
+#define TRACE_ENCODE_MAX              (TRACE_SYNC_LEN + 1u + TRACE_VARINT_MAX + 1u + \
+                                       (2u + TRACE_MAX_ARGS) * TRACE_VARINT_MAX)
+
+/// Size of an equivalent raw fixed-width record
+#define TRACE_RAW_SIZE(args)          (8uL + 4uL * (args))
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Dictionary slot
+typedef struct {
+  uint16_t uiId;                      ///< Event ID, TRACE_ID_NONE if unused
+  uint32_t ulDelta;                   ///< Timestamp delta of last record
+  uint32_t aulArgs[TRACE_MAX_ARGS];   ///< Arguments of last record
+} TRACE_SlotTypeDef;
+
+/// Encoder state (one per stream)
+typedef struct {
+  TRACE_SlotTypeDef asSlots[TRACE_DICT_SLOTS]; ///< Event ID dictionary
+  uint64_t aullLast[TRACE_DICT_SLOTS]; ///< Extended slot timestamps
+  uint64_t ullLast;                   ///< Extended timestamp of last record
+  uint32_t ulSinceSync;               ///< Records since last resync marker
+  bool bSyncPending;                  ///< Emit resync marker before next record
+} TRACE_EncoderTypeDef;
+
+/// Decoded event
+typedef struct {
+  uint64_t ullTime;                   ///< Timestamp, extended to 64 bits
+  uint16_t uiId;                      ///< Event ID
+  uint8_t ucNumArgs;                  ///< Number of arguments
+  uint32_t aulArgs[TRACE_MAX_ARGS];   ///< Arguments
+} TRACE_EventTypeDef;
+
+/// Decoder state (one per stream)
+typedef struct {
+  TRACE_SlotTypeDef asSlots[TRACE_DICT_SLOTS]; ///< Event ID dictionary
+  uint64_t aullLast[TRACE_DICT_SLOTS]; ///< Extended slot timestamps
+  uint64_t ullLast;                   ///< Extended timestamp of last record
+  TRACE_EventTypeDef sEvent;          ///< Record being decoded
+  uint32_t ulAcc;                     ///< Varint accumulator
+  uint8_t ucShift;                    ///< Varint bit position
+  uint8_t ucState;                    ///< Parser state
+  uint8_t ucHeader;                   ///< Header of record being decoded
+  uint8_t ucArg;                      ///< Argument being decoded
+  uint8_t ucRun;                      ///< Consecutive 0xFF bytes
+  bool bTimeValid;                    ///< Extended time base is valid
+  uint32_t ulEvents;                  ///< Decoded records
+  uint32_t ulSyncs;                   ///< Resync markers seen
+  uint32_t ulErrors;                  ///< Malformed records / lost sync
+  uint64_t ullRawBytes;               ///< Size as raw fixed-width records
+} TRACE_DecoderTypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+// Encoder
+void vTRACE_EncoderInit(TRACE_EncoderTypeDef* psEnc);
+void vTRACE_RequestSync(TRACE_EncoderTypeDef* psEnc);
+uint32_t ulTRACE_Encode(TRACE_EncoderTypeDef* psEnc, uint8_t* pucOut, uint32_t ulTime,
+                        uint16_t uiId, uint32_t ulNumArgs, const uint32_t* pulArgs);
+
+// Decoder
+void vTRACE_DecoderInit(TRACE_DecoderTypeDef* psDec);
+bool bTRACE_DecodeByte(TRACE_DecoderTypeDef* psDec, uint8_t ucByte,
+                       TRACE_EventTypeDef* psEvent);
+
+#endif // TRACE_H_
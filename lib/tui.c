@@ -0,0 +1,368 @@
+/*!****************************************************************************
+ * @file
+ * tui.c
+ *
+ * @brief
+ * Diff-rendered VT100 text UI
+ *
+ * Drawing functions only modify the back buffer. ulTUI_Refresh() compares it
+ * against the front buffer (what the terminal currently shows) and emits only
+ * the changed runs of each row, preceded by a cursor movement and attribute
+ * changes where needed. Short unchanged gaps between changes are rewritten
+ * instead of skipped, as that is cheaper than another cursor movement.
+ *
+ * The region is anchored at the cursor position on vTUI_Init() and addressed
+ * with relative cursor movements only, so it can follow any amount of
+ * preceding console output regardless of terminal height.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "tui.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Blank cell
+#define TUI_BLANK                     ((uint16_t)' ')
+
+/// Cell which never matches a drawn cell
+#define TUI_INVALID                   0xFFFFu
+
+/// Unchanged cells up to this gap length are rewritten within a run
+#define TUI_MERGE_GAP                 4u
+
+/// Build cell from attribute and character
+#define TUI_CELL(attr, ch)            ((uint16_t)(((uint16_t)(attr) << 8) | (uint8_t)(ch)))
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vTUI_Emit(TUI_TypeDef* psTui, const char* pcBuf, uint32_t ulLen);
+static void vTUI_EmitCsi(TUI_TypeDef* psTui, uint32_t ulParam, char cFinal);
+static void vTUI_Flush(TUI_TypeDef* psTui);
+static void vTUI_MoveTo(TUI_TypeDef* psTui, uint8_t ucRow, uint8_t ucCol);
+static void vTUI_SetAttr(TUI_TypeDef* psTui, uint8_t ucAttr);
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise text UI region at current cursor position
+ *
+ * Reserves TUI_ROWS lines (scrolling the terminal if necessary) and returns
+ * the cursor to the top left corner of the region.
+ *
+ * @param[out] *psTui     Text UI region
+ * @param[in] pfnWrite    Output function
+ * @date  19.10.2026
+ ******************************************************************************/
+void vTUI_Init(TUI_TypeDef* psTui, TUI_WriteTypeDef pfnWrite)
+{
+  psTui->pfnWrite = pfnWrite;
+  psTui->ulOutLen = 0uL;
+  psTui->ucAttr = TUI_ATTR_NONE;
+
+  vTUI_Emit(psTui, VT100_CURSOR_HIDE VT100_RESET_ATTRS, sizeof(VT100_CURSOR_HIDE VT100_RESET_ATTRS) - 1u);
+  for (uint32_t r = 0uL; r < TUI_ROWS; ++r)
+  {
+    vTUI_Emit(psTui, "\r\n", 2u);
+  }
+  vTUI_EmitCsi(psTui, TUI_ROWS, 'A');
+  vTUI_Flush(psTui);
+  psTui->ucRow = 0u;
+  psTui->ucCol = 0u;
+
+  vTUI_Clear(psTui);
+  for (uint32_t r = 0uL; r < TUI_ROWS; ++r)
+  {
+    for (uint32_t c = 0uL; c < TUI_COLS; ++c)
+    {
+      psTui->auiFront[r][c] = TUI_BLANK;
+    }
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Clear back buffer
+ *
+ * @param[in,out] *psTui  Text UI region
+ * @date  19.10.2026
+ ******************************************************************************/
+void vTUI_Clear(TUI_TypeDef* psTui)
+{
+  for (uint32_t r = 0uL; r < TUI_ROWS; ++r)
+  {
+    for (uint32_t c = 0uL; c < TUI_COLS; ++c)
+    {
+      psTui->auiBack[r][c] = TUI_BLANK;
+    }
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Force full redraw on next refresh
+ *
+ * @param[in,out] *psTui  Text UI region
+ * @date  19.10.2026
+ ******************************************************************************/
+void vTUI_Invalidate(TUI_TypeDef* psTui)
+{
+  for (uint32_t r = 0uL; r < TUI_ROWS; ++r)
+  {
+    for (uint32_t c = 0uL; c < TUI_COLS; ++c)
+    {
+      psTui->auiFront[r][c] = TUI_INVALID;
+    }
+  }
+  psTui->ucCol = TUI_COLS;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Draw string into back buffer
+ *
+ * Output is clipped at the region border. Control characters are drawn as
+ * blanks.
+ *
+ * @param[in,out] *psTui  Text UI region
+ * @param[in] ucRow       Row
+ * @param[in] ucCol       Column
+ * @param[in] ucAttr      Cell attributes TUI_ATTR_x
+ * @param[in] *pcStr      String
+ * @date  19.10.2026
+ ******************************************************************************/
+void vTUI_Puts(TUI_TypeDef* psTui, uint8_t ucRow, uint8_t ucCol, uint8_t ucAttr,
+               const char* pcStr)
+{
+  if (ucRow >= TUI_ROWS) return;
+
+  for (uint32_t c = ucCol; (c < TUI_COLS) && (*pcStr != '\0'); ++c, ++pcStr)
+  {
+    char cCh = ((uint8_t)*pcStr < 0x20u) ? ' ' : *pcStr;
+    psTui->auiBack[ucRow][c] = TUI_CELL(ucAttr, cCh);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Draw formatted string into back buffer
+ *
+ * @param[in,out] *psTui  Text UI region
+ * @param[in] ucRow       Row
+ * @param[in] ucCol       Column
+ * @param[in] ucAttr      Cell attributes TUI_ATTR_x
+ * @param[in] *pcFmt      printf() format string
+ * @date  19.10.2026
+ ******************************************************************************/
+void vTUI_Printf(TUI_TypeDef* psTui, uint8_t ucRow, uint8_t ucCol, uint8_t ucAttr,
+                 const char* pcFmt, ...)
+{
+  char acBuf[TUI_COLS + 1u];
+  va_list args;
+  va_start(args, pcFmt);
+  (void)vsnprintf(acBuf, sizeof(acBuf), pcFmt, args);
+  va_end(args);
+  vTUI_Puts(psTui, ucRow, ucCol, ucAttr, acBuf);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Emit changes between back and front buffer
+ *
+ * @param[in,out] *psTui  Text UI region
+ * @return  (uint32_t)  Number of bytes emitted
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulTUI_Refresh(TUI_TypeDef* psTui)
+{
+  psTui->ulBytes = 0uL;
+
+  for (uint32_t r = 0uL; r < TUI_ROWS; ++r)
+  {
+    const uint16_t* puiBack = psTui->auiBack[r];
+    uint16_t* puiFront = psTui->auiFront[r];
+
+    uint32_t c = 0uL;
+    while (c < TUI_COLS)
+    {
+      if (puiBack[c] == puiFront[c])
+      {
+        ++c;
+        continue;
+      }
+
+      // Extend run over changed cells and short unchanged gaps
+      uint32_t ulStart = c;
+      uint32_t ulLast = c;
+      for (uint32_t j = c + 1uL; (j < TUI_COLS) && (j - ulLast <= TUI_MERGE_GAP); ++j)
+      {
+        if (puiBack[j] != puiFront[j]) ulLast = j;
+      }
+
+      vTUI_MoveTo(psTui, (uint8_t)r, (uint8_t)ulStart);
+      for (uint32_t k = ulStart; k <= ulLast; ++k)
+      {
+        uint16_t uiCell = puiBack[k];
+        vTUI_SetAttr(psTui, (uint8_t)(uiCell >> 8));
+        char cCh = (char)(uiCell & 0xFFu);
+        vTUI_Emit(psTui, &cCh, 1u);
+        puiFront[k] = uiCell;
+      }
+      psTui->ucCol = (uint8_t)(ulLast + 1uL);
+      c = ulLast + 1uL;
+    }
+  }
+
+  vTUI_SetAttr(psTui, TUI_ATTR_NONE);
+  vTUI_Flush(psTui);
+  return psTui->ulBytes;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Erase region and leave the cursor at its top left corner
+ *
+ * Other output can then be written to the terminal in place of the region.
+ * vTUI_Init() afterwards reserves a new region below that output.
+ *
+ * @param[in,out] *psTui  Text UI region
+ * @date  19.10.2026
+ ******************************************************************************/
+void vTUI_Release(TUI_TypeDef* psTui)
+{
+  vTUI_MoveTo(psTui, 0u, 0u);
+  vTUI_SetAttr(psTui, TUI_ATTR_NONE);
+  vTUI_Emit(psTui, VT100_ERASE_DOWN VT100_CURSOR_SHOW, sizeof(VT100_ERASE_DOWN VT100_CURSOR_SHOW) - 1u);
+  vTUI_Flush(psTui);
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Stage bytes for output
+ *
+ * @param[in,out] *psTui  Text UI region
+ * @param[in] *pcBuf      Data
+ * @param[in] ulLen       Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vTUI_Emit(TUI_TypeDef* psTui, const char* pcBuf, uint32_t ulLen)
+{
+  psTui->ulBytes += ulLen;
+  while (ulLen > 0uL)
+  {
+    uint32_t ulChunk = TUI_OUT_SIZE - psTui->ulOutLen;
+    if (ulChunk > ulLen) ulChunk = ulLen;
+    (void)memcpy(&psTui->acOut[psTui->ulOutLen], pcBuf, ulChunk);
+    psTui->ulOutLen += ulChunk;
+    pcBuf += ulChunk;
+    ulLen -= ulChunk;
+    if (psTui->ulOutLen == TUI_OUT_SIZE) vTUI_Flush(psTui);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stage control sequence with a single numeric parameter
+ *
+ * @param[in,out] *psTui  Text UI region
+ * @param[in] ulParam     Parameter (omitted if 1)
+ * @param[in] cFinal      Final character
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vTUI_EmitCsi(TUI_TypeDef* psTui, uint32_t ulParam, char cFinal)
+{
+  char acBuf[16];
+  uint32_t ulLen = sizeof(acBuf);
+  acBuf[--ulLen] = cFinal;
+  if (ulParam != 1uL)
+  {
+    do
+    {
+      acBuf[--ulLen] = (char)('0' + (ulParam % 10uL));
+      ulParam /= 10uL;
+    } while (ulParam != 0uL);
+  }
+  acBuf[--ulLen] = '[';
+  acBuf[--ulLen] = '\e';
+  vTUI_Emit(psTui, &acBuf[ulLen], sizeof(acBuf) - ulLen);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Pass staged output to output function
+ *
+ * @param[in,out] *psTui  Text UI region
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vTUI_Flush(TUI_TypeDef* psTui)
+{
+  if (psTui->ulOutLen != 0uL)
+  {
+    psTui->pfnWrite(psTui->acOut, psTui->ulOutLen);
+    psTui->ulOutLen = 0uL;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Move cursor using relative movements
+ *
+ * @param[in,out] *psTui  Text UI region
+ * @param[in] ucRow       Target row
+ * @param[in] ucCol       Target column
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vTUI_MoveTo(TUI_TypeDef* psTui, uint8_t ucRow, uint8_t ucCol)
+{
+  // Column may be unknown after writing the last cell (pending auto-wrap)
+  if ((psTui->ucCol >= TUI_COLS) || ((ucCol == 0u) && (psTui->ucCol != 0u)))
+  {
+    vTUI_Emit(psTui, "\r", 1u);
+    psTui->ucCol = 0u;
+  }
+
+  if (ucRow > psTui->ucRow) vTUI_EmitCsi(psTui, ucRow - psTui->ucRow, 'B');
+  else if (ucRow < psTui->ucRow) vTUI_EmitCsi(psTui, psTui->ucRow - ucRow, 'A');
+
+  if (ucCol > psTui->ucCol) vTUI_EmitCsi(psTui, ucCol - psTui->ucCol, 'C');
+  else if (ucCol < psTui->ucCol) vTUI_EmitCsi(psTui, psTui->ucCol - ucCol, 'D');
+
+  psTui->ucRow = ucRow;
+  psTui->ucCol = ucCol;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Change terminal attributes if required
+ *
+ * @param[in,out] *psTui  Text UI region
+ * @param[in] ucAttr      Cell attributes TUI_ATTR_x
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vTUI_SetAttr(TUI_TypeDef* psTui, uint8_t ucAttr)
+{
+  if (ucAttr == psTui->ucAttr) return;
+
+  char acBuf[16] = "\e[0";
+  uint32_t ulLen = 3uL;
+  if ((ucAttr & TUI_ATTR_BOLD) != 0u) { acBuf[ulLen++] = ';'; acBuf[ulLen++] = '1'; }
+  if ((ucAttr & TUI_ATTR_UNDERLINE) != 0u) { acBuf[ulLen++] = ';'; acBuf[ulLen++] = '4'; }
+  if ((ucAttr & TUI_ATTR_INVERT) != 0u) { acBuf[ulLen++] = ';'; acBuf[ulLen++] = '7'; }
+  if ((ucAttr >> 4) != 0u)
+  {
+    acBuf[ulLen++] = ';';
+    acBuf[ulLen++] = '3';
+    acBuf[ulLen++] = (char)('0' + (ucAttr >> 4) - 1u);
+  }
+  acBuf[ulLen++] = 'm';
+
+  vTUI_Emit(psTui, acBuf, ulLen);
+  psTui->ucAttr = ucAttr;
+}
@@ -0,0 +1,73 @@
+/*!****************************************************************************
+ * @file
+ * tui.h
+ *
+ * @brief
+ * Diff-rendered VT100 text UI
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef TUI_H_
+#define TUI_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdint.h>
+#include "vt100.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Region width in cells
+#ifndef TUI_COLS
+#define TUI_COLS                      50u
+#endif
+
+/// Region height in cells
+#ifndef TUI_ROWS
+#define TUI_ROWS                      9u
+#endif
+
+/// Output staging buffer size
+#define TUI_OUT_SIZE                  64u
+
+/*! @brief Cell attributes
+ *  @{                                                                        */
+#define TUI_ATTR_NONE                 0x00u
+#define TUI_ATTR_BOLD                 0x01u
+#define TUI_ATTR_UNDERLINE            0x02u
+#define TUI_ATTR_INVERT               0x04u
+/// Foreground colour, VT100_FGCOL_BLACK to VT100_FGCOL_WHITE only
+#define TUI_ATTR_FG(col)              ((uint8_t)(((col) - VT100_FGCOL_BLACK + 1u) << 4))
+/*! @}                                                                        */
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Output function
+typedef void (*TUI_WriteTypeDef)(const char* pcBuf, uint32_t ulLen);
+
+/// Text UI region
+typedef struct {
+  uint16_t auiBack[TUI_ROWS][TUI_COLS];   ///< Cells being drawn (attr << 8 | char)
+  uint16_t auiFront[TUI_ROWS][TUI_COLS];  ///< Cells shown on the terminal
+  TUI_WriteTypeDef pfnWrite;              ///< Output function
+  char acOut[TUI_OUT_SIZE];               ///< Output staging buffer
+  uint32_t ulOutLen;                      ///< Bytes in staging buffer
+  uint32_t ulBytes;                       ///< Bytes emitted by last refresh
+  uint8_t ucRow;                          ///< Cursor row
+  uint8_t ucCol;                          ///< Cursor column, TUI_COLS if unknown
+  uint8_t ucAttr;                         ///< Terminal attributes
+} TUI_TypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vTUI_Init(TUI_TypeDef* psTui, TUI_WriteTypeDef pfnWrite);
+void vTUI_Clear(TUI_TypeDef* psTui);
+void vTUI_Invalidate(TUI_TypeDef* psTui);
+void vTUI_Puts(TUI_TypeDef* psTui, uint8_t ucRow, uint8_t ucCol, uint8_t ucAttr,
+               const char* pcStr);
+void vTUI_Printf(TUI_TypeDef* psTui, uint8_t ucRow, uint8_t ucCol, uint8_t ucAttr,
+                 const char* pcFmt, ...) __attribute__((format(printf, 5, 6)));
+uint32_t ulTUI_Refresh(TUI_TypeDef* psTui);
+void vTUI_Release(TUI_TypeDef* psTui);
+
+#endif // TUI_H_
@@ -0,0 +1,679 @@
+/*!****************************************************************************
+ * @file
+ * usbd.c
+ *
+ * @brief
+ * USB device control pipe with CDC-ACM function
+ *
+ * Implements the control transfer state machine on endpoint 0, the standard
+ * device requests of chapter 9 of the USB 2.0 specification and the class
+ * requests of a CDC-ACM function (virtual serial port) with the usual two
+ * interfaces: communication (notification endpoint) and data (bulk IN/OUT).
+ *
+ * The layer only sees endpoint 0. It is driven by four events from the
+ * hardware driver (bus reset, setup packet, OUT packet, IN packet sent) and
+ * answers through the driver callbacks; data endpoints are enabled and
+ * halted through the driver, their traffic bypasses this layer. Without a
+ * hardware dependency, the state machine runs on a host against recorded
+ * setup packets (tools/usbd_replay).
+ *
+ * Descriptors are constant, except for the device descriptor (IDs) and the
+ * string descriptors, which are converted from ASCII when requested.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+#include "usbd.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/*! @brief bmRequestType fields
+ *  @{                                                                        */
+#define USBD_REQ_DIR_IN               0x80u   ///< Device to host
+#define USBD_REQ_TYPE_MASK            0x60u
+#define USBD_REQ_TYPE_STANDARD        0x00u
+#define USBD_REQ_TYPE_CLASS           0x20u
+#define USBD_REQ_RCPT_MASK            0x1Fu
+#define USBD_REQ_RCPT_DEVICE          0x00u
+#define USBD_REQ_RCPT_INTERFACE       0x01u
+#define USBD_REQ_RCPT_ENDPOINT        0x02u
+/*! @}                                                                        */
+
+/*! @brief Standard requests
+ *  @{                                                                        */
+#define USBD_GET_STATUS               0x00u
+#define USBD_CLEAR_FEATURE            0x01u
+#define USBD_SET_FEATURE              0x03u
+#define USBD_SET_ADDRESS              0x05u
+#define USBD_GET_DESCRIPTOR           0x06u
+#define USBD_GET_CONFIGURATION        0x08u
+#define USBD_SET_CONFIGURATION        0x09u
+#define USBD_GET_INTERFACE            0x0Au
+#define USBD_SET_INTERFACE            0x0Bu
+/*! @}                                                                        */
+
+/*! @brief CDC class requests
+ *  @{                                                                        */
+#define USBD_CDC_SET_LINE_CODING      0x20u
+#define USBD_CDC_GET_LINE_CODING      0x21u
+#define USBD_CDC_SET_CONTROL_LINE     0x22u
+#define USBD_CDC_SEND_BREAK           0x23u
+/*! @}                                                                        */
+
+/*! @brief Descriptor types
+ *  @{                                                                        */
+#define USBD_DESC_DEVICE              0x01u
+#define USBD_DESC_CONFIG              0x02u
+#define USBD_DESC_STRING              0x03u
+#define USBD_DESC_INTERFACE           0x04u
+#define USBD_DESC_ENDPOINT            0x05u
+#define USBD_DESC_CS_INTERFACE        0x24u
+/*! @}                                                                        */
+
+/// Feature selector ENDPOINT_HALT
+#define USBD_FEATURE_EP_HALT          0x00u
+
+/// Line coding size on the wire
+#define USBD_LINE_CODING_SIZE         7u
+
+/// Interface numbers
+#define USBD_IF_COMM                  0u
+#define USBD_IF_DATA                  1u
+#define USBD_NUM_IF                   2u
+
+/// Low and high byte of a 16-bit value, for descriptors
+#define USBD_LE16(uiValue)            (uint8_t)((uiValue) & 0xFFu), (uint8_t)((uiValue) >> 8)
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Configuration descriptor with CDC-ACM function
+static const uint8_t aucConfig[] = {
+  // Configuration: 2 interfaces, bus powered, 100 mA
+  9u, USBD_DESC_CONFIG, USBD_LE16(67u), USBD_NUM_IF, 1u, 0u, 0x80u, 50u,
+
+  // Communication interface: CDC, ACM, no protocol
+  9u, USBD_DESC_INTERFACE, USBD_IF_COMM, 0u, 1u, 0x02u, 0x02u, 0x00u, 0u,
+  5u, USBD_DESC_CS_INTERFACE, 0x00u, USBD_LE16(0x0110u),      // Header, CDC 1.10
+  5u, USBD_DESC_CS_INTERFACE, 0x01u, 0x00u, USBD_IF_DATA,     // Call management
+  4u, USBD_DESC_CS_INTERFACE, 0x02u, 0x02u,                   // ACM: line coding, state
+  5u, USBD_DESC_CS_INTERFACE, 0x06u, USBD_IF_COMM, USBD_IF_DATA,  // Union
+  7u, USBD_DESC_ENDPOINT, USBD_EP_NOTIFY, 0x03u, USBD_LE16(USBD_NOTIFY_SIZE), 255u,
+
+  // Data interface: bulk OUT and IN
+  9u, USBD_DESC_INTERFACE, USBD_IF_DATA, 0u, 2u, 0x0Au, 0x00u, 0x00u, 0u,
+  7u, USBD_DESC_ENDPOINT, USBD_EP_DATA_OUT, 0x02u, USBD_LE16(USBD_DATA_SIZE), 0u,
+  7u, USBD_DESC_ENDPOINT, USBD_EP_DATA_IN, 0x02u, USBD_LE16(USBD_DATA_SIZE), 0u
+};
+
+_Static_assert(sizeof(aucConfig) == 67u, "wTotalLength does not match configuration descriptor");
+
+/// String descriptor 0: US English
+static const uint8_t aucLangIds[] = { 4u, USBD_DESC_STRING, USBD_LE16(0x0409u) };
+
+
+/*- Private functions --------------------------------------------------------*/
+static bool bUSBD_Standard(USBD_TypeDef* psDev, const uint8_t* pucSetup);
+static bool bUSBD_GetDescriptor(USBD_TypeDef* psDev, uint16_t uiValue, uint16_t uiLength);
+static bool bUSBD_Class(USBD_TypeDef* psDev, const uint8_t* pucSetup);
+static bool bUSBD_IsDataEndpoint(uint8_t ucEp);
+static void vUSBD_SendData(USBD_TypeDef* psDev, const uint8_t* pucData, uint32_t ulLen,
+                           uint16_t uiLength);
+static void vUSBD_SendPacket(USBD_TypeDef* psDev);
+static void vUSBD_SendStatus(USBD_TypeDef* psDev);
+static void vUSBD_Stall(USBD_TypeDef* psDev);
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialise device
+ *
+ * The line coding defaults to 115200 8N1 until set by the host.
+ *
+ * @param[out] *psDev   Device
+ * @param[in] *psDrv    Hardware driver
+ * @param[in] *psIdent  Identification, must stay valid
+ * @date  19.10.2026
+ ******************************************************************************/
+void vUSBD_Init(USBD_TypeDef* psDev, const USBD_DriverTypeDef* psDrv,
+                const USBD_IdentTypeDef* psIdent)
+{
+  (void)memset(psDev, 0, sizeof(*psDev));
+  psDev->psDrv = psDrv;
+  psDev->psIdent = psIdent;
+  psDev->sLineCoding.ulBaudRate = 115200uL;
+  psDev->sLineCoding.ucDataBits = 8u;
+
+  // Device: USB 2.0, class defined by interfaces of the CDC function
+  const uint8_t aucDevice[] = {
+    18u, USBD_DESC_DEVICE, USBD_LE16(0x0200u), 0x02u, 0x00u, 0x00u, USBD_EP0_SIZE,
+    USBD_LE16(psIdent->uiVendorId), USBD_LE16(psIdent->uiProductId), USBD_LE16(0x0100u),
+    1u, 2u, 3u, 1u
+  };
+  _Static_assert(sizeof(aucDevice) == sizeof(psDev->aucDevice), "device descriptor size");
+  (void)memcpy(psDev->aucDevice, aucDevice, sizeof(aucDevice));
+
+  vUSBD_Reset(psDev);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Bus reset: back to default state, address 0
+ *
+ * @param[in,out] *psDev  Device
+ * @date  19.10.2026
+ ******************************************************************************/
+void vUSBD_Reset(USBD_TypeDef* psDev)
+{
+  psDev->eState = USBD_STATE_DEFAULT;
+  psDev->eStage = USBD_STAGE_IDLE;
+  psDev->ucAddress = 0u;
+  psDev->ucConfig = 0u;
+  psDev->uiLines = 0u;
+  psDev->psDrv->pfnConfigure(false);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Setup packet received
+ *
+ * Aborts any control transfer in progress.
+ *
+ * @param[in,out] *psDev    Device
+ * @param[in] *pucSetup     Setup packet (USBD_SETUP_SIZE bytes)
+ * @date  19.10.2026
+ ******************************************************************************/
+void vUSBD_Setup(USBD_TypeDef* psDev, const uint8_t* pucSetup)
+{
+  psDev->eStage = USBD_STAGE_IDLE;
+  psDev->ucRequest = pucSetup[1];
+
+  bool bOk;
+  switch (pucSetup[0] & USBD_REQ_TYPE_MASK)
+  {
+    case USBD_REQ_TYPE_STANDARD:
+      bOk = bUSBD_Standard(psDev, pucSetup);
+      break;
+
+    case USBD_REQ_TYPE_CLASS:
+      bOk = bUSBD_Class(psDev, pucSetup);
+      break;
+
+    default:
+      bOk = false;
+      break;
+  }
+
+  if (!bOk) vUSBD_Stall(psDev);
+}
+
+/*!****************************************************************************
+ * @brief
+ * OUT packet received on EP0 (data or status stage)
+ *
+ * @param[in,out] *psDev  Device
+ * @param[in] *pucData    Packet data
+ * @param[in] ulLen       Packet length
+ * @date  19.10.2026
+ ******************************************************************************/
+void vUSBD_Ep0Out(USBD_TypeDef* psDev, const uint8_t* pucData, uint32_t ulLen)
+{
+  switch (psDev->eStage)
+  {
+    case USBD_STAGE_DATA_OUT:
+      if (psDev->ulRxLen + ulLen > psDev->ulRxExpected)
+      {
+        vUSBD_Stall(psDev);
+        return;
+      }
+      (void)memcpy(&psDev->aucBuf[psDev->ulRxLen], pucData, ulLen);
+      psDev->ulRxLen += ulLen;
+      if ((psDev->ulRxLen < psDev->ulRxExpected) && (ulLen == USBD_EP0_SIZE))
+      {
+        psDev->psDrv->pfnEp0Receive();
+        return;
+      }
+
+      // Data stage complete
+      if ((psDev->ucRequest == USBD_CDC_SET_LINE_CODING) &&
+          (psDev->ulRxLen == USBD_LINE_CODING_SIZE))
+      {
+        const uint8_t* pucLc = psDev->aucBuf;
+        psDev->sLineCoding.ulBaudRate = (uint32_t)pucLc[0] | ((uint32_t)pucLc[1] << 8) |
+                                        ((uint32_t)pucLc[2] << 16) | ((uint32_t)pucLc[3] << 24);
+        psDev->sLineCoding.ucStopBits = pucLc[4];
+        psDev->sLineCoding.ucParity = pucLc[5];
+        psDev->sLineCoding.ucDataBits = pucLc[6];
+        vUSBD_SendStatus(psDev);
+      }
+      else
+      {
+        vUSBD_Stall(psDev);
+      }
+      break;
+
+    case USBD_STAGE_DATA_IN:
+    case USBD_STAGE_STATUS_OUT:
+      // Status stage, the host may end an IN data stage early
+      psDev->eStage = USBD_STAGE_IDLE;
+      break;
+
+    default:
+      break;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * IN packet on EP0 sent (data or status stage)
+ *
+ * @param[in,out] *psDev  Device
+ * @date  19.10.2026
+ ******************************************************************************/
+void vUSBD_Ep0InDone(USBD_TypeDef* psDev)
+{
+  switch (psDev->eStage)
+  {
+    case USBD_STAGE_DATA_IN:
+      if ((psDev->ulTxLeft != 0uL) || psDev->bTxZlp)
+      {
+        vUSBD_SendPacket(psDev);
+      }
+      else
+      {
+        psDev->eStage = USBD_STAGE_STATUS_OUT;
+      }
+      break;
+
+    case USBD_STAGE_STATUS_IN:
+      // New address takes effect after the status stage
+      if (psDev->ucRequest == USBD_SET_ADDRESS)
+      {
+        psDev->psDrv->pfnSetAddress(psDev->ucAddress);
+        psDev->eState = (psDev->ucAddress != 0u) ? USBD_STATE_ADDRESS : USBD_STATE_DEFAULT;
+      }
+      psDev->eStage = USBD_STAGE_IDLE;
+      break;
+
+    default:
+      break;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if the device is configured
+ *
+ * @param[in] *psDev  Device
+ * @return  (bool)  Configuration 1 selected
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bUSBD_IsConfigured(const USBD_TypeDef* psDev)
+{
+  return psDev->eState == USBD_STATE_CONFIGURED;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get control line state set by the host
+ *
+ * @param[in] *psDev  Device
+ * @return  (uint16_t)  USBD_LINE_x bits
+ * @date  19.10.2026
+ ******************************************************************************/
+uint16_t uiUSBD_GetLines(const USBD_TypeDef* psDev)
+{
+  return psDev->uiLines;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get configuration descriptor
+ *
+ * @param[out] *pulLen  Descriptor length incl. interfaces and endpoints
+ * @return  (const uint8_t*)  Descriptor
+ * @date  19.10.2026
+ ******************************************************************************/
+const uint8_t* pucUSBD_GetConfigDescriptor(uint32_t* pulLen)
+{
+  *pulLen = sizeof(aucConfig);
+  return aucConfig;
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Handle standard request
+ *
+ * @param[in,out] *psDev    Device
+ * @param[in] *pucSetup     Setup packet
+ * @return  (bool)  Request accepted
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bUSBD_Standard(USBD_TypeDef* psDev, const uint8_t* pucSetup)
+{
+  const USBD_DriverTypeDef* psDrv = psDev->psDrv;
+  uint8_t ucRcpt = pucSetup[0] & USBD_REQ_RCPT_MASK;
+  bool bIn = (pucSetup[0] & USBD_REQ_DIR_IN) != 0u;
+  uint16_t uiValue = (uint16_t)(pucSetup[2] | (pucSetup[3] << 8));
+  uint16_t uiIndex = (uint16_t)(pucSetup[4] | (pucSetup[5] << 8));
+  uint16_t uiLength = (uint16_t)(pucSetup[6] | (pucSetup[7] << 8));
+  bool bConfigured = (psDev->eState == USBD_STATE_CONFIGURED);
+  uint8_t ucEp = (uint8_t)uiIndex;
+
+  switch (pucSetup[1])
+  {
+    case USBD_GET_DESCRIPTOR:
+      return bIn && (ucRcpt == USBD_REQ_RCPT_DEVICE) &&
+             bUSBD_GetDescriptor(psDev, uiValue, uiLength);
+
+    case USBD_SET_ADDRESS:
+      if (bIn || (ucRcpt != USBD_REQ_RCPT_DEVICE) || (uiValue > 127u) || bConfigured) return false;
+      psDev->ucAddress = (uint8_t)uiValue;
+      vUSBD_SendStatus(psDev);
+      return true;
+
+    case USBD_GET_CONFIGURATION:
+      if (!bIn || (ucRcpt != USBD_REQ_RCPT_DEVICE)) return false;
+      psDev->aucBuf[0] = psDev->ucConfig;
+      vUSBD_SendData(psDev, psDev->aucBuf, 1uL, uiLength);
+      return true;
+
+    case USBD_SET_CONFIGURATION:
+      if (bIn || (ucRcpt != USBD_REQ_RCPT_DEVICE) || (uiValue > 1u) ||
+          (psDev->eState == USBD_STATE_DEFAULT))
+      {
+        return false;
+      }
+      // Re-selecting the configuration resets the data endpoints
+      psDrv->pfnConfigure(false);
+      psDev->ucConfig = (uint8_t)uiValue;
+      psDev->uiLines = 0u;
+      psDev->eState = (uiValue != 0u) ? USBD_STATE_CONFIGURED : USBD_STATE_ADDRESS;
+      if (uiValue != 0u) psDrv->pfnConfigure(true);
+      vUSBD_SendStatus(psDev);
+      return true;
+
+    case USBD_GET_STATUS:
+      if (!bIn) return false;
+      psDev->aucBuf[0] = 0u;
+      psDev->aucBuf[1] = 0u;
+      if (ucRcpt == USBD_REQ_RCPT_ENDPOINT)
+      {
+        if (bUSBD_IsDataEndpoint(ucEp))
+        {
+          if (!bConfigured) return false;
+          psDev->aucBuf[0] = psDrv->pfnIsHalted(ucEp) ? 1u : 0u;
+        }
+        else if ((ucEp & 0x7Fu) != 0u)
+        {
+          return false;
+        }
+      }
+      else if (ucRcpt == USBD_REQ_RCPT_INTERFACE)
+      {
+        if (!bConfigured || (uiIndex >= USBD_NUM_IF)) return false;
+      }
+      else if (ucRcpt != USBD_REQ_RCPT_DEVICE)
+      {
+        return false;
+      }
+      vUSBD_SendData(psDev, psDev->aucBuf, 2uL, uiLength);
+      return true;
+
+    case USBD_CLEAR_FEATURE:
+    case USBD_SET_FEATURE:
+      // Only endpoint halt; remote wakeup and test mode are not supported
+      if (bIn || (ucRcpt != USBD_REQ_RCPT_ENDPOINT) || (uiValue != USBD_FEATURE_EP_HALT))
+      {
+        return false;
+      }
+      if (bUSBD_IsDataEndpoint(ucEp))
+      {
+        if (!bConfigured) return false;
+        psDrv->pfnSetHalt(ucEp, pucSetup[1] == USBD_SET_FEATURE);
+      }
+      else if ((ucEp & 0x7Fu) != 0u)
+      {
+        return false;
+      }
+      vUSBD_SendStatus(psDev);
+      return true;
+
+    case USBD_GET_INTERFACE:
+      if (!bIn || (ucRcpt != USBD_REQ_RCPT_INTERFACE) || !bConfigured ||
+          (uiIndex >= USBD_NUM_IF))
+      {
+        return false;
+      }
+      psDev->aucBuf[0] = 0u;
+      vUSBD_SendData(psDev, psDev->aucBuf, 1uL, uiLength);
+      return true;
+
+    case USBD_SET_INTERFACE:
+      // Alternate setting 0 only
+      if (bIn || (ucRcpt != USBD_REQ_RCPT_INTERFACE) || !bConfigured ||
+          (uiIndex >= USBD_NUM_IF) || (uiValue != 0u))
+      {
+        return false;
+      }
+      vUSBD_SendStatus(psDev);
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Handle GET_DESCRIPTOR
+ *
+ * Device qualifier and other-speed descriptors are rejected (full-speed only
+ * device), which makes the host skip them.
+ *
+ * @param[in,out] *psDev  Device
+ * @param[in] uiValue     Descriptor type (high byte) and index (low byte)
+ * @param[in] uiLength    Requested length
+ * @return  (bool)  Descriptor exists
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bUSBD_GetDescriptor(USBD_TypeDef* psDev, uint16_t uiValue, uint16_t uiLength)
+{
+  uint8_t ucIndex = (uint8_t)uiValue;
+
+  switch (uiValue >> 8)
+  {
+    case USBD_DESC_DEVICE:
+      vUSBD_SendData(psDev, psDev->aucDevice, sizeof(psDev->aucDevice), uiLength);
+      return true;
+
+    case USBD_DESC_CONFIG:
+      if (ucIndex != 0u) return false;
+      vUSBD_SendData(psDev, aucConfig, sizeof(aucConfig), uiLength);
+      return true;
+
+    case USBD_DESC_STRING:
+    {
+      if (ucIndex == 0u)
+      {
+        vUSBD_SendData(psDev, aucLangIds, sizeof(aucLangIds), uiLength);
+        return true;
+      }
+
+      const USBD_IdentTypeDef* psIdent = psDev->psIdent;
+      const char* pcText = (ucIndex == 1u) ? psIdent->pcManufacturer :
+                           (ucIndex == 2u) ? psIdent->pcProduct :
+                           (ucIndex == 3u) ? psIdent->pcSerial : NULL;
+      if (pcText == NULL) return false;
+
+      // ASCII to UTF-16LE
+      uint32_t ulChars = 0uL;
+      while ((pcText[ulChars] != '\0') && (ulChars < USBD_STRING_MAX))
+      {
+        psDev->aucBuf[2u + 2u * ulChars] = (uint8_t)pcText[ulChars];
+        psDev->aucBuf[3u + 2u * ulChars] = 0u;
+        ulChars++;
+      }
+      psDev->aucBuf[0] = (uint8_t)(2u + 2u * ulChars);
+      psDev->aucBuf[1] = USBD_DESC_STRING;
+      vUSBD_SendData(psDev, psDev->aucBuf, psDev->aucBuf[0], uiLength);
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Handle CDC class request to the communication interface
+ *
+ * @param[in,out] *psDev    Device
+ * @param[in] *pucSetup     Setup packet
+ * @return  (bool)  Request accepted
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bUSBD_Class(USBD_TypeDef* psDev, const uint8_t* pucSetup)
+{
+  uint16_t uiValue = (uint16_t)(pucSetup[2] | (pucSetup[3] << 8));
+  uint16_t uiIndex = (uint16_t)(pucSetup[4] | (pucSetup[5] << 8));
+  uint16_t uiLength = (uint16_t)(pucSetup[6] | (pucSetup[7] << 8));
+  bool bIn = (pucSetup[0] & USBD_REQ_DIR_IN) != 0u;
+
+  if (((pucSetup[0] & USBD_REQ_RCPT_MASK) != USBD_REQ_RCPT_INTERFACE) ||
+      (uiIndex != USBD_IF_COMM) || (psDev->eState != USBD_STATE_CONFIGURED))
+  {
+    return false;
+  }
+
+  switch (pucSetup[1])
+  {
+    case USBD_CDC_SET_LINE_CODING:
+      if (bIn || (uiLength != USBD_LINE_CODING_SIZE)) return false;
+      psDev->ulRxLen = 0uL;
+      psDev->ulRxExpected = uiLength;
+      psDev->eStage = USBD_STAGE_DATA_OUT;
+      psDev->psDrv->pfnEp0Receive();
+      return true;
+
+    case USBD_CDC_GET_LINE_CODING:
+    {
+      if (!bIn) return false;
+      const USBD_LineCodingTypeDef* psLc = &psDev->sLineCoding;
+      uint8_t* pucLc = psDev->aucBuf;
+      pucLc[0] = (uint8_t)psLc->ulBaudRate;
+      pucLc[1] = (uint8_t)(psLc->ulBaudRate >> 8);
+      pucLc[2] = (uint8_t)(psLc->ulBaudRate >> 16);
+      pucLc[3] = (uint8_t)(psLc->ulBaudRate >> 24);
+      pucLc[4] = psLc->ucStopBits;
+      pucLc[5] = psLc->ucParity;
+      pucLc[6] = psLc->ucDataBits;
+      vUSBD_SendData(psDev, pucLc, USBD_LINE_CODING_SIZE, uiLength);
+      return true;
+    }
+
+    case USBD_CDC_SET_CONTROL_LINE:
+      if (bIn) return false;
+      psDev->uiLines = uiValue & (USBD_LINE_DTR | USBD_LINE_RTS);
+      vUSBD_SendStatus(psDev);
+      return true;
+
+    case USBD_CDC_SEND_BREAK:
+      // Accepted, there is no line to break
+      if (bIn) return false;
+      vUSBD_SendStatus(psDev);
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if an endpoint address belongs to the CDC function
+ *
+ * @param[in] ucEp  Endpoint address
+ * @return  (bool)  Data or notification endpoint
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bUSBD_IsDataEndpoint(uint8_t ucEp)
+{
+  return (ucEp == USBD_EP_DATA_OUT) || (ucEp == USBD_EP_DATA_IN) || (ucEp == USBD_EP_NOTIFY);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start IN data stage
+ *
+ * Sends at most uiLength bytes. A reply shorter than requested that ends on
+ * a packet boundary is terminated by a zero-length packet.
+ *
+ * @param[in,out] *psDev  Device
+ * @param[in] *pucData    Data, must stay valid until sent
+ * @param[in] ulLen       Data length
+ * @param[in] uiLength    Length requested by the host
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vUSBD_SendData(USBD_TypeDef* psDev, const uint8_t* pucData, uint32_t ulLen,
+                           uint16_t uiLength)
+{
+  if (ulLen > uiLength) ulLen = uiLength;
+  psDev->pucTx = pucData;
+  psDev->ulTxLeft = ulLen;
+  psDev->bTxZlp = (ulLen < uiLength) && ((ulLen % USBD_EP0_SIZE) == 0uL);
+  psDev->eStage = USBD_STAGE_DATA_IN;
+
+  // Accept an early status stage from the host
+  psDev->psDrv->pfnEp0Receive();
+  vUSBD_SendPacket(psDev);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Send next IN data packet
+ *
+ * @param[in,out] *psDev  Device
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vUSBD_SendPacket(USBD_TypeDef* psDev)
+{
+  uint32_t ulLen = (psDev->ulTxLeft > USBD_EP0_SIZE) ? USBD_EP0_SIZE : psDev->ulTxLeft;
+  if (ulLen == 0uL) psDev->bTxZlp = false;
+
+  psDev->psDrv->pfnEp0Send(psDev->pucTx, ulLen);
+  psDev->pucTx += ulLen;
+  psDev->ulTxLeft -= ulLen;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start IN status stage (zero-length packet)
+ *
+ * @param[in,out] *psDev  Device
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vUSBD_SendStatus(USBD_TypeDef* psDev)
+{
+  psDev->eStage = USBD_STAGE_STATUS_IN;
+  psDev->psDrv->pfnEp0Send(NULL, 0uL);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Reject request
+ *
+ * @param[in,out] *psDev  Device
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vUSBD_Stall(USBD_TypeDef* psDev)
+{
+  psDev->eStage = USBD_STAGE_STALLED;
+  psDev->psDrv->pfnEp0Stall();
+}
@@ -0,0 +1,134 @@
+/*!****************************************************************************
+ * @file
+ * usbd.h
+ *
+ * @brief
+ * USB device control pipe with CDC-ACM function
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef USBD_H_
+#define USBD_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Control endpoint packet size
+#define USBD_EP0_SIZE                 64u
+
+/// Setup packet size
+#define USBD_SETUP_SIZE               8u
+
+/*! @brief CDC-ACM endpoints
+ *  @{                                                                        */
+#define USBD_EP_DATA_OUT              0x01u   ///< Bulk OUT, host to device
+#define USBD_EP_DATA_IN               0x81u   ///< Bulk IN, device to host
+#define USBD_EP_NOTIFY                0x82u   ///< Interrupt IN, serial state (unused)
+#define USBD_DATA_SIZE                64u     ///< Bulk packet size
+#define USBD_NOTIFY_SIZE              8u      ///< Interrupt packet size
+/*! @}                                                                        */
+
+/*! @brief CDC control line state bits
+ *  @{                                                                        */
+#define USBD_LINE_DTR                 0x0001u ///< Data terminal ready (port open)
+#define USBD_LINE_RTS                 0x0002u ///< Request to send
+/*! @}                                                                        */
+
+/// Longest string descriptor text in characters
+#define USBD_STRING_MAX               ((USBD_EP0_SIZE - 2u) / 2u)
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Device state
+typedef enum {
+  USBD_STATE_DEFAULT = 0,         ///< After bus reset
+  USBD_STATE_ADDRESS,             ///< Address assigned
+  USBD_STATE_CONFIGURED           ///< Configuration 1 selected
+} USBD_StateTypeDef;
+
+/// Control transfer stage
+typedef enum {
+  USBD_STAGE_IDLE = 0,            ///< Waiting for setup
+  USBD_STAGE_DATA_IN,             ///< Sending data packets
+  USBD_STAGE_DATA_OUT,            ///< Receiving data packets
+  USBD_STAGE_STATUS_IN,           ///< Sending zero-length status
+  USBD_STAGE_STATUS_OUT,          ///< Waiting for zero-length status
+  USBD_STAGE_STALLED              ///< Request rejected
+} USBD_StageTypeDef;
+
+/// CDC line coding (as transferred, little endian)
+typedef struct {
+  uint32_t ulBaudRate;            ///< Data terminal rate in bit/s
+  uint8_t ucStopBits;             ///< 0: 1, 1: 1.5, 2: 2 stop bits
+  uint8_t ucParity;               ///< 0: none, 1: odd, 2: even, 3: mark, 4: space
+  uint8_t ucDataBits;             ///< 5, 6, 7, 8 or 16
+} USBD_LineCodingTypeDef;
+
+/// Hardware driver, called from the event functions' context
+typedef struct {
+  /// Send one packet on EP0 IN (ulLen 0: zero-length packet)
+  void (*pfnEp0Send)(const uint8_t* pucData, uint32_t ulLen);
+  /// Accept one packet on EP0 OUT
+  void (*pfnEp0Receive)(void);
+  /// Stall EP0 in both directions until the next setup packet
+  void (*pfnEp0Stall)(void);
+  /// Apply device address
+  void (*pfnSetAddress)(uint8_t ucAddr);
+  /// Enable (true) or disable the CDC endpoints
+  void (*pfnConfigure)(bool bEnable);
+  /// Set or clear halt of a CDC endpoint
+  void (*pfnSetHalt)(uint8_t ucEp, bool bHalt);
+  /// Get halt state of a CDC endpoint
+  bool (*pfnIsHalted)(uint8_t ucEp);
+} USBD_DriverTypeDef;
+
+/// Device identification
+typedef struct {
+  uint16_t uiVendorId;            ///< idVendor
+  uint16_t uiProductId;           ///< idProduct
+  const char* pcManufacturer;     ///< Manufacturer string (ASCII)
+  const char* pcProduct;          ///< Product string (ASCII)
+  const char* pcSerial;           ///< Serial number string (ASCII)
+} USBD_IdentTypeDef;
+
+/// Device instance
+typedef struct {
+  const USBD_DriverTypeDef* psDrv;              ///< Hardware driver
+  const USBD_IdentTypeDef* psIdent;             ///< Identification
+  USBD_StateTypeDef eState;                     ///< Device state
+  USBD_StageTypeDef eStage;                     ///< Control transfer stage
+  uint8_t ucAddress;                            ///< Assigned address, applied after status
+  uint8_t ucConfig;                             ///< Selected configuration
+  uint8_t ucRequest;                            ///< Request of the current transfer
+  const uint8_t* pucTx;                         ///< Remaining IN data
+  uint32_t ulTxLeft;                            ///< Remaining IN bytes
+  bool bTxZlp;                                  ///< Terminate IN data with zero-length packet
+  uint32_t ulRxLen;                             ///< OUT bytes received
+  uint32_t ulRxExpected;                        ///< OUT bytes expected
+  uint8_t aucBuf[USBD_EP0_SIZE];                ///< Reply and OUT data buffer
+  uint8_t aucDevice[18];                        ///< Device descriptor
+  USBD_LineCodingTypeDef sLineCoding;           ///< Current line coding
+  uint16_t uiLines;                             ///< Control line state USBD_LINE_x
+} USBD_TypeDef;
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vUSBD_Init(USBD_TypeDef* psDev, const USBD_DriverTypeDef* psDrv,
+                const USBD_IdentTypeDef* psIdent);
+
+// Events from the hardware driver
+void vUSBD_Reset(USBD_TypeDef* psDev);
+void vUSBD_Setup(USBD_TypeDef* psDev, const uint8_t* pucSetup);
+void vUSBD_Ep0Out(USBD_TypeDef* psDev, const uint8_t* pucData, uint32_t ulLen);
+void vUSBD_Ep0InDone(USBD_TypeDef* psDev);
+
+// State
+bool bUSBD_IsConfigured(const USBD_TypeDef* psDev);
+uint16_t uiUSBD_GetLines(const USBD_TypeDef* psDev);
+const uint8_t* pucUSBD_GetConfigDescriptor(uint32_t* pulLen);
+
+#endif // USBD_H_
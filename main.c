@@ -6,45 +6,286 @@
  * Main program
  *
  * @date  19.10.2025
+ * @date  19.10.2026  Added live dashboard
+ * @date  19.10.2026  Added boot counter in non-volatile storage
+ * @date  19.10.2026  Added flight recorder events and fault dump
+ * @date  19.10.2026  Added image CRC self-check result
+ * @date  19.10.2026  Dashboard and background loop run as kernel threads
+ * @date  19.10.2026  LED blinky and core info printing as coroutines
+ * @date  19.10.2026  Dashboard redraw marked as timeline region
+ * @date  19.10.2026  Print hardware bring-up duration
+ * @date  19.10.2026  SPI NOR log status, dump on console key
+ * @date  19.10.2026  Command shell on debug console input
+ * @date  19.10.2026  Shell command to enter the serial bootloader
+ * @date  19.10.2026  Shell command to scan the sensor I2C bus
+ * @date  19.10.2026  Shell command to measure the capture input
+ * @date  19.10.2026  Shell command to play a 3-phase sine on the sequencer
  ******************************************************************************/
 
 /*- Header files -------------------------------------------------------------*/
+#include <stdarg.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
 #include "vt100.h"
+#include "coro.h"
+#include "fixmath.h"
 #include "hw_layer.h"
+#include "shell.h"
+#include "tui.h"
 
 
 /*- Macros -------------------------------------------------------------------*/
-/// LED toggle interval in milliseconds
+/// LED toggle interval in milliseconds (default, "set led")
 #define LED_TOGGLE_INTERVAL         500uL
 
+/// Longest console line in characters (awaited as SWO transmit space)
+#define CONSOLE_LINE_MAX            64u
 
-/*- Private data -------------------------------------------------------------*/
-/// Last time the LED was toggled
-static uint32_t ulLastToggle;
+/// Dashboard refresh interval in milliseconds (default, "set dash")
+#define DASH_REFRESH_INTERVAL       250uL
+
+/// Thread stack sizes in words (loop thread runs shell commands)
+#define DASH_STACK_WORDS            256u
+#define LOOP_STACK_WORDS            256u
+
+/*! @brief Thread priorities
+ *  @{                                                                        */
+#define LOOP_PRIORITY               0u
+#define DASH_PRIORITY               1u
+/*! @}                                                                        */
+
+/// Non-volatile storage key of boot counter (uint32_t)
+#define NVM_KEY_BOOT_COUNT          0x0001u
+
+/*! @brief Flight recorder event IDs
+ *  @{                                                                        */
+#define FLIGHT_EVT_BOOT             0x0001u   ///< Boot, arg: boot count
+#define FLIGHT_EVT_LED              0x0002u   ///< LED toggled
+#define FLIGHT_EVT_DASH             0x0003u   ///< Dashboard refreshed, arg: bytes sent
+/*! @}                                                                        */
+
+/*! @brief Levels of application messages (SPI NOR log only)
+ *  @{                                                                        */
+#define LOG_LEVEL_OFF               0u
+#define LOG_LEVEL_ERROR             1u
+#define LOG_LEVEL_WARN              2u
+#define LOG_LEVEL_INFO              3u
+#define LOG_LEVEL_DEBUG             4u
+/*! @}                                                                        */
+
+/// Initial level of application messages
+#define LOG_LEVEL_DEFAULT           LOG_LEVEL_INFO
+
+/*! @brief Runs per kernel of "bench" command
+ *  @{                                                                        */
+#define BENCH_RUNS_DEFAULT          16uL
+#define BENCH_RUNS_MAX              1000uL
+/*! @}                                                                        */
+
+/// Input size of "bench" CRC kernel in bytes
+#define BENCH_CRC_SIZE              256u
+
+/*! @brief Address range probed by "i2c" (without reserved addresses)
+ *  @{                                                                        */
+#define I2C_SCAN_FIRST              0x08u
+#define I2C_SCAN_LAST               0x77u
+/*! @}                                                                        */
+
+/*! @brief Gate time of "capture" command in milliseconds
+ *  @{                                                                        */
+#define CAPTURE_GATE_DEFAULT        1000uL
+#define CAPTURE_GATE_MAX            60000uL
+/*! @}                                                                        */
+
+/// Polling interval of "capture" in milliseconds (edge buffer lasts 2.5 ms at 50 kHz)
+#define CAPTURE_POLL                1uL
+
+/*! @brief Sine table of "wave": samples per sine period, phases (PWM channels)
+ *  @{                                                                        */
+#define WAVE_SAMPLES                64u
+#define WAVE_PHASES                 3u
+/*! @}                                                                        */
+
+/// Default sample rate of "wave" in Hz (sine at 100 Hz)
+#define WAVE_RATE_DEFAULT           6400uL
+
+/// Timeline region ID of dashboard redraw
+#define TRACE_REGION_DASH           0x0001u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Statistics since boot or "reset" command
+typedef struct {
+  uint32_t ulStart;               ///< System time of reset in ms
+  uint32_t ulLoops;               ///< Background loop iterations at reset
+  uint32_t ulRedraws;             ///< Dashboard redraws
+  uint32_t ulRedrawMin;           ///< Shortest redraw in cycles
+  uint32_t ulRedrawMax;           ///< Longest redraw in cycles
+  uint64_t ullRedrawSum;          ///< Sum of redraw cycles
+  uint32_t ulToggles;             ///< LED toggles
+  uint32_t ulCommands;            ///< Shell commands executed
+} AppStatsTypeDef;
+
+/// Parameter adjustable with "set"
+typedef struct {
+  const char* pcName;             ///< Name
+  const char* pcUnit;             ///< Unit
+  uint32_t* pulValue;             ///< Current value
+  uint32_t ulMin;                 ///< Smallest value
+  uint32_t ulMax;                 ///< Largest value
+  void (*pfnApply)(void);         ///< Called after change, or NULL
+} AppParamTypeDef;
+
+/// Kernel timed by "bench"
+typedef struct {
+  const char* pcName;             ///< Name
+  void (*pfnRun)(void);           ///< Kernel
+} AppKernelTypeDef;
 
 
 /*- Private functions --------------------------------------------------------*/
-static void vPrintCoreInfo(void);
+static CORO_StatusTypeDef eBlinkLed(CORO_TypeDef* psCo);
+static void vDashTick(HW_CLK_TimerTypeDef* psTimer);
+static void vDashThread(void* pvArg);
+static void vLoopThread(void* pvArg);
+static void vDashWrite(const char* pcBuf, uint32_t ulLen);
+static void vDashUpdate(uint32_t ulLoopRate);
+static CORO_StatusTypeDef ePrintCoreInfo(CORO_TypeDef* psCo);
 static void vPrintSysCoreClk(void);
 static void vPrintEsigInfo(void);
+static void vPrintImageCheck(void);
+static void vPrintBootCount(void);
+static void vPrintLogInfo(void);
+static void vPrintFaultDump(void);
+static void vLog(uint32_t ulLevel, const char* pcFmt, ...) __attribute__((format(printf, 2, 3)));
+static void vStatsReset(void);
+static void vApplyDashInterval(void);
+static bool bCmdHelp(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[]);
+static bool bCmdStats(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[]);
+static bool bCmdReset(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[]);
+static bool bCmdLog(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[]);
+static bool bCmdSet(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[]);
+static bool bCmdBench(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[]);
+static bool bCmdDump(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[]);
+static bool bCmdUpdate(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[]);
+static bool bCmdI2c(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[]);
+static bool bCmdCapture(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[]);
+static bool bCmdWave(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[]);
+static void vBenchCrc(void);
+static void vBenchFormat(void);
+static void vBenchSin(void);
+static void vBenchSqrt(void);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// LED blinky coroutine
+static CORO_TypeDef sLedCoro;
+
+/// Dashboard refresh timer
+static HW_CLK_TimerTypeDef sDashTimer;
+
+/// Dashboard refresh is due
+static HW_OS_SemTypeDef sDashDue;
+
+/// Threads
+static HW_OS_ThreadTypeDef sDashThread;
+static HW_OS_ThreadTypeDef sLoopThread;
+static uint32_t aulDashStack[DASH_STACK_WORDS];
+static uint32_t aulLoopStack[LOOP_STACK_WORDS];
+
+/// Background loop iterations and their rate per second
+static volatile uint32_t ulLoops;
+static volatile uint32_t ulLoopsPerSec;
+
+/// Live dashboard region
+static TUI_TypeDef sDash;
+
+/// Console (dashboard or shell output) owner
+static HW_OS_MutexTypeDef sConsole;
+
+/// Command shell on debug console input
+static SHELL_TypeDef sShell;
+
+/// Statistics, changed with console owned after kernel start
+static AppStatsTypeDef sAppStats;
+
+/// Runtime parameters
+static uint32_t ulLedInterval = LED_TOGGLE_INTERVAL;
+static uint32_t ulDashInterval = DASH_REFRESH_INTERVAL;
+static uint32_t ulLogLevel = LOG_LEVEL_DEFAULT;
+
+/// Names of log levels, indexed by level
+static const char* const apcLogLevels[] = { "off", "error", "warn", "info", "debug" };
+
+/// Input of "bench" CRC kernel
+static uint8_t aucBenchBuf[BENCH_CRC_SIZE];
+
+/// Result sink of "bench" kernels
+static volatile uint32_t ulBenchSink;
+
+/// Address probes of "i2c"
+static I2CQ_XferTypeDef asI2cProbes[I2C_SCAN_LAST - I2C_SCAN_FIRST + 1u];
+
+/// Compare values of "wave", one sample per row
+static uint16_t auiWave[WAVE_SAMPLES * WAVE_PHASES];
+
+/// Endless table of "wave"
+static const SEQ_TableTypeDef sWaveTable = {
+  .pvData = auiWave,
+  .ulSamples = WAVE_SAMPLES,
+  .ulPasses = 0uL,
+  .psNext = NULL
+};
+
+/// Shell commands
+static const SHELL_CmdTypeDef asCmds[] = {
+  { .pcName = "help",    .pcArgs = NULL,           .pcHelp = "List commands",          .pfnRun = bCmdHelp },
+  { .pcName = "stats",   .pcArgs = NULL,           .pcHelp = "Show counters",          .pfnRun = bCmdStats },
+  { .pcName = "reset",   .pcArgs = NULL,           .pcHelp = "Reset statistics",       .pfnRun = bCmdReset },
+  { .pcName = "log",     .pcArgs = "[level]",      .pcHelp = "Show/set log level",     .pfnRun = bCmdLog },
+  { .pcName = "set",     .pcArgs = "[name value]", .pcHelp = "Show/change parameters", .pfnRun = bCmdSet },
+  { .pcName = "bench",   .pcArgs = "[runs]",       .pcHelp = "Time kernels in cycles", .pfnRun = bCmdBench },
+  { .pcName = "dump",    .pcArgs = NULL,           .pcHelp = "Send log to probe",      .pfnRun = bCmdDump },
+  { .pcName = "update",  .pcArgs = NULL,           .pcHelp = "Reset into bootloader",  .pfnRun = bCmdUpdate },
+  { .pcName = "i2c",     .pcArgs = NULL,           .pcHelp = "Scan sensor bus",        .pfnRun = bCmdI2c },
+  { .pcName = "capture", .pcArgs = "[ms]",         .pcHelp = "Measure capture input",  .pfnRun = bCmdCapture },
+  { .pcName = "wave",    .pcArgs = "[rate|off]",   .pcHelp = "Play 3-phase PWM sine",  .pfnRun = bCmdWave }
+};
+
+/// Runtime parameters
+static const AppParamTypeDef asParams[] = {
+  { .pcName = "led",     .pcUnit = "ms", .pulValue = &ulLedInterval,  .ulMin = 10uL, .ulMax = 10000uL },
+  { .pcName = "dash",    .pcUnit = "ms", .pulValue = &ulDashInterval, .ulMin = 50uL, .ulMax = 10000uL,
+    .pfnApply = vApplyDashInterval }
+};
+
+/// Kernels timed by "bench"
+static const AppKernelTypeDef asKernels[] = {
+  { .pcName = "crc32",   .pfnRun = vBenchCrc },
+  { .pcName = "snprintf", .pfnRun = vBenchFormat },
+  { .pcName = "sin_q31", .pfnRun = vBenchSin },
+  { .pcName = "sqrt_q31", .pfnRun = vBenchSqrt }
+};
 
 
 /*- Public interface ---------------------------------------------------------*/
 /*!****************************************************************************
  * @brief
- * Main program entrypoint and background task
+ * Main program entrypoint
  *
  * @date  19.10.2025
+ * @date  19.10.2026
  ******************************************************************************/
 int main(void)
 {
   // Initialise hardware layer
   vHW_Init();
 
-  // Initialise LED blinky
-  ulLastToggle = ulHW_GetTime();
+  // Console output is queued for SWO, drained while waiting
+  vHW_SetSwoBuffered(true);
+  (void)setvbuf(stdout, NULL, _IONBF, 0u);
+  CORO_INIT(&sLedCoro);
 
   // Display MCU info via SWO
   printf(
@@ -64,62 +305,271 @@ int main(void)
     VT100_NO_INVERT
     "\r\n"
   );
-  vPrintCoreInfo();
+
+  // Print cooperatively, LED keeps blinking
+  CORO_TypeDef sInfoCoro;
+  CORO_INIT(&sInfoCoro);
+  while (ePrintCoreInfo(&sInfoCoro) != CORO_EXITED)
+  {
+    (void)eBlinkLed(&sLedCoro);
+    vHW_PollSwo();
+  }
   printf("\r\n");
   vPrintSysCoreClk();
   printf("\r\n");
   vPrintEsigInfo();
+  printf("\r\n");
+  vPrintImageCheck();
+  printf("\r\n");
+  vPrintBootCount();
+  printf("\r\n");
+  vPrintLogInfo();
+  printf("\r\n");
+  vPrintFaultDump();
 
-  // LED blinky in background task
+  // Live dashboard below static information, shell output replaces it
+  vTUI_Init(&sDash, vDashWrite);
+  vSHELL_Init(&sShell, asCmds, sizeof(asCmds) / sizeof(asCmds[0]), vDashWrite);
+  vStatsReset();
+  vHW_OsInit();
+  vHW_MutexInit(&sConsole);
+  vHW_SemInit(&sDashDue, 0uL, 1uL);
+  (void)bHW_ThreadCreate(&sDashThread, "dash", vDashThread, NULL,
+                         aulDashStack, sizeof(aulDashStack), DASH_PRIORITY);
+  (void)bHW_ThreadCreate(&sLoopThread, "loop", vLoopThread, NULL,
+                         aulLoopStack, sizeof(aulLoopStack), LOOP_PRIORITY);
+  vHW_TimerInit(&sDashTimer, vDashTick, NULL);
+  vHW_TimerStart(&sDashTimer, ulDashInterval, ulDashInterval);
+
+  // Run threads, does not return
+  vHW_OsStart();
   while (1)
   {
-    uint32_t ulNow = ulHW_GetTime();
-    if (ulNow - ulLastToggle > LED_TOGGLE_INTERVAL)
+  }
+}
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * LED blinky coroutine
+ *
+ * @param[in,out] *psCo   Coroutine state
+ * @return  (CORO_StatusTypeDef)  Coroutine status
+ * @date  19.10.2026
+ * @date  19.10.2026
+ ******************************************************************************/
+static CORO_StatusTypeDef eBlinkLed(CORO_TypeDef* psCo)
+{
+  CORO_BEGIN(psCo);
+  while (1)
+  {
+    CORO_AWAIT_TIME(psCo, ulHW_GetTime(), ulLedInterval);
+    vHW_ToggleLed();
+    vHW_Record(FLIGHT_EVT_LED, 0u);
+    sAppStats.ulToggles++;
+    vLog(LOG_LEVEL_DEBUG, "LED toggled");
+  }
+  CORO_END(psCo);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Dashboard refresh timer callback
+ *
+ * @param[in] *psTimer  Expired timer
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vDashTick(HW_CLK_TimerTypeDef* psTimer)
+{
+  (void)psTimer;
+  (void)bHW_SemGive(&sDashDue);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Dashboard thread: redraw on every refresh tick
+ *
+ * Skips the redraw while a shell command owns the console.
+ *
+ * @param[in] *pvArg  Unused
+ * @date  19.10.2026
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vDashThread(void* pvArg)
+{
+  (void)pvArg;
+  uint32_t ulRateStart = ulHW_GetTime();
+  uint32_t ulRateLoops = ulLoops;
+  while (1)
+  {
+    (void)bHW_SemTake(&sDashDue, HW_OS_WAIT_FOREVER);
+
+    uint32_t ulElapsed = ulHW_GetTime() - ulRateStart;
+    if (ulElapsed >= 1000uL)
     {
-      vHW_ToggleLed();
-      ulLastToggle = ulNow;
+      uint32_t ulNow = ulLoops;
+      ulLoopsPerSec = (uint32_t)(((uint64_t)(ulNow - ulRateLoops) * 1000uL) / ulElapsed);
+      ulRateLoops = ulNow;
+      ulRateStart += ulElapsed;
     }
+    if (!bHW_MutexLock(&sConsole, 0uL)) continue;
+
+    vHW_TraceBegin(TRACE_REGION_DASH);
+    uint32_t ulCycles = ulHW_GetCycleCount();
+    vDashUpdate(ulLoopsPerSec);
+    ulCycles = ulHW_GetCycleCount() - ulCycles;
+    vHW_TraceEnd(TRACE_REGION_DASH);
+
+    sAppStats.ulRedraws++;
+    sAppStats.ullRedrawSum += ulCycles;
+    if (ulCycles < sAppStats.ulRedrawMin) sAppStats.ulRedrawMin = ulCycles;
+    if (ulCycles > sAppStats.ulRedrawMax) sAppStats.ulRedrawMax = ulCycles;
+    (void)bHW_MutexUnlock(&sConsole);
   }
 }
 
+/*!****************************************************************************
+ * @brief
+ * Background thread: run coroutines and drain console output when nothing
+ * else runs, count loop iterations, feed console input to the shell
+ *
+ * At most one input character is handled per iteration. A complete command
+ * line is executed with the console owned, in place of the dashboard, which
+ * is then redrawn below the command output.
+ *
+ * @param[in] *pvArg  Unused
+ * @date  19.10.2026
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vLoopThread(void* pvArg)
+{
+  (void)pvArg;
+  while (1)
+  {
+    ulLoops++;
+    (void)eBlinkLed(&sLedCoro);
+    vHW_PollSwo();
+    if (bHW_IsSwoDataAvailable() && bSHELL_Input(&sShell, cHW_ReadSwo()))
+    {
+      (void)bHW_MutexLock(&sConsole, HW_OS_WAIT_FOREVER);
+      vTUI_Release(&sDash);
+      vSHELL_Execute(&sShell);
+      sAppStats.ulCommands++;
+      vTUI_Init(&sDash, vDashWrite);
+      (void)bHW_MutexUnlock(&sConsole);
+    }
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Dashboard and shell output function
+ *
+ * @param[in] *pcBuf    Data
+ * @param[in] ulLen     Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vDashWrite(const char* pcBuf, uint32_t ulLen)
+{
+  for (uint32_t i = 0uL; i < ulLen; ++i)
+  {
+    vHW_WriteSwo(pcBuf[i]);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Redraw live dashboard
+ *
+ * Only cells that changed since the previous refresh are sent to the
+ * terminal, so a refresh typically costs a few dozen bytes.
+ *
+ * @param[in] ulLoopRate  Background loop iterations per second
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vDashUpdate(uint32_t ulLoopRate)
+{
+  static uint32_t ulLastBytes;
+
+  uint32_t ulTime = ulHW_GetTime();
+  uint32_t ulSec = ulTime / 1000uL;
+  int32_t lTemp = lHW_GetDieTemp();
+  const char* pcSign = (lTemp < 0L) ? "-" : "";
+  uint32_t ulTemp = (uint32_t)((lTemp < 0L) ? -lTemp : lTemp);
+
+  vTUI_Puts(&sDash, 0u, 0u, TUI_ATTR_NONE,
+            "-- Live ------------------------------------------");
+  vTUI_Printf(&sDash, 1u, 0u, TUI_ATTR_NONE, "Uptime:    %lud %02lu:%02lu:%02lu.%03lu",
+              ulSec / 86400uL, (ulSec / 3600uL) % 24uL, (ulSec / 60uL) % 60uL,
+              ulSec % 60uL, ulTime % 1000uL);
+  vTUI_Printf(&sDash, 2u, 0u, TUI_ATTR_NONE, "Loop rate: %-10lu /s", ulLoopRate);
+  vTUI_Printf(&sDash, 3u, 0u, TUI_ATTR_NONE, "Die temp:  %s%lu.%02lu degC  ",
+              pcSign, ulTemp / 100uL, ulTemp % 100uL);
+  vTUI_Printf(&sDash, 4u, 0u, TUI_ATTR_NONE, "VDDA:      %4u mV", uiHW_GetVdda());
+  vTUI_Printf(&sDash, 5u, 0u, TUI_ATTR_NONE, "AIN0:      %4u mV", uiHW_GetAnalogIn(0u));
+  vTUI_Printf(&sDash, 6u, 0u, TUI_ATTR_NONE, "AIN1:      %4u mV", uiHW_GetAnalogIn(1u));
+  vTUI_Printf(&sDash, 7u, 0u, TUI_ATTR_NONE, "Stack free: dash %4lu B, loop %4lu B",
+              ulHW_OS_GetStackFree(&sDashThread), ulHW_OS_GetStackFree(&sLoopThread));
+  vTUI_Printf(&sDash, 8u, 0u, TUI_ATTR_FG(VT100_FGCOL_CYAN),
+              "Last refresh: %-4lu bytes", ulLastBytes);
+
+  ulLastBytes = ulTUI_Refresh(&sDash);
+  vHW_Record(FLIGHT_EVT_DASH, (uint16_t)ulLastBytes);
+}
 
-/*- Private functions --------------------------------------------------------*/
 /*!****************************************************************************
  * @brief
  * Print core information from CPUID
  *
+ * Waits for SWO transmit space before each line instead of blocking.
+ *
+ * @param[in,out] *psCo   Coroutine state
+ * @return  (CORO_StatusTypeDef)  Coroutine status
  * @date  25.10.2025
+ * @date  19.10.2026
  ******************************************************************************/
-static void vPrintCoreInfo(void)
+static CORO_StatusTypeDef ePrintCoreInfo(CORO_TypeDef* psCo)
 {
-  uint32_t ulCpuid = ulHW_GetCpuid();
+  // Locals do not survive an await
+  static uint32_t ulCpuid;
+
+  CORO_BEGIN(psCo);
+  ulCpuid = ulHW_GetCpuid();
+  CORO_AWAIT_SPACE(psCo, ulHW_GetSwoTxFree(), 2u * CONSOLE_LINE_MAX);
   printf(
     "-- Core Information ------------------------------\r\n"
     "CPUID:       0x%08lX\r\n", ulCpuid
   );
 
   // Implementor
+  CORO_AWAIT_SPACE(psCo, ulHW_GetSwoTxFree(), CONSOLE_LINE_MAX);
   uint8_t ucImpl = (uint8_t)(ulCpuid >> 24);
   printf("implementer: 0x%02X  (%s)\r\n", ucImpl, (ucImpl == 0x41u) ? "ARM" : "unknown");
 
   // Processor revision
+  CORO_AWAIT_SPACE(psCo, ulHW_GetSwoTxFree(), CONSOLE_LINE_MAX);
   uint8_t ucVar = (uint8_t)((ulCpuid >> 20) & 0xFuL);
   printf("variant:     0x%01X   (Revision %d)\r\n", ucVar, ucVar);
 
   // Part number
+  CORO_AWAIT_SPACE(psCo, ulHW_GetSwoTxFree(), CONSOLE_LINE_MAX);
   uint16_t uiPartno = (uint16_t)((ulCpuid >> 4) & 0xFFFuL);
   printf("partno:      0x%03X (%s)\r\n", uiPartno, (uiPartno == 0xC23u) ? "Cortex-M3" : "unknown");
 
   // Patch release
+  CORO_AWAIT_SPACE(psCo, ulHW_GetSwoTxFree(), CONSOLE_LINE_MAX);
   uint8_t ucRev = (uint8_t)(ulCpuid & 0xFuL);
   printf("revision:    0x%01X   (Patch %d)\r\n", ucRev, ucRev);
+  CORO_END(psCo);
 }
 
 /*!****************************************************************************
  * @brief
- * Print system core clock frequency
+ * Print system core clock frequency and bring-up duration
  *
  * @date  25.10.2025
+ * @date  19.10.2026
  ******************************************************************************/
 static void vPrintSysCoreClk(void)
 {
@@ -130,6 +580,7 @@ static void vPrintSysCoreClk(void)
     "-- Clocks ----------------------------------------\r\n"
     "f_HCLK = %d.%03d MHz\r\n", uiFreq_MHz, uiFreqRem_kHz
   );
+  printf("Bring-up: %lu cycles (%s)\r\n", ulHW_GetBootCycles(), pcHW_GetInitPath());
 }
 
 /*!****************************************************************************
@@ -150,3 +601,708 @@ static void vPrintEsigInfo(void)
   const uint32_t* pulUID = pulHW_GetUID();
   printf("Unique ID: %08lX %08lX %08lX\r\n", pulUID[0], pulUID[1], pulUID[2]);
 }
+
+/*!****************************************************************************
+ * @brief
+ * Print result of boot-time image CRC check
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vPrintImageCheck(void)
+{
+  printf(
+    "-- Image -----------------------------------------\r\n"
+  );
+
+  const HW_CRC_ImageCheckTypeDef* psCheck = psHW_GetImageCheck();
+  uint32_t ulCyclesPerUs = ulHW_GetCoreClkFreq() / 1000000uL;
+  switch (psCheck->eStatus)
+  {
+    case HW_CRC_IMAGE_OK:
+      printf("Image CRC: 0x%08lX OK (%lu bytes in %lu us)\r\n", psCheck->ulActual,
+             psCheck->ulLength, psCheck->ulCycles / ulCyclesPerUs);
+      break;
+
+    case HW_CRC_IMAGE_CORRUPT:
+      printf(VT100_SET_COLOR(VT100_FGCOL_RED)
+             "Image CRC: 0x%08lX CORRUPT (expected 0x%08lX)\r\n"
+             VT100_SET_COLOR(VT100_FGCOL_RESET),
+             psCheck->ulActual, psCheck->ulExpected);
+      break;
+
+    default:
+      printf("Image CRC: not embedded\r\n");
+      break;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Increment and print boot counter in non-volatile storage
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vPrintBootCount(void)
+{
+  printf(
+    "-- Storage ---------------------------------------\r\n"
+  );
+
+  uint32_t ulBootCount = 0uL;
+  (void)lHW_NvmGet(NVM_KEY_BOOT_COUNT, &ulBootCount, sizeof(ulBootCount));
+  ulBootCount++;
+  vHW_Record(FLIGHT_EVT_BOOT, (uint16_t)ulBootCount);
+  if (bHW_NvmPut(NVM_KEY_BOOT_COUNT, &ulBootCount, sizeof(ulBootCount)))
+  {
+    printf("Boot count: %lu\r\n", ulBootCount);
+  }
+  else
+  {
+    printf("Boot count: unavailable\r\n");
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Print SPI NOR log device and usage
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vPrintLogInfo(void)
+{
+  printf(
+    "-- Log -------------------------------------------\r\n"
+  );
+
+  HW_LOG_StatsTypeDef sStats;
+  vHW_LogGetStats(&sStats);
+  if (bHW_LogIsReady())
+  {
+    printf("SPI NOR: JEDEC %06lX, %lu KB ('dump' sends to ITM port %u)\r\n",
+           sStats.ulJedecId, sStats.ulSize / 1024uL, HW_LOG_DUMP_PORT);
+  }
+  else
+  {
+    printf("SPI NOR: not detected\r\n");
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Print fault snapshot and last events of previous run, if it ended in a
+ * fault
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vPrintFaultDump(void)
+{
+  static const char* const apcExceptions[] = {
+    "Thread", "Reset", "NMI", "HardFault", "MemManage", "BusFault", "UsageFault"
+  };
+  static const struct {
+    uint32_t ulMask;
+    const char* pcName;
+  } asCfsrBits[] = {
+    { 1uL << 0,  "IACCVIOL" },    { 1uL << 1,  "DACCVIOL" },
+    { 1uL << 3,  "MUNSTKERR" },   { 1uL << 4,  "MSTKERR" },
+    { 1uL << 8,  "IBUSERR" },     { 1uL << 9,  "PRECISERR" },
+    { 1uL << 10, "IMPRECISERR" }, { 1uL << 11, "UNSTKERR" },
+    { 1uL << 12, "STKERR" },      { 1uL << 16, "UNDEFINSTR" },
+    { 1uL << 17, "INVSTATE" },    { 1uL << 18, "INVPC" },
+    { 1uL << 19, "NOCP" },        { 1uL << 24, "UNALIGNED" },
+    { 1uL << 25, "DIVBYZERO" }
+  };
+
+  const HW_FLIGHT_DumpTypeDef* psDump = psHW_GetFaultDump();
+  if (psDump == NULL) return;
+
+  const HW_FLIGHT_FaultTypeDef* psFault = &psDump->sFault;
+  const uint32_t* pulRegs = psFault->aulRegs;
+  uint32_t ulExc = psFault->ulIpsr & 0x1FFuL;
+  printf(
+    VT100_SET_COLOR(VT100_FGCOL_RED)
+    "-- Fault Dump (previous run) ---------------------\r\n"
+    VT100_SET_COLOR(VT100_FGCOL_RESET)
+    "Exception: %s (%lu)\r\n"
+    "PC:  0x%08lX  LR:  0x%08lX  xPSR: 0x%08lX\r\n"
+    "R0:  0x%08lX  R1:  0x%08lX  R2:   0x%08lX\r\n"
+    "R3:  0x%08lX  R12: 0x%08lX  SP:   0x%08lX\r\n"
+    "CFSR: 0x%08lX  HFSR: 0x%08lX  EXC_RETURN: 0x%08lX\r\n",
+    (ulExc < 7uL) ? apcExceptions[ulExc] : "IRQ", ulExc,
+    pulRegs[HW_FLIGHT_REG_PC], pulRegs[HW_FLIGHT_REG_LR], pulRegs[HW_FLIGHT_REG_XPSR],
+    pulRegs[HW_FLIGHT_REG_R0], pulRegs[HW_FLIGHT_REG_R1], pulRegs[HW_FLIGHT_REG_R2],
+    pulRegs[HW_FLIGHT_REG_R3], pulRegs[HW_FLIGHT_REG_R12], psFault->ulSp,
+    psFault->ulCfsr, psFault->ulHfsr, psFault->ulExcReturn
+  );
+
+  // Decode fault status
+  printf("Status:");
+  for (uint32_t i = 0uL; i < sizeof(asCfsrBits) / sizeof(asCfsrBits[0]); ++i)
+  {
+    if ((psFault->ulCfsr & asCfsrBits[i].ulMask) != 0uL) printf(" %s", asCfsrBits[i].pcName);
+  }
+  if ((psFault->ulHfsr & (1uL << 1)) != 0uL) printf(" VECTTBL");
+  if ((psFault->ulHfsr & (1uL << 30)) != 0uL) printf(" FORCED");
+  printf("\r\n");
+
+  // Fault addresses, if marked valid (BFARVALID, MMARVALID)
+  if ((psFault->ulCfsr & (1uL << 15)) != 0uL) printf("BFAR:  0x%08lX\r\n", psFault->ulBfar);
+  if ((psFault->ulCfsr & (1uL << 7)) != 0uL) printf("MMFAR: 0x%08lX\r\n", psFault->ulMmfar);
+
+  // Last events, time relative to fault
+  printf("Last %lu events (us before fault, id, arg):\r\n", psDump->ulNumEvents);
+  uint32_t ulCyclesPerUs = ulHW_GetCoreClkFreq() / 1000000uL;
+  for (uint32_t i = 0uL; i < psDump->ulNumEvents; ++i)
+  {
+    const HW_FLIGHT_EventTypeDef* psEvent = &psDump->asEvents[i];
+    printf("  %10lu  0x%04X  %u\r\n", (psFault->ulTime - psEvent->ulTime) / ulCyclesPerUs,
+           psEvent->uiId, psEvent->uiArg);
+  }
+  printf("\r\n");
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write application message to SPI NOR log
+ *
+ * The console is left to the dashboard and shell, "dump" reads messages
+ * back.
+ *
+ * @param[in] ulLevel   Message level (LOG_LEVEL_ERROR..LOG_LEVEL_DEBUG)
+ * @param[in] *pcFmt    printf() format string
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vLog(uint32_t ulLevel, const char* pcFmt, ...)
+{
+  if ((ulLevel == LOG_LEVEL_OFF) || (ulLevel > ulLogLevel)) return;
+
+  char acLine[CONSOLE_LINE_MAX];
+  uint32_t ulTime = ulHW_GetTime();
+  int iLen = snprintf(acLine, sizeof(acLine), "[%c] %lu.%03lu ",
+                      "-EWID"[ulLevel], ulTime / 1000uL, ulTime % 1000uL);
+  va_list args;
+  va_start(args, pcFmt);
+  (void)vsnprintf(&acLine[iLen], sizeof(acLine) - 2u - (uint32_t)iLen, pcFmt, args);
+  va_end(args);
+  (void)strcat(acLine, "\r\n");
+  vHW_LogWrite(acLine, strlen(acLine));
+}
+
+/*!****************************************************************************
+ * @brief
+ * Reset statistics
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vStatsReset(void)
+{
+  sAppStats = (AppStatsTypeDef){
+    .ulStart = ulHW_GetTime(),
+    .ulLoops = ulLoops,
+    .ulRedrawMin = UINT32_MAX
+  };
+}
+
+/*!****************************************************************************
+ * @brief
+ * Restart dashboard refresh timer with changed interval
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vApplyDashInterval(void)
+{
+  vHW_TimerStart(&sDashTimer, ulDashInterval, ulDashInterval);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Shell command "help": list commands
+ *
+ * @param[in,out] *psShell  Shell instance
+ * @param[in] ulArgc        Number of arguments
+ * @param[in] *apcArgv[]    Arguments
+ * @return  (bool)  Usage valid
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bCmdHelp(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[])
+{
+  (void)ulArgc;
+  (void)apcArgv;
+  vSHELL_PrintHelp(psShell);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Shell command "stats": print timing and profiling counters
+ *
+ * Rates and redraw times cover the time since boot or the last "reset".
+ *
+ * @param[in,out] *psShell  Shell instance
+ * @param[in] ulArgc        Number of arguments
+ * @param[in] *apcArgv[]    Arguments
+ * @return  (bool)  Usage valid
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bCmdStats(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[])
+{
+  (void)apcArgv;
+  if (ulArgc != 1u) return false;
+
+  uint32_t ulTime = ulHW_GetTime();
+  uint32_t ulSpan = ulTime - sAppStats.ulStart;
+  uint32_t ulLoopCount = ulLoops - sAppStats.ulLoops;
+  uint32_t ulRedraws = sAppStats.ulRedraws;
+  uint32_t ulCyclesPerUs = ulHW_GetCoreClkFreq() / 1000000uL;
+  HW_LOG_StatsTypeDef sLog;
+  vHW_LogGetStats(&sLog);
+
+  vSHELL_Printf(psShell, "uptime    %lu ms, %lu ms since reset\r\n", ulTime, ulSpan);
+  vSHELL_Printf(psShell, "loop      %lu iterations, %lu /s now\r\n", ulLoopCount, ulLoopsPerSec);
+  if (ulRedraws > 0uL)
+  {
+    vSHELL_Printf(psShell, "redraw    %lu, cycles min %lu avg %lu max %lu\r\n", ulRedraws,
+                  sAppStats.ulRedrawMin, (uint32_t)(sAppStats.ullRedrawSum / ulRedraws),
+                  sAppStats.ulRedrawMax);
+  }
+  else
+  {
+    vSHELL_Puts(psShell, "redraw    0\r\n");
+  }
+  vSHELL_Printf(psShell, "led       %lu toggles\r\n", sAppStats.ulToggles);
+  vSHELL_Printf(psShell, "commands  %lu\r\n", sAppStats.ulCommands);
+  vSHELL_Printf(psShell, "stack     dash %lu B, loop %lu B free\r\n",
+                ulHW_OS_GetStackFree(&sDashThread), ulHW_OS_GetStackFree(&sLoopThread));
+  vSHELL_Printf(psShell, "log       %lu pages, %lu stalls, %lu B dropped\r\n",
+                sLog.sFlash.ulPages, sLog.sFlash.ulStalls, sLog.ulDropped);
+  vSHELL_Printf(psShell, "bring-up  %lu cycles (%lu us)\r\n", ulHW_GetBootCycles(),
+                ulHW_GetBootCycles() / ulCyclesPerUs);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Shell command "reset": reset statistics
+ *
+ * @param[in,out] *psShell  Shell instance
+ * @param[in] ulArgc        Number of arguments
+ * @param[in] *apcArgv[]    Arguments
+ * @return  (bool)  Usage valid
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bCmdReset(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[])
+{
+  (void)apcArgv;
+  if (ulArgc != 1u) return false;
+
+  vStatsReset();
+  vSHELL_Puts(psShell, "statistics reset\r\n");
+  vLog(LOG_LEVEL_INFO, "statistics reset");
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Shell command "log": print or set level of application messages
+ *
+ * @param[in,out] *psShell  Shell instance
+ * @param[in] ulArgc        Number of arguments
+ * @param[in] *apcArgv[]    Arguments
+ * @return  (bool)  Usage valid
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bCmdLog(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[])
+{
+  uint32_t ulNumLevels = sizeof(apcLogLevels) / sizeof(apcLogLevels[0]);
+  if (ulArgc == 2u)
+  {
+    uint32_t ulLevel = 0uL;
+    while ((ulLevel < ulNumLevels) && (strcmp(apcArgv[1], apcLogLevels[ulLevel]) != 0)) ulLevel++;
+    if (ulLevel == ulNumLevels) return false;
+    ulLogLevel = ulLevel;
+    vLog(LOG_LEVEL_INFO, "log level %s", apcLogLevels[ulLevel]);
+  }
+  else if (ulArgc != 1u)
+  {
+    return false;
+  }
+
+  vSHELL_Printf(psShell, "log level %s (", apcLogLevels[ulLogLevel]);
+  for (uint32_t i = 0uL; i < ulNumLevels; ++i)
+  {
+    vSHELL_Printf(psShell, (i > 0uL) ? " %s" : "%s", apcLogLevels[i]);
+  }
+  vSHELL_Puts(psShell, ")\r\n");
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Shell command "set": list parameters or change one
+ *
+ * @param[in,out] *psShell  Shell instance
+ * @param[in] ulArgc        Number of arguments
+ * @param[in] *apcArgv[]    Arguments
+ * @return  (bool)  Usage valid
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bCmdSet(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[])
+{
+  uint32_t ulNumParams = sizeof(asParams) / sizeof(asParams[0]);
+  if (ulArgc == 1u)
+  {
+    for (uint32_t i = 0uL; i < ulNumParams; ++i)
+    {
+      const AppParamTypeDef* psParam = &asParams[i];
+      vSHELL_Printf(psShell, "  %-8s %6lu %s (%lu..%lu)\r\n", psParam->pcName, *psParam->pulValue,
+                    psParam->pcUnit, psParam->ulMin, psParam->ulMax);
+    }
+    return true;
+  }
+  if (ulArgc != 3u) return false;
+
+  const AppParamTypeDef* psParam = NULL;
+  for (uint32_t i = 0uL; i < ulNumParams; ++i)
+  {
+    if (strcmp(apcArgv[1], asParams[i].pcName) == 0) psParam = &asParams[i];
+  }
+  uint32_t ulValue;
+  if ((psParam == NULL) || !bSHELL_ParseU32(apcArgv[2], &ulValue)) return false;
+
+  if ((ulValue < psParam->ulMin) || (ulValue > psParam->ulMax))
+  {
+    vSHELL_Printf(psShell, "%s: %lu out of range (%lu..%lu)\r\n", psParam->pcName, ulValue,
+                  psParam->ulMin, psParam->ulMax);
+    return true;
+  }
+  *psParam->pulValue = ulValue;
+  if (psParam->pfnApply != NULL) psParam->pfnApply();
+  vSHELL_Printf(psShell, "%s = %lu %s\r\n", psParam->pcName, ulValue, psParam->pcUnit);
+  vLog(LOG_LEVEL_INFO, "set %s %lu", psParam->pcName, ulValue);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Shell command "bench": time kernels in core clock cycles
+ *
+ * Each kernel runs the given number of times; interrupts stay enabled, so
+ * the minimum is the undisturbed figure. The dashboard is not redrawn
+ * meanwhile.
+ *
+ * @param[in,out] *psShell  Shell instance
+ * @param[in] ulArgc        Number of arguments
+ * @param[in] *apcArgv[]    Arguments
+ * @return  (bool)  Usage valid
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bCmdBench(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[])
+{
+  uint32_t ulRuns = BENCH_RUNS_DEFAULT;
+  if (ulArgc > 2u) return false;
+  if ((ulArgc == 2u) && (!bSHELL_ParseU32(apcArgv[1], &ulRuns) || (ulRuns == 0uL) ||
+                         (ulRuns > BENCH_RUNS_MAX)))
+  {
+    return false;
+  }
+
+  for (uint32_t i = 0uL; i < BENCH_CRC_SIZE; ++i)
+  {
+    aucBenchBuf[i] = (uint8_t)(i * 31u);
+  }
+
+  vLog(LOG_LEVEL_INFO, "bench %lu runs", ulRuns);
+  vSHELL_Printf(psShell, "%lu runs, cycles:\r\n", ulRuns);
+  for (uint32_t k = 0uL; k < sizeof(asKernels) / sizeof(asKernels[0]); ++k)
+  {
+    uint32_t ulMin = UINT32_MAX;
+    uint32_t ulMax = 0uL;
+    uint64_t ullSum = 0uLL;
+    for (uint32_t r = 0uL; r < ulRuns; ++r)
+    {
+      uint32_t ulCycles = ulHW_GetCycleCount();
+      asKernels[k].pfnRun();
+      ulCycles = ulHW_GetCycleCount() - ulCycles;
+      ullSum += ulCycles;
+      if (ulCycles < ulMin) ulMin = ulCycles;
+      if (ulCycles > ulMax) ulMax = ulCycles;
+    }
+    vSHELL_Printf(psShell, "  %-8s min %7lu  avg %7lu  max %7lu\r\n", asKernels[k].pcName,
+                  ulMin, (uint32_t)(ullSum / ulRuns), ulMax);
+  }
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Shell command "dump": send SPI NOR log to the debug probe
+ *
+ * @param[in,out] *psShell  Shell instance
+ * @param[in] ulArgc        Number of arguments
+ * @param[in] *apcArgv[]    Arguments
+ * @return  (bool)  Usage valid
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bCmdDump(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[])
+{
+  (void)apcArgv;
+  if (ulArgc != 1u) return false;
+
+  if (!bHW_LogIsReady())
+  {
+    vSHELL_Puts(psShell, "SPI NOR log not available\r\n");
+    return true;
+  }
+  uint32_t ulBytes = ulHW_LogDump();
+  vSHELL_Printf(psShell, "%lu bytes sent to ITM port %u\r\n", ulBytes, HW_LOG_DUMP_PORT);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Shell command "update": reset into the serial bootloader
+ *
+ * The bootloader waits for an image on USART1 (tools/boot_upload) and only
+ * starts the application again once the upload is complete. Returns if the
+ * image was built without the bootloader.
+ *
+ * @param[in,out] *psShell  Shell instance
+ * @param[in] ulArgc        Number of arguments
+ * @param[in] *apcArgv[]    Arguments
+ * @return  (bool)  Usage valid
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bCmdUpdate(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[])
+{
+  (void)apcArgv;
+  if (ulArgc != 1u) return false;
+
+  vSHELL_Puts(psShell, "resetting into bootloader\r\n");
+  vLog(LOG_LEVEL_INFO, "bootloader requested");
+  vHW_EnterBootloader();
+  vSHELL_Puts(psShell, "image not built for the bootloader\r\n");
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Shell command "i2c": scan the sensor bus
+ *
+ * Probes all addresses in one batch and lists those that acknowledge.
+ *
+ * @param[in,out] *psShell  Shell instance
+ * @param[in] ulArgc        Number of arguments
+ * @param[in] *apcArgv[]    Arguments
+ * @return  (bool)  Usage valid
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bCmdI2c(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[])
+{
+  (void)apcArgv;
+  if (ulArgc != 1u) return false;
+
+  I2CQ_BatchTypeDef sScan = {
+    .psXfers = asI2cProbes,
+    .ulCount = sizeof(asI2cProbes) / sizeof(asI2cProbes[0])
+  };
+  for (uint32_t i = 0uL; i < sScan.ulCount; ++i)
+  {
+    asI2cProbes[i].ucAddr = (uint8_t)(I2C_SCAN_FIRST + i);
+  }
+  if (!bHW_I2cSubmitBatch(&sScan))
+  {
+    vSHELL_Puts(psShell, "scan already running\r\n");
+    return true;
+  }
+  while (sScan.ulPending != 0uL)
+  {
+    vHW_Sleep(1uL);
+  }
+
+  uint32_t ulFound = 0uL;
+  for (uint32_t i = 0uL; i < sScan.ulCount; ++i)
+  {
+    if (asI2cProbes[i].eStatus != I2CQ_STATUS_OK) continue;
+    vSHELL_Printf(psShell, "%s0x%02X", (ulFound == 0uL) ? "devices " : " ", asI2cProbes[i].ucAddr);
+    ulFound++;
+  }
+  vSHELL_Puts(psShell, (ulFound == 0uL) ? "no devices\r\n" : "\r\n");
+
+  I2CQ_StatsTypeDef sStats;
+  vHW_I2cGetStats(&sStats);
+  vSHELL_Printf(psShell, "bus     %lu ok, %lu failed, %lu retries, %lu recoveries\r\n",
+                sStats.ulDone, sStats.ulFailed, sStats.ulRetries, sStats.ulRecoveries);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Shell command "capture": measure frequency and duty cycle on the capture input
+ *
+ * Collects the rising edges of one gate time; a gap in the records (buffer
+ * overrun) restarts the measurement.
+ *
+ * @param[in,out] *psShell  Shell instance
+ * @param[in] ulArgc        Number of arguments
+ * @param[in] *apcArgv[]    Arguments
+ * @return  (bool)  Usage valid
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bCmdCapture(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[])
+{
+  uint32_t ulGate = CAPTURE_GATE_DEFAULT;
+  if ((ulArgc == 2u) && (!bSHELL_ParseU32(apcArgv[1], &ulGate) || (ulGate == 0uL) ||
+                         (ulGate > CAPTURE_GATE_MAX)))
+  {
+    return false;
+  }
+  if (ulArgc > 2u) return false;
+
+  uint32_t ulOverruns = ulHW_CaptureGetOverruns();
+  CAPT_BatchTypeDef sTotal;
+  CAPT_BatchTypeDef sBatch;
+  vCAPT_ClearBatch(&sTotal);
+
+  if (!bHW_CaptureStart())
+  {
+    vSHELL_Puts(psShell, "DMA channel in use, stop \"wave\" first\r\n");
+    return true;
+  }
+  uint32_t ulStart = ulHW_GetTime();
+  while ((ulHW_GetTime() - ulStart) < ulGate)
+  {
+    vHW_Sleep(CAPTURE_POLL);
+    if (bHW_CaptureGetBatch(&sBatch, NULL))
+    {
+      vCAPT_AddBatch(&sTotal, &sBatch);
+    }
+    else
+    {
+      vCAPT_ClearBatch(&sTotal);
+    }
+  }
+  vHW_CaptureStop();
+
+  uint32_t ulFreq = ulCAPT_GetFreq(&sTotal, ulHW_CaptureGetClock());
+  uint16_t uiDuty = uiCAPT_GetDuty(&sTotal);
+  vSHELL_Printf(psShell, "edges   %lu, %lu overruns\r\n", sTotal.ulEdges,
+                ulHW_CaptureGetOverruns() - ulOverruns);
+  if (sTotal.ulPeriods == 0uL) return true;
+
+  vSHELL_Printf(psShell, "freq    %lu.%03lu Hz\r\n", ulFreq / 1000uL, ulFreq % 1000uL);
+  vSHELL_Printf(psShell, "period  min %lu max %lu ticks at %lu Hz\r\n", sTotal.ulPeriodMin,
+                sTotal.ulPeriodMax, ulHW_CaptureGetClock());
+  if (uiDuty == UINT16_MAX)
+  {
+    vSHELL_Puts(psShell, "duty    unknown (high or low time over one counter period)\r\n");
+  }
+  else
+  {
+    vSHELL_Printf(psShell, "duty    %u.%02u %%\r\n", uiDuty / 100u, uiDuty % 100u);
+  }
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Shell command "wave": play a 3-phase sine on the sequencer PWM outputs
+ *
+ * The sine table is scaled to the PWM period of the sample rate, so the
+ * sequencer is stopped while it is rewritten. The outputs need a low-pass
+ * filter to show the sine.
+ *
+ * @param[in,out] *psShell  Shell instance
+ * @param[in] ulArgc        Number of arguments
+ * @param[in] *apcArgv[]    Arguments
+ * @return  (bool)  Usage valid
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bCmdWave(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[])
+{
+  if (ulArgc > 2u) return false;
+  if ((ulArgc == 2u) && (strcmp(apcArgv[1], "off") == 0))
+  {
+    vHW_SeqStop();
+    return true;
+  }
+
+  uint32_t ulRate = WAVE_RATE_DEFAULT;
+  if ((ulArgc == 2u) && (!bSHELL_ParseU32(apcArgv[1], &ulRate) || (ulHW_SeqGetTop(ulRate) == 0uL)))
+  {
+    return false;
+  }
+
+  vHW_SeqStop();
+  uint32_t ulTop = ulHW_SeqGetTop(ulRate);
+  for (uint32_t i = 0uL; i < WAVE_SAMPLES; ++i)
+  {
+    for (uint32_t c = 0uL; c < WAVE_PHASES; ++c)
+    {
+      uint16_t uiAngle = (uint16_t)(i * (65536uL / WAVE_SAMPLES) + c * FIX_ANGLE16_DEG(120.0));
+      uint32_t ulLevel = (uint32_t)((int32_t)iFIX_SinQ15(uiAngle) + 32768);
+      auiWave[i * WAVE_PHASES + c] = (uint16_t)((ulTop * ulLevel) >> 16);
+    }
+  }
+
+  HW_SEQ_ConfigTypeDef sConfig = {
+    .eMode = HW_SEQ_MODE_PWM,
+    .ulRate = ulRate,
+    .ulChannels = WAVE_PHASES
+  };
+  if (!bHW_SeqStart(&sConfig, &sWaveTable))
+  {
+    vSHELL_Puts(psShell, "DMA channel in use\r\n");
+    return true;
+  }
+
+  uint32_t ulFreq = ulRate * 1000uL / WAVE_SAMPLES;
+  vSHELL_Printf(psShell, "sine    %lu.%03lu Hz, %lu samples/s, PWM top %lu\r\n", ulFreq / 1000uL,
+                ulFreq % 1000uL, ulRate, ulTop);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Bench kernel: hardware CRC-32 of BENCH_CRC_SIZE bytes
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vBenchCrc(void)
+{
+  ulBenchSink = ulHW_Crc32(aucBenchBuf, BENCH_CRC_SIZE);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Bench kernel: format a dashboard line
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vBenchFormat(void)
+{
+  char acLine[CONSOLE_LINE_MAX];
+  ulBenchSink = (uint32_t)snprintf(acLine, sizeof(acLine), "Uptime:    %lud %02lu:%02lu:%02lu.%03lu",
+                                   ulBenchSink & 7uL, 12uL, 34uL, 56uL, 789uL);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Bench kernel: Q31 sine
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vBenchSin(void)
+{
+  ulBenchSink = (uint32_t)lFIX_SinQ31(ulBenchSink * 2654435761uL);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Bench kernel: Q31 square root
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vBenchSqrt(void)
+{
+  ulBenchSink = (uint32_t)lFIX_SqrtQ31((int32_t)((ulBenchSink * 2654435761uL) >> 1));
+}
@@ -23,6 +23,11 @@
 /// Timeout for a character read operation, measured in milliseconds
 #define SYSCALLS_READ_TIMEOUT         10uL
 
+/// Standard I/O on the USB serial port instead of SWO
+#ifndef SYSCALLS_STDIO_USB
+#define SYSCALLS_STDIO_USB            0
+#endif
+
 
 /*- Retargeting functions ----------------------------------------------------*/
 /*!****************************************************************************
@@ -64,6 +69,7 @@ __used int _isatty(int fd)
  * @return  (int)       Number of bytes read
  * @date  03.03.2022
  * @date  21.03.2023  Adapted for ch32v003 SysTick
+ * @date  19.10.2026  Reads from USB serial port with SYSCALLS_STDIO_USB
  ******************************************************************************/
 __used int _read(int fd, void* buffer, unsigned buffer_size)
 {
@@ -74,6 +80,18 @@ __used int _read(int fd, void* buffer, unsigned buffer_size)
   }
   else if (fd == STDIN_FILENO)
   {
+#if SYSCALLS_STDIO_USB
+    for (unsigned i = 0; i < buffer_size; )
+    {
+      uint32_t ulStart = ulHW_GetTime();
+      while (!bHW_UsbIsDataAvailable())
+      {
+        // Exit on timeout
+        if ((ulHW_GetTime() - ulStart) > SYSCALLS_READ_TIMEOUT) return (int)i;
+      }
+      i += (unsigned)ulHW_UsbRead(&((char*)buffer)[i], buffer_size - i);
+    }
+#else
     for (unsigned i = 0; i < buffer_size; ++i)
     {
       uint32_t ulStart = ulHW_GetTime();
@@ -84,6 +102,7 @@ __used int _read(int fd, void* buffer, unsigned buffer_size)
       }
       ((char*)buffer)[i] = cHW_ReadSwo();
     }
+#endif
     return (int)buffer_size;
   }
   else
@@ -107,6 +126,8 @@ __used int _read(int fd, void* buffer, unsigned buffer_size)
  * @return  (int)         Number of bytes written
  * @date  03.03.2022
  * @date  03.03.2022  Added red text coloring for stderr output
+ * @date  19.10.2026  Output is copied to the SPI NOR log
+ * @date  19.10.2026  Writes to USB serial port with SYSCALLS_STDIO_USB
  ******************************************************************************/
 __used int _write(int fd, const char* buffer, unsigned count)
 {
@@ -117,10 +138,16 @@ __used int _write(int fd, const char* buffer, unsigned count)
   }
   else if (fd == STDOUT_FILENO || fd == STDERR_FILENO)
   {
+#if SYSCALLS_STDIO_USB
+    // Dropped while no terminal is attached
+    (void)ulHW_UsbWrite(buffer, count);
+#else
     for (unsigned i = 0; i < count; ++i)
     {
       vHW_WriteSwo(((const char*)buffer)[i]);
     }
+#endif
+    vHW_LogWrite(buffer, count);
     return (int)count;
   }
   else
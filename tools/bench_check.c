@@ -0,0 +1,433 @@
+/*!****************************************************************************
+ * @file
+ * bench_check.c
+ *
+ * @brief
+ * Host build of the microbenchmark harness
+ *
+ * Runs bench/bench.c and the code placement suite (bench/bench_exec.c) on a
+ * POSIX stand-in of the platform: a nanosecond clock as cycle counter,
+ * interrupt masking as no-op, and a result sink captured in memory. The DWT
+ * event counters are stood in by the cycle counter (no stalls, nothing
+ * folded). A check suite with fixed samples is run after them.
+ *
+ * The captured output is then parsed in the format built (BENCH_FORMAT, CSV
+ * or JSON lines): header, one record per case with the expected number of
+ * runs and min <= mean <= max, exact values for the fixed samples, CRLF line
+ * ends, and the end marker.
+ *
+ * Exits with failure status on the first error.
+ *
+ * Usage: bench_check [-v]
+ *   -v           Print the captured output
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "hw_layer.h"
+#include "bench.h"
+#include "bench_suites.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Output format, as selected for bench.c
+#ifndef BENCH_FORMAT
+#define BENCH_FORMAT                  0
+#endif
+
+/// Captured output size
+#define CHK_OUTPUT_SIZE               16384u
+
+/// Most records
+#define CHK_RECORDS_MAX               64u
+
+/// Runs of the measured check case
+#define CHK_RUNS                      5uL
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Parsed result record
+typedef struct {
+  char acSuite[16];               ///< Suite name
+  char acCase[24];                ///< Case name
+  unsigned long ulArg;            ///< Case argument
+  unsigned long ulUnits;          ///< Work units
+  unsigned long ulRuns;           ///< Runs
+  unsigned long ulMin;            ///< Minimum
+  unsigned long ulMax;            ///< Maximum
+  unsigned long ulMean;           ///< Mean
+} ChkRecordTypeDef;
+
+/// Expected record
+typedef struct {
+  const char* pcSuite;            ///< Suite name
+  const char* pcCase;             ///< Case name
+  unsigned long ulRuns;           ///< Runs
+} ChkExpectTypeDef;
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vChkBody(uint32_t ulArg);
+static void vChkCustom(const char* pcSuite);
+static void vChkFail(const char* pcMsg, const char* pcLine);
+static bool bChkParse(const char* pcLine, ChkRecordTypeDef* psRecord);
+static void vChkOutput(void);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Captured result sink
+static char acOutput[CHK_OUTPUT_SIZE];
+static size_t ulOutputLen;
+
+/// Stand-in event counters are running
+static bool bPerfEnabled;
+
+/// Check suite: one measured case, fixed samples in the custom part
+static const BENCH_CaseTypeDef asChkCases[] = {
+  { .pcName = "body", .pfnRun = vChkBody, .ulArg = 100u, .ulUnits = 4u, .ulWarmup = 1u, .ulRuns = CHK_RUNS }
+};
+static const BENCH_SuiteTypeDef sChkSuite = {
+  .pcName = "check",
+  .psCases = asChkCases,
+  .ulNumCases = BENCH_COUNT(asChkCases),
+  .pfnCustom = vChkCustom
+};
+
+/// Records expected in order
+static const ChkExpectTypeDef asExpect[] = {
+  { "exec", "flash", BENCH_DEFAULT_RUNS },
+  { "exec", "sram", BENCH_DEFAULT_RUNS },
+  { "exec", "empty_instr", BENCH_DEFAULT_RUNS },
+  { "exec", "empty_cpicnt", BENCH_DEFAULT_RUNS },
+  { "exec", "empty_lsucnt", BENCH_DEFAULT_RUNS },
+  { "exec", "empty_foldcnt", BENCH_DEFAULT_RUNS },
+  { "exec", "flash_instr", BENCH_DEFAULT_RUNS },
+  { "exec", "flash_cpicnt", BENCH_DEFAULT_RUNS },
+  { "exec", "flash_lsucnt", BENCH_DEFAULT_RUNS },
+  { "exec", "flash_foldcnt", BENCH_DEFAULT_RUNS },
+  { "exec", "sram_instr", BENCH_DEFAULT_RUNS },
+  { "exec", "sram_cpicnt", BENCH_DEFAULT_RUNS },
+  { "exec", "sram_lsucnt", BENCH_DEFAULT_RUNS },
+  { "exec", "sram_foldcnt", BENCH_DEFAULT_RUNS },
+  { "check", "body", CHK_RUNS },
+  { "check", "fixed", 3u },
+  { "check", "none", 0u }
+};
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Stand-in cycle counter
+ *
+ * @return  (uint32_t)  Monotonic clock in ns
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulBENCH_GetCycles(void)
+{
+  struct timespec sTs;
+  (void)clock_gettime(CLOCK_MONOTONIC, &sTs);
+  return (uint32_t)((uint64_t)sTs.tv_sec * 1000000000uLL + (uint64_t)sTs.tv_nsec);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stand-in cycle counter frequency
+ *
+ * @return  (uint32_t)  1 GHz
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulBENCH_GetCoreClock(void)
+{
+  return 1000000000uL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stand-in interrupt masking (no interrupts on the host)
+ *
+ * @return  (uint32_t)  0
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulBENCH_MaskIrq(void)
+{
+  return 0uL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stand-in interrupt mask restore
+ *
+ * @param[in] ulMask  Unused
+ * @date  19.10.2026
+ ******************************************************************************/
+void vBENCH_RestoreIrq(uint32_t ulMask)
+{
+  (void)ulMask;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Capture result output
+ *
+ * @param[in] *pcStr  Zero-terminated string
+ * @date  19.10.2026
+ ******************************************************************************/
+void vBENCH_Write(const char* pcStr)
+{
+  size_t ulLen = strlen(pcStr);
+  if (ulOutputLen + ulLen >= sizeof(acOutput))
+  {
+    printf("error: output buffer full\n");
+    exit(EXIT_FAILURE);
+  }
+  memcpy(&acOutput[ulOutputLen], pcStr, ulLen);
+  ulOutputLen += ulLen;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stand-in event counter enable
+ *
+ * @param[in] bEnable   Counters running
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_PerfEnable(bool bEnable)
+{
+  bPerfEnabled = bEnable;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stand-in event counter start
+ *
+ * @param[out] *psPerf  Counters
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_PerfStart(HW_PerfTypeDef* psPerf)
+{
+  memset(psPerf, 0, sizeof(*psPerf));
+  psPerf->aulLast[0] = ulBENCH_GetCycles();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stand-in event counter sample: cycles only
+ *
+ * @param[in,out] *psPerf Counters
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_PerfSample(HW_PerfTypeDef* psPerf)
+{
+  uint32_t ulNow = ulBENCH_GetCycles();
+  if (!bPerfEnabled)
+  {
+    printf("error: event counters sampled while disabled\n");
+    exit(EXIT_FAILURE);
+  }
+  psPerf->ulCycles += ulNow - psPerf->aulLast[0];
+  psPerf->aulLast[0] = ulNow;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stand-in metrics: one instruction per cycle
+ *
+ * @param[in] *psPerf     Counters
+ * @param[out] *psMetrics Metrics
+ * @date  19.10.2026
+ ******************************************************************************/
+void vHW_PerfGetMetrics(const HW_PerfTypeDef* psPerf, HW_PerfMetricsTypeDef* psMetrics)
+{
+  memset(psMetrics, 0, sizeof(*psMetrics));
+  psMetrics->ulInstructions = psPerf->ulCycles;
+  psMetrics->ulCpiMilli = 1000u;
+  psMetrics->bExact = true;
+}
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Measured body of the check suite
+ *
+ * @param[in] ulArg   Loop count
+ * @date  19.10.2026
+ ******************************************************************************/
+static __attribute__((noinline)) void vChkBody(uint32_t ulArg)
+{
+  for (volatile uint32_t i = 0u; i < ulArg; ++i) { }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Self-timed part of the check suite: fixed samples and an empty result
+ *
+ * @param[in] *pcSuite  Suite name
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkCustom(const char* pcSuite)
+{
+  BENCH_ResultTypeDef sResult;
+
+  vBENCH_ResetResult(&sResult);
+  vBENCH_AddSample(&sResult, 10u);
+  vBENCH_AddSample(&sResult, 30u);
+  vBENCH_AddSample(&sResult, 21u);
+  vBENCH_Report(pcSuite, "fixed", 7u, 3u, &sResult);
+
+  vBENCH_ResetResult(&sResult);
+  vBENCH_Report(pcSuite, "none", 0u, 0u, &sResult);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Print error with the line at fault and exit
+ *
+ * @param[in] *pcMsg    Error
+ * @param[in] *pcLine   Line
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkFail(const char* pcMsg, const char* pcLine)
+{
+  printf("error: %s\n  %s\n", pcMsg, pcLine);
+  exit(EXIT_FAILURE);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Parse a result record
+ *
+ * @param[in] *pcLine     Line without line end
+ * @param[out] *psRecord  Record
+ * @return  (bool)  Line is a complete record
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bChkParse(const char* pcLine, ChkRecordTypeDef* psRecord)
+{
+  int iEnd = -1;
+
+#if BENCH_FORMAT == 1
+  (void)sscanf(pcLine,
+               "{\"suite\":\"%15[^\"]\",\"case\":\"%23[^\"]\",\"arg\":%lu,\"units\":%lu,"
+               "\"runs\":%lu,\"min\":%lu,\"max\":%lu,\"mean\":%lu}%n",
+               psRecord->acSuite, psRecord->acCase, &psRecord->ulArg, &psRecord->ulUnits,
+               &psRecord->ulRuns, &psRecord->ulMin, &psRecord->ulMax, &psRecord->ulMean, &iEnd);
+#else
+  (void)sscanf(pcLine, "%15[^,],%23[^,],%lu,%lu,%lu,%lu,%lu,%lu%n",
+               psRecord->acSuite, psRecord->acCase, &psRecord->ulArg, &psRecord->ulUnits,
+               &psRecord->ulRuns, &psRecord->ulMin, &psRecord->ulMax, &psRecord->ulMean, &iEnd);
+#endif
+  return (iEnd >= 0) && (pcLine[iEnd] == '\0');
+}
+
+/*!****************************************************************************
+ * @brief
+ * Parse and check the captured output
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkOutput(void)
+{
+  char* apcLines[CHK_RECORDS_MAX + 4u];
+  uint32_t ulLines = 0u;
+  char* pcPos = acOutput;
+  unsigned long ulClock, ulOverhead;
+  int iEnd = -1;
+
+  // Split into lines, each terminated by CRLF
+  acOutput[ulOutputLen] = '\0';
+  while (*pcPos != '\0')
+  {
+    char* pcEnd = strstr(pcPos, "\r\n");
+    if (pcEnd == NULL) vChkFail("line without CRLF", pcPos);
+    if (ulLines == BENCH_COUNT(apcLines)) vChkFail("too many lines", pcPos);
+    *pcEnd = '\0';
+    if (strchr(pcPos, '\n') != NULL) vChkFail("bare LF", pcPos);
+    apcLines[ulLines++] = pcPos;
+    pcPos = pcEnd + 2;
+  }
+
+  // Header and end marker
+#if BENCH_FORMAT == 1
+  uint32_t ulFirst = 1u;
+  (void)sscanf(apcLines[0], "{\"meta\":{\"f_hclk\":%lu,\"overhead\":%lu}}%n", &ulClock, &ulOverhead, &iEnd);
+  if ((iEnd < 0) || (apcLines[0][iEnd] != '\0')) vChkFail("meta record", apcLines[0]);
+  if (strcmp(apcLines[ulLines - 1u], "{\"done\":true}") != 0) vChkFail("end marker", apcLines[ulLines - 1u]);
+#else
+  uint32_t ulFirst = 2u;
+  (void)sscanf(apcLines[0], "# f_hclk=%lu overhead=%lu%n", &ulClock, &ulOverhead, &iEnd);
+  if ((iEnd < 0) || (apcLines[0][iEnd] != '\0')) vChkFail("comment header", apcLines[0]);
+  if (strcmp(apcLines[1], "suite,case,arg,units,runs,min,max,mean") != 0) vChkFail("column header", apcLines[1]);
+  if (strcmp(apcLines[ulLines - 1u], "# done") != 0) vChkFail("end marker", apcLines[ulLines - 1u]);
+#endif
+  if (ulClock != 1000000000uL) vChkFail("core clock", apcLines[0]);
+
+  // Records
+  if (ulLines - ulFirst - 1u != BENCH_COUNT(asExpect)) vChkFail("record count", apcLines[ulLines - 1u]);
+  for (uint32_t i = 0u; i < BENCH_COUNT(asExpect); i++)
+  {
+    const char* pcLine = apcLines[ulFirst + i];
+    ChkRecordTypeDef sRec;
+
+    if (!bChkParse(pcLine, &sRec)) vChkFail("malformed record", pcLine);
+    if ((strcmp(sRec.acSuite, asExpect[i].pcSuite) != 0) || (strcmp(sRec.acCase, asExpect[i].pcCase) != 0))
+    {
+      vChkFail("unexpected record", pcLine);
+    }
+    if (sRec.ulRuns != asExpect[i].ulRuns) vChkFail("runs", pcLine);
+    if ((sRec.ulMin > sRec.ulMean) || (sRec.ulMean > sRec.ulMax)) vChkFail("min <= mean <= max", pcLine);
+  }
+
+  // Exact values of the fixed samples and the empty result
+  ChkRecordTypeDef sRec;
+  (void)bChkParse(apcLines[ulLines - 3u], &sRec);
+  if ((sRec.ulArg != 7u) || (sRec.ulUnits != 3u) || (sRec.ulMin != 10u) || (sRec.ulMax != 30u) ||
+      (sRec.ulMean != 20u))
+  {
+    vChkFail("fixed samples", apcLines[ulLines - 3u]);
+  }
+  (void)bChkParse(apcLines[ulLines - 2u], &sRec);
+  if ((sRec.ulMin != 0u) || (sRec.ulMax != 0u) || (sRec.ulMean != 0u)) vChkFail("empty result", apcLines[ulLines - 2u]);
+
+  printf("%-14s %-4s %u records, overhead %lu\n", BENCH_FORMAT == 1 ? "json" : "csv", "ok",
+         (unsigned int)BENCH_COUNT(asExpect), ulOverhead);
+}
+
+
+/*- Main ---------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+  bool bVerbose = false;
+  int iOpt;
+
+  while ((iOpt = getopt(argc, argv, "v")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'v':
+        bVerbose = true;
+        break;
+
+      default:
+        fprintf(stderr, "usage: bench_check [-v]\n");
+        return EXIT_FAILURE;
+    }
+  }
+
+  vBENCH_Init();
+  vBENCH_RunSuite(&sBENCH_SuiteExec);
+  vBENCH_RunSuite(&sChkSuite);
+  vBENCH_Finish();
+
+  if (bVerbose) fwrite(acOutput, 1u, ulOutputLen, stdout);
+  vChkOutput();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,415 @@
+/*!****************************************************************************
+ * @file
+ * boot_sim.c
+ *
+ * @brief
+ * Loopback simulator for the serial bootloader protocol
+ *
+ * Connects the uploader side and the bootloader side of lib/bootproto
+ * through a simulated serial line instead of a UART, with the on-chip flash
+ * modelled at page level: erase and program take their typical time, and
+ * programming a page that is not erased is reported as an error. The target
+ * receives frames into BOOT_WINDOW buffers as with DMA, so a frame arrives
+ * while the previous one is being programmed. After a RESEND, it discards
+ * frames still on the line, like the bootloader waiting for the line to go
+ * idle.
+ *
+ * Frames can be corrupted or truncated and responses lost at random. The
+ * uploaded image must end up in flash byte for byte with a valid vector
+ * table. Further checks: an image that does not fit, a wrong image CRC and
+ * an interrupted upload must all leave no startable application.
+ *
+ * Prints transfer time and throughput in simulated time; exits with failure
+ * status on the first error.
+ *
+ * Usage: boot_sim [-n <bytes>] [-b <baud>] [-e <N>] [-l <N>] [-r <N>] [-s <seed>]
+ *   -n <bytes>   Image size (default 40000)
+ *   -b <baud>    Line rate (default 1000000)
+ *   -e <N>       Corrupt one frame in N on average (default 0: never)
+ *   -l <N>       Truncate one frame in N on average (default 0: never)
+ *   -r <N>       Lose one response in N on average (default 0: never)
+ *   -s <seed>    Random seed
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "bootproto.h"
+#include "chk.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/*! @brief Simulated device (STM32F103x8, 8 KB bootloader, 4 KB storage)
+ *  @{                                                                        */
+#define SIM_APP_ADDR                  0x08002000uL
+#define SIM_APP_SIZE                  (52u * 1024u)
+#define SIM_RAM_BASE                  0x20000000uL
+#define SIM_RAM_SIZE                  (20u * 1024u)
+/*! @}                                                                        */
+
+/*! @brief Typical times in ns
+ *  @{                                                                        */
+#define SIM_T_ERASE                   20000000uLL   ///< Page erase
+#define SIM_T_PROGRAM                 52500uLL      ///< Half-word program
+#define SIM_T_IDLE                    1000000uLL    ///< Idle line detection after RESEND
+#define SIM_T_FRAME_TIMEOUT           20000000uLL   ///< Bootloader gives up on a partial frame
+#define SIM_T_HOST_TIMEOUT            500000000uLL  ///< Uploader waits for a response
+/*! @}                                                                        */
+
+/// Frames on the line at most
+#define SIM_LINE_DEPTH                8u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Frame on the line
+typedef struct {
+  uint8_t aucData[BOOT_FRAME_SIZE]; ///< Frame as sent
+  uint64_t ullArrival;            ///< Time of last byte at target
+  bool bTruncated;                ///< Bytes lost, target times out
+} SimFrameTypeDef;
+
+/// Response on the line
+typedef struct {
+  uint8_t aucData[BOOT_RESP_SIZE]; ///< Response
+  uint64_t ullArrival;            ///< Time of last byte at host
+  bool bLost;                     ///< Not received by host
+} SimRespTypeDef;
+
+/// Fault injection rates (one in N, 0 for never)
+typedef struct {
+  unsigned int uiCorrupt;         ///< Frames corrupted
+  unsigned int uiTruncate;        ///< Frames truncated
+  unsigned int uiLoseResp;        ///< Responses lost
+} SimFaultsTypeDef;
+
+/// Upload result
+typedef struct {
+  BOOT_StatusTypeDef eStatus;     ///< Final status (DONE, or error)
+  uint64_t ullTime;               ///< Simulated duration in ns
+  uint32_t ulFrames;              ///< Frames sent
+  uint32_t ulResends;             ///< Go-backs of the uploader
+  uint32_t ulDrains;              ///< Line drains of the target
+} SimResultTypeDef;
+
+
+/*- Private functions --------------------------------------------------------*/
+static bool bSimErase(uint32_t ulOffset);
+static bool bSimProgram(uint32_t ulOffset, const uint8_t* pucData);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Application flash region
+static uint8_t aucFlash[SIM_APP_SIZE];
+static const BOOT_FlashTypeDef sFlash = {
+  .pucBase = aucFlash,
+  .ulAddr = SIM_APP_ADDR,
+  .ulSize = SIM_APP_SIZE,
+  .pfnErase = bSimErase,
+  .pfnProgram = bSimProgram
+};
+
+/// Flash busy time of the current frame
+static uint64_t ullFlashTime;
+
+/// Byte time on the line in ns
+static uint64_t ullByteTime;
+
+/// Status names
+static const char* const apcStatus[] = {
+  "ACK", "READY", "RESEND", "DONE", "SIZE", "ORDER", "FLASH", "CRC"
+};
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Flash driver: erase page
+ *
+ * @param[in] ulOffset  Page offset in region
+ * @return  (bool)  Success
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimErase(uint32_t ulOffset)
+{
+  if (((ulOffset % BOOT_PAGE_SIZE) != 0u) || (ulOffset >= SIM_APP_SIZE)) vCHK_Exit("erase outside region");
+  (void)memset(&aucFlash[ulOffset], 0xFF, BOOT_PAGE_SIZE);
+  ullFlashTime += SIM_T_ERASE;
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Flash driver: program page
+ *
+ * @param[in] ulOffset  Page offset in region
+ * @param[in] *pucData  Page data
+ * @return  (bool)  Success
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimProgram(uint32_t ulOffset, const uint8_t* pucData)
+{
+  if (((ulOffset % BOOT_PAGE_SIZE) != 0u) || (ulOffset >= SIM_APP_SIZE)) vCHK_Exit("program outside region");
+  for (uint32_t i = 0u; i < BOOT_PAGE_SIZE; ++i)
+  {
+    if (aucFlash[ulOffset + i] != 0xFFu) vCHK_Exit("programming a page that is not erased");
+    aucFlash[ulOffset + i] = pucData[i];
+  }
+  ullFlashTime += SIM_T_PROGRAM * (BOOT_PAGE_SIZE / 2u);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Upload image through the simulated line
+ *
+ * @param[in] *pucImage   Image
+ * @param[in] ulLength    Image length in bytes
+ * @param[in] *psFaults   Fault injection rates
+ * @param[in] ulCrcXor    Value XORed into the image CRC sent (0: correct)
+ * @param[in] ulStopAfter Stop uploader after this many frames (0: never)
+ * @param[out] *psResult  Result
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimUpload(const uint8_t* pucImage, uint32_t ulLength, const SimFaultsTypeDef* psFaults,
+                       uint32_t ulCrcXor, uint32_t ulStopAfter, SimResultTypeDef* psResult)
+{
+  static BOOT_TargetTypeDef sTarget;
+  static SimFrameTypeDef asLine[SIM_LINE_DEPTH];
+  BOOT_HostTypeDef sHost;
+  static SimRespTypeDef asResp[SIM_LINE_DEPTH];
+  uint32_t ulHead = 0u;
+  uint32_t ulCount = 0u;
+  uint32_t ulRespHead = 0u;
+  uint32_t ulRespCount = 0u;
+  uint64_t ullHostNow = 0u;
+  uint64_t ullLineFree = 0u;
+  uint64_t ullTargetFree = 0u;
+  uint64_t ullLastResp = 0u;
+
+  vBOOT_TargetInit(&sTarget, &sFlash);
+  vBOOT_HostInit(&sHost, pucImage, ulLength);
+  sHost.ulCrc ^= ulCrcXor;
+  (void)memset(psResult, 0, sizeof(*psResult));
+  psResult->eStatus = BOOT_STATUS_ACK;
+
+  while (!bBOOT_HostIsDone(&sHost))
+  {
+    // Uploader sends as far as the window allows
+    while ((ulStopAfter == 0u) || (psResult->ulFrames < ulStopAfter))
+    {
+      if (ulCount == SIM_LINE_DEPTH) vCHK_Exit("line overflow, window not respected");
+      SimFrameTypeDef* psFrame = &asLine[(ulHead + ulCount) % SIM_LINE_DEPTH];
+      if (!bBOOT_HostNextFrame(&sHost, psFrame->aucData)) break;
+      uint64_t ullStart = (ullHostNow > ullLineFree) ? ullHostNow : ullLineFree;
+      psFrame->ullArrival = ullStart + ullByteTime * BOOT_FRAME_SIZE;
+      psFrame->bTruncated = bCHK_Chance(psFaults->uiTruncate);
+      if (bCHK_Chance(psFaults->uiCorrupt)) psFrame->aucData[(unsigned int)rand() % BOOT_FRAME_SIZE] ^= 0x10u;
+      ullLineFree = psFrame->ullArrival;
+      ulCount++;
+      psResult->ulFrames++;
+    }
+
+    // Next event: target takes a frame, response arrives, or uploader times out
+    uint64_t ullTarget = UINT64_MAX;
+    if (ulCount > 0u)
+    {
+      const SimFrameTypeDef* psFrame = &asLine[ulHead];
+      ullTarget = psFrame->ullArrival + (psFrame->bTruncated ? SIM_T_FRAME_TIMEOUT : 0u);
+      if (ullTarget < ullTargetFree) ullTarget = ullTargetFree;
+    }
+    uint64_t ullResp = (ulRespCount > 0u) ? asResp[ulRespHead].ullArrival : UINT64_MAX;
+    if ((ullTarget == UINT64_MAX) && (ullResp == UINT64_MAX))
+    {
+      if ((ulStopAfter != 0u) && (psResult->ulFrames >= ulStopAfter)) break;
+      ullHostNow = ullLastResp + SIM_T_HOST_TIMEOUT;
+      if (ullHostNow < ullTargetFree) ullHostNow = ullTargetFree;
+      ullLastResp = ullHostNow;
+      vBOOT_HostTimeout(&sHost);
+      continue;
+    }
+
+    if (ullTarget < ullResp)
+    {
+      // Target processes frame
+      SimFrameTypeDef* psFrame = &asLine[ulHead];
+      ulHead = (ulHead + 1u) % SIM_LINE_DEPTH;
+      ulCount--;
+      if (psFrame->bTruncated) psFrame->aucData[BOOT_FRAME_CRC] ^= 0xFFu;
+
+      uint8_t aucResp[BOOT_RESP_SIZE];
+      ullFlashTime = 0u;
+      BOOT_StatusTypeDef eStatus = eBOOT_TargetFrame(&sTarget, psFrame->aucData, aucResp);
+      ullTargetFree = ullTarget + ullFlashTime;
+      if (eStatus == BOOT_STATUS_RESEND)
+      {
+        // Wait for idle line, frames still on it are lost
+        if ((ulCount > 0u) && (ullLineFree > ullTargetFree)) ullTargetFree = ullLineFree;
+        ullTargetFree += SIM_T_IDLE;
+        ulCount = 0u;
+        psResult->ulDrains++;
+      }
+      if (ulRespCount == SIM_LINE_DEPTH) vCHK_Exit("response overrun");
+      SimRespTypeDef* psResp = &asResp[(ulRespHead + ulRespCount) % SIM_LINE_DEPTH];
+      (void)memcpy(psResp->aucData, aucResp, BOOT_RESP_SIZE);
+      psResp->ullArrival = ullTargetFree + ullByteTime * BOOT_RESP_SIZE;
+      psResp->bLost = bCHK_Chance(psFaults->uiLoseResp);
+      ulRespCount++;
+    }
+    else
+    {
+      // Uploader handles response
+      const SimRespTypeDef* psResp = &asResp[ulRespHead];
+      ulRespHead = (ulRespHead + 1u) % SIM_LINE_DEPTH;
+      ulRespCount--;
+      ullHostNow = psResp->ullArrival;
+      if (psResp->bLost) continue;
+      ullLastResp = ullHostNow;
+      BOOT_StatusTypeDef eStatus = eBOOT_HostResponse(&sHost, psResp->aucData);
+      if (eStatus >= BOOT_STATUS_SIZE)
+      {
+        psResult->eStatus = eStatus;
+        break;
+      }
+      if (eStatus == BOOT_STATUS_DONE) psResult->eStatus = eStatus;
+    }
+  }
+
+  psResult->ullTime = ullHostNow;
+  psResult->ulResends = sHost.ulResends;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Generate image with valid vector table
+ *
+ * @param[out] *pucImage  Image
+ * @param[in] ulLength    Image length in bytes (at least 8)
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimMakeImage(uint8_t* pucImage, uint32_t ulLength)
+{
+  for (uint32_t i = 0u; i < ulLength; ++i)
+  {
+    pucImage[i] = (uint8_t)rand();
+  }
+  const uint32_t aulVectors[2] = { SIM_RAM_BASE + SIM_RAM_SIZE, SIM_APP_ADDR + 0x101u };
+  for (uint32_t i = 0u; i < 8u; ++i)
+  {
+    pucImage[i] = (uint8_t)(aulVectors[i / 4u] >> (8u * (i % 4u)));
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Print result of a check and fail if unexpected
+ *
+ * @param[in] *pcName     Check name
+ * @param[in] *psResult   Upload result
+ * @param[in] eExpected   Expected final status
+ * @param[in] bAppValid   Expected application state
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimCheck(const char* pcName, const SimResultTypeDef* psResult,
+                      BOOT_StatusTypeDef eExpected, bool bAppValid)
+{
+  bool bValid = bBOOT_IsAppValid(&sFlash, SIM_RAM_BASE, SIM_RAM_SIZE);
+  bool bOk = (psResult->eStatus == eExpected) && (bValid == bAppValid);
+  printf("%-14s %-4s %-6s application %s\n", pcName, bOk ? "ok" : "FAIL",
+         apcStatus[psResult->eStatus], bValid ? "valid" : "not startable");
+  if (!bOk) exit(EXIT_FAILURE);
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Simulator entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  uint32_t ulLength = 40000u;
+  unsigned long ulBaud = 1000000uL;
+  SimFaultsTypeDef sFaults = { 0 };
+  unsigned int uiSeed = (unsigned int)time(NULL);
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "n:b:e:l:r:s:")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'n': ulLength = (uint32_t)strtoul(optarg, NULL, 0); break;
+      case 'b': ulBaud = strtoul(optarg, NULL, 0); break;
+      case 'e': sFaults.uiCorrupt = (unsigned int)strtoul(optarg, NULL, 0); break;
+      case 'l': sFaults.uiTruncate = (unsigned int)strtoul(optarg, NULL, 0); break;
+      case 'r': sFaults.uiLoseResp = (unsigned int)strtoul(optarg, NULL, 0); break;
+      case 's': uiSeed = (unsigned int)strtoul(optarg, NULL, 0); break;
+      default:
+        fprintf(stderr, "Usage: %s [-n <bytes>] [-b <baud>] [-e <N>] [-l <N>] [-r <N>] [-s <seed>]\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  if ((ulLength < 8u) || (ulLength > SIM_APP_SIZE) || (ulBaud == 0uL))
+  {
+    fprintf(stderr, "image size must be 8 to %u bytes\n", SIM_APP_SIZE);
+    return EXIT_FAILURE;
+  }
+  printf("seed %u\n", uiSeed);
+  srand(uiSeed);
+  ullByteTime = 10000000000uLL / ulBaud;
+  (void)memset(aucFlash, 0xFF, sizeof(aucFlash));
+
+  static uint8_t aucImage[SIM_APP_SIZE + BOOT_PAGE_SIZE];
+  const SimFaultsTypeDef sNoFaults = { 0 };
+  SimResultTypeDef sResult;
+
+  // Upload with faults, compare flash
+  vSimMakeImage(aucImage, ulLength);
+  vSimUpload(aucImage, ulLength, &sFaults, 0uL, 0u, &sResult);
+  vSimCheck("upload", &sResult, BOOT_STATUS_DONE, true);
+  if (memcmp(aucFlash, aucImage, ulLength) != 0) vCHK_Exit("flash differs from image");
+  double dSec = (double)sResult.ullTime * 1e-9;
+  printf("  %u bytes in %.3f s (%.1f KB/s), %u frames, %u go-backs, %u drains\n",
+         ulLength, dSec, (double)ulLength / 1024.0 / dSec, sResult.ulFrames,
+         sResult.ulResends, sResult.ulDrains);
+
+  // Image too large for region
+  vSimMakeImage(aucImage, SIM_APP_SIZE + 1u);
+  vSimUpload(aucImage, SIM_APP_SIZE + 1u, &sNoFaults, 0uL, 0u, &sResult);
+  vSimCheck("too large", &sResult, BOOT_STATUS_SIZE, true);
+
+  // Wrong CRC: nothing committed, previous application invalidated
+  vSimMakeImage(aucImage, ulLength);
+  vSimUpload(aucImage, ulLength, &sNoFaults, 1uL, 0u, &sResult);
+  vSimCheck("wrong CRC", &sResult, BOOT_STATUS_CRC, false);
+
+  // Interrupted after half of the frames
+  vSimUpload(aucImage, ulLength, &sNoFaults, 0uL, 0u, &sResult);
+  vSimCheck("upload again", &sResult, BOOT_STATUS_DONE, true);
+  uint32_t ulHalf = (ulLength / BOOT_PAGE_SIZE + 3u) / 2u;
+  vSimUpload(aucImage, ulLength, &sNoFaults, 0uL, ulHalf, &sResult);
+  vSimCheck("interrupted", &sResult, BOOT_STATUS_ACK, false);
+
+  // Smallest image, then the full region
+  vSimMakeImage(aucImage, 8u);
+  vSimUpload(aucImage, 8u, &sFaults, 0uL, 0u, &sResult);
+  vSimCheck("8 bytes", &sResult, BOOT_STATUS_DONE, true);
+  vSimMakeImage(aucImage, SIM_APP_SIZE);
+  vSimUpload(aucImage, SIM_APP_SIZE, &sFaults, 0uL, 0u, &sResult);
+  vSimCheck("full region", &sResult, BOOT_STATUS_DONE, true);
+  if (memcmp(aucFlash, aucImage, SIM_APP_SIZE) != 0) vCHK_Exit("flash differs from image");
+
+  return EXIT_SUCCESS;
+}
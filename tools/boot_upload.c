@@ -0,0 +1,348 @@
+/*!****************************************************************************
+ * @file
+ * boot_upload.c
+ *
+ * @brief
+ * Upload an application image to the serial bootloader
+ *
+ * Sends probe bytes until the bootloader answers (reset the board or enter
+ * "update" in the shell meanwhile), then transfers the image with the
+ * protocol in lib/bootproto.c: BOOT_WINDOW frames in flight, go-back on
+ * RESEND or when no response arrives in time. The image is the raw binary
+ * of the application linked behind the bootloader (hello-stm32f103.bin when
+ * built with BOOTLOADER=ON).
+ *
+ * The serial port is used in raw mode, 8N1 without flow control.
+ *
+ * Usage: boot_upload [-b <baud>] [-a <address>] [-w <s>] <device> <image>
+ *   -b <baud>      Line rate (default 1000000)
+ *   -a <address>   Application start address (default 0x08002000)
+ *   -w <s>         Time to wait for the bootloader (default 30)
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "bootproto.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Largest image in bytes
+#define UPLOAD_MAX_SIZE               (1024u * 1024u)
+
+/// Application region size for the image check (STM32F103x8 with bootloader and storage)
+#define UPLOAD_APP_SIZE               (52u * 1024u)
+
+/*! @brief RAM region for the image check
+ *  @{                                                                        */
+#define UPLOAD_RAM_BASE               0x20000000uL
+#define UPLOAD_RAM_SIZE               (20u * 1024u)
+/*! @}                                                                        */
+
+/*! @brief Timing in ms
+ *  @{                                                                        */
+#define UPLOAD_PROBE_INTERVAL         5             ///< Probe byte repetition
+#define UPLOAD_RESP_TIMEOUT           500           ///< Response to a frame
+/*! @}                                                                        */
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Supported line rates
+typedef struct {
+  unsigned long ulBaud;           ///< Bits per second
+  speed_t tSpeed;                 ///< termios constant
+} UploadBaudTypeDef;
+
+
+/*- Private data -------------------------------------------------------------*/
+static const UploadBaudTypeDef asBaudRates[] = {
+  { 115200uL, B115200 }, { 230400uL, B230400 }, { 460800uL, B460800 }, { 500000uL, B500000 },
+  { 921600uL, B921600 }, { 1000000uL, B1000000 }, { 2000000uL, B2000000 }
+};
+
+/// Status names
+static const char* const apcStatus[] = {
+  "ACK", "READY", "RESEND", "DONE", "image too large", "protocol order", "flash error", "image CRC mismatch"
+};
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Monotonic time
+ *
+ * @return  (double)  Time in seconds
+ * @date  19.10.2026
+ ******************************************************************************/
+static double dUploadNow(void)
+{
+  struct timespec sTs;
+  (void)clock_gettime(CLOCK_MONOTONIC, &sTs);
+  return (double)sTs.tv_sec + (double)sTs.tv_nsec * 1e-9;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Open serial port in raw mode
+ *
+ * @param[in] *pcDevice   Device path
+ * @param[in] ulBaud      Line rate
+ * @return  (int)   File descriptor, -1 on error
+ * @date  19.10.2026
+ ******************************************************************************/
+static int iUploadOpen(const char* pcDevice, unsigned long ulBaud)
+{
+  speed_t tSpeed = B0;
+  for (size_t i = 0u; i < sizeof(asBaudRates) / sizeof(asBaudRates[0]); ++i)
+  {
+    if (asBaudRates[i].ulBaud == ulBaud) tSpeed = asBaudRates[i].tSpeed;
+  }
+  if (tSpeed == B0)
+  {
+    fprintf(stderr, "unsupported baud rate %lu\n", ulBaud);
+    return -1;
+  }
+
+  int iFd = open(pcDevice, O_RDWR | O_NOCTTY);
+  if (iFd < 0)
+  {
+    fprintf(stderr, "cannot open %s: %s\n", pcDevice, strerror(errno));
+    return -1;
+  }
+  struct termios sTio;
+  if (tcgetattr(iFd, &sTio) != 0)
+  {
+    fprintf(stderr, "%s is not a serial port\n", pcDevice);
+    (void)close(iFd);
+    return -1;
+  }
+  cfmakeraw(&sTio);
+  sTio.c_cflag |= CLOCAL | CREAD;
+  sTio.c_cflag &= ~(CSTOPB | CRTSCTS);
+  sTio.c_cc[VMIN] = 0;
+  sTio.c_cc[VTIME] = 0;
+  (void)cfsetispeed(&sTio, tSpeed);
+  (void)cfsetospeed(&sTio, tSpeed);
+  if (tcsetattr(iFd, TCSANOW, &sTio) != 0)
+  {
+    fprintf(stderr, "cannot configure %s: %s\n", pcDevice, strerror(errno));
+    (void)close(iFd);
+    return -1;
+  }
+  (void)tcflush(iFd, TCIOFLUSH);
+  return iFd;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write all bytes
+ *
+ * @param[in] iFd       Serial port
+ * @param[in] *pucData  Data
+ * @param[in] ulLen     Number of bytes
+ * @return  (bool)  Success
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bUploadWrite(int iFd, const uint8_t* pucData, size_t ulLen)
+{
+  while (ulLen > 0u)
+  {
+    ssize_t lRet = write(iFd, pucData, ulLen);
+    if (lRet < 0)
+    {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    pucData += lRet;
+    ulLen -= (size_t)lRet;
+  }
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Receive response, skipping bytes before the sync byte
+ *
+ * @param[in] iFd         Serial port
+ * @param[out] *pucResp   Response, BOOT_RESP_SIZE bytes
+ * @param[in] iTimeoutMs  Timeout in ms
+ * @return  (bool)  Response received
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bUploadReadResponse(int iFd, uint8_t* pucResp, int iTimeoutMs)
+{
+  double dEnd = dUploadNow() + iTimeoutMs * 1e-3;
+  size_t ulLen = 0u;
+  while (ulLen < BOOT_RESP_SIZE)
+  {
+    int iLeft = (int)((dEnd - dUploadNow()) * 1e3);
+    struct pollfd sPoll = { .fd = iFd, .events = POLLIN };
+    if ((iLeft <= 0) || (poll(&sPoll, 1, iLeft) <= 0)) return false;
+    if (read(iFd, &pucResp[ulLen], 1u) != 1) continue;
+    if ((ulLen > 0u) || (pucResp[0] == BOOT_SYNC_RESP)) ulLen++;
+  }
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Probe until the bootloader answers
+ *
+ * @param[in] iFd       Serial port
+ * @param[in] iWaitSec  Timeout in s
+ * @return  (bool)  Bootloader ready
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bUploadConnect(int iFd, int iWaitSec)
+{
+  const uint8_t ucProbe = BOOT_PROBE;
+  uint8_t aucResp[BOOT_RESP_SIZE];
+  double dEnd = dUploadNow() + iWaitSec;
+
+  printf("waiting for bootloader (reset the board or enter \"update\")\n");
+  while (dUploadNow() < dEnd)
+  {
+    if (!bUploadWrite(iFd, &ucProbe, 1u)) return false;
+    if (bUploadReadResponse(iFd, aucResp, UPLOAD_PROBE_INTERVAL) &&
+        (aucResp[BOOT_RESP_STATUS] == BOOT_STATUS_READY))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Transfer image
+ *
+ * @param[in] iFd         Serial port
+ * @param[in] *pucImage   Image
+ * @param[in] ulLength    Image length in bytes
+ * @return  (bool)  Image committed
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bUploadSend(int iFd, const uint8_t* pucImage, uint32_t ulLength)
+{
+  BOOT_HostTypeDef sHost;
+  uint8_t aucFrame[BOOT_FRAME_SIZE];
+  uint8_t aucResp[BOOT_RESP_SIZE];
+  double dStart = dUploadNow();
+  uint32_t ulShown = UINT32_MAX;
+
+  vBOOT_HostInit(&sHost, pucImage, ulLength);
+  while (!bBOOT_HostIsDone(&sHost))
+  {
+    while (bBOOT_HostNextFrame(&sHost, aucFrame))
+    {
+      if (!bUploadWrite(iFd, aucFrame, BOOT_FRAME_SIZE))
+      {
+        fprintf(stderr, "\nwrite error: %s\n", strerror(errno));
+        return false;
+      }
+    }
+
+    if (!bUploadReadResponse(iFd, aucResp, UPLOAD_RESP_TIMEOUT))
+    {
+      vBOOT_HostTimeout(&sHost);
+      continue;
+    }
+    BOOT_StatusTypeDef eStatus = eBOOT_HostResponse(&sHost, aucResp);
+    if (eStatus >= BOOT_STATUS_SIZE)
+    {
+      fprintf(stderr, "\nbootloader: %s\n", (eStatus <= BOOT_STATUS_CRC) ? apcStatus[eStatus] : "unknown error");
+      return false;
+    }
+
+    uint32_t ulPercent = sHost.ulAcked * 100u / (sHost.ulEndSeq + 1u);
+    if (ulPercent != ulShown)
+    {
+      ulShown = ulPercent;
+      printf("\r%3u%%", ulPercent);
+      (void)fflush(stdout);
+    }
+  }
+
+  double dSec = dUploadNow() - dStart;
+  printf("\r%u bytes in %.2f s (%.1f KB/s), %u go-backs\n",
+         ulLength, dSec, (double)ulLength / 1024.0 / dSec, sHost.ulResends);
+  return true;
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Uploader entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  unsigned long ulBaud = 1000000uL;
+  uint32_t ulAddr = 0x08002000uL;
+  int iWaitSec = 30;
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "b:a:w:")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'b': ulBaud = strtoul(optarg, NULL, 0); break;
+      case 'a': ulAddr = (uint32_t)strtoul(optarg, NULL, 0); break;
+      case 'w': iWaitSec = atoi(optarg); break;
+      default:
+        fprintf(stderr, "Usage: %s [-b <baud>] [-a <address>] [-w <s>] <device> <image>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  if (argc - optind != 2)
+  {
+    fprintf(stderr, "Usage: %s [-b <baud>] [-a <address>] [-w <s>] <device> <image>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  static uint8_t aucImage[UPLOAD_MAX_SIZE];
+  FILE* psIn = fopen(argv[optind + 1], "rb");
+  if (psIn == NULL)
+  {
+    fprintf(stderr, "cannot open %s\n", argv[optind + 1]);
+    return EXIT_FAILURE;
+  }
+  uint32_t ulLength = (uint32_t)fread(aucImage, 1u, sizeof(aucImage), psIn);
+  (void)fclose(psIn);
+
+  // Same check as the bootloader applies before starting the image
+  const BOOT_FlashTypeDef sImage = { .pucBase = aucImage, .ulAddr = ulAddr, .ulSize = UPLOAD_APP_SIZE };
+  if ((ulLength < 8u) || !bBOOT_IsAppValid(&sImage, UPLOAD_RAM_BASE, UPLOAD_RAM_SIZE))
+  {
+    fprintf(stderr, "%s is not an image linked at 0x%08X\n", argv[optind + 1], ulAddr);
+    return EXIT_FAILURE;
+  }
+
+  int iFd = iUploadOpen(argv[optind], ulBaud);
+  if (iFd < 0) return EXIT_FAILURE;
+  if (!bUploadConnect(iFd, iWaitSec))
+  {
+    fprintf(stderr, "no answer from bootloader\n");
+    (void)close(iFd);
+    return EXIT_FAILURE;
+  }
+  bool bOk = bUploadSend(iFd, aucImage, ulLength);
+  (void)close(iFd);
+  return bOk ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,435 @@
+/*!****************************************************************************
+ * @file
+ * capt_check.c
+ *
+ * @brief
+ * Host check of the input capture timestamp extension and batch statistics
+ *
+ * Simulates the capture pipeline of hw_capture at tick level: a 16-bit
+ * counter, the half period interrupt updating the stamp after a random or
+ * forced latency, and one DMA burst per rising edge after a random delay,
+ * reading the rising and falling capture registers and the stamp. The
+ * records are passed to lib/capture in batches of random size, each with the
+ * half period count at processing time, as the consumer in hw_capture does.
+ *
+ * Every timestamp must equal the true edge time plus the origin, and every
+ * batch must match statistics computed from the true edges (periods, span,
+ * minimum and maximum, high time where high and low time are shorter than
+ * one counter period), along with frequency and duty cycle.
+ *
+ * Signals: fixed frequencies from 50 kHz down to 2 Hz, edges placed around
+ * half period boundaries at worst-case latencies, gaps of up to 50 s (over
+ * the 16-bit stamp range), and random periods and duty cycles.
+ *
+ * Exits with failure status on the first error.
+ *
+ * Usage: capt_check [-n <N>] [-l <ticks>] [-d <ticks>] [-s <seed>]
+ *   -n <N>       Edges in the random run (default 200000)
+ *   -l <ticks>   Longest interrupt latency (default and limit 16383)
+ *   -d <ticks>   Longest DMA delay (default 256, limit 719)
+ *   -s <seed>    Random seed
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "capture.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Counter clock in Hz (full timer clock)
+#define SIM_CLOCK                     72000000uL
+
+/// Counter period in ticks
+#define SIM_PERIOD                    (2uL * CAPT_HALF)
+
+/// Latency limit (quarter counter period, exclusive)
+#define SIM_LATENCY_LIMIT             (CAPT_HALF / 2uL)
+
+/// DMA delay limit (below the shortest high time, exclusive)
+#define SIM_DELAY_LIMIT               720uL
+
+/// Ticks covered by the 16-bit stamp
+#define SIM_STAMP_RANGE               (0x10000uLL * CAPT_HALF)
+
+/// Largest batch, as the hw_capture buffer
+#define SIM_BATCH_MAX                 127u
+
+/// Most edges per scenario
+#define SIM_EDGES_MAX                 400000u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Interrupt latency of half period boundaries
+typedef enum {
+  SIM_LAT_RANDOM = 0,             ///< Random up to the longest latency
+  SIM_LAT_ALTERNATE               ///< Zero and longest latency in turn
+} SimLatencyTypeDef;
+
+/// Signal: true edge times in ticks since counter start
+typedef struct {
+  uint64_t* pullRise;             ///< Rising edges
+  uint64_t* pullFall;             ///< Falling edge after each rising edge
+  uint32_t ulCount;               ///< Number of periods
+} SimSignalTypeDef;
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Longest interrupt latency and DMA delay in ticks
+static uint32_t ulMaxLatency = SIM_LATENCY_LIMIT - 1uL;
+static uint32_t ulMaxDelay = 256uL;
+
+/// Latency mode
+static SimLatencyTypeDef eLatency;
+
+/// Random latency seed, for a fixed latency per boundary
+static uint64_t ullLatencySeed;
+
+/// Signal buffers
+static uint64_t aullRise[SIM_EDGES_MAX];
+static uint64_t aullFall[SIM_EDGES_MAX];
+
+/// Records and timestamps of one batch
+static CAPT_RawTypeDef asRaw[SIM_BATCH_MAX];
+static uint64_t aullEdges[SIM_BATCH_MAX];
+
+/// Origin added to timestamps
+static const uint64_t ullOrigin = 123456789uLL * (SIM_CLOCK / 1000uL) + 4711uLL;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Print error and exit
+ *
+ * @param[in] *pcMsg    Message
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimFail(const char* pcMsg)
+{
+  printf("error: %s\n", pcMsg);
+  exit(EXIT_FAILURE);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Random number in range
+ *
+ * @param[in] ullMax    Largest value
+ * @return  (uint64_t)  Value in 0 .. ullMax
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint64_t ullSimRand(uint64_t ullMax)
+{
+  uint64_t ullValue = ((uint64_t)(unsigned int)rand() << 31) ^ (uint64_t)(unsigned int)rand();
+  return ullValue % (ullMax + 1uLL);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Interrupt latency of a half period boundary
+ *
+ * @param[in] ullBoundary   Boundary number (1: first counter value 0x8000)
+ * @return  (uint64_t)  Latency in ticks
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint64_t ullSimLatency(uint64_t ullBoundary)
+{
+  if (eLatency == SIM_LAT_ALTERNATE)
+  {
+    return ((ullBoundary & 1uLL) != 0uLL) ? 0uLL : ulMaxLatency;
+  }
+
+  uint64_t ullHash = (ullBoundary + ullLatencySeed) * 0x9E3779B97F4A7C15uLL;
+  ullHash ^= ullHash >> 29;
+  return ullHash % (ulMaxLatency + 1uLL);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Half periods counted by the interrupt at a time
+ *
+ * @param[in] ullTime   Ticks since counter start
+ * @return  (uint64_t)  Half period count
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint64_t ullSimHalves(uint64_t ullTime)
+{
+  uint64_t ullBoundary = ullTime / CAPT_HALF;
+  if ((ullBoundary > 0uLL) && (ullBoundary * CAPT_HALF + ullSimLatency(ullBoundary) > ullTime))
+  {
+    ullBoundary--;
+  }
+  return ullBoundary;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check that the true high time can be measured
+ *
+ * @param[in] ullHigh   High time
+ * @param[in] ullLow    Low time
+ * @return  (bool)  High time unique from the captures
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimHighKnown(uint64_t ullHigh, uint64_t ullLow)
+{
+  return (ullLow != 0uLL) && (ullLow < SIM_PERIOD) && (ullHigh <= SIM_PERIOD);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run signal through the simulated pipeline and check all batches
+ *
+ * @param[in] *pcName   Scenario
+ * @param[in] *psSig    Signal
+ * @return  (bool)  All timestamps and batches correct
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimRun(const char* pcName, const SimSignalTypeDef* psSig)
+{
+  CAPT_TypeDef sCapt;
+  vCAPT_Init(&sCapt, ullOrigin);
+
+  uint32_t ulFall = 0u;
+  uint64_t ullLastFall = 0uLL;
+  bool bHaveFall = false;
+  uint32_t ulBatches = 0u;
+  uint32_t ulDuty = 0u;
+  uint32_t i = 0u;
+
+  while (i < psSig->ulCount)
+  {
+    uint32_t ulLen = 1u + (uint32_t)ullSimRand(SIM_BATCH_MAX - 1u);
+    if (ulLen > psSig->ulCount - i) ulLen = psSig->ulCount - i;
+
+    // Records are fetched well within the stamp range
+    for (uint32_t j = 1u; j < ulLen; ++j)
+    {
+      if (psSig->pullRise[i + j] - psSig->pullRise[i] > SIM_STAMP_RANGE / 2uLL) ulLen = j;
+    }
+
+    // DMA bursts
+    uint64_t ullTransfer = 0uLL;
+    for (uint32_t j = 0u; j < ulLen; ++j)
+    {
+      uint64_t ullRise = psSig->pullRise[i + j];
+      uint64_t ullBurst = ullRise + ullSimRand(ulMaxDelay);
+      if (ullBurst > ullTransfer) ullTransfer = ullBurst;
+      while ((ulFall < i + j) && (psSig->pullFall[ulFall] <= ullTransfer))
+      {
+        ullLastFall = psSig->pullFall[ulFall++];
+        bHaveFall = true;
+      }
+      asRaw[j].uiRise = (uint16_t)ullRise;
+      asRaw[j].uiFall = bHaveFall ? (uint16_t)ullLastFall : 0u;
+      asRaw[j].uiHalves = (uint16_t)ullSimHalves(ullTransfer);
+    }
+
+    // Consumer runs after the last burst
+    uint64_t ullNow = ullSimHalves(ullTransfer + ullSimRand(ulMaxDelay));
+    CAPT_BatchTypeDef sBatch;
+    vCAPT_ClearBatch(&sBatch);
+    vCAPT_Process(&sCapt, asRaw, ulLen, ullNow, &sBatch, aullEdges);
+
+    // Expected statistics from the true edges
+    CAPT_BatchTypeDef sExp;
+    vCAPT_ClearBatch(&sExp);
+    sExp.ulEdges = ulLen;
+    sExp.ullFirst = ullOrigin + psSig->pullRise[i];
+    sExp.ullLast = ullOrigin + psSig->pullRise[i + ulLen - 1u];
+    for (uint32_t j = 0u; j < ulLen; ++j)
+    {
+      uint32_t n = i + j;
+      if (aullEdges[j] != ullOrigin + psSig->pullRise[n])
+      {
+        printf("  edge %u at %llu extended to %llu\n", n,
+               (unsigned long long)psSig->pullRise[n],
+               (unsigned long long)(aullEdges[j] - ullOrigin));
+        return false;
+      }
+      if (n == 0u) continue;
+
+      uint64_t ullPeriod = psSig->pullRise[n] - psSig->pullRise[n - 1u];
+      uint32_t ulPeriod = (ullPeriod > UINT32_MAX) ? UINT32_MAX : (uint32_t)ullPeriod;
+      if (ulPeriod < sExp.ulPeriodMin) sExp.ulPeriodMin = ulPeriod;
+      if (ulPeriod > sExp.ulPeriodMax) sExp.ulPeriodMax = ulPeriod;
+      sExp.ullSpan += ullPeriod;
+      sExp.ulPeriods++;
+
+      uint64_t ullHigh = psSig->pullFall[n - 1u] - psSig->pullRise[n - 1u];
+      if (bSimHighKnown(ullHigh, ullPeriod - ullHigh))
+      {
+        sExp.ullHigh += ullHigh;
+        sExp.ullHighSpan += ullPeriod;
+      }
+    }
+
+    if ((sBatch.ulEdges != sExp.ulEdges) || (sBatch.ulPeriods != sExp.ulPeriods) ||
+        (sBatch.ullFirst != sExp.ullFirst) || (sBatch.ullLast != sExp.ullLast) ||
+        (sBatch.ulPeriodMin != sExp.ulPeriodMin) || (sBatch.ulPeriodMax != sExp.ulPeriodMax) ||
+        (sBatch.ullSpan != sExp.ullSpan) || (sBatch.ullHigh != sExp.ullHigh) ||
+        (sBatch.ullHighSpan != sExp.ullHighSpan) ||
+        (ulCAPT_GetFreq(&sBatch, SIM_CLOCK) != ulCAPT_GetFreq(&sExp, SIM_CLOCK)) ||
+        (uiCAPT_GetDuty(&sBatch) != uiCAPT_GetDuty(&sExp)))
+    {
+      printf("  batch %u (edges %u..%u) statistics differ\n", ulBatches, i, i + ulLen - 1u);
+      return false;
+    }
+    if (sExp.ullHighSpan != 0uLL) ulDuty++;
+    ulBatches++;
+    i += ulLen;
+  }
+
+  printf("%-14s %-4s %6u edges %5u batches %5u with duty over %.3f s\n", pcName, "ok",
+         psSig->ulCount, ulBatches, ulDuty,
+         (double)psSig->pullRise[psSig->ulCount - 1u] / SIM_CLOCK);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run signal and exit on failure
+ *
+ * @param[in] *pcName   Scenario
+ * @param[in] *psSig    Signal
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimCheck(const char* pcName, const SimSignalTypeDef* psSig)
+{
+  if (!bSimRun(pcName, psSig))
+  {
+    printf("%-14s FAIL\n", pcName);
+    exit(EXIT_FAILURE);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Generate periodic signal
+ *
+ * @param[out] *psSig     Signal
+ * @param[in] ulCount     Number of periods
+ * @param[in] ullStart    First rising edge
+ * @param[in] ullPeriod   Period in ticks
+ * @param[in] ullHigh     High time in ticks
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimPeriodic(SimSignalTypeDef* psSig, uint32_t ulCount, uint64_t ullStart,
+                         uint64_t ullPeriod, uint64_t ullHigh)
+{
+  psSig->ulCount = ulCount;
+  for (uint32_t i = 0u; i < ulCount; ++i)
+  {
+    psSig->pullRise[i] = ullStart + i * ullPeriod;
+    psSig->pullFall[i] = psSig->pullRise[i] + ullHigh;
+  }
+}
+
+
+/*- Main ---------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+  unsigned long ulEdges = 200000uL;
+  unsigned int uiSeed = (unsigned int)time(NULL);
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "n:l:d:s:")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'n': ulEdges = strtoul(optarg, NULL, 0); break;
+      case 'l': ulMaxLatency = (uint32_t)strtoul(optarg, NULL, 0); break;
+      case 'd': ulMaxDelay = (uint32_t)strtoul(optarg, NULL, 0); break;
+      case 's': uiSeed = (unsigned int)strtoul(optarg, NULL, 0); break;
+      default:
+        fprintf(stderr, "Usage: %s [-n <N>] [-l <ticks>] [-d <ticks>] [-s <seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  if ((ulEdges < 2uL) || (ulEdges > SIM_EDGES_MAX) || (ulMaxLatency >= SIM_LATENCY_LIMIT) ||
+      (ulMaxDelay >= SIM_DELAY_LIMIT))
+  {
+    vSimFail("option out of range");
+  }
+  printf("seed %u\n", uiSeed);
+  srand(uiSeed);
+  ullLatencySeed = ullSimRand(UINT32_MAX);
+
+  SimSignalTypeDef sSig = { .pullRise = aullRise, .pullFall = aullFall };
+
+  // Extension of single counts around every boundary of a stamp cycle
+  uint32_t ulErrors = 0u;
+  for (uint64_t ullBoundary = 1uLL; ullBoundary <= 0x10002uLL; ++ullBoundary)
+  {
+    for (uint64_t ullTime = ullBoundary * CAPT_HALF - 300uLL;
+         ullTime < ullBoundary * CAPT_HALF + ulMaxLatency + 300uLL; ullTime += 37uLL)
+    {
+      uint64_t ullTransfer = ullTime + ullSimRand(ulMaxDelay);
+      uint64_t ullExt = ullCAPT_Extend((uint16_t)ullTime, (uint16_t)ullSimHalves(ullTransfer),
+                                       ullSimHalves(ullTransfer + ulMaxDelay));
+      if (ullExt != ullTime) ulErrors++;
+    }
+  }
+  printf("%-14s %-4s %u errors\n", "extend", (ulErrors == 0u) ? "ok" : "FAIL", ulErrors);
+  if (ulErrors != 0u) return EXIT_FAILURE;
+
+  // Fixed frequencies: duty known while high and low time fit the counter
+  vSimPeriodic(&sSig, 20000u, 1000u, SIM_CLOCK / 50000uL, SIM_CLOCK / 100000uL);
+  vSimCheck("50 kHz 50 %", &sSig);
+  vSimPeriodic(&sSig, 5000u, 77u, SIM_CLOCK / 1000uL, SIM_CLOCK / 4000uL);
+  vSimCheck("1 kHz 25 %", &sSig);
+  vSimPeriodic(&sSig, 2000u, 5u, SIM_CLOCK / 300uL, SIM_CLOCK / 30000uL);
+  vSimCheck("300 Hz 1 %", &sSig);
+  vSimPeriodic(&sSig, 50u, 123456u, SIM_CLOCK / 2uL, SIM_CLOCK / 20uL);
+  vSimCheck("2 Hz 10 %", &sSig);
+
+  // Edges next to boundaries, zero and longest latency in turn
+  eLatency = SIM_LAT_ALTERNATE;
+  sSig.ulCount = 0u;
+  for (uint32_t i = 0u; i < 20000u; ++i)
+  {
+    uint64_t ullBoundary = (uint64_t)(i / 8u) * 3u + 1u;
+    int64_t llOffset = (int64_t)ullSimRand(2u * ulMaxLatency + 64u) - (int64_t)ulMaxLatency - 32;
+    uint64_t ullRise = (uint64_t)((int64_t)(ullBoundary * CAPT_HALF) + llOffset);
+    if ((sSig.ulCount > 0u) && (ullRise <= aullFall[sSig.ulCount - 1u] + ulMaxDelay)) continue;
+    aullRise[sSig.ulCount] = ullRise;
+    aullFall[sSig.ulCount] = ullRise + ulMaxDelay + 1u + ullSimRand(100u);
+    sSig.ulCount++;
+  }
+  vSimCheck("boundaries", &sSig);
+  eLatency = SIM_LAT_RANDOM;
+
+  // Long gaps, beyond the stamp range
+  uint64_t ullTime = 1000uLL;
+  for (uint32_t i = 0u; i < 200u; ++i)
+  {
+    aullRise[i] = ullTime;
+    aullFall[i] = ullTime + 1000u + ullSimRand(SIM_PERIOD);
+    ullTime = aullFall[i] + 1000u + ullSimRand(50uLL * SIM_CLOCK);
+  }
+  sSig.ulCount = 200u;
+  vSimCheck("gaps", &sSig);
+
+  // Random periods and duty cycles
+  ullTime = ullSimRand(SIM_PERIOD);
+  for (uint32_t i = 0u; i < ulEdges; ++i)
+  {
+    uint64_t ullScale = 1uLL << ullSimRand(20u);
+    uint64_t ullHigh = ulMaxDelay + 1u + ullSimRand(ullScale * 50u);
+    uint64_t ullLow = ulMaxDelay + 1u + ullSimRand(ullScale * 50u);
+    aullRise[i] = ullTime;
+    aullFall[i] = ullTime + ullHigh;
+    ullTime = aullFall[i] + ullLow;
+  }
+  sSig.ulCount = (uint32_t)ulEdges;
+  vSimCheck("random", &sSig);
+
+  return EXIT_SUCCESS;
+}
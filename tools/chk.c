@@ -0,0 +1,156 @@
+/*!****************************************************************************
+ * @file
+ * chk.c
+ *
+ * @brief
+ * Helpers shared by the host checks and simulators
+ *
+ * Checks that run a model to the end of a scenario record only their first
+ * failure (vCHK_Fail()) and report it with the scenario result
+ * (vCHK_Report()), at the simulated time registered with vCHK_SetClock().
+ * Simulators that stop at the first inconsistency use vCHK_Exit() instead.
+ *
+ * Random numbers come from rand() (seeded by the tool) for simple events,
+ * and from xorshift64* with a caller-held state where a sequence must not
+ * depend on other random draws, e.g. per thread or per coroutine.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include "chk.h"
+
+
+/*- Private data -------------------------------------------------------------*/
+/// First failure, NULL if none
+static const char* pcFailure;
+
+/// Simulated time reported with a failure, NULL if none
+static const char* pcClockUnit;
+static const uint32_t* pulClock;
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Record first failure
+ *
+ * @param[in] *pcMsg  Message
+ * @date  19.10.2026
+ ******************************************************************************/
+void vCHK_Fail(const char* pcMsg)
+{
+  if (pcFailure == NULL) pcFailure = pcMsg;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if a failure was recorded
+ *
+ * @return  (bool)  Failure recorded
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bCHK_Failed(void)
+{
+  return pcFailure != NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Register simulated time reported with a failure
+ *
+ * @param[in] *pcUnit   Unit name (e.g. "tick")
+ * @param[in] *pulNow   Current time
+ * @date  19.10.2026
+ ******************************************************************************/
+void vCHK_SetClock(const char* pcUnit, const uint32_t* pulNow)
+{
+  pcClockUnit = pcUnit;
+  pulClock = pulNow;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Print scenario result, exit on failure
+ *
+ * The scenario fails if bOk is false or a failure was recorded.
+ *
+ * @param[in] *pcName   Scenario
+ * @param[in] bOk       Scenario-specific checks passed
+ * @param[in] ullCount  Operations in the scenario
+ * @param[in] *pcUnit   Operation name (e.g. "calls")
+ * @date  19.10.2026
+ ******************************************************************************/
+void vCHK_Report(const char* pcName, bool bOk, uint64_t ullCount, const char* pcUnit)
+{
+  bOk = bOk && (pcFailure == NULL);
+  printf("%-14s %-4s %8llu %s", pcName, bOk ? "ok" : "FAIL", (unsigned long long)ullCount, pcUnit);
+  if ((pcFailure != NULL) && (pulClock != NULL))
+  {
+    printf("  (%s at %s %lu)", pcFailure, pcClockUnit, (unsigned long)*pulClock);
+  }
+  else if (pcFailure != NULL)
+  {
+    printf("  (%s)", pcFailure);
+  }
+  printf("\n");
+  if (!bOk) exit(EXIT_FAILURE);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Report error and exit
+ *
+ * @param[in] *pcMsg  Message
+ * @date  19.10.2026
+ ******************************************************************************/
+void vCHK_Exit(const char* pcMsg)
+{
+  fprintf(stderr, "error: %s\n", pcMsg);
+  exit(EXIT_FAILURE);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Random event with probability 1/N
+ *
+ * @param[in] uiN   Rate, 0 for never
+ * @return  (bool)  Event occurs
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bCHK_Chance(unsigned int uiN)
+{
+  return (uiN != 0u) && ((unsigned int)rand() % uiN == 0u);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Pseudo-random number (xorshift64*)
+ *
+ * @param[in,out] *pullState  State (not 0)
+ * @return  (uint32_t)  Random value
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulCHK_Rand(uint64_t* pullState)
+{
+  *pullState ^= *pullState >> 12;
+  *pullState ^= *pullState << 25;
+  *pullState ^= *pullState >> 27;
+  return (uint32_t)((*pullState * 0x2545F4914F6CDD1DuLL) >> 32);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Pseudo-random number in a range (xorshift64*)
+ *
+ * @param[in,out] *pullState  State (not 0)
+ * @param[in] ulRange         Range (min. 1)
+ * @return  (uint32_t)  Number in [0, ulRange)
+ * @date  19.10.2026
+ ******************************************************************************/
+uint32_t ulCHK_RandRange(uint64_t* pullState, uint32_t ulRange)
+{
+  return ulCHK_Rand(pullState) % ulRange;
+}
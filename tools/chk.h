@@ -0,0 +1,29 @@
+/*!****************************************************************************
+ * @file
+ * chk.h
+ *
+ * @brief
+ * Helpers shared by the host checks and simulators
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef CHK_H_
+#define CHK_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*- Public interface ---------------------------------------------------------*/
+void vCHK_Fail(const char* pcMsg);
+bool bCHK_Failed(void);
+void vCHK_SetClock(const char* pcUnit, const uint32_t* pulNow);
+void vCHK_Report(const char* pcName, bool bOk, uint64_t ullCount, const char* pcUnit);
+void vCHK_Exit(const char* pcMsg);
+bool bCHK_Chance(unsigned int uiN);
+uint32_t ulCHK_Rand(uint64_t* pullState);
+uint32_t ulCHK_RandRange(uint64_t* pullState, uint32_t ulRange);
+
+#endif // CHK_H_
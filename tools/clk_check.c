@@ -0,0 +1,338 @@
+/*!****************************************************************************
+ * @file
+ * clk_check.c
+ *
+ * @brief
+ * Check of the compile-time clock tree solver
+ *
+ * Evaluates the lib/clktree macros with run-time values for every crystal
+ * from 4 to 16 MHz in 1 MHz steps, common UART crystals and some out of
+ * range, against every SYSCLK the PLL can produce from it and a few it
+ * cannot. Bus, USB and ADC targets are the reachable dividers of their
+ * parent clock plus unreachable ones.
+ *
+ * Each combination is checked against an independent search over all PLL
+ * and prescaler settings: the solver must report the same feasibility, and
+ * the RCC_CFGR and FLASH_ACR values of a feasible one must decode back to
+ * exactly the requested frequencies with the wait states for SYSCLK. The
+ * default configuration (hw_clkcfg.h, 8 MHz HSE) must give the register
+ * values of the former hand-written bring-up.
+ *
+ * Exits with failure status on the first error.
+ *
+ * Usage: clk_check [-v]
+ *   -v           List the SYSCLK values reachable from each crystal
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "clktree.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Number of elements of an array
+#define CHECK_COUNT(a)                (sizeof(a) / sizeof((a)[0]))
+
+/// Most SYSCLK targets per crystal
+#define CHECK_SYS_MAX                 64u
+
+/// RCC_CFGR bits the solver may set
+#define CHECK_CFGR_MASK               0x007FFFF0uL
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Crystals in Hz
+static const uint32_t aulHse[] = {
+  4000000uL, 5000000uL, 6000000uL, 7000000uL, 8000000uL, 9000000uL, 10000000uL,
+  11000000uL, 12000000uL, 13000000uL, 14000000uL, 15000000uL, 16000000uL,
+  3686400uL, 7372800uL, 11059200uL, 12288000uL, 14745600uL,
+  3000000uL, 20000000uL, 25000000uL
+};
+
+/// AHB prescaler by HPRE code
+static const uint32_t aulHpre[16] = { 1, 1, 1, 1, 1, 1, 1, 1, 2, 4, 8, 16, 64, 128, 256, 512 };
+
+/// APB prescaler by PPRE code
+static const uint32_t aulPpre[8] = { 1, 1, 1, 1, 2, 4, 8, 16 };
+
+/// ADC prescaler by ADCPRE code
+static const uint32_t aulAdcpre[4] = { 2, 4, 6, 8 };
+
+/// Dividers tried for bus and ADC targets (3 is never available)
+static const uint32_t aulTryDiv[] = { 1, 2, 3, 4, 6, 8, 16, 64, 512 };
+
+/// Combinations checked and feasible
+static unsigned long ulChecked;
+static unsigned long ulFeasible;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Print result line and exit on failure
+ *
+ * @param[in]  pcName       Check name
+ * @param[in]  bOk          Result
+ * @param[in]  pcInfo       Details
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vCheckResult(const char* pcName, bool bOk, const char* pcInfo)
+{
+  printf("%-14s %-4s %s\n", pcName, bOk ? "ok" : "FAIL", pcInfo);
+  if (!bOk) exit(EXIT_FAILURE);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Print combination and error, and exit
+ *
+ * @param[in]  pcMsg        Error
+ * @param[in]  pulT         HSE, SYSCLK, HCLK, PCLK1, PCLK2, USBCLK, ADCCLK
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vCheckFail(const char* pcMsg, const uint32_t* pulT)
+{
+  printf("error: %s\n", pcMsg);
+  printf("  hse %lu sys %lu hclk %lu pclk1 %lu pclk2 %lu usb %lu adc %lu\n",
+         (unsigned long)pulT[0], (unsigned long)pulT[1], (unsigned long)pulT[2],
+         (unsigned long)pulT[3], (unsigned long)pulT[4], (unsigned long)pulT[5],
+         (unsigned long)pulT[6]);
+  exit(EXIT_FAILURE);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Search all settings for one producing the targets
+ *
+ * @param[in]  pulT         HSE, SYSCLK, HCLK, PCLK1, PCLK2, USBCLK, ADCCLK
+ * @return  (bool)  Some setting produces the targets within the device limits
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bCheckSearch(const uint32_t* pulT)
+{
+  uint64_t ullHse = pulT[0], ullSys = pulT[1], ullHclk = pulT[2];
+  uint64_t ullPclk1 = pulT[3], ullPclk2 = pulT[4], ullUsb = pulT[5], ullAdc = pulT[6];
+  bool bOk;
+
+  if ((ullHse < 4000000u) || (ullHse > 16000000u)) return false;
+  if ((ullSys < 16000000u) || (ullSys > 72000000u)) return false;
+
+  bOk = false;
+  for (uint64_t ullPre = 1u; ullPre <= 2u; ullPre++)
+  {
+    for (uint64_t ullMul = 2u; ullMul <= 16u; ullMul++)
+    {
+      if (ullHse * ullMul == ullSys * ullPre) bOk = true;
+    }
+  }
+  if (!bOk) return false;
+
+  bOk = false;
+  for (uint32_t ulCode = 0u; ulCode < CHECK_COUNT(aulHpre); ulCode++)
+  {
+    if (ullHclk * aulHpre[ulCode] == ullSys) bOk = true;
+  }
+  if (!bOk) return false;
+
+  bOk = false;
+  for (uint32_t ulCode = 0u; ulCode < CHECK_COUNT(aulPpre); ulCode++)
+  {
+    if ((ullPclk1 * aulPpre[ulCode] == ullHclk) && (ullPclk1 <= 36000000u)) bOk = true;
+  }
+  if (!bOk) return false;
+
+  bOk = false;
+  for (uint32_t ulCode = 0u; ulCode < CHECK_COUNT(aulPpre); ulCode++)
+  {
+    if (ullPclk2 * aulPpre[ulCode] == ullHclk) bOk = true;
+  }
+  if (!bOk) return false;
+
+  if (ullAdc != 0u)
+  {
+    if ((ullAdc < 600000u) || (ullAdc > 14000000u)) return false;
+    bOk = false;
+    for (uint32_t ulCode = 0u; ulCode < CHECK_COUNT(aulAdcpre); ulCode++)
+    {
+      if (ullAdc * aulAdcpre[ulCode] == ullPclk2) bOk = true;
+    }
+    if (!bOk) return false;
+  }
+
+  if (ullUsb != 0u)
+  {
+    if (ullUsb != 48000000u) return false;
+    if ((ullUsb != ullSys) && (ullUsb * 3u != ullSys * 2u)) return false;
+  }
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check solver against the search, and decode its register values
+ *
+ * @param[in]  pulT         HSE, SYSCLK, HCLK, PCLK1, PCLK2, USBCLK, ADCCLK
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vCheckOne(const uint32_t* pulT)
+{
+  uint32_t ulHse = pulT[0], ulSys = pulT[1], ulHclk = pulT[2];
+  uint32_t ulPclk1 = pulT[3], ulPclk2 = pulT[4], ulUsb = pulT[5], ulAdc = pulT[6];
+  bool bSolved = CLKTREE_FEASIBLE(ulHse, ulSys, ulHclk, ulPclk1, ulPclk2, ulUsb, ulAdc);
+
+  ulChecked++;
+  if (bSolved != bCheckSearch(pulT))
+  {
+    vCheckFail(bSolved ? "solver accepts an infeasible tree" : "solver misses a feasible tree", pulT);
+  }
+  if (!bSolved) return;
+  ulFeasible++;
+
+  uint32_t ulCfgr = CLKTREE_CFGR(ulHse, ulSys, ulHclk, ulPclk1, ulPclk2, ulUsb, ulAdc);
+  uint32_t ulAcr = CLKTREE_FLASH_ACR(ulSys);
+
+  if ((ulCfgr & ~CHECK_CFGR_MASK) != 0u) vCheckFail("SW or reserved bits", pulT);
+  if ((ulCfgr & (1uL << 16)) == 0u) vCheckFail("PLLSRC", pulT);
+  if ((((ulCfgr >> 4) & 0xFu) != 0u) && (((ulCfgr >> 4) & 0x8u) == 0u)) vCheckFail("HPRE code", pulT);
+  if ((((ulCfgr >> 8) & 0x7u) != 0u) && (((ulCfgr >> 8) & 0x4u) == 0u)) vCheckFail("PPRE1 code", pulT);
+  if ((((ulCfgr >> 11) & 0x7u) != 0u) && (((ulCfgr >> 11) & 0x4u) == 0u)) vCheckFail("PPRE2 code", pulT);
+
+  uint64_t ullPre = ((ulCfgr >> 17) & 1u) + 1u;
+  uint64_t ullMul = ((ulCfgr >> 18) & 0xFu) + 2u;
+  if (ullMul > 16u) vCheckFail("PLLMUL code", pulT);
+  if ((uint64_t)ulHse * ullMul != (uint64_t)ulSys * ullPre) vCheckFail("PLL output", pulT);
+  if ((ullPre == 2u) && (CLKTREE_PLLMUL_AT_(ulHse, 1u, ulSys) != 0u)) vCheckFail("HSE / 2 preferred", pulT);
+
+  if (ulSys / aulHpre[(ulCfgr >> 4) & 0xFu] != ulHclk) vCheckFail("HCLK", pulT);
+  if (ulSys % aulHpre[(ulCfgr >> 4) & 0xFu] != 0u) vCheckFail("HCLK", pulT);
+  if (ulHclk / aulPpre[(ulCfgr >> 8) & 0x7u] != ulPclk1) vCheckFail("PCLK1", pulT);
+  if (ulHclk / aulPpre[(ulCfgr >> 11) & 0x7u] != ulPclk2) vCheckFail("PCLK2", pulT);
+  if (ulPclk1 > 36000000uL) vCheckFail("PCLK1 limit", pulT);
+  if ((ulAdc != 0u) && (ulPclk2 / aulAdcpre[(ulCfgr >> 14) & 0x3u] != ulAdc)) vCheckFail("ADCCLK", pulT);
+
+  uint32_t ulUsbOut = ((ulCfgr >> 22) & 1u) ? ulSys : ulSys / 3u * 2u;
+  if ((ulUsb != 0u) && ((ulUsbOut != ulUsb) || (((ulCfgr >> 22) & 1u) == 0u && ulSys % 3u != 0u)))
+  {
+    vCheckFail("USBCLK", pulT);
+  }
+
+  uint32_t ulLatency = (ulSys <= 24000000uL) ? 0u : (ulSys <= 48000000uL) ? 1u : 2u;
+  if (ulAcr != (ulLatency | 0x10uL)) vCheckFail("FLASH_ACR", pulT);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check all bus, USB and ADC targets for a crystal and SYSCLK
+ *
+ * @param[in]  ulHse        Crystal in Hz
+ * @param[in]  ulSys        SYSCLK in Hz
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vCheckTree(uint32_t ulHse, uint32_t ulSys)
+{
+  static const uint32_t aulUsb[] = { 0u, 48000000uL, 24000000uL };
+  static const uint32_t aulHdiv[] = { 1, 2, 3, 4, 16, 64, 512 };
+  uint32_t aulT[7] = { ulHse, ulSys };
+
+  for (uint32_t ulH = 0u; ulH < CHECK_COUNT(aulHdiv); ulH++)
+  {
+    aulT[2] = ulSys / aulHdiv[ulH];
+    for (uint32_t ulP1 = 0u; ulP1 < CHECK_COUNT(aulTryDiv); ulP1++)
+    {
+      aulT[3] = aulT[2] / aulTryDiv[ulP1];
+      for (uint32_t ulP2 = 0u; ulP2 < CHECK_COUNT(aulTryDiv); ulP2++)
+      {
+        aulT[4] = aulT[2] / aulTryDiv[ulP2];
+        for (uint32_t ulU = 0u; ulU < CHECK_COUNT(aulUsb); ulU++)
+        {
+          aulT[5] = aulUsb[ulU];
+          aulT[6] = 0u;
+          vCheckOne(aulT);
+          for (uint32_t ulA = 1u; ulA < 6u; ulA++)
+          {
+            aulT[6] = aulT[4] / aulTryDiv[ulA];
+            vCheckOne(aulT);
+          }
+        }
+      }
+    }
+  }
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+  bool bVerbose = false;
+  char acInfo[96];
+  int iOpt;
+
+  while ((iOpt = getopt(argc, argv, "v")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'v':
+        bVerbose = true;
+        break;
+
+      default:
+        fprintf(stderr, "usage: clk_check [-v]\n");
+        return EXIT_FAILURE;
+    }
+  }
+
+  // Default configuration of hw_clkcfg.h: the former hand-written values
+  uint32_t ulCfgr = CLKTREE_CFGR(8000000uL, 72000000uL, 72000000uL, 36000000uL, 36000000uL,
+                                 48000000uL, 9000000uL);
+  uint32_t ulAcr = CLKTREE_FLASH_ACR(72000000uL);
+  snprintf(acInfo, sizeof(acInfo), "CFGR 0x%08lX, ACR 0x%02lX",
+           (unsigned long)ulCfgr, (unsigned long)ulAcr);
+  vCheckResult("default", (ulCfgr == ((1uL << 16) | (7uL << 18) | (4uL << 8) | (4uL << 11) | (1uL << 14))) &&
+                          (ulAcr == (2uL | 0x10uL)) &&
+                          (CLKTREE_TIMCLK(72000000uL, 36000000uL) == 72000000uL),
+               acInfo);
+
+  // Every crystal against every SYSCLK reachable from it, and some not
+  for (uint32_t ulX = 0u; ulX < CHECK_COUNT(aulHse); ulX++)
+  {
+    uint32_t aulSys[CHECK_SYS_MAX];
+    uint32_t ulSysCount = 0u;
+    uint32_t ulHse = aulHse[ulX];
+
+    for (uint32_t ulPre = 1u; ulPre <= 2u; ulPre++)
+    {
+      for (uint32_t ulMul = 2u; ulMul <= 16u; ulMul++)
+      {
+        aulSys[ulSysCount++] = ulHse / ulPre * ulMul;
+      }
+    }
+    aulSys[ulSysCount++] = 72000000uL;
+    aulSys[ulSysCount++] = 48000000uL;
+    aulSys[ulSysCount++] = 70000000uL;
+    aulSys[ulSysCount++] = 80000000uL;
+    aulSys[ulSysCount++] = ulHse * 9u + 1u;
+
+    if (bVerbose) printf("hse %8lu:", (unsigned long)ulHse);
+    for (uint32_t ulS = 0u; ulS < ulSysCount; ulS++)
+    {
+      uint32_t ulSys = aulSys[ulS];
+      if (bVerbose && (ulS < 30u) && (CLKTREE_PREDIV(ulHse, ulSys) == ((ulS < 15u) ? 1u : 2u)) &&
+          CLKTREE_FEASIBLE(ulHse, ulSys, ulSys, ulSys / 2u, ulSys, 0u, 0u))
+      {
+        printf(" %lu", (unsigned long)ulSys);
+      }
+      vCheckTree(ulHse, ulSys);
+    }
+    if (bVerbose) printf("\n");
+  }
+
+  snprintf(acInfo, sizeof(acInfo), "%lu combinations, %lu feasible", ulChecked, ulFeasible);
+  vCheckResult("solver", ulFeasible != 0u, acInfo);
+  return EXIT_SUCCESS;
+}
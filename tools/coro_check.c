@@ -0,0 +1,625 @@
+/*!****************************************************************************
+ * @file
+ * coro_check.c
+ *
+ * @brief
+ * Host check of the stackless coroutines
+ *
+ * Drives coroutines built with lib/coro.h from a simple scheduler, as main()
+ * and the background thread do, under a software clock. Each coroutine keeps
+ * its context next to its state and records what it did; the scheduler
+ * checks every return value against it:
+ *
+ *   yield       One return per yield, resume right after it, exit for good
+ *   wait        Condition evaluated once per call, no return if already
+ *               true, events consumed once however often signalled, space
+ *   timeout     Time awaits waking exactly at the delay, also across the
+ *               32-bit wrap-around and for a zero delay, and an event await
+ *               with a timeout, ended by the event, by the timeout or both
+ *   restart     The scheduler stopped mid-await and replaced by another one
+ *               with the tasks in reverse order: every coroutine resumes at
+ *               its await, late timers wake on the first call, exited
+ *               coroutines stay exited until re-initialised
+ *
+ * Finally, coroutines looping over random time awaits, yields and event
+ * awaits run under random clock steps and signals, with the scheduler
+ * restarted at random after a random pause. No time await may wake early or
+ * stay waiting once due, and no signalled event may be missed.
+ *
+ * Exits with failure status on the first error.
+ *
+ * Usage: coro_check [-n <polls>] [-s <seed>]
+ *   -n <polls>   Scheduler passes in the random run (default 1000000)
+ *   -s <seed>    Random seed
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "coro.h"
+#include "chk.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Coroutines in the random run
+#define CHK_TASKS                     16u
+
+/// Longest time await in the random run
+#define CHK_DELAY_MAX                 500uL
+
+/// Event await timeout in the timeout scenario
+#define CHK_TIMEOUT                   100uL
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Position of a coroutine, set by its body
+typedef enum {
+  CHK_PHASE_NONE = 0,             ///< Not started or between awaits
+  CHK_PHASE_TIME,                 ///< In time await
+  CHK_PHASE_YIELD,                ///< Yielded
+  CHK_PHASE_EVENT,                ///< In event await
+  CHK_PHASE_COND,                 ///< In condition await
+  CHK_PHASE_SPACE,                ///< In space await
+  CHK_PHASE_DONE                  ///< Body completed
+} ChkPhaseTypeDef;
+
+/// Result of an event await with timeout
+typedef enum {
+  CHK_WAKE_NONE = 0,              ///< Still waiting
+  CHK_WAKE_EVENT,                 ///< Event taken
+  CHK_WAKE_TIMEOUT                ///< Timed out
+} ChkWakeTypeDef;
+
+/// Coroutine with context
+typedef struct ChkTask {
+  CORO_TypeDef sCo;               ///< Coroutine state (first member)
+  CORO_StatusTypeDef (*pfnBody)(CORO_TypeDef* psCo); ///< Body
+  ChkPhaseTypeDef ePhase;         ///< Position
+  uint32_t ulStarts;              ///< Times the body was entered at its start
+  uint32_t ulSteps;               ///< Awaits and yields passed
+  uint32_t ulRound;               ///< Loop counter
+  uint32_t ulRounds;              ///< Loop count
+  uint32_t ulStart;               ///< Start of the current time await
+  uint32_t ulDelay;               ///< Delay of the current time await
+  uint32_t ulEvals;               ///< Condition evaluations
+  uint32_t ulFree;                ///< Free space for space awaits
+  uint64_t ullRand;               ///< Random state of the body
+  bool bReady;                    ///< Condition for condition awaits
+  ChkWakeTypeDef eWake;           ///< Result of event await with timeout
+  CORO_EventTypeDef ucEvent;      ///< Event
+} ChkTaskTypeDef;
+
+/// Scheduler: coroutines polled in order
+typedef struct {
+  ChkTaskTypeDef* apsTasks[CHK_TASKS];
+  uint32_t ulCount;               ///< Number of coroutines
+} ChkSchedTypeDef;
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Software clock
+static uint32_t ulNow;
+
+/// Coroutines
+static ChkTaskTypeDef asTasks[CHK_TASKS];
+
+/// Coroutine calls
+static uint64_t ullCalls;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Coroutine context from coroutine state
+ *
+ * @param[in] *psCo   Coroutine state
+ * @return  (ChkTaskTypeDef*)  Context
+ * @date  19.10.2026
+ ******************************************************************************/
+static ChkTaskTypeDef* psChkTask(CORO_TypeDef* psCo)
+{
+  return (ChkTaskTypeDef*)psCo;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Condition of the wait coroutine, counting evaluations
+ *
+ * @param[in,out] *psTask Context
+ * @return  (bool)  Condition
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bChkReady(ChkTaskTypeDef* psTask)
+{
+  psTask->ulEvals++;
+  return psTask->bReady;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Condition of an event await with timeout
+ *
+ * @param[in,out] *psTask Context
+ * @return  (bool)  Event taken or timed out
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bChkEventOrTimeout(ChkTaskTypeDef* psTask)
+{
+  if (bCORO_TakeEvent(&psTask->ucEvent)) psTask->eWake = CHK_WAKE_EVENT;
+  else if ((ulNow - psTask->ulStart) >= CHK_TIMEOUT) psTask->eWake = CHK_WAKE_TIMEOUT;
+  return psTask->eWake != CHK_WAKE_NONE;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Yield coroutine: three yields in a loop
+ *
+ * @param[in,out] *psCo   Coroutine state
+ * @return  (CORO_StatusTypeDef)  Coroutine status
+ * @date  19.10.2026
+ ******************************************************************************/
+static CORO_StatusTypeDef eChkYield(CORO_TypeDef* psCo)
+{
+  ChkTaskTypeDef* psTask = psChkTask(psCo);
+
+  CORO_BEGIN(psCo);
+  psTask->ulStarts++;
+  for (psTask->ulRound = 0uL; psTask->ulRound < 3uL; psTask->ulRound++)
+  {
+    psTask->ePhase = CHK_PHASE_YIELD;
+    CORO_YIELD(psCo);
+    psTask->ePhase = CHK_PHASE_NONE;
+    psTask->ulSteps++;
+  }
+  psTask->ePhase = CHK_PHASE_DONE;
+  CORO_END(psCo);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Wait coroutine: condition twice, event, space
+ *
+ * @param[in,out] *psCo   Coroutine state
+ * @return  (CORO_StatusTypeDef)  Coroutine status
+ * @date  19.10.2026
+ ******************************************************************************/
+static CORO_StatusTypeDef eChkWait(CORO_TypeDef* psCo)
+{
+  ChkTaskTypeDef* psTask = psChkTask(psCo);
+
+  CORO_BEGIN(psCo);
+  psTask->ulStarts++;
+  psTask->ePhase = CHK_PHASE_COND;
+  CORO_AWAIT(psCo, bChkReady(psTask));
+  psTask->ulSteps++;
+  CORO_AWAIT(psCo, bChkReady(psTask));
+  psTask->ulSteps++;
+  psTask->ePhase = CHK_PHASE_EVENT;
+  CORO_AWAIT_EVENT(psCo, &psTask->ucEvent);
+  psTask->ulSteps++;
+  psTask->ePhase = CHK_PHASE_SPACE;
+  CORO_AWAIT_SPACE(psCo, psTask->ulFree, 4u);
+  psTask->ulSteps++;
+  psTask->ePhase = CHK_PHASE_DONE;
+  CORO_END(psCo);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Timeout coroutine: time await, then event await with timeout
+ *
+ * @param[in,out] *psCo   Coroutine state
+ * @return  (CORO_StatusTypeDef)  Coroutine status
+ * @date  19.10.2026
+ ******************************************************************************/
+static CORO_StatusTypeDef eChkTimeout(CORO_TypeDef* psCo)
+{
+  ChkTaskTypeDef* psTask = psChkTask(psCo);
+
+  CORO_BEGIN(psCo);
+  psTask->ulStarts++;
+  psTask->ulStart = ulNow;
+  psTask->ePhase = CHK_PHASE_TIME;
+  CORO_AWAIT_TIME(psCo, ulNow, psTask->ulDelay);
+  psTask->ulSteps++;
+  psTask->ulStart = ulNow;
+  psTask->eWake = CHK_WAKE_NONE;
+  psTask->ePhase = CHK_PHASE_EVENT;
+  CORO_AWAIT(psCo, bChkEventOrTimeout(psTask));
+  psTask->ulSteps++;
+  psTask->ePhase = CHK_PHASE_DONE;
+  CORO_END(psCo);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Periodic coroutine: endless time awaits of the context delay
+ *
+ * @param[in,out] *psCo   Coroutine state
+ * @return  (CORO_StatusTypeDef)  Coroutine status
+ * @date  19.10.2026
+ ******************************************************************************/
+static CORO_StatusTypeDef eChkPeriodic(CORO_TypeDef* psCo)
+{
+  ChkTaskTypeDef* psTask = psChkTask(psCo);
+
+  CORO_BEGIN(psCo);
+  psTask->ulStarts++;
+  while (1)
+  {
+    psTask->ulStart = ulNow;
+    psTask->ePhase = CHK_PHASE_TIME;
+    CORO_AWAIT_TIME(psCo, ulNow, psTask->ulDelay);
+    psTask->ulSteps++;
+  }
+  CORO_END(psCo);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Random coroutine: rounds of time await, yield and event await
+ *
+ * @param[in,out] *psCo   Coroutine state
+ * @return  (CORO_StatusTypeDef)  Coroutine status
+ * @date  19.10.2026
+ ******************************************************************************/
+static CORO_StatusTypeDef eChkRandom(CORO_TypeDef* psCo)
+{
+  ChkTaskTypeDef* psTask = psChkTask(psCo);
+
+  CORO_BEGIN(psCo);
+  psTask->ulStarts++;
+  for (psTask->ulRound = 0uL; psTask->ulRound < psTask->ulRounds; psTask->ulRound++)
+  {
+    psTask->ulDelay = ulCHK_RandRange(&psTask->ullRand, CHK_DELAY_MAX + 1uL);
+    psTask->ulStart = ulNow;
+    psTask->ePhase = CHK_PHASE_TIME;
+    CORO_AWAIT_TIME(psCo, ulNow, psTask->ulDelay);
+    if ((ulNow - psTask->ulStart) < psTask->ulDelay) vCHK_Fail("time await woke early");
+    psTask->ulSteps++;
+
+    psTask->ePhase = CHK_PHASE_YIELD;
+    CORO_YIELD(psCo);
+    psTask->ulSteps++;
+
+    psTask->ePhase = CHK_PHASE_EVENT;
+    CORO_AWAIT_EVENT(psCo, &psTask->ucEvent);
+    psTask->ulSteps++;
+  }
+  psTask->ePhase = CHK_PHASE_DONE;
+  CORO_END(psCo);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Initialise coroutine with context
+ *
+ * @param[out] *psTask    Context
+ * @param[in] pfnBody     Body
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkInit(ChkTaskTypeDef* psTask, CORO_StatusTypeDef (*pfnBody)(CORO_TypeDef* psCo))
+{
+  *psTask = (ChkTaskTypeDef){ .pfnBody = pfnBody };
+  CORO_INIT(&psTask->sCo);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Call coroutine once, check status against its recorded position
+ *
+ * @param[in,out] *psTask Context
+ * @return  (CORO_StatusTypeDef)  Coroutine status
+ * @date  19.10.2026
+ ******************************************************************************/
+static CORO_StatusTypeDef eChkCall(ChkTaskTypeDef* psTask)
+{
+  uint32_t ulStarts = psTask->ulStarts;
+  bool bExited = bCORO_IsExited(&psTask->sCo);
+  CORO_StatusTypeDef eStatus = psTask->pfnBody(&psTask->sCo);
+  ullCalls++;
+
+  if (psTask->ulStarts > ulStarts + 1uL) vCHK_Fail("body entered twice in one call");
+  if (bExited && ((eStatus != CORO_EXITED) || (psTask->ulStarts != ulStarts)))
+  {
+    vCHK_Fail("exited coroutine ran");
+  }
+  switch (eStatus)
+  {
+    case CORO_WAITING:
+      if ((psTask->ePhase == CHK_PHASE_NONE) || (psTask->ePhase == CHK_PHASE_YIELD) ||
+          (psTask->ePhase == CHK_PHASE_DONE))
+      {
+        vCHK_Fail("waiting outside an await");
+      }
+      if ((psTask->ePhase == CHK_PHASE_TIME) && ((ulNow - psTask->ulStart) >= psTask->ulDelay))
+      {
+        vCHK_Fail("time await not woken when due");
+      }
+      if ((psTask->ePhase == CHK_PHASE_EVENT) && (psTask->ucEvent != 0u))
+      {
+        vCHK_Fail("signalled event not taken");
+      }
+      break;
+    case CORO_YIELDED:
+      if (psTask->ePhase != CHK_PHASE_YIELD) vCHK_Fail("yielded outside a yield");
+      break;
+    case CORO_EXITED:
+      if (!bCORO_IsExited(&psTask->sCo)) vCHK_Fail("exited without exit state");
+      break;
+    default:
+      vCHK_Fail("invalid status");
+      break;
+  }
+  return eStatus;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Poll every coroutine of a scheduler once
+ *
+ * @param[in] *psSched    Scheduler
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkPoll(const ChkSchedTypeDef* psSched)
+{
+  for (uint32_t i = 0uL; i < psSched->ulCount; ++i)
+  {
+    (void)eChkCall(psSched->apsTasks[i]);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check result of a single call
+ *
+ * @param[in,out] *psTask Context
+ * @param[in] eExpect     Expected status
+ * @param[in] ulSteps     Expected steps after the call
+ * @param[in] *pcMsg      Failure message
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkStep(ChkTaskTypeDef* psTask, CORO_StatusTypeDef eExpect, uint32_t ulSteps,
+                     const char* pcMsg)
+{
+  if ((eChkCall(psTask) != eExpect) || (psTask->ulSteps != ulSteps)) vCHK_Fail(pcMsg);
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Check entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  unsigned long ulRandomPolls = 1000000uL;
+  unsigned int uiSeed = (unsigned int)time(NULL);
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "n:s:")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'n': ulRandomPolls = strtoul(optarg, NULL, 0); break;
+      case 's': uiSeed = (unsigned int)strtoul(optarg, NULL, 0); break;
+      default:
+        fprintf(stderr, "Usage: %s [-n <polls>] [-s <seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  printf("seed %u\n", uiSeed);
+  srand(uiSeed);
+  vCHK_SetClock("time", &ulNow);
+
+  ChkTaskTypeDef* psTask = &asTasks[0];
+  uint64_t ullStart;
+  bool bOk;
+
+  // Yield: one return per yield, then exited for good
+  ullStart = ullCalls;
+  vChkInit(psTask, eChkYield);
+  vChkStep(psTask, CORO_YIELDED, 0uL, "first yield");
+  vChkStep(psTask, CORO_YIELDED, 1uL, "second yield");
+  vChkStep(psTask, CORO_YIELDED, 2uL, "third yield");
+  vChkStep(psTask, CORO_EXITED, 3uL, "exit after last yield");
+  vChkStep(psTask, CORO_EXITED, 3uL, "exited coroutine");
+  bOk = (psTask->ulStarts == 1uL) && (psTask->ePhase == CHK_PHASE_DONE);
+  vCHK_Report("yield", bOk, ullCalls - ullStart, "calls");
+
+  // Wait: condition evaluated once per call, no return when already true
+  ullStart = ullCalls;
+  vChkInit(psTask, eChkWait);
+  vChkStep(psTask, CORO_WAITING, 0uL, "condition false");
+  vChkStep(psTask, CORO_WAITING, 0uL, "condition still false");
+  bOk = (psTask->ulEvals == 2uL);
+  psTask->bReady = true;
+  vChkStep(psTask, CORO_WAITING, 2uL, "condition true, into event await");
+  bOk = bOk && (psTask->ulEvals == 4uL) && (psTask->ePhase == CHK_PHASE_EVENT);
+
+  // Two signals wake once and are consumed
+  vCORO_Signal(&psTask->ucEvent);
+  vCORO_Signal(&psTask->ucEvent);
+  vChkStep(psTask, CORO_WAITING, 3uL, "event taken, into space await");
+  bOk = bOk && (psTask->ucEvent == 0u) && (psTask->ePhase == CHK_PHASE_SPACE);
+  vCORO_Signal(&psTask->ucEvent);
+  psTask->ulFree = 3uL;
+  vChkStep(psTask, CORO_WAITING, 3uL, "space short by one");
+  bOk = bOk && (psTask->ucEvent == 1u);
+  psTask->ulFree = 4uL;
+  vChkStep(psTask, CORO_EXITED, 4uL, "space available");
+  vChkStep(psTask, CORO_EXITED, 4uL, "exited coroutine");
+  bOk = bOk && (psTask->ulEvals == 4uL) && (psTask->ulStarts == 1uL);
+  vCHK_Report("wait", bOk, ullCalls - ullStart, "calls");
+
+  // Timeout: time awaits of several delays and start times, called every tick
+  ullStart = ullCalls;
+  bOk = true;
+  static const uint32_t aulDelays[] = { 0uL, 1uL, 2uL, 7uL, 1000uL, 0x80000000uL };
+  static const uint32_t aulStarts[] = { 0uL, 12345uL, 0xFFFFFFFFuL, 0xFFFFFFFFuL - 500uL };
+  for (uint32_t s = 0uL; s < sizeof(aulStarts) / sizeof(aulStarts[0]); ++s)
+  {
+    for (uint32_t d = 0uL; d < sizeof(aulDelays) / sizeof(aulDelays[0]); ++d)
+    {
+      ulNow = aulStarts[s];
+      vChkInit(psTask, eChkTimeout);
+      psTask->ulDelay = aulDelays[d];
+      uint32_t ulWake = ulNow + aulDelays[d];
+      while ((psTask->ulSteps == 0uL) && !bCHK_Failed())
+      {
+        (void)eChkCall(psTask);
+        if (psTask->ulSteps == 0uL)
+        {
+          // Skip most of a long delay: the clock has no calls in between
+          if ((ulWake - ulNow) > 4uL) ulNow = ulWake - 4uL;
+          else ulNow++;
+        }
+      }
+      bOk = bOk && (ulNow == ulWake);
+
+      // Event await with timeout: run into the timeout
+      ulWake = ulNow + CHK_TIMEOUT;
+      while (!bCORO_IsExited(&psTask->sCo) && !bCHK_Failed())
+      {
+        ulNow++;
+        (void)eChkCall(psTask);
+      }
+      bOk = bOk && (ulNow == ulWake) && (psTask->eWake == CHK_WAKE_TIMEOUT);
+    }
+  }
+
+  // Event before the timeout, and together with it
+  for (uint32_t ulAt = 1uL; ulAt <= CHK_TIMEOUT; ++ulAt)
+  {
+    ulNow = 0xFFFFFFC0uL;
+    vChkInit(psTask, eChkTimeout);
+    vChkStep(psTask, CORO_WAITING, 1uL, "into event await");
+    for (uint32_t t = 1uL; t < ulAt; ++t)
+    {
+      ulNow++;
+      vChkStep(psTask, CORO_WAITING, 1uL, "event await without event");
+    }
+    ulNow++;
+    vCORO_Signal(&psTask->ucEvent);
+    vChkStep(psTask, CORO_EXITED, 2uL, "event await with event");
+    bOk = bOk && (psTask->eWake == CHK_WAKE_EVENT) && (psTask->ucEvent == 0u);
+  }
+  vCHK_Report("timeout", bOk, ullCalls - ullStart, "calls");
+
+  // Restart: scheduler stopped mid-await, replaced by another one in reverse order
+  ullStart = ullCalls;
+  ulNow = 0xFFFFF000uL;
+  ChkSchedTypeDef sSched = { .ulCount = 4uL };
+  static const uint32_t aulPeriods[] = { 10uL, 250uL, 1000uL };
+  for (uint32_t i = 0uL; i < 3uL; ++i)
+  {
+    sSched.apsTasks[i] = &asTasks[i];
+    vChkInit(&asTasks[i], eChkPeriodic);
+    asTasks[i].ulDelay = aulPeriods[i];
+  }
+  sSched.apsTasks[3] = &asTasks[3];
+  vChkInit(&asTasks[3], eChkWait);
+  for (uint32_t t = 0uL; t < 2345uL; ++t)
+  {
+    vChkPoll(&sSched);
+    ulNow++;
+  }
+  bOk = (asTasks[0].ulSteps == 234uL) && (asTasks[1].ulSteps == 9uL) &&
+        (asTasks[2].ulSteps == 2uL) && (asTasks[3].ulSteps == 0uL);
+  asTasks[3].bReady = true;
+  vChkPoll(&sSched);
+  bOk = bOk && (asTasks[3].ulSteps == 2uL);
+
+  // Pause without calls: overdue awaits wake on the first call, the others stay
+  ulNow += 600uL;
+  ChkSchedTypeDef sRestart = { .ulCount = 4uL };
+  for (uint32_t i = 0uL; i < 4uL; ++i)
+  {
+    sRestart.apsTasks[i] = sSched.apsTasks[3u - i];
+  }
+  vChkPoll(&sRestart);
+  bOk = bOk && (asTasks[0].ulSteps == 235uL) && (asTasks[1].ulSteps == 10uL) &&
+        (asTasks[2].ulSteps == 2uL) && (asTasks[3].ulSteps == 2uL);
+  // The slowest is due 1000 after its last wake at 2000, 55 after the pause
+  uint32_t ulResume = ulNow;
+  while ((asTasks[2].ulSteps == 2uL) && !bCHK_Failed())
+  {
+    ulNow++;
+    vChkPoll(&sRestart);
+  }
+  bOk = bOk && ((ulNow - ulResume) == 55uL);
+
+  // Exited coroutine stays exited across the restart until re-initialised
+  vCORO_Signal(&asTasks[3].ucEvent);
+  asTasks[3].ulFree = 4uL;
+  vChkPoll(&sRestart);
+  vChkPoll(&sRestart);
+  bOk = bOk && bCORO_IsExited(&asTasks[3].sCo) && (asTasks[3].ulSteps == 4uL);
+  CORO_INIT(&asTasks[3].sCo);
+  vChkPoll(&sRestart);
+  bOk = bOk && (asTasks[3].ulStarts == 2uL) && (asTasks[3].ulSteps == 6uL) &&
+        (asTasks[3].ePhase == CHK_PHASE_EVENT);
+  for (uint32_t i = 0uL; i < 3uL; ++i)
+  {
+    bOk = bOk && (asTasks[i].ulStarts == 1uL);
+  }
+  vCHK_Report("restart", bOk, ullCalls - ullStart, "calls");
+
+  // Random: random clock steps, signals and scheduler restarts after a pause
+  ullStart = ullCalls;
+  ulNow = 0xFFFFFFFFuL - (uint32_t)(rand() % 100000);
+  sSched.ulCount = CHK_TASKS;
+  for (uint32_t i = 0uL; i < CHK_TASKS; ++i)
+  {
+    vChkInit(&asTasks[i], eChkRandom);
+    asTasks[i].ulRounds = 0xFFFFFFFFuL;
+    asTasks[i].ullRand = ((uint64_t)rand() << 32) | (uint64_t)rand() | 1uLL;
+    sSched.apsTasks[i] = &asTasks[i];
+  }
+  uint32_t ulRestarts = 0uL;
+  for (unsigned long n = 0uL; (n < ulRandomPolls) && !bCHK_Failed(); ++n)
+  {
+    vChkPoll(&sSched);
+    ulNow += (uint32_t)(rand() % 4);
+    for (uint32_t i = 0uL; i < CHK_TASKS; ++i)
+    {
+      if ((rand() % 8) == 0) vCORO_Signal(&asTasks[i].ucEvent);
+    }
+
+    // Restart with the coroutines shuffled, after a pause of up to twice the delay
+    if ((rand() % 1000) == 0)
+    {
+      ulNow += (uint32_t)(rand() % (int)(2uL * CHK_DELAY_MAX));
+      for (uint32_t i = CHK_TASKS - 1uL; i > 0uL; --i)
+      {
+        uint32_t j = (uint32_t)rand() % (i + 1uL);
+        ChkTaskTypeDef* psSwap = sSched.apsTasks[i];
+        sSched.apsTasks[i] = sSched.apsTasks[j];
+        sSched.apsTasks[j] = psSwap;
+      }
+      ulRestarts++;
+    }
+  }
+  bOk = true;
+  for (uint32_t i = 0uL; i < CHK_TASKS; ++i)
+  {
+    bOk = bOk && (asTasks[i].ulStarts == 1uL) &&
+          ((asTasks[i].ulSteps / 3uL) == asTasks[i].ulRound);
+  }
+  vCHK_Report("random", bOk, ullCalls - ullStart, "calls");
+  printf("  %lu restarts, %lu rounds in coroutine 0\n", (unsigned long)ulRestarts,
+         (unsigned long)asTasks[0].ulRound);
+
+  return EXIT_SUCCESS;
+}
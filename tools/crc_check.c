@@ -0,0 +1,455 @@
+/*!****************************************************************************
+ * @file
+ * crc_check.c
+ *
+ * @brief
+ * Host check of the CRC-32 library and the CRC unit driver
+ *
+ * Checks ulCRC32_Update() against the standard check values and a bitwise
+ * reference, and runs hw_crc against a software model of the CRC unit:
+ * DR = 32 steps of the MSB-first shift register over DR ^ word, DR = reset
+ * value on CR_RESET (see host/stm32f1xx_hal.h). In zlib mode, results must
+ * equal ulCRC32_Update(); in native mode, the model fed with the same words
+ * from the reset value.
+ *
+ *   vectors       Check values by ulCRC32_Update() and ulHW_CRC_Calc(),
+ *                 the latter at every alignment
+ *   software      Random data against the bitwise reference, whole and split
+ *   load          Random native states loaded into the unit by running the
+ *                 shift register backwards; no reset while the unit already
+ *                 holds the context's state
+ *   interleaved   Random updates of split data on several contexts of both
+ *                 modes in turn, so the unit switches context before most
+ *                 updates
+ *   dma           Native context fed by DMA (run synchronously on the model)
+ *                 between CPU updates of a zlib context
+ *
+ * Exits with failure status on the first error.
+ *
+ * Usage: crc_check [-n <N>] [-s <seed>]
+ *   -n <N>       Random updates per scenario (default 20000)
+ *   -s <seed>    Random seed
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "stm32f1xx_hal.h"
+#include "crc32.h"
+#include "hw_crc.h"
+#include "hw_dma.h"
+#include "chk.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Reset value of the CRC unit
+#define CHK_UNIT_RESET                0xFFFFFFFFuL
+
+/// Largest random data block
+#define CHK_DATA_MAX                  1024u
+
+/// Contexts in the interleaved run
+#define CHK_CONTEXTS                  4u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Check value
+typedef struct {
+  const char* pcData;             ///< Data
+  uint32_t ulCrc;                 ///< zlib crc32()
+} ChkVectorTypeDef;
+
+/// Context under test with its data
+typedef struct {
+  HW_CRC_ContextTypeDef sCtx;     ///< Context
+  uint8_t aucData[CHK_DATA_MAX + 4u]; ///< Data, fed from aucData[ulOffset]
+  uint32_t ulOffset;              ///< Alignment of data
+  uint32_t ulLen;                 ///< Data length
+  uint32_t ulFed;                 ///< Bytes fed so far
+} ChkStreamTypeDef;
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Check values
+static const ChkVectorTypeDef asVectors[] = {
+  { "", 0x00000000uL },
+  { "a", 0xE8B7BE43uL },
+  { "abc", 0x352441C2uL },
+  { "123456789", 0xCBF43926uL },
+  { "message digest", 0x20159D7FuL },
+  { "abcdefghijklmnopqrstuvwxyz", 0x4C2750BDuL },
+  { "The quick brown fox jumps over the lazy dog", 0x414FA339uL },
+  { "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789", 0x1FC2E6D2uL }
+};
+
+/// CRC unit model: register block seen by the driver, and unit state
+static CRC_TypeDef sCrcRegs;
+static uint32_t ulUnit = CHK_UNIT_RESET;
+
+/// Unit accesses applied to the model
+static uint32_t ulUnitWrites;
+static uint32_t ulUnitResets;
+
+/// Cycle counter model
+DWT_Type sHOST_Dwt;
+
+/// Streams of the interleaved and DMA runs
+static ChkStreamTypeDef asStreams[CHK_CONTEXTS];
+
+/// Updates in the current scenario
+static uint32_t ulUpdates;
+
+/// Random state
+static uint64_t ullRng;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * CRC unit model: one data word
+ *
+ * @param[in] ulDr      Unit state
+ * @param[in] ulWord    Data word
+ * @return  (uint32_t)  New unit state
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulChkUnitWord(uint32_t ulDr, uint32_t ulWord)
+{
+  uint32_t ulReg = ulDr ^ ulWord;
+  for (uint32_t i = 0uL; i < 32uL; ++i)
+  {
+    ulReg = ((ulReg & 0x80000000uL) != 0uL) ? ((ulReg << 1) ^ CRC32_POLY) : (ulReg << 1);
+  }
+  return ulReg;
+}
+
+/*!****************************************************************************
+ * @brief
+ * CRC unit model: native CRC of whole little-endian words
+ *
+ * @param[in] ulDr      Unit state
+ * @param[in] *pucData  Data
+ * @param[in] ulLen     Number of bytes, rounded down to words
+ * @return  (uint32_t)  New unit state
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulChkUnitBlock(uint32_t ulDr, const uint8_t* pucData, uint32_t ulLen)
+{
+  for (uint32_t i = 0uL; i + 4uL <= ulLen; i += 4uL)
+  {
+    uint32_t ulWord = (uint32_t)pucData[i] | ((uint32_t)pucData[i + 1u] << 8) |
+                      ((uint32_t)pucData[i + 2u] << 16) | ((uint32_t)pucData[i + 3u] << 24);
+    ulDr = ulChkUnitWord(ulDr, ulWord);
+  }
+  return ulDr;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Bitwise reference of zlib crc32()
+ *
+ * @param[in] ulCrc     CRC of preceding data
+ * @param[in] *pucData  Data
+ * @param[in] ulLen     Number of bytes
+ * @return  (uint32_t)  CRC
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulChkCrcBitwise(uint32_t ulCrc, const uint8_t* pucData, uint32_t ulLen)
+{
+  uint32_t ulReg = ~ulCrc;
+  for (uint32_t i = 0uL; i < ulLen; ++i)
+  {
+    ulReg ^= pucData[i];
+    for (uint32_t b = 0uL; b < 8uL; ++b)
+    {
+      ulReg = ((ulReg & 1uL) != 0uL) ? ((ulReg >> 1) ^ CRC32_POLY_REFLECTED) : (ulReg >> 1);
+    }
+  }
+  return ~ulReg;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Fill stream with random data and start its context
+ *
+ * @param[out] *psStream  Stream
+ * @param[in] eMode       CRC variant
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkStreamStart(ChkStreamTypeDef* psStream, HW_CRC_ModeTypeDef eMode)
+{
+  psStream->ulOffset = ulCHK_RandRange(&ullRng, 4uL);
+  psStream->ulLen = ulCHK_RandRange(&ullRng, CHK_DATA_MAX + 1uL);
+  if (eMode == HW_CRC_MODE_NATIVE) psStream->ulLen &= ~0x3uL;
+  psStream->ulFed = 0uL;
+  for (uint32_t i = 0uL; i < psStream->ulLen; ++i)
+  {
+    psStream->aucData[psStream->ulOffset + i] = (uint8_t)ulCHK_Rand(&ullRng);
+  }
+  vHW_CRC_Start(&psStream->sCtx, eMode);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check result of a completely fed stream
+ *
+ * @param[in] *psStream   Stream
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkStreamDone(ChkStreamTypeDef* psStream)
+{
+  const uint8_t* pucData = &psStream->aucData[psStream->ulOffset];
+  uint32_t ulExpect = (psStream->sCtx.eMode == HW_CRC_MODE_ZLIB) ?
+                      ulCRC32_Update(CRC32_INIT, pucData, psStream->ulLen) :
+                      ulChkUnitBlock(CHK_UNIT_RESET, pucData, psStream->ulLen);
+  if (ulHW_CRC_Final(&psStream->sCtx) != ulExpect)
+  {
+    vCHK_Fail((psStream->sCtx.eMode == HW_CRC_MODE_ZLIB) ? "zlib CRC differs" : "native CRC differs");
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Random length of the next update: short, word sized or long
+ *
+ * @param[in] *psStream   Stream
+ * @return  (uint32_t)  Number of bytes, multiple of 4 in native mode
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulChkStreamChunk(const ChkStreamTypeDef* psStream)
+{
+  uint32_t ulLeft = psStream->ulLen - psStream->ulFed;
+  uint32_t ulLen = (ulCHK_RandRange(&ullRng, 4uL) == 0uL) ? ulCHK_RandRange(&ullRng, ulLeft + 1uL) :
+                                                            ulCHK_RandRange(&ullRng, 16uL);
+  if (ulLen > ulLeft) ulLen = ulLeft;
+  if (psStream->sCtx.eMode == HW_CRC_MODE_NATIVE) ulLen &= ~0x3uL;
+  return ulLen;
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * CRC unit model: apply previous register access, return register block
+ *
+ * @return  (CRC_TypeDef*)  Registers, DR holding the unit state
+ * @date  19.10.2026
+ ******************************************************************************/
+CRC_TypeDef* psHOST_CrcAccess(void)
+{
+  if ((sCrcRegs.CR & CRC_CR_RESET) != 0uL)
+  {
+    ulUnit = CHK_UNIT_RESET;
+    ulUnitResets++;
+  }
+  else if (sCrcRegs.DR != ulUnit)
+  {
+    ulUnit = ulChkUnitWord(ulUnit, sCrcRegs.DR);
+    ulUnitWrites++;
+  }
+  sCrcRegs.CR = 0uL;
+  sCrcRegs.DR = ulUnit;
+  return &sCrcRegs;
+}
+
+/*!****************************************************************************
+ * @brief
+ * DMA feed model: write all words to the register at once, then complete
+ *
+ * @param[in,out] *psReq    Request
+ * @param[in] *pulReg       Register
+ * @param[in] *pulSrc       Words
+ * @param[in] ulCount       Number of words
+ * @param[in] pfnCallback   Completion callback, or NULL
+ * @return  (bool)  true
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_DMA_Feed(DMAQ_RequestTypeDef* psReq, volatile uint32_t* pulReg, const uint32_t* pulSrc,
+                  uint32_t ulCount, DMAQ_CallbackTypeDef pfnCallback)
+{
+  for (uint32_t i = 0uL; i < ulCount; ++i)
+  {
+    *pulReg = pulSrc[i];
+    (void)psHOST_CrcAccess();
+  }
+  psReq->eState = DMAQ_STATE_DONE;
+  if (pfnCallback != NULL) pfnCallback(psReq);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * DMA feed model: never pending
+ *
+ * @param[in] *psReq  Request
+ * @return  (bool)  false
+ * @date  19.10.2026
+ ******************************************************************************/
+bool bHW_DMA_IsPending(const DMAQ_RequestTypeDef* psReq)
+{
+  (void)psReq;
+  return false;
+}
+
+/*!****************************************************************************
+ * @brief
+ * DMA feed model: request state
+ *
+ * @param[in] *psReq  Request
+ * @return  (DMAQ_StateTypeDef)   State
+ * @date  19.10.2026
+ ******************************************************************************/
+DMAQ_StateTypeDef eHW_DMA_Wait(const DMAQ_RequestTypeDef* psReq)
+{
+  return psReq->eState;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  unsigned long ulRuns = 20000uL;
+  unsigned int uiSeed = (unsigned int)time(NULL);
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "n:s:")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'n': ulRuns = strtoul(optarg, NULL, 0); break;
+      case 's': uiSeed = (unsigned int)strtoul(optarg, NULL, 0); break;
+      default:
+        fprintf(stderr, "Usage: %s [-n <N>] [-s <seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  printf("seed %u\n", uiSeed);
+  ullRng = ((uint64_t)uiSeed << 32) | 0x9E3779B9uLL;
+  vCHK_SetClock("update", &ulUpdates);
+  vHW_CRC_Init();
+
+  static uint8_t aucBuf[CHK_DATA_MAX + 4u];
+  HW_CRC_ContextTypeDef sCtx;
+  bool bOk = true;
+
+  // Check values, software and on the unit at every alignment
+  ulUpdates = 0uL;
+  for (uint32_t v = 0uL; v < sizeof(asVectors) / sizeof(asVectors[0]); ++v)
+  {
+    uint32_t ulLen = (uint32_t)strlen(asVectors[v].pcData);
+    bOk = bOk && (ulCRC32_Update(CRC32_INIT, asVectors[v].pcData, ulLen) == asVectors[v].ulCrc);
+    for (uint32_t ulOffset = 0uL; ulOffset < 4uL; ++ulOffset)
+    {
+      (void)memcpy(&aucBuf[ulOffset], asVectors[v].pcData, ulLen);
+      bOk = bOk && (ulHW_CRC_Calc(&aucBuf[ulOffset], ulLen) == asVectors[v].ulCrc);
+      ulUpdates++;
+    }
+  }
+  vCHK_Report("vectors", bOk, ulUpdates, "blocks");
+
+  // Random data against the bitwise reference
+  for (ulUpdates = 0uL; (ulUpdates < ulRuns) && !bCHK_Failed(); ++ulUpdates)
+  {
+    uint32_t ulLen = ulCHK_RandRange(&ullRng, CHK_DATA_MAX + 1uL);
+    uint32_t ulSplit = ulCHK_RandRange(&ullRng, ulLen + 1uL);
+    uint32_t ulInit = (ulCHK_RandRange(&ullRng, 2uL) == 0uL) ? CRC32_INIT : ulCHK_Rand(&ullRng);
+    for (uint32_t i = 0uL; i < ulLen; ++i)
+    {
+      aucBuf[i] = (uint8_t)ulCHK_Rand(&ullRng);
+    }
+    uint32_t ulExpect = ulChkCrcBitwise(ulInit, aucBuf, ulLen);
+    if (ulCRC32_Update(ulInit, aucBuf, ulLen) != ulExpect) vCHK_Fail("CRC differs from reference");
+    if (ulCRC32_Update(ulCRC32_Update(ulInit, aucBuf, ulSplit), &aucBuf[ulSplit], ulLen - ulSplit) != ulExpect)
+    {
+      vCHK_Fail("split CRC differs from reference");
+    }
+  }
+  vCHK_Report("software", true, ulUpdates, "blocks");
+
+  // Unit loaded with random states, reused without reset
+  for (ulUpdates = 0uL; (ulUpdates < ulRuns) && !bCHK_Failed(); ++ulUpdates)
+  {
+    uint32_t ulState = (ulCHK_RandRange(&ullRng, 16uL) == 0uL) ? CHK_UNIT_RESET : ulCHK_Rand(&ullRng);
+    uint32_t ulWord = ulCHK_Rand(&ullRng);
+    vHW_CRC_Start(&sCtx, HW_CRC_MODE_NATIVE);
+    sCtx.ulCrc = ulState;
+    vHW_CRC_Update(&sCtx, &ulWord, 0uL);
+    if (ulHW_CRC_Final(&sCtx) != ulState) vCHK_Fail("state not loaded");
+
+    uint32_t ulResets = ulUnitResets;
+    vHW_CRC_Update(&sCtx, &ulWord, sizeof(ulWord));
+    if (ulHW_CRC_Final(&sCtx) != ulChkUnitWord(ulState, ulWord)) vCHK_Fail("word after load differs");
+    if (ulUnitResets != ulResets) vCHK_Fail("unit reset while holding the state");
+  }
+  vCHK_Report("load", true, ulUpdates, "states");
+
+  // Interleaved contexts of both modes
+  for (uint32_t i = 0uL; i < CHK_CONTEXTS; ++i)
+  {
+    vChkStreamStart(&asStreams[i], (i & 1uL) ? HW_CRC_MODE_NATIVE : HW_CRC_MODE_ZLIB);
+  }
+  uint32_t ulStreams = 0uL;
+  uint32_t ulResets = ulUnitResets;
+  for (ulUpdates = 0uL; (ulUpdates < ulRuns) && !bCHK_Failed(); ++ulUpdates)
+  {
+    ChkStreamTypeDef* psStream = &asStreams[ulCHK_RandRange(&ullRng, CHK_CONTEXTS)];
+    uint32_t ulLen = ulChkStreamChunk(psStream);
+    vHW_CRC_Update(&psStream->sCtx, &psStream->aucData[psStream->ulOffset + psStream->ulFed], ulLen);
+    psStream->ulFed += ulLen;
+    if (psStream->ulFed == psStream->ulLen)
+    {
+      vChkStreamDone(psStream);
+      vChkStreamStart(psStream, psStream->sCtx.eMode);
+      ulStreams++;
+    }
+  }
+  vCHK_Report("interleaved", ulStreams != 0uL, ulUpdates, "updates");
+  printf("  %lu streams, %lu unit resets, %lu words\n", (unsigned long)ulStreams,
+         (unsigned long)(ulUnitResets - ulResets), (unsigned long)ulUnitWrites);
+
+  // DMA feed between CPU updates
+  vChkStreamStart(&asStreams[0], HW_CRC_MODE_ZLIB);
+  vChkStreamStart(&asStreams[1], HW_CRC_MODE_NATIVE);
+  ulStreams = 0uL;
+  for (ulUpdates = 0uL; (ulUpdates < ulRuns) && !bCHK_Failed(); ++ulUpdates)
+  {
+    ChkStreamTypeDef* psStream = &asStreams[ulCHK_RandRange(&ullRng, 2uL)];
+    uint32_t ulLen = ulChkStreamChunk(psStream);
+    uint8_t* pucData = &psStream->aucData[psStream->ulOffset + psStream->ulFed];
+    if (psStream->sCtx.eMode == HW_CRC_MODE_NATIVE)
+    {
+      // DMA needs aligned words
+      static uint32_t aulWords[CHK_DATA_MAX / 4u];
+      (void)memcpy(aulWords, pucData, ulLen);
+      if (!bHW_CRC_UpdateDma(&psStream->sCtx, aulWords, ulLen / 4uL)) vCHK_Fail("DMA feed refused");
+    }
+    else
+    {
+      vHW_CRC_Update(&psStream->sCtx, pucData, ulLen);
+    }
+    psStream->ulFed += ulLen;
+    if (psStream->ulFed == psStream->ulLen)
+    {
+      vChkStreamDone(psStream);
+      vChkStreamStart(psStream, psStream->sCtx.eMode);
+      ulStreams++;
+    }
+  }
+  vCHK_Report("dma", ulStreams != 0uL, ulUpdates, "updates");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,564 @@
+/*!****************************************************************************
+ * @file
+ * dma_sim.c
+ *
+ * @brief
+ * Simulated channel for the DMA request queue
+ *
+ * Runs lib/dmaq against a simulated memory-to-memory channel as used by
+ * hw_dma. A started chunk is transferred unit by unit into host memory when
+ * its completion event is raised, honouring the unit size and the address
+ * increment flags; an error event transfers part of the chunk and stops the
+ * channel. Every start is checked against the queue: the channel must be
+ * idle, the request must be the queue head in state BUSY with all followers
+ * QUEUED, the chunk must hold 1..ulMaxChunk units, and a continued request
+ * must resume exactly where its previous chunk ended.
+ *
+ * Scenarios: chunking of a request over a small chunk limit and over the
+ * 16-bit counter, FIFO completion order, memset and register feed transfers,
+ * a bus error in the middle of the queue, resubmission from the callback,
+ * the head/body/tail split for all relative alignments, and the shared
+ * channel owner. Finally, random copies with random chunk limits and error
+ * injection are submitted while the queue is running; each copy that ends
+ * DONE must match its source.
+ *
+ * Exits with failure status on the first error.
+ *
+ * Usage: dma_sim [-n <copies>] [-e <N>] [-s <seed>]
+ *   -n <copies>  Copies in the random run (default 20000)
+ *   -e <N>       Bus error in one chunk in N on average (default 500)
+ *   -s <seed>    Random seed
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "dmaq.h"
+#include "chk.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Channel counter limit as in hw_dma
+#define SIM_MAX_CHUNK                 0xFFFFuL
+
+/// Smallest copy handed to the queue as in hw_dma
+#define SIM_MIN_SIZE                  8uL
+
+/// Size of the large transfer buffers
+#define SIM_LARGE_SIZE                (3uL * SIM_MAX_CHUNK + 123uL)
+
+/// Requests in flight in the queued scenarios
+#define SIM_REQUESTS                  8u
+
+/// Largest copy in the random run
+#define SIM_SPAN                      512u
+
+/// Completion log entries
+#define SIM_LOG_SIZE                  64u
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vSimStart(const DMAQ_RequestTypeDef* psReq, uint32_t ulCount);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Driver
+static const DMAQ_DriverTypeDef sDrv = {
+  .pfnStart = vSimStart
+};
+
+/// Queue under test
+static DMAQ_TypeDef sQueue;
+
+/// Channel: active chunk
+static bool bActive;
+static const DMAQ_RequestTypeDef* psActive;
+static uint32_t ulActiveCount;
+
+/// Channel: end of the last completed chunk, for the continuity check
+static const DMAQ_RequestTypeDef* psLast;
+static uintptr_t ulLastDst;
+static uintptr_t ulLastSrc;
+
+/// Channel statistics
+static uint32_t ulStarts;
+static uint32_t ulErrors;
+
+/// Completion log
+static DMAQ_RequestTypeDef* apsLog[SIM_LOG_SIZE];
+static uint32_t ulLogLen;
+
+/// Transfer buffers
+static uint8_t aucLargeSrc[SIM_LARGE_SIZE];
+static uint8_t aucLargeDst[SIM_LARGE_SIZE];
+static uint8_t aaucSrc[SIM_REQUESTS][SIM_SPAN + 8u];
+static uint8_t aaucDst[SIM_REQUESTS][SIM_SPAN + 8u];
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Driver: program and enable the channel
+ *
+ * @param[in] *psReq    Request
+ * @param[in] ulCount   Transfer units
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimStart(const DMAQ_RequestTypeDef* psReq, uint32_t ulCount)
+{
+  ulStarts++;
+  if (bActive) vCHK_Exit("start while channel busy");
+  if (psReq != sQueue.psHead) vCHK_Exit("start of request other than queue head");
+  if (psReq->eState != DMAQ_STATE_BUSY) vCHK_Exit("started request not busy");
+  for (const DMAQ_RequestTypeDef* psNext = psReq->psNext; psNext != NULL; psNext = psNext->psNext)
+  {
+    if (psNext->eState != DMAQ_STATE_QUEUED) vCHK_Exit("waiting request not queued");
+  }
+  if ((ulCount == 0uL) || (ulCount > sQueue.ulMaxChunk) || (ulCount > psReq->ulCount))
+  {
+    vCHK_Exit("chunk size out of range");
+  }
+  if ((psReq == psLast) && ((psReq->ulDst != ulLastDst) || (psReq->ulSrc != ulLastSrc)))
+  {
+    vCHK_Exit("chunk does not continue previous chunk");
+  }
+  if (psReq->ucShift > 2u) vCHK_Exit("unit size out of range");
+
+  bActive = true;
+  psActive = psReq;
+  ulActiveCount = ulCount;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Transfer units of the active chunk
+ *
+ * @param[in] ulUnits   Units to transfer
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimTransfer(uint32_t ulUnits)
+{
+  uint32_t ulSize = 1uL << psActive->ucShift;
+  uintptr_t ulDst = psActive->ulDst;
+  uintptr_t ulSrc = psActive->ulSrc;
+
+  for (uint32_t i = 0uL; i < ulUnits; ++i)
+  {
+    (void)memcpy((void*)ulDst, (const void*)ulSrc, ulSize);
+    if ((psActive->ucFlags & DMAQ_FLAG_DST_INC) != 0u) ulDst += ulSize;
+    if ((psActive->ucFlags & DMAQ_FLAG_SRC_INC) != 0u) ulSrc += ulSize;
+  }
+
+  // Only a request with units left may continue
+  psLast = (ulActiveCount < psActive->ulCount) ? psActive : NULL;
+  ulLastDst = ulDst;
+  ulLastSrc = ulSrc;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Complete active chunk and report the event to the queue
+ *
+ * @param[in] bError    Bus error after part of the chunk
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimEvent(bool bError)
+{
+  if (!bActive) vCHK_Exit("event on idle channel");
+  bActive = false;
+
+  if (bError)
+  {
+    ulErrors++;
+    vSimTransfer((uint32_t)rand() % ulActiveCount);
+    psLast = NULL;
+    vDMAQ_Event(&sQueue, DMAQ_EVENT_ERROR);
+  }
+  else
+  {
+    vSimTransfer(ulActiveCount);
+    vDMAQ_Event(&sQueue, DMAQ_EVENT_DONE);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run channel until the queue is empty
+ *
+ * @param[in] uiErrorRate   Bus error in one chunk in N, 0 for never
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimRun(unsigned int uiErrorRate)
+{
+  while (sQueue.psHead != NULL)
+  {
+    vSimEvent(bCHK_Chance(uiErrorRate));
+  }
+  if (bActive) vCHK_Exit("channel busy after completion");
+  if (sQueue.psTail != NULL) vCHK_Exit("queue tail left after completion");
+}
+
+/*!****************************************************************************
+ * @brief
+ * Request callback: log completion
+ *
+ * @param[in] *psReq  Request
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimDone(DMAQ_RequestTypeDef* psReq)
+{
+  if ((psReq->eState != DMAQ_STATE_DONE) && (psReq->eState != DMAQ_STATE_ERROR))
+  {
+    vCHK_Exit("callback while pending");
+  }
+  for (const DMAQ_RequestTypeDef* psNext = sQueue.psHead; psNext != NULL; psNext = psNext->psNext)
+  {
+    if (psNext == psReq) vCHK_Exit("callback before dequeue");
+  }
+  if (ulLogLen < SIM_LOG_SIZE) apsLog[ulLogLen] = psReq;
+  ulLogLen++;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Request callback: submit again while the context counts down
+ *
+ * @param[in] *psReq  Request
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimResubmit(DMAQ_RequestTypeDef* psReq)
+{
+  uint32_t* pulLeft = psReq->pvContext;
+  vSimDone(psReq);
+  if ((*pulLeft)-- > 1u)
+  {
+    psReq->ulDst -= 16u;
+    psReq->ulSrc -= 16u;
+    psReq->ulCount = 4u;
+    vDMAQ_Submit(&sQueue, psReq);
+    if (psReq->eState == DMAQ_STATE_IDLE) vCHK_Exit("resubmitted request idle");
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Prepare a request
+ *
+ * @param[out] *psReq   Request
+ * @param[in] *pvDst    Destination
+ * @param[in] *pvSrc    Source
+ * @param[in] ulCount   Transfer units
+ * @param[in] ucShift   Unit size, log2 of bytes
+ * @param[in] ucFlags   Flags DMAQ_FLAG_x
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimRequest(DMAQ_RequestTypeDef* psReq, void* pvDst, const void* pvSrc,
+                        uint32_t ulCount, uint8_t ucShift, uint8_t ucFlags)
+{
+  *psReq = (DMAQ_RequestTypeDef){
+    .ulDst = (uintptr_t)pvDst, .ulSrc = (uintptr_t)pvSrc, .ulCount = ulCount, .ucShift = ucShift,
+    .ucFlags = ucFlags, .pfnCallback = vSimDone
+  };
+}
+
+/*!****************************************************************************
+ * @brief
+ * Submit a copy as hw_dma does: head and tail on the CPU, body by DMA
+ *
+ * @param[out] *psReq   Request
+ * @param[out] *pucDst  Destination
+ * @param[in] *pucSrc   Source
+ * @param[in] ulSize    Size in bytes (min. SIM_MIN_SIZE)
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimCopy(DMAQ_RequestTypeDef* psReq, uint8_t* pucDst, const uint8_t* pucSrc,
+                     uint32_t ulSize)
+{
+  DMAQ_PlanTypeDef sPlan;
+  vDMAQ_Plan((uintptr_t)pucDst, (uintptr_t)pucSrc, ulSize, &sPlan);
+  (void)memcpy(pucDst, pucSrc, sPlan.ulHead);
+  pucDst += sPlan.ulHead;
+  pucSrc += sPlan.ulHead;
+  (void)memcpy(pucDst + sPlan.ulBody, pucSrc + sPlan.ulBody, sPlan.ulTail);
+
+  vSimRequest(psReq, pucDst, pucSrc, sPlan.ulBody >> sPlan.ucShift, sPlan.ucShift,
+              DMAQ_FLAG_DST_INC | DMAQ_FLAG_SRC_INC);
+  vDMAQ_Submit(&sQueue, psReq);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Fill buffer with random bytes
+ *
+ * @param[out] *pucBuf  Buffer
+ * @param[in] ulSize    Size in bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimRandomize(uint8_t* pucBuf, uint32_t ulSize)
+{
+  for (uint32_t i = 0uL; i < ulSize; ++i)
+  {
+    pucBuf[i] = (uint8_t)rand();
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check the head/body/tail split of one copy
+ *
+ * @param[in] ulDst     Destination address
+ * @param[in] ulSrc     Source address
+ * @param[in] ulSize    Size in bytes
+ * @return  (bool)  Split valid and widest possible
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimPlanOk(uintptr_t ulDst, uintptr_t ulSrc, uint32_t ulSize)
+{
+  DMAQ_PlanTypeDef sPlan;
+  vDMAQ_Plan(ulDst, ulSrc, ulSize, &sPlan);
+
+  uint32_t ulDiff = (uint32_t)((ulDst ^ ulSrc) & 0x3u);
+  uint32_t ulWidest = (ulDiff == 0uL) ? 2uL : (ulDiff == 2uL) ? 1uL : 0uL;
+  uint32_t ulUnit = 1uL << sPlan.ucShift;
+  return (sPlan.ucShift == ulWidest) &&
+         (sPlan.ulHead + sPlan.ulBody + sPlan.ulTail == ulSize) &&
+         (sPlan.ulHead < ulUnit) && (sPlan.ulTail < ulUnit) &&
+         (((ulDst + sPlan.ulHead) & (ulUnit - 1u)) == 0u) &&
+         (((ulSrc + sPlan.ulHead) & (ulUnit - 1u)) == 0u) &&
+         ((sPlan.ulBody & (ulUnit - 1u)) == 0u);
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Simulator entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  unsigned long ulCopies = 20000uL;
+  unsigned int uiErrorRate = 500u;
+  unsigned int uiSeed = (unsigned int)time(NULL);
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "n:e:s:")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'n': ulCopies = strtoul(optarg, NULL, 0); break;
+      case 'e': uiErrorRate = (unsigned int)strtoul(optarg, NULL, 0); break;
+      case 's': uiSeed = (unsigned int)strtoul(optarg, NULL, 0); break;
+      default:
+        fprintf(stderr, "Usage: %s [-n <copies>] [-e <N>] [-s <seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  printf("seed %u\n", uiSeed);
+  srand(uiSeed);
+
+  DMAQ_RequestTypeDef asReqs[SIM_REQUESTS];
+  uint32_t ulStart;
+  bool bOk;
+
+  // Chunking over a small limit: ceil(50 / 7) chunks, state BUSY until done
+  vDMAQ_Init(&sQueue, &sDrv, 7uL);
+  ulStart = ulStarts;
+  ulLogLen = 0u;
+  vSimRandomize(aaucSrc[0], 200u);
+  vSimRequest(&asReqs[0], aaucDst[0], aaucSrc[0], 50u, 2u, DMAQ_FLAG_DST_INC | DMAQ_FLAG_SRC_INC);
+  bOk = (asReqs[0].eState == DMAQ_STATE_IDLE) && !bDMAQ_IsPending(&asReqs[0]);
+  vDMAQ_Submit(&sQueue, &asReqs[0]);
+  bOk = bOk && (asReqs[0].eState == DMAQ_STATE_BUSY) && bDMAQ_IsPending(&asReqs[0]);
+  vSimEvent(false);
+  bOk = bOk && (asReqs[0].eState == DMAQ_STATE_BUSY) && (ulLogLen == 0u);
+  vSimRun(0u);
+  bOk = bOk && (asReqs[0].eState == DMAQ_STATE_DONE) && (ulLogLen == 1u) &&
+        (ulStarts - ulStart == 8u) && (memcmp(aaucDst[0], aaucSrc[0], 200u) == 0);
+  vCHK_Report("chunking", bOk, ulStarts - ulStart, "chunks");
+
+  // Counter limit: 3 full chunks and a remainder of byte units
+  vDMAQ_Init(&sQueue, &sDrv, SIM_MAX_CHUNK);
+  ulStart = ulStarts;
+  vSimRandomize(aucLargeSrc, SIM_LARGE_SIZE);
+  vSimRequest(&asReqs[0], aucLargeDst, aucLargeSrc, SIM_LARGE_SIZE, 0u,
+              DMAQ_FLAG_DST_INC | DMAQ_FLAG_SRC_INC);
+  vDMAQ_Submit(&sQueue, &asReqs[0]);
+  vSimRun(0u);
+  bOk = (asReqs[0].eState == DMAQ_STATE_DONE) && (ulStarts - ulStart == 4u) &&
+        (memcmp(aucLargeDst, aucLargeSrc, SIM_LARGE_SIZE) == 0);
+  vCHK_Report("counter limit", bOk, ulStarts - ulStart, "chunks");
+
+  // FIFO: followers wait in state QUEUED and complete in submission order
+  vDMAQ_Init(&sQueue, &sDrv, 16uL);
+  ulStart = ulStarts;
+  ulLogLen = 0u;
+  for (uint32_t i = 0u; i < SIM_REQUESTS; ++i)
+  {
+    vSimRandomize(aaucSrc[i], SIM_SPAN);
+    (void)memset(aaucDst[i], 0, SIM_SPAN);
+    vSimRequest(&asReqs[i], aaucDst[i], aaucSrc[i], 20u + 9u * i, 1u,
+                DMAQ_FLAG_DST_INC | DMAQ_FLAG_SRC_INC);
+    vDMAQ_Submit(&sQueue, &asReqs[i]);
+  }
+  bOk = (asReqs[0].eState == DMAQ_STATE_BUSY) && (asReqs[1].eState == DMAQ_STATE_QUEUED);
+  vSimRun(0u);
+  bOk = bOk && (ulLogLen == SIM_REQUESTS);
+  for (uint32_t i = 0u; bOk && (i < SIM_REQUESTS); ++i)
+  {
+    bOk = (apsLog[i] == &asReqs[i]) && (asReqs[i].eState == DMAQ_STATE_DONE) &&
+          (memcmp(aaucDst[i], aaucSrc[i], 2u * (20u + 9u * i)) == 0) &&
+          (aaucDst[i][2u * (20u + 9u * i)] == 0u);
+  }
+  vCHK_Report("fifo", bOk, ulStarts - ulStart, "chunks");
+
+  // Memset: fixed source pattern; feed: fixed destination register
+  ulStart = ulStarts;
+  (void)memset(aaucDst[0], 0, SIM_SPAN);
+  vSimRequest(&asReqs[0], aaucDst[0], &asReqs[0].ulFill, 100u, 2u, DMAQ_FLAG_DST_INC);
+  asReqs[0].ulFill = 0xA5A5A5A5uL;
+  uint32_t aulWords[40];
+  volatile uint32_t ulRegister = 0uL;
+  for (uint32_t i = 0u; i < 40u; ++i)
+  {
+    aulWords[i] = 0x1000uL + i;
+  }
+  vSimRequest(&asReqs[1], (void*)&ulRegister, aulWords, 40u, 2u, DMAQ_FLAG_SRC_INC);
+  vDMAQ_Submit(&sQueue, &asReqs[0]);
+  vDMAQ_Submit(&sQueue, &asReqs[1]);
+  vSimRun(0u);
+  bOk = (asReqs[0].eState == DMAQ_STATE_DONE) && (asReqs[1].eState == DMAQ_STATE_DONE) &&
+        (ulRegister == 0x1000uL + 39u) && (aaucDst[0][400] == 0u);
+  for (uint32_t i = 0u; bOk && (i < 400u); ++i)
+  {
+    bOk = (aaucDst[0][i] == 0xA5u);
+  }
+  vCHK_Report("fill and feed", bOk, ulStarts - ulStart, "chunks");
+
+  // Bus error in the second request: it fails, the queue continues
+  ulStart = ulStarts;
+  ulLogLen = 0u;
+  for (uint32_t i = 0u; i < 3u; ++i)
+  {
+    (void)memset(aaucDst[i], 0, SIM_SPAN);
+    vSimRequest(&asReqs[i], aaucDst[i], aaucSrc[i], 40u, 2u, DMAQ_FLAG_DST_INC | DMAQ_FLAG_SRC_INC);
+    vDMAQ_Submit(&sQueue, &asReqs[i]);
+  }
+  vSimEvent(false);
+  vSimEvent(false);
+  vSimEvent(false);
+  vSimEvent(true);
+  bOk = (asReqs[0].eState == DMAQ_STATE_DONE) && (asReqs[1].eState == DMAQ_STATE_ERROR) &&
+        (asReqs[2].eState == DMAQ_STATE_BUSY) && (ulLogLen == 2u);
+  vSimRun(0u);
+  bOk = bOk && (asReqs[2].eState == DMAQ_STATE_DONE) && (ulLogLen == 3u) &&
+        (apsLog[1] == &asReqs[1]) && (memcmp(aaucDst[2], aaucSrc[2], 160u) == 0);
+  vCHK_Report("bus error", bOk, ulStarts - ulStart, "chunks");
+
+  // Resubmission from the callback, the channel never waits
+  ulStart = ulStarts;
+  ulLogLen = 0u;
+  uint32_t ulLeft = 5u;
+  vSimRequest(&asReqs[0], aaucDst[0], aaucSrc[0], 4u, 2u, DMAQ_FLAG_DST_INC | DMAQ_FLAG_SRC_INC);
+  asReqs[0].pfnCallback = vSimResubmit;
+  asReqs[0].pvContext = &ulLeft;
+  vDMAQ_Submit(&sQueue, &asReqs[0]);
+  vSimRun(0u);
+  bOk = (ulLogLen == 5u) && (ulStarts - ulStart == 5u) && (asReqs[0].eState == DMAQ_STATE_DONE);
+  vCHK_Report("resubmit", bOk, ulStarts - ulStart, "chunks");
+
+  // Split for every relative alignment and small sizes
+  ulStart = ulStarts;
+  bOk = true;
+  for (uintptr_t ulDst = 0x20000000u; bOk && (ulDst < 0x20000004u); ++ulDst)
+  {
+    for (uintptr_t ulSrc = 0x08000000u; bOk && (ulSrc < 0x08000004u); ++ulSrc)
+    {
+      for (uint32_t ulSize = SIM_MIN_SIZE; bOk && (ulSize < 64u); ++ulSize)
+      {
+        bOk = bSimPlanOk(ulDst, ulSrc, ulSize);
+      }
+    }
+  }
+  vCHK_Report("plan", bOk, ulStarts - ulStart, "chunks");
+
+  // Shared channel: one owner at a time, release only by the owner
+  ulStart = ulStarts;
+  volatile uint32_t ulOwner = DMAQ_OWNER_FREE;
+  bOk = bDMAQ_Acquire(&ulOwner, 1uL) && bDMAQ_Acquire(&ulOwner, 1uL) &&
+        !bDMAQ_Acquire(&ulOwner, 2uL) && !bDMAQ_Release(&ulOwner, 2uL) &&
+        !bDMAQ_Release(&ulOwner, DMAQ_OWNER_FREE) && (ulOwner == 1uL) &&
+        bDMAQ_Release(&ulOwner, 1uL) && (ulOwner == DMAQ_OWNER_FREE) &&
+        !bDMAQ_Release(&ulOwner, 1uL) && bDMAQ_Acquire(&ulOwner, 2uL);
+  vCHK_Report("shared", bOk, ulStarts - ulStart, "chunks");
+
+  // Random copies submitted while the queue runs, random chunk limits
+  ulStart = ulStarts;
+  ulErrors = 0u;
+  uint32_t aulSize[SIM_REQUESTS] = { 0u };
+  unsigned long ulSubmitted = 0uL;
+  unsigned long ulDone = 0uL;
+  unsigned long ulBytes = 0uL;
+  uint32_t ulBad = 0u;
+  vDMAQ_Init(&sQueue, &sDrv, 1uL + (uint32_t)rand() % 64u);
+  for (;;)
+  {
+    // Collect completed copies
+    for (uint32_t i = 0u; i < SIM_REQUESTS; ++i)
+    {
+      if ((aulSize[i] == 0u) || bDMAQ_IsPending(&asReqs[i])) continue;
+      if (asReqs[i].eState == DMAQ_STATE_DONE)
+      {
+        ulDone++;
+        ulBytes += aulSize[i];
+        if (memcmp(&aaucDst[i][aaucDst[i][SIM_SPAN + 7u] & 3u],
+                   &aaucSrc[i][aaucSrc[i][SIM_SPAN + 7u] & 3u], aulSize[i]) != 0)
+        {
+          ulBad++;
+        }
+      }
+      aulSize[i] = 0u;
+    }
+    if ((ulSubmitted == ulCopies) && (sQueue.psHead == NULL)) break;
+
+    // New chunk limit whenever the queue drains
+    if ((sQueue.psHead == NULL) && bCHK_Chance(4u))
+    {
+      vDMAQ_Init(&sQueue, &sDrv, 1uL + (uint32_t)rand() % 64u);
+    }
+
+    uint32_t i = (uint32_t)rand() % SIM_REQUESTS;
+    if ((ulSubmitted < ulCopies) && (aulSize[i] == 0u) && bCHK_Chance(2u))
+    {
+      // Offsets are kept past the copy so the check finds them again
+      uint32_t ulDstOfs = (uint32_t)rand() & 3u;
+      uint32_t ulSrcOfs = (uint32_t)rand() & 3u;
+      aaucDst[i][SIM_SPAN + 7u] = (uint8_t)ulDstOfs;
+      aaucSrc[i][SIM_SPAN + 7u] = (uint8_t)ulSrcOfs;
+      aulSize[i] = SIM_MIN_SIZE + (uint32_t)rand() % (SIM_SPAN - SIM_MIN_SIZE);
+      vSimRandomize(&aaucSrc[i][ulSrcOfs], aulSize[i]);
+      vSimCopy(&asReqs[i], &aaucDst[i][ulDstOfs], &aaucSrc[i][ulSrcOfs], aulSize[i]);
+      ulSubmitted++;
+    }
+    else if (sQueue.psHead != NULL)
+    {
+      vSimEvent(bCHK_Chance(uiErrorRate));
+    }
+  }
+  vCHK_Report("random", (ulBad == 0u) && !bActive && (ulDone + ulErrors == ulSubmitted), ulStarts - ulStart, "chunks");
+  printf("  %lu copies, %lu done with %lu bytes, %lu bus errors\n", ulSubmitted, ulDone, ulBytes,
+         (unsigned long)ulErrors);
+
+  return EXIT_SUCCESS;
+}
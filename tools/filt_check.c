@@ -0,0 +1,344 @@
+/*!****************************************************************************
+ * @file
+ * filt_check.c
+ *
+ * @brief
+ * Host check of the block filters against double precision
+ *
+ * Runs lib/filter on the host and compares every output with the
+ * double-precision result:
+ *
+ *   decimate    Per-channel sums for decimation ratios 1..256 and 1..8
+ *               interleaved channels, exact
+ *   adc_12q4    Decimated 12-bit samples scaled to 12.4 fixed-point as in
+ *               hw_adc, truncated: 0 <= mean * 16 - result < 1
+ *   movavg      Moving average over the last FILT_MOVAVG_LEN inputs,
+ *               truncated: 0 <= mean - result < 1
+ *
+ * and checks the edges: full-scale sums up to the 32-bit limit, step and
+ * impulse responses that settle after FILT_MOVAVG_LEN inputs, full-scale
+ * input without overflow, and a running sum that does not drift from the
+ * history over a long run.
+ *
+ * For each check, the error range in LSB is printed together with its
+ * limits. Exits with failure status if any limit is exceeded.
+ *
+ * Usage: filt_check [-n <N>] [-s <seed>]
+ *   -n <N>       Random samples per check (default 1000000)
+ *   -s <seed>    Random seed
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "filter.h"
+#include "chk.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Largest decimation ratio as power of two
+#define CHK_FRAMES_SHIFT_MAX          8u
+
+/// Largest number of interleaved channels
+#define CHK_CHANNELS_MAX              8u
+
+/// Frames of full-scale samples that just fit into a 32-bit sum
+#define CHK_FRAMES_FULL               65537uL
+
+/// Decimation ratio of hw_adc as power of two
+#define CHK_ADC_FRAMES_SHIFT          4u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Signed error statistics of one check, error = reference - result
+typedef struct {
+  const char* pcName;             ///< Check
+  double dLow;                    ///< Smallest allowed error in LSB
+  double dHigh;                   ///< Error must stay below, in LSB
+  double dMin;                    ///< Smallest error in LSB
+  double dMax;                    ///< Largest error in LSB
+  uint64_t ullCount;              ///< Number of samples
+  bool bEdges;                    ///< Edge cases passed
+} ChkStatTypeDef;
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Random state
+static uint64_t ullRng;
+
+/// Overall result
+static bool bAllOk = true;
+
+/// Sample block and full-scale block
+static uint16_t auiBlock[(1u << CHK_FRAMES_SHIFT_MAX) * CHK_CHANNELS_MAX];
+static uint16_t auiFull[CHK_FRAMES_FULL];
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Random sample, with extra weight on the range ends
+ *
+ * @param[in] uiMax   Full scale
+ * @return  (uint16_t)  Sample
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint16_t uiChkRandSample(uint16_t uiMax)
+{
+  uint32_t ulSel = ulCHK_Rand(&ullRng) & 15u;
+  if (ulSel == 0u) return 0u;
+  if (ulSel == 1u) return uiMax;
+  return (uint16_t)(ulCHK_Rand(&ullRng) % ((uint32_t)uiMax + 1u));
+}
+
+/*!****************************************************************************
+ * @brief
+ * Record one sample
+ *
+ * @param[in,out] *psStat  Statistics
+ * @param[in] dGot         Result in LSB
+ * @param[in] dRef         Reference in LSB
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkSample(ChkStatTypeDef* psStat, double dGot, double dRef)
+{
+  double dErr = dRef - dGot;
+  if ((psStat->ullCount == 0u) || (dErr < psStat->dMin)) psStat->dMin = dErr;
+  if ((psStat->ullCount == 0u) || (dErr > psStat->dMax)) psStat->dMax = dErr;
+  psStat->ullCount++;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Print statistics and update overall result
+ *
+ * @param[in] *psStat  Statistics
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkReport(const ChkStatTypeDef* psStat)
+{
+  bool bOk = psStat->bEdges && (psStat->dMin >= psStat->dLow) &&
+             ((psStat->dMax < psStat->dHigh) || ((psStat->dHigh == 0.0) && (psStat->dMax == 0.0)));
+  printf("%-14s %10llu samples  error %+9.6f .. %+9.6f LSB  limit [%+.0f, %+.0f)  edges %s  %s\n",
+         psStat->pcName, (unsigned long long)psStat->ullCount, psStat->dMin, psStat->dMax,
+         psStat->dLow, psStat->dHigh, psStat->bEdges ? "ok" : "FAIL", bOk ? "ok" : "FAIL");
+  bAllOk = bAllOk && bOk;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Decimation into per-channel sums, and 12.4 fixed-point scaling as in hw_adc
+ *
+ * @param[in] ullN  Random samples
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkDecimate(uint64_t ullN)
+{
+  ChkStatTypeDef sSum = { .pcName = "decimate", .dLow = 0.0, .dHigh = 0.0, .bEdges = true };
+  ChkStatTypeDef sAdc = { .pcName = "adc_12q4", .dLow = 0.0, .dHigh = 1.0, .bEdges = true };
+  uint32_t aulSums[CHK_CHANNELS_MAX];
+
+  uint64_t ullSamples = 0u;
+  while (ullSamples < ullN)
+  {
+    uint32_t ulShift = ulCHK_Rand(&ullRng) % (CHK_FRAMES_SHIFT_MAX + 1u);
+    uint32_t ulFrames = 1uL << ulShift;
+    uint32_t ulChannels = 1uL + ulCHK_Rand(&ullRng) % CHK_CHANNELS_MAX;
+    uint16_t uiMax = (ulCHK_Rand(&ullRng) & 1u) ? 0xFFFFu : 0x0FFFu;
+    for (uint32_t i = 0uL; i < ulFrames * ulChannels; ++i)
+    {
+      auiBlock[i] = uiChkRandSample(uiMax);
+    }
+    vFILT_Decimate(auiBlock, ulFrames, ulChannels, aulSums);
+
+    for (uint32_t c = 0uL; c < ulChannels; ++c)
+    {
+      double dRef = 0.0;
+      for (uint32_t f = 0uL; f < ulFrames; ++f)
+      {
+        dRef += auiBlock[f * ulChannels + c];
+      }
+      vChkSample(&sSum, aulSums[c], dRef);
+
+      // 12-bit samples at or above the hw_adc ratio: 12.4 of the mean
+      if ((uiMax == 0x0FFFu) && (ulShift >= CHK_ADC_FRAMES_SHIFT))
+      {
+        uint16_t uiSample = (uint16_t)(aulSums[c] >> (ulShift - CHK_ADC_FRAMES_SHIFT));
+        vChkSample(&sAdc, uiSample, dRef / ulFrames * 16.0);
+      }
+    }
+    ullSamples += (uint64_t)ulFrames * ulChannels;
+  }
+
+  // Full scale: 12-bit samples give 0xFFF0 in 12.4, 16-bit samples fill 32 bits
+  for (uint32_t i = 0uL; i < CHK_FRAMES_FULL; ++i)
+  {
+    auiFull[i] = 0x0FFFu;
+  }
+  vFILT_Decimate(auiFull, 1uL << CHK_ADC_FRAMES_SHIFT, 1uL, aulSums);
+  sAdc.bEdges = (aulSums[0] == 0xFFF0uL);
+  for (uint32_t i = 0uL; i < CHK_FRAMES_FULL; ++i)
+  {
+    auiFull[i] = 0xFFFFu;
+  }
+  vFILT_Decimate(auiFull, CHK_FRAMES_FULL, 1uL, aulSums);
+  sSum.bEdges = (aulSums[0] == 0xFFFFFFFFuL);
+
+  // No frames: sums cleared
+  aulSums[0] = 1uL;
+  vFILT_Decimate(auiFull, 0uL, 1uL, aulSums);
+  sSum.bEdges = sSum.bEdges && (aulSums[0] == 0uL);
+
+  vChkReport(&sSum);
+  vChkReport(&sAdc);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Response of a moving average initialised to uiFrom to a step to uiTo
+ *
+ * @param[in] uiFrom  Initial value
+ * @param[in] uiTo    Step value
+ * @return  (bool)  Output is floor of the window mean and settles after
+ *                  FILT_MOVAVG_LEN inputs
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bChkStep(uint16_t uiFrom, uint16_t uiTo)
+{
+  FILT_MovAvgTypeDef sFilt;
+  vFILT_MovAvgInit(&sFilt, uiFrom);
+
+  bool bOk = true;
+  for (uint32_t k = 1uL; k <= 2u * FILT_MOVAVG_LEN; ++k)
+  {
+    uint32_t ulNew = (k < FILT_MOVAVG_LEN) ? k : FILT_MOVAVG_LEN;
+    uint32_t ulRef = ((FILT_MOVAVG_LEN - ulNew) * uiFrom + ulNew * uiTo) >> FILT_MOVAVG_SHIFT;
+    uint16_t uiOut = uiFILT_MovAvgPush(&sFilt, uiTo);
+    bOk = bOk && (uiOut == ulRef);
+    if ((k < FILT_MOVAVG_LEN) && (uiTo > uiFrom))
+    {
+      // Truncation may reach a lower value early, a higher one only with the full window
+      bOk = bOk && (uiOut < uiTo);
+    }
+  }
+  return bOk && (sFilt.ulSum == ((uint32_t)uiTo << FILT_MOVAVG_SHIFT));
+}
+
+/*!****************************************************************************
+ * @brief
+ * Moving average window, truncation and full-scale edges
+ *
+ * @param[in] ullN  Random samples
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkMovAvg(uint64_t ullN)
+{
+  ChkStatTypeDef sStat = { .pcName = "movavg", .dLow = 0.0, .dHigh = 1.0, .bEdges = true };
+  FILT_MovAvgTypeDef sFilt;
+  uint16_t auiHist[FILT_MOVAVG_LEN];
+
+  // Random restarts with 16-bit and 12.4 input ranges
+  uint64_t i = 0u;
+  while (i < ullN)
+  {
+    uint16_t uiMax = (ulCHK_Rand(&ullRng) & 1u) ? 0xFFFFu : 0xFFF0u;
+    uint16_t uiInit = uiChkRandSample(uiMax);
+    vFILT_MovAvgInit(&sFilt, uiInit);
+    for (uint32_t j = 0uL; j < FILT_MOVAVG_LEN; ++j)
+    {
+      auiHist[j] = uiInit;
+    }
+    for (uint32_t j = 0uL; (j < 4096u) && (i < ullN); ++j, ++i)
+    {
+      uint16_t uiIn = uiChkRandSample(uiMax);
+      auiHist[j % FILT_MOVAVG_LEN] = uiIn;
+      double dRef = 0.0;
+      for (uint32_t k = 0uL; k < FILT_MOVAVG_LEN; ++k)
+      {
+        dRef += auiHist[k];
+      }
+      vChkSample(&sStat, uiFILT_MovAvgPush(&sFilt, uiIn), dRef / FILT_MOVAVG_LEN);
+    }
+
+    // Running sum equals the history
+    uint32_t ulSum = 0uL;
+    for (uint32_t k = 0uL; k < FILT_MOVAVG_LEN; ++k)
+    {
+      ulSum += sFilt.auiHist[k];
+    }
+    sStat.bEdges = sStat.bEdges && (sFilt.ulSum == ulSum);
+  }
+
+  // Steps between the range ends and by one LSB, both directions
+  sStat.bEdges = sStat.bEdges && bChkStep(0u, 0xFFFFu) && bChkStep(0xFFFFu, 0u) &&
+                 bChkStep(0u, FILT_MOVAVG_LEN) && bChkStep(0x1234u, 0x1234u);
+  for (uint32_t j = 0uL; j < FILT_MOVAVG_LEN; ++j)
+  {
+    sStat.bEdges = sStat.bEdges && bChkStep(0u, (uint16_t)j) &&
+                   bChkStep(0xFFFFu, (uint16_t)(0xFFFFu - j));
+  }
+
+  // Impulse shows up in exactly FILT_MOVAVG_LEN outputs
+  vFILT_MovAvgInit(&sFilt, 0u);
+  uint32_t ulNonZero = 0uL;
+  for (uint32_t j = 0uL; j < 4u * FILT_MOVAVG_LEN; ++j)
+  {
+    if (uiFILT_MovAvgPush(&sFilt, (j == 1u) ? 0xFFFFu : 0u) != 0u) ulNonZero++;
+  }
+  sStat.bEdges = sStat.bEdges && (ulNonZero == FILT_MOVAVG_LEN);
+
+  // Full-scale input for a long run: no overflow, no drift
+  vFILT_MovAvgInit(&sFilt, 0xFFFFu);
+  bool bFull = true;
+  for (uint32_t j = 0uL; j < 1000000u; ++j)
+  {
+    bFull = bFull && (uiFILT_MovAvgPush(&sFilt, 0xFFFFu) == 0xFFFFu);
+  }
+  sStat.bEdges = sStat.bEdges && bFull;
+
+  vChkReport(&sStat);
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Check entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  uint64_t ullN = 1000000u;
+  uint64_t ullSeed = (uint64_t)time(NULL);
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "n:s:")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'n': ullN = strtoull(optarg, NULL, 0); break;
+      case 's': ullSeed = strtoull(optarg, NULL, 0); break;
+      default:
+        fprintf(stderr, "Usage: %s [-n <N>] [-s <seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  ullRng = ullSeed | 1u;
+  printf("seed %llu\n", (unsigned long long)ullSeed);
+
+  vChkDecimate(ullN);
+  vChkMovAvg(ullN);
+
+  return bAllOk ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,376 @@
+/*!****************************************************************************
+ * @file
+ * fix_check.c
+ *
+ * @brief
+ * Host accuracy check of the fixed-point library against double precision
+ *
+ * Runs every function of lib/fixmath on the host (portable C path, same
+ * results as the Cortex-M3 instructions) over corner cases and exhaustive or
+ * pseudo-random inputs and compares with the double-precision result. For
+ * each function, the largest error in LSB of the result format is printed
+ * together with its limit; formatting is compared with printf("%.*f").
+ *
+ * Exits with failure status if any limit is exceeded.
+ *
+ * Usage: fix_check [-n <N>] [-s <seed>]
+ *   -n <N>       Random samples per function (default 1000000)
+ *   -s <seed>    Random seed
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "fixmath.h"
+#include "chk.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// 2^15 and 2^31
+#define CHK_Q15                       32768.0
+#define CHK_Q31                       2147483648.0
+
+/// Dot product length for the multiply-accumulate check
+#define CHK_DOT_LEN                   64u
+
+/// Full turn in radians per binary angle unit
+#define CHK_RAD16                     (2.0 * M_PI / 65536.0)
+#define CHK_RAD32                     (2.0 * M_PI / 4294967296.0)
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Error statistics of one function
+typedef struct {
+  const char* pcName;             ///< Function
+  double dLimit;                  ///< Allowed error in LSB
+  double dMax;                    ///< Largest error in LSB
+  uint64_t ullCount;              ///< Number of samples
+  double dWorstIn;                ///< Input with the largest error
+} ChkStatTypeDef;
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Random state
+static uint64_t ullRng;
+
+/// Overall result
+static bool bAllOk = true;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Record one sample
+ *
+ * @param[in,out] *psStat  Statistics
+ * @param[in] dGot         Result in LSB
+ * @param[in] dRef         Reference in LSB
+ * @param[in] dIn          Input (for the report)
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkSample(ChkStatTypeDef* psStat, double dGot, double dRef, double dIn)
+{
+  double dErr = fabs(dGot - dRef);
+  if (dErr > psStat->dMax)
+  {
+    psStat->dMax = dErr;
+    psStat->dWorstIn = dIn;
+  }
+  psStat->ullCount++;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Print statistics and update overall result
+ *
+ * @param[in] *psStat  Statistics
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkReport(const ChkStatTypeDef* psStat)
+{
+  bool bOk = psStat->dMax <= psStat->dLimit;
+  printf("%-14s %10llu samples  max %9.6f LSB  limit %5.2f  %s",
+         psStat->pcName, (unsigned long long)psStat->ullCount, psStat->dMax,
+         psStat->dLimit, bOk ? "ok" : "FAIL");
+  if (!bOk) printf("  (input %.17g)", psStat->dWorstIn);
+  printf("\n");
+  bAllOk = bAllOk && bOk;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Random Q31 value, with extra weight on the range ends and small values
+ *
+ * @return  (int32_t)  Value
+ * @date  19.10.2026
+ ******************************************************************************/
+static int32_t lChkRandQ31(void)
+{
+  uint32_t ulSel = ulCHK_Rand(&ullRng) & 15u;
+  if (ulSel == 0u) return FIX_Q31_MIN + (int32_t)(ulCHK_Rand(&ullRng) & 0xFFu);
+  if (ulSel == 1u) return FIX_Q31_MAX - (int32_t)(ulCHK_Rand(&ullRng) & 0xFFu);
+  if (ulSel == 2u) return (int32_t)ulCHK_Rand(&ullRng) >> (ulCHK_Rand(&ullRng) & 31u);
+  return (int32_t)ulCHK_Rand(&ullRng);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Multiplication and multiply-accumulate
+ *
+ * @param[in] ullN  Random samples
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkMul(uint64_t ullN)
+{
+  ChkStatTypeDef sQ15 = { .pcName = "mul_q15", .dLimit = 0.5 };
+  for (int32_t a = -32768; a < 32768; a += 7)
+  {
+    for (int32_t b = -32768; b < 32768; b += 13)
+    {
+      double dRef = fmin((double)a * b / CHK_Q15, 32767.0);
+      vChkSample(&sQ15, iFIX_MulQ15((int16_t)a, (int16_t)b), dRef, a / CHK_Q15);
+    }
+  }
+  vChkSample(&sQ15, iFIX_MulQ15(FIX_Q15_MIN, FIX_Q15_MIN), 32767.0, -1.0);
+  vChkReport(&sQ15);
+
+  ChkStatTypeDef sQ31 = { .pcName = "mul_q31", .dLimit = 0.5 };
+  vChkSample(&sQ31, lFIX_MulQ31(FIX_Q31_MIN, FIX_Q31_MIN), CHK_Q31 - 1.0, -1.0);
+  for (uint64_t i = 0u; i < ullN; ++i)
+  {
+    int32_t lA = lChkRandQ31();
+    int32_t lB = lChkRandQ31();
+    double dRef = fmin((double)lA * (double)lB / CHK_Q31, CHK_Q31 - 1.0);
+    vChkSample(&sQ31, lFIX_MulQ31(lA, lB), dRef, lA / CHK_Q31);
+  }
+  vChkReport(&sQ31);
+
+  ChkStatTypeDef sMac = { .pcName = "mac_q31", .dLimit = 0.5 };
+  for (uint64_t i = 0u; i < ullN / CHK_DOT_LEN; ++i)
+  {
+    // Scale so that the sum stays within [-1, 1)
+    FIX_AccTypeDef llAcc = 0;
+    double dRef = 0.0;
+    for (uint32_t j = 0u; j < CHK_DOT_LEN; ++j)
+    {
+      int32_t lA = lChkRandQ31();
+      int32_t lB = lChkRandQ31() / (int32_t)CHK_DOT_LEN;
+      llAcc = llFIX_MacQ31(llAcc, lA, lB);
+      dRef += (double)lA * (double)lB;
+    }
+    vChkSample(&sMac, lFIX_AccToQ31(llAcc), dRef / CHK_Q31, dRef / CHK_Q31 / CHK_Q31);
+  }
+  vChkReport(&sMac);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Reciprocal and division
+ *
+ * @param[in] ullN  Random samples
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkRecip(uint64_t ullN)
+{
+  ChkStatTypeDef sRecip = { .pcName = "recip_q31", .dLimit = 0.5 };
+  ChkStatTypeDef sDiv = { .pcName = "div_q31", .dLimit = 0.5 };
+  for (uint64_t i = 0u; i < ullN; ++i)
+  {
+    uint32_t ulPow = 1uL << (i & 31u);
+    int32_t lX = (i < 64u) ? (int32_t)((i & 32u) ? 0uL - ulPow : ulPow) : lChkRandQ31();
+    if (lX == 0) continue;
+
+    // Mantissa error in LSB of the mantissa
+    int32_t lExp;
+    int32_t lM = lFIX_RecipQ31(lX, &lExp);
+    double dRef = CHK_Q31 / (double)lX * CHK_Q31 / ldexp(1.0, lExp);
+    vChkSample(&sRecip, lM, dRef, lX / CHK_Q31);
+
+    // Quotient of a smaller numerator
+    int32_t lNum = (int32_t)((int64_t)lChkRandQ31() * (lX < 0 ? -(int64_t)lX : lX) >> 31);
+    double dQ = (double)lNum / (double)lX * CHK_Q31;
+    vChkSample(&sDiv, lFIX_DivQ31(lNum, lX), fmin(dQ, CHK_Q31 - 1.0), lX / CHK_Q31);
+  }
+  vChkReport(&sRecip);
+  vChkReport(&sDiv);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Square root
+ *
+ * @param[in] ullN  Random samples
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkSqrt(uint64_t ullN)
+{
+  ChkStatTypeDef sQ15 = { .pcName = "sqrt_q15", .dLimit = 0.5 };
+  for (int32_t x = 0; x < 32768; ++x)
+  {
+    vChkSample(&sQ15, iFIX_SqrtQ15((int16_t)x), sqrt(x * CHK_Q15), x / CHK_Q15);
+  }
+  vChkReport(&sQ15);
+
+  // Rounded to nearest, so the error must not exceed half an LSB
+  ChkStatTypeDef sQ31 = { .pcName = "sqrt_q31", .dLimit = 0.5 };
+  for (uint64_t i = 0u; i < ullN; ++i)
+  {
+    int32_t lX = (int32_t)(ulCHK_Rand(&ullRng) >> 1);
+    if (i < 256u) lX = (int32_t)i;
+    else if (ulCHK_Rand(&ullRng) & 1u) lX >>= ulCHK_Rand(&ullRng) & 31u;
+    vChkSample(&sQ31, lFIX_SqrtQ31(lX), sqrt((double)lX * CHK_Q31), lX / CHK_Q31);
+  }
+  vChkSample(&sQ31, lFIX_SqrtQ31(FIX_Q31_MAX), sqrt((CHK_Q31 - 1.0) * CHK_Q31), 1.0);
+  vChkReport(&sQ31);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Sine and cosine
+ *
+ * @param[in] ullN  Random samples
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkSinCos(uint64_t ullN)
+{
+  // Limits include the table rounding; Q15 saturates at sin = 1
+  ChkStatTypeDef sSin15 = { .pcName = "sin_q15", .dLimit = 1.0 };
+  ChkStatTypeDef sCos15 = { .pcName = "cos_q15", .dLimit = 1.0 };
+  for (uint32_t a = 0u; a < 65536u; ++a)
+  {
+    double dRad = a * CHK_RAD16;
+    vChkSample(&sSin15, iFIX_SinQ15((uint16_t)a), fmin(sin(dRad) * CHK_Q15, 32767.0), dRad);
+    vChkSample(&sCos15, iFIX_CosQ15((uint16_t)a), fmin(cos(dRad) * CHK_Q15, 32767.0), dRad);
+  }
+  vChkReport(&sSin15);
+  vChkReport(&sCos15);
+
+  ChkStatTypeDef sSin31 = { .pcName = "sin_q31", .dLimit = 1.5 };
+  ChkStatTypeDef sCos31 = { .pcName = "cos_q31", .dLimit = 1.5 };
+  for (uint64_t i = 0u; i < ullN; ++i)
+  {
+    // Table points and their neighbours first, then random angles
+    uint32_t ulA = (i < 4096u) ? ((uint32_t)(i >> 2) << 22) + (uint32_t)(i & 3u) - 1u : ulCHK_Rand(&ullRng);
+    double dRad = ulA * CHK_RAD32;
+    vChkSample(&sSin31, lFIX_SinQ31(ulA), fmin(sin(dRad) * CHK_Q31, CHK_Q31 - 1.0), dRad);
+    vChkSample(&sCos31, lFIX_CosQ31(ulA), fmin(cos(dRad) * CHK_Q31, CHK_Q31 - 1.0), dRad);
+  }
+  vChkReport(&sSin31);
+  vChkReport(&sCos31);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Binary logarithm
+ *
+ * @param[in] ullN  Random samples
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkLog2(uint64_t ullN)
+{
+  ChkStatTypeDef sLog = { .pcName = "log2", .dLimit = 1.0 };
+  for (uint64_t i = 0u; i < ullN; ++i)
+  {
+    uint32_t ulX = (i < 1024u) ? (uint32_t)i + 1u : ulCHK_Rand(&ullRng) >> (ulCHK_Rand(&ullRng) & 31u);
+    if (ulX == 0u) continue;
+    uint32_t ulFrac = (uint32_t)(i % 3u) * 15u + (uint32_t)(i & 1u);   // 0, 1, 15, 16, 30, 31
+    double dRef = log2(ulX / ldexp(1.0, (int)ulFrac)) * 65536.0;
+    vChkSample(&sLog, lFIX_Log2(ulX, ulFrac), dRef, ulX / ldexp(1.0, (int)ulFrac));
+  }
+  vChkReport(&sLog);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Decimal formatting against printf
+ *
+ * Exact ties are skipped (printf rounds them to even) as well as the sign of
+ * values rounded to zero (printf keeps it).
+ *
+ * @param[in] ullN  Random samples
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkFormat(uint64_t ullN)
+{
+  uint64_t ullCount = 0u;
+  uint64_t ullBad = 0u;
+  for (uint64_t i = 0u; i < ullN; ++i)
+  {
+    int32_t lX = lChkRandQ31();
+    uint32_t ulFrac = ulCHK_Rand(&ullRng) % 32u;
+    uint32_t ulDigits = ulCHK_Rand(&ullRng) % 10u;
+
+    uint64_t ullRem = (uint64_t)((lX < 0) ? (0uL - (uint32_t)lX) : (uint32_t)lX) & ((1uLL << ulFrac) - 1u);
+    uint64_t ullScale = 1u;
+    for (uint32_t j = 0u; j < ulDigits; ++j) ullScale *= 10u;
+    if ((ulFrac > 0u) && (((ullRem * ullScale) & ((1uLL << ulFrac) - 1u)) == (1uLL << (ulFrac - 1u)))) continue;
+
+    char acGot[FIX_FORMAT_MAX];
+    char acRef[64];
+    uint32_t ulLen = ulFIX_Format(acGot, lX, ulFrac, ulDigits);
+    (void)snprintf(acRef, sizeof(acRef), "%.*f", (int)ulDigits, lX / ldexp(1.0, (int)ulFrac));
+    const char* pcRef = acRef;
+    if ((acRef[0] == '-') && (strspn(&acRef[1], "0.") == strlen(&acRef[1]))) pcRef++;
+
+    ullCount++;
+    if ((strcmp(acGot, pcRef) != 0) || (ulLen != strlen(acGot)))
+    {
+      if (ullBad == 0u) printf("format: 0x%08lX Q%lu .%lu: got \"%s\", expected \"%s\"\n",
+                               (unsigned long)(uint32_t)lX, (unsigned long)ulFrac,
+                               (unsigned long)ulDigits, acGot, pcRef);
+      ullBad++;
+    }
+  }
+  printf("%-14s %10llu samples  %llu mismatches  %s\n", "format",
+         (unsigned long long)ullCount, (unsigned long long)ullBad, (ullBad == 0u) ? "ok" : "FAIL");
+  bAllOk = bAllOk && (ullBad == 0u);
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Check entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  uint64_t ullN = 1000000u;
+  uint64_t ullSeed = (uint64_t)time(NULL);
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "n:s:")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'n': ullN = strtoull(optarg, NULL, 0); break;
+      case 's': ullSeed = strtoull(optarg, NULL, 0); break;
+      default:
+        fprintf(stderr, "Usage: %s [-n <N>] [-s <seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  ullRng = ullSeed | 1u;
+  printf("seed %llu\n", (unsigned long long)ullSeed);
+
+  vChkMul(ullN);
+  vChkRecip(ullN);
+  vChkSqrt(ullN);
+  vChkSinCos(ullN);
+  vChkLog2(ullN);
+  vChkFormat(ullN);
+
+  return bAllOk ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,81 @@
+/*!****************************************************************************
+ * @file
+ * stm32f1xx_hal.h
+ *
+ * @brief
+ * Host stand-in for the HAL header, for compiling hw_layer sources into
+ * host checks
+ *
+ * Only provides what those sources use. Peripherals are models implemented
+ * by the check:
+ *
+ * CRC evaluates to psHOST_CrcAccess(), which applies the previous access
+ * to the model and returns the register block holding the model's state.
+ * A DR write is seen as a changed DR, so writing the value DR already holds
+ * is taken as a read; the model then differs from the unit and the check
+ * fails, it cannot pass wrongly.
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+#ifndef STM32F1XX_HAL_H_
+#define STM32F1XX_HAL_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// CRC unit
+#define CRC                           (psHOST_CrcAccess())
+#define CRC_CR_RESET                  (1uL << 0)
+
+/// Cycle counter
+#define DWT                           (&sHOST_Dwt)
+
+/// Flash size register (not readable on the host)
+#define FLASHSIZE_BASE                0x1FFFF7E0uL
+
+/// Clock gates
+#define __HAL_RCC_CRC_CLK_ENABLE()    ((void)0)
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// CRC unit registers
+typedef struct {
+  volatile uint32_t DR;           ///< Data
+  volatile uint32_t IDR;          ///< Independent data
+  volatile uint32_t CR;           ///< Control
+} CRC_TypeDef;
+
+/// DWT registers
+typedef struct {
+  volatile uint32_t CTRL;         ///< Control
+  volatile uint32_t CYCCNT;       ///< Cycle counter
+} DWT_Type;
+
+
+/*- Public interface ---------------------------------------------------------*/
+extern DWT_Type sHOST_Dwt;
+
+CRC_TypeDef* psHOST_CrcAccess(void);
+
+/*!****************************************************************************
+ * @brief
+ * Reverse bit order
+ *
+ * @param[in] ulValue   Value
+ * @return  (uint32_t)  Value with bit order reversed
+ * @date  19.10.2026
+ ******************************************************************************/
+static inline uint32_t __RBIT(uint32_t ulValue)
+{
+  uint32_t ulResult = 0uL;
+  for (uint32_t i = 0uL; i < 32uL; ++i)
+  {
+    ulResult = (ulResult << 1) | ((ulValue >> i) & 1uL);
+  }
+  return ulResult;
+}
+
+#endif // STM32F1XX_HAL_H_
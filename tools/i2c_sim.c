@@ -0,0 +1,715 @@
+/*!****************************************************************************
+ * @file
+ * i2c_sim.c
+ *
+ * @brief
+ * Simulated bus for the I2C transaction queue
+ *
+ * Runs lib/i2cq against a simulated I2C1 master and bus with register-file
+ * sensors (first written byte selects the register, reads and writes
+ * auto-increment). Driver calls complete after their bus time at 400 kHz
+ * with the event the hardware would report; a 1 ms tick drives the phase
+ * timeouts as in hw_i2c. Every driver call is checked against the bus state
+ * (no start on a busy bus, address only after start, data only after the
+ * matching address, stop only on a busy bus).
+ *
+ * Scenarios: register reads and writes including single-byte reads, probes
+ * of present and absent devices, batches with callback order, resubmission
+ * from the callback, and one each of address NACK, arbitration loss, bus
+ * error and a slave holding SDA low, which must be retried and, for the
+ * latter, recovered. A device that never releases the bus must time out
+ * after all retries without blocking later transactions. Finally, sensor
+ * batches run for many periods with random faults; every transaction must
+ * complete, and read data must match the sensor whenever the status is OK.
+ *
+ * Exits with failure status on the first error.
+ *
+ * Usage: i2c_sim [-p <periods>] [-a <N>] [-e <N>] [-k <N>] [-s <seed>]
+ *   -p <periods> Sensor batches in the random run (default 2000)
+ *   -a <N>       NACK one address in N on average (default 40)
+ *   -e <N>       Bus error in one data phase in N on average (default 200)
+ *   -k <N>       Slave holds SDA low in one read in N on average (default 500)
+ *   -s <seed>    Random seed
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "i2cq.h"
+#include "chk.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Bit time in ns (400 kHz)
+#define SIM_T_BIT                     2500uLL
+
+/// Tick period in ns
+#define SIM_T_TICK                    1000000uLL
+
+/*! @brief Queue configuration as in hw_i2c
+ *  @{                                                                        */
+#define SIM_RETRIES                   2u
+#define SIM_TIMEOUT_BASE              2u
+#define SIM_BYTES_PER_TICK            44u
+/*! @}                                                                        */
+
+/// Number of simulated sensors
+#define SIM_DEVICES                   3u
+
+/// Address without device
+#define SIM_ADDR_ABSENT               0x50u
+
+/// Transactions per sensor batch
+#define SIM_BATCH_SIZE                4u
+
+/// Completion log entries
+#define SIM_LOG_SIZE                  64u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Bus state seen by the simulated controller
+typedef enum {
+  SIM_BUS_IDLE = 0,               ///< Stop sent or recovered
+  SIM_BUS_START,                  ///< Start sent, address expected
+  SIM_BUS_ADDR_WRITE,             ///< Write address acknowledged
+  SIM_BUS_ADDR_READ,              ///< Read address acknowledged
+  SIM_BUS_WRITTEN,                ///< Write phase done, start or stop expected
+  SIM_BUS_DATA,                   ///< Data phase running or done, stop expected
+  SIM_BUS_FAILED                  ///< NACK or error reported, stop or recovery expected
+} SimBusTypeDef;
+
+/// Sensor
+typedef struct {
+  uint8_t ucAddr;                 ///< 7-bit address
+  uint8_t ucReg;                  ///< Register pointer
+  bool bPointerSet;               ///< Pointer written in the current write phase
+  uint8_t aucRegs[256];           ///< Register file
+} SimDeviceTypeDef;
+
+/// Fault injection: rates (one in N, 0 for never) and forced faults
+typedef struct {
+  unsigned int uiNackRate;        ///< Address not acknowledged
+  unsigned int uiBusRate;         ///< Bus error in a data phase
+  unsigned int uiStuckRate;       ///< Slave holds SDA low in a read
+  unsigned int uiNack;            ///< Next address phases not acknowledged
+  unsigned int uiArbitration;     ///< Next starts lose arbitration
+  unsigned int uiBus;             ///< Next data phases end with bus error
+  unsigned int uiStuck;           ///< Next reads get stuck
+  bool bStuckForever;             ///< Every read gets stuck
+} SimFaultsTypeDef;
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vSimStart(void);
+static void vSimAddress(uint8_t ucAddrRw);
+static void vSimWrite(const uint8_t* pucData, uint16_t uiLen);
+static void vSimRead(uint8_t* pucData, uint16_t uiLen);
+static void vSimStop(void);
+static void vSimRecover(void);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Driver
+static const I2CQ_DriverTypeDef sDrv = {
+  .pfnStart = vSimStart,
+  .pfnAddress = vSimAddress,
+  .pfnWrite = vSimWrite,
+  .pfnRead = vSimRead,
+  .pfnStop = vSimStop,
+  .pfnRecover = vSimRecover
+};
+
+/// Queue under test
+static I2CQ_TypeDef sQueue;
+
+/// Sensors
+static SimDeviceTypeDef asDevices[SIM_DEVICES] = {
+  { .ucAddr = 0x1Eu }, { .ucAddr = 0x48u }, { .ucAddr = 0x76u }
+};
+
+/// Bus
+static SimBusTypeDef eBus;
+static SimDeviceTypeDef* psSelected;
+static bool bStuck;
+
+/// Faults
+static SimFaultsTypeDef sFaults;
+
+/// Simulated time in ns, and time the bus is busy until
+static uint64_t ullNow;
+static uint64_t ullBusFree;
+
+/// Event pending from the last driver call
+static bool bEventPending;
+static I2CQ_EventTypeDef ePendingEvent;
+static uint64_t ullEventTime;
+
+/// Event and driver call counts
+static uint32_t ulEvents;
+static uint32_t ulCalls;
+
+/// Completion log
+static I2CQ_XferTypeDef* apsLog[SIM_LOG_SIZE];
+static uint32_t ulLogLen;
+static uint32_t ulBatchesDone;
+static uint32_t ulBatchOrderErrors;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Consume a forced fault
+ *
+ * @param[in,out] *puiCount   Remaining forced faults
+ * @return  (bool)  Fault occurs
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimForced(unsigned int* puiCount)
+{
+  if (*puiCount == 0u) return false;
+  (*puiCount)--;
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Complete driver call after a number of bit times with an event
+ *
+ * @param[in] ulBits    Bus time in bits
+ * @param[in] eEvent    Event reported by the controller
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimPost(uint32_t ulBits, I2CQ_EventTypeDef eEvent)
+{
+  if (bEventPending) vCHK_Exit("driver call while an event is pending");
+  uint64_t ullStart = (ullBusFree > ullNow) ? ullBusFree : ullNow;
+  ullBusFree = ullStart + ulBits * SIM_T_BIT;
+  ullEventTime = ullBusFree;
+  ePendingEvent = eEvent;
+  bEventPending = true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: start condition
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimStart(void)
+{
+  ulCalls++;
+  if ((eBus != SIM_BUS_IDLE) && (eBus != SIM_BUS_WRITTEN)) vCHK_Exit("start while bus busy");
+
+  // A slave holding SDA low keeps the controller from generating the start
+  if (bStuck) return;
+  eBus = SIM_BUS_START;
+  if (bSimForced(&sFaults.uiArbitration))
+  {
+    eBus = SIM_BUS_FAILED;
+    vSimPost(1u, I2CQ_EVENT_BUS);
+    return;
+  }
+  vSimPost(1u, I2CQ_EVENT_START);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: address byte
+ *
+ * @param[in] ucAddrRw  Address and direction bit
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimAddress(uint8_t ucAddrRw)
+{
+  ulCalls++;
+  if (eBus != SIM_BUS_START) vCHK_Exit("address without start");
+
+  psSelected = NULL;
+  for (uint32_t i = 0u; i < SIM_DEVICES; ++i)
+  {
+    if (asDevices[i].ucAddr == (ucAddrRw >> 1)) psSelected = &asDevices[i];
+  }
+  if ((psSelected == NULL) || bSimForced(&sFaults.uiNack) || bCHK_Chance(sFaults.uiNackRate))
+  {
+    eBus = SIM_BUS_FAILED;
+    vSimPost(9u, I2CQ_EVENT_NACK);
+    return;
+  }
+  psSelected->bPointerSet = false;
+  eBus = ((ucAddrRw & 1u) != 0u) ? SIM_BUS_ADDR_READ : SIM_BUS_ADDR_WRITE;
+  vSimPost(9u, I2CQ_EVENT_ADDR);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: write phase
+ *
+ * @param[in] *pucData  Data
+ * @param[in] uiLen     Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimWrite(const uint8_t* pucData, uint16_t uiLen)
+{
+  ulCalls++;
+  if (eBus != SIM_BUS_ADDR_WRITE) vCHK_Exit("write without write address");
+  if (uiLen == 0u) vCHK_Exit("empty write phase");
+
+  if (bSimForced(&sFaults.uiBus) || bCHK_Chance(sFaults.uiBusRate))
+  {
+    eBus = SIM_BUS_FAILED;
+    vSimPost(9u * (uint32_t)uiLen / 2u, I2CQ_EVENT_BUS);
+    return;
+  }
+  for (uint32_t i = 0u; i < uiLen; ++i)
+  {
+    if (!psSelected->bPointerSet)
+    {
+      psSelected->ucReg = pucData[i];
+      psSelected->bPointerSet = true;
+    }
+    else
+    {
+      psSelected->aucRegs[psSelected->ucReg++] = pucData[i];
+    }
+  }
+  eBus = SIM_BUS_WRITTEN;
+  vSimPost(9u * uiLen, I2CQ_EVENT_DONE);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: read phase
+ *
+ * @param[out] *pucData Buffer
+ * @param[in] uiLen     Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimRead(uint8_t* pucData, uint16_t uiLen)
+{
+  ulCalls++;
+  if (eBus != SIM_BUS_ADDR_READ) vCHK_Exit("read without read address");
+  if (uiLen == 0u) vCHK_Exit("empty read phase");
+
+  eBus = SIM_BUS_DATA;
+  if (sFaults.bStuckForever || bSimForced(&sFaults.uiStuck) || bCHK_Chance(sFaults.uiStuckRate))
+  {
+    // Slave lost a clock and holds SDA low, the transfer never completes
+    bStuck = true;
+    return;
+  }
+  if (bSimForced(&sFaults.uiBus) || bCHK_Chance(sFaults.uiBusRate))
+  {
+    eBus = SIM_BUS_FAILED;
+    vSimPost(9u * (uint32_t)uiLen / 2u, I2CQ_EVENT_BUS);
+    return;
+  }
+  for (uint32_t i = 0u; i < uiLen; ++i)
+  {
+    pucData[i] = psSelected->aucRegs[psSelected->ucReg++];
+  }
+  vSimPost(9u * uiLen, I2CQ_EVENT_DONE);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: stop condition
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimStop(void)
+{
+  ulCalls++;
+  if ((eBus == SIM_BUS_IDLE) || (eBus == SIM_BUS_START)) vCHK_Exit("stop on idle bus");
+  if (bEventPending) vCHK_Exit("stop while transfer running");
+
+  eBus = SIM_BUS_IDLE;
+  ullBusFree = ((ullBusFree > ullNow) ? ullBusFree : ullNow) + SIM_T_BIT;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: bus recovery (nine clocks, stop, peripheral reset)
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimRecover(void)
+{
+  ulCalls++;
+  bEventPending = false;
+  bStuck = false;
+  eBus = SIM_BUS_IDLE;
+  ullBusFree = ((ullBusFree > ullNow) ? ullBusFree : ullNow) + 10u * 4u * SIM_T_BIT;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run bus until the queue is idle
+ *
+ * @param[in] ullLimit  Simulated time limit in ns
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimRun(uint64_t ullLimit)
+{
+  uint64_t ullEnd = ullNow + ullLimit;
+  uint64_t ullNextTick = (ullNow / SIM_T_TICK + 1u) * SIM_T_TICK;
+
+  while (bI2CQ_IsBusy(&sQueue))
+  {
+    if (ullNow > ullEnd) vCHK_Exit("queue does not complete");
+    if (bEventPending && (ullEventTime < ullNextTick))
+    {
+      ullNow = ullEventTime;
+      bEventPending = false;
+      ulEvents++;
+      vI2CQ_Event(&sQueue, ePendingEvent);
+    }
+    else
+    {
+      ullNow = ullNextTick;
+      ullNextTick += SIM_T_TICK;
+      vI2CQ_Tick(&sQueue);
+    }
+  }
+  if (bEventPending) vCHK_Exit("event pending after completion");
+  if (eBus != SIM_BUS_IDLE) vCHK_Exit("bus not released after completion");
+}
+
+/*!****************************************************************************
+ * @brief
+ * Transaction callback: log completion
+ *
+ * @param[in] *psXfer   Transaction
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimDone(I2CQ_XferTypeDef* psXfer)
+{
+  if (psXfer->eStatus == I2CQ_STATUS_PENDING) vCHK_Exit("callback while pending");
+  if (ulLogLen < SIM_LOG_SIZE) apsLog[ulLogLen] = psXfer;
+  ulLogLen++;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Transaction callback: submit again while the context counts down
+ *
+ * @param[in] *psXfer   Transaction
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimResubmit(I2CQ_XferTypeDef* psXfer)
+{
+  uint32_t* pulLeft = psXfer->pvContext;
+  vSimDone(psXfer);
+  if ((*pulLeft)-- > 1u)
+  {
+    if (!bI2CQ_Submit(&sQueue, psXfer)) vCHK_Exit("resubmit from callback rejected");
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Batch callback: all transactions must have completed before
+ *
+ * @param[in] *psBatch  Batch
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimBatchDone(I2CQ_BatchTypeDef* psBatch)
+{
+  for (uint32_t i = 0u; i < psBatch->ulCount; ++i)
+  {
+    if (psBatch->psXfers[i].eStatus == I2CQ_STATUS_PENDING) ulBatchOrderErrors++;
+  }
+  ulBatchesDone++;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Fill sensor register files with a known pattern
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimResetDevices(void)
+{
+  for (uint32_t d = 0u; d < SIM_DEVICES; ++d)
+  {
+    for (uint32_t r = 0u; r < 256u; ++r)
+    {
+      asDevices[d].aucRegs[r] = (uint8_t)(asDevices[d].ucAddr * 31u + r * 7u);
+    }
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Register read transaction: write register, read after repeated start
+ *
+ * @param[out] *psXfer    Transaction
+ * @param[out] *pucReg    Register number storage
+ * @param[in] ucAddr      Device address
+ * @param[in] ucReg       First register
+ * @param[out] *pucBuf    Read buffer
+ * @param[in] uiLen       Read length
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimRegRead(I2CQ_XferTypeDef* psXfer, uint8_t* pucReg, uint8_t ucAddr, uint8_t ucReg,
+                        uint8_t* pucBuf, uint16_t uiLen)
+{
+  *pucReg = ucReg;
+  *psXfer = (I2CQ_XferTypeDef){
+    .pfnDone = vSimDone, .pucTx = pucReg, .uiTxLen = 1u, .pucRx = pucBuf, .uiRxLen = uiLen,
+    .ucAddr = ucAddr
+  };
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check that read data matches the sensor registers
+ *
+ * @param[in] ucAddr    Device address
+ * @param[in] ucReg     First register
+ * @param[in] *pucBuf   Data read
+ * @param[in] uiLen     Length
+ * @return  (bool)  Data matches
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimMatches(uint8_t ucAddr, uint8_t ucReg, const uint8_t* pucBuf, uint16_t uiLen)
+{
+  for (uint32_t d = 0u; d < SIM_DEVICES; ++d)
+  {
+    if (asDevices[d].ucAddr != ucAddr) continue;
+    for (uint32_t i = 0u; i < uiLen; ++i)
+    {
+      if (asDevices[d].aucRegs[(uint8_t)(ucReg + i)] != pucBuf[i]) return false;
+    }
+    return true;
+  }
+  return false;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Print scenario result and exit on failure
+ *
+ * @param[in] *pcName   Scenario
+ * @param[in] bOk       Checks passed
+ * @param[in] *psStart  Statistics before the scenario
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimCheck(const char* pcName, bool bOk, const I2CQ_StatsTypeDef* psStart)
+{
+  const I2CQ_StatsTypeDef* psNow = &sQueue.sStats;
+  printf("%-14s %-4s %3u ok %3u failed %3u retries %3u recoveries\n", pcName, bOk ? "ok" : "FAIL",
+         psNow->ulDone - psStart->ulDone, psNow->ulFailed - psStart->ulFailed,
+         psNow->ulRetries - psStart->ulRetries, psNow->ulRecoveries - psStart->ulRecoveries);
+  if (!bOk) exit(EXIT_FAILURE);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run single transaction to completion
+ *
+ * @param[in,out] *psXfer   Transaction
+ * @return  (I2CQ_StatusTypeDef)  Final status
+ * @date  19.10.2026
+ ******************************************************************************/
+static I2CQ_StatusTypeDef eSimRunOne(I2CQ_XferTypeDef* psXfer)
+{
+  if (!bI2CQ_Submit(&sQueue, psXfer)) vCHK_Exit("submit rejected");
+  vSimRun(100u * SIM_T_TICK);
+  return psXfer->eStatus;
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Simulator entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  unsigned long ulPeriods = 2000uL;
+  SimFaultsTypeDef sRandom = { .uiNackRate = 40u, .uiBusRate = 200u, .uiStuckRate = 500u };
+  unsigned int uiSeed = (unsigned int)time(NULL);
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "p:a:e:k:s:")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'p': ulPeriods = strtoul(optarg, NULL, 0); break;
+      case 'a': sRandom.uiNackRate = (unsigned int)strtoul(optarg, NULL, 0); break;
+      case 'e': sRandom.uiBusRate = (unsigned int)strtoul(optarg, NULL, 0); break;
+      case 'k': sRandom.uiStuckRate = (unsigned int)strtoul(optarg, NULL, 0); break;
+      case 's': uiSeed = (unsigned int)strtoul(optarg, NULL, 0); break;
+      default:
+        fprintf(stderr, "Usage: %s [-p <periods>] [-a <N>] [-e <N>] [-k <N>] [-s <seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  printf("seed %u\n", uiSeed);
+  srand(uiSeed);
+  vSimResetDevices();
+  vI2CQ_Init(&sQueue, &sDrv, SIM_RETRIES, SIM_TIMEOUT_BASE, SIM_BYTES_PER_TICK);
+
+  I2CQ_StatsTypeDef sStart;
+  I2CQ_XferTypeDef sXfer;
+  I2CQ_XferTypeDef asXfers[SIM_BATCH_SIZE];
+  uint8_t aucRegs[SIM_BATCH_SIZE];
+  uint8_t aaucBuf[SIM_BATCH_SIZE][16];
+  uint8_t ucReg;
+  bool bOk;
+
+  // Register reads, single-byte read, register write and read-back
+  sStart = sQueue.sStats;
+  vSimRegRead(&sXfer, &ucReg, 0x76u, 0xF7u, aaucBuf[0], 6u);
+  bOk = (eSimRunOne(&sXfer) == I2CQ_STATUS_OK) && bSimMatches(0x76u, 0xF7u, aaucBuf[0], 6u);
+  vSimRegRead(&sXfer, &ucReg, 0x48u, 0x00u, aaucBuf[0], 1u);
+  bOk = bOk && (eSimRunOne(&sXfer) == I2CQ_STATUS_OK) && bSimMatches(0x48u, 0x00u, aaucBuf[0], 1u);
+  const uint8_t aucWrite[] = { 0x20u, 0xA5u, 0x5Au };
+  sXfer = (I2CQ_XferTypeDef){ .pucTx = aucWrite, .uiTxLen = sizeof(aucWrite), .ucAddr = 0x1Eu };
+  bOk = bOk && (eSimRunOne(&sXfer) == I2CQ_STATUS_OK);
+  vSimRegRead(&sXfer, &ucReg, 0x1Eu, 0x20u, aaucBuf[0], 2u);
+  bOk = bOk && (eSimRunOne(&sXfer) == I2CQ_STATUS_OK) && (aaucBuf[0][0] == 0xA5u) &&
+        (aaucBuf[0][1] == 0x5Au);
+  sXfer = (I2CQ_XferTypeDef){ .pucRx = aaucBuf[0], .uiRxLen = 2u, .ucAddr = 0x1Eu };
+  bOk = bOk && (eSimRunOne(&sXfer) == I2CQ_STATUS_OK) && bSimMatches(0x1Eu, 0x22u, aaucBuf[0], 2u);
+  vSimCheck("registers", bOk, &sStart);
+
+  // Probes: absent device is not retried forever
+  sStart = sQueue.sStats;
+  sXfer = (I2CQ_XferTypeDef){ .ucAddr = 0x48u };
+  bOk = (eSimRunOne(&sXfer) == I2CQ_STATUS_OK) && (sXfer.ucAttempts == 1u);
+  sXfer = (I2CQ_XferTypeDef){ .ucAddr = SIM_ADDR_ABSENT };
+  bOk = bOk && (eSimRunOne(&sXfer) == I2CQ_STATUS_NACK) && (sXfer.ucAttempts == SIM_RETRIES + 1u);
+  vSimCheck("probe", bOk, &sStart);
+
+  // Rejected submissions
+  sStart = sQueue.sStats;
+  sXfer = (I2CQ_XferTypeDef){ .ucAddr = 0x80u };
+  bOk = !bI2CQ_Submit(&sQueue, &sXfer);
+  sXfer = (I2CQ_XferTypeDef){ .ucAddr = 0x48u, .uiRxLen = 2u };
+  bOk = bOk && !bI2CQ_Submit(&sQueue, &sXfer);
+  sXfer = (I2CQ_XferTypeDef){ .ucAddr = 0x48u };
+  bOk = bOk && bI2CQ_Submit(&sQueue, &sXfer) && !bI2CQ_Submit(&sQueue, &sXfer);
+  vSimRun(100u * SIM_T_TICK);
+  vSimCheck("reject", bOk && (sXfer.eStatus == I2CQ_STATUS_OK), &sStart);
+
+  // Batch: FIFO completion, batch callback last
+  sStart = sQueue.sStats;
+  I2CQ_BatchTypeDef sBatch = {
+    .psXfers = asXfers, .ulCount = SIM_BATCH_SIZE, .pfnDone = vSimBatchDone
+  };
+  for (uint32_t i = 0u; i < SIM_BATCH_SIZE; ++i)
+  {
+    vSimRegRead(&asXfers[i], &aucRegs[i], asDevices[i % SIM_DEVICES].ucAddr, (uint8_t)(0x10u * i),
+                aaucBuf[i], (uint16_t)(2u + 4u * i));
+  }
+  ulLogLen = 0u;
+  ulBatchesDone = 0u;
+  bOk = bI2CQ_SubmitBatch(&sQueue, &sBatch) && !bI2CQ_SubmitBatch(&sQueue, &sBatch);
+  vSimRun(100u * SIM_T_TICK);
+  bOk = bOk && (ulBatchesDone == 1u) && (ulBatchOrderErrors == 0u) && (sBatch.ulPending == 0u) &&
+        (sBatch.ulFailed == 0u) && (ulLogLen == SIM_BATCH_SIZE);
+  for (uint32_t i = 0u; bOk && (i < SIM_BATCH_SIZE); ++i)
+  {
+    bOk = (apsLog[i] == &asXfers[i]) &&
+          bSimMatches(asXfers[i].ucAddr, aucRegs[i], aaucBuf[i], asXfers[i].uiRxLen);
+  }
+  vSimCheck("batch", bOk, &sStart);
+
+  // Resubmission from the callback
+  sStart = sQueue.sStats;
+  uint32_t ulLeft = 5u;
+  vSimRegRead(&sXfer, &ucReg, 0x48u, 0x00u, aaucBuf[0], 2u);
+  sXfer.pfnDone = vSimResubmit;
+  sXfer.pvContext = &ulLeft;
+  ulLogLen = 0u;
+  (void)eSimRunOne(&sXfer);
+  vSimCheck("resubmit", (ulLogLen == 5u) && (sXfer.eStatus == I2CQ_STATUS_OK), &sStart);
+
+  // Single faults: retried, stuck bus recovered
+  const struct {
+    const char* pcName;
+    SimFaultsTypeDef sFaults;
+    uint32_t ulRecoveries;
+  } asSingle[] = {
+    { "nack",        { .uiNack = 1u },        0u },
+    { "arbitration", { .uiArbitration = 1u }, 1u },
+    { "bus error",   { .uiBus = 1u },         1u },
+    { "stuck bus",   { .uiStuck = 1u },       1u }
+  };
+  for (uint32_t i = 0u; i < sizeof(asSingle) / sizeof(asSingle[0]); ++i)
+  {
+    sStart = sQueue.sStats;
+    sFaults = asSingle[i].sFaults;
+    vSimRegRead(&sXfer, &ucReg, 0x76u, 0xF7u, aaucBuf[0], 6u);
+    bOk = (eSimRunOne(&sXfer) == I2CQ_STATUS_OK) && bSimMatches(0x76u, 0xF7u, aaucBuf[0], 6u) &&
+          (sXfer.ucAttempts == 2u) &&
+          (sQueue.sStats.ulRecoveries - sStart.ulRecoveries == asSingle[i].ulRecoveries);
+    vSimCheck(asSingle[i].pcName, bOk, &sStart);
+  }
+
+  // Device never releases the bus: times out, queue continues
+  sStart = sQueue.sStats;
+  sFaults = (SimFaultsTypeDef){ .bStuckForever = true };
+  vSimRegRead(&asXfers[0], &aucRegs[0], 0x76u, 0xF7u, aaucBuf[0], 6u);
+  vSimRegRead(&asXfers[1], &aucRegs[1], 0x48u, 0x00u, aaucBuf[1], 2u);
+  asXfers[1].uiTxLen = 0u;
+  asXfers[1].pucTx = NULL;
+  uint64_t ullStartTime = ullNow;
+  bOk = bI2CQ_Submit(&sQueue, &asXfers[0]);
+  vSimRun(100u * SIM_T_TICK);
+  sFaults = (SimFaultsTypeDef){ 0 };
+  bOk = bOk && (asXfers[0].eStatus == I2CQ_STATUS_TIMEOUT) &&
+        (asXfers[0].ucAttempts == SIM_RETRIES + 1u) && (eSimRunOne(&asXfers[1]) == I2CQ_STATUS_OK);
+  vSimCheck("timeout", bOk, &sStart);
+  printf("  given up after %.1f ms\n", (double)(ullNow - ullStartTime) * 1e-6);
+
+  // Sensor batches with random faults
+  sStart = sQueue.sStats;
+  sFaults = sRandom;
+  ulEvents = 0u;
+  ulCalls = 0u;
+  ullStartTime = ullNow;
+  uint32_t ulXfers = 0u;
+  uint32_t ulBad = 0u;
+  for (unsigned long p = 0uL; p < ulPeriods; ++p)
+  {
+    for (uint32_t i = 0u; i < SIM_BATCH_SIZE; ++i)
+    {
+      vSimRegRead(&asXfers[i], &aucRegs[i], asDevices[i % SIM_DEVICES].ucAddr,
+                  (uint8_t)rand(), aaucBuf[i], (uint16_t)(1u + (unsigned int)rand() % 16u));
+    }
+    ulLogLen = 0u;
+    ulBatchesDone = 0u;
+    if (!bI2CQ_SubmitBatch(&sQueue, &sBatch)) vCHK_Exit("batch rejected");
+    vSimRun(1000u * SIM_T_TICK);
+    if ((ulBatchesDone != 1u) || (ulLogLen != SIM_BATCH_SIZE)) vCHK_Exit("batch incomplete");
+    for (uint32_t i = 0u; i < SIM_BATCH_SIZE; ++i)
+    {
+      if ((asXfers[i].eStatus == I2CQ_STATUS_OK) &&
+          !bSimMatches(asXfers[i].ucAddr, aucRegs[i], aaucBuf[i], asXfers[i].uiRxLen))
+      {
+        ulBad++;
+      }
+    }
+    ulXfers += SIM_BATCH_SIZE;
+  }
+  sFaults = (SimFaultsTypeDef){ 0 };
+  vSimCheck("random", (ulBad == 0u) && (ulBatchOrderErrors == 0u), &sStart);
+  printf("  %u transactions in %.1f ms, %.2f driver calls and %.2f events each\n", ulXfers,
+         (double)(ullNow - ullStartTime) * 1e-6, (double)ulCalls / ulXfers, (double)ulEvents / ulXfers);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,207 @@
+/*!****************************************************************************
+ * @file
+ * image_crc.c
+ *
+ * @brief
+ * Host tool to embed and verify the firmware image CRC
+ *
+ * Reads a raw flash image (objcopy -O binary, gaps filled with 0xFF) and
+ * locates the image descriptor (see hw_crc.h) by its magic. Fills in the
+ * descriptor offset, image length and zlib CRC-32 of the image, with the
+ * CRC field taken as zero, and writes the completed descriptor to a file,
+ * from where the build puts it into the ELF file with
+ * "objcopy --update-section .image_crc=<file>".
+ *
+ * With -c, the embedded CRC of an image (e.g. read back from a device) is
+ * verified instead.
+ *
+ * Usage: image_crc [-c] <image> [descriptor]
+ *   -c           Verify embedded CRC only, exit status reports result
+ *   image        Raw flash image
+ *   descriptor   Output file for completed descriptor
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "crc32.h"
+#include "hw_crc.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Maximum image size
+#define IMAGE_MAX_SIZE                (1024u * 1024u)
+
+/// Descriptor size in bytes
+#define IMAGE_DESC_SIZE               sizeof(HW_CRC_ImageTypeDef)
+
+/*! @brief Descriptor field offsets
+ *  @{                                                                        */
+#define IMAGE_DESC_OFFSET             offsetof(HW_CRC_ImageTypeDef, ulOffset)
+#define IMAGE_DESC_LENGTH             offsetof(HW_CRC_ImageTypeDef, ulLength)
+#define IMAGE_DESC_CRC                offsetof(HW_CRC_ImageTypeDef, ulCrc)
+/*! @}                                                                        */
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Image
+static uint8_t aucImage[IMAGE_MAX_SIZE];
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Read little-endian word
+ *
+ * @param[in] *pucData  Data
+ * @return  (uint32_t)  Word
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulGetLe(const uint8_t* pucData)
+{
+  return (uint32_t)pucData[0] | ((uint32_t)pucData[1] << 8) |
+         ((uint32_t)pucData[2] << 16) | ((uint32_t)pucData[3] << 24);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write little-endian word
+ *
+ * @param[out] *pucData   Destination
+ * @param[in] ulValue     Word
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vPutLe(uint8_t* pucData, uint32_t ulValue)
+{
+  for (uint32_t i = 0u; i < 4u; ++i)
+  {
+    pucData[i] = (uint8_t)(ulValue >> (8u * i));
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Locate descriptor by magic
+ *
+ * @param[in] ulSize    Image size in bytes
+ * @return  (long)      Descriptor offset, -1 if not found or not unique
+ * @date  19.10.2026
+ ******************************************************************************/
+static long lFindDescriptor(uint32_t ulSize)
+{
+  long lFound = -1L;
+  for (uint32_t i = 0u; i + IMAGE_DESC_SIZE <= ulSize; i += 4u)
+  {
+    if ((ulGetLe(&aucImage[i]) != HW_CRC_IMAGE_MAGIC0) ||
+        (ulGetLe(&aucImage[i + 4u]) != HW_CRC_IMAGE_MAGIC1))
+    {
+      continue;
+    }
+    if (lFound >= 0L) return -1L;
+    lFound = (long)i;
+  }
+  return lFound;
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Tool entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  bool bVerify = false;
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "c")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'c': bVerify = true; break;
+      default:
+        fprintf(stderr, "Usage: %s [-c] <image> [descriptor]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  if ((optind >= argc) || (!bVerify && (optind + 2 != argc)))
+  {
+    fprintf(stderr, "Usage: %s [-c] <image> [descriptor]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  FILE* psIn = fopen(argv[optind], "rb");
+  if (psIn == NULL)
+  {
+    perror(argv[optind]);
+    return EXIT_FAILURE;
+  }
+  uint32_t ulSize = (uint32_t)fread(aucImage, 1u, sizeof(aucImage), psIn);
+  bool bTooLarge = (fgetc(psIn) != EOF);
+  fclose(psIn);
+  if (bTooLarge)
+  {
+    fprintf(stderr, "%s: image larger than %u bytes\n", argv[optind], IMAGE_MAX_SIZE);
+    return EXIT_FAILURE;
+  }
+
+  long lDesc = lFindDescriptor(ulSize);
+  if (lDesc < 0L)
+  {
+    fprintf(stderr, "%s: no unique image descriptor found\n", argv[optind]);
+    return EXIT_FAILURE;
+  }
+  uint8_t* pucDesc = &aucImage[lDesc];
+
+  uint32_t ulLength = ulSize;
+  uint32_t ulEmbedded = ulGetLe(&pucDesc[IMAGE_DESC_CRC]);
+  if (bVerify)
+  {
+    // Image may be followed by erased flash
+    ulLength = ulGetLe(&pucDesc[IMAGE_DESC_LENGTH]);
+    if ((ulLength > ulSize) || (ulGetLe(&pucDesc[IMAGE_DESC_OFFSET]) != (uint32_t)lDesc))
+    {
+      fprintf(stderr, "%s: no CRC embedded\n", argv[optind]);
+      return EXIT_FAILURE;
+    }
+  }
+  else
+  {
+    vPutLe(&pucDesc[IMAGE_DESC_OFFSET], (uint32_t)lDesc);
+    vPutLe(&pucDesc[IMAGE_DESC_LENGTH], ulLength);
+  }
+
+  vPutLe(&pucDesc[IMAGE_DESC_CRC], 0u);
+  uint32_t ulCrc = ulCRC32_Update(CRC32_INIT, aucImage, ulLength);
+  vPutLe(&pucDesc[IMAGE_DESC_CRC], ulCrc);
+
+  if (bVerify)
+  {
+    bool bOk = (ulCrc == ulEmbedded);
+    printf("%s: %u bytes, CRC32 0x%08X, embedded 0x%08X: %s\n", argv[optind],
+           ulLength, ulCrc, ulEmbedded, bOk ? "OK" : "MISMATCH");
+    return bOk ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  FILE* psOut = fopen(argv[optind + 1], "wb");
+  if ((psOut == NULL) || (fwrite(pucDesc, 1u, IMAGE_DESC_SIZE, psOut) != IMAGE_DESC_SIZE) ||
+      (fclose(psOut) != 0))
+  {
+    perror(argv[optind + 1]);
+    return EXIT_FAILURE;
+  }
+  printf("Image CRC: %u bytes, descriptor at 0x%05lX, CRC32 0x%08X\n", ulLength, lDesc, ulCrc);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,372 @@
+/*!****************************************************************************
+ * @file
+ * kvs_sim.c
+ *
+ * @brief
+ * Host simulator for the flash key-value store
+ *
+ * Runs the store against simulated STM32F1 flash (1 KB pages, half-word
+ * programming, programming a non-erased half-word fails unless 0x0000 is
+ * written) with random puts and deletes. With power-cut injection, a random
+ * program or erase is interrupted: the half-word being programmed only gets
+ * some of its bits cleared, the page being erased only some of its bits set.
+ * The store is then remounted and every key must hold either its last
+ * committed value or, for the interrupted key, the new value.
+ *
+ * Prints throughput and flash wear statistics; exits with failure status on
+ * the first inconsistency.
+ *
+ * Usage: kvs_sim [-n <ops>] [-c <N>] [-p <pages>] [-l <len>] [-s <seed>]
+ *   -n <ops>     Number of operations (default 100000)
+ *   -c <N>       Cut power during one of N operations on average (0: never)
+ *   -p <pages>   Number of flash pages (default 4)
+ *   -l <len>     Maximum value length (default 64)
+ *   -s <seed>    Random seed
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "kvstore.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Page size in bytes
+#define SIM_PAGE_SIZE                 1024u
+
+/// Number of distinct keys used
+#define SIM_KEYS                      20u
+
+/// No power cut pending
+#define SIM_NO_CUT                    (-1L)
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Committed key state
+typedef struct {
+  int32_t lLen;                   ///< Value length, -1 if deleted
+  uint8_t aucValue[KVS_MAX_VALUE];  ///< Value
+} SimKeyTypeDef;
+
+
+/// Operation result
+typedef enum {
+  SIM_OK = 0,                     ///< Operation succeeded
+  SIM_FAILED,                     ///< Operation rejected (store full)
+  SIM_CUT                         ///< Power was cut during operation
+} SimResultTypeDef;
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Simulated flash
+static uint16_t auiFlash[KVS_MAX_PAGES * SIM_PAGE_SIZE / 2u];
+
+/// Half-word operations until power cut
+static long lBudget = SIM_NO_CUT;
+
+/// Power cut return point
+static jmp_buf sCut;
+
+/// Flash operation counters
+static uint64_t ullPrograms;
+static uint64_t ullErases;
+
+/// Expected contents
+static SimKeyTypeDef asKeys[SIM_KEYS];
+
+/// New state of key being modified
+static SimKeyTypeDef sNew;
+
+/// Store
+static KVS_TypeDef sKvs;
+
+/// Read buffer
+static uint8_t aucBuf[KVS_MAX_VALUE];
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Count down power cut budget
+ *
+ * @return  (bool)  Power is cut now
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimCut(void)
+{
+  if (lBudget == SIM_NO_CUT) return false;
+  return lBudget-- == 0L;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Erase simulated page
+ *
+ * @param[in] ulAddr  Page address
+ * @return  (bool)  Success
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimErase(uintptr_t ulAddr)
+{
+  uint16_t* puiPage = (uint16_t*)ulAddr;
+  if (bSimCut())
+  {
+    for (uint32_t i = 0u; i < SIM_PAGE_SIZE / 2u; ++i)
+    {
+      puiPage[i] |= (uint16_t)rand();
+    }
+    longjmp(sCut, 1);
+  }
+
+  ullErases++;
+  (void)memset(puiPage, 0xFF, SIM_PAGE_SIZE);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Program simulated half-words
+ *
+ * @param[in] ulAddr      Destination address
+ * @param[in] *puiData    Data, may be in simulated flash
+ * @param[in] ulCount     Number of half-words
+ * @return  (bool)  Success
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimProgram(uintptr_t ulAddr, const uint16_t* puiData, uint32_t ulCount)
+{
+  uint16_t* puiDst = (uint16_t*)ulAddr;
+  for (uint32_t i = 0u; i < ulCount; ++i)
+  {
+    uint16_t uiData = puiData[i];
+    if (bSimCut())
+    {
+      puiDst[i] &= (uint16_t)rand() | uiData;
+      longjmp(sCut, 1);
+    }
+    if ((puiDst[i] != 0xFFFFu) && (uiData != 0u))
+    {
+      fprintf(stderr, "programming error at offset 0x%lx\n",
+              (unsigned long)(ulAddr + 2u * i - (uintptr_t)auiFlash));
+      exit(EXIT_FAILURE);
+    }
+    ullPrograms++;
+    puiDst[i] = uiData;
+  }
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Store or delete sNew, returning early on power cut
+ *
+ * @param[in] uiKey     Key
+ * @param[in] bDelete   Delete key instead of storing value
+ * @return  (SimResultTypeDef)  Result
+ * @date  19.10.2026
+ ******************************************************************************/
+static SimResultTypeDef eSimOperation(uint16_t uiKey, bool bDelete)
+{
+  if (setjmp(sCut) != 0)
+  {
+    lBudget = SIM_NO_CUT;
+    return SIM_CUT;
+  }
+
+  bool bOk = bDelete ? bKVS_Delete(&sKvs, uiKey)
+                     : bKVS_Put(&sKvs, uiKey, sNew.aucValue, (uint32_t)sNew.lLen);
+  lBudget = SIM_NO_CUT;
+  return bOk ? SIM_OK : SIM_FAILED;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check store contents against expected state
+ *
+ * @param[in] *psKvs      Store
+ * @param[in] lPending    Key of interrupted operation, -1 if none
+ * @param[in] *psNew      New state of interrupted key
+ * @return  (bool)  Contents are consistent
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimCheck(const KVS_TypeDef* psKvs, long lPending, const SimKeyTypeDef* psNew)
+{
+  for (uint32_t k = 0u; k < SIM_KEYS; ++k)
+  {
+    int32_t lLen = lKVS_Get(psKvs, (uint16_t)(k + 1u), aucBuf, sizeof(aucBuf));
+    const SimKeyTypeDef* psOld = &asKeys[k];
+    bool bOld = (lLen == psOld->lLen) && ((lLen <= 0L) || (memcmp(aucBuf, psOld->aucValue, (size_t)lLen) == 0));
+    bool bNew = ((long)k == lPending) && (lLen == psNew->lLen) &&
+                ((lLen <= 0L) || (memcmp(aucBuf, psNew->aucValue, (size_t)lLen) == 0));
+    if (!bOld && !bNew)
+    {
+      fprintf(stderr, "key %u: length %d, expected %d\n", k + 1u, lLen, psOld->lLen);
+      return false;
+    }
+    if (bNew) asKeys[k] = *psNew;
+  }
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get monotonic time
+ *
+ * @return  (double)  Time in seconds
+ * @date  19.10.2026
+ ******************************************************************************/
+static double dGetTime(void)
+{
+  struct timespec sTs;
+  (void)clock_gettime(CLOCK_MONOTONIC, &sTs);
+  return (double)sTs.tv_sec + (double)sTs.tv_nsec * 1e-9;
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Simulator entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  long lOps = 100000L;
+  long lCutRate = 0L;
+  unsigned int uiPages = 4u;
+  unsigned int uiMaxLen = 64u;
+  unsigned int uiSeed = (unsigned int)time(NULL);
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "n:c:p:l:s:")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'n': lOps = strtol(optarg, NULL, 0); break;
+      case 'c': lCutRate = strtol(optarg, NULL, 0); break;
+      case 'p': uiPages = (unsigned int)strtoul(optarg, NULL, 0); break;
+      case 'l': uiMaxLen = (unsigned int)strtoul(optarg, NULL, 0); break;
+      case 's': uiSeed = (unsigned int)strtoul(optarg, NULL, 0); break;
+      default:
+        fprintf(stderr, "Usage: %s [-n <ops>] [-c <N>] [-p <pages>] [-l <len>] [-s <seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  if ((uiPages > KVS_MAX_PAGES) || (uiMaxLen > KVS_MAX_VALUE))
+  {
+    fprintf(stderr, "at most %u pages and %u bytes per value\n", KVS_MAX_PAGES, KVS_MAX_VALUE);
+    return EXIT_FAILURE;
+  }
+  srand(uiSeed);
+
+  const KVS_FlashTypeDef sFlash = {
+    .ulBase = (uintptr_t)auiFlash,
+    .ulPageSize = SIM_PAGE_SIZE,
+    .ulNumPages = uiPages,
+    .pfnErase = bSimErase,
+    .pfnProgram = bSimProgram
+  };
+
+  (void)memset(auiFlash, 0xFF, sizeof(auiFlash));
+  if (!bKVS_Mount(&sKvs, &sFlash))
+  {
+    fprintf(stderr, "mount failed\n");
+    return EXIT_FAILURE;
+  }
+  for (uint32_t k = 0u; k < SIM_KEYS; ++k)
+  {
+    asKeys[k].lLen = -1L;
+  }
+
+  long lCuts = 0L;
+  long lFull = 0L;
+  uint64_t ullBytes = 0u;
+  double dTime = 0.0;
+
+  for (long lOp = 0L; lOp < lOps; ++lOp)
+  {
+    long lKey = rand() % (long)SIM_KEYS;
+    bool bDelete = (rand() % 10) == 0;
+    sNew.lLen = bDelete ? -1L : (int32_t)((unsigned int)rand() % (uiMaxLen + 1u));
+    for (int32_t i = 0L; i < sNew.lLen; ++i)
+    {
+      sNew.aucValue[i] = (uint8_t)rand();
+    }
+    lBudget = ((lCutRate > 0L) && ((rand() % lCutRate) == 0)) ? rand() % 64L : SIM_NO_CUT;
+
+    double dStart = dGetTime();
+    SimResultTypeDef eResult = eSimOperation((uint16_t)(lKey + 1L), bDelete);
+    if (eResult != SIM_CUT)
+    {
+      dTime += dGetTime() - dStart;
+      if (eResult == SIM_OK)
+      {
+        asKeys[lKey] = sNew;
+        if (!bDelete) ullBytes += (uint64_t)sNew.lLen;
+      }
+      else
+      {
+        lFull++;
+      }
+    }
+    else
+    {
+      // Power cut: reboot
+      lCuts++;
+      if (!bKVS_Mount(&sKvs, &sFlash) || !bSimCheck(&sKvs, lKey, &sNew))
+      {
+        fprintf(stderr, "inconsistent after power cut in operation %ld\n", lOp);
+        return EXIT_FAILURE;
+      }
+    }
+
+    if (((lOp % 1000L) == 0L) && !bSimCheck(&sKvs, -1L, &sNew))
+    {
+      fprintf(stderr, "inconsistent in operation %ld\n", lOp);
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Read throughput
+  uint64_t ullReadBytes = 0u;
+  double dStart = dGetTime();
+  for (long i = 0L; i < lOps; ++i)
+  {
+    int32_t lLen = lKVS_Get(&sKvs, (uint16_t)(i % (long)SIM_KEYS + 1L), aucBuf, sizeof(aucBuf));
+    if (lLen > 0L) ullReadBytes += (uint64_t)lLen;
+  }
+  double dRead = dGetTime() - dStart;
+
+  KVS_StatsTypeDef sStats;
+  vKVS_GetStats(&sKvs, &sStats);
+  printf(
+    "operations:    %ld (%ld power cuts, %ld rejected as full)\n"
+    "write:         %.2f Mops/s, %.1f MB/s value data\n"
+    "read:          %.2f Mops/s, %.1f MB/s value data\n"
+    "programmed:    %.2f half-words per value byte\n"
+    "erases:        %llu (page erase counts %u..%u)\n"
+    "keys:          %u, %u bytes free\n",
+    lOps, lCuts, lFull,
+    (dTime > 0.0) ? (double)lOps / dTime * 1e-6 : 0.0,
+    (dTime > 0.0) ? (double)ullBytes / dTime * 1e-6 : 0.0,
+    (dRead > 0.0) ? (double)lOps / dRead * 1e-6 : 0.0,
+    (dRead > 0.0) ? (double)ullReadBytes / dRead * 1e-6 : 0.0,
+    (ullBytes != 0u) ? (double)ullPrograms / (double)ullBytes : 0.0,
+    (unsigned long long)ullErases, sStats.uiMinErase, sStats.uiMaxErase,
+    sStats.ulKeys, sStats.ulFreeBytes
+  );
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,486 @@
+/*!****************************************************************************
+ * @file
+ * nor_sim.c
+ *
+ * @brief
+ * Host simulator for the SPI NOR flash log
+ *
+ * Runs the log (lib/norlog) and the flash command layer (lib/spinor) against
+ * a simulated 25-series serial NOR flash on the SPI bus level: commands are
+ * decoded byte by byte from the transferred data, page program and sector
+ * erase need a preceding write enable and keep the device busy for their
+ * typical duration, and any access while busy, programming of bits that are
+ * not erased or program data wrapping within a page is reported as an error.
+ * Page data is sent through an asynchronous bus driver, as with DMA.
+ *
+ * A pseudo-random byte stream is written in random chunk sizes; the log is
+ * flushed and remounted a number of times in between. Finally, the dump must
+ * be the tail of the written stream, or all of it if the log did not wrap.
+ *
+ * Prints the sustained write throughput in simulated time and flash
+ * statistics; exits with failure status on the first error.
+ *
+ * Usage: nor_sim [-n <bytes>] [-k <KB>] [-f <MHz>] [-r <N>] [-s <seed>]
+ *   -n <bytes>   Number of bytes to write (default 1000000)
+ *   -k <KB>      Device capacity in KB, power of two (default 64)
+ *   -f <MHz>     SPI clock (default 18)
+ *   -r <N>       Number of remounts (default 10)
+ *   -s <seed>    Random seed
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "norlog.h"
+#include "spinor.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// JEDEC manufacturer and memory type (Winbond W25Q)
+#define SIM_JEDEC_MFR                 0xEFu
+#define SIM_JEDEC_TYPE                0x40u
+
+/*! @brief Typical operation times in ns
+ *  @{                                                                        */
+#define SIM_T_PP                      700000uLL     ///< Page program
+#define SIM_T_SE                      45000000uLL   ///< Sector erase
+#define SIM_T_CS                      50uLL         ///< Chip select toggle
+/*! @}                                                                        */
+
+/// Maximum chunk size written at once
+#define SIM_MAX_CHUNK                 300u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Simulated device
+typedef struct {
+  uint8_t* pucMem;                ///< Array contents
+  uint32_t ulSize;                ///< Capacity in bytes
+  uint8_t ucCapacity;             ///< JEDEC capacity code
+  bool bSelected;                 ///< Chip select asserted
+  uint8_t ucCmd;                  ///< Current command
+  uint32_t ulCount;               ///< Bytes received since select
+  uint32_t ulAddr;                ///< Command address
+  bool bWel;                      ///< Write enable latch
+  uint64_t ullBusyUntil;          ///< End of program/erase
+  uint8_t aucLatch[SPINOR_PAGE_SIZE]; ///< Page program data
+  uint32_t ulLatchLen;            ///< Bytes in page latch
+} SimNorTypeDef;
+
+/// Dump buffer
+typedef struct {
+  uint8_t* pucBuf;                ///< Dumped bytes
+  uint64_t ullLen;                ///< Number of bytes dumped
+  uint64_t ullCap;                ///< Buffer size
+} SimDumpTypeDef;
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Device
+static SimNorTypeDef sDev;
+
+/// Simulated time in ns, byte time on the bus
+static uint64_t ullNow;
+static uint64_t ullByteTime;
+
+/// End of asynchronous transfer, 0 if none
+static uint64_t ullAsyncUntil;
+
+/// Device operation counters
+static uint64_t ullPrograms;
+static uint64_t ullErases;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Report protocol error and exit
+ *
+ * @param[in] *pcMsg  Message
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimFail(const char* pcMsg)
+{
+  fprintf(stderr, "error at %.3f ms: %s (command 0x%02x, address 0x%06x)\n",
+          (double)ullNow * 1e-6, pcMsg, sDev.ucCmd, sDev.ulAddr);
+  exit(EXIT_FAILURE);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if a program or erase is in progress
+ *
+ * @return  (bool)  Device busy
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimDevBusy(void)
+{
+  return ullNow < sDev.ullBusyUntil;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Shift one byte through the device
+ *
+ * @param[in] ucIn    Byte sent to device
+ * @return  (uint8_t)   Byte returned by device
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint8_t ucSimDevShift(uint8_t ucIn)
+{
+  if (!sDev.bSelected) vSimFail("transfer without chip select");
+
+  uint32_t ulIdx = sDev.ulCount++;
+  if (ulIdx == 0u)
+  {
+    sDev.ucCmd = ucIn;
+    sDev.ulAddr = 0u;
+    sDev.ulLatchLen = 0u;
+    if (bSimDevBusy() && (ucIn != SPINOR_CMD_RDSR)) vSimFail("command while busy");
+    if (ucIn == SPINOR_CMD_WREN) sDev.bWel = true;
+    return 0xFFu;
+  }
+
+  switch (sDev.ucCmd)
+  {
+    case SPINOR_CMD_RDSR:
+      return (uint8_t)((bSimDevBusy() ? SPINOR_SR_WIP : 0u) | (sDev.bWel ? SPINOR_SR_WEL : 0u));
+
+    case SPINOR_CMD_RDID:
+      if (ulIdx == 1u) return SIM_JEDEC_MFR;
+      if (ulIdx == 2u) return SIM_JEDEC_TYPE;
+      if (ulIdx == 3u) return sDev.ucCapacity;
+      return 0xFFu;
+
+    case SPINOR_CMD_READ:
+    case SPINOR_CMD_PP:
+    case SPINOR_CMD_SE:
+      if (ulIdx <= 3u)
+      {
+        sDev.ulAddr = ((sDev.ulAddr << 8) | ucIn) & (sDev.ulSize - 1u);
+        return 0xFFu;
+      }
+      if (sDev.ucCmd == SPINOR_CMD_READ)
+      {
+        return sDev.pucMem[(sDev.ulAddr + ulIdx - 4u) & (sDev.ulSize - 1u)];
+      }
+      if (sDev.ucCmd == SPINOR_CMD_PP)
+      {
+        if (sDev.ulLatchLen == SPINOR_PAGE_SIZE) vSimFail("program data wraps within page");
+        sDev.aucLatch[sDev.ulLatchLen++] = ucIn;
+        return 0xFFu;
+      }
+      vSimFail("data after sector erase address");
+      return 0xFFu;
+
+    default:
+      return 0xFFu;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Release chip select: execute program or erase
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimDevDeselect(void)
+{
+  sDev.bSelected = false;
+  if (sDev.ulCount == 0u) return;
+
+  if ((sDev.ucCmd == SPINOR_CMD_PP) || (sDev.ucCmd == SPINOR_CMD_SE))
+  {
+    if (sDev.ulCount < 4u) vSimFail("incomplete address");
+    if (!sDev.bWel) vSimFail("program/erase without write enable");
+    sDev.bWel = false;
+  }
+
+  if (sDev.ucCmd == SPINOR_CMD_PP)
+  {
+    uint32_t ulPage = sDev.ulAddr & ~(SPINOR_PAGE_SIZE - 1u);
+    for (uint32_t i = 0u; i < sDev.ulLatchLen; ++i)
+    {
+      uint32_t ulAddr = ulPage + ((sDev.ulAddr + i) & (SPINOR_PAGE_SIZE - 1u));
+      uint8_t ucData = sDev.aucLatch[i];
+      if ((sDev.pucMem[ulAddr] & ucData) != ucData) vSimFail("programming bits that are not erased");
+      sDev.pucMem[ulAddr] &= ucData;
+    }
+    sDev.ullBusyUntil = ullNow + SIM_T_PP;
+    ullPrograms++;
+  }
+  else if (sDev.ucCmd == SPINOR_CMD_SE)
+  {
+    (void)memset(&sDev.pucMem[sDev.ulAddr & ~(SPINOR_SECTOR_SIZE - 1u)], 0xFF, SPINOR_SECTOR_SIZE);
+    sDev.ullBusyUntil = ullNow + SIM_T_SE;
+    ullErases++;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Bus driver: chip select
+ *
+ * @param[in] bSelect   Assert chip select
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimSelect(bool bSelect)
+{
+  if (ullAsyncUntil != 0u) vSimFail("chip select during asynchronous transfer");
+  ullNow += SIM_T_CS;
+  if (bSelect)
+  {
+    sDev.bSelected = true;
+    sDev.ulCount = 0u;
+  }
+  else
+  {
+    vSimDevDeselect();
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Bus driver: blocking transfer
+ *
+ * @param[in] *pucTx    Transmit data, NULL for 0xFF
+ * @param[out] *pucRx   Receive buffer, or NULL
+ * @param[in] ulLen     Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimTransfer(const uint8_t* pucTx, uint8_t* pucRx, uint32_t ulLen)
+{
+  if (ullAsyncUntil != 0u) vSimFail("transfer during asynchronous transfer");
+  for (uint32_t i = 0u; i < ulLen; ++i)
+  {
+    uint8_t ucRx = ucSimDevShift((pucTx != NULL) ? pucTx[i] : 0xFFu);
+    if (pucRx != NULL) pucRx[i] = ucRx;
+  }
+  ullNow += ullByteTime * ulLen;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Bus driver: start asynchronous transmit, chip select released when done
+ *
+ * @param[in] *pucTx  Transmit data
+ * @param[in] ulLen   Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimWriteAsync(const uint8_t* pucTx, uint32_t ulLen)
+{
+  for (uint32_t i = 0u; i < ulLen; ++i)
+  {
+    (void)ucSimDevShift(pucTx[i]);
+  }
+  ullAsyncUntil = ullNow + ullByteTime * ulLen;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Bus driver: check asynchronous transfer (one poll costs 1 us)
+ *
+ * @return  (bool)  Transfer in progress
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimIsBusy(void)
+{
+  if (ullAsyncUntil == 0u) return false;
+  if (ullNow < ullAsyncUntil)
+  {
+    ullNow += 1000u;
+    return true;
+  }
+  ullAsyncUntil = 0u;
+  vSimDevDeselect();
+  return false;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stream byte at position
+ *
+ * @param[in] ullPos  Position
+ * @return  (uint8_t)   Byte
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint8_t ucSimStream(uint64_t ullPos)
+{
+  uint64_t ullX = (ullPos + 1u) * 0x9E3779B97F4A7C15uLL;
+  return (uint8_t)(ullX >> 56);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Dump sink: collect payload
+ *
+ * @param[in] *pucData      Payload
+ * @param[in] ulLen         Payload length
+ * @param[in,out] *pvContext  Dump buffer
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimDumpSink(const uint8_t* pucData, uint32_t ulLen, void* pvContext)
+{
+  SimDumpTypeDef* psDump = (SimDumpTypeDef*)pvContext;
+  if (psDump->ullLen + ulLen > psDump->ullCap) vSimFail("dump larger than device");
+  (void)memcpy(&psDump->pucBuf[psDump->ullLen], pucData, ulLen);
+  psDump->ullLen += ulLen;
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Simulator entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  uint64_t ullTotal = 1000000u;
+  unsigned int uiKb = 64u;
+  double dMhz = 18.0;
+  unsigned int uiRemounts = 10u;
+  unsigned int uiSeed = (unsigned int)time(NULL);
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "n:k:f:r:s:")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'n': ullTotal = strtoull(optarg, NULL, 0); break;
+      case 'k': uiKb = (unsigned int)strtoul(optarg, NULL, 0); break;
+      case 'f': dMhz = strtod(optarg, NULL); break;
+      case 'r': uiRemounts = (unsigned int)strtoul(optarg, NULL, 0); break;
+      case 's': uiSeed = (unsigned int)strtoul(optarg, NULL, 0); break;
+      default:
+        fprintf(stderr, "Usage: %s [-n <bytes>] [-k <KB>] [-f <MHz>] [-r <N>] [-s <seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  if ((uiKb < 64u) || (uiKb > SPINOR_MAX_SIZE / 1024u) || ((uiKb & (uiKb - 1u)) != 0u) || (dMhz <= 0.0))
+  {
+    fprintf(stderr, "capacity must be a power of two from 64 to %lu KB\n",
+            (unsigned long)(SPINOR_MAX_SIZE / 1024u));
+    return EXIT_FAILURE;
+  }
+  srand(uiSeed);
+
+  sDev.ulSize = uiKb * 1024u;
+  sDev.pucMem = malloc(sDev.ulSize);
+  if (sDev.pucMem == NULL) return EXIT_FAILURE;
+  (void)memset(sDev.pucMem, 0xFF, sDev.ulSize);
+  while ((1uL << sDev.ucCapacity) < sDev.ulSize) sDev.ucCapacity++;
+  ullByteTime = (uint64_t)(8000.0 / dMhz);
+
+  const SPINOR_BusTypeDef sBus = {
+    .pfnSelect = vSimSelect,
+    .pfnTransfer = vSimTransfer,
+    .pfnWriteAsync = vSimWriteAsync,
+    .pfnIsBusy = bSimIsBusy
+  };
+  SPINOR_TypeDef sNor;
+  static NORLOG_TypeDef sLog;
+  if (!bSPINOR_Init(&sNor, &sBus) || (sNor.ulSize != sDev.ulSize) ||
+      !bNORLOG_Mount(&sLog, &sNor, 0u, sNor.ulSize))
+  {
+    fprintf(stderr, "device not detected or mount failed\n");
+    return EXIT_FAILURE;
+  }
+
+  // Remount points
+  uint64_t ullNextRemount = (uiRemounts != 0u) ? ullTotal / (uiRemounts + 1u) : UINT64_MAX;
+  uint64_t ullPos = 0u;
+  uint64_t ullPages = 0u;
+  uint64_t ullStalls = 0u;
+  uint8_t aucChunk[SIM_MAX_CHUNK];
+  uint64_t ullStart = ullNow;
+
+  while (ullPos < ullTotal)
+  {
+    uint32_t ulLen = 1u + (uint32_t)rand() % SIM_MAX_CHUNK;
+    if (ulLen > ullTotal - ullPos) ulLen = (uint32_t)(ullTotal - ullPos);
+    for (uint32_t i = 0u; i < ulLen; ++i)
+    {
+      aucChunk[i] = ucSimStream(ullPos + i);
+    }
+
+    uint32_t ulDone = 0u;
+    while (ulDone < ulLen)
+    {
+      ulDone += ulNORLOG_Write(&sLog, &aucChunk[ulDone], ulLen - ulDone);
+      vNORLOG_Poll(&sLog);
+    }
+    ullPos += ulLen;
+
+    if (ullPos >= ullNextRemount)
+    {
+      NORLOG_StatsTypeDef sStats;
+      vNORLOG_Flush(&sLog);
+      vNORLOG_GetStats(&sLog, &sStats);
+      ullPages += sStats.ulPages;
+      ullStalls += sStats.ulStalls;
+      if (!bNORLOG_Mount(&sLog, &sNor, 0u, sNor.ulSize))
+      {
+        fprintf(stderr, "remount failed at byte %llu\n", (unsigned long long)ullPos);
+        return EXIT_FAILURE;
+      }
+      ullNextRemount += ullTotal / (uiRemounts + 1u);
+    }
+  }
+  vNORLOG_Flush(&sLog);
+  uint64_t ullTime = ullNow - ullStart;
+
+  NORLOG_StatsTypeDef sStats;
+  vNORLOG_GetStats(&sLog, &sStats);
+  ullPages += sStats.ulPages;
+  ullStalls += sStats.ulStalls;
+
+  // Read back: dump must be the tail of the stream
+  SimDumpTypeDef sDump = { .pucBuf = malloc(sDev.ulSize), .ullLen = 0u, .ullCap = sDev.ulSize };
+  if (sDump.pucBuf == NULL) return EXIT_FAILURE;
+  uint64_t ullDumpStart = ullNow;
+  uint32_t ulDumped = ulNORLOG_Dump(&sLog, vSimDumpSink, &sDump);
+  uint64_t ullDumpTime = ullNow - ullDumpStart;
+
+  bool bOk = (ulDumped == sDump.ullLen) && (sDump.ullLen <= ullTotal);
+  for (uint64_t i = 0u; bOk && (i < sDump.ullLen); ++i)
+  {
+    bOk = sDump.pucBuf[i] == ucSimStream(ullTotal - sDump.ullLen + i);
+  }
+  bool bWrapped = ullPages > sNor.ulSize / SPINOR_PAGE_SIZE;
+  if (!bOk || (!bWrapped && (ulDumped != ullTotal)))
+  {
+    fprintf(stderr, "dump mismatch: %lu bytes dumped, %llu written\n",
+            (unsigned long)ulDumped, (unsigned long long)ullTotal);
+    return EXIT_FAILURE;
+  }
+
+  printf(
+    "written:       %llu bytes in %llu pages, %u remounts\n"
+    "throughput:    %.1f KB/s sustained at %.1f MHz SPI (simulated)\n"
+    "flash:         %llu page programs, %llu sector erases\n"
+    "stalls:        %llu writes waited for a free buffer\n"
+    "dump:          %lu bytes (%s), %.1f KB/s\n",
+    (unsigned long long)ullTotal, (unsigned long long)ullPages, uiRemounts,
+    (ullTime != 0u) ? (double)ullTotal / ((double)ullTime * 1e-9) / 1024.0 : 0.0, dMhz,
+    (unsigned long long)ullPrograms, (unsigned long long)ullErases,
+    (unsigned long long)ullStalls,
+    (unsigned long)ulDumped, bWrapped ? "wrapped, tail" : "complete",
+    (ullDumpTime != 0u) ? (double)ulDumped / ((double)ullDumpTime * 1e-9) / 1024.0 : 0.0
+  );
+
+  free(sDump.pucBuf);
+  free(sDev.pucMem);
+  return EXIT_SUCCESS;
+}
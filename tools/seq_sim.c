@@ -0,0 +1,640 @@
+/*!****************************************************************************
+ * @file
+ * seq_sim.c
+ *
+ * @brief
+ * Simulated timer and DMA channel for the waveform sequencer
+ *
+ * Runs lib/seq with the interrupt handler logic of hw_seq against a
+ * simulated timer and DMA channel. Each timer update loads the compare
+ * preload registers into the outputs and requests one DMA burst of one
+ * sample (1..3 channels); a burst requested while the channel is disabled
+ * stays pending until it is enabled again. Transfer complete and half
+ * transfer flags raise the interrupt, which runs after a random latency.
+ *
+ * Samples carry their table, index and channel, so the output of every
+ * timer period is checked: all channels from the same sample, samples in the
+ * order of the passes selected (or of the stream), no sample skipped. A
+ * sample may only be held longer when a pass was re-armed after the next
+ * update (latency over one sample period) or after the end.
+ *
+ * Scenarios: an endless table, pass counts with linked tables and the end of
+ * the sequence, queued tables at random times, re-arming late, streams with
+ * random half buffer sizes and ends, and streams refilled too late, which
+ * must be reported as underruns.
+ *
+ * Exits with failure status on the first error.
+ *
+ * Usage: seq_sim [-r <runs>] [-s <seed>]
+ *   -r <runs>    Runs per scenario (default 200)
+ *   -s <seed>    Random seed
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "seq.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Time steps per sample period
+#define SIM_STEPS                     16u
+
+/// Most channels per sample (CCR1..CCR3)
+#define SIM_CHANNELS_MAX              3u
+
+/// Tables and most samples per table
+#define SIM_TABLES                    6u
+#define SIM_SAMPLES_MAX               200u
+
+/// Most samples per stream half
+#define SIM_HALF_MAX                  64u
+
+/// Length of the expected sample queue
+#define SIM_EXPECT_SIZE               4096u
+
+/// Channel value of a sample: sample ID and channel
+#define SIM_VALUE(ulId, ulCh)         ((uint16_t)((ulId) * SIM_CHANNELS_MAX + (ulCh)))
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// DMA channel
+typedef struct {
+  const uint16_t* puiBase;        ///< Memory address
+  uint32_t ulLen;                 ///< Transfers per activation
+  uint32_t ulCount;               ///< Transfers remaining
+  bool bCirc;                     ///< Circular mode
+  bool bEn;                       ///< Enabled
+  bool bHt;                       ///< Half transfer flag
+  bool bTc;                       ///< Transfer complete flag
+} SimDmaTypeDef;
+
+/// Run result
+typedef struct {
+  uint32_t ulSamples;             ///< Samples played
+  uint32_t ulHeld;                ///< Periods a sample was held by late re-arming
+  uint32_t ulLate;                ///< Updates with the previous burst still pending
+  bool bDeviated;                 ///< Output differed from the expected samples
+} SimResultTypeDef;
+
+
+/*- Private functions --------------------------------------------------------*/
+static void vSimServe(void);
+static void vSimIsr(void);
+static void vSimExpect(uint32_t ulId);
+static uint32_t ulSimRefill(void* pvDst, uint32_t ulSamples, void* pvContext);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Channels per sample
+static uint32_t ulChannels;
+
+/// Timer: output and preload registers, pending burst transfers, DMA request enable
+static uint16_t auiOutput[SIM_CHANNELS_MAX];
+static uint16_t auiPreload[SIM_CHANNELS_MAX];
+static uint32_t ulPending;
+static bool bUde;
+
+/// DMA channel
+static SimDmaTypeDef sDma;
+
+/// Interrupt: latency limit in steps, scheduled step (0: none), current step
+static uint32_t ulMaxLatency;
+static uint64_t ullIsrAt;
+static uint64_t ullNow;
+
+/// Stream mode instead of table passes
+static bool bStream;
+
+/// Sequence ended (table) or stopped (stream)
+static bool bDone;
+
+/// Tables and their samples
+static SEQ_TableTypeDef asTables[SIM_TABLES];
+static uint16_t aauiData[SIM_TABLES][SIM_SAMPLES_MAX * SIM_CHANNELS_MAX];
+
+/// Player, stream and counters under test
+static SEQ_PlayerTypeDef sPlayer;
+static SEQ_StreamTypeDef sStream;
+static SEQ_StatsTypeDef sStats;
+static uint16_t auiRing[2u * SIM_HALF_MAX * SIM_CHANNELS_MAX];
+
+/// Reference player: table, passes of it started, queued table
+static const SEQ_TableTypeDef* psRefTable;
+static uint32_t ulRefPass;
+static const SEQ_TableTypeDef* psRefQueued;
+
+/// Stream source: next sample ID, last sample ID
+static uint32_t ulStreamNext;
+static uint32_t ulStreamLast;
+
+/// Expected samples, not yet output
+static uint32_t aulExpect[SIM_EXPECT_SIZE];
+static uint32_t ulExpectHead;
+static uint32_t ulExpectTail;
+
+/// Result of the run
+static SimResultTypeDef sResult;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Print error and exit
+ *
+ * @param[in] *pcMsg    Message
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimFail(const char* pcMsg)
+{
+  printf("error: %s\n", pcMsg);
+  exit(EXIT_FAILURE);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Random number in range
+ *
+ * @param[in] ulMin     Smallest value
+ * @param[in] ulMax     Largest value
+ * @return  (uint32_t)  Value in ulMin .. ulMax
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulSimRand(uint32_t ulMin, uint32_t ulMax)
+{
+  return ulMin + (uint32_t)rand() % (ulMax - ulMin + 1u);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Enable DMA channel for a block and serve a pending burst
+ *
+ * @param[in] *puiBase  First transfer
+ * @param[in] ulLen     Transfers
+ * @param[in] bCirc     Circular mode
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimArm(const uint16_t* puiBase, uint32_t ulLen, bool bCirc)
+{
+  sDma.puiBase = puiBase;
+  sDma.ulLen = ulLen;
+  sDma.ulCount = ulLen;
+  sDma.bCirc = bCirc;
+  sDma.bEn = true;
+  vSimServe();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Serve pending burst transfers while the channel is enabled
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimServe(void)
+{
+  while ((ulPending != 0u) && sDma.bEn && (sDma.ulCount != 0u))
+  {
+    auiPreload[ulChannels - ulPending] = sDma.puiBase[sDma.ulLen - sDma.ulCount];
+    ulPending--;
+    sDma.ulCount--;
+
+    bool bFlag = false;
+    if (sDma.bCirc && (sDma.ulCount == sDma.ulLen / 2u))
+    {
+      sDma.bHt = true;
+      bFlag = true;
+    }
+    if (sDma.ulCount == 0u)
+    {
+      sDma.bTc = true;
+      bFlag = true;
+      if (sDma.bCirc) sDma.ulCount = sDma.ulLen;
+    }
+    if (bFlag && (ullIsrAt == 0uLL)) ullIsrAt = ullNow + ulSimRand(0u, ulMaxLatency);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check that no further samples will be expected
+ *
+ * @return  (bool)  Sequence ended or stream source exhausted
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimEnded(void)
+{
+  return bDone || (bStream && (ulStreamNext > ulStreamLast));
+}
+
+/*!****************************************************************************
+ * @brief
+ * Timer update: load outputs, request burst, check output
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimUpdate(void)
+{
+  memcpy(auiOutput, auiPreload, sizeof(auiOutput));
+  if (bUde && (ulPending != 0u)) sResult.ulLate++;
+  if (bUde && (ulPending == 0u)) ulPending = ulChannels;
+  vSimServe();
+
+  // All channels from one sample (ID 0: idle)
+  uint32_t ulId = auiOutput[0] / SIM_CHANNELS_MAX;
+  for (uint32_t c = 0u; c < ulChannels; ++c)
+  {
+    uint16_t uiExp = (ulId == 0u) ? 0u : SIM_VALUE(ulId, c);
+    if (auiOutput[c] != uiExp)
+    {
+      printf("  period at step %llu: channel %u is %u, expected %u\n", (unsigned long long)ullNow,
+             c, auiOutput[c], uiExp);
+      vSimFail("sample torn across channels");
+    }
+  }
+
+  static uint32_t ulLast;
+  if (ullNow == SIM_STEPS) ulLast = 0u;
+  if ((ulExpectHead != ulExpectTail) && (ulId == aulExpect[ulExpectTail % SIM_EXPECT_SIZE]))
+  {
+    ulExpectTail++;
+    sResult.ulSamples++;
+  }
+  else if (ulId != ulLast)
+  {
+    sResult.bDeviated = true;
+  }
+  else if ((ulId != 0u) && ((ulExpectHead != ulExpectTail) || !bSimEnded()))
+  {
+    sResult.ulHeld++;
+  }
+  ulLast = ulId;
+}
+
+/*!****************************************************************************
+ * @brief
+ * DMA interrupt handler, as in hw_seq
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimIsr(void)
+{
+  bool bHt = sDma.bHt;
+  bool bTc = sDma.bTc;
+  sDma.bHt = false;
+  sDma.bTc = false;
+
+  if (bStream)
+  {
+    if (!sDma.bEn) return;
+    uint32_t ulPlaying = ((sDma.ulLen - sDma.ulCount) >= sDma.ulLen / 2u) ? 1u : 0u;
+    if (bHt && bTc) sStats.ulUnderruns++;
+    if (!bSEQ_StreamRefill(&sStream, 1u - ulPlaying, &sStats))
+    {
+      sDma.bEn = false;
+      bUde = false;
+      ulPending = 0u;
+      bDone = true;
+    }
+    return;
+  }
+
+  if (!bTc) return;
+  sDma.bEn = false;
+  const SEQ_TableTypeDef* psTable = psSEQ_NextPass(&sPlayer, &sStats);
+
+  // Reference selection of the next pass
+  const SEQ_TableTypeDef* psRef = psRefTable;
+  if (psRefQueued != NULL)
+  {
+    psRef = psRefQueued;
+    psRefQueued = NULL;
+    ulRefPass = 0u;
+  }
+  else if ((psRef->ulPasses != 0u) && (ulRefPass >= psRef->ulPasses))
+  {
+    psRef = psRef->psNext;
+    ulRefPass = 0u;
+  }
+  ulRefPass++;
+  if (psRef != NULL) psRefTable = psRef;
+  if (psTable != psRef) vSimFail("next pass selects a different table");
+
+  if (psTable == NULL)
+  {
+    bUde = false;
+    ulPending = 0u;
+    bDone = true;
+    return;
+  }
+
+  uint32_t t = (uint32_t)(psTable - asTables);
+  for (uint32_t i = 0u; i < psTable->ulSamples; ++i)
+  {
+    vSimExpect(t * SIM_SAMPLES_MAX + i + 1u);
+  }
+  vSimArm((const uint16_t*)psTable->pvData, psTable->ulSamples * ulChannels, false);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Append expected sample
+ *
+ * @param[in] ulId  Sample ID
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimExpect(uint32_t ulId)
+{
+  if (ulExpectHead - ulExpectTail >= SIM_EXPECT_SIZE) vSimFail("expected sample queue full");
+  aulExpect[ulExpectHead++ % SIM_EXPECT_SIZE] = ulId;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stream refill: consecutive sample IDs up to the last one
+ *
+ * @param[out] *pvDst     Samples
+ * @param[in] ulSamples   Samples requested
+ * @param[in] *pvContext  Unused
+ * @return  (uint32_t)  Samples written
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulSimRefill(void* pvDst, uint32_t ulSamples, void* pvContext)
+{
+  (void)pvContext;
+  uint16_t* puiDst = (uint16_t*)pvDst;
+  uint32_t n = 0u;
+  for (; (n < ulSamples) && (ulStreamNext <= ulStreamLast); ++n)
+  {
+    for (uint32_t c = 0u; c < ulChannels; ++c)
+    {
+      puiDst[n * ulChannels + c] = SIM_VALUE(ulStreamNext, c);
+    }
+    vSimExpect(ulStreamNext++);
+  }
+  return n;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Reset timer, DMA and expected samples for a run
+ *
+ * @param[in] ulLatency   Latency limit in steps
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimReset(uint32_t ulLatency)
+{
+  ulChannels = ulSimRand(1u, SIM_CHANNELS_MAX);
+  memset(auiOutput, 0, sizeof(auiOutput));
+  memset(auiPreload, 0, sizeof(auiPreload));
+  memset(&sDma, 0, sizeof(sDma));
+  memset(&sStats, 0, sizeof(sStats));
+  memset(&sResult, 0, sizeof(sResult));
+  ulPending = 0u;
+  bUde = true;
+  ulMaxLatency = ulLatency;
+  ullIsrAt = 0uLL;
+  ullNow = 0uLL;
+  bDone = false;
+  ulExpectHead = 0u;
+  ulExpectTail = 0u;
+  psRefQueued = NULL;
+
+  for (uint32_t t = 0u; t < SIM_TABLES; ++t)
+  {
+    uint32_t ulSamples = (ulSimRand(0u, 3u) == 0u) ? ulSimRand(1u, 3u) : ulSimRand(1u, SIM_SAMPLES_MAX);
+    for (uint32_t i = 0u; i < ulSamples; ++i)
+    {
+      for (uint32_t c = 0u; c < ulChannels; ++c)
+      {
+        aauiData[t][i * ulChannels + c] = SIM_VALUE(t * SIM_SAMPLES_MAX + i + 1u, c);
+      }
+    }
+    asTables[t] = (SEQ_TableTypeDef){ .pvData = aauiData[t], .ulSamples = ulSamples };
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run simulation for a number of sample periods
+ *
+ * @param[in] ulPeriods   Sample periods
+ * @param[in] ulQueueRate Queue a random table in one step of ulQueueRate (0: never)
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimRun(uint32_t ulPeriods, uint32_t ulQueueRate)
+{
+  for (ullNow = 1uLL; ullNow <= (uint64_t)ulPeriods * SIM_STEPS; ++ullNow)
+  {
+    if ((ullNow % SIM_STEPS) == 0uLL) vSimUpdate();
+    if ((ulQueueRate != 0u) && !bDone && (ulSimRand(1u, ulQueueRate) == 1u))
+    {
+      const SEQ_TableTypeDef* psTable = &asTables[ulSimRand(0u, SIM_TABLES - 1u)];
+      vSEQ_Queue(&sPlayer, psTable);
+      psRefQueued = psTable;
+    }
+    if ((ullIsrAt != 0uLL) && (ullIsrAt <= ullNow))
+    {
+      ullIsrAt = 0uLL;
+      vSimIsr();
+    }
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start table playback
+ *
+ * @param[in] *psFirst  First table
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimStartTable(const SEQ_TableTypeDef* psFirst)
+{
+  bStream = false;
+  vSEQ_Init(&sPlayer, psFirst, &sStats);
+  psRefTable = psFirst;
+  ulRefPass = 1u;
+
+  uint32_t t = (uint32_t)(psFirst - asTables);
+  for (uint32_t i = 0u; i < psFirst->ulSamples; ++i)
+  {
+    vSimExpect(t * SIM_SAMPLES_MAX + i + 1u);
+  }
+  vSimArm((const uint16_t*)psFirst->pvData, psFirst->ulSamples * ulChannels, false);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Print scenario result and exit on failure
+ *
+ * @param[in] *pcName   Scenario
+ * @param[in] bOk       Passed
+ * @param[in] *pcInfo   Summary
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimCheck(const char* pcName, bool bOk, const char* pcInfo)
+{
+  printf("%-14s %-4s %s\n", pcName, bOk ? "ok" : "FAIL", pcInfo);
+  if (!bOk) exit(EXIT_FAILURE);
+}
+
+
+/*- Main ---------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+  unsigned long ulRuns = 200uL;
+  unsigned int uiSeed = (unsigned int)time(NULL);
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "r:s:")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'r': ulRuns = strtoul(optarg, NULL, 0); break;
+      case 's': uiSeed = (unsigned int)strtoul(optarg, NULL, 0); break;
+      default:
+        fprintf(stderr, "Usage: %s [-r <runs>] [-s <seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  if (ulRuns == 0uL) vSimFail("option out of range");
+  printf("seed %u\n", uiSeed);
+  srand(uiSeed);
+
+  char acInfo[96];
+  bool bOk;
+  uint64_t ullSamples;
+  uint64_t ullCount;
+
+  // Endless table: every sample in order, none held
+  bOk = true;
+  ullSamples = 0uLL;
+  for (unsigned long r = 0uL; r < ulRuns; ++r)
+  {
+    vSimReset(SIM_STEPS - 1u);
+    asTables[0].ulPasses = 0u;
+    vSimStartTable(&asTables[0]);
+    vSimRun(2000u, 0u);
+    bOk = bOk && !sResult.bDeviated && (sResult.ulHeld == 0u) &&
+          (sResult.ulSamples >= 1998u - asTables[0].ulSamples);
+    ullSamples += sResult.ulSamples;
+  }
+  snprintf(acInfo, sizeof(acInfo), "%llu samples", (unsigned long long)ullSamples);
+  vSimCheck("endless", bOk, acInfo);
+
+  // Pass counts and linked tables, then the last sample is held
+  bOk = true;
+  ullCount = 0uLL;
+  for (unsigned long r = 0uL; r < ulRuns; ++r)
+  {
+    vSimReset(SIM_STEPS - 1u);
+    uint32_t ulLinked = ulSimRand(1u, SIM_TABLES);
+    uint32_t ulTotal = 0u;
+    for (uint32_t t = 0u; t < ulLinked; ++t)
+    {
+      asTables[t].ulPasses = ulSimRand(1u, 4u);
+      asTables[t].psNext = (t + 1u < ulLinked) ? &asTables[t + 1u] : NULL;
+      ulTotal += asTables[t].ulPasses * asTables[t].ulSamples;
+    }
+    vSimStartTable(&asTables[0]);
+    vSimRun(ulTotal + 100u, 0u);
+    bOk = bOk && bDone && !sResult.bDeviated && (sResult.ulHeld == 0u) &&
+          (sResult.ulSamples == ulTotal) && (ulExpectHead == ulExpectTail);
+    ullCount += sStats.ulPasses;
+  }
+  snprintf(acInfo, sizeof(acInfo), "%llu passes", (unsigned long long)ullCount);
+  vSimCheck("passes", bOk, acInfo);
+
+  // Tables queued at random times take over at the next pass boundary
+  bOk = true;
+  ullCount = 0uLL;
+  for (unsigned long r = 0uL; r < ulRuns; ++r)
+  {
+    vSimReset(SIM_STEPS - 1u);
+    for (uint32_t t = 0u; t < SIM_TABLES; ++t)
+    {
+      asTables[t].ulPasses = ulSimRand(0u, 3u);
+      asTables[t].psNext = &asTables[ulSimRand(0u, SIM_TABLES - 1u)];
+    }
+    vSimStartTable(&asTables[0]);
+    vSimRun(4000u, ulSimRand(100u, 5000u));
+    bOk = bOk && !sResult.bDeviated && (sResult.ulHeld == 0u);
+    ullCount += sStats.ulSwaps;
+  }
+  snprintf(acInfo, sizeof(acInfo), "%llu swaps", (unsigned long long)ullCount);
+  vSimCheck("swap", bOk, acInfo);
+
+  // Re-armed late: samples only held, once per period missed
+  bOk = true;
+  ullCount = 0uLL;
+  for (unsigned long r = 0uL; r < ulRuns; ++r)
+  {
+    vSimReset(4u * SIM_STEPS);
+    for (uint32_t t = 0u; t < SIM_TABLES; ++t)
+    {
+      asTables[t].ulPasses = ulSimRand(0u, 3u);
+      asTables[t].psNext = &asTables[ulSimRand(0u, SIM_TABLES - 1u)];
+    }
+    vSimStartTable(&asTables[0]);
+    vSimRun(4000u, 1000u);
+    bOk = bOk && !sResult.bDeviated && (sResult.ulHeld == sResult.ulLate);
+    ullCount += sResult.ulLate;
+  }
+  snprintf(acInfo, sizeof(acInfo), "%llu periods missed", (unsigned long long)ullCount);
+  vSimCheck("late", bOk && (ullCount != 0uLL), acInfo);
+
+  // Streams: refilled within half a ring, every sample in order, then held
+  bOk = true;
+  ullSamples = 0uLL;
+  for (unsigned long r = 0uL; r < ulRuns; ++r)
+  {
+    uint32_t ulHalf = ulSimRand(1u, SIM_HALF_MAX);
+    vSimReset(ulHalf * SIM_STEPS - 1u);
+    bStream = true;
+    ulStreamNext = 1u;
+    ulStreamLast = ulSimRand(1u, 3000u);
+    if (!bSEQ_StreamInit(&sStream, auiRing, ulHalf, ulChannels * sizeof(uint16_t), ulSimRefill, NULL))
+    {
+      vSimFail("stream without samples");
+    }
+    vSimArm(auiRing, 2u * ulHalf * ulChannels, true);
+    vSimRun(ulStreamLast + 4u * ulHalf + 10u, 0u);
+    bOk = bOk && bDone && !sResult.bDeviated && (sResult.ulHeld == 0u) &&
+          (sResult.ulSamples == ulStreamLast) && (sStats.ulUnderruns == 0u);
+    ullSamples += sResult.ulSamples;
+  }
+  snprintf(acInfo, sizeof(acInfo), "%llu samples", (unsigned long long)ullSamples);
+  vSimCheck("stream", bOk, acInfo);
+
+  // Streams refilled too late: every deviation reported
+  bOk = true;
+  ullCount = 0uLL;
+  for (unsigned long r = 0uL; r < ulRuns; ++r)
+  {
+    uint32_t ulHalf = ulSimRand(1u, SIM_HALF_MAX);
+    vSimReset(3u * ulHalf * SIM_STEPS);
+    bStream = true;
+    ulStreamNext = 1u;
+    ulStreamLast = 3000u;
+    (void)bSEQ_StreamInit(&sStream, auiRing, ulHalf, ulChannels * sizeof(uint16_t), ulSimRefill, NULL);
+    vSimArm(auiRing, 2u * ulHalf * ulChannels, true);
+    vSimRun(2000u, 0u);
+    bOk = bOk && (!sResult.bDeviated || (sStats.ulUnderruns != 0u));
+    ullCount += sStats.ulUnderruns;
+  }
+  snprintf(acInfo, sizeof(acInfo), "%llu underruns", (unsigned long long)ullCount);
+  vSimCheck("underrun", bOk && (ullCount != 0uLL), acInfo);
+
+  // Set/reset words
+  bOk = (ulSEQ_Bsrr(0xF000u, 0x5A5Au) == 0xA0005000uL) && (ulSEQ_Bsrr(0x0000u, 0xFFFFu) == 0uL) &&
+        (ulSEQ_Bsrr(0xFFFFu, 0x0000u) == 0xFFFF0000uL);
+  vSimCheck("bsrr", bOk, "");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,332 @@
+/*!****************************************************************************
+ * @file
+ * shell_check.c
+ *
+ * @brief
+ * Host check of the command shell parser
+ *
+ * Feeds scripted input into lib/shell one character at a time, as the
+ * firmware's background loop does, against a small command table whose
+ * handlers record their arguments. After each step, the shell output and
+ * the recorded calls are compared with the script. The steps cover prefix
+ * matching (unique, ambiguous, exact match over longer names), argument
+ * splitting and limits, line endings, line editing, overlong lines, usage
+ * errors and number parsing.
+ *
+ * Prints one line per step; exits with failure status on the first
+ * mismatch.
+ *
+ * Usage: shell_check [-v]
+ *   -v   Print shell output of every step
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "shell.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Capture buffer size
+#define SIM_CAPTURE_SIZE              1024u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Script step
+typedef struct {
+  const char* pcInput;            ///< Characters fed to the shell
+  const char* pcOutput;           ///< Expected shell output
+  const char* pcCalls;            ///< Expected handler calls ("name(arg,arg)")
+} SimStepTypeDef;
+
+/// Captured text
+typedef struct {
+  char acBuf[SIM_CAPTURE_SIZE];   ///< Text
+  size_t ulLen;                   ///< Characters in buffer
+} SimCaptureTypeDef;
+
+
+/*- Private functions --------------------------------------------------------*/
+static bool bSimRecord(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[]);
+static bool bSimSet(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[]);
+static bool bSimHelp(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[]);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Print output of every step
+static bool bVerbose;
+
+/// Shell output and handler calls of the current step
+static SimCaptureTypeDef sOutput;
+static SimCaptureTypeDef sCalls;
+
+/// Command table ("stat" is a prefix of "stats")
+static const SHELL_CmdTypeDef asCmds[] = {
+  { .pcName = "help",  .pcArgs = NULL,        .pcHelp = "List commands",  .pfnRun = bSimHelp },
+  { .pcName = "stat",  .pcArgs = NULL,        .pcHelp = "Short stats",    .pfnRun = bSimRecord },
+  { .pcName = "stats", .pcArgs = "[reset]",   .pcHelp = "Full stats",     .pfnRun = bSimRecord },
+  { .pcName = "set",   .pcArgs = "<n> <val>", .pcHelp = "Set parameter",  .pfnRun = bSimSet },
+  { .pcName = "reset", .pcArgs = NULL,        .pcHelp = "Reset counters", .pfnRun = bSimRecord },
+  { .pcName = "bench", .pcArgs = "[runs]",    .pcHelp = "Run benchmark",  .pfnRun = bSimRecord }
+};
+
+/// Script
+static const SimStepTypeDef asScript[] = {
+  // Exact names, prefixes and line endings
+  { "bench\r",           "> bench\r\n",                             "bench()" },
+  { "b\n",               "> b\r\n",                                 "b()" },
+  { "stat\r\n",          "> stat\r\n",                              "stat()" },
+  { "stats 1 2\r",       "> stats 1 2\r\n",                         "stats(1,2)" },
+  { "\r",                "> \r\n",                                  "" },
+  { "\n\r",              "> \r\n",                                  "" },
+  { "re\r",              "> re\r\n",                                "re()" },
+  { "s\r",               "> s\r\n"
+                         "ambiguous command 's': stat stats set\r\n", "" },
+  { "st\r",              "> st\r\n"
+                         "ambiguous command 'st': stat stats\r\n",  "" },
+  { "x\r",               "> x\r\n"
+                         "unknown command 'x', try 'help'\r\n",     "" },
+  { "benchmark\r",       "> benchmark\r\n"
+                         "unknown command 'benchmark', try 'help'\r\n", "" },
+
+  // Blanks, argument limit
+  { "  \t bench   7 \r", ">   \t bench   7 \r\n",                   "bench(7)" },
+  { "   \r",             ">    \r\n",                               "" },
+  { "bench 1 2 3 4 5\r", "> bench 1 2 3 4 5\r\n",                   "bench(1,2,3,4,5)" },
+  { "bench 1 2 3 4 5 6\r", "> bench 1 2 3 4 5 6\r\n"
+                         "too many arguments (max. 5)\r\n",         "" },
+
+  // Line editing and control characters
+  { "benx\b\x7f" "nch\r", "> bench\r\n",                             "bench()" },
+  { "\b\b\bstat\r",      "> stat\r\n",                              "stat()" },
+  { "stats\x03" "bench\r", "> bench\r\n",                           "bench()" },
+  { "be\x1b" "nch\t9\r", "> bench\t9\r\n",                          "bench(9)" },
+  { "b\xe4nch\r",        "> bnch\r\n"
+                         "unknown command 'bnch', try 'help'\r\n",  "" },
+
+  // Overlong line is discarded, the next one works
+  { "bench 0123456789012345678901234567890123456789012345678901234567890123\r",
+                         "> bench 0123456789012345678901234567890123456789012345678901234567\r\n"
+                         "line too long (max. 64 characters)\r\n",  "" },
+  { "stat\r",            "> stat\r\n",                              "stat()" },
+
+  // Usage errors and number parsing
+  { "set\r",             "> set\r\n"
+                         "usage: set <n> <val>\r\n",                "" },
+  { "set 1 0x1F\r",      "> set 1 0x1F\r\n",                        "set(1,31)" },
+  { "se 4294967295 0\r", "> se 4294967295 0\r\n",                   "set(4294967295,0)" },
+  { "set 4294967296 0\r", "> set 4294967296 0\r\n"
+                         "usage: set <n> <val>\r\n",                "" },
+  { "set 0x 1\r",        "> set 0x 1\r\n"
+                         "usage: set <n> <val>\r\n",                "" },
+  { "set 12a 1\r",       "> set 12a 1\r\n"
+                         "usage: set <n> <val>\r\n",                "" },
+  { "set 0xffffffff 0xG\r", "> set 0xffffffff 0xG\r\n"
+                         "usage: set <n> <val>\r\n",                "" },
+
+  // Help lists the table
+  { "h\r",               "> h\r\n"
+                         "  help                      List commands\r\n"
+                         "  stat                      Short stats\r\n"
+                         "  stats    [reset]          Full stats\r\n"
+                         "  set      <n> <val>        Set parameter\r\n"
+                         "  reset                     Reset counters\r\n"
+                         "  bench    [runs]           Run benchmark\r\n", "" }
+};
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Append text to capture buffer
+ *
+ * @param[in,out] *psCap  Capture buffer
+ * @param[in] *pcBuf      Text
+ * @param[in] ulLen       Number of characters
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimCapture(SimCaptureTypeDef* psCap, const char* pcBuf, size_t ulLen)
+{
+  if (psCap->ulLen + ulLen >= SIM_CAPTURE_SIZE)
+  {
+    fprintf(stderr, "capture buffer overflow\n");
+    exit(EXIT_FAILURE);
+  }
+  (void)memcpy(&psCap->acBuf[psCap->ulLen], pcBuf, ulLen);
+  psCap->ulLen += ulLen;
+  psCap->acBuf[psCap->ulLen] = '\0';
+}
+
+/*!****************************************************************************
+ * @brief
+ * Shell output function
+ *
+ * @param[in] *pcBuf    Data
+ * @param[in] ulLen     Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimWrite(const char* pcBuf, uint32_t ulLen)
+{
+  vSimCapture(&sOutput, pcBuf, ulLen);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Handler: record call with arguments
+ *
+ * @param[in,out] *psShell  Shell instance
+ * @param[in] ulArgc        Number of arguments
+ * @param[in] *apcArgv[]    Arguments
+ * @return  (bool)  Always true
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimRecord(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[])
+{
+  (void)psShell;
+  if (apcArgv[ulArgc] != NULL) vSimCapture(&sCalls, "<argv not terminated>", 21u);
+  vSimCapture(&sCalls, apcArgv[0], strlen(apcArgv[0]));
+  vSimCapture(&sCalls, "(", 1u);
+  for (uint32_t i = 1u; i < ulArgc; ++i)
+  {
+    if (i > 1u) vSimCapture(&sCalls, ",", 1u);
+    vSimCapture(&sCalls, apcArgv[i], strlen(apcArgv[i]));
+  }
+  vSimCapture(&sCalls, ")", 1u);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Handler: two numeric arguments, recorded as parsed
+ *
+ * @param[in,out] *psShell  Shell instance
+ * @param[in] ulArgc        Number of arguments
+ * @param[in] *apcArgv[]    Arguments
+ * @return  (bool)  Arguments valid
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimSet(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[])
+{
+  (void)psShell;
+  uint32_t ulN, ulVal;
+  if ((ulArgc != 3u) || !bSHELL_ParseU32(apcArgv[1], &ulN) || !bSHELL_ParseU32(apcArgv[2], &ulVal))
+  {
+    return false;
+  }
+  char acBuf[40];
+  int iLen = snprintf(acBuf, sizeof(acBuf), "set(%lu,%lu)", (unsigned long)ulN, (unsigned long)ulVal);
+  vSimCapture(&sCalls, acBuf, (size_t)iLen);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Handler: list commands
+ *
+ * @param[in,out] *psShell  Shell instance
+ * @param[in] ulArgc        Number of arguments
+ * @param[in] *apcArgv[]    Arguments
+ * @return  (bool)  Always true
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimHelp(SHELL_TypeDef* psShell, uint32_t ulArgc, char* apcArgv[])
+{
+  (void)ulArgc;
+  (void)apcArgv;
+  vSHELL_PrintHelp(psShell);
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Print text with control characters escaped
+ *
+ * @param[in] *pcLabel  Label
+ * @param[in] *pcText   Text
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimPrintEscaped(const char* pcLabel, const char* pcText)
+{
+  printf("    %s \"", pcLabel);
+  for (; *pcText != '\0'; ++pcText)
+  {
+    if (*pcText == '\r') printf("\\r");
+    else if (*pcText == '\n') printf("\\n\n     %*s", (int)strlen(pcLabel) + 1, "");
+    else if ((uint8_t)*pcText < 0x20u) printf("\\x%02x", (unsigned int)(uint8_t)*pcText);
+    else putchar(*pcText);
+  }
+  printf("\"\n");
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Check entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "v")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'v': bVerbose = true; break;
+      default:
+        fprintf(stderr, "Usage: %s [-v]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+
+  static SHELL_TypeDef sShell;
+  vSHELL_Init(&sShell, asCmds, sizeof(asCmds) / sizeof(asCmds[0]), vSimWrite);
+
+  for (size_t i = 0u; i < sizeof(asScript) / sizeof(asScript[0]); ++i)
+  {
+    const SimStepTypeDef* psStep = &asScript[i];
+    sOutput.ulLen = 0u;
+    sOutput.acBuf[0] = '\0';
+    sCalls.ulLen = 0u;
+    sCalls.acBuf[0] = '\0';
+
+    // One character at a time, executing as soon as a line is complete
+    uint32_t ulLines = 0u;
+    for (const char* pcIn = psStep->pcInput; *pcIn != '\0'; ++pcIn)
+    {
+      if (bSHELL_Input(&sShell, *pcIn))
+      {
+        vSHELL_Execute(&sShell);
+        ulLines++;
+      }
+    }
+
+    bool bOk = (ulLines == 1u) && (strcmp(sOutput.acBuf, psStep->pcOutput) == 0) &&
+               (strcmp(sCalls.acBuf, psStep->pcCalls) == 0);
+    printf("%2zu %-4s %s\n", i + 1u, bOk ? "ok" : "FAIL", sCalls.acBuf);
+    if (bVerbose || !bOk)
+    {
+      vSimPrintEscaped("output:  ", sOutput.acBuf);
+    }
+    if (!bOk)
+    {
+      vSimPrintEscaped("expected:", psStep->pcOutput);
+      printf("    calls: \"%s\", expected \"%s\", %lu lines executed\n",
+             sCalls.acBuf, psStep->pcCalls, (unsigned long)ulLines);
+      return EXIT_FAILURE;
+    }
+  }
+
+  printf("%zu steps passed\n", sizeof(asScript) / sizeof(asScript[0]));
+  return EXIT_SUCCESS;
+}
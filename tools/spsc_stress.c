@@ -0,0 +1,433 @@
+/*!****************************************************************************
+ * @file
+ * spsc_stress.c
+ *
+ * @brief
+ * Host stress test of the lock-free SPSC queue on two threads
+ *
+ * A producer and a consumer thread pass items carrying a sequence number
+ * through a small queue defined with lib/spsc.h, built on the C11 atomics
+ * path (SPSC_SINGLE_CORE=0) so that the acquire/release ordering of
+ * SPSC_LOAD_ACQUIRE() and SPSC_STORE_RELEASE() is exercised between cores.
+ * The indices start just below the 32-bit wrap-around. Each side accesses
+ * the queue in one of the following ways:
+ *
+ *   single      bPush / bPop
+ *   bulk        ulPushBulk / ulPopBulk of random length
+ *   span        ulGetWriteSpan / vCommitWrite and ulGetReadSpan /
+ *               vCommitRead, filling and reading part of the span in place
+ *   mixed       A random one of the above for every access, on each side
+ *
+ * Both sides run each way, then pairs of different ways (push against bulk
+ * pop, bulk push against read span, write span against pop).
+ *
+ * The consumer checks every item: sequence numbers must follow each other
+ * without gap or repetition (no loss, no reordering) and the redundant
+ * fields must match (no torn or stale item). The fill level it sees must
+ * never exceed the queue size. The consumer starts only when the queue is
+ * full, so the high-water mark must end at the queue size; it must also be
+ * at least the largest fill level seen by the consumer.
+ *
+ * Exits with failure status on the first error.
+ *
+ * Usage: spsc_stress [-n <N>] [-s <seed>]
+ *   -n <N>       Items per run (default 5000000)
+ *   -s <seed>    Random seed
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "spsc.h"
+#include "chk.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+#if SPSC_SINGLE_CORE
+#error "spsc_stress needs the multi-core path (SPSC_SINGLE_CORE=0)"
+#endif
+
+/// Queue size in items
+#define CHK_SIZE                      16u
+
+/// Longest bulk access in items
+#define CHK_BULK_MAX                  (2u * CHK_SIZE)
+
+/// Index at start, items before the 32-bit wrap-around
+#define CHK_INDEX_START               (0xFFFFFFFFuL - 1000uL)
+
+/// Multiplier of the redundant item field
+#define CHK_FILL                      0x9E3779B97F4A7C15uLL
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Item: sequence number and redundant fields
+typedef struct {
+  uint32_t ulSeq;                 ///< Sequence number
+  uint32_t ulCheck;               ///< Inverted sequence number
+  uint64_t ullFill;               ///< Sequence number times CHK_FILL
+} ChkItemTypeDef;
+
+/// Queue access
+typedef enum {
+  CHK_MODE_SINGLE = 0,            ///< Single push/pop
+  CHK_MODE_BULK,                  ///< Bulk push/pop
+  CHK_MODE_SPAN,                  ///< Spans accessed in place
+  CHK_MODE_MIXED                  ///< Random access per operation
+} ChkModeTypeDef;
+
+/// State of one side
+typedef struct {
+  ChkModeTypeDef eMode;           ///< Queue access
+  uint64_t ullItems;              ///< Items to pass
+  uint64_t ullRand;               ///< Random state (not 0)
+  uint64_t ullDone;               ///< Items passed
+  uint64_t ullWaits;              ///< Accesses on a full or empty queue
+  uint32_t ulMaxCount;            ///< Largest fill level seen
+  const char* pcFailure;          ///< First failure, NULL if none
+} ChkSideTypeDef;
+
+
+/*- Private data -------------------------------------------------------------*/
+SPSC_DEFINE(Chk, ChkItemTypeDef, CHK_SIZE)
+
+/// Queue under test
+static SPSC_Chk_TypeDef sQueue;
+
+/// Set by the side failing first, stops the other side
+static bool bStop;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Record failure of one side and stop both
+ *
+ * @param[in,out] *psSide Side
+ * @param[in] *pcMsg      Message
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkFail(ChkSideTypeDef* psSide, const char* pcMsg)
+{
+  if (psSide->pcFailure == NULL) psSide->pcFailure = pcMsg;
+  __atomic_store_n(&bStop, true, __ATOMIC_RELAXED);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if a side has stopped the run
+ *
+ * @return  (bool)  Stopped
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bChkStopped(void)
+{
+  return __atomic_load_n(&bStop, __ATOMIC_RELAXED);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Access mode of the next operation
+ *
+ * @param[in,out] *psSide Side
+ * @return  (ChkModeTypeDef)  Single, bulk or span
+ * @date  19.10.2026
+ ******************************************************************************/
+static ChkModeTypeDef eChkMode(ChkSideTypeDef* psSide)
+{
+  if (psSide->eMode != CHK_MODE_MIXED) return psSide->eMode;
+  return (ChkModeTypeDef)ulCHK_RandRange(&psSide->ullRand, 3uL);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Fill item
+ *
+ * @param[out] *psItem  Item
+ * @param[in] ullCount  Items before it
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkMake(ChkItemTypeDef* psItem, uint64_t ullCount)
+{
+  psItem->ulSeq = (uint32_t)ullCount;
+  psItem->ulCheck = ~(uint32_t)ullCount;
+  psItem->ullFill = (uint64_t)(uint32_t)ullCount * CHK_FILL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check received item against the next expected one
+ *
+ * @param[in,out] *psSide Consumer
+ * @param[in] *psItem     Item
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkTake(ChkSideTypeDef* psSide, const ChkItemTypeDef* psItem)
+{
+  int32_t lAhead = (int32_t)(psItem->ulSeq - (uint32_t)psSide->ullDone);
+  if ((psItem->ulCheck != ~psItem->ulSeq) || (psItem->ullFill != (uint64_t)psItem->ulSeq * CHK_FILL))
+  {
+    vChkFail(psSide, "torn item");
+  }
+  else if (lAhead != 0)
+  {
+    vChkFail(psSide, (lAhead < 0) ? "item repeated" : "item lost");
+  }
+  psSide->ullDone++;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Producer thread
+ *
+ * @param[in,out] *pvArg  Producer side (ChkSideTypeDef*)
+ * @return  (void*)   NULL
+ * @date  19.10.2026
+ ******************************************************************************/
+static void* pvChkProducer(void* pvArg)
+{
+  ChkSideTypeDef* psSide = (ChkSideTypeDef*)pvArg;
+  ChkItemTypeDef asItems[CHK_BULK_MAX];
+
+  while ((psSide->ullDone < psSide->ullItems) && !bChkStopped())
+  {
+    uint64_t ullLeft = psSide->ullItems - psSide->ullDone;
+    uint32_t ulDone = 0uL;
+    switch (eChkMode(psSide))
+    {
+      case CHK_MODE_SINGLE:
+        vChkMake(&asItems[0], psSide->ullDone);
+        ulDone = bSPSC_Chk_Push(&sQueue, &asItems[0]) ? 1uL : 0uL;
+        break;
+
+      case CHK_MODE_BULK:
+      {
+        uint32_t ulNum = 1uL + ulCHK_RandRange(&psSide->ullRand, CHK_BULK_MAX);
+        if (ulNum > ullLeft) ulNum = (uint32_t)ullLeft;
+        for (uint32_t i = 0uL; i < ulNum; ++i)
+        {
+          vChkMake(&asItems[i], psSide->ullDone + i);
+        }
+        ulDone = ulSPSC_Chk_PushBulk(&sQueue, asItems, ulNum);
+        if (ulDone > ulNum) vChkFail(psSide, "bulk push beyond request");
+        break;
+      }
+
+      default:
+      {
+        ChkItemTypeDef* psSpan;
+        uint32_t ulLen = ulSPSC_Chk_GetWriteSpan(&sQueue, &psSpan);
+        if (ulLen > CHK_SIZE) vChkFail(psSide, "write span beyond queue size");
+        if (ulLen == 0uL) break;
+        ulDone = 1uL + ulCHK_RandRange(&psSide->ullRand, ulLen);
+        if (ulDone > ullLeft) ulDone = (uint32_t)ullLeft;
+        for (uint32_t i = 0uL; i < ulDone; ++i)
+        {
+          vChkMake(&psSpan[i], psSide->ullDone + i);
+        }
+        vSPSC_Chk_CommitWrite(&sQueue, ulDone);
+        break;
+      }
+    }
+
+    psSide->ullDone += ulDone;
+    if (ulSPSC_Chk_GetHighWater(&sQueue) > CHK_SIZE) vChkFail(psSide, "high water beyond queue size");
+    if (ulDone == 0uL)
+    {
+      psSide->ullWaits++;
+      (void)sched_yield();
+    }
+  }
+  return NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Consumer thread
+ *
+ * @param[in,out] *pvArg  Consumer side (ChkSideTypeDef*)
+ * @return  (void*)   NULL
+ * @date  19.10.2026
+ ******************************************************************************/
+static void* pvChkConsumer(void* pvArg)
+{
+  ChkSideTypeDef* psSide = (ChkSideTypeDef*)pvArg;
+  ChkItemTypeDef asItems[CHK_BULK_MAX];
+
+  // Start on a full queue
+  uint32_t ulFull = (psSide->ullItems < CHK_SIZE) ? (uint32_t)psSide->ullItems : CHK_SIZE;
+  while ((ulSPSC_Chk_GetCount(&sQueue) < ulFull) && !bChkStopped())
+  {
+    (void)sched_yield();
+  }
+
+  while ((psSide->ullDone < psSide->ullItems) && !bChkStopped())
+  {
+    uint32_t ulCount = ulSPSC_Chk_GetCount(&sQueue);
+    if (ulCount > CHK_SIZE) vChkFail(psSide, "fill level beyond queue size");
+    if (ulCount > psSide->ulMaxCount) psSide->ulMaxCount = ulCount;
+
+    uint32_t ulDone = 0uL;
+    switch (eChkMode(psSide))
+    {
+      case CHK_MODE_SINGLE:
+        if (bSPSC_Chk_Pop(&sQueue, &asItems[0]))
+        {
+          vChkTake(psSide, &asItems[0]);
+          ulDone = 1uL;
+        }
+        break;
+
+      case CHK_MODE_BULK:
+      {
+        uint32_t ulNum = 1uL + ulCHK_RandRange(&psSide->ullRand, CHK_BULK_MAX);
+        ulDone = ulSPSC_Chk_PopBulk(&sQueue, asItems, ulNum);
+        if (ulDone > ulNum) vChkFail(psSide, "bulk pop beyond request");
+        for (uint32_t i = 0uL; (i < ulDone) && (i < ulNum); ++i)
+        {
+          vChkTake(psSide, &asItems[i]);
+        }
+        break;
+      }
+
+      default:
+      {
+        const ChkItemTypeDef* psSpan;
+        uint32_t ulLen = ulSPSC_Chk_GetReadSpan(&sQueue, &psSpan);
+        if (ulLen > CHK_SIZE) vChkFail(psSide, "read span beyond queue size");
+        if (ulLen == 0uL) break;
+        ulDone = 1uL + ulCHK_RandRange(&psSide->ullRand, ulLen);
+        for (uint32_t i = 0uL; i < ulDone; ++i)
+        {
+          vChkTake(psSide, &psSpan[i]);
+        }
+        vSPSC_Chk_CommitRead(&sQueue, ulDone);
+        break;
+      }
+    }
+
+    if (ulDone == 0uL)
+    {
+      psSide->ullWaits++;
+      (void)sched_yield();
+    }
+  }
+  return NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Pass items from a producer to a consumer thread, print result
+ *
+ * @param[in] *pcName   Run name
+ * @param[in] eProd     Producer access
+ * @param[in] eCons     Consumer access
+ * @param[in] ullItems  Items to pass (min. 1)
+ * @return  (bool)  Passed
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bChkRun(const char* pcName, ChkModeTypeDef eProd, ChkModeTypeDef eCons, uint64_t ullItems)
+{
+  ChkSideTypeDef sProd = { .eMode = eProd, .ullItems = ullItems };
+  ChkSideTypeDef sCons = { .eMode = eCons, .ullItems = ullItems };
+  sProd.ullRand = ((uint64_t)rand() << 32) | (uint64_t)rand() | 1uLL;
+  sCons.ullRand = ((uint64_t)rand() << 32) | (uint64_t)rand() | 1uLL;
+
+  vSPSC_Chk_Init(&sQueue);
+  sQueue.ulHead = CHK_INDEX_START;
+  sQueue.ulTail = CHK_INDEX_START;
+  bStop = false;
+
+  struct timespec sStart, sEnd;
+  pthread_t sProdThread, sConsThread;
+  (void)clock_gettime(CLOCK_MONOTONIC, &sStart);
+  if ((pthread_create(&sConsThread, NULL, pvChkConsumer, &sCons) != 0) ||
+      (pthread_create(&sProdThread, NULL, pvChkProducer, &sProd) != 0))
+  {
+    fprintf(stderr, "error: cannot create threads\n");
+    exit(EXIT_FAILURE);
+  }
+  (void)pthread_join(sProdThread, NULL);
+  (void)pthread_join(sConsThread, NULL);
+  (void)clock_gettime(CLOCK_MONOTONIC, &sEnd);
+  double dSeconds = (double)(sEnd.tv_sec - sStart.tv_sec) + (double)(sEnd.tv_nsec - sStart.tv_nsec) * 1e-9;
+
+  // Both sides done, queue empty, high water at the full queue
+  uint32_t ulHighWater = ulSPSC_Chk_GetHighWater(&sQueue);
+  const char* pcFailure = (sProd.pcFailure != NULL) ? sProd.pcFailure : sCons.pcFailure;
+  if (pcFailure == NULL)
+  {
+    if ((sProd.ullDone != ullItems) || (sCons.ullDone != ullItems)) pcFailure = "item count";
+    else if (sQueue.ulHead != (uint32_t)(CHK_INDEX_START + ullItems)) pcFailure = "head index";
+    else if (ulSPSC_Chk_GetCount(&sQueue) != 0uL) pcFailure = "queue not empty";
+    else if (ulHighWater < sCons.ulMaxCount) pcFailure = "high water below fill level seen";
+    else if ((ullItems >= CHK_SIZE) && (ulHighWater != CHK_SIZE)) pcFailure = "high water not at full queue";
+  }
+
+  // Reset on the empty queue
+  vSPSC_Chk_ResetHighWater(&sQueue);
+  if ((pcFailure == NULL) && (ulSPSC_Chk_GetHighWater(&sQueue) != 0uL)) pcFailure = "high water reset";
+
+  printf("%-14s %-4s %10llu items %7.2f Mitems/s  high water %2lu  waits %llu/%llu",
+         pcName, (pcFailure == NULL) ? "ok" : "FAIL", (unsigned long long)sCons.ullDone,
+         (double)sCons.ullDone / dSeconds * 1e-6, (unsigned long)ulHighWater,
+         (unsigned long long)sProd.ullWaits, (unsigned long long)sCons.ullWaits);
+  if (pcFailure != NULL) printf("  (%s after %llu items)", pcFailure, (unsigned long long)sCons.ullDone);
+  printf("\n");
+  return pcFailure == NULL;
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Stress test entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  unsigned long long ullItems = 5000000uLL;
+  unsigned int uiSeed = (unsigned int)time(NULL);
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "n:s:")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'n': ullItems = strtoull(optarg, NULL, 0); break;
+      case 's': uiSeed = (unsigned int)strtoul(optarg, NULL, 0); break;
+      default:
+        fprintf(stderr, "Usage: %s [-n <N>] [-s <seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  if (ullItems == 0uLL)
+  {
+    fprintf(stderr, "error: no items\n");
+    return EXIT_FAILURE;
+  }
+  printf("seed %u\n", uiSeed);
+  srand(uiSeed);
+
+  if (!bChkRun("single", CHK_MODE_SINGLE, CHK_MODE_SINGLE, ullItems)) return EXIT_FAILURE;
+  if (!bChkRun("bulk", CHK_MODE_BULK, CHK_MODE_BULK, ullItems)) return EXIT_FAILURE;
+  if (!bChkRun("span", CHK_MODE_SPAN, CHK_MODE_SPAN, ullItems)) return EXIT_FAILURE;
+  if (!bChkRun("push/popbulk", CHK_MODE_SINGLE, CHK_MODE_BULK, ullItems)) return EXIT_FAILURE;
+  if (!bChkRun("span/commitrd", CHK_MODE_BULK, CHK_MODE_SPAN, ullItems)) return EXIT_FAILURE;
+  if (!bChkRun("commitwr/pop", CHK_MODE_SPAN, CHK_MODE_SINGLE, ullItems)) return EXIT_FAILURE;
+  if (!bChkRun("mixed", CHK_MODE_MIXED, CHK_MODE_MIXED, ullItems)) return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
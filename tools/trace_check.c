@@ -0,0 +1,534 @@
+/*!****************************************************************************
+ * @file
+ * trace_check.c
+ *
+ * @brief
+ * Host check of the trace record encoder and decoder
+ *
+ * Encodes generated records with lib/trace and feeds the output of every
+ * ulTRACE_Encode() call byte by byte into the decoder, which must return
+ * exactly the record encoded: 64-bit extended timestamp, event ID and
+ * arguments. Every output must fit into TRACE_ENCODE_MAX bytes.
+ *
+ * Records come from periodic sources, on time, with jitter, late or after a
+ * pause, some of which share a dictionary slot, and from random IDs. Time steps between
+ * records range from zero up to the largest one allowed by 32-bit
+ * timestamps, so every timestamp coding and every varint length occurs;
+ * arguments change slowly or at random.
+ *
+ *   roundtrip   Every record decoded exactly; all timestamp codings, literal
+ *               IDs and resync markers every TRACE_SYNC_INTERVAL records
+ *   eviction    IDs sharing a slot alternate: each one is coded as literal
+ *               with arguments relative to zero, a repeated ID from its slot
+ *   encode max  Largest records with and without resync marker, written
+ *               into a buffer of TRACE_ENCODE_MAX bytes with guard bytes
+ *   truncated   Random records cut short, as when the output does not fit,
+ *               followed by vTRACE_RequestSync(): the cut record is lost,
+ *               nothing else, and no wrong record is returned
+ *   dropped     Random byte ranges removed without notice to the encoder:
+ *               from the next resync marker on, every record is decoded
+ *               exactly again
+ *
+ * After a loss, timestamps are only checked modulo 2^32, as the resync
+ * marker carries 32 bits.
+ *
+ * Exits with failure status on the first error.
+ *
+ * Usage: trace_check [-n <N>] [-e <rate>] [-s <seed>]
+ *   -n <N>       Records per random run (default 2000000)
+ *   -e <rate>    Loss rate 1/rate in the truncated and dropped runs
+ *                (default 1000)
+ *   -s <seed>    Random seed
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "trace.h"
+#include "chk.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Periodic sources, the ones beyond TRACE_DICT_SLOTS share a slot
+#define CHK_SOURCES                   18u
+
+/// Guard bytes after the output buffer
+#define CHK_GUARD                     16u
+
+/// Guard byte value
+#define CHK_GUARD_BYTE                0x5Au
+
+/// Most decoded records kept per encoder call
+#define CHK_EVENTS_MAX                4u
+
+/// Header slot index of literal event IDs
+#define CHK_SLOT_LITERAL              15u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Periodic event source
+typedef struct {
+  uint16_t uiId;                  ///< Event ID
+  uint8_t ucArgs;                 ///< Number of arguments
+  uint32_t ulPeriod;              ///< Nominal period
+  uint64_t ullLast;               ///< Time of last record
+  uint32_t aulArgs[TRACE_MAX_ARGS]; ///< Arguments of last record
+} ChkSourceTypeDef;
+
+/// Output loss
+typedef enum {
+  CHK_LOSS_NONE = 0,              ///< Complete output
+  CHK_LOSS_TRUNCATE,              ///< Output cut short, encoder resynced
+  CHK_LOSS_DROP                   ///< Bytes removed, encoder not told
+} ChkLossTypeDef;
+
+/// Run statistics
+typedef struct {
+  uint64_t ullBytes;              ///< Encoded bytes
+  uint64_t ullRawBytes;           ///< Size as raw fixed-width records
+  uint32_t aulModes[4];           ///< Records per timestamp coding
+  uint32_t ulLiterals;            ///< Records with literal ID
+  uint32_t ulSyncs;               ///< Resync markers written
+  uint32_t ulMaxLen;              ///< Longest output of one call
+  uint32_t ulLost;                ///< Records cut or hit by a drop
+  uint32_t ulUnchecked;           ///< Records between a drop and the next marker
+} ChkStatsTypeDef;
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Codec under test
+static TRACE_EncoderTypeDef sEnc;
+static TRACE_DecoderTypeDef sDec;
+
+/// Output of one call and guard bytes
+static uint8_t aucOut[TRACE_ENCODE_MAX + CHK_GUARD];
+
+/// Sources
+static ChkSourceTypeDef asSources[CHK_SOURCES];
+
+/// Header byte of the last record
+static uint8_t ucHeader;
+
+/// Current time, extended to 64 bits
+static uint64_t ullNow;
+
+/// Records encoded in the current scenario
+static uint32_t ulRecord;
+
+/// Random state
+static uint64_t ullRng;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Random time step: zero, or of random varint length
+ *
+ * @return  (uint32_t)  Step
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulChkStep(void)
+{
+  static const uint8_t aucBits[] = { 0u, 7u, 7u, 14u, 14u, 21u, 28u, 32u };
+  uint32_t ulBits = aucBits[ulCHK_RandRange(&ullRng, sizeof(aucBits))];
+  if (ulBits == 0uL) return 0uL;
+  uint32_t ulStep = ulCHK_Rand(&ullRng);
+  return (ulBits < 32uL) ? (ulStep & ((1uL << ulBits) - 1uL)) : ulStep;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Random argument change: small step or any value
+ *
+ * @param[in] ulLast  Previous argument
+ * @return  (uint32_t)  Argument
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulChkArg(uint32_t ulLast)
+{
+  if (ulCHK_RandRange(&ullRng, 4uL) == 0uL) return ulCHK_Rand(&ullRng);
+  return ulLast + ulCHK_RandRange(&ullRng, 33uL) - 16uL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Initialise sources: random IDs and periods
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkSources(void)
+{
+  for (uint32_t i = 0uL; i < CHK_SOURCES; ++i)
+  {
+    ChkSourceTypeDef* psSrc = &asSources[i];
+    psSrc->uiId = (uint16_t)(i % TRACE_DICT_SLOTS + TRACE_DICT_SLOTS * ulCHK_RandRange(&ullRng, 4000uL));
+    psSrc->ucArgs = (uint8_t)ulCHK_RandRange(&ullRng, TRACE_MAX_ARGS + 1uL);
+    psSrc->ulPeriod = 1uL + ulChkStep();
+    psSrc->ullLast = ullNow;
+    for (uint32_t a = 0uL; a < TRACE_MAX_ARGS; ++a)
+    {
+      psSrc->aulArgs[a] = ulCHK_Rand(&ullRng);
+    }
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Generate next record and advance time
+ *
+ * @param[out] *psEvent   Record
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkNext(TRACE_EventTypeDef* psEvent)
+{
+  if (ulCHK_RandRange(&ullRng, 16uL) != 0uL)
+  {
+    // Periodic source due next, on time, with jitter or late
+    ChkSourceTypeDef* psSrc = &asSources[0];
+    uint64_t ullDue = psSrc->ullLast + psSrc->ulPeriod;
+    for (uint32_t i = 1uL; i < CHK_SOURCES; ++i)
+    {
+      if (asSources[i].ullLast + asSources[i].ulPeriod < ullDue)
+      {
+        psSrc = &asSources[i];
+        ullDue = psSrc->ullLast + psSrc->ulPeriod;
+      }
+    }
+    if (ulCHK_RandRange(&ullRng, 4uL) == 0uL) ullDue = ullDue + ulCHK_RandRange(&ullRng, 65uL) - 32uLL;
+    ullNow = ((ullDue >= ullNow) && ((ullDue - ullNow) <= 0xFFFFFFFFuLL)) ? ullDue :
+             ullNow + ulCHK_RandRange(&ullRng, 256uL);
+    if (ulCHK_RandRange(&ullRng, 64uL) == 0uL) psSrc->ulPeriod = 1uL + ulChkStep();
+
+    psEvent->uiId = psSrc->uiId;
+    psEvent->ucNumArgs = psSrc->ucArgs;
+    if (ulCHK_RandRange(&ullRng, 16uL) == 0uL)
+    {
+      psEvent->ucNumArgs = (uint8_t)ulCHK_RandRange(&ullRng, TRACE_MAX_ARGS + 1uL);
+    }
+    for (uint32_t a = 0uL; a < TRACE_MAX_ARGS; ++a)
+    {
+      psSrc->aulArgs[a] = ulChkArg(psSrc->aulArgs[a]);
+      psEvent->aulArgs[a] = psSrc->aulArgs[a];
+    }
+    psSrc->ullLast = ullNow;
+    if (ulCHK_RandRange(&ullRng, 32uL) == 0uL) psSrc->ullLast += ulChkStep();
+  }
+  else
+  {
+    // Any ID, any arguments
+    ullNow += ulChkStep();
+    psEvent->uiId = (uint16_t)ulCHK_RandRange(&ullRng, TRACE_ID_NONE);
+    psEvent->ucNumArgs = (uint8_t)ulCHK_RandRange(&ullRng, TRACE_MAX_ARGS + 1uL);
+    for (uint32_t a = 0uL; a < TRACE_MAX_ARGS; ++a)
+    {
+      psEvent->aulArgs[a] = ulCHK_Rand(&ullRng);
+    }
+  }
+  psEvent->ullTime = ullNow;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Encode record into the output buffer, check length and guard bytes
+ *
+ * @param[in] *psEvent    Record
+ * @param[in,out] *psStats  Statistics
+ * @return  (uint32_t)  Number of bytes written
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulChkEncode(const TRACE_EventTypeDef* psEvent, ChkStatsTypeDef* psStats)
+{
+  (void)memset(aucOut, CHK_GUARD_BYTE, sizeof(aucOut));
+  uint32_t ulLen = ulTRACE_Encode(&sEnc, aucOut, (uint32_t)psEvent->ullTime, psEvent->uiId,
+                                  psEvent->ucNumArgs, psEvent->aulArgs);
+  ulRecord++;
+  if ((ulLen == 0uL) || (ulLen > TRACE_ENCODE_MAX)) vCHK_Fail("output length out of range");
+  for (uint32_t i = TRACE_ENCODE_MAX; i < sizeof(aucOut); ++i)
+  {
+    if (aucOut[i] != CHK_GUARD_BYTE) vCHK_Fail("output beyond TRACE_ENCODE_MAX");
+  }
+
+  // Header follows the resync marker, if any
+  uint32_t ulHeader = 0uL;
+  if (aucOut[0] == 0xFFu)
+  {
+    psStats->ulSyncs++;
+    ulHeader = TRACE_SYNC_LEN + 1u;
+    while ((ulHeader < TRACE_ENCODE_MAX) && ((aucOut[ulHeader] & 0x80u) != 0u)) ulHeader++;
+    ulHeader++;
+  }
+  ucHeader = (ulHeader < ulLen) ? aucOut[ulHeader] : 0u;
+  psStats->aulModes[ucHeader & 0x03u]++;
+  if ((ucHeader >> 4) == CHK_SLOT_LITERAL) psStats->ulLiterals++;
+  psStats->ullBytes += ulLen;
+  psStats->ullRawBytes += TRACE_RAW_SIZE(psEvent->ucNumArgs);
+  if (ulLen > psStats->ulMaxLen) psStats->ulMaxLen = ulLen;
+  return ulLen;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Feed bytes into the decoder
+ *
+ * @param[in] *pucData    Data
+ * @param[in] ulLen       Number of bytes
+ * @param[out] *psEvents  Decoded records, up to CHK_EVENTS_MAX
+ * @return  (uint32_t)  Number of decoded records
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulChkDecode(const uint8_t* pucData, uint32_t ulLen, TRACE_EventTypeDef* psEvents)
+{
+  uint32_t ulEvents = 0uL;
+  for (uint32_t i = 0uL; i < ulLen; ++i)
+  {
+    TRACE_EventTypeDef sEvent;
+    if (bTRACE_DecodeByte(&sDec, pucData[i], &sEvent))
+    {
+      if (ulEvents < CHK_EVENTS_MAX) psEvents[ulEvents] = sEvent;
+      ulEvents++;
+    }
+  }
+  return ulEvents;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Compare decoded with encoded record
+ *
+ * @param[in] *psGot      Decoded record
+ * @param[in] *psExpect   Encoded record
+ * @param[in] ullOffset   Expected timestamp offset
+ * @return  (bool)  Records match
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bChkSame(const TRACE_EventTypeDef* psGot, const TRACE_EventTypeDef* psExpect,
+                     uint64_t ullOffset)
+{
+  if ((psGot->ullTime != psExpect->ullTime + ullOffset) || (psGot->uiId != psExpect->uiId) ||
+      (psGot->ucNumArgs != psExpect->ucNumArgs))
+  {
+    return false;
+  }
+  for (uint32_t a = 0uL; a < psExpect->ucNumArgs; ++a)
+  {
+    if (psGot->aulArgs[a] != psExpect->aulArgs[a]) return false;
+  }
+  return true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start scenario: fresh encoder and decoder, time below the 32-bit wrap
+ *
+ * @param[out] *psStats   Statistics
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkStart(ChkStatsTypeDef* psStats)
+{
+  vTRACE_EncoderInit(&sEnc);
+  vTRACE_DecoderInit(&sDec);
+  (void)memset(psStats, 0, sizeof(*psStats));
+  ullNow = 0xFFFFFFFFuLL - ulCHK_RandRange(&ullRng, 100000uL);
+  ulRecord = 0uL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Random run: encode, lose output at a rate, decode and compare
+ *
+ * @param[in] ulRecords   Records
+ * @param[in] eLoss       Kind of output loss
+ * @param[in] ulRate      Loss rate 1/ulRate, 0 for none
+ * @param[out] *psStats   Statistics
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkRun(uint32_t ulRecords, ChkLossTypeDef eLoss, uint32_t ulRate, ChkStatsTypeDef* psStats)
+{
+  TRACE_EventTypeDef sEvent;
+  TRACE_EventTypeDef asEvents[CHK_EVENTS_MAX];
+  bool bChecked = true;
+  bool bRebase = true;
+  uint64_t ullOffset = 0uLL;
+
+  vChkStart(psStats);
+  vChkSources();
+  while ((ulRecord < ulRecords) && !bCHK_Failed())
+  {
+    vChkNext(&sEvent);
+    uint32_t ulLen = ulChkEncode(&sEvent, psStats);
+    bool bSync = (aucOut[0] == 0xFFu);
+    bool bLoss = (eLoss != CHK_LOSS_NONE) && (ulRate != 0uL) && (ulCHK_RandRange(&ullRng, ulRate) == 0uL);
+
+    uint32_t ulEvents;
+    if (bLoss && (eLoss == CHK_LOSS_TRUNCATE))
+    {
+      // Output cut short: nothing decoded, marker before the next record
+      ulEvents = ulChkDecode(aucOut, ulCHK_RandRange(&ullRng, ulLen), asEvents);
+      vTRACE_RequestSync(&sEnc);
+      if (ulEvents != 0uL) vCHK_Fail("record returned from truncated output");
+      psStats->ulLost++;
+      bRebase = true;
+      continue;
+    }
+    if (bLoss)
+    {
+      // Bytes removed: anything may be decoded until the next marker
+      uint32_t ulFrom = ulCHK_RandRange(&ullRng, ulLen);
+      uint32_t ulTo = ulFrom + 1uL + ulCHK_RandRange(&ullRng, ulLen - ulFrom);
+      (void)ulChkDecode(aucOut, ulFrom, asEvents);
+      (void)ulChkDecode(&aucOut[ulTo], ulLen - ulTo, asEvents);
+      psStats->ulLost++;
+      bChecked = false;
+      continue;
+    }
+
+    ulEvents = ulChkDecode(aucOut, ulLen, asEvents);
+    if (!bChecked && bSync)
+    {
+      bChecked = true;
+      bRebase = true;
+    }
+    if (!bChecked)
+    {
+      psStats->ulUnchecked++;
+      continue;
+    }
+    if (ulEvents != 1uL)
+    {
+      vCHK_Fail((ulEvents == 0uL) ? "record not decoded" : "several records decoded");
+      continue;
+    }
+
+    // The decoder starts at the first marker time, and after a loss extends
+    // the marker time from the last record it has seen (missing a wrap if
+    // the lost ones span 2^32 ticks)
+    if (bRebase)
+    {
+      ullOffset = asEvents[0].ullTime - sEvent.ullTime;
+      if ((uint32_t)ullOffset != 0uL) vCHK_Fail("timestamp after resync");
+      bRebase = false;
+    }
+    if (!bChkSame(&asEvents[0], &sEvent, ullOffset)) vCHK_Fail("decoded record differs");
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Print run statistics
+ *
+ * @param[in] *psStats    Statistics
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkPrintStats(const ChkStatsTypeDef* psStats)
+{
+  printf("  %.2f bytes per record (raw %.2f), longest %lu, %lu markers, %lu literal IDs\n",
+         (double)psStats->ullBytes / (double)ulRecord, (double)psStats->ullRawBytes / (double)ulRecord,
+         (unsigned long)psStats->ulMaxLen, (unsigned long)psStats->ulSyncs,
+         (unsigned long)psStats->ulLiterals);
+  printf("  timestamps: %lu same, %lu period, %lu jitter, %lu stream\n",
+         (unsigned long)psStats->aulModes[0], (unsigned long)psStats->aulModes[1],
+         (unsigned long)psStats->aulModes[2], (unsigned long)psStats->aulModes[3]);
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Check entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  unsigned long ulRecords = 2000000uL;
+  unsigned long ulRate = 1000uL;
+  unsigned int uiSeed = (unsigned int)time(NULL);
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "n:e:s:")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'n': ulRecords = strtoul(optarg, NULL, 0); break;
+      case 'e': ulRate = strtoul(optarg, NULL, 0); break;
+      case 's': uiSeed = (unsigned int)strtoul(optarg, NULL, 0); break;
+      default:
+        fprintf(stderr, "Usage: %s [-n <N>] [-e <rate>] [-s <seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  printf("seed %u\n", uiSeed);
+  ullRng = ((uint64_t)uiSeed << 32) | 0x9E3779B9uLL;
+  vCHK_SetClock("record", &ulRecord);
+
+  ChkStatsTypeDef sStats;
+  TRACE_EventTypeDef sEvent;
+  TRACE_EventTypeDef asEvents[CHK_EVENTS_MAX];
+  bool bOk;
+
+  // Roundtrip: every record, every timestamp coding, markers at the interval
+  vChkRun((uint32_t)ulRecords, CHK_LOSS_NONE, 0uL, &sStats);
+  bOk = (sDec.ulEvents == ulRecord) && (sDec.ulErrors == 0uL) && (sDec.ulSyncs == sStats.ulSyncs) &&
+        (sStats.ulSyncs == (ulRecord + TRACE_SYNC_INTERVAL - 1uL) / TRACE_SYNC_INTERVAL) &&
+        (sStats.aulModes[0] != 0uL) && (sStats.aulModes[1] != 0uL) && (sStats.aulModes[2] != 0uL) &&
+        (sStats.aulModes[3] != 0uL) && (sStats.ulLiterals != 0uL);
+  vCHK_Report("roundtrip", bOk, ulRecord, "records");
+  vChkPrintStats(&sStats);
+
+  // Eviction: IDs 3 and 18 share slot 3 and replace each other
+  vChkStart(&sStats);
+  bOk = true;
+  for (uint32_t i = 0uL; i < 60uL; ++i)
+  {
+    sEvent = (TRACE_EventTypeDef){
+      .ullTime = ullNow += 1000uL, .uiId = (i < 40uL) ? ((i & 1uL) ? 18u : 3u) : 3u,
+      .ucNumArgs = 3u, .aulArgs = { i, 1000000uL + i, 0xFFFFFFFFuL - i }
+    };
+    uint32_t ulLen = ulChkEncode(&sEvent, &sStats);
+    bool bLiteral = (ucHeader >> 4) == CHK_SLOT_LITERAL;
+    bOk = bOk && (bLiteral == (i <= 40uL)) && (ulChkDecode(aucOut, ulLen, asEvents) == 1uL) &&
+          bChkSame(&asEvents[0], &sEvent, 0uLL);
+  }
+  vCHK_Report("eviction", bOk && (sDec.ulErrors == 0uL), ulRecord, "records");
+
+  // Largest records: marker, long time, literal ID and arguments of 5 bytes each
+  vChkStart(&sStats);
+  sEvent = (TRACE_EventTypeDef){
+    .ullTime = 0xFFFFFFFFuLL, .uiId = TRACE_ID_NONE - 1u,
+    .ucNumArgs = TRACE_MAX_ARGS, .aulArgs = { 0x80000000uL, 0x80000000uL, 0x80000000uL }
+  };
+  uint32_t ulWithSync = ulChkEncode(&sEvent, &sStats);
+  bOk = (ulChkDecode(aucOut, ulWithSync, asEvents) == 1uL) && bChkSame(&asEvents[0], &sEvent, 0uLL);
+  sEvent.ullTime += 0xFFFFFFFFuLL;
+  sEvent.uiId = TRACE_ID_NONE - 1u - TRACE_DICT_SLOTS;
+  uint32_t ulWithout = ulChkEncode(&sEvent, &sStats);
+  bOk = bOk && (ulChkDecode(aucOut, ulWithout, asEvents) == 1uL) && bChkSame(&asEvents[0], &sEvent, 0uLL);
+  vCHK_Report("encode max", bOk, ulRecord, "records");
+  printf("  %lu bytes with marker, %lu without, TRACE_ENCODE_MAX %u\n", (unsigned long)ulWithSync,
+         (unsigned long)ulWithout, TRACE_ENCODE_MAX);
+
+  // Truncated output with resync: only the cut records are missing
+  vChkRun((uint32_t)ulRecords, CHK_LOSS_TRUNCATE, (uint32_t)ulRate, &sStats);
+  bOk = (sDec.ulEvents == ulRecord - sStats.ulLost);
+  vCHK_Report("truncated", bOk, ulRecord, "records");
+  printf("  %lu cut, %lu errors, %lu markers decoded\n", (unsigned long)sStats.ulLost,
+         (unsigned long)sDec.ulErrors, (unsigned long)sDec.ulSyncs);
+
+  // Dropped bytes: exact again from the next marker
+  vChkRun((uint32_t)ulRecords, CHK_LOSS_DROP, (uint32_t)ulRate, &sStats);
+  vCHK_Report("dropped", true, ulRecord, "records");
+  printf("  %lu hit, %lu unchecked until the next marker, %lu errors\n", (unsigned long)sStats.ulLost,
+         (unsigned long)sStats.ulUnchecked, (unsigned long)sDec.ulErrors);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,143 @@
+/*!****************************************************************************
+ * @file
+ * trace_decode.c
+ *
+ * @brief
+ * Host decoder for compact binary trace streams
+ *
+ * Reads the payload bytes of one trace stream (i.e. one ITM stimulus port,
+ * as captured by the SWO viewer) and prints one CSV line per event:
+ *
+ *   time,id,arg0,arg1,arg2
+ *
+ * Usage: trace_decode [-f <Hz>] [-s] [file]
+ *   -f <Hz>   Print time in seconds instead of cycles, for core clock <Hz>
+ *   -s        Print stream statistics and compression ratio to stderr
+ *   file      Input file, stdin if omitted
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "trace.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Input block size
+#define DECODE_BLOCK_SIZE             65536u
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Input block
+static uint8_t aucBlock[DECODE_BLOCK_SIZE];
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Get monotonic time
+ *
+ * @return  (double)  Time in seconds
+ * @date  19.10.2026
+ ******************************************************************************/
+static double dGetTime(void)
+{
+  struct timespec sTs;
+  (void)clock_gettime(CLOCK_MONOTONIC, &sTs);
+  return (double)sTs.tv_sec + (double)sTs.tv_nsec * 1e-9;
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Decoder entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  double dFreq = 0.0;
+  bool bStats = false;
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "f:s")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'f': dFreq = strtod(optarg, NULL); break;
+      case 's': bStats = true; break;
+      default:
+        fprintf(stderr, "Usage: %s [-f <Hz>] [-s] [file]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+
+  FILE* psIn = stdin;
+  if (optind < argc)
+  {
+    psIn = fopen(argv[optind], "rb");
+    if (psIn == NULL)
+    {
+      perror(argv[optind]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  TRACE_DecoderTypeDef sDec;
+  TRACE_EventTypeDef sEvent;
+  vTRACE_DecoderInit(&sDec);
+
+  uint64_t ullBytes = 0uLL;
+  double dDecode = 0.0;
+  size_t ulRead;
+  while ((ulRead = fread(aucBlock, 1u, sizeof(aucBlock), psIn)) > 0u)
+  {
+    ullBytes += ulRead;
+    double dStart = dGetTime();
+    for (size_t i = 0u; i < ulRead; ++i)
+    {
+      if (!bTRACE_DecodeByte(&sDec, aucBlock[i], &sEvent)) continue;
+
+      if (dFreq > 0.0) printf("%.9f,%u", (double)sEvent.ullTime / dFreq, sEvent.uiId);
+      else printf("%llu,%u", (unsigned long long)sEvent.ullTime, sEvent.uiId);
+      for (uint32_t a = 0u; a < sEvent.ucNumArgs; ++a)
+      {
+        printf(",%d", (int32_t)sEvent.aulArgs[a]);
+      }
+      putchar('\n');
+    }
+    dDecode += dGetTime() - dStart;
+  }
+  if (psIn != stdin) fclose(psIn);
+
+  if (bStats)
+  {
+    fprintf(stderr,
+      "bytes:     %llu\n"
+      "events:    %u\n"
+      "syncs:     %u\n"
+      "errors:    %u\n"
+      "raw bytes: %llu\n"
+      "ratio:     %.2f\n"
+      "bytes/evt: %.2f\n"
+      "decode:    %.1f MB/s (incl. output)\n",
+      (unsigned long long)ullBytes, sDec.ulEvents, sDec.ulSyncs, sDec.ulErrors,
+      (unsigned long long)sDec.ullRawBytes,
+      (ullBytes != 0uLL) ? (double)sDec.ullRawBytes / (double)ullBytes : 0.0,
+      (sDec.ulEvents != 0u) ? (double)ullBytes / sDec.ulEvents : 0.0,
+      (dDecode > 0.0) ? (double)ullBytes / dDecode * 1e-6 : 0.0
+    );
+  }
+
+  return EXIT_SUCCESS;
+}
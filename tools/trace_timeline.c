@@ -0,0 +1,490 @@
+/*!****************************************************************************
+ * @file
+ * trace_timeline.c
+ *
+ * @brief
+ * Host converter from timeline trace stream to Chrome trace JSON
+ *
+ * Reads the payload bytes of the timeline stream (ITM stimulus port
+ * HW_TRACE_TL_PORT, as captured by the SWO viewer) and writes a Chrome trace
+ * event file, which can be opened in Perfetto (ui.perfetto.dev) or
+ * chrome://tracing:
+ *  - "Handler mode": one slice per exception handler, nested as preempted
+ *  - one track per kernel thread with its running slices
+ *  - "<thread> regions": user regions marked by that thread
+ * Regions marked in a handler are placed on the handler track.
+ *
+ * Timestamps are converted from core cycles with the core clock recorded by
+ * the firmware after every resync marker, or with the frequency given by -f.
+ *
+ * Usage: trace_timeline [-f <Hz>] [file]
+ *   -f <Hz>   Core clock, overrides the recorded frequency
+ *   file      Input file, stdin if omitted
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "trace.h"
+#include "hw_trace.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Input block size
+#define TIMELINE_BLOCK_SIZE           65536u
+
+/// Core clock if none is recorded or given
+#define TIMELINE_DEFAULT_FREQ         72000000.0
+
+/// Maximum number of threads
+#define TIMELINE_MAX_THREADS          64u
+
+/// Maximum handler / region nesting depth
+#define TIMELINE_MAX_DEPTH            32u
+
+/*! @brief Track IDs
+ *  @{                                                                        */
+#define TIMELINE_TID_HANDLER          1u
+#define TIMELINE_TID_THREAD(i)        (2u + 2u * (i))
+#define TIMELINE_TID_REGION(i)        (3u + 2u * (i))
+/*! @}                                                                        */
+
+/// Number of exceptions with a name (system exceptions and STM32F103 IRQs)
+#define TIMELINE_NUM_EXC_NAMES        (16u + 43u)
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Kernel thread
+typedef struct {
+  uint32_t ulId;                      ///< Thread identity (0: outside kernel)
+  char acName[16];                    ///< Name
+  uint32_t ulRegionDepth;             ///< Open regions
+} TIMELINE_ThreadTypeDef;
+
+/// Converter state
+typedef struct {
+  TIMELINE_ThreadTypeDef asThreads[TIMELINE_MAX_THREADS];
+  uint32_t ulNumThreads;              ///< Threads seen
+  uint32_t ulCurrent;                 ///< Index of running thread
+  bool bRunning;                      ///< A running slice is open
+  uint32_t aulExc[TIMELINE_MAX_DEPTH]; ///< Active exceptions, innermost last
+  uint32_t aulExcRegions[TIMELINE_MAX_DEPTH]; ///< Open regions per exception
+  uint32_t ulExcDepth;                ///< Handler nesting depth
+  double dFreq;                       ///< Core clock in Hz
+  bool bFixedFreq;                    ///< Frequency given by user
+  uint64_t ullBase;                   ///< Cycle count at dBaseUs
+  double dBaseUs;                     ///< Time of last frequency change
+  double dLastUs;                     ///< Time of last event
+  bool bTimeValid;                    ///< ullBase is set
+  bool bFirst;                        ///< No event written yet
+} TIMELINE_StateTypeDef;
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Input block
+static uint8_t aucBlock[TIMELINE_BLOCK_SIZE];
+
+/// Exception names, indexed by exception number (IPSR)
+static const char* const apcExcNames[TIMELINE_NUM_EXC_NAMES] = {
+  "Thread", "Reset", "NMI", "HardFault", "MemManage", "BusFault", "UsageFault",
+  NULL, NULL, NULL, NULL, "SVCall", "DebugMon", NULL, "PendSV", "SysTick",
+  "WWDG", "PVD", "TAMPER", "RTC", "FLASH", "RCC", "EXTI0", "EXTI1", "EXTI2",
+  "EXTI3", "EXTI4", "DMA1_Channel1", "DMA1_Channel2", "DMA1_Channel3",
+  "DMA1_Channel4", "DMA1_Channel5", "DMA1_Channel6", "DMA1_Channel7",
+  "ADC1_2", "USB_HP_CAN1_TX", "USB_LP_CAN1_RX0", "CAN1_RX1", "CAN1_SCE",
+  "EXTI9_5", "TIM1_BRK", "TIM1_UP", "TIM1_TRG_COM", "TIM1_CC", "TIM2", "TIM3",
+  "TIM4", "I2C1_EV", "I2C1_ER", "I2C2_EV", "I2C2_ER", "SPI1", "SPI2", "USART1",
+  "USART2", "USART3", "EXTI15_10", "RTC_Alarm", "USBWakeUp"
+};
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Convert timestamp to microseconds
+ *
+ * @param[in,out] *psState  Converter state
+ * @param[in] ullTime       Timestamp in core cycles
+ * @return  (double)      Time in microseconds
+ * @date  19.10.2026
+ ******************************************************************************/
+static double dToUs(TIMELINE_StateTypeDef* psState, uint64_t ullTime)
+{
+  if (!psState->bTimeValid)
+  {
+    psState->ullBase = ullTime;
+    psState->dBaseUs = 0.0;
+    psState->bTimeValid = true;
+  }
+  double dUs = psState->dBaseUs +
+               (double)(int64_t)(ullTime - psState->ullBase) * 1e6 / psState->dFreq;
+  if (dUs < psState->dLastUs) dUs = psState->dLastUs;
+  psState->dLastUs = dUs;
+  return dUs;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write one trace event
+ *
+ * @param[in,out] *psState  Converter state
+ * @param[in] cPhase        Event phase ('B', 'E')
+ * @param[in] ulTid         Track
+ * @param[in] dUs           Time in microseconds
+ * @param[in] *pcName       Slice name
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vWriteEvent(TIMELINE_StateTypeDef* psState, char cPhase, uint32_t ulTid,
+                        double dUs, const char* pcName)
+{
+  printf("%s\n{\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"name\":\"%s\"}",
+         psState->bFirst ? "" : ",", cPhase, ulTid, dUs, pcName);
+  psState->bFirst = false;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write track name
+ *
+ * @param[in,out] *psState  Converter state
+ * @param[in] ulTid         Track
+ * @param[in] *pcName       Track name
+ * @param[in] *pcSuffix     Appended to track name
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vWriteTrackName(TIMELINE_StateTypeDef* psState, uint32_t ulTid,
+                            const char* pcName, const char* pcSuffix)
+{
+  printf("%s\n{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\","
+         "\"args\":{\"name\":\"%s%s\"}},"
+         "\n{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_sort_index\","
+         "\"args\":{\"sort_index\":%u}}",
+         psState->bFirst ? "" : ",", ulTid, pcName, pcSuffix, ulTid, ulTid);
+  psState->bFirst = false;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get exception name
+ *
+ * @param[in] ulExc       Exception number
+ * @param[out] *pcBuf     Buffer for generated names
+ * @param[in] ulSize      Buffer size
+ * @return  (const char*)   Name
+ * @date  19.10.2026
+ ******************************************************************************/
+static const char* pcExcName(uint32_t ulExc, char* pcBuf, size_t ulSize)
+{
+  if ((ulExc < TIMELINE_NUM_EXC_NAMES) && (apcExcNames[ulExc] != NULL))
+  {
+    return apcExcNames[ulExc];
+  }
+  if (ulExc >= 16u) (void)snprintf(pcBuf, ulSize, "IRQ %u", ulExc - 16u);
+  else (void)snprintf(pcBuf, ulSize, "Exception %u", ulExc);
+  return pcBuf;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Find or add thread
+ *
+ * @param[in,out] *psState  Converter state
+ * @param[in] ulId          Thread identity
+ * @return  (uint32_t)    Thread index
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulGetThread(TIMELINE_StateTypeDef* psState, uint32_t ulId)
+{
+  for (uint32_t i = 0u; i < psState->ulNumThreads; ++i)
+  {
+    if (psState->asThreads[i].ulId == ulId) return i;
+  }
+  if (psState->ulNumThreads >= TIMELINE_MAX_THREADS) return 0u;
+
+  uint32_t i = psState->ulNumThreads++;
+  TIMELINE_ThreadTypeDef* psThread = &psState->asThreads[i];
+  psThread->ulId = ulId;
+  psThread->ulRegionDepth = 0u;
+  if (ulId == 0u) (void)snprintf(psThread->acName, sizeof(psThread->acName), "main");
+  else (void)snprintf(psThread->acName, sizeof(psThread->acName), "0x%08x", ulId);
+  return i;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write track names of a thread
+ *
+ * @param[in,out] *psState  Converter state
+ * @param[in] ulThread      Thread index
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vNameThread(TIMELINE_StateTypeDef* psState, uint32_t ulThread)
+{
+  const char* pcName = psState->asThreads[ulThread].acName;
+  vWriteTrackName(psState, TIMELINE_TID_THREAD(ulThread), pcName, "");
+  vWriteTrackName(psState, TIMELINE_TID_REGION(ulThread), pcName, " regions");
+}
+
+/*!****************************************************************************
+ * @brief
+ * Convert one timeline record
+ *
+ * @param[in,out] *psState  Converter state
+ * @param[in] *psEvent      Decoded record
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vConvert(TIMELINE_StateTypeDef* psState, const TRACE_EventTypeDef* psEvent)
+{
+  char acName[32];
+  uint32_t ulArg = (psEvent->ucNumArgs > 0u) ? psEvent->aulArgs[0] : 0u;
+
+  if (psEvent->uiId == HW_TRACE_TL_CLOCK)
+  {
+    // Rebase so that earlier timestamps keep their scaling
+    if (!psState->bFixedFreq && (ulArg != 0u) && ((double)ulArg != psState->dFreq))
+    {
+      psState->dBaseUs = dToUs(psState, psEvent->ullTime);
+      psState->ullBase = psEvent->ullTime;
+      psState->dFreq = (double)ulArg;
+    }
+    return;
+  }
+
+  double dUs = dToUs(psState, psEvent->ullTime);
+  TIMELINE_ThreadTypeDef* psThread = &psState->asThreads[psState->ulCurrent];
+
+  switch (psEvent->uiId)
+  {
+    case HW_TRACE_TL_EXC_ENTER:
+      if (psState->ulExcDepth >= TIMELINE_MAX_DEPTH) break;
+      psState->aulExc[psState->ulExcDepth] = ulArg;
+      psState->aulExcRegions[psState->ulExcDepth] = 0u;
+      psState->ulExcDepth++;
+      vWriteEvent(psState, 'B', TIMELINE_TID_HANDLER, dUs,
+                  pcExcName(ulArg, acName, sizeof(acName)));
+      break;
+
+    case HW_TRACE_TL_EXC_EXIT:
+      // Exit without entry, e.g. at the start of the capture
+      if ((psState->ulExcDepth == 0u) || (psState->aulExc[psState->ulExcDepth - 1u] != ulArg))
+      {
+        break;
+      }
+      psState->ulExcDepth--;
+      for (uint32_t r = psState->aulExcRegions[psState->ulExcDepth]; r > 0u; --r)
+      {
+        vWriteEvent(psState, 'E', TIMELINE_TID_HANDLER, dUs, "");
+      }
+      vWriteEvent(psState, 'E', TIMELINE_TID_HANDLER, dUs, "");
+      break;
+
+    case HW_TRACE_TL_THREAD:
+    {
+      if (psState->bRunning)
+      {
+        vWriteEvent(psState, 'E', TIMELINE_TID_THREAD(psState->ulCurrent), dUs, "");
+      }
+      uint32_t ulNew = psState->ulNumThreads;
+      psState->ulCurrent = ulGetThread(psState, ulArg);
+      if (psState->ulCurrent == ulNew) vNameThread(psState, ulNew);
+      psState->bRunning = (ulArg != 0u);
+      if (psState->bRunning)
+      {
+        vWriteEvent(psState, 'B', TIMELINE_TID_THREAD(psState->ulCurrent), dUs, "running");
+      }
+      break;
+    }
+
+    case HW_TRACE_TL_THREAD_NAME:
+    {
+      uint32_t i = ulGetThread(psState, ulArg);
+      char* pcName = psState->asThreads[i].acName;
+      uint32_t c;
+      for (c = 0u; c < 8u; ++c)
+      {
+        uint32_t ulWord = (psEvent->ucNumArgs > 1u + c / 4u) ? psEvent->aulArgs[1u + c / 4u] : 0u;
+        char cChar = (char)(ulWord >> (8u * (c % 4u)));
+        if (cChar == '\0') break;
+
+        // Keep the JSON string valid
+        pcName[c] = ((cChar == '"') || (cChar == '\\') || ((uint8_t)cChar < 0x20u)) ? '_' : cChar;
+      }
+      pcName[c] = '\0';
+      vNameThread(psState, i);
+      break;
+    }
+
+    case HW_TRACE_TL_REGION_BEGIN:
+      (void)snprintf(acName, sizeof(acName), "region %u", ulArg);
+      if (psState->ulExcDepth > 0u)
+      {
+        psState->aulExcRegions[psState->ulExcDepth - 1u]++;
+        vWriteEvent(psState, 'B', TIMELINE_TID_HANDLER, dUs, acName);
+      }
+      else
+      {
+        psThread->ulRegionDepth++;
+        vWriteEvent(psState, 'B', TIMELINE_TID_REGION(psState->ulCurrent), dUs, acName);
+      }
+      break;
+
+    case HW_TRACE_TL_REGION_END:
+      if (psState->ulExcDepth > 0u)
+      {
+        uint32_t* pulOpen = &psState->aulExcRegions[psState->ulExcDepth - 1u];
+        if (*pulOpen == 0u) break;
+        (*pulOpen)--;
+        vWriteEvent(psState, 'E', TIMELINE_TID_HANDLER, dUs, "");
+      }
+      else
+      {
+        if (psThread->ulRegionDepth == 0u) break;
+        psThread->ulRegionDepth--;
+        vWriteEvent(psState, 'E', TIMELINE_TID_REGION(psState->ulCurrent), dUs, "");
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Close open slices at the end of the capture
+ *
+ * @param[in,out] *psState  Converter state
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vFinish(TIMELINE_StateTypeDef* psState)
+{
+  double dUs = psState->dLastUs;
+  while (psState->ulExcDepth > 0u)
+  {
+    psState->ulExcDepth--;
+    for (uint32_t r = psState->aulExcRegions[psState->ulExcDepth]; r > 0u; --r)
+    {
+      vWriteEvent(psState, 'E', TIMELINE_TID_HANDLER, dUs, "");
+    }
+    vWriteEvent(psState, 'E', TIMELINE_TID_HANDLER, dUs, "");
+  }
+  for (uint32_t i = 0u; i < psState->ulNumThreads; ++i)
+  {
+    for (; psState->asThreads[i].ulRegionDepth > 0u; psState->asThreads[i].ulRegionDepth--)
+    {
+      vWriteEvent(psState, 'E', TIMELINE_TID_REGION(i), dUs, "");
+    }
+  }
+  if (psState->bRunning)
+  {
+    vWriteEvent(psState, 'E', TIMELINE_TID_THREAD(psState->ulCurrent), dUs, "");
+  }
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Converter entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  static TIMELINE_StateTypeDef sState;
+  sState.dFreq = TIMELINE_DEFAULT_FREQ;
+  sState.bFirst = true;
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "f:")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'f':
+        sState.dFreq = strtod(optarg, NULL);
+        sState.bFixedFreq = true;
+        break;
+      default:
+        fprintf(stderr, "Usage: %s [-f <Hz>] [file]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  if (!(sState.dFreq > 0.0))
+  {
+    fprintf(stderr, "Invalid frequency\n");
+    return EXIT_FAILURE;
+  }
+
+  FILE* psIn = stdin;
+  if (optind < argc)
+  {
+    psIn = fopen(argv[optind], "rb");
+    if (psIn == NULL)
+    {
+      perror(argv[optind]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Records before the first clock record are scaled with its frequency
+  TRACE_DecoderTypeDef sDec;
+  TRACE_EventTypeDef sEvent;
+  TRACE_EventTypeDef* psEvents = NULL;
+  size_t ulNumEvents = 0u;
+  size_t ulCapacity = 0u;
+  bool bClockSeen = sState.bFixedFreq;
+  vTRACE_DecoderInit(&sDec);
+
+  size_t ulRead;
+  while ((ulRead = fread(aucBlock, 1u, sizeof(aucBlock), psIn)) > 0u)
+  {
+    for (size_t i = 0u; i < ulRead; ++i)
+    {
+      if (!bTRACE_DecodeByte(&sDec, aucBlock[i], &sEvent)) continue;
+
+      if (!bClockSeen && (sEvent.uiId == HW_TRACE_TL_CLOCK) && (sEvent.aulArgs[0] != 0u))
+      {
+        sState.dFreq = (double)sEvent.aulArgs[0];
+        bClockSeen = true;
+      }
+      if (ulNumEvents == ulCapacity)
+      {
+        ulCapacity = (ulCapacity != 0u) ? 2u * ulCapacity : 4096u;
+        psEvents = realloc(psEvents, ulCapacity * sizeof(*psEvents));
+        if (psEvents == NULL)
+        {
+          perror("realloc");
+          return EXIT_FAILURE;
+        }
+      }
+      psEvents[ulNumEvents++] = sEvent;
+    }
+  }
+  if (psIn != stdin) fclose(psIn);
+
+  printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  vWriteTrackName(&sState, TIMELINE_TID_HANDLER, "Handler mode", "");
+  sState.ulCurrent = ulGetThread(&sState, 0u);
+  vNameThread(&sState, sState.ulCurrent);
+  for (size_t i = 0u; i < ulNumEvents; ++i)
+  {
+    vConvert(&sState, &psEvents[i]);
+  }
+  vFinish(&sState);
+  printf("\n]}\n");
+  free(psEvents);
+
+  fprintf(stderr, "%zu records, %u resyncs, %u errors, %.0f Hz%s\n",
+          ulNumEvents, sDec.ulSyncs, sDec.ulErrors, sState.dFreq,
+          bClockSeen ? "" : " (default)");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,266 @@
+/*!****************************************************************************
+ * @file
+ * tui_check.c
+ *
+ * @brief
+ * Host check of the diff-rendered text UI
+ *
+ * Renders frames with lib/tui into a capturing output function and compares
+ * the byte stream with the exact VT100 sequence expected:
+ *
+ *   init        Region reserved below the cursor, cursor back on top
+ *   unchanged   A frame redrawn with the same content emits nothing
+ *   cell        Single-cell changes with relative cursor movements
+ *   gap         Short unchanged gaps rewritten, longer ones skipped
+ *   attributes  SGR sequences per cell and reset after the frame
+ *   redraw      Full redraw after vTUI_Invalidate()
+ *   release     Region erased, cursor shown on its top left corner
+ *
+ * The returned byte counts must match the captured output, and no single
+ * write may exceed the staging buffer. On failure, expected and captured
+ * streams are printed with escape characters shown as "\e".
+ *
+ * Exits with failure status on the first error.
+ *
+ * Usage: tui_check [-v]
+ *   -v           Print every captured stream
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "tui.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Capture buffer size
+#define CHK_CAPTURE_SIZE              4096u
+
+/// Cursor one line down (parameter 1 is omitted)
+#define CHK_DOWN                      "\e[B"
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Captured output
+static char acCapture[CHK_CAPTURE_SIZE];
+static uint32_t ulCaptured;
+static uint32_t ulWrites;
+static uint32_t ulLargestWrite;
+
+/// Print every captured stream
+static bool bVerbose;
+
+/// Region under test
+static TUI_TypeDef sTui;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Output function: append to capture buffer
+ *
+ * @param[in] *pcBuf    Data
+ * @param[in] ulLen     Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkWrite(const char* pcBuf, uint32_t ulLen)
+{
+  if (ulCaptured + ulLen > CHK_CAPTURE_SIZE)
+  {
+    fprintf(stderr, "error: capture buffer full\n");
+    exit(EXIT_FAILURE);
+  }
+  (void)memcpy(&acCapture[ulCaptured], pcBuf, ulLen);
+  ulCaptured += ulLen;
+  ulWrites++;
+  if (ulLen > ulLargestWrite) ulLargestWrite = ulLen;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Discard captured output
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkRestart(void)
+{
+  ulCaptured = 0uL;
+  ulWrites = 0uL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Print byte stream with escape characters made visible
+ *
+ * @param[in] *pcLabel  Label
+ * @param[in] *pcBuf    Data
+ * @param[in] ulLen     Number of bytes
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkPrint(const char* pcLabel, const char* pcBuf, uint32_t ulLen)
+{
+  printf("  %-9s \"", pcLabel);
+  for (uint32_t i = 0uL; i < ulLen; ++i)
+  {
+    char cCh = pcBuf[i];
+    if (cCh == '\e') printf("\\e");
+    else if (cCh == '\r') printf("\\r");
+    else if (cCh == '\n') printf("\\n");
+    else putchar(cCh);
+  }
+  printf("\"\n");
+}
+
+/*!****************************************************************************
+ * @brief
+ * Compare captured output with expected stream, print result, exit on failure
+ *
+ * @param[in] *pcName     Scenario
+ * @param[in] *pcExpect   Expected stream
+ * @param[in] ulReturned  Byte count returned by the tested function
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkExpect(const char* pcName, const char* pcExpect, uint32_t ulReturned)
+{
+  uint32_t ulLen = (uint32_t)strlen(pcExpect);
+  bool bOk = (ulCaptured == ulLen) && (memcmp(acCapture, pcExpect, ulLen) == 0) &&
+             (ulReturned == ulCaptured) && (ulLargestWrite <= TUI_OUT_SIZE) &&
+             ((ulWrites == 0uL) == (ulCaptured == 0uL));
+
+  printf("%-14s %-4s %4lu bytes in %lu writes\n", pcName, bOk ? "ok" : "FAIL",
+         (unsigned long)ulCaptured, (unsigned long)ulWrites);
+  if (!bOk || bVerbose)
+  {
+    if (!bOk) vChkPrint("expected", pcExpect, ulLen);
+    vChkPrint("captured", acCapture, ulCaptured);
+  }
+  if (!bOk) exit(EXIT_FAILURE);
+  vChkRestart();
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Check entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "v")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'v': bVerbose = true; break;
+      default:
+        fprintf(stderr, "Usage: %s [-v]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  _Static_assert((TUI_ROWS == 9u) && (TUI_COLS == 50u), "expected streams assume a 50x9 region");
+
+  static char acExpect[CHK_CAPTURE_SIZE];
+  char acRow[TUI_COLS + 1u];
+
+  // Init: hide cursor, reset attributes, reserve rows, back to the top
+  vTUI_Init(&sTui, vChkWrite);
+  vChkExpect("init", "\e[?25l\e[0m\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\e[9A", sTui.ulBytes);
+
+  // Blank frame on blank terminal, then the same text twice
+  vChkExpect("unchanged", "", ulTUI_Refresh(&sTui));
+  vTUI_Puts(&sTui, 0u, 0u, TUI_ATTR_NONE, "Uptime");
+  vChkExpect("first text", "Uptime", ulTUI_Refresh(&sTui));
+  vTUI_Clear(&sTui);
+  vTUI_Puts(&sTui, 0u, 0u, TUI_ATTR_NONE, "Uptime");
+  vChkExpect("unchanged", "", ulTUI_Refresh(&sTui));
+  vChkExpect("unchanged", "", ulTUI_Refresh(&sTui));
+
+  // Single cells: move down and right, continue in place, back to column 0 and up
+  vTUI_Puts(&sTui, 3u, 10u, TUI_ATTR_NONE, "X");
+  vChkExpect("cell", "\e[3B\e[4CX", ulTUI_Refresh(&sTui));
+  vTUI_Puts(&sTui, 3u, 11u, TUI_ATTR_NONE, "Y");
+  vChkExpect("cell next", "Y", ulTUI_Refresh(&sTui));
+  vTUI_Puts(&sTui, 1u, 0u, TUI_ATTR_NONE, "Z");
+  vChkExpect("cell col 0", "\r\e[2AZ", ulTUI_Refresh(&sTui));
+  vTUI_Puts(&sTui, 1u, 0u, TUI_ATTR_NONE, "z");
+  vChkExpect("cell col 0", "\rz", ulTUI_Refresh(&sTui));
+  vTUI_Puts(&sTui, 1u, TUI_COLS - 1u, TUI_ATTR_NONE, "E");
+  vTUI_Puts(&sTui, 2u, 1u, TUI_ATTR_NONE, "F");
+  vChkExpect("cell wrap", "\e[48CE\r" CHK_DOWN "\e[CF", ulTUI_Refresh(&sTui));
+
+  // Gaps: changes 4 cells apart share a run, 5 cells apart take a cursor movement
+  vTUI_Puts(&sTui, 5u, 0u, TUI_ATTR_NONE, "A");
+  vTUI_Puts(&sTui, 5u, 4u, TUI_ATTR_NONE, "B");
+  vTUI_Puts(&sTui, 6u, 0u, TUI_ATTR_NONE, "C");
+  vTUI_Puts(&sTui, 6u, 5u, TUI_ATTR_NONE, "D");
+  vChkExpect("gap", "\r\e[3BA   B\r" CHK_DOWN "C\e[4CD", ulTUI_Refresh(&sTui));
+
+  // Attributes: one SGR per change, reset after the frame; attribute-only change redraws
+  vTUI_Puts(&sTui, 7u, 0u, TUI_ATTR_BOLD, "ab");
+  vTUI_Puts(&sTui, 7u, 2u, TUI_ATTR_UNDERLINE | TUI_ATTR_FG(VT100_FGCOL_CYAN), "c");
+  vTUI_Puts(&sTui, 7u, 3u, TUI_ATTR_INVERT | TUI_ATTR_FG(VT100_FGCOL_RED), "d");
+  vTUI_Puts(&sTui, 7u, 4u, TUI_ATTR_NONE, "e");
+  vChkExpect("attributes", "\r" CHK_DOWN "\e[0;1mab\e[0;4;36mc\e[0;7;31md\e[0me",
+             ulTUI_Refresh(&sTui));
+  vTUI_Puts(&sTui, 7u, 4u, TUI_ATTR_BOLD | TUI_ATTR_UNDERLINE | TUI_ATTR_INVERT |
+            TUI_ATTR_FG(VT100_FGCOL_WHITE), "e");
+  vChkExpect("attr only", "\e[D\e[0;1;4;7;37me\e[0m", ulTUI_Refresh(&sTui));
+  vTUI_Puts(&sTui, 7u, 4u, TUI_ATTR_NONE, "e");
+  vChkExpect("attr off", "\e[De", ulTUI_Refresh(&sTui));
+
+  // Full redraw: every row rewritten from column 0, in writes of the staging size
+  vTUI_Clear(&sTui);
+  vTUI_Puts(&sTui, 0u, 0u, TUI_ATTR_NONE, "Row 0");
+  vTUI_Puts(&sTui, 8u, 45u, TUI_ATTR_BOLD, "end");
+  vTUI_Invalidate(&sTui);
+  acExpect[0] = '\0';
+  for (uint32_t r = 0uL; r < TUI_ROWS; ++r)
+  {
+    (void)memset(acRow, ' ', TUI_COLS);
+    acRow[TUI_COLS] = '\0';
+    if (r == 0uL)
+    {
+      (void)memcpy(acRow, "Row 0", 5u);
+      (void)strcat(acExpect, "\r\e[7A");
+      (void)strcat(acExpect, acRow);
+    }
+    else if (r == TUI_ROWS - 1u)
+    {
+      acRow[45] = '\0';
+      (void)strcat(acExpect, "\r" CHK_DOWN);
+      (void)strcat(acExpect, acRow);
+      (void)strcat(acExpect, "\e[0;1mend\e[0m  ");
+    }
+    else
+    {
+      (void)strcat(acExpect, "\r" CHK_DOWN);
+      (void)strcat(acExpect, acRow);
+    }
+  }
+  ulLargestWrite = 0uL;
+  vChkExpect("redraw", acExpect, ulTUI_Refresh(&sTui));
+  if (ulLargestWrite != TUI_OUT_SIZE)
+  {
+    fprintf(stderr, "error: redraw not staged in full buffers\n");
+    return EXIT_FAILURE;
+  }
+  vChkExpect("unchanged", "", ulTUI_Refresh(&sTui));
+
+  // Release: back to the top left corner, erase, show cursor
+  uint32_t ulBefore = sTui.ulBytes;
+  vTUI_Release(&sTui);
+  vChkExpect("release", "\r\e[8A\e[J\e[?25h", sTui.ulBytes - ulBefore);
+
+  return EXIT_SUCCESS;
+}
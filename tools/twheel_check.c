@@ -0,0 +1,501 @@
+/*!****************************************************************************
+ * @file
+ * twheel_check.c
+ *
+ * @brief
+ * Host check of the hierarchical timer wheel
+ *
+ * Runs lib/timer_wheel under a software tick that mirrors the timer service
+ * of hw_clk: the system time counts every tick, the wheel is only advanced
+ * while timers are active, and starting a timer first catches the wheel up
+ * with the system time if it was idle. Every timer carries the tick it is
+ * due at; each callback must come exactly at that tick, and no active timer
+ * may pass its due tick without firing.
+ *
+ * Scenarios: one-shot timers at and around the level boundaries (1, 32,
+ * 1024, 32768 and 2^20 ticks) and beyond the wheel range, started at every
+ * phase of a 32-tick slot and across the 32-bit tick wrap-around; cancel at
+ * each level, also in the tick before and after a cascade; periodic re-arm;
+ * stop and restart of the own and of another due timer from a callback;
+ * start after idle ticks in which the wheel was not advanced; and skipping
+ * of the ticks reported by ulTWHEEL_GetIdleTicks() as in tickless sleep.
+ * Finally, random start, stop and restart operations run for many ticks.
+ *
+ * Exits with failure status on the first error.
+ *
+ * Usage: twheel_check [-n <ticks>] [-s <seed>]
+ *   -n <ticks>   Ticks in the random run (default 2000000)
+ *   -s <seed>    Random seed
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "timer_wheel.h"
+#include "chk.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Timers in the scenarios
+#define CHK_TIMERS                    64u
+
+/// Wheel range in ticks
+#define CHK_RANGE                     (1uL << (TWHEEL_SLOT_BITS * TWHEEL_LEVELS))
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Action of a timer callback
+typedef enum {
+  CHK_ACTION_NONE = 0,            ///< Only record
+  CHK_ACTION_STOP_SELF,           ///< Stop own timer
+  CHK_ACTION_STOP_OTHER,          ///< Stop the other timer
+  CHK_ACTION_RESTART_SELF         ///< Restart own timer with a new delay
+} ChkActionTypeDef;
+
+/// Timer under test with its expected state
+typedef struct {
+  TWHEEL_TimerTypeDef sTimer;     ///< Timer
+  bool bExpected;                 ///< Timer expected to be active
+  uint32_t ulDue;                 ///< Tick of the next expiry
+  uint32_t ulFired;               ///< Number of callbacks
+  ChkActionTypeDef eAction;       ///< Callback action
+  uint32_t ulArg;                 ///< Restart delay, or other timer index
+} ChkTimerTypeDef;
+
+
+/*- Private data -------------------------------------------------------------*/
+/// System time and wheel, as in hw_clk
+static uint32_t ulTicks;
+static TWHEEL_TypeDef sWheel;
+
+/// Timers
+static ChkTimerTypeDef asTimers[CHK_TIMERS];
+
+/// Callbacks
+static uint64_t ullFired;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Start timer as vHW_CLK_TimerStart() does
+ *
+ * @param[in] i         Timer index
+ * @param[in] ulDelay   Delay in ticks (min. 1)
+ * @param[in] ulPeriod  Reload period, 0 for one-shot
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkStart(uint32_t i, uint32_t ulDelay, uint32_t ulPeriod)
+{
+  TWHEEL_TimerTypeDef* psTimer = &asTimers[i].sTimer;
+  vTWHEEL_Remove(&sWheel, psTimer);
+
+  // Wheel is not advanced while empty, catch up with system time
+  if (sWheel.ulActive == 0uL) sWheel.ulNow = ulTicks;
+
+  psTimer->ulExpiry = sWheel.ulNow + ((ulDelay != 0uL) ? ulDelay : 1uL);
+  psTimer->ulPeriod = ulPeriod;
+  vTWHEEL_Insert(&sWheel, psTimer);
+
+  asTimers[i].bExpected = true;
+  asTimers[i].ulDue = ulTicks + ((ulDelay != 0uL) ? ulDelay : 1uL);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stop timer
+ *
+ * @param[in] i   Timer index
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkStop(uint32_t i)
+{
+  vTWHEEL_Remove(&sWheel, &asTimers[i].sTimer);
+  asTimers[i].bExpected = false;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Timer callback: check due tick and run the action
+ *
+ * @param[in] *psTimer  Timer
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkCallback(TWHEEL_TimerTypeDef* psTimer)
+{
+  ChkTimerTypeDef* psChk = psTimer->pvContext;
+  uint32_t i = (uint32_t)(psChk - asTimers);
+
+  ullFired++;
+  psChk->ulFired++;
+  if (!psChk->bExpected) vCHK_Fail("callback of a stopped timer");
+  if (psChk->ulDue != ulTicks) vCHK_Fail("callback not at the due tick");
+  if (bTWHEEL_IsActive(psTimer) != (psTimer->ulPeriod != 0uL)) vCHK_Fail("re-arm state wrong in callback");
+
+  if (psTimer->ulPeriod != 0uL)
+  {
+    psChk->ulDue += psTimer->ulPeriod;
+  }
+  else
+  {
+    psChk->bExpected = false;
+  }
+
+  switch (psChk->eAction)
+  {
+    case CHK_ACTION_STOP_SELF: vChkStop(i); break;
+    case CHK_ACTION_STOP_OTHER: vChkStop(psChk->ulArg); break;
+    case CHK_ACTION_RESTART_SELF: vChkStart(i, psChk->ulArg, psTimer->ulPeriod); break;
+    default: break;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Set up all timers idle
+ *
+ * @param[in] ulStart   System time
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkReset(uint32_t ulStart)
+{
+  ulTicks = ulStart;
+  vTWHEEL_Init(&sWheel, ulStart);
+  for (uint32_t i = 0uL; i < CHK_TIMERS; ++i)
+  {
+    asTimers[i] = (ChkTimerTypeDef){ 0 };
+    asTimers[i].sTimer.pfnCallback = vChkCallback;
+    asTimers[i].sTimer.pvContext = &asTimers[i];
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check expected timer states against the wheel
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkStates(void)
+{
+  uint32_t ulActive = 0uL;
+  for (uint32_t i = 0uL; i < CHK_TIMERS; ++i)
+  {
+    const ChkTimerTypeDef* psChk = &asTimers[i];
+    if (bTWHEEL_IsActive(&psChk->sTimer) != psChk->bExpected) vCHK_Fail("active state differs");
+    if (!psChk->bExpected) continue;
+    ulActive++;
+
+    // A due tick in the past (modulo 2^32) has been missed
+    if ((int32_t)(psChk->ulDue - ulTicks) <= 0) vCHK_Fail("timer missed its due tick");
+  }
+  if (sWheel.ulActive != ulActive) vCHK_Fail("active count differs");
+}
+
+/*!****************************************************************************
+ * @brief
+ * Tick as in vHW_CLK_TickHandler()
+ *
+ * @param[in] bCheck    Check all timer states after the tick
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkTick(bool bCheck)
+{
+  ulTicks++;
+  if (sWheel.ulActive != 0uL) vTWHEEL_Advance(&sWheel);
+  if (bCheck) vChkStates();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run ticks until no timer is active or a limit is reached
+ *
+ * Between due ticks, only the wheel state is checked to keep long delays
+ * fast; a missed expiry is still found at the next check.
+ *
+ * @param[in] ulLimit   Most ticks
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vChkRun(uint32_t ulLimit)
+{
+  for (uint32_t t = 0uL; (t < ulLimit) && (sWheel.ulActive != 0uL) && !bCHK_Failed(); ++t)
+  {
+    vChkTick((t & 0x3FFuL) == 0uL);
+  }
+  vChkStates();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check that every timer fired a number of times
+ *
+ * @param[in] ulCount   Number of timers
+ * @param[in] ulFired   Expected callbacks per timer
+ * @return  (bool)  All counts match
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bChkFired(uint32_t ulCount, uint32_t ulFired)
+{
+  for (uint32_t i = 0uL; i < ulCount; ++i)
+  {
+    if (asTimers[i].ulFired != ulFired) return false;
+  }
+  return true;
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Check entrypoint
+ *
+ * @param[in] argc      Number of arguments
+ * @param[in] *argv[]   Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  unsigned long ulRandomTicks = 2000000uL;
+  unsigned int uiSeed = (unsigned int)time(NULL);
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "n:s:")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'n': ulRandomTicks = strtoul(optarg, NULL, 0); break;
+      case 's': uiSeed = (unsigned int)strtoul(optarg, NULL, 0); break;
+      default:
+        fprintf(stderr, "Usage: %s [-n <ticks>] [-s <seed>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+  printf("seed %u\n", uiSeed);
+  srand(uiSeed);
+  vCHK_SetClock("tick", &ulTicks);
+
+  // Delays at and around the level boundaries, and beyond the wheel range
+  static const uint32_t aulDelays[] = {
+    1uL, 2uL, 31uL, 32uL, 33uL, 63uL, 64uL, 1023uL, 1024uL, 1025uL, 32767uL, 32768uL, 32769uL,
+    CHK_RANGE - 1uL, CHK_RANGE, CHK_RANGE + 1uL, 3uL * CHK_RANGE + 12345uL
+  };
+  const uint32_t ulDelays = sizeof(aulDelays) / sizeof(aulDelays[0]);
+  uint64_t ullStart;
+  bool bOk;
+
+  // Insert at each level from every phase of a slot, and across the wrap-around
+  ullStart = ullFired;
+  bOk = true;
+  static const uint32_t aulStarts[] = { 0uL, 0x12345uL, 0xFFFFFFFFuL - CHK_RANGE / 2uL };
+  for (uint32_t s = 0uL; s < sizeof(aulStarts) / sizeof(aulStarts[0]); ++s)
+  {
+    for (uint32_t ulPhase = 0uL; ulPhase < TWHEEL_SLOTS; ulPhase += (s == 0uL) ? 1uL : 7uL)
+    {
+      vChkReset(aulStarts[s]);
+      for (uint32_t t = 0uL; t < ulPhase; ++t)
+      {
+        vChkTick(false);
+      }
+      for (uint32_t i = 0uL; i < ulDelays; ++i)
+      {
+        vChkStart(i, aulDelays[i], 0uL);
+      }
+      vChkStates();
+      vChkRun(4uL * CHK_RANGE);
+      bOk = bOk && bChkFired(ulDelays, 1uL) && (sWheel.ulActive == 0uL);
+    }
+  }
+  vCHK_Report("levels", bOk, ullFired - ullStart, "callbacks");
+
+  // Cancel at each level: right after start, before and after a cascade
+  ullStart = ullFired;
+  vChkReset(0uL);
+  for (uint32_t i = 0uL; i < ulDelays; ++i)
+  {
+    vChkStart(i, aulDelays[i], 0uL);
+    vChkStart(ulDelays + i, aulDelays[i], 0uL);
+  }
+  for (uint32_t i = 0uL; i < ulDelays; i += 2uL)
+  {
+    vChkStop(i);
+  }
+  vChkStop(0uL);
+  vChkStates();
+  bOk = (sWheel.ulActive == 2uL * ulDelays - (ulDelays + 1uL) / 2uL);
+  for (uint32_t ulAt = 1024uL; (ulAt <= CHK_RANGE) && !bCHK_Failed(); ulAt *= 32uL)
+  {
+    // Stop one timer in the tick before and one after an upper level cascades
+    while (ulTicks < ulAt - 1uL)
+    {
+      vChkTick(false);
+    }
+    for (uint32_t k = 0uL; k < 2uL; ++k)
+    {
+      for (uint32_t i = 1uL; i < ulDelays; i += 2uL)
+      {
+        if (asTimers[i].bExpected && (aulDelays[i] > ulAt))
+        {
+          vChkStop(i);
+          break;
+        }
+      }
+      vChkTick(true);
+    }
+  }
+  vChkRun(4uL * CHK_RANGE);
+  for (uint32_t i = 0uL; i < ulDelays; ++i)
+  {
+    bOk = bOk && (asTimers[ulDelays + i].ulFired == 1uL);
+  }
+  vCHK_Report("cancel", bOk && (sWheel.ulActive == 0uL), ullFired - ullStart, "callbacks");
+
+  // Periodic re-arm, including periods at the level boundaries
+  ullStart = ullFired;
+  vChkReset(0xFFFFF000uL);
+  static const uint32_t aulPeriods[] = { 1uL, 7uL, 31uL, 32uL, 33uL, 1000uL, 1024uL, 40000uL };
+  const uint32_t ulPeriods = sizeof(aulPeriods) / sizeof(aulPeriods[0]);
+  for (uint32_t i = 0uL; i < ulPeriods; ++i)
+  {
+    vChkStart(i, aulPeriods[i], aulPeriods[i]);
+  }
+  for (uint32_t t = 0uL; t < 400000uL; ++t)
+  {
+    vChkTick(true);
+  }
+  bOk = true;
+  for (uint32_t i = 0uL; i < ulPeriods; ++i)
+  {
+    bOk = bOk && (asTimers[i].ulFired == 400000uL / aulPeriods[i]);
+    vChkStop(i);
+  }
+  vCHK_Report("periodic", bOk && (sWheel.ulActive == 0uL), ullFired - ullStart, "callbacks");
+
+  // Stop and restart from callbacks, also another timer due in the same tick
+  ullStart = ullFired;
+  vChkReset(0uL);
+  asTimers[0].eAction = CHK_ACTION_STOP_SELF;
+  vChkStart(0uL, 5uL, 5uL);
+  asTimers[1].eAction = CHK_ACTION_STOP_OTHER;
+  asTimers[1].ulArg = 2uL;
+  vChkStart(1uL, 40uL, 0uL);
+  vChkStart(2uL, 40uL, 0uL);
+  asTimers[2].eAction = CHK_ACTION_STOP_OTHER;
+  asTimers[2].ulArg = 1uL;
+  asTimers[3].eAction = CHK_ACTION_RESTART_SELF;
+  asTimers[3].ulArg = 1000uL;
+  vChkStart(3uL, 100uL, 0uL);
+  asTimers[4].eAction = CHK_ACTION_RESTART_SELF;
+  asTimers[4].ulArg = 3uL;
+  vChkStart(4uL, 7uL, 50uL);
+  for (uint32_t t = 0uL; t < 1200uL; ++t)
+  {
+    vChkTick(true);
+  }
+  // Timer 1 or 2 fires first and stops the other; the restart of timer 4 replaces its re-arm
+  bOk = (asTimers[0].ulFired == 1uL) && (asTimers[1].ulFired + asTimers[2].ulFired == 1uL) &&
+        (asTimers[3].ulFired == 2uL) && asTimers[3].bExpected && (asTimers[4].ulFired > 300uL);
+  vChkStop(3uL);
+  vChkStop(4uL);
+  vCHK_Report("callback stop", bOk && (sWheel.ulActive == 0uL), ullFired - ullStart, "callbacks");
+
+  // Start after idle ticks: the wheel catches up instead of firing early
+  ullStart = ullFired;
+  vChkReset(1000uL);
+  vChkStart(0uL, 3uL, 0uL);
+  vChkRun(10uL);
+  for (uint32_t t = 0uL; t < 12345uL; ++t)
+  {
+    vChkTick(false);
+  }
+  bOk = (sWheel.ulNow == 1003uL);
+  vChkStart(0uL, 10uL, 0uL);
+  vChkStart(1uL, 40000uL, 0uL);
+  bOk = bOk && (sWheel.ulNow == ulTicks);
+  vChkTick(true);
+  vChkStop(1uL);
+
+  // Wheel idle again, first timer stopped immediately: the second one still catches up
+  for (uint32_t t = 0uL; t < 777uL; ++t)
+  {
+    vChkTick(false);
+  }
+  vChkStart(2uL, 1uL, 0uL);
+  vChkStop(2uL);
+  vChkStart(3uL, 33uL, 0uL);
+  vChkRun(100uL);
+  bOk = bOk && (asTimers[0].ulFired == 2uL) && (asTimers[3].ulFired == 1uL) && (asTimers[2].ulFired == 0uL);
+  vCHK_Report("idle start", bOk, ullFired - ullStart, "callbacks");
+
+  // Tickless: skipped ticks have no timer due and need no cascade
+  ullStart = ullFired;
+  vChkReset(0uL);
+  for (uint32_t i = 0uL; i < ulDelays; ++i)
+  {
+    vChkStart(i, aulDelays[i] + 3uL, ((i & 1u) || (aulDelays[i] < TWHEEL_SLOTS)) ? 0uL : aulDelays[i]);
+  }
+  bOk = true;
+  uint32_t ulSkipped = 0uL;
+  uint32_t ulSleeps = 0uL;
+  while ((ulTicks < 2uL * CHK_RANGE) && !bCHK_Failed())
+  {
+    uint32_t ulSkip = ulTWHEEL_GetIdleTicks(&sWheel, UINT32_MAX);
+    bOk = bOk && (ulSkip < TWHEEL_SLOTS);
+    uint64_t ullBefore = ullFired;
+    for (uint32_t t = 0uL; t < ulSkip; ++t)
+    {
+      vChkTick(false);
+    }
+    bOk = bOk && (ullFired == ullBefore);
+    vChkTick(true);
+    ulSkipped += ulSkip;
+    ulSleeps++;
+  }
+  for (uint32_t i = 0uL; i < ulDelays; ++i)
+  {
+    vChkStop(i);
+  }
+  bOk = bOk && (ulTWHEEL_GetIdleTicks(&sWheel, 1234uL) == 1234uL);
+  vCHK_Report("tickless", bOk, ullFired - ullStart, "callbacks");
+  printf("  %lu ticks in %lu wake-ups\n", (unsigned long)ulTicks, (unsigned long)ulSleeps);
+
+  // Random start, stop and restart
+  ullStart = ullFired;
+  vChkReset((uint32_t)rand() * 2654435761uL);
+  for (unsigned long t = 0uL; (t < ulRandomTicks) && !bCHK_Failed(); ++t)
+  {
+    uint32_t i = (uint32_t)rand() % CHK_TIMERS;
+    uint32_t ulOp = (uint32_t)rand() % 64u;
+    if (ulOp == 0u)
+    {
+      vChkStop(i);
+    }
+    else if (ulOp < 3u)
+    {
+      // Level chosen first, so that all levels are used alike
+      uint32_t ulBits = TWHEEL_SLOT_BITS * (1u + (uint32_t)rand() % TWHEEL_LEVELS);
+      uint32_t ulDelay = 1uL + (uint32_t)rand() % (1uL << ulBits);
+      uint32_t ulPeriod = (rand() & 1) ? 1uL + (uint32_t)rand() % 5000uL : 0uL;
+      asTimers[i].eAction = (ChkActionTypeDef)((uint32_t)rand() % 4u);
+      asTimers[i].ulArg = (asTimers[i].eAction == CHK_ACTION_STOP_OTHER) ? (uint32_t)rand() % CHK_TIMERS :
+                                                                           1uL + (uint32_t)rand() % 3000uL;
+      vChkStart(i, ulDelay, ulPeriod);
+    }
+    vChkTick((t & 0xFuL) == 0uL);
+  }
+  for (uint32_t i = 0uL; i < CHK_TIMERS; ++i)
+  {
+    asTimers[i].eAction = CHK_ACTION_NONE;
+    if (asTimers[i].sTimer.ulPeriod != 0uL) vChkStop(i);
+  }
+  vChkRun(4uL * CHK_RANGE);
+  vCHK_Report("random", sWheel.ulActive == 0uL, ullFired - ullStart, "callbacks");
+
+  return EXIT_SUCCESS;
+}
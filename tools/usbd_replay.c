@@ -0,0 +1,567 @@
+/*!****************************************************************************
+ * @file
+ * usbd_replay.c
+ *
+ * @brief
+ * Host replay of USB control transfers against the CDC-ACM device layer
+ *
+ * Runs lib/usbd against a simulated endpoint 0. The host side replays setup
+ * packets as recorded from a Linux host during enumeration and while the
+ * cdc-acm driver opens the port, followed by requests that exercise error
+ * paths (stalls, endpoint halt, zero-length packet termination).
+ *
+ * Each transfer is completed like the host controller would: IN data is
+ * collected packet by packet until a short packet or wLength, then the
+ * zero-length OUT status is sent; OUT data is sent in 64-byte packets and
+ * the zero-length IN status is expected. The reply, the number of packets
+ * and the device state after the transfer are checked against the script.
+ *
+ * Prints one line per transfer; exits with failure status on the first
+ * mismatch.
+ *
+ * Usage: usbd_replay [-v]
+ *   -v   Dump reply data
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "usbd.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/// Longest reply collected
+#define SIM_MAX_REPLY                 512u
+
+/// Device identification used by the script
+#define SIM_VENDOR_ID                 0x0483u
+#define SIM_PRODUCT_ID                0x5740u
+#define SIM_MANUFACTURER              "STMicroelectronics"
+#define SIM_PRODUCT                   "STM32F103 Virtual COM Port Demo"  ///< 31 characters
+#define SIM_SERIAL                    "0123456789AB"
+
+/// Assigned device address
+#define SIM_ADDRESS                   5u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/// Expected outcome of a transfer
+typedef enum {
+  SIM_EXPECT_DATA = 0,            ///< IN data stage with given reply
+  SIM_EXPECT_STATUS,              ///< Status stage only (incl. OUT data)
+  SIM_EXPECT_STALL,               ///< Request stalled
+  SIM_RESET                       ///< No transfer, bus reset
+} SimExpectTypeDef;
+
+/// Script entry
+typedef struct {
+  const char* pcName;             ///< Description
+  uint8_t aucSetup[USBD_SETUP_SIZE];  ///< Setup packet
+  SimExpectTypeDef eExpect;       ///< Outcome
+  const uint8_t* pucData;         ///< Expected IN reply or OUT data
+  uint32_t ulLen;                 ///< Length of pucData
+  const char* pcString;           ///< Expected reply is string descriptor of this text
+  uint32_t ulPackets;             ///< Expected number of IN data packets, 0: any
+  bool (*pfnCheck)(void);         ///< Device state check afterwards, may be NULL
+} SimStepTypeDef;
+
+/// Simulated endpoint 0 and CDC endpoints
+typedef struct {
+  uint8_t aucTx[USBD_EP0_SIZE];   ///< Pending IN packet
+  uint32_t ulTxLen;               ///< Pending IN packet length
+  bool bTxPending;                ///< IN packet armed
+  bool bRxArmed;                  ///< OUT packet accepted
+  bool bStalled;                  ///< EP0 stalled
+  uint8_t ucAddress;              ///< Applied address
+  bool bConfigured;               ///< CDC endpoints enabled
+  uint16_t uiHalted;              ///< Halt bits, OUT 0..7, IN 8..15
+} SimEp0TypeDef;
+
+
+/*- Private functions --------------------------------------------------------*/
+static bool bCheckAddress(void);
+static bool bCheckConfigured(void);
+static bool bCheckLinesClosed(void);
+static bool bCheckLinesOpen(void);
+static bool bCheckLineCoding(void);
+static bool bCheckHalted(void);
+static bool bCheckDefault(void);
+
+
+/*- Private data -------------------------------------------------------------*/
+/// Simulated hardware
+static SimEp0TypeDef sEp0;
+
+/// Device under test
+static USBD_TypeDef sDev;
+
+/// Device descriptor as expected by the host
+static const uint8_t aucDevice[] = {
+  0x12, 0x01, 0x00, 0x02, 0x02, 0x00, 0x00, 0x40, 0x83, 0x04, 0x40, 0x57, 0x00, 0x01,
+  0x01, 0x02, 0x03, 0x01
+};
+
+/// Configuration descriptor header
+static const uint8_t aucConfigHeader[] = { 0x09, 0x02, 0x43, 0x00, 0x02, 0x01, 0x00, 0x80, 0x32 };
+
+/// Language IDs
+static const uint8_t aucLangIds[] = { 0x04, 0x03, 0x09, 0x04 };
+
+/// Line coding 9600 8N1
+static const uint8_t aucLineCoding[] = { 0x80, 0x25, 0x00, 0x00, 0x00, 0x00, 0x08 };
+
+/// Status replies
+static const uint8_t aucZero[] = { 0x00, 0x00 };
+static const uint8_t aucHalted[] = { 0x01, 0x00 };
+static const uint8_t aucConfigOne[] = { 0x01 };
+
+/// Full configuration descriptor, filled in from the device layer
+static const uint8_t* pucConfig;
+
+/// Replay script
+static const SimStepTypeDef asScript[] = {
+  // Enumeration by the Linux hub driver
+  { "GET_DESCRIPTOR device (64)", { 0x80, 0x06, 0x00, 0x01, 0x00, 0x00, 0x40, 0x00 },
+    SIM_EXPECT_DATA, aucDevice, sizeof(aucDevice), NULL, 1u, bCheckDefault },
+  { "bus reset", { 0 }, SIM_RESET, NULL, 0u, NULL, 0u, bCheckDefault },
+  { "SET_CONFIGURATION in default state", { 0x00, 0x09, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    SIM_EXPECT_STALL, NULL, 0u, NULL, 0u, bCheckDefault },
+  { "SET_ADDRESS", { 0x00, 0x05, SIM_ADDRESS, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    SIM_EXPECT_STATUS, NULL, 0u, NULL, 0u, bCheckAddress },
+  { "GET_DESCRIPTOR device (18)", { 0x80, 0x06, 0x00, 0x01, 0x00, 0x00, 0x12, 0x00 },
+    SIM_EXPECT_DATA, aucDevice, sizeof(aucDevice), NULL, 1u, NULL },
+  { "GET_DESCRIPTOR config (9)", { 0x80, 0x06, 0x00, 0x02, 0x00, 0x00, 0x09, 0x00 },
+    SIM_EXPECT_DATA, aucConfigHeader, sizeof(aucConfigHeader), NULL, 1u, NULL },
+  { "GET_DESCRIPTOR config (67)", { 0x80, 0x06, 0x00, 0x02, 0x00, 0x00, 0x43, 0x00 },
+    SIM_EXPECT_DATA, NULL, 67u, NULL, 2u, NULL },
+  { "GET_DESCRIPTOR string 0", { 0x80, 0x06, 0x00, 0x03, 0x00, 0x00, 0xFF, 0x00 },
+    SIM_EXPECT_DATA, aucLangIds, sizeof(aucLangIds), NULL, 1u, NULL },
+  { "GET_DESCRIPTOR string 2 (64 bytes, ZLP)", { 0x80, 0x06, 0x02, 0x03, 0x09, 0x04, 0xFF, 0x00 },
+    SIM_EXPECT_DATA, NULL, 0u, SIM_PRODUCT, 2u, NULL },
+  { "GET_DESCRIPTOR string 1", { 0x80, 0x06, 0x01, 0x03, 0x09, 0x04, 0xFF, 0x00 },
+    SIM_EXPECT_DATA, NULL, 0u, SIM_MANUFACTURER, 1u, NULL },
+  { "GET_DESCRIPTOR string 3", { 0x80, 0x06, 0x03, 0x03, 0x09, 0x04, 0xFF, 0x00 },
+    SIM_EXPECT_DATA, NULL, 0u, SIM_SERIAL, 1u, NULL },
+  { "GET_DESCRIPTOR string 4 (none)", { 0x80, 0x06, 0x04, 0x03, 0x09, 0x04, 0xFF, 0x00 },
+    SIM_EXPECT_STALL, NULL, 0u, NULL, 0u, NULL },
+  { "GET_DESCRIPTOR device qualifier", { 0x80, 0x06, 0x00, 0x06, 0x00, 0x00, 0x0A, 0x00 },
+    SIM_EXPECT_STALL, NULL, 0u, NULL, 0u, NULL },
+  { "GET_DESCRIPTOR config (64, no ZLP)", { 0x80, 0x06, 0x00, 0x02, 0x00, 0x00, 0x40, 0x00 },
+    SIM_EXPECT_DATA, NULL, 64u, NULL, 1u, NULL },
+  { "SET_CONFIGURATION 1", { 0x00, 0x09, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    SIM_EXPECT_STATUS, NULL, 0u, NULL, 0u, bCheckConfigured },
+  { "GET_CONFIGURATION", { 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00 },
+    SIM_EXPECT_DATA, aucConfigOne, sizeof(aucConfigOne), NULL, 1u, NULL },
+
+  // Port open by the cdc-acm driver
+  { "SET_CONTROL_LINE_STATE 0", { 0x21, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    SIM_EXPECT_STATUS, NULL, 0u, NULL, 0u, bCheckLinesClosed },
+  { "SET_LINE_CODING 9600 8N1", { 0x21, 0x20, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00 },
+    SIM_EXPECT_STATUS, aucLineCoding, sizeof(aucLineCoding), NULL, 0u, bCheckLineCoding },
+  { "GET_LINE_CODING", { 0xA1, 0x21, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00 },
+    SIM_EXPECT_DATA, aucLineCoding, sizeof(aucLineCoding), NULL, 1u, NULL },
+  { "SET_CONTROL_LINE_STATE DTR|RTS", { 0x21, 0x22, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    SIM_EXPECT_STATUS, NULL, 0u, NULL, 0u, bCheckLinesOpen },
+
+  // Endpoint halt and error paths
+  { "GET_STATUS device", { 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00 },
+    SIM_EXPECT_DATA, aucZero, sizeof(aucZero), NULL, 1u, NULL },
+  { "GET_STATUS ep 0x81", { 0x82, 0x00, 0x00, 0x00, 0x81, 0x00, 0x02, 0x00 },
+    SIM_EXPECT_DATA, aucZero, sizeof(aucZero), NULL, 1u, NULL },
+  { "SET_FEATURE ep 0x81 halt", { 0x02, 0x03, 0x00, 0x00, 0x81, 0x00, 0x00, 0x00 },
+    SIM_EXPECT_STATUS, NULL, 0u, NULL, 0u, bCheckHalted },
+  { "GET_STATUS ep 0x81 (halted)", { 0x82, 0x00, 0x00, 0x00, 0x81, 0x00, 0x02, 0x00 },
+    SIM_EXPECT_DATA, aucHalted, sizeof(aucHalted), NULL, 1u, NULL },
+  { "CLEAR_FEATURE ep 0x81 halt", { 0x02, 0x01, 0x00, 0x00, 0x81, 0x00, 0x00, 0x00 },
+    SIM_EXPECT_STATUS, NULL, 0u, NULL, 0u, NULL },
+  { "GET_STATUS ep 0x81 (cleared)", { 0x82, 0x00, 0x00, 0x00, 0x81, 0x00, 0x02, 0x00 },
+    SIM_EXPECT_DATA, aucZero, sizeof(aucZero), NULL, 1u, NULL },
+  { "GET_STATUS ep 0x03 (none)", { 0x82, 0x00, 0x00, 0x00, 0x03, 0x00, 0x02, 0x00 },
+    SIM_EXPECT_STALL, NULL, 0u, NULL, 0u, NULL },
+  { "SET_INTERFACE 1 alt 1", { 0x01, 0x0B, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00 },
+    SIM_EXPECT_STALL, NULL, 0u, NULL, 0u, NULL },
+  { "SET_LINE_CODING short", { 0x21, 0x20, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00 },
+    SIM_EXPECT_STALL, NULL, 0u, NULL, 0u, bCheckLineCoding },
+  { "vendor request", { 0xC0, 0x01, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00 },
+    SIM_EXPECT_STALL, NULL, 0u, NULL, 0u, NULL },
+  { "GET_CONFIGURATION after stall", { 0x80, 0x08, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00 },
+    SIM_EXPECT_DATA, aucConfigOne, sizeof(aucConfigOne), NULL, 1u, bCheckLinesOpen },
+
+  // Unplug
+  { "bus reset", { 0 }, SIM_RESET, NULL, 0u, NULL, 0u, bCheckDefault }
+};
+
+/// Dump replies
+static bool bVerbose;
+
+
+/*- Private functions --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Driver: arm IN packet on EP0
+ *
+ * @param[in] *pucData  Packet data
+ * @param[in] ulLen     Packet length
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimEp0Send(const uint8_t* pucData, uint32_t ulLen)
+{
+  if (sEp0.bTxPending || (ulLen > USBD_EP0_SIZE))
+  {
+    fprintf(stderr, "error: IN packet of %u bytes while %s\n", (unsigned int)ulLen,
+            sEp0.bTxPending ? "another one is pending" : "too long");
+    exit(EXIT_FAILURE);
+  }
+  if (ulLen != 0u) (void)memcpy(sEp0.aucTx, pucData, ulLen);
+  sEp0.ulTxLen = ulLen;
+  sEp0.bTxPending = true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: accept OUT packet on EP0
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimEp0Receive(void)
+{
+  sEp0.bRxArmed = true;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: stall EP0
+ *
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimEp0Stall(void)
+{
+  sEp0.bStalled = true;
+  sEp0.bTxPending = false;
+  sEp0.bRxArmed = false;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: apply address
+ *
+ * @param[in] ucAddr  Address
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimSetAddress(uint8_t ucAddr)
+{
+  sEp0.ucAddress = ucAddr;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: enable or disable CDC endpoints
+ *
+ * @param[in] bEnable   Enable
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimConfigure(bool bEnable)
+{
+  sEp0.bConfigured = bEnable;
+  sEp0.uiHalted = 0u;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: set or clear endpoint halt
+ *
+ * @param[in] ucEp    Endpoint address
+ * @param[in] bHalt   Halt
+ * @date  19.10.2026
+ ******************************************************************************/
+static void vSimSetHalt(uint8_t ucEp, bool bHalt)
+{
+  uint16_t uiBit = (uint16_t)(1u << (((ucEp & 0x80u) >> 4) | (ucEp & 0x07u)));
+  sEp0.uiHalted = bHalt ? (uint16_t)(sEp0.uiHalted | uiBit) : (uint16_t)(sEp0.uiHalted & ~uiBit);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Driver: get endpoint halt
+ *
+ * @param[in] ucEp    Endpoint address
+ * @return  (bool)  Halted
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bSimIsHalted(uint8_t ucEp)
+{
+  return (sEp0.uiHalted & (1u << (((ucEp & 0x80u) >> 4) | (ucEp & 0x07u)))) != 0u;
+}
+
+/*!****************************************************************************
+ * @brief
+ * State checks referenced by the script
+ *
+ * @return  (bool)  State as expected
+ * @date  19.10.2026
+ ******************************************************************************/
+static bool bCheckDefault(void)
+{
+  return (sDev.eState == USBD_STATE_DEFAULT) && (sEp0.ucAddress == 0u) && !sEp0.bConfigured;
+}
+
+static bool bCheckAddress(void)
+{
+  return (sDev.eState == USBD_STATE_ADDRESS) && (sEp0.ucAddress == SIM_ADDRESS);
+}
+
+static bool bCheckConfigured(void)
+{
+  return bUSBD_IsConfigured(&sDev) && sEp0.bConfigured && (sEp0.uiHalted == 0u);
+}
+
+static bool bCheckLinesClosed(void)
+{
+  return uiUSBD_GetLines(&sDev) == 0u;
+}
+
+static bool bCheckLinesOpen(void)
+{
+  return uiUSBD_GetLines(&sDev) == (USBD_LINE_DTR | USBD_LINE_RTS);
+}
+
+static bool bCheckLineCoding(void)
+{
+  const USBD_LineCodingTypeDef* psLc = &sDev.sLineCoding;
+  return (psLc->ulBaudRate == 9600u) && (psLc->ucStopBits == 0u) && (psLc->ucParity == 0u) &&
+         (psLc->ucDataBits == 8u);
+}
+
+static bool bCheckHalted(void)
+{
+  return bSimIsHalted(USBD_EP_DATA_IN) && !bSimIsHalted(USBD_EP_DATA_OUT);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Build string descriptor as the host expects it
+ *
+ * @param[out] *pucDesc   Descriptor
+ * @param[in] *pcText     ASCII text
+ * @return  (uint32_t)  Descriptor length
+ * @date  19.10.2026
+ ******************************************************************************/
+static uint32_t ulSimStringDesc(uint8_t* pucDesc, const char* pcText)
+{
+  uint32_t ulLen = 2u;
+  for (; *pcText != '\0'; ++pcText)
+  {
+    pucDesc[ulLen++] = (uint8_t)*pcText;
+    pucDesc[ulLen++] = 0u;
+  }
+  pucDesc[0] = (uint8_t)ulLen;
+  pucDesc[1] = 0x03u;
+  return ulLen;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run one control transfer like the host controller
+ *
+ * @param[in] *psStep     Script entry
+ * @param[out] *pucReply  IN data received
+ * @param[out] *pulLen    IN data length
+ * @param[out] *pulPackets  Number of IN data packets
+ * @return  (SimExpectTypeDef)  Outcome
+ * @date  19.10.2026
+ ******************************************************************************/
+static SimExpectTypeDef eSimTransfer(const SimStepTypeDef* psStep, uint8_t* pucReply,
+                                     uint32_t* pulLen, uint32_t* pulPackets)
+{
+  const uint8_t* pucSetup = psStep->aucSetup;
+  uint32_t ulLength = (uint32_t)pucSetup[6] | ((uint32_t)pucSetup[7] << 8);
+  *pulLen = 0u;
+  *pulPackets = 0u;
+
+  // A setup packet is always accepted and clears a stall
+  sEp0.bStalled = false;
+  sEp0.bTxPending = false;
+  sEp0.bRxArmed = false;
+  vUSBD_Setup(&sDev, pucSetup);
+  if (sEp0.bStalled) return SIM_EXPECT_STALL;
+
+  if (((pucSetup[0] & 0x80u) != 0u) && (ulLength != 0u))
+  {
+    // IN data stage until short packet or wLength
+    for (;;)
+    {
+      if (!sEp0.bTxPending)
+      {
+        fprintf(stderr, "error: no IN data packet after %u bytes\n", (unsigned int)*pulLen);
+        exit(EXIT_FAILURE);
+      }
+      uint32_t ulPacket = sEp0.ulTxLen;
+      if ((*pulLen + ulPacket > ulLength) || (*pulLen + ulPacket > SIM_MAX_REPLY))
+      {
+        fprintf(stderr, "error: device sent more than wLength\n");
+        exit(EXIT_FAILURE);
+      }
+      (void)memcpy(&pucReply[*pulLen], sEp0.aucTx, ulPacket);
+      *pulLen += ulPacket;
+      *pulPackets += 1u;
+      sEp0.bTxPending = false;
+      vUSBD_Ep0InDone(&sDev);
+      if ((ulPacket < USBD_EP0_SIZE) || (*pulLen == ulLength)) break;
+    }
+    if (sEp0.bTxPending)
+    {
+      fprintf(stderr, "error: IN packet after end of data stage\n");
+      exit(EXIT_FAILURE);
+    }
+
+    // Zero-length OUT status
+    if (!sEp0.bRxArmed)
+    {
+      fprintf(stderr, "error: status OUT not accepted\n");
+      exit(EXIT_FAILURE);
+    }
+    sEp0.bRxArmed = false;
+    vUSBD_Ep0Out(&sDev, NULL, 0u);
+    return SIM_EXPECT_DATA;
+  }
+
+  // OUT data stage
+  for (uint32_t ulPos = 0u; ulPos < ulLength; )
+  {
+    uint32_t ulPacket = (ulLength - ulPos > USBD_EP0_SIZE) ? USBD_EP0_SIZE : ulLength - ulPos;
+    if (!sEp0.bRxArmed)
+    {
+      fprintf(stderr, "error: OUT data not accepted at byte %u\n", (unsigned int)ulPos);
+      exit(EXIT_FAILURE);
+    }
+    sEp0.bRxArmed = false;
+    vUSBD_Ep0Out(&sDev, &psStep->pucData[ulPos], ulPacket);
+    if (sEp0.bStalled) return SIM_EXPECT_STALL;
+    ulPos += ulPacket;
+  }
+
+  // Zero-length IN status
+  if (!sEp0.bTxPending || (sEp0.ulTxLen != 0u))
+  {
+    fprintf(stderr, "error: no zero-length status packet\n");
+    exit(EXIT_FAILURE);
+  }
+  sEp0.bTxPending = false;
+  vUSBD_Ep0InDone(&sDev);
+  return SIM_EXPECT_STATUS;
+}
+
+
+/*- Public interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Replay script and compare
+ *
+ * @param[in] argc    Argument count
+ * @param[in] *argv[] Arguments
+ * @return  (int)   Exit status
+ * @date  19.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "v")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'v': bVerbose = true; break;
+      default:
+        fprintf(stderr, "Usage: %s [-v]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+  }
+
+  static const USBD_DriverTypeDef sDrv = {
+    .pfnEp0Send = vSimEp0Send,
+    .pfnEp0Receive = vSimEp0Receive,
+    .pfnEp0Stall = vSimEp0Stall,
+    .pfnSetAddress = vSimSetAddress,
+    .pfnConfigure = vSimConfigure,
+    .pfnSetHalt = vSimSetHalt,
+    .pfnIsHalted = bSimIsHalted
+  };
+  static const USBD_IdentTypeDef sIdent = {
+    .uiVendorId = SIM_VENDOR_ID,
+    .uiProductId = SIM_PRODUCT_ID,
+    .pcManufacturer = SIM_MANUFACTURER,
+    .pcProduct = SIM_PRODUCT,
+    .pcSerial = SIM_SERIAL
+  };
+  vUSBD_Init(&sDev, &sDrv, &sIdent);
+
+  uint32_t ulConfigLen;
+  pucConfig = pucUSBD_GetConfigDescriptor(&ulConfigLen);
+
+  unsigned int uiSteps = 0u;
+  for (size_t i = 0u; i < sizeof(asScript) / sizeof(asScript[0]); ++i)
+  {
+    const SimStepTypeDef* psStep = &asScript[i];
+    uint8_t aucReply[SIM_MAX_REPLY];
+    uint8_t aucExpected[SIM_MAX_REPLY];
+    uint32_t ulLen = 0u;
+    uint32_t ulPackets = 0u;
+    bool bOk = true;
+
+    if (psStep->eExpect == SIM_RESET)
+    {
+      (void)memset(&sEp0, 0, sizeof(sEp0));
+      vUSBD_Reset(&sDev);
+    }
+    else
+    {
+      SimExpectTypeDef eResult = eSimTransfer(psStep, aucReply, &ulLen, &ulPackets);
+      bOk = (eResult == psStep->eExpect);
+
+      if (bOk && (eResult == SIM_EXPECT_DATA))
+      {
+        // Expected reply: given, string descriptor or configuration prefix
+        uint32_t ulExpected = psStep->ulLen;
+        if (psStep->pcString != NULL)
+        {
+          ulExpected = ulSimStringDesc(aucExpected, psStep->pcString);
+        }
+        else if (psStep->pucData != NULL)
+        {
+          (void)memcpy(aucExpected, psStep->pucData, ulExpected);
+        }
+        else
+        {
+          (void)memcpy(aucExpected, pucConfig, ulExpected);
+        }
+        bOk = (ulLen == ulExpected) && (memcmp(aucReply, aucExpected, ulLen) == 0) &&
+              ((psStep->ulPackets == 0u) || (ulPackets == psStep->ulPackets));
+      }
+      bOk = bOk && (sDev.eStage == ((eResult == SIM_EXPECT_STALL) ? USBD_STAGE_STALLED : USBD_STAGE_IDLE));
+    }
+    if (bOk && (psStep->pfnCheck != NULL)) bOk = psStep->pfnCheck();
+
+    printf("%-44s %s", psStep->pcName, bOk ? "ok" : "FAILED");
+    if (ulPackets != 0u) printf("  (%u bytes, %u packets)", (unsigned int)ulLen, (unsigned int)ulPackets);
+    printf("\n");
+    if (bVerbose && (ulLen != 0u))
+    {
+      for (uint32_t j = 0u; j < ulLen; ++j)
+      {
+        printf("%s%02x", ((j % 16u) == 0u) ? "  " : " ", aucReply[j]);
+        if (((j % 16u) == 15u) || (j + 1u == ulLen)) printf("\n");
+      }
+    }
+    if (!bOk) return EXIT_FAILURE;
+    uiSteps++;
+  }
+
+  printf("%u transfers replayed, configuration descriptor %u bytes\n", uiSteps,
+         (unsigned int)ulConfigLen);
+  return EXIT_SUCCESS;
+}
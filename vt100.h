@@ -6,6 +6,8 @@
  * VT100 Escape Sequences
  *
  * @date  13.10.2025
+ * @date  19.10.2026  Added cursor control sequences
+ * @date  19.10.2026  Added erase below cursor
  ******************************************************************************/
 
 #ifndef VT100_H_
@@ -14,6 +16,18 @@
 /*- Macros -------------------------------------------------------------------*/
 // Clear terminal
 #define VT100_ERASE_DISPLAY           "\e[2J"
+#define VT100_ERASE_DOWN              "\e[J"
+
+// Cursor control
+#define VT100_CSI                     "\e["
+#define VT100_CURSOR_HOME             "\e[H"
+#define VT100_CURSOR_HIDE             "\e[?25l"
+#define VT100_CURSOR_SHOW             "\e[?25h"
+#define VT100_CURSOR_POS(row, col)    "\e[" __XSTRING(row) ";" __XSTRING(col) "H"
+#define VT100_CURSOR_UP(n)            "\e[" __XSTRING(n) "A"
+#define VT100_CURSOR_DOWN(n)          "\e[" __XSTRING(n) "B"
+#define VT100_CURSOR_FWD(n)           "\e[" __XSTRING(n) "C"
+#define VT100_CURSOR_BACK(n)          "\e[" __XSTRING(n) "D"
 
 // Reset graphical attributes
 #define VT100_RESET_ATTRS             "\e[0m"